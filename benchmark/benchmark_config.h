@@ -29,11 +29,17 @@ class BenchmarkConfig {
 
 }; // struct singleton_t
 
+/// @returns the registered benchmark, for further configuration,
+/// or nullptr if it's filtered out by the config.
 template <typename F>
-void RegisterBenchmark(const std::string& name, F&& func)
+benchmark::internal::Benchmark* RegisterBenchmark(
+        const std::string& name,
+        F&& func)
 {
     if (BenchmarkConfig::instance().shouldRegister(name))
-        benchmark::RegisterBenchmark(name.c_str(), std::forward<F>(func));
+        return benchmark::RegisterBenchmark(
+                name.c_str(), std::forward<F>(func));
+    return nullptr;
 }
 
 } // namespace zstrong::bench
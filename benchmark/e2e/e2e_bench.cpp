@@ -19,6 +19,8 @@
 #include "benchmark/e2e/e2e_compressor.h"
 #include "benchmark/e2e/e2e_fieldlz.h"
 #include "benchmark/e2e/e2e_json_extract.h"
+#include "benchmark/e2e/e2e_parallel.h"
+#include "benchmark/e2e/e2e_parquet.h"
 #include "benchmark/e2e/e2e_parse.h"
 #include "benchmark/e2e/e2e_sao.h"
 #include "benchmark/e2e/e2e_splitByStruct.h"
@@ -622,6 +624,8 @@ void registerE2EBenchmarks()
     thrift::registerBenchmarks();
     json_extract::registerBenchmarks();
     parse::registerBenchmarks();
+    parallel::registerBenchmarks();
+    parquet::registerBenchmarks();
 }
 
 } // namespace zstrong::bench::e2e
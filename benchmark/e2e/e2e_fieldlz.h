@@ -36,6 +36,8 @@ namespace {
 // - eltWidth: width of each input element in bytes
 // - clevel: compression level
 // - dlevel: decompression level
+// - fieldLzLevel: optional Field LZ level override, the only way to select
+//   the archival levels 6 to 9
 // Unlike most other compressor graphs, FieldLz reacts differently to different
 // compression and decompression levels, which is why we want to include them.
 class FieldLzCompressor : public ZstrongCompressor {
@@ -43,7 +45,10 @@ class FieldLzCompressor : public ZstrongCompressor {
     ZL_GraphID configureGraph(ZL_Compressor* cgraph) override
     {
         // Build the conversion and FieldLz graphs
-        auto fieldlz  = ZL_Compressor_registerFieldLZGraph(cgraph);
+        auto fieldlz = fieldLzLevel_
+                ? ZL_Compressor_registerFieldLZGraph_withLevel(
+                          cgraph, *fieldLzLevel_)
+                : ZL_Compressor_registerFieldLZGraph(cgraph);
         auto startGid = addConversionFromSerial(cgraph, fieldlz, eltWidth_);
 
         // Set additional graph parameters: compression level and
@@ -61,13 +66,19 @@ class FieldLzCompressor : public ZstrongCompressor {
     }
     size_t eltWidth_;
     int clevel_, dlevel_;
+    std::optional<int> fieldLzLevel_;
 
    public:
-    FieldLzCompressor(size_t eltWidth, int clevel, int dlevel)
+    FieldLzCompressor(
+            size_t eltWidth,
+            int clevel,
+            int dlevel,
+            std::optional<int> fieldLzLevel = std::nullopt)
             : ZstrongCompressor(),
               eltWidth_(eltWidth),
               clevel_(clevel),
-              dlevel_(dlevel)
+              dlevel_(dlevel),
+              fieldLzLevel_(fieldLzLevel)
     {
     }
 
@@ -76,6 +87,13 @@ class FieldLzCompressor : public ZstrongCompressor {
         // Return a human-readable name for the compressor.
         // We encode all the important configurations here - specifically the
         // width we operate on and the level of compression/decompression.
+        if (fieldLzLevel_) {
+            return fmt::format(
+                    "FieldLz{}(lvl={}, dlvl={})",
+                    eltWidth_ * 8,
+                    *fieldLzLevel_,
+                    dlevel_);
+        }
         return fmt::format(
                 "FieldLz{}(clvl={}, dlvl={})", eltWidth_ * 8, clevel_, dlevel_);
     }
@@ -123,6 +141,12 @@ inline void registerFieldLzBenchmarks()
             std::make_shared<FieldLzCompressor>(corpus->width(), 3, 7),
             std::make_shared<FieldLzCompressor>(corpus->width(), 7, 7),
         };
+        // Every Field LZ level, to compare the ratio and speed of the fast
+        // levels (1-5) with the archival levels (6-9)
+        for (int level = 1; level <= 9; ++level) {
+            compressors.push_back(std::make_shared<FieldLzCompressor>(
+                    corpus->width(), level, 7, level));
+        }
         for (auto compressor : compressors) {
             // Register a test case for each compressor and corpus.
             E2EBenchmarkTestcase(compressor, corpus).registerBenchmarks();
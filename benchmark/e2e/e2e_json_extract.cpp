@@ -4,11 +4,14 @@
 
 #include <random>
 
+#include <fmt/format.h>
+
 #include "benchmark/benchmark_data.h"
 #include "benchmark/e2e/e2e_bench.h"
 #include "benchmark/e2e/e2e_compressor.h"
 #include "custom_transforms/json_extract/decode_json_extract.h"
 #include "custom_transforms/json_extract/encode_json_extract.h"
+#include "openzl/shared/cpu.h"
 #include "openzl/zl_config.h"
 #include "openzl/zl_ctransform.h"
 #include "openzl/zl_dtransform.h"
@@ -22,9 +25,18 @@ namespace {
 
 class JsonExtractCompressor : public ZstrongCompressor {
    public:
+    /// @param cpuFeatures The CPU features the structural indexer may employ
+    explicit JsonExtractCompressor(unsigned cpuFeatures = ZL_CPU_FEATURES_ALL)
+            : cpuFeatures_(cpuFeatures)
+    {
+    }
+
     std::string name() override
     {
-        return "JsonExtract";
+        if (cpuFeatures_ == ZL_CPU_FEATURES_ALL) {
+            return "JsonExtract";
+        }
+        return fmt::format("JsonExtract(cpu={:#x})", cpuFeatures_);
     }
 
     ZL_GraphID configureGraph(ZL_Compressor* cgraph) override
@@ -39,13 +51,70 @@ class JsonExtractCompressor : public ZstrongCompressor {
     {
         ZL_REQUIRE_SUCCESS(ZS2_DCtx_registerJsonExtract(dctx, 0));
     }
+
+    void benchCompression(benchmark::State& state, const std::string_view src)
+            override
+    {
+        ZL_cpuFeatures_setMask(cpuFeatures_);
+        ZstrongCompressor::benchCompression(state, src);
+        ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+    }
+
+   private:
+    unsigned cpuFeatures_;
+};
+
+/// Newline-delimited JSON log records, as ingested from logging pipelines.
+/// They are dense in short tokens of every type, and strings with escapes.
+class JsonLogsData : public BenchmarkData {
+   public:
+    explicit JsonLogsData(size_t size)
+    {
+        std::mt19937 gen(0xdeadbeef);
+        std::uniform_int_distribution<int> latency(0, 1000000);
+        std::uniform_int_distribution<int> user(0, 1 << 20);
+        std::uniform_int_distribution<int> level(0, 3);
+        char const* const kLevels[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+        int64_t ts = 1700000000000;
+        while (data_.size() < size) {
+            ts += latency(gen) % 1000;
+            auto const lvl = level(gen);
+            data_ += fmt::format(
+                    "{{\"ts\":{},\"level\":\"{}\",\"latency_ms\":{:.3f},"
+                    "\"user\":{},\"ok\":{},\"trace\":null,"
+                    "\"msg\":\"GET \\\"/api/v1/items/{}\\\" served\","
+                    "\"tags\":[\"web\",\"shard-{}\",{}]}}\n",
+                    ts,
+                    kLevels[lvl],
+                    latency(gen) / 1000.0,
+                    user(gen),
+                    lvl < 3 ? "true" : "false",
+                    user(gen),
+                    user(gen) % 64,
+                    -lvl);
+        }
+        data_.resize(size);
+    }
+
+    std::string_view data() override
+    {
+        return data_;
+    }
+
+    std::string name() override
+    {
+        return fmt::format("JsonLogs(size={})", data_.size());
+    }
+
+   private:
+    std::string data_;
 };
 
-void registerBenchmark(size_t size)
+void registerBenchmark(
+        std::shared_ptr<BenchmarkData> corpus,
+        unsigned cpuFeatures = ZL_CPU_FEATURES_ALL)
 {
-    auto corpus = std::make_shared<ArbitrarySerializedData>(
-            tests::genJsonLikeData(size));
-    auto compressor = std::make_shared<JsonExtractCompressor>();
+    auto compressor = std::make_shared<JsonExtractCompressor>(cpuFeatures);
     E2EBenchmarkTestcase(compressor, corpus).registerBenchmarks();
 }
 
@@ -53,7 +122,14 @@ void registerBenchmark(size_t size)
 
 void registerBenchmarks()
 {
-    registerBenchmark(100 * 1024);
+    registerBenchmark(std::make_shared<ArbitrarySerializedData>(
+            tests::genJsonLikeData(100 * 1024)));
+    for (size_t const size : { 100 * 1024, 16 << 20 }) {
+        auto const logs = std::make_shared<JsonLogsData>(size);
+        registerBenchmark(logs);
+        // Scalar structural indexer, to compare against the vector paths
+        registerBenchmark(logs, 0);
+    }
 }
 
 } // namespace zstrong::bench::e2e::json_extract
@@ -0,0 +1,277 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "benchmark/e2e/e2e_parallel.h"
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark_config.h"
+#include "benchmark/benchmark_data.h"
+#include "benchmark/e2e/e2e_zstrong_utils.h"
+#include "custom_parsers/csv/csv_profile.h"
+#include "openzl/cpp/ThreadPool.hpp"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_compressor.h"
+#include "openzl/zl_decompress.h"
+#include "openzl/zl_public_nodes.h"
+#include "openzl/zl_segmenter.h"
+
+namespace zstrong::bench::e2e::parallel {
+
+using namespace zstrong::bench::utils;
+using namespace zstrong::bench::e2e::utils;
+
+namespace {
+
+constexpr size_t kChunkSize = (size_t)1 << 20;
+
+/* Cuts the serial input into fixed-size chunks,
+ * each compressed independently with the generic graph */
+ZL_Report fixedSizeSegmenterFn(ZL_Segmenter* sctx)
+{
+    size_t remaining;
+    ZL_RET_R_IF_ERR(ZL_Segmenter_getNumElts(sctx, &remaining, 1));
+    while (remaining > 0) {
+        size_t chunkSize = std::min(remaining, kChunkSize);
+        ZL_RET_R_IF_ERR(ZL_Segmenter_processChunk(
+                sctx, &chunkSize, 1, ZL_GRAPH_COMPRESS_GENERIC, nullptr));
+        remaining -= chunkSize;
+    }
+    return ZL_returnSuccess();
+}
+
+const ZL_Type kSerialType[] = { ZL_Type_serial };
+
+const ZL_SegmenterDesc kFixedSizeSegmenter = {
+    .name           = "bench_fixed_size_segmenter",
+    .segmenterFn    = fixedSizeSegmenterFn,
+    .inputTypeMasks = kSerialType,
+    .numInputs      = 1,
+};
+
+/// Synthetic CSV with a header, where some fields are quoted
+class CsvData : public BenchmarkData {
+   public:
+    explicit CsvData(size_t targetSize) : targetSize_(targetSize) {}
+
+    std::string_view data() override
+    {
+        if (data_.empty()) {
+            std::mt19937 gen(42);
+            data_ = "id,timestamp,name,score,note\n";
+            for (size_t row = 0; data_.size() < targetSize_; ++row) {
+                data_ += fmt::format(
+                        "{},{},user{},{}.{},",
+                        row,
+                        1600000000 + 7 * row + gen() % 5,
+                        gen() % 1000,
+                        gen() % 100,
+                        gen() % 10);
+                data_ += (gen() % 16 == 0) ? "\"quoted, note\"\n" : "ok\n";
+            }
+        }
+        return data_;
+    }
+
+    std::string name() override
+    {
+        return fmt::format("CSV(size={}MiB)", targetSize_ >> 20);
+    }
+
+   private:
+    size_t targetSize_;
+    std::string data_;
+};
+
+CGraph_unique createSegmenterGraph()
+{
+    auto cgraph = createCGraph();
+    ZS2_unwrap(
+            ZL_Compressor_setParameter(
+                    cgraph.get(),
+                    ZL_CParam_formatVersion,
+                    ZL_MAX_FORMAT_VERSION),
+            "Failed setting format version");
+    ZL_GraphID const gid = ZL_Compressor_registerSegmenter(
+            cgraph.get(), &kFixedSizeSegmenter);
+    ZS2_unwrap(
+            ZL_Compressor_selectStartingGraphID(cgraph.get(), gid),
+            "Failed setting starting graph id");
+    return cgraph;
+}
+
+/// The CSV profile, which cuts its input into chunks of whole rows
+CGraph_unique createCsvGraph()
+{
+    auto cgraph = createCGraph();
+    ZS2_unwrap(
+            ZL_Compressor_setParameter(
+                    cgraph.get(),
+                    ZL_CParam_formatVersion,
+                    ZL_MAX_FORMAT_VERSION),
+            "Failed setting format version");
+    ZL_GraphID const gid = openzl::custom_parsers::
+            ZL_createGraph_genericCSVCompressor(cgraph.get());
+    ZS2_unwrap(
+            ZL_Compressor_selectStartingGraphID(cgraph.get(), gid),
+            "Failed setting starting graph id");
+    return cgraph;
+}
+
+using CreateGraphFn = CGraph_unique (*)();
+
+size_t compressWithWorkers(
+        std::vector<uint8_t>& dst,
+        std::string_view src,
+        const ZL_Compressor* cgraph,
+        openzl::ThreadPool& pool,
+        int nbWorkers)
+{
+    auto cctx = createCCTX();
+    ZS2_unwrap(
+            ZL_CCtx_refCompressor(cctx.get(), cgraph),
+            "Failed referencing compressor");
+    ZS2_unwrap(
+            ZL_CCtx_setParameter(cctx.get(), ZL_CParam_nbWorkers, nbWorkers),
+            "Failed setting nbWorkers");
+    ZL_WorkerPool const workerPool = pool.get();
+    ZS2_unwrap(
+            ZL_CCtx_setWorkerPool(cctx.get(), &workerPool),
+            "Failed attaching worker pool");
+    dst.resize(ZL_compressBound(src.size()));
+    return ZS2_unwrap(
+            ZL_CCtx_compress(
+                    cctx.get(), dst.data(), dst.size(), src.data(), src.size()),
+            "Failed compressing");
+}
+
+void benchCompression(
+        benchmark::State& state,
+        std::shared_ptr<BenchmarkData> data,
+        CreateGraphFn createGraph,
+        int nbWorkers)
+{
+    std::string_view const src = data->data();
+    auto const cgraph          = createGraph();
+    openzl::ThreadPool pool((size_t)nbWorkers - 1);
+    std::vector<uint8_t> compressed;
+    size_t cSize = 0;
+    for (auto _ : state) {
+        cSize = compressWithWorkers(
+                compressed, src, cgraph.get(), pool, nbWorkers);
+        benchmark::DoNotOptimize(compressed);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed((int64_t)(src.size() * state.iterations()));
+    state.counters["Size"]             = (double)src.size();
+    state.counters["CompressedSize"]   = (double)cSize;
+    state.counters["CompressionRatio"] = (double)src.size() / (double)cSize;
+}
+
+void benchDecompression(
+        benchmark::State& state,
+        std::shared_ptr<BenchmarkData> data,
+        CreateGraphFn createGraph,
+        int nbWorkers)
+{
+    std::string_view const src = data->data();
+    auto const cgraph          = createGraph();
+    openzl::ThreadPool pool((size_t)nbWorkers - 1);
+    std::vector<uint8_t> compressed;
+    size_t const cSize = compressWithWorkers(
+            compressed, src, cgraph.get(), pool, nbWorkers);
+
+    auto dctx = createDCTX();
+    ZS2_unwrap(
+            ZL_DCtx_setParameter(dctx.get(), ZL_DParam_stickyParameters, 1),
+            "Failed setting sticky parameters");
+    ZS2_unwrap(
+            ZL_DCtx_setParameter(dctx.get(), ZL_DParam_nbWorkers, nbWorkers),
+            "Failed setting nbWorkers");
+    ZL_WorkerPool const workerPool = pool.get();
+    ZS2_unwrap(
+            ZL_DCtx_setWorkerPool(dctx.get(), &workerPool),
+            "Failed attaching worker pool");
+    std::vector<uint8_t> decompressed(src.size());
+    for (auto _ : state) {
+        size_t const dSize = ZS2_unwrap(
+                ZL_DCtx_decompress(
+                        dctx.get(),
+                        decompressed.data(),
+                        decompressed.size(),
+                        compressed.data(),
+                        cSize),
+                "Failed decompressing");
+        if (dSize != src.size()) {
+            throw std::runtime_error{ "Failed roundtrip testing" };
+        }
+        benchmark::DoNotOptimize(decompressed);
+        benchmark::ClobberMemory();
+    }
+    if (getStringView(decompressed) != src) {
+        throw std::runtime_error{ "Failed roundtrip testing" };
+    }
+    state.SetBytesProcessed((int64_t)(src.size() * state.iterations()));
+    state.counters["Size"]             = (double)src.size();
+    state.counters["CompressedSize"]   = (double)cSize;
+    state.counters["CompressionRatio"] = (double)src.size() / (double)cSize;
+}
+
+} // namespace
+
+void registerBenchmarks()
+{
+    std::vector<std::pair<std::shared_ptr<BenchmarkData>, CreateGraphFn>>
+            corpora = {
+                { std::make_shared<UniformDistributionData<uint16_t>>(
+                          32 * kChunkSize / sizeof(uint16_t), 1000),
+                  createSegmenterGraph },
+                { std::make_shared<NormalDistributionData<uint32_t>>(
+                          1000, 100, 32 * kChunkSize / sizeof(uint32_t)),
+                  createSegmenterGraph },
+                // Cut into 8 chunks of whole rows by the profile
+                { std::make_shared<CsvData>(64 * kChunkSize), createCsvGraph },
+            };
+    std::vector<int> nbWorkersList = { 1, 2, 4, 8, 16 };
+    int const nbCores = (int)std::thread::hardware_concurrency();
+    if (nbCores > nbWorkersList.back()) {
+        nbWorkersList.push_back(nbCores);
+    }
+    for (auto const& [corpus, createGraph] : corpora) {
+        for (int const nbWorkers : nbWorkersList) {
+            // Workers run on other threads: measure wall-clock time
+            auto* const compressBM = RegisterBenchmark(
+                    fmt::format(
+                            "E2E / Parallel / {} / Workers={} / Compress",
+                            corpus->name(),
+                            nbWorkers),
+                    [corpus, createGraph, nbWorkers](benchmark::State& state) {
+                        benchCompression(state, corpus, createGraph, nbWorkers);
+                    });
+            if (compressBM != nullptr) {
+                compressBM->UseRealTime();
+            }
+            auto* const decompressBM = RegisterBenchmark(
+                    fmt::format(
+                            "E2E / Parallel / {} / Workers={} / Decompress",
+                            corpus->name(),
+                            nbWorkers),
+                    [corpus, createGraph, nbWorkers](benchmark::State& state) {
+                        benchDecompression(
+                                state, corpus, createGraph, nbWorkers);
+                    });
+            if (decompressBM != nullptr) {
+                decompressBM->UseRealTime();
+            }
+        }
+    }
+}
+
+} // namespace zstrong::bench::e2e::parallel
@@ -0,0 +1,13 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+namespace zstrong::bench::e2e::parallel {
+
+/**
+ * Registers benchmarks of chunk-parallel compression and decompression,
+ * for an increasing number of workers.
+ */
+void registerBenchmarks();
+
+} // namespace zstrong::bench::e2e::parallel
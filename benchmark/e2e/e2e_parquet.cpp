@@ -0,0 +1,647 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "benchmark/e2e/e2e_parquet.h"
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark_config.h"
+#include "benchmark/benchmark_data.h"
+#include "benchmark/e2e/e2e_zstrong_utils.h"
+#include "custom_parsers/parquet/parquet_graph.h"
+#include "custom_parsers/shared_components/clustering.h"
+#include "openzl/cpp/ThreadPool.hpp"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_compressor.h"
+#include "openzl/zl_decompress.h"
+
+namespace zstrong::bench::e2e::parquet {
+
+using namespace zstrong::bench::utils;
+using namespace zstrong::bench::e2e::utils;
+
+namespace {
+
+constexpr size_t kGiB = (size_t)1 << 30;
+
+/// Writes the Thrift compact protocol, which encodes Parquet metadata
+class ThriftWriter {
+   public:
+    explicit ThriftWriter(std::string& out) : out_(out) {}
+
+    void i32(int16_t id, int32_t value)
+    {
+        fieldBegin(id, kI32);
+        varint(zigzag(value));
+    }
+
+    void i64(int16_t id, int64_t value)
+    {
+        fieldBegin(id, kI64);
+        varint(zigzag(value));
+    }
+
+    void string(int16_t id, std::string_view value)
+    {
+        fieldBegin(id, kBinary);
+        listElt(value);
+    }
+
+    void structBegin(int16_t id)
+    {
+        fieldBegin(id, kStruct);
+        listStructBegin();
+    }
+
+    void structEnd()
+    {
+        out_.push_back(0);
+        lastIds_.pop_back();
+    }
+
+    void listBegin(int16_t id, uint8_t eltType, size_t size)
+    {
+        fieldBegin(id, kList);
+        if (size < 15) {
+            out_.push_back((char)((size << 4) | eltType));
+        } else {
+            out_.push_back((char)(0xF0 | eltType));
+            varint(size);
+        }
+    }
+
+    void listElt(int32_t value)
+    {
+        varint(zigzag(value));
+    }
+
+    void listElt(std::string_view value)
+    {
+        varint(value.size());
+        out_.append(value);
+    }
+
+    void listStructBegin()
+    {
+        lastIds_.push_back(0);
+    }
+
+    static constexpr uint8_t kI32    = 5;
+    static constexpr uint8_t kI64    = 6;
+    static constexpr uint8_t kBinary = 8;
+    static constexpr uint8_t kList   = 9;
+    static constexpr uint8_t kStruct = 12;
+
+   private:
+    void fieldBegin(int16_t id, uint8_t type)
+    {
+        int16_t& lastId   = lastIds_.back();
+        int const delta   = id - lastId;
+        if (delta > 0 && delta <= 15) {
+            out_.push_back((char)((delta << 4) | type));
+        } else {
+            out_.push_back((char)type);
+            varint(zigzag(id));
+        }
+        lastId = id;
+    }
+
+    static uint64_t zigzag(int64_t value)
+    {
+        return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+    }
+
+    void varint(uint64_t value)
+    {
+        while (value >= 0x80) {
+            out_.push_back((char)(value | 0x80));
+            value >>= 7;
+        }
+        out_.push_back((char)value);
+    }
+
+    std::string& out_;
+    std::vector<int16_t> lastIds_{ 0 };
+};
+
+/// Appends @p values of @p width <= 56 bits each, least significant bit first
+void bitPack(std::string& out, const uint64_t* values, size_t n, int width)
+{
+    uint64_t bits = 0;
+    int nbBits    = 0;
+    for (size_t i = 0; i < n; ++i) {
+        bits |= values[i] << nbBits;
+        nbBits += width;
+        while (nbBits >= 8) {
+            out.push_back((char)bits);
+            bits >>= 8;
+            nbBits -= 8;
+        }
+    }
+    if (nbBits > 0) {
+        out.push_back((char)bits);
+    }
+}
+
+int bitWidth(uint64_t value)
+{
+    int width = 0;
+    while (value >> width) {
+        ++width;
+    }
+    return width;
+}
+
+void appendVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((char)value);
+}
+
+void appendLE(std::string& out, const void* src, size_t size)
+{
+    out.append((const char*)src, size);
+}
+
+/// DELTA_BINARY_PACKED, with blocks of 128 values in 4 miniblocks
+void deltaEncode(std::string& out, const int64_t* values, size_t n)
+{
+    constexpr size_t kBlockSize     = 128;
+    constexpr size_t kMiniblockSize = 32;
+    appendVarint(out, kBlockSize);
+    appendVarint(out, kBlockSize / kMiniblockSize);
+    appendVarint(out, n);
+    appendVarint(out, ((uint64_t)values[0] << 1) ^ (uint64_t)(values[0] >> 63));
+    for (size_t b = 1; b < n; b += kBlockSize) {
+        size_t const count = std::min(kBlockSize, n - b);
+        int64_t deltas[kBlockSize];
+        int64_t minDelta = INT64_MAX;
+        for (size_t i = 0; i < count; ++i) {
+            deltas[i] = values[b + i] - values[b + i - 1];
+            minDelta  = std::min(minDelta, deltas[i]);
+        }
+        appendVarint(
+                out, ((uint64_t)minDelta << 1) ^ (uint64_t)(minDelta >> 63));
+        uint64_t packed[kBlockSize] = {};
+        for (size_t i = 0; i < count; ++i) {
+            packed[i] = (uint64_t)(deltas[i] - minDelta);
+        }
+        int widths[kBlockSize / kMiniblockSize] = {};
+        for (size_t m = 0; m * kMiniblockSize < count; ++m) {
+            uint64_t const* const mb = packed + m * kMiniblockSize;
+            widths[m] = bitWidth(*std::max_element(mb, mb + kMiniblockSize));
+        }
+        for (int width : widths) {
+            out.push_back((char)width);
+        }
+        for (size_t m = 0; m * kMiniblockSize < count; ++m) {
+            bitPack(out, packed + m * kMiniblockSize, kMiniblockSize, widths[m]);
+        }
+    }
+}
+
+/// Definition levels of @p n defined values, in a single RLE run
+void appendLevels(std::string& out, size_t n)
+{
+    std::string levels;
+    appendVarint(levels, n << 1);
+    levels.push_back(1);
+    uint32_t const size = (uint32_t)levels.size();
+    appendLE(out, &size, sizeof(size));
+    out += levels;
+}
+
+enum PageEncoding : int32_t {
+    kPlain         = 0,
+    kRle           = 3,
+    kDeltaBinary   = 5,
+    kRleDictionary = 8,
+};
+
+void appendPageHeader(
+        std::string& out,
+        int32_t pageType,
+        size_t size,
+        size_t numValues,
+        int32_t encoding)
+{
+    ThriftWriter w(out);
+    w.i32(1, pageType);
+    w.i32(2, (int32_t)size);
+    w.i32(3, (int32_t)size);
+    if (pageType == 2) {
+        w.structBegin(7);
+        w.i32(1, (int32_t)numValues);
+        w.i32(2, encoding);
+        w.structEnd();
+    } else {
+        w.structBegin(5);
+        w.i32(1, (int32_t)numValues);
+        w.i32(2, encoding);
+        w.i32(3, kRle);
+        w.i32(4, kRle);
+        w.structEnd();
+    }
+    out.push_back(0);
+}
+
+/// Parquet physical types
+enum PhysicalType : int32_t {
+    kInt32     = 1,
+    kInt64     = 2,
+    kDouble    = 5,
+    kByteArray = 6,
+};
+
+struct Column {
+    std::string name;
+    PhysicalType type;
+    PageEncoding encoding;
+};
+
+struct ChunkInfo {
+    int64_t offset;
+    int64_t dictionaryOffset; ///< -1 without dictionary
+    int64_t size;
+    size_t numValues;
+};
+
+/**
+ * Generates an uncompressed Parquet file of roughly @p targetSize bytes, with
+ * row groups of @p rowGroupRows rows. It mixes the PLAIN, RLE_DICTIONARY and
+ * DELTA_BINARY_PACKED encodings, with one dictionary page per column chunk,
+ * like most writers do.
+ */
+std::string generateParquet(size_t targetSize, size_t rowGroupRows)
+{
+    constexpr size_t kPageRows = 20000;
+    std::vector<Column> const columns = {
+        { "timestamp", kInt64, kDeltaBinary },
+        { "user_id", kInt64, kPlain },
+        { "country", kByteArray, kRleDictionary },
+        { "price", kDouble, kPlain },
+        { "quantity", kInt32, kPlain },
+    };
+    std::vector<std::string> countries;
+    for (int i = 0; i < 60; ++i) {
+        countries.push_back(fmt::format("country-{:02}", i));
+    }
+
+    std::mt19937_64 gen(0xC0FFEE);
+    std::geometric_distribution<int64_t> jitter(0.01);
+    std::geometric_distribution<size_t> popular(0.05);
+    std::uniform_int_distribution<int64_t> users(0, 1000000);
+    std::uniform_int_distribution<int32_t> cents(1, 100000);
+    int64_t timestamp = 1700000000000;
+
+    std::string out;
+    out.reserve(targetSize + (targetSize >> 4));
+    out += "PAR1";
+    std::vector<std::vector<ChunkInfo>> rowGroups;
+    size_t numRows = 0;
+    while (out.size() < targetSize) {
+        size_t const rows = rowGroupRows;
+        std::vector<int64_t> timestamps(rows), userIds(rows);
+        std::vector<uint64_t> countryIdx(rows);
+        std::vector<double> prices(rows);
+        std::vector<int32_t> quantities(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            timestamp += jitter(gen);
+            timestamps[i] = timestamp;
+            userIds[i]    = i > 0 && gen() % 4 == 0 ? userIds[i - 1]
+                                                    : users(gen);
+            countryIdx[i] = std::min(popular(gen), countries.size() - 1);
+            prices[i]     = cents(gen) / 100.0;
+            quantities[i] = (int32_t)(1 + popular(gen));
+        }
+
+        std::vector<ChunkInfo> chunks;
+        for (auto const& column : columns) {
+            ChunkInfo chunk = { (int64_t)out.size(), -1, 0, rows };
+            if (column.encoding == kRleDictionary) {
+                std::string dict;
+                for (auto const& country : countries) {
+                    uint32_t const len = (uint32_t)country.size();
+                    appendLE(dict, &len, sizeof(len));
+                    dict += country;
+                }
+                chunk.dictionaryOffset = chunk.offset;
+                appendPageHeader(out, 2, dict.size(), countries.size(), kPlain);
+                out += dict;
+            }
+            for (size_t p = 0; p < rows; p += kPageRows) {
+                size_t const n = std::min(kPageRows, rows - p);
+                std::string page;
+                appendLevels(page, n);
+                if (column.encoding == kDeltaBinary) {
+                    deltaEncode(page, timestamps.data() + p, n);
+                } else if (column.encoding == kRleDictionary) {
+                    int const width = bitWidth(countries.size() - 1);
+                    page.push_back((char)width);
+                    size_t const groups = (n + 7) / 8;
+                    appendVarint(page, (groups << 1) | 1);
+                    std::vector<uint64_t> idx(groups * 8);
+                    std::copy_n(countryIdx.begin() + (ptrdiff_t)p, n, idx.begin());
+                    bitPack(page, idx.data(), idx.size(), width);
+                } else if (column.type == kInt64) {
+                    appendLE(page, userIds.data() + p, n * sizeof(int64_t));
+                } else if (column.type == kDouble) {
+                    appendLE(page, prices.data() + p, n * sizeof(double));
+                } else {
+                    appendLE(page, quantities.data() + p, n * sizeof(int32_t));
+                }
+                if (p == 0 && chunk.dictionaryOffset >= 0) {
+                    // The data page offset is the first data page
+                    chunk.offset = (int64_t)out.size();
+                }
+                appendPageHeader(out, 0, page.size(), n, column.encoding);
+                out += page;
+            }
+            int64_t const begin = chunk.dictionaryOffset >= 0
+                    ? chunk.dictionaryOffset
+                    : chunk.offset;
+            chunk.size = (int64_t)out.size() - begin;
+            chunks.push_back(chunk);
+        }
+        rowGroups.push_back(std::move(chunks));
+        numRows += rows;
+    }
+
+    // Footer
+    std::string footer;
+    ThriftWriter w(footer);
+    w.i32(1, 1);
+    w.listBegin(2, ThriftWriter::kStruct, columns.size() + 1);
+    w.listStructBegin();
+    w.string(4, "schema");
+    w.i32(5, (int32_t)columns.size());
+    w.structEnd();
+    for (auto const& column : columns) {
+        w.listStructBegin();
+        w.i32(1, column.type);
+        w.i32(3, 1 /* OPTIONAL */);
+        w.string(4, column.name);
+        w.structEnd();
+    }
+    w.i64(3, (int64_t)numRows);
+    w.listBegin(4, ThriftWriter::kStruct, rowGroups.size());
+    for (auto const& chunks : rowGroups) {
+        w.listStructBegin();
+        w.listBegin(1, ThriftWriter::kStruct, chunks.size());
+        int64_t totalSize = 0;
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            auto const& chunk  = chunks[c];
+            auto const& column = columns[c];
+            w.listStructBegin();
+            w.i64(2, chunk.offset);
+            w.structBegin(3);
+            w.i32(1, column.type);
+            w.listBegin(2, ThriftWriter::kI32, 2);
+            w.listElt((int32_t)column.encoding);
+            w.listElt((int32_t)kRle);
+            w.listBegin(3, ThriftWriter::kBinary, 1);
+            w.listElt(std::string_view(column.name));
+            w.i32(4, 0 /* UNCOMPRESSED */);
+            w.i64(5, (int64_t)chunk.numValues);
+            w.i64(6, chunk.size);
+            w.i64(7, chunk.size);
+            w.i64(9, chunk.offset);
+            if (chunk.dictionaryOffset >= 0) {
+                w.i64(11, chunk.dictionaryOffset);
+            }
+            w.structEnd();
+            w.structEnd();
+            totalSize += chunk.size;
+        }
+        w.i64(2, totalSize);
+        w.i64(3, (int64_t)rowGroupRows);
+        w.structEnd();
+    }
+    footer.push_back(0);
+
+    out += footer;
+    uint32_t const footerSize = (uint32_t)footer.size();
+    appendLE(out, &footerSize, sizeof(footerSize));
+    out += "PAR1";
+    return out;
+}
+
+/**
+ * A generated Parquet file. Multi-GB files are only generated when a benchmark
+ * using them runs.
+ */
+class ParquetData : public BenchmarkData {
+   public:
+    ParquetData(size_t targetSize, size_t rowGroupRows)
+            : targetSize_(targetSize), rowGroupRows_(rowGroupRows)
+    {
+    }
+
+    std::string_view data() override
+    {
+        if (data_.empty()) {
+            data_ = generateParquet(targetSize_, rowGroupRows_);
+        }
+        return data_;
+    }
+
+    std::string name() override
+    {
+        return fmt::format(
+                "Parquet(size={}MiB, rowGroupRows={})",
+                targetSize_ >> 20,
+                rowGroupRows_);
+    }
+
+   private:
+    size_t targetSize_;
+    size_t rowGroupRows_;
+    std::string data_;
+};
+
+CGraph_unique createParquetGraph(bool rowGroups)
+{
+    auto cgraph = createCGraph();
+    ZS2_unwrap(
+            ZL_Compressor_setParameter(
+                    cgraph.get(),
+                    ZL_CParam_formatVersion,
+                    ZL_MAX_FORMAT_VERSION),
+            "Failed setting format version");
+    ZL_GraphID const clustering =
+            ZS2_createGraph_genericClustering(cgraph.get());
+    ZL_GraphID const gid = rowGroups
+            ? ZL_Parquet_registerRowGroupGraph(cgraph.get(), clustering)
+            : ZL_Parquet_registerGraph(cgraph.get(), clustering);
+    ZS2_unwrap(
+            ZL_Compressor_selectStartingGraphID(cgraph.get(), gid),
+            "Failed setting starting graph id");
+    return cgraph;
+}
+
+size_t compressWithWorkers(
+        std::vector<uint8_t>& dst,
+        std::string_view src,
+        const ZL_Compressor* cgraph,
+        openzl::ThreadPool& pool,
+        int nbWorkers)
+{
+    auto cctx = createCCTX();
+    ZS2_unwrap(
+            ZL_CCtx_refCompressor(cctx.get(), cgraph),
+            "Failed referencing compressor");
+    ZS2_unwrap(
+            ZL_CCtx_setParameter(cctx.get(), ZL_CParam_nbWorkers, nbWorkers),
+            "Failed setting nbWorkers");
+    ZL_WorkerPool const workerPool = pool.get();
+    ZS2_unwrap(
+            ZL_CCtx_setWorkerPool(cctx.get(), &workerPool),
+            "Failed attaching worker pool");
+    dst.resize(ZL_compressBound(src.size()));
+    return ZS2_unwrap(
+            ZL_CCtx_compress(
+                    cctx.get(), dst.data(), dst.size(), src.data(), src.size()),
+            "Failed compressing");
+}
+
+void setCounters(benchmark::State& state, size_t srcSize, size_t cSize)
+{
+    state.SetBytesProcessed((int64_t)(srcSize * state.iterations()));
+    state.counters["Size"]             = (double)srcSize;
+    state.counters["CompressedSize"]   = (double)cSize;
+    state.counters["CompressionRatio"] = (double)srcSize / (double)cSize;
+}
+
+void benchCompression(
+        benchmark::State& state,
+        std::shared_ptr<BenchmarkData> data,
+        bool rowGroups,
+        int nbWorkers)
+{
+    std::string_view const src = data->data();
+    auto const cgraph          = createParquetGraph(rowGroups);
+    openzl::ThreadPool pool((size_t)nbWorkers - 1);
+    std::vector<uint8_t> compressed;
+    size_t cSize = 0;
+    for (auto _ : state) {
+        cSize = compressWithWorkers(
+                compressed, src, cgraph.get(), pool, nbWorkers);
+        benchmark::DoNotOptimize(compressed);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, src.size(), cSize);
+}
+
+void benchDecompression(
+        benchmark::State& state,
+        std::shared_ptr<BenchmarkData> data,
+        bool rowGroups,
+        int nbWorkers)
+{
+    std::string_view const src = data->data();
+    auto const cgraph          = createParquetGraph(rowGroups);
+    openzl::ThreadPool pool((size_t)nbWorkers - 1);
+    std::vector<uint8_t> compressed;
+    size_t const cSize = compressWithWorkers(
+            compressed, src, cgraph.get(), pool, nbWorkers);
+
+    auto dctx = createDCTX();
+    ZS2_unwrap(
+            ZL_DCtx_setParameter(dctx.get(), ZL_DParam_stickyParameters, 1),
+            "Failed setting sticky parameters");
+    ZS2_unwrap(
+            ZL_DCtx_setParameter(dctx.get(), ZL_DParam_nbWorkers, nbWorkers),
+            "Failed setting nbWorkers");
+    ZL_WorkerPool const workerPool = pool.get();
+    ZS2_unwrap(
+            ZL_DCtx_setWorkerPool(dctx.get(), &workerPool),
+            "Failed attaching worker pool");
+    std::vector<uint8_t> decompressed(src.size());
+    for (auto _ : state) {
+        size_t const dSize = ZS2_unwrap(
+                ZL_DCtx_decompress(
+                        dctx.get(),
+                        decompressed.data(),
+                        decompressed.size(),
+                        compressed.data(),
+                        cSize),
+                "Failed decompressing");
+        if (dSize != src.size()) {
+            throw std::runtime_error{ "Failed roundtrip testing" };
+        }
+        benchmark::DoNotOptimize(decompressed);
+        benchmark::ClobberMemory();
+    }
+    if (getStringView(decompressed) != src) {
+        throw std::runtime_error{ "Failed roundtrip testing" };
+    }
+    setCounters(state, src.size(), cSize);
+}
+
+void registerBenchmark(
+        const std::shared_ptr<BenchmarkData>& corpus,
+        bool rowGroups,
+        int nbWorkers)
+{
+    std::string const graph = rowGroups
+            ? fmt::format("RowGroups / Workers={}", nbWorkers)
+            : std::string("Whole");
+    // Workers run on other threads: measure wall-clock time
+    auto* const compressBM = RegisterBenchmark(
+            fmt::format("E2E / Parquet / {} / {} / Compress", corpus->name(), graph),
+            [corpus, rowGroups, nbWorkers](benchmark::State& state) {
+                benchCompression(state, corpus, rowGroups, nbWorkers);
+            });
+    if (compressBM != nullptr) {
+        compressBM->UseRealTime()->Iterations(1);
+    }
+    auto* const decompressBM = RegisterBenchmark(
+            fmt::format(
+                    "E2E / Parquet / {} / {} / Decompress", corpus->name(), graph),
+            [corpus, rowGroups, nbWorkers](benchmark::State& state) {
+                benchDecompression(state, corpus, rowGroups, nbWorkers);
+            });
+    if (decompressBM != nullptr) {
+        decompressBM->UseRealTime()->Iterations(1);
+    }
+}
+
+} // namespace
+
+void registerBenchmarks()
+{
+    // Row groups of 1M rows are about 20 MiB
+    std::vector<std::shared_ptr<BenchmarkData>> corpora = {
+        std::make_shared<ParquetData>(256 << 20, 1 << 20),
+        std::make_shared<ParquetData>(2 * kGiB, 1 << 20),
+        std::make_shared<ParquetData>(4 * kGiB, 1 << 20),
+    };
+    std::vector<int> nbWorkersList = { 1, 2, 4, 8, 16 };
+    int const nbCores = (int)std::thread::hardware_concurrency();
+    if (nbCores > nbWorkersList.back()) {
+        nbWorkersList.push_back(nbCores);
+    }
+    for (auto const& corpus : corpora) {
+        // Baseline: the whole file in a single chunk
+        registerBenchmark(corpus, false, 1);
+        for (int const nbWorkers : nbWorkersList) {
+            registerBenchmark(corpus, true, nbWorkers);
+        }
+    }
+}
+
+} // namespace zstrong::bench::e2e::parquet
@@ -0,0 +1,13 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+namespace zstrong::bench::e2e::parquet {
+
+/**
+ * Registers throughput benchmarks of the Parquet graphs on generated multi-GB
+ * files, whose row groups are compressed with an increasing number of workers.
+ */
+void registerBenchmarks();
+
+} // namespace zstrong::bench::e2e::parquet
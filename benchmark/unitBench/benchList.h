@@ -75,6 +75,7 @@ static size_t out_identical(const void* src, size_t srcSize)
 #include "benchmark/unitBench/scenarios/zstd.h"
 
 // openzl standard codecs
+#include "benchmark/unitBench/scenarios/codecs/dedup.h"
 #include "benchmark/unitBench/scenarios/codecs/delta.h"
 #include "benchmark/unitBench/scenarios/codecs/dispatch_by_tag.h"
 #include "benchmark/unitBench/scenarios/codecs/dispatch_string.h"
@@ -82,11 +83,14 @@ static size_t out_identical(const void* src, size_t srcSize)
 #include "benchmark/unitBench/scenarios/codecs/estimate.h"
 #include "benchmark/unitBench/scenarios/codecs/flatpack.h"
 #include "benchmark/unitBench/scenarios/codecs/huffman.h"
+#include "benchmark/unitBench/scenarios/codecs/pfor.h"
+#include "benchmark/unitBench/scenarios/codecs/rans.h"
 #include "benchmark/unitBench/scenarios/codecs/rolz.h"
 #include "benchmark/unitBench/scenarios/codecs/tokenize.h"
 #include "benchmark/unitBench/scenarios/codecs/transpose.h"
 
 // format-specific parsers
+#include "benchmark/unitBench/scenarios/misc/hash_table.h"
 #include "benchmark/unitBench/scenarios/misc/id_list_features.h"
 #include "benchmark/unitBench/scenarios/misc/sao.h"
 
@@ -411,6 +415,8 @@ Bench_Entry const scenarioList[] = {
     { "deltaDecode32", deltaDecode32_wrapper, .outSize = out_identical },
     { "deltaEncode64", deltaEncode64_wrapper, .outSize = out_identical },
     { "deltaDecode64", deltaDecode64_wrapper, .outSize = out_identical },
+    { "cdcCandidates", cdcCandidates_wrapper, .outSize = cdcCandidates_outSize },
+    { "dedupChunksZstd", .graphF = dedupChunks_zstdGraph },
     { "deltaFieldLZ32", .graphF = delta_fieldLZ32Graph },
     { "deltaFieldLZ64", .graphF = delta_fieldLZ64Graph },
     { "dimensionality1", dimensionality1_wrapper, .outSize=out_identical },
@@ -447,10 +453,22 @@ Bench_Entry const scenarioList[] = {
     { "id_score_list_features", id_score_list_features_wrapper },
     { "largeHuffmanEncode", largeHuffmanEncode_wrapper, .display = largeHuffmanEncode_displayResult },
     { "largeHuffmanDecode", largeHuffmanDecode_wrapper, .display = largeHuffmanDecode_displayResult },
+    { "mapTokensSwiss32", mapTokensSwiss32_wrapper, .prep = mapTokens32_prep },
+    { "mapTokensChained32", mapTokensChained32_wrapper, .prep = mapTokens32_prep },
+    { "mapTokensSwiss64", mapTokensSwiss64_wrapper, .prep = mapTokens64_prep },
+    { "mapTokensChained64", mapTokensChained64_wrapper, .prep = mapTokens64_prep },
+    { "pforEncode32", pforEncode32_wrapper, .outSize = pforEncode_outSize },
+    { "pforDecode32", pforDecode_wrapper, .prep = pforDecode32_preparation, .outSize = pforDecode_outSize, .display = decoderResult },
+    { "pforEncode64", pforEncode64_wrapper, .outSize = pforEncode_outSize },
+    { "pforDecode64", pforDecode_wrapper, .prep = pforDecode64_preparation, .outSize = pforDecode_outSize, .display = decoderResult },
     { "rangePack32", .graphF = rangepack_fieldLZ32Graph },
     { "rangePack64", .graphF = rangepack_fieldLZ64Graph },
     { "rangePack32zstd", .graphF = rangepack32_zstdGraph },
     { "rangePack64zstd", .graphF = rangepack64_zstdGraph },
+    { "ransEncode8", ransEncode8_wrapper, .outSize = ransEncode_outSize },
+    { "ransDecode8", ransDecode_wrapper, .prep = ransDecode8_preparation, .outSize = ransDecode_outSize, .display = ransDecode_displayResult },
+    { "ransEncode16", ransEncode16_wrapper, .outSize = ransEncode_outSize },
+    { "ransDecode16", ransDecode_wrapper, .prep = ransDecode16_preparation, .outSize = ransDecode_outSize, .display = ransDecode_displayResult },
     { "rolz_c", rolzc_wrapper },
     { "sao_v1", .graphF=sao_graph_v1 },
     { "saoIngest", saoIngest_wrapper },
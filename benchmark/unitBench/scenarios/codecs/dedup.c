@@ -0,0 +1,40 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "benchmark/unitBench/scenarios/codecs/dedup.h"
+
+#include "openzl/codecs/dedup/encode_cdc_kernel.h"
+#include "openzl/common/assertion.h"
+#include "openzl/compress/private_nodes.h" // ZL_GRAPH_DELTA_FIELD_LZ
+#include "openzl/zl_public_nodes.h"
+
+size_t cdcCandidates_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload)
+{
+    (void)customPayload;
+    size_t const dstSize = ZS_cdcCandidatesWords(srcSize) * sizeof(uint64_t);
+    ZL_REQUIRE_GE(dstCapacity, dstSize);
+    ZS_CdcParams const params = ZS_cdcParams(ZL_DEDUP_CHUNKS_AVG_SIZE_DEFAULT);
+    ZS_cdcFindCandidates(dst, src, srcSize, params.maskBits);
+    return dstSize;
+}
+
+size_t cdcCandidates_outSize(void const* src, size_t srcSize)
+{
+    (void)src;
+    return ZS_cdcCandidatesWords(srcSize) * sizeof(uint64_t);
+}
+
+ZL_GraphID dedupChunks_zstdGraph(ZL_Compressor* cgraph)
+{
+    ZL_GraphID const successors[] = {
+        ZL_GRAPH_ZSTD,
+        ZL_GRAPH_FIELD_LZ,
+        ZL_GRAPH_DELTA_FIELD_LZ,
+    };
+    return ZL_Compressor_registerStaticGraph_fromNode(
+            cgraph, ZL_NODE_DEDUP_CHUNKS, successors, 3);
+}
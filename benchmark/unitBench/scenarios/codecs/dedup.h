@@ -0,0 +1,39 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_DEDUP_H
+#define ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_DEDUP_H
+
+#include <stddef.h>
+
+#include "openzl/zl_compressor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Content-defined chunking : marks the candidate chunk boundaries,
+ * for the default average chunk size
+ */
+size_t cdcCandidates_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+/**
+ * Calculate output size for cdcCandidates
+ */
+size_t cdcCandidates_outSize(void const* src, size_t srcSize);
+
+/**
+ * Deduplicates chunks, then compresses unique chunks with zstd
+ */
+ZL_GraphID dedupChunks_zstdGraph(ZL_Compressor* cgraph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_DEDUP_H
@@ -0,0 +1,128 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "benchmark/unitBench/scenarios/codecs/pfor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "openzl/codecs/pfor/decode_pfor_kernel.h"
+#include "openzl/codecs/pfor/encode_pfor_kernel.h"
+#include "openzl/common/assertion.h"
+#include "openzl/shared/mem.h"
+
+/* Benchmark format :
+ * [eltWidth : 1 byte][nbElts : LE32] followed by the PFOR blocks. */
+#define PFOR_BENCH_HEADER_SIZE 5
+
+/// @returns the size of the benchmark frame written into @p dst
+static size_t pforEncode(
+        void* dst,
+        size_t dstCapacity,
+        const void* src,
+        size_t srcSize,
+        size_t eltWidth)
+{
+    size_t const nbElts = srcSize / eltWidth;
+    uint8_t* const op   = dst;
+    ZL_REQUIRE_GE(
+            dstCapacity,
+            PFOR_BENCH_HEADER_SIZE + ZS_pforEncodeBound(nbElts, eltWidth));
+    op[0] = (uint8_t)eltWidth;
+    ZL_writeLE32(op + 1, (uint32_t)nbElts);
+    return PFOR_BENCH_HEADER_SIZE
+            + ZS_pforEncode(
+                    op + PFOR_BENCH_HEADER_SIZE,
+                    dstCapacity - PFOR_BENCH_HEADER_SIZE,
+                    src,
+                    nbElts,
+                    eltWidth);
+}
+
+size_t pforEncode32_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload)
+{
+    (void)customPayload;
+    return pforEncode(dst, dstCapacity, src, srcSize, 4);
+}
+
+size_t pforEncode64_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload)
+{
+    (void)customPayload;
+    return pforEncode(dst, dstCapacity, src, srcSize, 8);
+}
+
+size_t pforEncode_outSize(void const* src, size_t srcSize)
+{
+    (void)src;
+    // The bound is largest for 1-byte elements
+    return PFOR_BENCH_HEADER_SIZE + ZS_pforEncodeBound(srcSize, 1);
+}
+
+static size_t
+pforDecode_preparation(void* src, size_t srcSize, size_t eltWidth)
+{
+    srcSize -= srcSize % eltWidth;
+    size_t const dstCapacity = PFOR_BENCH_HEADER_SIZE
+            + ZS_pforEncodeBound(srcSize / eltWidth, eltWidth);
+
+    uint8_t* const dst = (uint8_t*)malloc(dstCapacity);
+    ZL_REQUIRE_NN(dst);
+    size_t const csize = pforEncode(dst, dstCapacity, src, srcSize, eltWidth);
+    ZL_REQUIRE_LE(csize, srcSize);
+    memcpy(src, dst, csize);
+    free(dst);
+    ZL_LOG(V, "prepared %zu -> %zu", srcSize, csize);
+    return csize;
+}
+
+size_t
+pforDecode32_preparation(void* src, size_t srcSize, const BenchPayload* bp)
+{
+    (void)bp;
+    return pforDecode_preparation(src, srcSize, 4);
+}
+
+size_t
+pforDecode64_preparation(void* src, size_t srcSize, const BenchPayload* bp)
+{
+    (void)bp;
+    return pforDecode_preparation(src, srcSize, 8);
+}
+
+size_t pforDecode_outSize(void const* src, size_t srcSize)
+{
+    ZL_REQUIRE_GE(srcSize, PFOR_BENCH_HEADER_SIZE);
+    uint8_t const* const ip = src;
+    return ip[0] * (size_t)ZL_readLE32(ip + 1);
+}
+
+size_t pforDecode_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload)
+{
+    (void)customPayload;
+    ZL_REQUIRE_GE(srcSize, PFOR_BENCH_HEADER_SIZE);
+    uint8_t const* const ip = src;
+    size_t const eltWidth   = ip[0];
+    size_t const nbElts     = ZL_readLE32(ip + 1);
+    ZL_REQUIRE_LE(nbElts * eltWidth, dstCapacity);
+    ZL_REQUIRE_SUCCESS(ZS_pforDecode(
+            dst,
+            nbElts,
+            eltWidth,
+            ip + PFOR_BENCH_HEADER_SIZE,
+            srcSize - PFOR_BENCH_HEADER_SIZE));
+    return nbElts * eltWidth;
+}
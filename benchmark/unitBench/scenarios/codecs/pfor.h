@@ -0,0 +1,63 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_PFOR_H
+#define ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_PFOR_H
+
+#include <stddef.h>
+#include "benchmark/unitBench/bench_entry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * PFOR encoding wrapper functions, for 32-bit and 64-bit integers
+ */
+size_t pforEncode32_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+size_t pforEncode64_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+/**
+ * Calculate output size for PFOR encoding
+ */
+size_t pforEncode_outSize(void const* src, size_t srcSize);
+
+/**
+ * Preparation functions for PFOR decoding : encode the input
+ */
+size_t
+pforDecode32_preparation(void* src, size_t srcSize, const BenchPayload* bp);
+
+size_t
+pforDecode64_preparation(void* src, size_t srcSize, const BenchPayload* bp);
+
+/**
+ * Calculate output size for PFOR decoding
+ */
+size_t pforDecode_outSize(void const* src, size_t srcSize);
+
+/**
+ * PFOR decoding wrapper function, for all integer widths
+ */
+size_t pforDecode_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_PFOR_H
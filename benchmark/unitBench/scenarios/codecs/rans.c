@@ -0,0 +1,223 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+/// MinGW: Use the ANSI stdio functions (e.g. to get correct printf for 64-bits)
+#undef __USE_MINGW_ANSI_STDIO
+#define __USE_MINGW_ANSI_STDIO 1
+
+#include "benchmark/unitBench/scenarios/codecs/rans.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "openzl/codecs/entropy/decode_rans_kernel.h"
+#include "openzl/codecs/entropy/encode_rans_kernel.h"
+#include "openzl/common/assertion.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+
+/* Benchmark format :
+ * [eltWidth : 1 byte][nbElts : LE32][nbSymbols : LE32][norm : LE16 each]
+ * followed by the rANS payload. */
+#define RANS_BENCH_HEADER_SIZE 9
+
+/// @returns the size of the benchmark frame written into @p dst
+static size_t ransEncode(
+        void* dst,
+        size_t dstCapacity,
+        const void* src,
+        size_t srcSize,
+        size_t eltWidth)
+{
+    size_t const nbElts    = srcSize / eltWidth;
+    size_t const maxSymbol = eltWidth == 1 ? 255 : 65535;
+    unsigned* const count  = calloc(maxSymbol + 1, sizeof(unsigned));
+    ZL_REQUIRE_NN(count);
+    size_t nbSymbols   = 0;
+    size_t cardinality = 0;
+    for (size_t i = 0; i < nbElts; ++i) {
+        size_t const symbol = eltWidth == 1 ? ((const uint8_t*)src)[i]
+                                            : ZL_readLE16((const uint8_t*)src
+                                                          + 2 * i);
+        cardinality += count[symbol]++ == 0;
+        nbSymbols = ZL_MAX(nbSymbols, symbol + 1);
+    }
+    ZL_REQUIRE_GE(cardinality, 2, "rANS can't encode constant data");
+
+    unsigned const tableLog = ZS_ransOptimalTableLog(
+            nbElts, cardinality, ZS_ransMaxTableLog(eltWidth));
+    uint16_t* const norm = malloc(nbSymbols * sizeof(uint16_t));
+    ZS_RansCElt* const ctable = malloc(nbSymbols * sizeof(ZS_RansCElt));
+    ZL_REQUIRE_NN(norm);
+    ZL_REQUIRE_NN(ctable);
+    ZL_REQUIRE_SUCCESS(
+            ZS_ransNormalizeCount(norm, count, nbSymbols, nbElts, tableLog));
+    ZS_ransBuildCTable(ctable, norm, nbSymbols, tableLog);
+
+    uint8_t* op = dst;
+    ZL_REQUIRE_GE(
+            dstCapacity,
+            RANS_BENCH_HEADER_SIZE + 2 * nbSymbols
+                    + ZS_ransEncodeBound(nbElts));
+    op[0] = (uint8_t)eltWidth;
+    ZL_writeLE32(op + 1, (uint32_t)nbElts);
+    ZL_writeLE32(op + 5, (uint32_t)nbSymbols);
+    op += RANS_BENCH_HEADER_SIZE;
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        ZL_writeLE16(op + 2 * s, norm[s]);
+    }
+    op += 2 * nbSymbols;
+
+    ZL_Report const ret = ZS_ransEncode(
+            op,
+            ZS_ransEncodeBound(nbElts),
+            src,
+            nbElts,
+            eltWidth,
+            ctable,
+            tableLog);
+    ZL_REQUIRE_SUCCESS(ret);
+    op += ZL_validResult(ret);
+
+    free(ctable);
+    free(norm);
+    free(count);
+    return (size_t)(op - (uint8_t*)dst);
+}
+
+size_t ransEncode8_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload)
+{
+    (void)customPayload;
+    return ransEncode(dst, dstCapacity, src, srcSize, 1);
+}
+
+size_t ransEncode16_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload)
+{
+    (void)customPayload;
+    return ransEncode(dst, dstCapacity, src, srcSize, 2);
+}
+
+size_t ransEncode_outSize(void const* src, size_t srcSize)
+{
+    (void)src;
+    return RANS_BENCH_HEADER_SIZE + 2 * 65536 + ZS_ransEncodeBound(srcSize);
+}
+
+static size_t
+ransDecode_preparation(void* src, size_t srcSize, size_t eltWidth)
+{
+    srcSize -= srcSize % eltWidth;
+    size_t const nbSymbols   = eltWidth == 1 ? 256 : 65536;
+    size_t const dstCapacity = RANS_BENCH_HEADER_SIZE + 2 * nbSymbols
+            + ZS_ransEncodeBound(srcSize / eltWidth);
+
+    uint8_t* const dst = (uint8_t*)malloc(dstCapacity);
+    ZL_REQUIRE_NN(dst);
+    size_t const csize = ransEncode(dst, dstCapacity, src, srcSize, eltWidth);
+    ZL_REQUIRE_LE(csize, srcSize);
+    memcpy(src, dst, csize);
+    free(dst);
+    ZL_LOG(V, "prepared %zu -> %zu", srcSize, csize);
+    return csize;
+}
+
+size_t
+ransDecode8_preparation(void* src, size_t srcSize, const BenchPayload* bp)
+{
+    (void)bp;
+    return ransDecode_preparation(src, srcSize, 1);
+}
+
+size_t
+ransDecode16_preparation(void* src, size_t srcSize, const BenchPayload* bp)
+{
+    (void)bp;
+    return ransDecode_preparation(src, srcSize, 2);
+}
+
+size_t ransDecode_outSize(void const* src, size_t srcSize)
+{
+    ZL_REQUIRE_GE(srcSize, RANS_BENCH_HEADER_SIZE);
+    uint8_t const* const ip = src;
+    return ip[0] * (size_t)ZL_readLE32(ip + 1);
+}
+
+size_t ransDecode_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload)
+{
+    (void)customPayload;
+    ZL_REQUIRE_GE(srcSize, RANS_BENCH_HEADER_SIZE);
+    uint8_t const* ip         = src;
+    uint8_t const* const iend = ip + srcSize;
+    size_t const eltWidth     = ip[0];
+    size_t const nbElts       = ZL_readLE32(ip + 1);
+    size_t const nbSymbols    = ZL_readLE32(ip + 5);
+    ip += RANS_BENCH_HEADER_SIZE;
+    ZL_REQUIRE_LE(nbElts * eltWidth, dstCapacity);
+    ZL_REQUIRE_LE(nbSymbols, 65536);
+    ZL_REQUIRE_LE(2 * nbSymbols, (size_t)(iend - ip));
+
+    // Table construction is part of decoding
+    uint16_t norm[65536];
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        norm[s] = ZL_readLE16(ip + 2 * s);
+    }
+    ip += 2 * nbSymbols;
+    ZL_Report const tableLog = ZS_ransValidNorm(norm, nbSymbols, eltWidth);
+    ZL_REQUIRE_SUCCESS(tableLog);
+    void* const dtable = malloc(
+            ZS_ransDTableSize((unsigned)ZL_validResult(tableLog), eltWidth));
+    ZL_REQUIRE_NN(dtable);
+    ZS_ransBuildDTable(
+            dtable,
+            norm,
+            nbSymbols,
+            (unsigned)ZL_validResult(tableLog),
+            eltWidth);
+
+    ZL_REQUIRE_SUCCESS(ZS_ransDecode(
+            dst,
+            nbElts,
+            eltWidth,
+            ip,
+            (size_t)(iend - ip),
+            dtable,
+            (unsigned)ZL_validResult(tableLog)));
+    free(dtable);
+
+    return nbElts * eltWidth;
+}
+
+void ransDecode_displayResult(
+        const char* srcname,
+        const char* fname,
+        BMK_runTime_t rt,
+        size_t srcSize)
+{
+    double const sec           = rt.nanoSecPerRun / 1e+9;
+    double const nbRunsPerSec  = 1. / sec;
+    double const nbBytesPerSec = nbRunsPerSec * (double)rt.sumOfReturn;
+
+    printf("%s: decode %zu bytes into %zu bytes in %.2f ms  ==> %.1f MB/s \n",
+           fname,
+           srcSize,
+           rt.sumOfReturn,
+           sec * 1000.,
+           nbBytesPerSec / (1 << 20));
+    (void)srcname;
+    fflush(NULL);
+}
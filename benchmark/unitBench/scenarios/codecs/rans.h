@@ -0,0 +1,73 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_RANS_H
+#define ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_RANS_H
+
+#include <stddef.h>
+#include "benchmark/unitBench/bench_entry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * rANS encoding wrapper functions, for 8-bit and 16-bit symbols
+ */
+size_t ransEncode8_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+size_t ransEncode16_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+/**
+ * Calculate output size for rANS encoding
+ */
+size_t ransEncode_outSize(void const* src, size_t srcSize);
+
+/**
+ * Preparation functions for rANS decoding :
+ * encode the input, along with its normalized counts
+ */
+size_t
+ransDecode8_preparation(void* src, size_t srcSize, const BenchPayload* bp);
+
+size_t
+ransDecode16_preparation(void* src, size_t srcSize, const BenchPayload* bp);
+
+/**
+ * Calculate output size for rANS decoding
+ */
+size_t ransDecode_outSize(void const* src, size_t srcSize);
+
+/**
+ * rANS decoding wrapper function, for both symbol widths
+ */
+size_t ransDecode_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+/**
+ * Display function for rANS decoding results
+ */
+void ransDecode_displayResult(
+        const char* srcname,
+        const char* fname,
+        BMK_runTime_t rt,
+        size_t srcSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_CODECS_RANS_H
@@ -0,0 +1,93 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+/// MinGW: Use the ANSI stdio functions (e.g. to get correct printf for 64-bits)
+#undef __USE_MINGW_ANSI_STDIO
+#define __USE_MINGW_ANSI_STDIO 1
+
+/* ===   Dependencies   === */
+#include "benchmark/unitBench/scenarios/misc/hash_table.h"
+
+#include <stdio.h>  // printf
+#include <stdlib.h> // abort, exit
+
+#include "openzl/common/map.h"
+#include "openzl/shared/mem.h"
+
+ZL_DECLARE_MAP_TYPE_WITH_IMPL(SwissMap32, uint32_t, uint32_t, SwissTable);
+ZL_DECLARE_MAP_TYPE_WITH_IMPL(ChainedMap32, uint32_t, uint32_t, GenericTable);
+ZL_DECLARE_MAP_TYPE_WITH_IMPL(SwissMap64, uint64_t, uint32_t, SwissTable);
+ZL_DECLARE_MAP_TYPE_WITH_IMPL(ChainedMap64, uint64_t, uint32_t, GenericTable);
+
+#define MAP_TOKENS_DEFAULT_CARDINALITY 4096
+
+static uint64_t mapTokens_cardinality(const BenchPayload* bp)
+{
+    if (bp->intParam < 0) {
+        printf("Parameter cardinality (%i) must be positive \n", bp->intParam);
+        exit(1);
+    }
+    uint64_t const cardinality = bp->intParam
+            ? (uint64_t)bp->intParam
+            : MAP_TOKENS_DEFAULT_CARDINALITY;
+    printf("Preparing map scenario with a cardinality of %llu \n",
+           (unsigned long long)cardinality);
+    return cardinality;
+}
+
+// Tokens are scrambled, so that they don't end up in consecutive slots
+size_t mapTokens32_prep(void* src, size_t srcSize, const BenchPayload* bp)
+{
+    uint64_t const cardinality = mapTokens_cardinality(bp);
+    uint8_t* const src8        = src;
+    for (size_t n = 0; n + 4 <= srcSize; n += 4) {
+        uint32_t const token = ZL_readLE32(src8 + n);
+        ZL_writeLE32(src8 + n, (uint32_t)(token % cardinality) * 0x9E3779B1u);
+    }
+    return srcSize;
+}
+
+size_t mapTokens64_prep(void* src, size_t srcSize, const BenchPayload* bp)
+{
+    uint64_t const cardinality = mapTokens_cardinality(bp);
+    uint8_t* const src8        = src;
+    for (size_t n = 0; n + 8 <= srcSize; n += 8) {
+        uint64_t const token = ZL_readLE64(src8 + n);
+        ZL_writeLE64(
+                src8 + n, (token % cardinality) * 0x9E3779B97F4A7C15ULL);
+    }
+    return srcSize;
+}
+
+#define MAP_TOKENS_WRAPPER(name, Map, nbBits)                            \
+    size_t name##_wrapper(                                               \
+            const void* src,                                             \
+            size_t srcSize,                                              \
+            void* dst,                                                   \
+            size_t dstCapacity,                                          \
+            void* customPayload)                                         \
+    {                                                                    \
+        (void)dst;                                                       \
+        (void)dstCapacity;                                               \
+        (void)customPayload;                                             \
+        const uint8_t* const src8 = src;                                 \
+        size_t const nbTokens     = srcSize / sizeof(uint##nbBits##_t);  \
+        Map map                   = Map##_create((uint32_t)nbTokens);    \
+        for (size_t n = 0; n < nbTokens; ++n) {                          \
+            Map##_Entry const entry = {                                  \
+                ZL_readLE##nbBits(src8 + n * sizeof(uint##nbBits##_t)), \
+                (uint32_t)Map##_size(&map),                              \
+            };                                                           \
+            Map##_Insert const insert = Map##_insert(&map, &entry);      \
+            if (insert.badAlloc) {                                       \
+                abort();                                                 \
+            }                                                            \
+        }                                                                \
+        size_t const cardinality = Map##_size(&map);                     \
+        Map##_destroy(&map);                                             \
+        return cardinality;                                              \
+    }
+
+MAP_TOKENS_WRAPPER(mapTokensSwiss32, SwissMap32, 32)
+MAP_TOKENS_WRAPPER(mapTokensChained32, ChainedMap32, 32)
+MAP_TOKENS_WRAPPER(mapTokensSwiss64, SwissMap64, 64)
+MAP_TOKENS_WRAPPER(mapTokensChained64, ChainedMap64, 64)
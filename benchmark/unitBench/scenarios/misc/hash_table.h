@@ -0,0 +1,58 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_MISC_HASH_TABLE_H
+#define ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_MISC_HASH_TABLE_H
+
+#include <stddef.h>
+#include "benchmark/unitBench/bench_entry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Preparation functions for the map scenarios.
+ * Reduce the input, read as 32-bit or 64-bit tokens, to a cardinality of
+ * `--param` distinct tokens (default: 4096).
+ */
+size_t mapTokens32_prep(void* src, size_t srcSize, const BenchPayload* bp);
+size_t mapTokens64_prep(void* src, size_t srcSize, const BenchPayload* bp);
+
+/**
+ * Builds the alphabet of the input tokens, like the tokenize encoder does,
+ * using either the SwissTable or the GenericTable map implementation.
+ * Returns the number of distinct tokens.
+ */
+size_t mapTokensSwiss32_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+size_t mapTokensChained32_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+size_t mapTokensSwiss64_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+size_t mapTokensChained64_wrapper(
+        const void* src,
+        size_t srcSize,
+        void* dst,
+        size_t dstCapacity,
+        void* customPayload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZSTRONG_BENCHMARK_UNITBENCH_SCENARIOS_MISC_HASH_TABLE_H
@@ -17,6 +17,7 @@
 #include "tools/fileio/fileio.h"
 
 #include "benchmark/unitBench/benchList.h" // list of functions & graphs to benchmark
+#include "openzl/shared/cpu.h" // ZL_cpuFeatures_setMask
 #include "openzl/zl_compress.h"
 #include "openzl/zl_data.h"       // ZL_DataArenaType
 #include "openzl/zl_decompress.h" // ZL_DCtx_create, ZL_DCtx_setStreamArena
@@ -597,6 +598,35 @@ static int parseInt(const char* cmd)
 
 #define GET_ZU_FLAG(flagStr, zuVar) GET_NUM_FLAG(flagStr, SET_ZU(zuVar))
 
+/* Dispatch levels, each one enabling the features of the previous ones */
+static const struct {
+    const char* name;
+    unsigned features;
+} cpuLevels[] = {
+    { "scalar", 0 },
+    { "ssse3", ZL_CpuFeature_ssse3 },
+    { "sse42", ZL_CpuFeature_ssse3 | ZL_CpuFeature_sse42 },
+    { "bmi2", ZL_CpuFeature_ssse3 | ZL_CpuFeature_sse42 | ZL_CpuFeature_bmi2 },
+    { "avx2",
+      ZL_CpuFeature_ssse3 | ZL_CpuFeature_sse42 | ZL_CpuFeature_bmi2
+              | ZL_CpuFeature_avx2 },
+    { "native", ZL_CPU_FEATURES_ALL },
+};
+
+static void setCpuLevel(const char* name)
+{
+    for (size_t n = 0; n < sizeof(cpuLevels) / sizeof(cpuLevels[0]); n++) {
+        if (!strcmp(name, cpuLevels[n].name)) {
+            ZL_cpuFeatures_setMask(cpuLevels[n].features);
+            return;
+        }
+    }
+    EXIT("unknown cpu level %s (scalar, ssse3, sse42, bmi2, avx2, native)",
+         name);
+}
+
+#define GET_CPU_FLAG(flagStr) GET_NUM_FLAG(flagStr, setCpuLevel(toParse))
+
 #define CMD_FLAG(flagStr, code)        \
     if (isCommand(command, flagStr)) { \
         code;                          \
@@ -620,6 +650,8 @@ static int help(const char* exename)
     printf("  -i=#      Test duration per file, in seconds \n");
     printf("  -B=#      Split input into blocks of size # bytes \n");
     printf(" --csv      output result in csv format \n");
+    printf(" --cpu=#    restrict SIMD kernels to a level : scalar, ssse3, \n");
+    printf("            sse42, bmi2, avx2, or native (default) \n");
     printf(" --save-result  save the 1st generated artifact into '%s' \n",
            artifactFilename);
     printf("  -h        This help \n");
@@ -690,6 +722,8 @@ int main(int argc, const char* argv[])
 
         CMD_FLAG("--save-result", bp.saveArtifact = true);
 
+        GET_CPU_FLAG("--cpu");
+
         CMD_FLAG("--", argnb++; break); // No more command after this flag
 
         break; // not a command => no more commmand after this point
@@ -124,6 +124,45 @@ void writeTrace(CCtx& cctx, const CompressArgs& args)
     }
 }
 
+/**
+ * Compresses @p input as a stream of blocks, reading it sequentially block by
+ * block and writing compressed data into @p output as soon as it is produced,
+ * so that only one block of input and one block of compressed data are held
+ * in memory at any time. The input doesn't need to be seekable, nor its size
+ * to be known: it is stored into @p inputSize.
+ *
+ * @return the compressed size
+ */
+size_t compressStream(
+        CCtx& cctx,
+        tools::io::Input& input,
+        tools::io::Output& output,
+        size_t& inputSize)
+{
+    std::string srcBuffer(ZL_STREAMBLOCKSIZE_DEFAULT, '\0');
+    std::string dstBuffer(ZL_compressBound(ZL_STREAMBLOCKSIZE_DEFAULT), '\0');
+    size_t compressedSize = 0;
+    inputSize             = 0;
+    ZL_FlushMode mode;
+    do {
+        const size_t srcSize = input.read(srcBuffer.data(), srcBuffer.size());
+        inputSize += srcSize;
+        // A short read means the end of the input
+        mode = srcSize < srcBuffer.size() ? ZL_FlushMode_end
+                                          : ZL_FlushMode_continue;
+        ZL_InBuffer in{ srcBuffer.data(), srcSize, 0 };
+        size_t remaining;
+        do {
+            ZL_OutBuffer out{ dstBuffer.data(), dstBuffer.size(), 0 };
+            remaining = cctx.unwrap(
+                    ZL_CCtx_compressStream(cctx.get(), &in, &out, mode));
+            output.write({ dstBuffer.data(), out.pos });
+            compressedSize += out.pos;
+        } while (in.pos < in.size || remaining != 0);
+    } while (mode != ZL_FlushMode_end);
+    return compressedSize;
+}
+
 int performCompression(const CompressArgs& args)
 {
     // create compressor and context
@@ -142,28 +181,33 @@ int performCompression(const CompressArgs& args)
     auto& input  = *args.input;
     auto& output = *args.output;
 
-    // ahead of time.
-    const auto inputSize = input.size().value();
-    // TODO: Size limitations should be a library feature
-    if (inputSize > 2 * BYTES_TO_GiB) {
-        throw std::runtime_error(
-                "Chunking support is required for compressing inputs larger than 2 GiB. ");
+    // Large inputs, and inputs which can't be measured ahead of time like
+    // pipes, are compressed as a stream of blocks, instead of requiring
+    // buffers for the whole input and frame
+    const bool streaming = !input.hasKnownSize()
+            || input.size().value() > 2 * BYTES_TO_GiB;
+
+    size_t inputSize = 0;
+    std::string dstBuffer;
+    poly::string_view srcBuffer;
+    if (!streaming) {
+        inputSize = input.size().value();
+        Logger::log(VERBOSE1, "Input size: ", inputSize);
+        dstBuffer = std::string(ZL_compressBound(inputSize), '\0');
+        // read the input
+        srcBuffer = input.contents();
     }
-    Logger::log(VERBOSE1, "Input size: ", inputSize);
-
-    std::string dstBuffer = std::string(ZL_compressBound(inputSize), '\0');
-
-    // read the input
-    const auto srcBuffer = input.contents();
 
     // compress
     const auto start = std::chrono::steady_clock::now();
-    const double start_time_ms = std::chrono::duration<double, std::milli>(start.time_since_epoch()).count();
-    fprintf(stderr, "Start: %.4f ms\n", start_time_ms);
 
     size_t compressedSize;
     try {
-        compressedSize = cctx.compressSerial(dstBuffer, srcBuffer);
+        if (streaming) {
+            compressedSize = compressStream(cctx, input, output, inputSize);
+        } else {
+            compressedSize = cctx.compressSerial(dstBuffer, srcBuffer);
+        }
     } catch (const openzl::Exception&) {
         // if tracing, write the error trace to the output file
         if (args.traceOutput) {
@@ -175,9 +219,6 @@ int performCompression(const CompressArgs& args)
     util::logWarnings(cctx);
 
     const auto end     = std::chrono::steady_clock::now();
-    const double end_time_ms = std::chrono::duration<double, std::milli>(end.time_since_epoch()).count();
-    fprintf(stderr, "end: %.4f ms\n", end_time_ms);
-
     const auto time_ms = std::chrono::duration<double, std::milli>(end - start);
 
     const auto time_s        = time_ms.count() / 1000.0;
@@ -186,16 +227,18 @@ int performCompression(const CompressArgs& args)
     const auto compressionSpeed = inputSize_mib / time_s;
 
     // write output
-    dstBuffer.resize(compressedSize);
     Logger::log_c(
             INFO,
             "Compressed %zu -> %zu (%.2fx) in %.3f ms, %.2f MiB/s",
-            srcBuffer.size(),
-            dstBuffer.size(),
-            (double)srcBuffer.size() / dstBuffer.size(),
+            inputSize,
+            compressedSize,
+            (double)inputSize / compressedSize,
             time_ms.count(),
             compressionSpeed);
-    output.write(dstBuffer);
+    if (!streaming) {
+        dstBuffer.resize(compressedSize);
+        output.write(dstBuffer);
+    }
     output.close();
 
     // if tracing, write the trace to the output file
@@ -190,10 +190,10 @@ compressProfiles()
         std::string kParquetName = "parquet";
         mp[kParquetName]         = std::make_shared<CompressProfile>(
                 kParquetName,
-                "Parquet in the canonical format (no compression, plain encoding)",
+                "Uncompressed Parquet with plain, dictionary or delta encoded pages",
                 [](ZL_Compressor* comp, void*, const ProfileArgs&) {
                     auto clustering = ZS2_createGraph_genericClustering(comp);
-                    return ZL_Parquet_registerGraph(comp, clustering);
+                    return ZL_Parquet_registerRowGroupGraph(comp, clustering);
                 });
 
         std::string kSDDLName = "sddl";
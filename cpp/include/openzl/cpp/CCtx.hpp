@@ -7,6 +7,7 @@
 #include "openzl/cpp/Compressor.hpp"
 #include "openzl/cpp/Exception.hpp"
 #include "openzl/cpp/Input.hpp"
+#include "openzl/cpp/ThreadPool.hpp"
 #include "openzl/cpp/detail/NonNullUniqueCPtr.hpp"
 #include "openzl/cpp/poly/Optional.hpp"
 #include "openzl/cpp/poly/Span.hpp"
@@ -58,6 +59,15 @@ class CCtx {
     int getParameter(CParam) const;
     void resetParameters();
 
+    /**
+     * Attaches @p pool to this CCtx, to compress Chunks in parallel.
+     * Parallelism is controlled by CParam::NbWorkers.
+     * @p pool must outlive this CCtx, or be detached with
+     * detachWorkerPool().
+     */
+    void setWorkerPool(ThreadPool& pool);
+    void detachWorkerPool();
+
     size_t compress(poly::span<char> output, poly::span<const Input> inputs);
     std::string compress(poly::span<const Input> inputs);
 
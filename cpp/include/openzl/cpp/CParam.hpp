@@ -14,5 +14,8 @@ enum class CParam {
     CompressedChecksum    = ZL_CParam_compressedChecksum,
     ContentChecksum       = ZL_CParam_contentChecksum,
     MinStreamSize         = ZL_CParam_minStreamSize,
+    NbWorkers             = ZL_CParam_nbWorkers,
+    SeekTable             = ZL_CParam_seekTable,
+    StreamBlockSize       = ZL_CParam_streamBlockSize,
 };
 }
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "openzl/cpp/Output.hpp"
+#include "openzl/cpp/ThreadPool.hpp"
 #include "openzl/cpp/detail/NonNullUniqueCPtr.hpp"
 #include "openzl/cpp/poly/Span.hpp"
 #include "openzl/cpp/poly/StringView.hpp"
@@ -19,6 +20,7 @@ enum class DParam {
     StickyParameters        = ZL_DParam_stickyParameters,
     CheckCompressedChecksum = ZL_DParam_checkCompressedChecksum,
     CheckContentChecksum    = ZL_DParam_checkContentChecksum,
+    NbWorkers               = ZL_DParam_nbWorkers,
 };
 
 class DCtx {
@@ -52,6 +54,15 @@ class DCtx {
     int getParameter(DParam) const;
     void resetParameters();
 
+    /**
+     * Attaches @p pool to this DCtx, to decode Chunks in parallel.
+     * Parallelism is controlled by DParam::NbWorkers.
+     * @p pool must outlive this DCtx, or be detached with
+     * detachWorkerPool().
+     */
+    void setWorkerPool(ThreadPool& pool);
+    void detachWorkerPool();
+
     void decompress(poly::span<Output> outputs, poly::string_view input);
     std::vector<Output> decompress(poly::string_view input);
 
@@ -61,6 +72,20 @@ class DCtx {
     size_t decompressSerial(poly::span<char> output, poly::string_view input);
     std::string decompressSerial(poly::string_view input);
 
+    /**
+     * Random access, for frames compressed with CParam::SeekTable.
+     * @p input must be exactly one complete frame.
+     * Only the Chunks needed to answer the request are decoded.
+     */
+    std::vector<Output> decompressChunkAt(
+            size_t chunkIndex,
+            poly::string_view input);
+    Output decompressRange(
+            int outputIndex,
+            size_t eltBegin,
+            size_t eltEnd,
+            poly::string_view input);
+
     void registerCustomDecoder(const ZL_MIDecoderDesc& desc);
     void registerCustomDecoder(std::shared_ptr<CustomDecoder> decoder);
 
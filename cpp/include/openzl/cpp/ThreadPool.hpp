@@ -0,0 +1,70 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "openzl/zl_common_types.h" // ZL_WorkerPool
+
+namespace openzl {
+
+/**
+ * A fixed-size pool of threads, which can be attached to a CCtx or a DCtx
+ * to let OpenZL run independent tasks concurrently.
+ *
+ * The calling thread participates in the execution of tasks, so a pool of
+ * N threads provides N+1 workers.
+ * The pool must outlive any context it is attached to.
+ */
+class ThreadPool {
+   public:
+    /// @param nbThreads number of additional threads. 0 is allowed, in which
+    /// case all tasks run on the calling thread.
+    explicit ThreadPool(size_t nbThreads);
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    /// @returns the number of threads owned by the pool.
+    size_t nbThreads() const
+    {
+        return threads_.size();
+    }
+
+    /// @returns the C interface of this pool, referencing this object.
+    ZL_WorkerPool get();
+
+    /**
+     * Runs @p task for each taskID in [0, nbTasks), concurrently,
+     * and returns once all of them are completed.
+     * Concurrent invocations are serialized.
+     */
+    void runTasks(ZL_WorkerTaskFn task, void* taskCtx, size_t nbTasks);
+
+   private:
+    void workerLoop();
+    void runAvailableTasks();
+
+    std::vector<std::thread> threads_;
+    std::mutex runMutex_; // serializes runTasks() invocations
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable done_;
+    bool stop_{ false };
+    size_t generation_{ 0 };
+
+    // Current batch, protected by mutex_
+    ZL_WorkerTaskFn task_{ nullptr };
+    void* taskCtx_{ nullptr };
+    size_t nbTasks_{ 0 };
+    size_t nextTask_{ 0 };
+    size_t nbCompleted_{ 0 };
+};
+
+} // namespace openzl
@@ -24,5 +24,58 @@ class DedupNumeric : public SimplePipeNode<DedupNumeric> {
     };
 };
 
+class DedupChunks : public Node {
+   public:
+    static constexpr NodeID node = ZL_NODE_DEDUP_CHUNKS;
+
+    static constexpr NodeMetadata<1, 3> metadata = {
+        .inputs           = { InputMetadata{ .type = Type::Serial } },
+        .singletonOutputs = { OutputMetadata{ .type = Type::Serial,
+                                              .name = "unique chunks" },
+                              OutputMetadata{ .type = Type::Numeric,
+                                              .name = "unique chunk sizes" },
+                              OutputMetadata{ .type = Type::Numeric,
+                                              .name = "chunk references" } },
+        .description =
+                "Cut the input into content-defined chunks & only keep the first copy of each chunk",
+    };
+
+    DedupChunks() = default;
+    DedupChunks(int avgChunkSize, int maxIndexedChunks)
+            : avgChunkSize_(avgChunkSize), maxIndexedChunks_(maxIndexedChunks)
+    {
+    }
+
+    NodeID baseNode() const override
+    {
+        return node;
+    }
+
+    poly::optional<NodeParameters> parameters() const override
+    {
+        LocalParams params;
+        params.addIntParam(ZL_DEDUP_CHUNKS_AVG_SIZE_PID, avgChunkSize_);
+        params.addIntParam(ZL_DEDUP_CHUNKS_MAX_INDEX_PID, maxIndexedChunks_);
+        return NodeParameters{ .localParams = std::move(params) };
+    }
+
+    GraphID operator()(
+            Compressor& compressor,
+            GraphID unique,
+            GraphID uniqueSizes,
+            GraphID refs) const
+    {
+        return buildGraph(
+                compressor,
+                std::initializer_list<GraphID>{ unique, uniqueSizes, refs });
+    }
+
+    ~DedupChunks() override = default;
+
+   private:
+    int avgChunkSize_{ ZL_DEDUP_CHUNKS_AVG_SIZE_DEFAULT };
+    int maxIndexedChunks_{ ZL_DEDUP_CHUNKS_MAX_INDEX_DEFAULT };
+};
+
 } // namespace nodes
 } // namespace openzl
@@ -0,0 +1,26 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "openzl/codecs/zl_pfor.h"
+#include "openzl/cpp/Compressor.hpp"
+#include "openzl/cpp/codecs/Metadata.hpp"
+#include "openzl/cpp/codecs/Node.hpp"
+
+namespace openzl {
+namespace nodes {
+class Pfor : public SimplePipeNode<Pfor> {
+   public:
+    static constexpr NodeID node = ZL_NODE_PFOR;
+
+    static constexpr NodeMetadata<1, 1> metadata = {
+        .inputs           = { InputMetadata{ .type = Type::Numeric } },
+        .singletonOutputs = { OutputMetadata{ .type = Type::Serial,
+                                              .name = "blocks" } },
+        .description =
+                "Bitpack blocks of ints as offsets from a base or as deltas, "
+                "with outliers stored as exceptions"
+    };
+};
+} // namespace nodes
+} // namespace openzl
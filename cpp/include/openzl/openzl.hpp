@@ -17,3 +17,4 @@
 #include "openzl/cpp/LocalParams.hpp"                // IWYU pragma: export
 #include "openzl/cpp/Output.hpp"                     // IWYU pragma: export
 #include "openzl/cpp/Selector.hpp"                   // IWYU pragma: export
+#include "openzl/cpp/ThreadPool.hpp"                 // IWYU pragma: export
@@ -40,6 +40,17 @@ void CCtx::resetParameters()
     unwrap(ZL_CCtx_resetParameters(get()));
 }
 
+void CCtx::setWorkerPool(ThreadPool& pool)
+{
+    const ZL_WorkerPool workerPool = pool.get();
+    unwrap(ZL_CCtx_setWorkerPool(get(), &workerPool));
+}
+
+void CCtx::detachWorkerPool()
+{
+    unwrap(ZL_CCtx_setWorkerPool(get(), nullptr));
+}
+
 void CCtx::refCompressor(const Compressor& compressor)
 {
     unwrap(ZL_CCtx_refCompressor(get(), compressor.get()));
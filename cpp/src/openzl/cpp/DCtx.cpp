@@ -25,6 +25,17 @@ void DCtx::resetParameters()
     unwrap(ZL_DCtx_resetParameters(get()));
 }
 
+void DCtx::setWorkerPool(ThreadPool& pool)
+{
+    const ZL_WorkerPool workerPool = pool.get();
+    unwrap(ZL_DCtx_setWorkerPool(get(), &workerPool));
+}
+
+void DCtx::detachWorkerPool()
+{
+    unwrap(ZL_DCtx_setWorkerPool(get(), nullptr));
+}
+
 void DCtx::decompress(poly::span<Output> outputs, poly::string_view input)
 {
     if (outputs.size() == 1) {
@@ -81,6 +92,45 @@ std::string DCtx::decompressSerial(poly::string_view input)
     return out;
 }
 
+std::vector<Output> DCtx::decompressChunkAt(
+        size_t chunkIndex,
+        poly::string_view input)
+{
+    FrameInfo info(input);
+    std::vector<Output> outputs(info.numOutputs());
+    std::vector<ZL_Output*> outputPtrs;
+    outputPtrs.reserve(outputs.size());
+    for (auto& output : outputs) {
+        outputPtrs.push_back(output.get());
+    }
+    unwrap(ZL_DCtx_decompressChunkAt(
+            get(),
+            outputPtrs.data(),
+            outputPtrs.size(),
+            chunkIndex,
+            input.data(),
+            input.size()));
+    return outputs;
+}
+
+Output DCtx::decompressRange(
+        int outputIndex,
+        size_t eltBegin,
+        size_t eltEnd,
+        poly::string_view input)
+{
+    Output out;
+    unwrap(ZL_DCtx_decompressRange(
+            get(),
+            out.get(),
+            outputIndex,
+            eltBegin,
+            eltEnd,
+            input.data(),
+            input.size()));
+    return out;
+}
+
 void DCtx::registerCustomDecoder(const ZL_MIDecoderDesc& desc)
 {
     unwrap(ZL_DCtx_registerMIDecoder(get(), &desc));
@@ -0,0 +1,96 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/cpp/ThreadPool.hpp"
+
+namespace openzl {
+
+ThreadPool::ThreadPool(size_t nbThreads)
+{
+    threads_.reserve(nbThreads);
+    for (size_t i = 0; i < nbThreads; ++i) {
+        threads_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeUp_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+ZL_WorkerPool ThreadPool::get()
+{
+    ZL_WorkerPool pool;
+    pool.opaque   = this;
+    pool.runTasks = [](void* opaque,
+                       ZL_WorkerTaskFn task,
+                       void* taskCtx,
+                       size_t nbTasks) {
+        static_cast<ThreadPool*>(opaque)->runTasks(task, taskCtx, nbTasks);
+    };
+    return pool;
+}
+
+void ThreadPool::runTasks(ZL_WorkerTaskFn task, void* taskCtx, size_t nbTasks)
+{
+    if (nbTasks == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_        = task;
+        taskCtx_     = taskCtx;
+        nbTasks_     = nbTasks;
+        nextTask_    = 0;
+        nbCompleted_ = 0;
+        ++generation_;
+    }
+    wakeUp_.notify_all();
+    runAvailableTasks();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return nbCompleted_ == nbTasks_; });
+    task_ = nullptr;
+}
+
+void ThreadPool::runAvailableTasks()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (task_ != nullptr && nextTask_ < nbTasks_) {
+        const size_t taskID = nextTask_++;
+        auto const task     = task_;
+        auto const taskCtx  = taskCtx_;
+        lock.unlock();
+        task(taskCtx, taskID);
+        lock.lock();
+        if (++nbCompleted_ == nbTasks_) {
+            done_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    size_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeUp_.wait(lock, [&] {
+                return stop_ || generation_ != seenGeneration;
+            });
+            if (stop_) {
+                return;
+            }
+            seenGeneration = generation_;
+        }
+        runAvailableTasks();
+    }
+}
+
+} // namespace openzl
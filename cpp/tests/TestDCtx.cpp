@@ -1,6 +1,7 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include <gtest/gtest.h>
+#include <cstring>
 #include "openzl/openzl.hpp"
 #include "openzl/zl_compressor.h"
 #include "openzl/zl_public_nodes.h"
@@ -123,6 +124,47 @@ TEST_F(TestDCtx, decompress)
     }
 }
 
+TEST_F(TestDCtx, randomAccess)
+{
+    Compressor compressor;
+    compressor.setParameter(CParam::FormatVersion, ZL_MAX_FORMAT_VERSION);
+    compressor.setParameter(CParam::SeekTable, ZL_TernaryParam_enable);
+    compressor.unwrap(ZL_Compressor_selectStartingGraphID(
+            compressor.get(), ZL_GRAPH_COMPRESS_GENERIC));
+    CCtx cctx;
+    cctx.refCompressor(compressor);
+    auto compressed = cctx.compress(inputs_);
+    auto nbChunks   = ZL_getNumChunks(compressed.data(), compressed.size());
+    ASSERT_EQ(ZL_validResult(nbChunks), 1u);
+
+    auto chunk = dctx_.decompressChunkAt(0, compressed);
+    ASSERT_EQ(chunk.size(), inputs_.size());
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        ASSERT_EQ(chunk[i], inputs_[i]);
+    }
+    ASSERT_THROW(dctx_.decompressChunkAt(1, compressed), Exception);
+
+    const auto numerics = dctx_.decompressRange(1, 10, 1001, compressed);
+    ASSERT_EQ(numerics.numElts(), 991u);
+    ASSERT_EQ(numerics.eltWidth(), sizeof(int));
+    ASSERT_EQ(
+            std::memcmp(
+                    numerics.ptr(),
+                    numericInput_.data() + 10,
+                    991 * sizeof(int)),
+            0);
+
+    const auto strings = dctx_.decompressRange(3, 2, 4, compressed);
+    ASSERT_EQ(strings.numElts(), 2u);
+    ASSERT_EQ(strings.contentSize(), lengths_[2] + lengths_[3]);
+    poly::string_view const content(
+            (const char*)strings.ptr(), strings.contentSize());
+    ASSERT_EQ(content, poly::string_view(serialInput_).substr(2, 220));
+
+    // Frames need a seek table for random access
+    ASSERT_THROW(dctx_.decompressChunkAt(0, compress(inputs_)), Exception);
+}
+
 TEST_F(TestDCtx, accessorsOnOutputWorkAsExpected)
 {
     auto input = Input::refString(
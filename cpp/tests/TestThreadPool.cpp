@@ -0,0 +1,39 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "openzl/cpp/ThreadPool.hpp"
+
+using namespace testing;
+
+namespace openzl::tests {
+
+namespace {
+void incrementTask(void* taskCtx, size_t taskID)
+{
+    auto& counters = *static_cast<std::vector<std::atomic<int>>*>(taskCtx);
+    counters[taskID]++;
+}
+} // namespace
+
+TEST(TestThreadPool, runsEachTaskOnce)
+{
+    for (size_t nbThreads : { 0, 1, 4 }) {
+        ThreadPool pool(nbThreads);
+        ASSERT_EQ(pool.nbThreads(), nbThreads);
+        auto workerPool = pool.get();
+        for (size_t nbTasks : { 0, 1, 3, 100 }) {
+            std::vector<std::atomic<int>> counters(nbTasks);
+            workerPool.runTasks(
+                    workerPool.opaque, incrementTask, &counters, nbTasks);
+            for (auto& counter : counters) {
+                ASSERT_EQ(counter.load(), 1);
+            }
+        }
+    }
+}
+
+} // namespace openzl::tests
@@ -3,13 +3,209 @@
 #include "custom_parsers/csv/csv_lexer.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "openzl/codecs/zl_dispatch.h"
 #include "openzl/common/logging.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/cpu.h"
+#include "openzl/shared/simd_wrapper.h"
+#include "openzl/shared/utils.h"
 #include "openzl/zl_graph_api.h"
 
-#include <stdio.h>
-#include <time.h>
+/* The lexer works in two stages, as in simdcsv :
+ * - Stage 1 classifies 64 bytes at a time with vector compares, producing
+ *   bitmasks of the quotes, separators and newlines of each block. The quoted
+ *   regions are the prefix XOR of the quotes bitmask, which is computed with a
+ *   carry-less multiplication by all ones when available. Escaped quotes
+ *   (`""`) toggle the state twice, so they need no special handling.
+ * - Stage 2 walks the separators and newlines outside of quotes with bit
+ *   tricks, and emits the strings.
+ * Positions are 64-bit, so inputs larger than 4 GiB are supported, as long as
+ * each string fits in the 32-bit string lengths.
+ */
+
+#define CSV_BLOCK_SIZE 64
+/// Number of blocks indexed by stage 1 before stage 2 consumes them
+#define CSV_CHUNK_NB_BLOCKS 64
+#define CSV_CHUNK_SIZE (CSV_BLOCK_SIZE * CSV_CHUNK_NB_BLOCKS)
+
+/// Bitmasks of the structural characters of a chunk, one word per block
+typedef struct {
+    uint64_t seps[CSV_CHUNK_NB_BLOCKS];
+    uint64_t newlines[CSV_CHUNK_NB_BLOCKS];
+    size_t nbBlocks;
+} CSV_Structurals;
+
+typedef struct {
+    const char* content;
+    size_t length;
+    size_t pos;       ///< Start of the next chunk
+    uint64_t inQuote; ///< All ones when @p pos is within quotes
+    char sep;
+} CSV_Scanner;
+
+static CSV_Scanner
+CSV_Scanner_init(const char* content, size_t length, char sep)
+{
+    CSV_Scanner const scanner = {
+        .content = content,
+        .length  = length,
+        .pos     = 0,
+        .inQuote = 0,
+        .sep     = sep,
+    };
+    return scanner;
+}
+
+ZL_FORCE_INLINE uint64_t CSV_mask64(ZL_Vec128 const* vecs, ZL_Vec128 target)
+{
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        ZL_VecMask const m = ZL_Vec128_mask8(ZL_Vec128_cmp8(vecs[i], target));
+        mask |= (uint64_t)m << (16 * i);
+    }
+    return mask;
+}
+
+/// @returns the prefix XOR of @p x : bit i is the XOR of bits 0 to i
+ZL_FORCE_INLINE uint64_t CSV_prefixXor(uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/**
+ * Fills the structurals of @p nbBlocks blocks of @p src,
+ * where @p inQuote is the quote state before the first block, and is updated
+ * to the state after the last one.
+ */
+ZL_FORCE_INLINE void CSV_indexBlocks_impl(
+        CSV_Structurals* out,
+        uint64_t* inQuote,
+        const char* src,
+        size_t nbBlocks,
+        char sep,
+        uint64_t (*prefixXor)(uint64_t))
+{
+    ZL_Vec128 const quoteV   = ZL_Vec128_set8('"');
+    ZL_Vec128 const sepV     = ZL_Vec128_set8((uint8_t)sep);
+    ZL_Vec128 const newlineV = ZL_Vec128_set8('\n');
+    uint64_t carry           = *inQuote;
+    for (size_t b = 0; b < nbBlocks; ++b) {
+        const char* const block = src + b * CSV_BLOCK_SIZE;
+        ZL_Vec128 vecs[4];
+        for (size_t i = 0; i < 4; ++i) {
+            vecs[i] = ZL_Vec128_read(block + 16 * i);
+        }
+        uint64_t const quotes = CSV_mask64(vecs, quoteV);
+        uint64_t const inside = prefixXor(quotes) ^ carry;
+        carry = (uint64_t)((int64_t)inside >> 63);
+        out->seps[b]     = CSV_mask64(vecs, sepV) & ~inside;
+        out->newlines[b] = CSV_mask64(vecs, newlineV) & ~inside;
+    }
+    *inQuote = carry;
+}
+
+static uint64_t CSV_prefixXor_portable(uint64_t x)
+{
+    return CSV_prefixXor(x);
+}
+
+static void CSV_indexBlocks_portable(
+        CSV_Structurals* out,
+        uint64_t* inQuote,
+        const char* src,
+        size_t nbBlocks,
+        char sep)
+{
+    CSV_indexBlocks_impl(
+            out, inQuote, src, nbBlocks, sep, CSV_prefixXor_portable);
+}
+
+#if ZL_CAN_PCLMUL
+#    include <immintrin.h>
+
+ZL_TARGET_PCLMUL_BEGIN
+
+static uint64_t CSV_prefixXor_pclmul(uint64_t x)
+{
+    __m128i const r = _mm_clmulepi64_si128(
+            _mm_set_epi64x(0, (long long)x), _mm_set1_epi8(-1), 0);
+    return (uint64_t)_mm_cvtsi128_si64(r);
+}
+
+static void CSV_indexBlocks_pclmul(
+        CSV_Structurals* out,
+        uint64_t* inQuote,
+        const char* src,
+        size_t nbBlocks,
+        char sep)
+{
+    CSV_indexBlocks_impl(
+            out, inQuote, src, nbBlocks, sep, CSV_prefixXor_pclmul);
+}
+
+ZL_TARGET_END
+#endif
+
+static void CSV_indexBlocks(
+        CSV_Structurals* out,
+        uint64_t* inQuote,
+        const char* src,
+        size_t nbBlocks,
+        char sep)
+{
+#if ZL_CAN_PCLMUL
+    if (ZL_cpuHas(ZL_CpuFeature_pclmul)) {
+        CSV_indexBlocks_pclmul(out, inQuote, src, nbBlocks, sep);
+        return;
+    }
+#endif
+    CSV_indexBlocks_portable(out, inQuote, src, nbBlocks, sep);
+}
+
+/**
+ * Indexes the next chunk of @p scanner into @p out.
+ * @returns the position of the chunk
+ * @pre scanner->pos < scanner->length
+ */
+static size_t CSV_scanChunk(CSV_Scanner* scanner, CSV_Structurals* out)
+{
+    size_t const start     = scanner->pos;
+    size_t const remaining = scanner->length - start;
+    size_t const chunkSize = ZL_MIN(remaining, (size_t)CSV_CHUNK_SIZE);
+    size_t const nbFull    = chunkSize / CSV_BLOCK_SIZE;
+    CSV_indexBlocks(
+            out,
+            &scanner->inQuote,
+            scanner->content + start,
+            nbFull,
+            scanner->sep);
+    out->nbBlocks = nbFull;
+    size_t const tailSize = chunkSize % CSV_BLOCK_SIZE;
+    if (tailSize > 0) {
+        // The padding holds no quote, so the quote state carries over
+        char tail[CSV_BLOCK_SIZE] = { 0 };
+        memcpy(tail,
+               scanner->content + start + nbFull * CSV_BLOCK_SIZE,
+               tailSize);
+        CSV_Structurals last;
+        CSV_indexBlocks(&last, &scanner->inQuote, tail, 1, scanner->sep);
+        uint64_t const valid  = ((uint64_t)1 << tailSize) - 1;
+        out->seps[nbFull]     = last.seps[0] & valid;
+        out->newlines[nbFull] = last.newlines[0] & valid;
+        out->nbBlocks         = nbFull + 1;
+    }
+    scanner->pos = start + chunkSize;
+    return start;
+}
+
 // Parses the CSV file to get the number of columns, separated by @p sep, and
 // the length of the first row, including the ending `\n`.
 static ZL_Report parseFirstRow(
@@ -19,27 +215,22 @@ static ZL_Report parseFirstRow(
         size_t* nbColumns,
         size_t* firstRowLen)
 {
+    CSV_Scanner scanner = CSV_Scanner_init(content, length, sep);
+    CSV_Structurals structurals;
     *nbColumns = 0;
-    for (size_t i = 0; i < length; i++) {
-        if (content[i] == '"') {
-            do {
-                i++;
-            } while (i < length && content[i] != '"');
-            if (i >= length) {
-                ZL_RET_R_ERR(
-                        node_invalid_input,
-                        "CSV file is not well formed. Open quote is not closed");
+    while (scanner.pos < length) {
+        size_t const chunkStart = CSV_scanChunk(&scanner, &structurals);
+        for (size_t b = 0; b < structurals.nbBlocks; ++b) {
+            uint64_t const seps     = structurals.seps[b];
+            uint64_t const newlines = structurals.newlines[b];
+            if (newlines == 0) {
+                *nbColumns += (size_t)ZL_popcount64(seps);
+                continue;
             }
-            i++;
-            if (i >= length) {
-                ZL_RET_R_ERR(
-                        node_invalid_input,
-                        "CSV file is not well formed. No newline character found anywhere in the file");
-            }
-        }
-        if (content[i] == '\n') {
-            *firstRowLen = i + 1;
-            (*nbColumns)++;
+            unsigned const bit    = (unsigned)ZL_ctz64(newlines);
+            uint64_t const before = ((uint64_t)1 << bit) - 1;
+            *nbColumns += (size_t)ZL_popcount64(seps & before) + 1;
+            *firstRowLen = chunkStart + b * CSV_BLOCK_SIZE + bit + 1;
             ZL_RET_R_IF_GT(
                     node_invalid_input,
                     *nbColumns,
@@ -47,19 +238,58 @@ static ZL_Report parseFirstRow(
                     "CSV file has more columns than supported by dispatchString");
             return ZL_returnSuccess();
         }
-        if (content[i] == sep) {
-            (*nbColumns)++;
-        }
     }
+    ZL_RET_R_IF(
+            node_invalid_input,
+            scanner.inQuote,
+            "CSV file is not well formed. Open quote is not closed");
     ZL_RET_R_ERR(
             node_invalid_input,
             "CSV file not well formed. No newline character found anywhere in the file");
 }
 
+size_t ZL_CSV_findRowsEnd(
+        const char* const content,
+        size_t byteSize,
+        char sep,
+        size_t minSize)
+{
+    // Position of the first newline which can end the rows
+    size_t const minPos = minSize > 0 ? minSize - 1 : 0;
+    CSV_Scanner scanner = CSV_Scanner_init(content, byteSize, sep);
+    CSV_Structurals structurals;
+    while (scanner.pos < byteSize) {
+        size_t const chunkStart = CSV_scanChunk(&scanner, &structurals);
+        for (size_t b = 0; b < structurals.nbBlocks; ++b) {
+            size_t const blockStart = chunkStart + b * CSV_BLOCK_SIZE;
+            uint64_t newlines       = structurals.newlines[b];
+            if (blockStart + CSV_BLOCK_SIZE <= minPos) {
+                continue;
+            }
+            if (blockStart < minPos) {
+                newlines &= ~(((uint64_t)1 << (minPos - blockStart)) - 1);
+            }
+            if (newlines != 0) {
+                return blockStart + (size_t)ZL_ctz64(newlines) + 1;
+            }
+        }
+    }
+    return byteSize;
+}
+
 static size_t countNbNewlines(const char* content, const size_t length)
 {
-    size_t nbNewlines = 0;
-    for (uint32_t i = 0; i < length; i++) {
+    ZL_Vec128 const newlineV = ZL_Vec128_set8('\n');
+    size_t nbNewlines        = 0;
+    size_t i                 = 0;
+    for (; i + CSV_BLOCK_SIZE <= length; i += CSV_BLOCK_SIZE) {
+        ZL_Vec128 vecs[4];
+        for (size_t v = 0; v < 4; ++v) {
+            vecs[v] = ZL_Vec128_read(content + i + 16 * v);
+        }
+        nbNewlines += (size_t)ZL_popcount64(CSV_mask64(vecs, newlineV));
+    }
+    for (; i < length; i++) {
         nbNewlines += (content[i] == '\n');
     }
     return nbNewlines;
@@ -72,39 +302,34 @@ static size_t countNbNewlines(const char* content, const size_t length)
  *   - Delimiters, whitespace, and newlines to dispatch N
  *   - Header to dispatch N + 1
  */
-// TODO: refactor this and the parsing fn to return an error if the assumption
-// of equal-sized rows is violated
 static ZL_Report createCsvDispatchIndices(
         uint16_t* dispatchIndices,
         size_t nbContentRows,
-        size_t nbColumns,
-        const uint32_t* stringLens)
+        size_t nbColumns)
 {
-    (void)stringLens;
     size_t maxDispatches = ZL_DispatchString_maxDispatches();
     ZL_RET_R_IF_GT(
             temporaryLibraryLimitation,
             nbColumns,
             maxDispatches - 2,
-            "Dispatch only supports up to %i dispatches - 2 aux outputs = %i columns",
+            "Dispatch only supports up to %zu dispatches - 2 aux outputs = %zu columns",
             maxDispatches,
             maxDispatches - 2);
     // We separate strings to follow the pattern of 'header',
-    // 'content', 'separator', 'content', ..., therefore even indices are
-    // separators.
+    // 'content', 'separator', 'content', ..., so every row has the same
+    // indices : fill the first one, then double the filled rows until done.
+    uint16_t* const rows   = dispatchIndices + 1;
+    size_t const rowSize   = 2 * nbColumns;
+    size_t const totalSize = nbContentRows * rowSize;
     if (nbContentRows != 0) {
-        size_t columnNumber = 0;
-        for (size_t i = 0; i < 2 * nbColumns; i += 2) {
-            dispatchIndices[i]     = (uint16_t)nbColumns;
-            dispatchIndices[i + 1] = (uint16_t)columnNumber++;
+        for (size_t col = 0; col < nbColumns; ++col) {
+            rows[2 * col]     = (uint16_t)col;
+            rows[2 * col + 1] = (uint16_t)nbColumns;
         }
-        dispatchIndices[2 * nbColumns] = (uint16_t)nbColumns;
-        // memcpy in a loop! memcpy in a loop! memcpy in a loop!
-        // (this can probably be faster)
-        for (size_t row = 1; row < nbContentRows; ++row) {
-            memcpy(dispatchIndices + 1 + row * (2 * nbColumns),
-                   dispatchIndices + 1,
-                   2 * nbColumns * sizeof(dispatchIndices[0]));
+        for (size_t filled = rowSize; filled < totalSize;) {
+            size_t const copySize = ZL_MIN(filled, totalSize - filled);
+            memcpy(rows + filled, rows, copySize * sizeof(rows[0]));
+            filled += copySize;
         }
     }
     // Header goes to a separate cluster
@@ -112,155 +337,443 @@ static ZL_Report createCsvDispatchIndices(
     return ZL_returnSuccess();
 }
 
-static ZL_Report createParsedCsv(
-        uint32_t* stringLens,
+/**
+ * A range of rows to lex, which may run concurrently with other ranges.
+ * Unless it is the first range, it starts within a row, under an assumed
+ * quote state : its rows begin after the first newline found at or after
+ * @p start. All ranges but the last one continue past @p end until the first
+ * newline at or after it, which is exactly where the next range begins.
+ */
+typedef struct {
+    size_t start;
+    size_t end;
+    uint64_t inQuote; ///< Assumed quote state at @p start
+    bool isFirst;
+    bool isLast;
+    uint32_t* stringLens;      ///< Capacity 2 * nbColumns * (newlines + 1)
+    uint16_t* dispatchIndices; ///< Same capacity, only for null-aware lexing
+    uint64_t endInQuote;       ///< Output : quote state at @p end
+} CSV_Range;
+
+/**
+ * Lexes the rows of @p range, as ZL_CSV_lex() or ZL_CSV_lexNullAware()
+ * would lex them within the whole input @p content.
+ * @returns the number of strings
+ */
+ZL_FORCE_INLINE ZL_Report CSV_lexRange_impl(
+        CSV_Range* range,
         const char* content,
         const size_t length,
         char sep,
-        size_t nbColumns)
+        size_t nbColumns,
+        bool nullAware)
 {
-    uint32_t fieldStart = 0;
-    size_t nbStrs       = 0;
-    size_t col          = 1;
-
-    for (uint32_t i = 0; i < length; ++i) {
-        // skip past all quoted strings
-        if (content[i] == '"') {
-            do {
-                ++i;
-            } while (i < length && content[i] != '"');
-            if (i >= length) {
-                ZL_RET_R_ERR(
-                        node_invalid_input,
-                        "CSV file is not well formed. Open quote is not closed");
-            }
-            ++i;
-            if (i >= length) {
-                ZL_RET_R_ERR(
-                        node_invalid_input,
-                        "CSV file is not well formed. No newline character at the end of the last line");
-            }
+    uint32_t* const stringLens      = range->stringLens;
+    uint16_t* const dispatchIndices = range->dispatchIndices;
+    CSV_Scanner scanner = CSV_Scanner_init(content, length, sep);
+    scanner.pos         = range->start;
+    scanner.inQuote     = range->inQuote;
+    range->endInQuote   = range->inQuote;
+    CSV_Structurals structurals;
+    bool inRows       = range->isFirst;
+    size_t fieldStart = range->start;
+    size_t nbStrs     = 0;
+    // Column of the next field : counts from 1 for ZL_CSV_lex(),
+    // and from 0 for the null-aware variant
+    size_t col = nullAware ? 0 : 1;
+    // End of the current run of contiguous separators, e.g. ',,,,,,',
+    // which are coalesced into a single string by the null-aware variant.
+    // 0 when there is none.
+    size_t runEnd = 0;
+
+    while (scanner.pos < length) {
+        size_t const chunkStart = CSV_scanChunk(&scanner, &structurals);
+        if (scanner.pos == range->end) {
+            range->endInQuote = scanner.inQuote;
         }
-        if (content[i] == sep || content[i] == '\n') {
-            // check for unexpected or missing columns
-            if (content[i] == sep) {
-                if (col >= nbColumns) {
-                    ZL_RET_R_ERR(
-                            node_invalid_input,
-                            "CSV file is not well formed. Header expects %i columns, but found %i (or more) columns",
-                            nbColumns,
-                            col);
+        for (size_t b = 0; b < structurals.nbBlocks; ++b) {
+            size_t const blockStart = chunkStart + b * CSV_BLOCK_SIZE;
+            uint64_t const seps     = structurals.seps[b];
+            uint64_t bits           = seps | structurals.newlines[b];
+            for (; bits != 0; bits &= bits - 1) {
+                unsigned const bit = (unsigned)ZL_ctz64(bits);
+                size_t const i     = blockStart + bit;
+                bool const isSep   = (seps >> bit) & 1;
+                if (!inRows) {
+                    if (isSep) {
+                        continue;
+                    }
+                    if (i >= range->end) {
+                        // The previous range lexes this row
+                        return ZL_returnValue(0);
+                    }
+                    inRows     = true;
+                    fieldStart = i + 1;
+                    continue;
                 }
-                ++col;
-            } else { // content[i] == '\n'
-                if (col != nbColumns) {
-                    ZL_RET_R_ERR(
+                if (nullAware) {
+                    if (isSep && i == runEnd && runEnd != 0) {
+                        // extend the current run
+                        ZL_RET_R_IF_GE(
+                                node_invalid_input,
+                                col + 1,
+                                nbColumns,
+                                "CSV file is not well formed. Header expects %zu columns, but found more",
+                                nbColumns);
+                        ++col;
+                        ++runEnd;
+                        continue;
+                    }
+                    if (runEnd != 0) {
+                        // close the previous run
+                        stringLens[nbStrs] = (uint32_t)(runEnd - fieldStart);
+                        dispatchIndices[nbStrs] = (uint16_t)nbColumns;
+                        ++nbStrs;
+                        fieldStart = runEnd;
+                        runEnd     = 0;
+                    }
+                    ZL_RET_R_IF_GT(
                             node_invalid_input,
-                            "CSV file is not well formed. Header expects %i columns, but only found %i columns",
-                            nbColumns,
-                            col);
+                            i - fieldStart,
+                            UINT32_MAX,
+                            "CSV field is larger than 4 GiB");
+                    stringLens[nbStrs]      = (uint32_t)(i - fieldStart);
+                    dispatchIndices[nbStrs] = (uint16_t)col;
+                    ++nbStrs;
+                    if (isSep) {
+                        ZL_RET_R_IF_GE(
+                                node_invalid_input,
+                                col + 1,
+                                nbColumns,
+                                "CSV file is not well formed. Header expects %zu columns, but found more",
+                                nbColumns);
+                        ++col;
+                        fieldStart = i;
+                        runEnd     = i + 1;
+                        continue;
+                    }
+                    stringLens[nbStrs]      = 1;
+                    dispatchIndices[nbStrs] = (uint16_t)nbColumns;
+                    ++nbStrs;
+                    col = 0;
+                } else {
+                    // check for unexpected or missing columns
+                    if (isSep) {
+                        ZL_RET_R_IF_GE(
+                                node_invalid_input,
+                                col,
+                                nbColumns,
+                                "CSV file is not well formed. Header expects %zu columns, but found %zu (or more) columns",
+                                nbColumns,
+                                col + 1);
+                        ++col;
+                    } else {
+                        ZL_RET_R_IF_NE(
+                                node_invalid_input,
+                                col,
+                                nbColumns,
+                                "CSV file is not well formed. Header expects %zu columns, but only found %zu columns",
+                                nbColumns,
+                                col);
+                        col = 1;
+                    }
+                    ZL_RET_R_IF_GT(
+                            node_invalid_input,
+                            i - fieldStart,
+                            UINT32_MAX,
+                            "CSV field is larger than 4 GiB");
+                    stringLens[nbStrs++] = (uint32_t)(i - fieldStart);
+                    stringLens[nbStrs++] = 1;
+                }
+                fieldStart = i + 1;
+                if (!isSep && !range->isLast && i >= range->end) {
+                    // The next range starts with the next row
+                    return ZL_returnValue(nbStrs);
                 }
-                col = 1;
             }
-
-            stringLens[nbStrs] = i - fieldStart;
-            ++nbStrs;
-            stringLens[nbStrs] = 1;
-            ++nbStrs;
-            fieldStart = i + 1;
+        }
+        if (!inRows && scanner.pos >= range->end) {
+            // No newline in the range : it has no rows of its own
+            return ZL_returnValue(0);
         }
     }
-    ZL_RET_R_IF_NE(
+    if (!inRows) {
+        return ZL_returnValue(0);
+    }
+    if (runEnd != 0) {
+        stringLens[nbStrs]      = (uint32_t)(runEnd - fieldStart);
+        dispatchIndices[nbStrs] = (uint16_t)nbColumns;
+        ++nbStrs;
+        fieldStart = runEnd;
+    }
+    ZL_RET_R_IF(
             node_invalid_input,
-            col,
-            1,
-            "CSV file may be truncated. Header expects %i columns, but only found %i columns in the last line",
-            nbColumns,
-            col - 1);
+            scanner.inQuote,
+            "CSV file is not well formed. Open quote is not closed");
+    if (!nullAware) {
+        ZL_RET_R_IF_NE(
+                node_invalid_input,
+                col,
+                1,
+                "CSV file may be truncated. Header expects %zu columns, but only found %zu columns in the last line",
+                nbColumns,
+                col - 1);
+    }
     ZL_RET_R_IF_NE(
             node_invalid_input,
             fieldStart,
             length,
             "CSV file not well formed. No newline character at the end of the last line");
-    ZL_LOG(V, "createParsedCsv nbStrs: %zu", nbStrs);
     return ZL_returnValue(nbStrs);
 }
 
+static ZL_Report CSV_lexRange(
+        CSV_Range* range,
+        const char* content,
+        size_t length,
+        char sep,
+        size_t nbColumns)
+{
+    return CSV_lexRange_impl(range, content, length, sep, nbColumns, false);
+}
+
+static ZL_Report CSV_lexRangeNullAware(
+        CSV_Range* range,
+        const char* content,
+        size_t length,
+        char sep,
+        size_t nbColumns)
+{
+    return CSV_lexRange_impl(range, content, length, sep, nbColumns, true);
+}
+
+static CSV_Range CSV_wholeRange(
+        uint32_t* stringLens,
+        uint16_t* dispatchIndices,
+        size_t length)
+{
+    CSV_Range const range = {
+        .start           = 0,
+        .end             = length,
+        .inQuote         = 0,
+        .isFirst         = true,
+        .isLast          = true,
+        .stringLens      = stringLens,
+        .dispatchIndices = dispatchIndices,
+    };
+    return range;
+}
+
 // returns number of strings processed
 ZL_Report createNullAwareLexAndDispatch(
         uint32_t* stringLens,
         uint16_t* dispatchIndices,
         const char* content,
         const size_t length,
-        uint8_t nbColumns,
+        size_t nbColumns,
         char sep)
 {
-    uint32_t fieldStart = 0;
-    uint8_t colIdx      = 0;
-    size_t nbStrs       = 0;
-
-    for (uint32_t i = 0; i < length;) {
-        // skip past all quoted strings
-        if (content[i] == '"') {
-            do {
-                ++i;
-            } while (i < length && content[i] != '"');
-            if (i >= length) {
-                ZL_RET_R_ERR(
-                        node_invalid_input,
-                        "CSV file is not well formed. Open quote is not closed");
-            }
-            ++i;
+    CSV_Range range = CSV_wholeRange(stringLens, dispatchIndices, length);
+    return CSV_lexRangeNullAware(&range, content, length, sep, nbColumns);
+}
+
+/* Parallel lexing
+ *
+ * The rows are split into byte ranges, which are lexed as independent tasks
+ * on the worker pool of the compression. The quote state at the start of a
+ * range depends on all the preceding bytes, so each range is lexed
+ * speculatively, both outside and inside quotes. Once all ranges are lexed,
+ * the quote state at the end of each range, under its correct assumption,
+ * selects the correct lexing of the next range. The results are then merged.
+ */
+
+/// Ranges are at least that large, to amortize the tasks
+#define CSV_MIN_RANGE_SIZE (1 << 18)
+#define CSV_MAX_NB_RANGES 64
+
+typedef struct {
+    const char* content;
+    size_t length;
+    char sep;
+    size_t nbColumns;
+    bool nullAware;
+    size_t nbNewlines;
+    /// Lexed outside quotes, then inside quotes
+    CSV_Range speculations[2];
+    ZL_Report results[2];
+} CSV_Partition;
+
+static void CSV_countTask(void* taskCtx, size_t taskID)
+{
+    CSV_Partition* const part = (CSV_Partition*)taskCtx + taskID;
+    CSV_Range const* range    = &part->speculations[0];
+    part->nbNewlines          = countNbNewlines(
+            part->content + range->start, range->end - range->start);
+}
+
+static void CSV_lexTask(void* taskCtx, size_t taskID)
+{
+    CSV_Partition* const part   = (CSV_Partition*)taskCtx + taskID;
+    size_t const nbSpeculations = part->speculations[0].isFirst ? 1 : 2;
+    for (size_t s = 0; s < nbSpeculations; ++s) {
+        part->results[s] = part->nullAware
+                ? CSV_lexRangeNullAware(
+                          &part->speculations[s],
+                          part->content,
+                          part->length,
+                          part->sep,
+                          part->nbColumns)
+                : CSV_lexRange(
+                          &part->speculations[s],
+                          part->content,
+                          part->length,
+                          part->sep,
+                          part->nbColumns);
+    }
+}
+
+/// @p nbThreads == 0 follows the number of workers of the compression
+static size_t
+CSV_nbPartitions(const ZL_Graph* gctx, size_t length, size_t nbThreads)
+{
+    size_t const nbWorkers = ZL_Graph_getNbWorkers(gctx);
+    size_t nbParts = nbThreads == 0 ? nbWorkers : ZL_MIN(nbThreads, nbWorkers);
+    nbParts        = ZL_MIN(nbParts, length / CSV_MIN_RANGE_SIZE);
+    return ZL_MAX(ZL_MIN(nbParts, (size_t)CSV_MAX_NB_RANGES), (size_t)1);
+}
+
+/**
+ * Lexes the rows of @p content in up to @p nbThreads ranges, into scratch
+ * buffers whose first string is left for the header.
+ * @p dispatchIndices is only filled by the null-aware variant.
+ * @returns the number of strings, excluding the header
+ */
+static ZL_Report CSV_lexRows(
+        ZL_Graph* gctx,
+        uint32_t** stringLens,
+        uint16_t** dispatchIndices,
+        const char* content,
+        size_t length,
+        char sep,
+        size_t nbColumns,
+        bool nullAware,
+        size_t nbThreads)
+{
+    size_t const nbParts = CSV_nbPartitions(gctx, length, nbThreads);
+    // Given 'n' columns, there are up to 'n' content strings and 'n'
+    // separator strings per row. This is because we count the newline
+    // separator as well as all the column separators. Each range may lex one
+    // more row, past its end or without a final newline. Overcounting
+    // extraneous quoted newlines is possible.
+    size_t const rowCapacity = 2 * nbColumns;
+    CSV_Partition parts[CSV_MAX_NB_RANGES];
+    // Ranges are whole chunks, so that the quote state at their end is known
+    size_t const rangeSize = nbParts == 1
+            ? length
+            : length / nbParts / CSV_CHUNK_SIZE * CSV_CHUNK_SIZE;
+    for (size_t p = 0; p < nbParts; ++p) {
+        CSV_Partition* const part = &parts[p];
+        part->content             = content;
+        part->length              = length;
+        part->sep                 = sep;
+        part->nbColumns           = nbColumns;
+        part->nullAware           = nullAware;
+        for (size_t s = 0; s < 2; ++s) {
+            CSV_Range* const range = &part->speculations[s];
+            memset(range, 0, sizeof(*range));
+            range->start   = p * rangeSize;
+            range->end     = p + 1 == nbParts ? length : (p + 1) * rangeSize;
+            range->inQuote = s == 0 ? 0 : ~(uint64_t)0;
+            range->isFirst = p == 0;
+            range->isLast  = p + 1 == nbParts;
         }
-        if (content[i] == sep) {
-            stringLens[nbStrs]      = i - fieldStart;
-            dispatchIndices[nbStrs] = colIdx;
-            ++nbStrs;
-            fieldStart = i;
-            // coalesce all contiguous separators, e.g. ',,,,,,'
-            while (i < length && content[i] == sep) {
-                ++colIdx;
-                ++i;
+    }
+    if (nbParts == 1) {
+        parts[0].nbNewlines = countNbNewlines(content, length);
+    } else {
+        ZL_Graph_runTasks(gctx, CSV_countTask, parts, nbParts);
+    }
+
+    // Each range writes its outside-quotes lexing in place, right after the
+    // previous ranges' capacity, and its inside-quotes lexing to the side
+    size_t capacity = 1; // header
+    for (size_t p = 0; p < nbParts; ++p) {
+        capacity += rowCapacity * (parts[p].nbNewlines + 1);
+    }
+    *stringLens = ZL_Graph_getScratchSpace(gctx, capacity * sizeof(uint32_t));
+    ZL_RET_R_IF_NULL(allocation, *stringLens);
+    uint32_t* altStringLens = NULL;
+    if (nbParts > 1) {
+        altStringLens =
+                ZL_Graph_getScratchSpace(gctx, capacity * sizeof(uint32_t));
+        ZL_RET_R_IF_NULL(allocation, altStringLens);
+    }
+    uint16_t* altDispatchIndices = NULL;
+    *dispatchIndices             = NULL;
+    if (nullAware) {
+        *dispatchIndices =
+                ZL_Graph_getScratchSpace(gctx, capacity * sizeof(uint16_t));
+        ZL_RET_R_IF_NULL(allocation, *dispatchIndices);
+        if (nbParts > 1) {
+            altDispatchIndices = ZL_Graph_getScratchSpace(
+                    gctx, capacity * sizeof(uint16_t));
+            ZL_RET_R_IF_NULL(allocation, altDispatchIndices);
+        }
+    }
+    for (size_t p = 0, offset = 1; p < nbParts; ++p) {
+        CSV_Range* const ranges = parts[p].speculations;
+        ranges[0].stringLens    = *stringLens + offset;
+        if (nullAware) {
+            ranges[0].dispatchIndices = *dispatchIndices + offset;
+        }
+        if (nbParts > 1) {
+            ranges[1].stringLens = altStringLens + offset;
+            if (nullAware) {
+                ranges[1].dispatchIndices = altDispatchIndices + offset;
             }
-            stringLens[nbStrs]      = i - fieldStart;
-            dispatchIndices[nbStrs] = nbColumns;
-            ++nbStrs;
-            fieldStart = i;
-            continue;
         }
-        if (content[i] == '\n') {
-            stringLens[nbStrs]      = i - fieldStart;
-            dispatchIndices[nbStrs] = colIdx;
-            ++nbStrs;
-            stringLens[nbStrs]      = 1;
-            dispatchIndices[nbStrs] = nbColumns;
-            ++nbStrs;
-            fieldStart = i + 1;
-            colIdx     = 0;
+        offset += rowCapacity * (parts[p].nbNewlines + 1);
+    }
+
+    if (nbParts == 1) {
+        CSV_lexTask(parts, 0);
+        return parts[0].results[0];
+    }
+    ZL_Graph_runTasks(gctx, CSV_lexTask, parts, nbParts);
+
+    // Select the correct speculations, and merge them
+    size_t nbStrs    = 0;
+    uint64_t inQuote = 0;
+    for (size_t p = 0; p < nbParts; ++p) {
+        size_t const s               = inQuote ? 1 : 0;
+        CSV_Range const* const range = &parts[p].speculations[s];
+        ZL_RET_R_IF_ERR(parts[p].results[s]);
+        size_t const rangeNbStrs = ZL_validResult(parts[p].results[s]);
+        memmove(*stringLens + 1 + nbStrs,
+                range->stringLens,
+                rangeNbStrs * sizeof(uint32_t));
+        if (nullAware) {
+            memmove(*dispatchIndices + 1 + nbStrs,
+                    range->dispatchIndices,
+                    rangeNbStrs * sizeof(uint16_t));
         }
-        ++i;
+        nbStrs += rangeNbStrs;
+        inQuote = range->endInQuote;
     }
-    ZL_RET_R_IF_NE(
-            node_invalid_input,
-            fieldStart,
-            length,
-            "CSV file not well formed. No newline character at the end of the last line");
-    ZL_LOG(V, "createParsedCsv nbStrs: %zu", nbStrs);
     return ZL_returnValue(nbStrs);
 }
 
-ZL_Report ZL_CSV_lex(
+static ZL_Report CSV_lex(
         ZL_Graph* gctx,
         const char* const content,
         size_t byteSize,
         bool hasHeader,
         char sep,
+        bool nullAware,
+        size_t nbThreads,
         ZL_CSV_lexResult* retLexResult)
 {
-    // TODO: can we use a vector to avoid this double iteration? would it be
-    // faster?
     // pre-processing for rows, columns before parsing
-    fprintf(stderr, "CSV_lex Start\n");
     const char* rowsStart;
     size_t rowsByteSize;
     size_t nbColumns;
@@ -270,6 +783,11 @@ ZL_Report ZL_CSV_lex(
         ZL_RET_R_IF_ERR(parseFirstRow(
                 content, byteSize, sep, &nbColumns, &firstRowLen));
         if (hasHeader) {
+            ZL_RET_R_IF_GT(
+                    node_invalid_input,
+                    firstRowLen,
+                    UINT32_MAX,
+                    "CSV header is larger than 4 GiB");
             rowsStart    = content + firstRowLen;
             rowsByteSize = byteSize - firstRowLen;
         } else {
@@ -278,60 +796,34 @@ ZL_Report ZL_CSV_lex(
         }
     }
 
-    struct timespec countNbNewlines_start, countNbNewlines_end;
-    clock_gettime(CLOCK_MONOTONIC, &countNbNewlines_start);
-
-    const size_t maxNbRows = countNbNewlines(rowsStart, rowsByteSize);
-
-    clock_gettime(CLOCK_MONOTONIC, &countNbNewlines_end);
-    double countNbNewlines_start_time_ms = (double)countNbNewlines_start.tv_sec * 1000.0 + (double)countNbNewlines_start.tv_nsec / 1000000.0;
-    double countNbNewlines_end_time_ms = (double)countNbNewlines_end.tv_sec * 1000.0 + (double)countNbNewlines_end.tv_nsec / 1000000.0;
-    double countNbNewlines_duration = countNbNewlines_end_time_ms - countNbNewlines_start_time_ms;
-    fprintf(stderr, "[countNbNewlines] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms\n", countNbNewlines_start_time_ms, countNbNewlines_end_time_ms, countNbNewlines_duration);
-
-    // Given 'n' columns, there are 'n' content strings and 'n' separator
-    // strings per row. This is because we count the newline separator as well
-    // as all the column separators. We add 1 for the header. Overcounting
-    // extraneous quoted newlines is possible.
-    const size_t maxNbStrings = 2 * nbColumns * maxNbRows + 1;
-
-    uint32_t* stringLens =
-            ZL_Graph_getScratchSpace(gctx, maxNbStrings * sizeof(uint32_t));
-    ZL_RET_R_IF_NULL(allocation, stringLens);
+    uint32_t* stringLens;
+    uint16_t* dispatchIndices;
+    ZL_TRY_LET_R(
+            nbStrs,
+            CSV_lexRows(
+                    gctx,
+                    &stringLens,
+                    &dispatchIndices,
+                    rowsStart,
+                    rowsByteSize,
+                    sep,
+                    nbColumns,
+                    nullAware,
+                    nbThreads));
+    ZL_LOG(V, "CSV_lex nbStrs: %zu", nbStrs);
     stringLens[0] = (uint32_t)(rowsStart - content); // 0 if there is no header
-
-    struct timespec createParsedCsv_start, createParsedCsv_end;
-    clock_gettime(CLOCK_MONOTONIC, &createParsedCsv_start);
-
-    ZL_Report rep = createParsedCsv(
-            stringLens + 1, rowsStart, rowsByteSize, sep, nbColumns);
-
-    clock_gettime(CLOCK_MONOTONIC, &createParsedCsv_end);
-    double createParsedCsv_start_time_ms = (double)createParsedCsv_start.tv_sec * 1000.0 + (double)createParsedCsv_start.tv_nsec / 1000000.0;
-    double createParsedCsv_end_time_ms = (double)createParsedCsv_end.tv_sec * 1000.0 + (double)createParsedCsv_end.tv_nsec / 1000000.0;
-    double createParsedCsv_duration = createParsedCsv_end_time_ms - createParsedCsv_start_time_ms;
-    fprintf(stderr, "[createParsedCsv] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms\n", createParsedCsv_start_time_ms, createParsedCsv_end_time_ms, createParsedCsv_duration);
-
-    ZL_RET_R_IF_ERR(rep);
-    size_t actualNbStrs = ZL_validResult(rep);
-    size_t actualNbRows = actualNbStrs / (2 * nbColumns);
-    actualNbStrs += 1; // +1 for header
-
-    uint16_t* dispatchIndices =
-            ZL_Graph_getScratchSpace(gctx, actualNbStrs * sizeof(uint16_t));
-    ZL_RET_R_IF_NULL(allocation, dispatchIndices);
-
-    struct timespec createCsvDispatchIndices_start, createCsvDispatchIndices_end;
-    clock_gettime(CLOCK_MONOTONIC, &createCsvDispatchIndices_start);
-
-    ZL_RET_R_IF_ERR(createCsvDispatchIndices(
-            dispatchIndices, actualNbRows, nbColumns, stringLens));
-
-    clock_gettime(CLOCK_MONOTONIC, &createCsvDispatchIndices_end);
-    double createCsvDispatchIndices_start_time_ms = (double)createCsvDispatchIndices_start.tv_sec * 1000.0 + (double)createCsvDispatchIndices_start.tv_nsec / 1000000.0;
-    double createCsvDispatchIndices_end_time_ms = (double)createCsvDispatchIndices_end.tv_sec * 1000.0 + (double)createCsvDispatchIndices_end.tv_nsec / 1000000.0;
-    double createCsvDispatchIndices_duration = createCsvDispatchIndices_end_time_ms - createCsvDispatchIndices_start_time_ms;
-    fprintf(stderr, "[createCsvDispatchIndices] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms\n", createCsvDispatchIndices_start_time_ms, createCsvDispatchIndices_end_time_ms, createCsvDispatchIndices_duration);
+    size_t const actualNbStrs = nbStrs + 1;          // +1 for header
+
+    if (nullAware) {
+        dispatchIndices[0] = (uint16_t)(nbColumns + 1); // header
+    } else {
+        size_t const actualNbRows = nbStrs / (2 * nbColumns);
+        dispatchIndices           = ZL_Graph_getScratchSpace(
+                gctx, actualNbStrs * sizeof(uint16_t));
+        ZL_RET_R_IF_NULL(allocation, dispatchIndices);
+        ZL_RET_R_IF_ERR(createCsvDispatchIndices(
+                dispatchIndices, actualNbRows, nbColumns));
+    }
 
     // return
     retLexResult->stringLens      = stringLens;
@@ -339,69 +831,45 @@ ZL_Report ZL_CSV_lex(
     retLexResult->nbStrs          = actualNbStrs;
     retLexResult->nbColumns       = nbColumns;
 
-    fprintf(stderr, "CSV_lex End\n");
     return ZL_returnSuccess();
 }
 
-ZL_Report ZL_CSV_lexNullAware(
+ZL_Report ZL_CSV_lex(
         ZL_Graph* gctx,
         const char* const content,
         size_t byteSize,
         bool hasHeader,
         char sep,
+        size_t nbThreads,
         ZL_CSV_lexResult* retLexResult)
 {
-    // TODO: can we use a vector to avoid this double iteration? would it be
-    // faster?
-    // pre-processing for rows, columns before parsing
-    const char* rowsStart;
-    size_t rowsByteSize;
-    size_t nbColumns;
-    {
-        size_t firstRowLen =
-                0; // dummy initialization, to avoid -Wmaybe-uninitialized
-        ZL_RET_R_IF_ERR(parseFirstRow(
-                content, byteSize, sep, &nbColumns, &firstRowLen));
-        if (hasHeader) {
-            rowsStart    = content + firstRowLen;
-            rowsByteSize = byteSize - firstRowLen;
-        } else {
-            rowsStart    = content;
-            rowsByteSize = byteSize;
-        }
-    }
-    const size_t maxNbRows = countNbNewlines(rowsStart, rowsByteSize);
-    // Given 'n' columns, there are up to 'n' content strings and 'n' separator
-    // strings per row. This is because we count the newline separator as well
-    // as all the column separators. We add 1 for the header. Overcounting
-    // extraneous quoted newlines is possible.
-    const size_t maxNbStrings = 2 * nbColumns * maxNbRows + 1;
-
-    uint32_t* stringLens =
-            ZL_Graph_getScratchSpace(gctx, maxNbStrings * sizeof(uint32_t));
-    ZL_RET_R_IF_NULL(allocation, stringLens);
-    uint16_t* dispatchIndices =
-            ZL_Graph_getScratchSpace(gctx, maxNbStrings * sizeof(uint16_t));
-    ZL_RET_R_IF_NULL(allocation, dispatchIndices);
-    stringLens[0] = (uint32_t)(rowsStart - content); // 0 if there is no header
-
-    ZL_Report rep = createNullAwareLexAndDispatch(
-            stringLens + 1,
-            dispatchIndices + 1,
-            rowsStart,
-            rowsByteSize,
-            (uint8_t)nbColumns,
-            sep);
-    ZL_RET_R_IF_ERR(rep);
-    size_t actualNbStrs = ZL_validResult(rep);
-    actualNbStrs += 1;                            // +1 for header
-    dispatchIndices[0] = (uint16_t)nbColumns + 1; // header
-
-    // return
-    retLexResult->stringLens      = stringLens;
-    retLexResult->dispatchIndices = dispatchIndices;
-    retLexResult->nbStrs          = actualNbStrs;
-    retLexResult->nbColumns       = nbColumns;
+    return CSV_lex(
+            gctx,
+            content,
+            byteSize,
+            hasHeader,
+            sep,
+            false,
+            nbThreads,
+            retLexResult);
+}
 
-    return ZL_returnSuccess();
+ZL_Report ZL_CSV_lexNullAware(
+        ZL_Graph* gctx,
+        const char* const content,
+        size_t byteSize,
+        bool hasHeader,
+        char sep,
+        size_t nbThreads,
+        ZL_CSV_lexResult* retLexResult)
+{
+    return CSV_lex(
+            gctx,
+            content,
+            byteSize,
+            hasHeader,
+            sep,
+            true,
+            nbThreads,
+            retLexResult);
 }
@@ -20,12 +20,20 @@ typedef struct {
     uint16_t* dispatchIndices;
 } ZL_CSV_lexResult;
 
+/**
+ * Lexes @p content in up to @p nbThreads ranges. Large inputs are split into
+ * ranges which are lexed concurrently on the worker pool of the compression,
+ * and the result is identical to serial lexing. 0 follows the number of
+ * workers of the compression (ZL_CParam_nbWorkers), and 1 lexes serially.
+ * Without a worker pool, the input is always lexed serially.
+ */
 ZL_Report ZL_CSV_lex(
         ZL_Graph* gctx,
         const char* const content,
         size_t byteSize,
         bool hasHeader,
         char sep,
+        size_t nbThreads,
         ZL_CSV_lexResult* retLexResult);
 
 // Instead of doing a full columnar dispatch, we skip the dispatch if the column
@@ -37,14 +45,27 @@ ZL_Report ZL_CSV_lexNullAware(
         size_t byteSize,
         bool hasHeader,
         char sep,
+        size_t nbThreads,
         ZL_CSV_lexResult* retLexResult);
 
+/**
+ * Finds where to cut @p content on a row boundary. Newlines within quotes
+ * don't end a row.
+ * @returns the size of the shortest prefix of whole rows of @p content which
+ * spans at least @p minSize bytes, or @p byteSize if there is none.
+ */
+size_t ZL_CSV_findRowsEnd(
+        const char* const content,
+        size_t byteSize,
+        char sep,
+        size_t minSize);
+
 ZL_Report createNullAwareLexAndDispatch(
         uint32_t* stringLens,
         uint16_t* dispatchIndices,
         const char* content,
         const size_t length,
-        uint8_t nbColumns,
+        size_t nbColumns,
         char sep);
 
 #if defined(__cplusplus)
@@ -12,6 +12,11 @@
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 #include "openzl/zl_graph_api.h"
+#include "openzl/zl_segmenter.h"
+
+/// Chunks of the CSV segmenter are made of whole rows, and of at least this
+/// many bytes, unless the input is smaller.
+#define ZL_CSV_MIN_CHUNK_SIZE ((size_t)8 << 20)
 
 static void print(const void* ptr, size_t size, char* name)
 {
@@ -62,12 +67,30 @@ csvParserGraphFn(ZL_Graph* gctx, ZL_Edge* inputs[], size_t nbInputs)
             node_invalid_input,
             (useNullAwareParse != 0) && (useNullAwareParse != 1),
             "UseNullAware must be 0 or 1");
+    int nbThreads =
+            ZL_Graph_getLocalIntParam(gctx, ZL_PARSER_NB_THREADS_PID)
+                    .paramValue;
+    ZL_RET_R_IF_LT(
+            node_invalid_input, nbThreads, 0, "NbThreads must be positive");
 
     ZL_CSV_lexResult lexed = {};
     ZL_Report lexRes       = (useNullAwareParse)
                   ? ZL_CSV_lexNullAware(
-                      gctx, content, byteSize, hasHeader, sep, &lexed)
-                  : ZL_CSV_lex(gctx, content, byteSize, hasHeader, sep, &lexed);
+                      gctx,
+                      content,
+                      byteSize,
+                      hasHeader,
+                      sep,
+                      (size_t)nbThreads,
+                      &lexed)
+                  : ZL_CSV_lex(
+                      gctx,
+                      content,
+                      byteSize,
+                      hasHeader,
+                      sep,
+                      (size_t)nbThreads,
+                      &lexed);
     ZL_RET_R_IF_ERR(lexRes);
     // +1 for delimiters and newlines; +1 for header
     size_t nbOutputs = lexed.nbColumns + 2;
@@ -122,6 +145,18 @@ ZL_GraphID ZL_CsvParser_registerGraph(
         char sep,
         bool useNullAware,
         const ZL_GraphID clusteringGraph)
+{
+    return ZL_CsvParser_registerGraphWithThreads(
+            compressor, hasHeader, sep, useNullAware, 1, clusteringGraph);
+}
+
+ZL_GraphID ZL_CsvParser_registerGraphWithThreads(
+        ZL_Compressor* compressor,
+        bool hasHeader,
+        char sep,
+        bool useNullAware,
+        size_t nbThreads,
+        const ZL_GraphID clusteringGraph)
 {
     ZL_GraphID* successors = (ZL_GraphID[]){ clusteringGraph,
                                              ZL_GRAPH_COMPRESS_GENERIC,
@@ -138,9 +173,13 @@ ZL_GraphID ZL_CsvParser_registerGraph(
                              {
                                      .paramId    = ZL_PARSER_USE_NULL_AWARE_PID,
                                      .paramValue = useNullAware,
+                             },
+                             {
+                                     .paramId    = ZL_PARSER_NB_THREADS_PID,
+                                     .paramValue = (int)nbThreads,
                              } };
     ZL_LocalParams csvParams = (ZL_LocalParams){
-        .intParams = { .intParams = intParams, .nbIntParams = 3 },
+        .intParams = { .intParams = intParams, .nbIntParams = 4 },
     };
 
     ZL_GraphID csvParserGraph =
@@ -168,3 +207,75 @@ ZL_GraphID ZL_CsvParser_registerGraph(
     return ZL_Compressor_registerParameterizedGraph(
             compressor, &csvParserGraphDesc);
 }
+
+// Cuts the input into chunks of whole rows, which don't depend on each other,
+// so they are compressed in parallel when ZL_CParam_nbWorkers > 1.
+static ZL_Report csvSegmenterFn(ZL_Segmenter* sctx)
+{
+    // The first chunk goes to the parser of the header, the others don't have
+    // one
+    ZL_GraphIDList const graphs = ZL_Segmenter_getCustomGraphs(sctx);
+    ZL_RET_R_IF_NE(graph_invalid, graphs.nbGraphIDs, 2);
+    int const intSep =
+            ZL_Segmenter_getLocalIntParam(sctx, ZL_PARSER_SEPARATOR_PID)
+                    .paramValue;
+    ZL_RET_R_IF(
+            node_invalid_input,
+            (intSep > 255) || (intSep < 0),
+            "Separator must be a char value");
+
+    const ZL_Input* const input = ZL_Segmenter_getInput(sctx, 0);
+    ZL_RET_R_IF_NULL(graph_invalidNumInputs, input);
+    const char* const content = (const char*)ZL_Input_ptr(input);
+    const size_t byteSize     = ZL_Input_contentSize(input);
+
+    size_t pos        = 0;
+    ZL_GraphID parser = graphs.graphids[0];
+    do {
+        // Don't leave a small chunk at the end
+        size_t chunkSize = byteSize - pos;
+        if (chunkSize >= 2 * ZL_CSV_MIN_CHUNK_SIZE) {
+            chunkSize = ZL_CSV_findRowsEnd(
+                    content + pos,
+                    chunkSize,
+                    (char)intSep,
+                    ZL_CSV_MIN_CHUNK_SIZE);
+        }
+        ZL_RET_R_IF_ERR(
+                ZL_Segmenter_processChunk(sctx, &chunkSize, 1, parser, NULL));
+        pos += chunkSize;
+        parser = graphs.graphids[1];
+    } while (pos < byteSize);
+    return ZL_returnSuccess();
+}
+
+ZL_GraphID ZL_CsvParser_registerChunkedGraph(
+        ZL_Compressor* compressor,
+        bool hasHeader,
+        char sep,
+        bool useNullAware,
+        const ZL_GraphID clusteringGraph)
+{
+    ZL_GraphID const successors[] = {
+        ZL_CsvParser_registerGraph(
+                compressor, hasHeader, sep, useNullAware, clusteringGraph),
+        ZL_CsvParser_registerGraph(
+                compressor, false, sep, useNullAware, clusteringGraph),
+    };
+    ZL_IntParam const intParams[] = { {
+            .paramId    = ZL_PARSER_SEPARATOR_PID,
+            .paramValue = sep,
+    } };
+
+    ZL_SegmenterDesc const segDesc = {
+        .name            = "CSV Rows",
+        .segmenterFn     = csvSegmenterFn,
+        .inputTypeMasks  = (ZL_Type[]){ ZL_Type_serial },
+        .numInputs       = 1,
+        .customGraphs    = successors,
+        .numCustomGraphs = 2,
+        .localParams     = { .intParams = { .intParams   = intParams,
+                                            .nbIntParams = 1 } },
+    };
+    return ZL_Compressor_registerSegmenter(compressor, &segDesc);
+}
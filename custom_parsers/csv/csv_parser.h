@@ -17,6 +17,9 @@ extern "C" {
 #define ZL_PARSER_SEPARATOR_PID 226
 // Whether to use the null-aware parser (1) or not (0)
 #define ZL_PARSER_USE_NULL_AWARE_PID 227
+// Number of ranges of the input lexed concurrently on the worker pool,
+// 0 to follow ZL_CParam_nbWorkers, 1 for serial lexing
+#define ZL_PARSER_NB_THREADS_PID 228
 
 /**
  * @brief Registers the csv parser graph. This graph takes a serialized input
@@ -46,6 +49,37 @@ ZL_GraphID ZL_CsvParser_registerGraph(
         bool useNullAware,
         const ZL_GraphID clusteringGraph);
 
+/**
+ * @brief Same as @ref ZL_CsvParser_registerGraph, but lexes the input in up
+ * to @p nbThreads ranges of rows. Large inputs are split into ranges which
+ * are lexed concurrently on the ZL_WorkerPool of the compression, when
+ * ZL_CParam_nbWorkers > 1. 0 follows ZL_CParam_nbWorkers. The output is
+ * identical to serial lexing, and any format version is supported.
+ */
+ZL_GraphID ZL_CsvParser_registerGraphWithThreads(
+        ZL_Compressor* compressor,
+        bool hasHeader,
+        char sep,
+        bool useNullAware,
+        size_t nbThreads,
+        const ZL_GraphID clusteringGraph);
+
+/**
+ * @brief Same as @ref ZL_CsvParser_registerGraph, but cuts the input into
+ * chunks of whole rows, of at least a few MiB each. Chunks are parsed
+ * independently, so they are compressed in parallel when
+ * ZL_CParam_nbWorkers > 1. Only the first chunk holds the header.
+ * Each chunk is clustered on its own, so the frame differs from the one of
+ * @ref ZL_CsvParser_registerGraph.
+ * Chunks require format version >= ZL_CHUNK_VERSION_MIN.
+ */
+ZL_GraphID ZL_CsvParser_registerChunkedGraph(
+        ZL_Compressor* compressor,
+        bool hasHeader,
+        char sep,
+        bool useNullAware,
+        const ZL_GraphID clusteringGraph);
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif
@@ -32,7 +32,9 @@ ZL_GraphID ZL_createGraph_genericCSVCompressorWithOptions(
         ZL_Compressor* compressor,
         bool hasHeader,
         char separator,
-        bool useNullAware) noexcept
+        bool useNullAware,
+        size_t nbThreads,
+        bool chunked) noexcept
 {
     const auto parseExceptionsGraph = ZL_GRAPH_COMPRESS_GENERIC;
     const auto flz1 =
@@ -115,8 +117,21 @@ ZL_GraphID ZL_createGraph_genericCSVCompressorWithOptions(
                     clusteringCodecs.size());
 
     // TODO support non-comma separators
-    return ZL_CsvParser_registerGraph(
-            compressor, hasHeader, separator, useNullAware, clusteringGraph);
+    if (chunked) {
+        return ZL_CsvParser_registerChunkedGraph(
+                compressor,
+                hasHeader,
+                separator,
+                useNullAware,
+                clusteringGraph);
+    }
+    return ZL_CsvParser_registerGraphWithThreads(
+            compressor,
+            hasHeader,
+            separator,
+            useNullAware,
+            nbThreads,
+            clusteringGraph);
 }
 
 } // namespace openzl::custom_parsers
@@ -15,6 +15,9 @@ namespace openzl::custom_parsers {
  * no specific column clusters, and sets up appropriate successors for different
  * data types.
  *
+ * Large inputs are lexed concurrently on the worker pool of the compression
+ * when ZL_CParam_nbWorkers > 1, with the same output as serial lexing.
+ *
  * @param compressor The compressor to register the graph with
  * @returns The graph ID registered for the clustering graph
  */
@@ -28,12 +31,20 @@ ZL_GraphID ZL_createGraph_genericCSVCompressor(
  * @param separator The character used to separate columns. (default: ',')
  * @param useNullAware Whether to use null-aware column coalescing. (default:
  * false)
+ * @param nbThreads The number of ranges of the input lexed concurrently on the
+ * worker pool of the compression, 0 to follow ZL_CParam_nbWorkers. The output
+ * doesn't depend on it. (default: 0)
+ * @param chunked Whether to cut the input into chunks of whole rows, which are
+ * compressed in parallel. Requires format version >= ZL_CHUNK_VERSION_MIN.
+ * See @ref ZL_CsvParser_registerChunkedGraph. (default: false)
  */
 ZL_GraphID ZL_createGraph_genericCSVCompressorWithOptions(
         ZL_Compressor* compressor,
         bool hasHeader,
         char separator,
-        bool useNullAware) noexcept;
+        bool useNullAware,
+        size_t nbThreads = 0,
+        bool chunked     = false) noexcept;
 
 } // namespace openzl::custom_parsers
 
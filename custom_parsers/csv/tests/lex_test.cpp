@@ -1,9 +1,21 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "custom_parsers/csv/csv_lexer.h"
+#include "custom_parsers/csv/csv_profile.h"
+#include "openzl/cpp/ThreadPool.hpp"
+#include "openzl/shared/cpu.h"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_compressor.h"
+#include "openzl/zl_decompress.h"
 #include "openzl/zl_errors.h"
+#include "openzl/zl_version.h"
 
 using namespace ::testing;
 
@@ -90,3 +102,342 @@ TEST(LexTest, singleLine)
         EXPECT_EQ(expectedDispatchIndicess[i], dispatchIndices[i]);
     }
 }
+
+namespace {
+struct Lexed {
+    std::vector<uint32_t> stringLens;
+    std::vector<uint16_t> dispatchIndices;
+
+    bool operator==(const Lexed& other) const
+    {
+        return stringLens == other.stringLens
+                && dispatchIndices == other.dispatchIndices;
+    }
+};
+
+/// Byte-at-a-time lexer, where every quote toggles the quoted state
+Lexed referenceLex(const std::string& input, size_t nbColumns, char sep)
+{
+    Lexed lexed;
+    auto emit = [&](size_t size, size_t dispatch) {
+        lexed.stringLens.push_back((uint32_t)size);
+        lexed.dispatchIndices.push_back((uint16_t)dispatch);
+    };
+    bool inQuote      = false;
+    size_t fieldStart = 0;
+    size_t colIdx     = 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        if (input[i] == '"') {
+            inQuote = !inQuote;
+        } else if (!inQuote && input[i] == sep) {
+            emit(i - fieldStart, colIdx);
+            fieldStart = i;
+            while (i < input.size() && input[i] == sep) {
+                ++colIdx;
+                ++i;
+            }
+            emit(i - fieldStart, nbColumns);
+            fieldStart = i--;
+        } else if (!inQuote && input[i] == '\n') {
+            emit(i - fieldStart, colIdx);
+            emit(1, nbColumns);
+            fieldStart = i + 1;
+            colIdx     = 0;
+        }
+    }
+    return lexed;
+}
+
+ZL_Report lex(Lexed& lexed, const std::string& input, size_t nbColumns)
+{
+    lexed.stringLens.assign(2 * nbColumns * (input.size() + 1), 0);
+    lexed.dispatchIndices.assign(lexed.stringLens.size(), 0);
+    auto e = createNullAwareLexAndDispatch(
+            lexed.stringLens.data(),
+            lexed.dispatchIndices.data(),
+            input.data(),
+            input.size(),
+            nbColumns,
+            ',');
+    size_t const nbStrs = ZL_isError(e) ? 0 : ZL_validResult(e);
+    lexed.stringLens.resize(nbStrs);
+    lexed.dispatchIndices.resize(nbStrs);
+    return e;
+}
+} // namespace
+
+TEST(LexTest, quotes)
+{
+    // Separators, newlines and escaped quotes within quotes
+    std::string const input =
+            "\"a,\"\"b\"\"\n\",c\n"
+            "d,\"\"\"\"\n";
+    Lexed lexed;
+    auto e = lex(lexed, input, 2);
+    ASSERT_FALSE(ZL_isError(e));
+    EXPECT_EQ(
+            lexed.stringLens,
+            std::vector<uint32_t>({ 10, 1, 1, 1, 1, 1, 4, 1 }));
+    EXPECT_EQ(
+            lexed.dispatchIndices,
+            std::vector<uint16_t>({ 0, 2, 1, 2, 0, 2, 1, 2 }));
+
+    EXPECT_TRUE(ZL_isError(lex(lexed, "a,\"b\n", 2)));
+    EXPECT_TRUE(ZL_isError(lex(lexed, "a,b,c\n", 2)));
+}
+
+TEST(LexTest, matchesReference)
+{
+    std::mt19937 gen(42);
+    char const alphabet[] = { 'a', 'b', ',', ',', '"', '\n' };
+    std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 1);
+    size_t const nbColumns = 300;
+    for (size_t size : { 1, 63, 64, 65, 1000, 4095, 4096, 4097, 100000 }) {
+        std::string input;
+        for (size_t i = 0; i + 1 < size; ++i) {
+            input += alphabet[pick(gen)];
+        }
+        input += '\n';
+        // Close the last quote, if any
+        if (std::count(input.begin(), input.end(), '"') % 2 != 0) {
+            input.insert(input.begin(), '"');
+        }
+        auto const expected = referenceLex(input, nbColumns, ',');
+        for (unsigned mask : { 0u, (unsigned)ZL_CPU_FEATURES_ALL }) {
+            ZL_cpuFeatures_setMask(mask);
+            Lexed lexed;
+            auto e = lex(lexed, input, nbColumns);
+            ASSERT_FALSE(ZL_isError(e));
+            EXPECT_TRUE(lexed == expected) << "size " << size;
+        }
+    }
+    ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+}
+
+TEST(LexTest, findRowsEnd)
+{
+    std::string const input = "a,b\n\"1\n2\",3\n4,5\n6,7";
+    for (size_t minSize : { 0, 1, 4 }) {
+        EXPECT_EQ(
+                ZL_CSV_findRowsEnd(input.data(), input.size(), ',', minSize),
+                4);
+    }
+    // The newline within quotes doesn't end a row
+    EXPECT_EQ(ZL_CSV_findRowsEnd(input.data(), input.size(), ',', 5), 12);
+    EXPECT_EQ(ZL_CSV_findRowsEnd(input.data(), input.size(), ',', 12), 12);
+    EXPECT_EQ(ZL_CSV_findRowsEnd(input.data(), input.size(), ',', 13), 16);
+    EXPECT_EQ(
+            ZL_CSV_findRowsEnd(input.data(), input.size(), ',', 17),
+            input.size());
+
+    // Newlines past the first blocks
+    std::string const quoted = "\"" + std::string(1000, '\n') + "\"\n";
+    std::string const longInput = quoted + quoted + "x";
+    for (size_t minSize : { 0, 1, 64, 500, 1003 }) {
+        EXPECT_EQ(
+                ZL_CSV_findRowsEnd(
+                        longInput.data(), longInput.size(), ',', minSize),
+                quoted.size());
+    }
+    EXPECT_EQ(
+            ZL_CSV_findRowsEnd(longInput.data(), longInput.size(), ',', 1004),
+            2 * quoted.size());
+}
+
+namespace {
+/// Runs tasks on a ThreadPool, and records the largest batch of tasks it was
+/// given, i.e. how much work could run in parallel.
+class BatchRecordingPool {
+   public:
+    explicit BatchRecordingPool(size_t nbThreads) : pool_(nbThreads) {}
+
+    ZL_WorkerPool get()
+    {
+        ZL_WorkerPool workerPool;
+        workerPool.opaque   = this;
+        workerPool.runTasks = [](void* opaque,
+                                 ZL_WorkerTaskFn task,
+                                 void* taskCtx,
+                                 size_t nbTasks) {
+            auto* const self    = static_cast<BatchRecordingPool*>(opaque);
+            self->maxBatchSize_ = std::max(self->maxBatchSize_, nbTasks);
+            self->pool_.runTasks(task, taskCtx, nbTasks);
+        };
+        return workerPool;
+    }
+
+    size_t maxBatchSize() const
+    {
+        return maxBatchSize_;
+    }
+
+   private:
+    openzl::ThreadPool pool_;
+    size_t maxBatchSize_ = 0;
+};
+
+struct CsvOptions {
+    bool useNullAware = false;
+    size_t nbThreads  = 0;
+    bool chunked      = false;
+    int nbWorkers     = 1;
+    int formatVersion = ZL_MAX_FORMAT_VERSION;
+};
+
+/// @returns the compressed input, or an empty string on error
+std::string compressCsv(
+        const std::string& input,
+        const CsvOptions& options,
+        BatchRecordingPool* pool)
+{
+    ZL_Compressor* compressor = ZL_Compressor_create();
+    auto gid = openzl::custom_parsers::
+            ZL_createGraph_genericCSVCompressorWithOptions(
+                    compressor,
+                    true,
+                    ',',
+                    options.useNullAware,
+                    options.nbThreads,
+                    options.chunked);
+    EXPECT_FALSE(
+            ZL_isError(ZL_Compressor_selectStartingGraphID(compressor, gid)));
+    ZL_CCtx* cctx = ZL_CCtx_create();
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_formatVersion, options.formatVersion)));
+    if (options.formatVersion >= ZL_SEEK_TABLE_VERSION_MIN) {
+        // The seek table tells how the input was cut into chunks
+        EXPECT_FALSE(ZL_isError(
+                ZL_CCtx_setParameter(cctx, ZL_CParam_seekTable, 1)));
+    }
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_nbWorkers, options.nbWorkers)));
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        EXPECT_FALSE(ZL_isError(ZL_CCtx_setWorkerPool(cctx, &workerPool)));
+    }
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_refCompressor(cctx, compressor)));
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    ZL_Report const r = ZL_CCtx_compress(
+            cctx,
+            compressed.data(),
+            compressed.size(),
+            input.data(),
+            input.size());
+    compressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return compressed;
+}
+
+/// Rows with quoted separators and newlines, of at least @p size bytes
+std::string genCsv(size_t size)
+{
+    std::mt19937 gen(7);
+    std::string input = "id,name,note\n";
+    while (input.size() < size) {
+        input += std::to_string(gen() % 100000) + ",name"
+                + std::to_string(gen() % 100) + ",";
+        switch (gen() % 8) {
+            case 0:
+                input += "\"quoted, \"\"text\"\"\nwith newlines\n\"";
+                break;
+            case 1:
+                break;
+            default:
+                input += "plain";
+        }
+        input += '\n';
+    }
+    return input;
+}
+
+void expectRoundTrip(const std::string& compressed, const std::string& input)
+{
+    std::string decompressed(input.size(), '\0');
+    ZL_Report const r = ZL_decompress(
+            decompressed.data(),
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+    ASSERT_FALSE(ZL_isError(r));
+    EXPECT_EQ(decompressed, input);
+}
+} // namespace
+
+TEST(LexTest, parallelMatchesSerial)
+{
+    std::string const input = genCsv(3 << 20);
+    // A quoted field spanning several ranges
+    std::string const longField(1 << 20, '\n');
+    std::string const longRow = "1,\"" + longField + "\",x\n";
+    std::string withLongField = input;
+    withLongField.insert(withLongField.find('\n', 1 << 20) + 1, longRow);
+    // A missing column, in the middle of a range
+    std::string malformed = input;
+    malformed.insert(malformed.find("plain\n", 1 << 19) + 6, "1,2\n");
+
+    BatchRecordingPool pool(3);
+    for (bool useNullAware : { false, true }) {
+        CsvOptions serial;
+        serial.useNullAware = useNullAware;
+        for (auto const& data : { input, withLongField }) {
+            auto const expected = compressCsv(data, serial, nullptr);
+            ASSERT_FALSE(expected.empty());
+            expectRoundTrip(expected, data);
+            for (int nbWorkers : { 2, 4 }) {
+                for (size_t nbThreads : { 0, 3, 8 }) {
+                    CsvOptions parallel = serial;
+                    parallel.nbWorkers  = nbWorkers;
+                    parallel.nbThreads  = nbThreads;
+                    EXPECT_EQ(compressCsv(data, parallel, &pool), expected)
+                            << "nbWorkers=" << nbWorkers
+                            << ", nbThreads=" << nbThreads;
+                }
+            }
+            // Frames older than chunks are supported as well
+            CsvOptions old      = serial;
+            old.formatVersion   = ZL_CHUNK_VERSION_MIN - 1;
+            auto const oldFrame = compressCsv(data, old, nullptr);
+            ASSERT_FALSE(oldFrame.empty());
+            old.nbWorkers = 4;
+            EXPECT_EQ(compressCsv(data, old, &pool), oldFrame);
+        }
+        if (!useNullAware) {
+            CsvOptions parallel = serial;
+            parallel.nbWorkers  = 8;
+            EXPECT_EQ(
+                    compressCsv(malformed, parallel, &pool),
+                    compressCsv(malformed, serial, nullptr));
+        }
+    }
+    // Ranges were lexed on the workers together
+    EXPECT_GT(pool.maxBatchSize(), 1);
+}
+
+TEST(LexTest, chunkedRows)
+{
+    // Large enough to be cut into several chunks of whole rows
+    std::string input = genCsv(20 << 20);
+    // A quoted field spanning the first chunk boundary
+    std::string const longField(1 << 20, '\n');
+    input.insert(
+            input.find('\n', (8 << 20) - (1 << 19)) + 1,
+            "1,\"" + longField + "\",x\n");
+
+    BatchRecordingPool pool(3);
+    for (bool useNullAware : { false, true }) {
+        CsvOptions serial;
+        serial.useNullAware = useNullAware;
+        serial.chunked      = true;
+        auto const expected = compressCsv(input, serial, nullptr);
+        ASSERT_FALSE(expected.empty());
+        CsvOptions parallel = serial;
+        parallel.nbWorkers  = 4;
+        EXPECT_EQ(compressCsv(input, parallel, &pool), expected);
+        ZL_Report const nbChunks =
+                ZL_getNumChunks(expected.data(), expected.size());
+        ASSERT_FALSE(ZL_isError(nbChunks));
+        EXPECT_EQ(ZL_validResult(nbChunks), 2);
+        expectRoundTrip(expected, input);
+    }
+}
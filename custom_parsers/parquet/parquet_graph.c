@@ -3,20 +3,25 @@
 #include "parquet_graph.h"
 
 #include "custom_parsers/parquet/parquet_lexer.h"
+#include "openzl/codecs/zl_bitunpack.h"
+#include "openzl/common/map.h"
 #include "openzl/compress/graphs/generic_clustering_graph.h"
+#include "openzl/shared/xxhash.h"
 #include "openzl/zl_dyngraph.h"
 #include "openzl/zl_errors.h"
 #include "openzl/zl_graph_api.h"
-
-#include <stdio.h>
-#include <time.h>
-static double parquetGraphFn_time_ms = 0.0;
+#include "openzl/zl_segmenter.h"
 
 #define ZL_TRY_SET_EL(_var, _expr) ZL_TRY_SET_T(ZL_EdgeList, _var, _expr)
 
-// Run the conversion node for the given type and width.
-static ZL_Report
-runConversion(ZL_Edge* in, ZL_Edge** out, ZL_Type type, size_t width)
+// Run the conversion node for the given type and width, or unpack the elements
+// if they are bit-packed.
+static ZL_Report runConversion(
+        ZL_Edge* in,
+        ZL_Edge** out,
+        ZL_Type type,
+        size_t width,
+        uint32_t bitWidth)
 {
     ZL_RESULT_DECLARE_SCOPE_REPORT(in);
     if (type == ZL_Type_serial) {
@@ -25,7 +30,14 @@ runConversion(ZL_Edge* in, ZL_Edge** out, ZL_Type type, size_t width)
     }
 
     ZL_EdgeList el;
-    if (type == ZL_Type_numeric) {
+    if (bitWidth > 0) {
+        // Unpacks to numeric elements of the width given by the lexer
+        ZL_IntParam const intParam = { ZL_Bitunpack_numBits, (int)bitWidth };
+        ZL_LocalParams lParams     = { .intParams = { &intParam, 1 } };
+        ZL_TRY_SET_EL(
+                el,
+                ZL_Edge_runNode_withParams(in, ZS2_NODE_BITUNPACK, &lParams));
+    } else if (type == ZL_Type_numeric) {
         if (width == 1) {
             ZL_TRY_SET_EL(el, ZL_Edge_runNode(in, ZL_NODE_INTERPRET_AS_LE8));
         } else if (width == 2) {
@@ -54,89 +66,188 @@ runConversion(ZL_Edge* in, ZL_Edge** out, ZL_Type type, size_t width)
     return ZL_returnSuccess();
 }
 
-static ZL_Report parquetGraphInner(
-        ZL_Graph* graph,
-        ZL_Edge* ins[],
-        size_t nbIns,
-        ZL_ParquetLexer* lexer)
+/// The stream that page data belongs to. Page data of the same stream is
+/// dispatched to the same edge.
+typedef struct {
+    /// Tag of the schema element of the page, used for clustering.
+    uint32_t tag;
+    ZL_Type type;
+    uint32_t width;
+    /// Non-zero if the elements are bit-packed
+    uint32_t bitWidth;
+} ParquetStream;
+
+/// A contiguous range of the Parquet file. Page data is dispatched to the edge
+/// of its stream, and everything else to the metadata edge.
+/// Also the layout of a row group, passed from the row group segmenter to the
+/// row group graph, so it must not contain any pointer.
+typedef struct {
+    uint64_t size;
+    uint32_t isPageData;
+    /// Only valid for page data.
+    ParquetStream stream;
+} ParquetSegment;
+
+ZL_FORCE_INLINE size_t ParquetStreamMap_hash(ParquetStream const* key)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
+    return (size_t)XXH3_64bits(key, sizeof(*key));
+}
 
-    ZL_RESULT_DECLARE_SCOPE_REPORT(graph);
-    ZL_ERR_IF_NE(nbIns, 1, graph_invalidNumInputs);
-    ZL_Edge* edge               = ins[0];
-    ZL_Input const* const input = ZL_Edge_getData(edge);
-    const size_t size           = ZL_Input_numElts(input);
-    ZL_ErrorContext* errCtx     = ZL_GET_DEFAULT_ERROR_CONTEXT(graph);
+ZL_FORCE_INLINE bool ParquetStreamMap_eq(
+        ParquetStream const* lhs,
+        ParquetStream const* rhs)
+{
+    return lhs->tag == rhs->tag && lhs->type == rhs->type
+            && lhs->width == rhs->width && lhs->bitWidth == rhs->bitWidth;
+}
 
-    // Will return an error if the input is not a valid Parquet file.
-    ZL_ERR_IF_ERR(
-            ZL_ParquetLexer_init(lexer, ZL_Input_ptr(input), size, errCtx));
+/// Maps each stream to its dispatch tag
+ZL_DECLARE_CUSTOM_MAP_TYPE(ParquetStreamMap, ParquetStream, uint32_t);
 
-    // Allocate space for segment sizes.
-    ZL_TRY_LET_R(maxNbSegments, ZL_ParquetLexer_maxNumTokens(lexer, errCtx));
-    ZL_ERR_IF_EQ(maxNbSegments, 0, corruption);
-    size_t* const segmentSizes =
-            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(size_t));
-    uint32_t* const dispatchTags =
-            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(uint32_t));
+/// Copy parameter of the row group graph: its array of ParquetSegment
+#define ZL_PARQUET_ROW_GROUP_LAYOUT_PID 229
 
-    // Allocate space for token metadata. Note: the tag here is different from
-    // the "dispatch tag" above. This tag identifies the schema element that a
-    // given data page belongs to.
-    uint32_t* const tags =
-            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(uint32_t));
-    ZL_Type* const types =
-            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(ZL_Type));
-    size_t* const widths =
-            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(size_t));
+/// Chunks of the row group segmenter are made of whole row groups, and of at
+/// least this many bytes, unless the file is smaller.
+#define ZL_PARQUET_MIN_CHUNK_SIZE ((size_t)8 << 20)
 
-    ZL_ERR_IF_NULL(segmentSizes, allocation);
+static bool isPageData(ZL_ParquetTokenType type)
+{
+    return type != ZL_ParquetTokenType_Magic
+            && type != ZL_ParquetTokenType_Footer
+            && type != ZL_ParquetTokenType_PageHeader;
+}
 
-    // Header stream metadata
-    tags[0]   = 0;
-    types[0]  = ZL_Type_serial;
-    widths[0] = 1;
+/// The stream of everything but page data
+static const ParquetStream kParquetHeaderStream = { 0, ZL_Type_serial, 1, 0 };
 
-    // Iterate over all the tokens in the Parquet file, and fill out
-    // segmentSizes and tags. All non-data pages are dispatched to the 0th
-    // output edge. All data pages are dispatched to their own output edge.
-    size_t nbSegments = 0;
-    uint32_t nbTags   = 0;
+static ParquetStream parquetTokenStream(const ZL_ParquetToken* token)
+{
+    ParquetStream const stream = {
+        .tag      = token->tag,
+        .type     = token->dataType,
+        .width    = (uint32_t)token->dataWidth,
+        .bitWidth = token->bitWidth,
+    };
+    return stream;
+}
 
+// Lexes all the remaining tokens of @p lexer into @p segments, or only counts
+// them if @p segments is NULL.
+// @returns the number of segments
+static ZL_Report parquetLexSegments(
+        ZL_ParquetLexer* lexer,
+        ParquetSegment* segments,
+        size_t capacity,
+        ZL_ErrorContext* errCtx)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(errCtx);
+    size_t nbSegments = 0;
     while (!ZL_ParquetLexer_finished(lexer)) {
         ZL_ParquetToken tokens[32] = { 0 };
         size_t nbTokens            = 0;
         ZL_TRY_SET_R(nbTokens, ZL_ParquetLexer_lex(lexer, tokens, 32, errCtx));
+        if (segments == NULL) {
+            nbSegments += nbTokens;
+            continue;
+        }
         for (size_t i = 0; i < nbTokens; ++i) {
-            ZL_ERR_IF_GE(nbSegments, maxNbSegments, GENERIC);
+            ZL_ERR_IF_GE(nbSegments, capacity, GENERIC);
             const ZL_ParquetToken token = tokens[i];
-            bool isDataPage = token.type == ZL_ParquetTokenType_DataPage;
-            // Fill in dispatch instructions.
-            segmentSizes[nbSegments] = token.size;
-            dispatchTags[nbSegments] = isDataPage ? ++nbTags : 0;
-
-            // Fill in token metadata.
-            if (isDataPage) {
-                tags[nbTags]   = token.tag;
-                types[nbTags]  = token.dataType;
-                widths[nbTags] = token.dataWidth;
-            }
-            ++nbSegments;
+            ParquetSegment* const seg   = &segments[nbSegments++];
+            seg->size                   = token.size;
+            seg->isPageData             = isPageData(token.type);
+            seg->stream = seg->isPageData ? parquetTokenStream(&token)
+                                          : kParquetHeaderStream;
+        }
+    }
+    return ZL_returnValue(nbSegments);
+}
+
+// Assigns a dispatch tag to each segment: 0 to non page data, and the index of
+// its stream in @p streams, plus 1, to page data.
+// @returns the number of streams
+static ZL_Report parquetAssignStreams(
+        ZL_Graph* graph,
+        const ParquetSegment* segments,
+        size_t nbSegments,
+        uint32_t* dispatchTags,
+        ParquetStream* streams)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(graph);
+    ZL_ERR_IF_GE(nbSegments, UINT32_MAX, temporaryLibraryLimitation);
+    ParquetStreamMap map = ParquetStreamMap_create((uint32_t)nbSegments);
+    uint32_t nbStreams   = 0;
+    for (size_t i = 0; i < nbSegments; ++i) {
+        const ParquetSegment* const seg = &segments[i];
+        if (!seg->isPageData) {
+            dispatchTags[i] = 0;
+            continue;
+        }
+        ParquetStreamMap_Insert const insert = ParquetStreamMap_insertVal(
+                &map, (ParquetStreamMap_Entry){ seg->stream, nbStreams + 1 });
+        if (insert.badAlloc) {
+            ParquetStreamMap_destroy(&map);
+            ZL_ERR(allocation);
         }
+        if (insert.inserted) {
+            streams[nbStreams++] = seg->stream;
+        }
+        dispatchTags[i] = insert.ptr->val;
     }
+    ParquetStreamMap_destroy(&map);
+    return ZL_returnValue(nbStreams);
+}
+
+// Dispatches the input @p edge along @p segments, converts page data to its
+// type, and sends it to the clustering graph. Page data of the same stream is
+// concatenated.
+static ZL_Report parquetDispatchSegments(
+        ZL_Graph* graph,
+        ZL_Edge* edge,
+        const ParquetSegment* segments,
+        size_t nbSegments)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(graph);
+    size_t const maxNbSegments = nbSegments > 0 ? nbSegments : 1;
+
+    // Allocate space for segment sizes.
+    size_t* const segmentSizes =
+            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(size_t));
+    uint32_t* const dispatchTags =
+            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(uint32_t));
+
+    // Allocate space for stream metadata. Note: the tag of a stream is
+    // different from the "dispatch tag" above. It identifies the schema
+    // element that the page data belongs to.
+    ParquetStream* const streams =
+            ZL_Graph_getScratchSpace(graph, maxNbSegments * sizeof(*streams));
+
+    ZL_ERR_IF_NULL(segmentSizes, allocation);
+    ZL_ERR_IF_NULL(dispatchTags, allocation);
+    ZL_ERR_IF_NULL(streams, allocation);
+
+    for (size_t i = 0; i < nbSegments; ++i) {
+        segmentSizes[i] = (size_t)segments[i].size;
+    }
+
+    // All non-data pages are dispatched to the 0th output edge. Page data is
+    // dispatched to the output edge of its stream.
+    ZL_TRY_LET_R(
+            nbStreams,
+            parquetAssignStreams(
+                    graph, segments, nbSegments, dispatchTags, streams));
 
     ZL_DispatchInstructions di = {
         .segmentSizes = segmentSizes,
         .nbSegments   = nbSegments,
         .tags         = dispatchTags,
-        .nbTags       = nbTags + 1,
+        .nbTags       = (unsigned)nbStreams + 1,
     };
 
     // Split the input according to segmentSizes
     ZL_TRY_LET_T(ZL_EdgeList, el, ZL_Edge_runDispatchNode(edge, &di));
-    ZL_ERR_IF_NE(el.nbEdges, nbTags + 3, GENERIC);
+    ZL_ERR_IF_NE(el.nbEdges, nbStreams + 3, GENERIC);
 
     // Set the destination for the tags and segment sizes
     ZL_ERR_IF_ERR(
@@ -147,24 +258,21 @@ static ZL_Report parquetGraphInner(
     ZL_Edge** const edges = el.edges + 2;
     size_t const nbEdges  = el.nbEdges - 2;
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    parquetGraphFn_time_ms += current_duration;
-    fprintf(stderr, "[parquetGraphInner] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms\n", start_time_ms, end_time_ms, parquetGraphFn_time_ms);
-    // Set the metadata for each edge and run the conversion
+    // Set the metadata for each edge and run the conversion. The first edge
+    // holds the headers, which are serial.
     for (size_t i = 0; i < nbEdges; ++i) {
         ZL_Edge* in  = edges[i];
         ZL_Edge* out = NULL;
+        const ParquetStream* const stream =
+                i == 0 ? &kParquetHeaderStream : &streams[i - 1];
 
         // Run the conversion
-        ZL_ERR_IF_ERR(runConversion(in, &out, types[i], widths[i]));
+        ZL_ERR_IF_ERR(runConversion(
+                in, &out, stream->type, stream->width, stream->bitWidth));
 
         // Set the tag metadata for the clustering node
         ZL_ERR_IF_ERR(ZL_Edge_setIntMetadata(
-                out, ZL_CLUSTERING_TAG_METADATA_ID, (int)tags[i]));
+                out, ZL_CLUSTERING_TAG_METADATA_ID, (int)stream->tag));
         edges[i] = out;
     }
 
@@ -177,6 +285,42 @@ static ZL_Report parquetGraphInner(
     return ZL_returnSuccess();
 }
 
+static ZL_Report parquetGraphInner(
+        ZL_Graph* graph,
+        ZL_Edge* ins[],
+        size_t nbIns,
+        ZL_ParquetLexer* lexer)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(graph);
+    ZL_ERR_IF_NE(nbIns, 1, graph_invalidNumInputs);
+    ZL_Edge* edge               = ins[0];
+    ZL_Input const* const input = ZL_Edge_getData(edge);
+    const size_t size           = ZL_Input_numElts(input);
+    ZL_ErrorContext* errCtx     = ZL_GET_DEFAULT_ERROR_CONTEXT(graph);
+
+    // Will return an error if the input is not a valid Parquet file.
+    ZL_ERR_IF_ERR(
+            ZL_ParquetLexer_init(lexer, ZL_Input_ptr(input), size, errCtx));
+
+    // Count the segments, then lex them again into space allocated at once.
+    // Encoded pages are made of many small segments, so the bound of
+    // ZL_ParquetLexer_maxNumTokens() would take much more space.
+    ZL_TRY_LET_R(maxNbSegments, parquetLexSegments(lexer, NULL, 0, errCtx));
+    ZL_ERR_IF_EQ(maxNbSegments, 0, corruption);
+    ParquetSegment* const segments = ZL_Graph_getScratchSpace(
+            graph, maxNbSegments * sizeof(ParquetSegment));
+    ZL_ERR_IF_NULL(segments, allocation);
+
+    // Iterate over all the tokens in the Parquet file
+    ZL_ERR_IF_ERR(
+            ZL_ParquetLexer_init(lexer, ZL_Input_ptr(input), size, errCtx));
+    ZL_TRY_LET_R(
+            nbSegments,
+            parquetLexSegments(lexer, segments, maxNbSegments, errCtx));
+
+    return parquetDispatchSegments(graph, edge, segments, nbSegments);
+}
+
 // Wrapper around the inner graph function that allocates a lexer
 static ZL_Report parquetGraphFn(ZL_Graph* graph, ZL_Edge* sctxs[], size_t nbIns)
 {
@@ -188,6 +332,122 @@ static ZL_Report parquetGraphFn(ZL_Graph* graph, ZL_Edge* sctxs[], size_t nbIns)
     return ret;
 }
 
+// Dispatches a chunk of the row group segmenter along the layout passed as a
+// parameter, without lexing it again.
+static ZL_Report
+parquetRowGroupGraphFn(ZL_Graph* graph, ZL_Edge* ins[], size_t nbIns)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(graph);
+    ZL_ERR_IF_NE(nbIns, 1, graph_invalidNumInputs);
+    ZL_RefParam const layout =
+            ZL_Graph_getLocalRefParam(graph, ZL_PARQUET_ROW_GROUP_LAYOUT_PID);
+    ZL_ERR_IF_NULL(layout.paramRef, graphParameter_invalid);
+    ZL_ERR_IF_NE(
+            layout.paramSize % sizeof(ParquetSegment),
+            0,
+            graphParameter_invalid);
+    const ParquetSegment* const segments = layout.paramRef;
+    size_t const nbSegments = layout.paramSize / sizeof(ParquetSegment);
+
+    // The dispatch node validates that the segments cover the input
+    return parquetDispatchSegments(graph, ins[0], segments, nbSegments);
+}
+
+// Lexes the row groups [@p first, @p last) and sends them as a single chunk
+// to the row group graph.
+static ZL_Report parquetProcessRowGroups(
+        ZL_Segmenter* sctx,
+        ZL_ParquetLexer* lexer,
+        size_t first,
+        size_t last,
+        ZL_GraphID rowGroupGraph)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(NULL);
+    // Count the segments first, to allocate the layout at once
+    size_t capacity = 0;
+    for (size_t rg = first; rg < last; ++rg) {
+        ZL_ERR_IF_ERR(ZL_ParquetLexer_initRowGroup(lexer, rg, NULL));
+        ZL_TRY_LET_R(nb, parquetLexSegments(lexer, NULL, 0, NULL));
+        capacity += nb;
+    }
+    ParquetSegment* const segments =
+            ZL_Segmenter_getScratchSpace(sctx, capacity * sizeof(*segments));
+    ZL_ERR_IF_NULL(segments, allocation);
+
+    size_t nbSegments = 0;
+    size_t chunkSize  = 0;
+    for (size_t rg = first; rg < last; ++rg) {
+        ZL_ERR_IF_ERR(ZL_ParquetLexer_initRowGroup(lexer, rg, NULL));
+        ZL_TRY_LET_R(
+                nb,
+                parquetLexSegments(
+                        lexer,
+                        segments + nbSegments,
+                        capacity - nbSegments,
+                        NULL));
+        for (size_t i = nbSegments; i < nbSegments + nb; ++i) {
+            chunkSize += (size_t)segments[i].size;
+        }
+        nbSegments += nb;
+    }
+
+    ZL_CopyParam const layout = {
+        .paramId   = ZL_PARQUET_ROW_GROUP_LAYOUT_PID,
+        .paramPtr  = segments,
+        .paramSize = nbSegments * sizeof(*segments),
+    };
+    ZL_LocalParams const localParams = { .copyParams = { &layout, 1 } };
+    ZL_RuntimeGraphParameters const params = { .localParams = &localParams };
+    ZL_ERR_IF_ERR(ZL_Segmenter_processChunk(
+            sctx, &chunkSize, 1, rowGroupGraph, &params));
+    return ZL_returnSuccess();
+}
+
+// Cuts the Parquet file into chunks of whole row groups, which don't depend on
+// each other, so they are compressed in parallel when ZL_CParam_nbWorkers > 1.
+static ZL_Report parquetRowGroupSegmenterFn(ZL_Segmenter* sctx)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(NULL);
+    ZL_GraphIDList const graphs = ZL_Segmenter_getCustomGraphs(sctx);
+    ZL_ERR_IF_NE(graphs.nbGraphIDs, 2, graph_invalid);
+    ZL_GraphID const rowGroupGraph = graphs.graphids[0];
+    ZL_GraphID const parserGraph   = graphs.graphids[1];
+
+    ZL_Input const* const input = ZL_Segmenter_getInput(sctx, 0);
+    ZL_ERR_IF_NULL(input, graph_invalidNumInputs);
+    size_t const size = ZL_Input_numElts(input);
+
+    ZL_ParquetLexer* const lexer = ZL_ParquetLexer_create();
+    ZL_ERR_IF_NULL(lexer, allocation);
+    ZL_Report ret =
+            ZL_ParquetLexer_init(lexer, ZL_Input_ptr(input), size, NULL);
+    size_t const nbRowGroups = ZL_ParquetLexer_numRowGroups(lexer);
+    if (ZL_isError(ret) || nbRowGroups == 0) {
+        // Let the parser graph report the error, or compress the file whole
+        ZL_ParquetLexer_free(lexer);
+        size_t chunkSize = size;
+        return ZL_Segmenter_processChunk(
+                sctx, &chunkSize, 1, parserGraph, NULL);
+    }
+
+    size_t first       = 0;
+    size_t firstOffset = 0;
+    for (size_t rg = 1; rg <= nbRowGroups && !ZL_isError(ret); ++rg) {
+        size_t const offset = rg == nbRowGroups
+                ? size
+                : ZL_ParquetLexer_rowGroupOffset(lexer, rg);
+        if (offset - firstOffset < ZL_PARQUET_MIN_CHUNK_SIZE
+            && rg < nbRowGroups) {
+            continue;
+        }
+        ret = parquetProcessRowGroups(sctx, lexer, first, rg, rowGroupGraph);
+        first       = rg;
+        firstOffset = offset;
+    }
+    ZL_ParquetLexer_free(lexer);
+    return ret;
+}
+
 ZL_GraphID ZL_Parquet_registerGraph(
         ZL_Compressor* compressor,
         ZL_GraphID clusteringGraph)
@@ -215,3 +475,45 @@ ZL_GraphID ZL_Parquet_registerGraph(
     };
     return ZL_Compressor_registerParameterizedGraph(compressor, &desc);
 }
+
+ZL_GraphID ZL_Parquet_registerRowGroupGraph(
+        ZL_Compressor* compressor,
+        ZL_GraphID clusteringGraph)
+{
+    ZL_GraphID rowGroup =
+            ZL_Compressor_getGraph(compressor, "Parquet Row Group");
+
+    if (rowGroup.gid == ZL_GRAPH_ILLEGAL.gid) {
+        // Register the anchor graph
+        ZL_FunctionGraphDesc desc = {
+            .name           = "!Parquet Row Group",
+            .graph_f        = parquetRowGroupGraphFn,
+            .inputTypeMasks = (ZL_Type[]){ ZL_Type_serial },
+            .nbInputs       = 1,
+        };
+
+        rowGroup = ZL_Compressor_registerFunctionGraph(compressor, &desc);
+    }
+
+    // Register the parameterized graph
+    ZL_ParameterizedGraphDesc const desc = {
+        .name           = "Parquet Row Group",
+        .graph          = rowGroup,
+        .customGraphs   = &clusteringGraph,
+        .nbCustomGraphs = 1,
+    };
+    ZL_GraphID const successors[] = {
+        ZL_Compressor_registerParameterizedGraph(compressor, &desc),
+        ZL_Parquet_registerGraph(compressor, clusteringGraph),
+    };
+
+    ZL_SegmenterDesc const segDesc = {
+        .name            = "Parquet Row Groups",
+        .segmenterFn     = parquetRowGroupSegmenterFn,
+        .inputTypeMasks  = (ZL_Type[]){ ZL_Type_serial },
+        .numInputs       = 1,
+        .customGraphs    = successors,
+        .numCustomGraphs = 2,
+    };
+    return ZL_Compressor_registerSegmenter(compressor, &segDesc);
+}
@@ -14,14 +14,36 @@ ZL_BEGIN_C_DECLS
  * @param compressor The compressor to register the graph with.
  * @param clusteringGraph The clustering graph to use as a successor.
  *
+ * Column chunks must be uncompressed, and stored back to back. Data pages may
+ * be PLAIN, RLE_DICTIONARY or DELTA_BINARY_PACKED encoded: PLAIN values and
+ * dictionary pages are converted to the type of their column. Dictionary
+ * indices and deltas are decoded into numeric streams (RLE run values and
+ * bit-unpacked runs), tagged apart from the values, while their headers are
+ * sent as serial streams.
+ *
  * @warning This graph will fail to compress if the input is not a valid Parquet
- * file in the canonical format. You can produve a canonical Parquet file using
+ * file in this format. You can produce a canonical Parquet file using
  * the canonicalization script (/tools/parquet/make_canonical_parquet.cpp).
  */
 ZL_GraphID ZL_Parquet_registerGraph(
         ZL_Compressor* compressor,
         ZL_GraphID clusteringGraph);
 
+/**
+ * Registration function for the Parquet graph which compresses row groups
+ * independently. It accepts the same files as ZL_Parquet_registerGraph().
+ *
+ * Consecutive row groups are grouped into chunks of at least a few MiB, which
+ * are compressed in parallel when ZL_CParam_nbWorkers > 1.
+ * Chunks require format version >= ZL_CHUNK_VERSION_MIN.
+ *
+ * @param compressor The compressor to register the graph with.
+ * @param clusteringGraph The clustering graph to use as a successor.
+ */
+ZL_GraphID ZL_Parquet_registerRowGroupGraph(
+        ZL_Compressor* compressor,
+        ZL_GraphID clusteringGraph);
+
 ZL_END_C_DECLS
 
 #endif
@@ -9,8 +9,10 @@
 #include "openzl/zl_errors.h"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <exception>
 #include <memory>
+#include <new>
 #include <string>
 #include <vector>
 
@@ -19,24 +21,35 @@ using namespace zstrong::parquet;
 struct ZL_ParquetLexer_s {
     /// Pointer to the current position in the input buffer.
     /// Everything before this pointer has already been lexed.
-    const char* currPtr;
+    const char* currPtr = nullptr;
+    /// Pointer to the end of the bytes to lex: the end of the input buffer,
+    /// or the end of the selected row group.
+    const char* endPtr = nullptr;
     /// Pointer to the footer of the input buffer.
-    const char* footerPtr;
+    const char* footerPtr = nullptr;
     /// Pointer to the end of the input buffer.
-    const char* srcEnd;
+    const char* srcEnd = nullptr;
     /// Pointer to the beginning of the input buffer.
-    const char* srcBegin;
+    const char* srcBegin = nullptr;
     /// The file metadata.
     std::unique_ptr<FileMetadata> fileMetadata;
+    /// The offset of each row group in the input buffer, followed by the
+    /// offset of the footer.
+    std::vector<size_t> rowGroupOffsets;
     /// Whether or not we have already read the header magic
     bool readMagic = false;
     /// The current column chunk
     uint32_t chunkIdx = 0;
     /// The number of bytes read from the current chunk
-    uint32_t chunkLexed = 0;
+    int64_t chunkLexed = 0;
     /// The current page header. Will be reset after reading page
     /// data.
     std::unique_ptr<PageHeader> pageHeader = nullptr;
+    /// The tokens of the encoded page data just read, which are returned
+    /// before lexing further.
+    std::vector<ZL_ParquetToken> pageTokens;
+    /// The number of tokens of pageTokens already returned.
+    size_t pageTokensLexed = 0;
 };
 
 namespace {
@@ -44,13 +57,25 @@ const uint32_t kParquetMagic = 0x31524150;
 const uint32_t kMinParquetSize =
         /* magics */ 2 * sizeof(kParquetMagic)
         + /* metadata length */ sizeof(uint32_t);
+/// A page header has at least the type, uncompressed size and compressed size
+/// fields, which take 2 bytes each, and the stop field.
+const size_t kMinPageHeaderSize = 7;
+
+/// The kind of values in a stream of page data, which are never clustered
+/// together.
+enum class StreamKind : uint32_t {
+    Values            = 0,
+    DictionaryIndices = 1,
+    Deltas            = 2,
+};
 
 size_t getRemaining(const ZL_ParquetLexer* lexer)
 {
-    if (lexer->currPtr > lexer->footerPtr) {
+    const char* const end = std::min(lexer->endPtr, lexer->footerPtr);
+    if (lexer->currPtr > end) {
         return 0;
     }
-    return (size_t)(lexer->footerPtr - lexer->currPtr);
+    return (size_t)(end - lexer->currPtr);
 }
 
 ColumnChunkMetadata& getChunkMeta(ZL_ParquetLexer* lexer)
@@ -117,6 +142,9 @@ ZL_Report lexPageHeader(
     } catch (const std::exception& e) {
         return ZL_REPORT_ERROR(GENERIC, e.what());
     }
+    // Guarantees the bound of ZL_ParquetLexer_maxNumTokens()
+    ZL_ERR_IF_LT(out->size, kMinPageHeaderSize, node_invalid_input);
+    ZL_ERR_IF_LT(lexer->pageHeader->numBytes, 0, node_invalid_input);
 
     // If we are in a data page, include the repetition and definition levels in
     // the header
@@ -145,14 +173,18 @@ ZL_Report lexPageHeader(
         lexer->pageHeader->numBytes -= size + 4;
     }
 
-    lexer->chunkLexed += out->size;
+    lexer->chunkLexed += (int64_t)out->size;
     return ZL_returnSuccess();
 }
 
 /**
  * Compute a tag for a given column chunk by hashing the schema path.
+ * Streams of encoded values also hash their kind, so that they are never
+ * clustered with values.
  */
-uint32_t getTag(const std::vector<std::string>& path)
+uint32_t getTag(
+        const std::vector<std::string>& path,
+        StreamKind kind = StreamKind::Values)
 {
     XXH3_state_t state;
     XXH3_64bits_reset(&state);
@@ -161,6 +193,9 @@ uint32_t getTag(const std::vector<std::string>& path)
         XXH3_64bits_update(&state, str.data(), len);
         XXH3_64bits_update(&state, &len, sizeof(size_t));
     }
+    if (kind != StreamKind::Values) {
+        XXH3_64bits_update(&state, &kind, sizeof(kind));
+    }
     XXH64_hash_t result = XXH3_64bits_digest(&state);
     return (uint32_t)result;
 }
@@ -202,32 +237,350 @@ size_t getDataWidth(DataType type, int32_t width = 0)
     return 1;
 }
 
-ZL_Report lexDataPage(
+/// @returns the width of the elements that @p bitWidth bits unpack to.
+size_t getUnpackedWidth(uint32_t bitWidth)
+{
+    if (bitWidth <= 8) {
+        return 1;
+    } else if (bitWidth <= 16) {
+        return 2;
+    } else if (bitWidth <= 32) {
+        return 4;
+    }
+    return 8;
+}
+
+/// Reads the ULEB128 varint at @p offset of [@p src, @p src + @p size), and
+/// advances @p offset past it.
+/// @returns false if the varint is truncated or overflows.
+bool readVarint(const char* src, size_t size, size_t& offset, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; offset < size && shift < 64; shift += 7) {
+        uint8_t const byte = (uint8_t)src[offset++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Splits the encoded data of a page into tokens. Consecutive headers are
+ * merged into a single token, and finish() sends the bytes left as a header,
+ * so decoding can stop at any point.
+ */
+class EncodedPageSplitter {
+   public:
+    EncodedPageSplitter(
+            std::vector<ZL_ParquetToken>& tokens,
+            const ZL_ParquetToken& page)
+            : tokens_(tokens), page_(page)
+    {
+        tokens_.clear();
+    }
+
+    void finish()
+    {
+        header(remaining());
+        if (tokens_.empty()) {
+            push(0, ZL_ParquetTokenType_EncodingHeader, ZL_Type_serial, 1, 0);
+        }
+    }
+
+    const char* ptr() const
+    {
+        return page_.ptr + pos_;
+    }
+
+    size_t remaining() const
+    {
+        return page_.size - pos_;
+    }
+
+    /// Sends the next @p size bytes as headers.
+    void header(size_t size)
+    {
+        if (size == 0) {
+            return;
+        }
+        if (!tokens_.empty()
+            && tokens_.back().type == ZL_ParquetTokenType_EncodingHeader) {
+            tokens_.back().size += size;
+            pos_ += size;
+            return;
+        }
+        push(size, ZL_ParquetTokenType_EncodingHeader, ZL_Type_serial, 1, 0);
+    }
+
+    /// Sends the next @p size bytes as values.
+    void values(
+            size_t size,
+            ZL_ParquetTokenType type,
+            ZL_Type dataType,
+            size_t dataWidth,
+            uint32_t bitWidth)
+    {
+        if (size > 0) {
+            push(size, type, dataType, dataWidth, bitWidth);
+        }
+    }
+
+   private:
+    void push(
+            size_t size,
+            ZL_ParquetTokenType type,
+            ZL_Type dataType,
+            size_t dataWidth,
+            uint32_t bitWidth)
+    {
+        ZL_ParquetToken token = page_;
+        token.ptr             = ptr();
+        token.size            = size;
+        token.type            = type;
+        token.dataType        = dataType;
+        token.dataWidth       = dataWidth;
+        token.bitWidth        = bitWidth;
+        tokens_.push_back(token);
+        pos_ += size;
+    }
+
+    std::vector<ZL_ParquetToken>& tokens_;
+    const ZL_ParquetToken page_;
+    size_t pos_ = 0;
+};
+
+/**
+ * Splits dictionary indices, encoded with the RLE / bit-packing hybrid
+ * encoding, into the values of RLE runs, and bit-packed runs.
+ */
+void splitDictionaryIndices(EncodedPageSplitter& splitter)
+{
+    if (splitter.remaining() == 0) {
+        return;
+    }
+    uint32_t const bitWidth = (uint8_t)splitter.ptr()[0];
+    // Zero width indices take no space, so there is nothing to split
+    if (bitWidth == 0 || bitWidth > 32) {
+        return;
+    }
+    splitter.header(1);
+
+    size_t const valueWidth = (bitWidth + 7) / 8;
+    ZL_Type const valueType =
+            valueWidth == 3 ? ZL_Type_struct : ZL_Type_numeric;
+    while (splitter.remaining() > 0) {
+        size_t headerSize = 0;
+        uint64_t runHeader;
+        if (!readVarint(
+                    splitter.ptr(),
+                    splitter.remaining(),
+                    headerSize,
+                    runHeader)) {
+            return;
+        }
+        size_t const available = splitter.remaining() - headerSize;
+        if (runHeader & 1) {
+            // Bit-packed run of (runHeader >> 1) groups of 8 values
+            uint64_t const nbGroups = runHeader >> 1;
+            if (nbGroups > available / bitWidth) {
+                return;
+            }
+            splitter.header(headerSize);
+            splitter.values(
+                    (size_t)nbGroups * bitWidth,
+                    ZL_ParquetTokenType_DictionaryIndices,
+                    ZL_Type_numeric,
+                    getUnpackedWidth(bitWidth),
+                    bitWidth);
+        } else {
+            // RLE run of a single value
+            if (valueWidth > available) {
+                return;
+            }
+            splitter.header(headerSize);
+            splitter.values(
+                    valueWidth,
+                    ZL_ParquetTokenType_DictionaryIndices,
+                    valueType,
+                    valueWidth,
+                    0);
+        }
+    }
+}
+
+/**
+ * Splits DELTA_BINARY_PACKED encoded values into their headers and their
+ * bit-packed miniblocks.
+ */
+void splitDeltas(EncodedPageSplitter& splitter, DataType type)
+{
+    size_t pos = 0;
+    uint64_t blockSize, nbMiniblocks, nbValues, firstValue;
+    const char* const src = splitter.ptr();
+    size_t const size     = splitter.remaining();
+    if (!readVarint(src, size, pos, blockSize)
+        || !readVarint(src, size, pos, nbMiniblocks)
+        || !readVarint(src, size, pos, nbValues)
+        || !readVarint(src, size, pos, firstValue)) {
+        return;
+    }
+    if (blockSize == 0 || blockSize % 128 != 0 || nbMiniblocks == 0
+        || blockSize % nbMiniblocks != 0
+        || (blockSize / nbMiniblocks) % 32 != 0) {
+        return;
+    }
+    splitter.header(pos);
+
+    uint64_t const miniblockSize = blockSize / nbMiniblocks;
+    uint32_t const maxBitWidth   = type == DataType::INT32 ? 32 : 64;
+    // The first value is stored in the header, then each block holds up to
+    // blockSize deltas. Miniblocks after the last delta are omitted.
+    uint64_t nbDeltas = nbValues > 0 ? nbValues - 1 : 0;
+    while (nbDeltas > 0) {
+        pos = 0;
+        uint64_t minDelta;
+        if (!readVarint(splitter.ptr(), splitter.remaining(), pos, minDelta)
+            || nbMiniblocks > splitter.remaining() - pos) {
+            return;
+        }
+        const uint8_t* const bitWidths =
+                (const uint8_t*)splitter.ptr() + pos;
+        size_t const nbUsed = (size_t)std::min<uint64_t>(
+                nbMiniblocks, (nbDeltas + miniblockSize - 1) / miniblockSize);
+        size_t blockBytes = pos + (size_t)nbMiniblocks;
+        for (size_t i = 0; i < nbUsed; ++i) {
+            if (bitWidths[i] == 0) {
+                continue;
+            }
+            if (bitWidths[i] > maxBitWidth
+                || miniblockSize / 8 > splitter.remaining()) {
+                return;
+            }
+            blockBytes += (size_t)(miniblockSize / 8) * bitWidths[i];
+            if (blockBytes > splitter.remaining()) {
+                return;
+            }
+        }
+        splitter.header(pos + (size_t)nbMiniblocks);
+        for (size_t i = 0; i < nbUsed; ++i) {
+            splitter.values(
+                    (size_t)(miniblockSize / 8) * bitWidths[i],
+                    ZL_ParquetTokenType_DeltaMiniblock,
+                    ZL_Type_numeric,
+                    getUnpackedWidth(bitWidths[i]),
+                    bitWidths[i]);
+        }
+        nbDeltas -= std::min(nbDeltas, blockSize);
+    }
+}
+
+/// Splits the encoded data @p page into the tokens of @p lexer with @p split.
+template <typename SplitFn>
+ZL_Report splitPageData(
+        ZL_ParquetLexer* lexer,
+        const ZL_ParquetToken& page,
+        SplitFn&& split,
+        ZL_ErrorContext* errCtx)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(errCtx);
+    try {
+        EncodedPageSplitter splitter(lexer->pageTokens, page);
+        split(splitter);
+        splitter.finish();
+    } catch (const std::bad_alloc&) {
+        ZL_ERR(allocation);
+    }
+    return ZL_returnSuccess();
+}
+
+/// Lexes the data of a data page or of a dictionary page.
+ZL_Report lexPageData(
         ZL_ParquetLexer* lexer,
         ZL_ParquetToken* out,
         ZL_ErrorContext* errCtx)
 {
     ZL_RESULT_DECLARE_SCOPE_REPORT(errCtx);
-    ZL_ERR_IF_NE(
-            (int)lexer->pageHeader->encoding,
-            (int)Encoding::PLAIN,
-            node_invalid_input);
-    out->type = ZL_ParquetTokenType_DataPage;
-    out->size = lexer->pageHeader->numBytes;
-    out->ptr  = lexer->currPtr;
+    const PageHeader& header = *lexer->pageHeader;
+    out->size                = (size_t)header.numBytes;
+    out->ptr                 = lexer->currPtr;
 
     auto& chunkMeta = getChunkMeta(lexer);
     auto schemaMeta = getSchemaMeta(lexer, chunkMeta.path_in_schema);
 
     ZL_ERR_IF_NULL(schemaMeta, GENERIC, "Unknown schema path");
     ZL_ERR_IF_NE((uint32_t)schemaMeta->type, (uint32_t)chunkMeta.type, GENERIC);
+    ZL_ERR_IF_GT(
+            (int64_t)out->size,
+            chunkMeta.numBytes - lexer->chunkLexed,
+            node_invalid_input,
+            "Page overflows its column chunk");
 
+    // PLAIN encoded values, including dictionary values, keep the type of
+    // their column. Encoded values are decoded into numeric streams, tagged by
+    // kind.
     out->tag       = getTag(chunkMeta.path_in_schema);
     out->dataType  = getDataType(chunkMeta.type);
     out->dataWidth = getDataWidth(chunkMeta.type, schemaMeta->typeWidth);
+    out->bitWidth  = 0;
+
+    if (header.pageType == PageType::DICTIONARY_PAGE) {
+        // PLAIN_DICTIONARY is the deprecated name of PLAIN in dictionary pages
+        ZL_ERR_IF(
+                header.encoding != Encoding::PLAIN
+                        && header.encoding != Encoding::PLAIN_DICTIONARY,
+                node_invalid_input,
+                "Unsupported dictionary page encoding");
+        out->type = ZL_ParquetTokenType_DictionaryPage;
+    } else {
+        switch (header.encoding) {
+            case Encoding::PLAIN:
+                out->type = ZL_ParquetTokenType_DataPage;
+                break;
+            case Encoding::PLAIN_DICTIONARY:
+            case Encoding::RLE_DICTIONARY: {
+                out->tag = getTag(
+                        chunkMeta.path_in_schema,
+                        StreamKind::DictionaryIndices);
+                ZL_ERR_IF_ERR(splitPageData(
+                        lexer, *out, splitDictionaryIndices, errCtx));
+                break;
+            }
+            case Encoding::DELTA_BINARY_PACKED: {
+                ZL_ERR_IF(
+                        chunkMeta.type != DataType::INT32
+                                && chunkMeta.type != DataType::INT64,
+                        node_invalid_input,
+                        "DELTA_BINARY_PACKED requires an integer column");
+                out->tag = getTag(chunkMeta.path_in_schema, StreamKind::Deltas);
+                auto const type = chunkMeta.type;
+                ZL_ERR_IF_ERR(splitPageData(
+                        lexer,
+                        *out,
+                        [type](EncodedPageSplitter& splitter) {
+                            splitDeltas(splitter, type);
+                        },
+                        errCtx));
+                break;
+            }
+            case Encoding::RLE:
+            case Encoding::BIT_PACKED:
+            case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+            case Encoding::DELTA_BYTE_ARRAY:
+            case Encoding::BYTE_STREAM_SPLIT:
+            default:
+                ZL_ERR(node_invalid_input, "Unsupported data page encoding");
+        }
+    }
 
     lexer->currPtr += out->size;
-    lexer->chunkLexed += out->size;
+    lexer->chunkLexed += (int64_t)out->size;
+    if (!lexer->pageTokens.empty()) {
+        // Encoded page data is returned as the tokens it was split into
+        *out                   = lexer->pageTokens[0];
+        lexer->pageTokensLexed = 1;
+    }
     return ZL_returnSuccess();
 }
 
@@ -235,6 +588,13 @@ ZL_Report
 lexOne(ZL_ParquetLexer* lexer, ZL_ParquetToken* out, ZL_ErrorContext* errCtx)
 {
     ZL_RESULT_DECLARE_SCOPE_REPORT(errCtx);
+    if (lexer->pageTokensLexed < lexer->pageTokens.size()) {
+        *out = lexer->pageTokens[lexer->pageTokensLexed++];
+        return ZL_returnSuccess();
+    }
+    lexer->pageTokens.clear();
+    lexer->pageTokensLexed = 0;
+
     if (!lexer->readMagic) {
         return lexMagic(lexer, out, errCtx);
     }
@@ -263,8 +623,9 @@ lexOne(ZL_ParquetLexer* lexer, ZL_ParquetToken* out, ZL_ErrorContext* errCtx)
         return lexPageHeader(lexer, out, errCtx);
     }
 
-    if (lexer->pageHeader->pageType == PageType::DATA_PAGE) {
-        auto ret = lexDataPage(lexer, out, errCtx);
+    if (lexer->pageHeader->pageType == PageType::DATA_PAGE
+        || lexer->pageHeader->pageType == PageType::DICTIONARY_PAGE) {
+        auto ret = lexPageData(lexer, out, errCtx);
         lexer->pageHeader.reset();
         return ret;
     }
@@ -275,19 +636,17 @@ lexOne(ZL_ParquetLexer* lexer, ZL_ParquetToken* out, ZL_ErrorContext* errCtx)
 
 ZL_ParquetLexer* ZL_ParquetLexer_create(void)
 {
-    ZL_ParquetLexer* const lexer =
-            (ZL_ParquetLexer*)ZL_calloc(sizeof(ZL_ParquetLexer));
-    if (lexer == NULL)
+    void* const mem = ZL_malloc(sizeof(ZL_ParquetLexer));
+    if (mem == NULL)
         return NULL;
-    return lexer;
+    return new (mem) ZL_ParquetLexer();
 }
 
 void ZL_ParquetLexer_free(ZL_ParquetLexer* lexer)
 {
     if (lexer == NULL)
         return;
-    lexer->fileMetadata.reset();
-    lexer->pageHeader.reset();
+    lexer->~ZL_ParquetLexer();
     ZL_free(lexer);
 }
 
@@ -302,8 +661,16 @@ ZL_Report ZL_ParquetLexer_init(
     lexer->srcBegin = (const char*)src;
     lexer->srcEnd   = lexer->srcBegin + srcSize;
 
-    lexer->currPtr   = lexer->srcBegin;
-    lexer->footerPtr = lexer->srcEnd;
+    lexer->currPtr    = lexer->srcBegin;
+    lexer->endPtr     = lexer->srcEnd;
+    lexer->footerPtr  = lexer->srcEnd;
+    lexer->readMagic  = false;
+    lexer->chunkIdx   = 0;
+    lexer->chunkLexed = 0;
+    lexer->pageHeader.reset();
+    lexer->pageTokens.clear();
+    lexer->pageTokensLexed = 0;
+    lexer->rowGroupOffsets.clear();
 
     // Check magic
     ZL_ERR_IF_NE(
@@ -336,12 +703,82 @@ ZL_Report ZL_ParquetLexer_init(
         ZL_ERR(GENERIC, "Error while reading file metadata: %s", e.what());
     }
 
+    // Column chunks must be stored in order and back to back, which also
+    // locates every row group.
+    auto const& meta    = *lexer->fileMetadata;
+    size_t const footer = (size_t)(lexer->footerPtr - lexer->srcBegin);
+    size_t offset       = sizeof(kParquetMagic);
+    ZL_ERR_IF_NE(
+            meta.columnChunks.size(),
+            (size_t)meta.numColumns * meta.numRowGroups,
+            node_invalid_input);
+    for (uint32_t rg = 0; rg < meta.numRowGroups; ++rg) {
+        lexer->rowGroupOffsets.push_back(offset);
+        for (uint32_t i = 0; i < meta.numColumns; ++i) {
+            auto const& chunk = meta.columnChunks[rg * meta.numColumns + i];
+            ZL_ERR_IF(
+                    chunk.offset >= 0 && (size_t)chunk.offset != offset,
+                    node_invalid_input,
+                    "Column chunks are not contiguous");
+            ZL_ERR_IF_LT(chunk.numBytes, 0, node_invalid_input);
+            ZL_ERR_IF_GT(
+                    (uint64_t)chunk.numBytes,
+                    footer - offset,
+                    node_invalid_input);
+            offset += (size_t)chunk.numBytes;
+        }
+    }
+    ZL_ERR_IF_NE(offset, footer, node_invalid_input, "Data after row groups");
+    lexer->rowGroupOffsets.push_back(offset);
+
     return ZL_returnSuccess();
 }
 
 bool ZL_ParquetLexer_finished(const ZL_ParquetLexer* lexer)
 {
-    return lexer->currPtr == lexer->srcEnd;
+    return lexer->currPtr == lexer->endPtr
+            && lexer->pageTokensLexed == lexer->pageTokens.size();
+}
+
+size_t ZL_ParquetLexer_numRowGroups(const ZL_ParquetLexer* lexer)
+{
+    if (lexer->rowGroupOffsets.empty()) {
+        return 0;
+    }
+    return lexer->rowGroupOffsets.size() - 1;
+}
+
+size_t ZL_ParquetLexer_rowGroupOffset(
+        const ZL_ParquetLexer* lexer,
+        size_t rowGroup)
+{
+    return lexer->rowGroupOffsets.at(rowGroup);
+}
+
+ZL_Report ZL_ParquetLexer_initRowGroup(
+        ZL_ParquetLexer* lexer,
+        size_t rowGroup,
+        ZL_ErrorContext* errCtx)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(errCtx);
+    size_t const numRowGroups = ZL_ParquetLexer_numRowGroups(lexer);
+    ZL_ERR_IF_GE(rowGroup, numRowGroups, parameter_invalid);
+    bool const first = rowGroup == 0;
+    bool const last  = rowGroup + 1 == numRowGroups;
+
+    // The first row group owns the magic, and the last one the footer
+    lexer->currPtr = first ? lexer->srcBegin
+                           : lexer->srcBegin + lexer->rowGroupOffsets[rowGroup];
+    lexer->endPtr  = last
+             ? lexer->srcEnd
+             : lexer->srcBegin + lexer->rowGroupOffsets[rowGroup + 1];
+    lexer->readMagic  = !first;
+    lexer->chunkIdx   = (uint32_t)rowGroup * lexer->fileMetadata->numColumns;
+    lexer->chunkLexed = 0;
+    lexer->pageHeader.reset();
+    lexer->pageTokens.clear();
+    lexer->pageTokensLexed = 0;
+    return ZL_returnSuccess();
 }
 
 ZL_Report ZL_ParquetLexer_lex(
@@ -364,8 +801,11 @@ ZL_Report ZL_ParquetLexer_maxNumTokens(
         ZL_ErrorContext* errCtx)
 {
     ZL_RESULT_DECLARE_SCOPE_REPORT(errCtx);
-    // TODO: Improve this estimate
-    ZL_ERR_IF_LT(lexer->srcEnd, lexer->srcBegin, GENERIC);
-    size_t srcSize = (size_t)(lexer->srcEnd - lexer->srcBegin);
-    return ZL_returnValue(srcSize);
+    ZL_ERR_IF_LT(lexer->endPtr, lexer->currPtr, GENERIC);
+    // Each page is made of a page header of at least kMinPageHeaderSize bytes
+    // followed by page data, plus the magic and footer tokens. Encoded page
+    // data is split into non-empty tokens, so it has at most one token per
+    // byte.
+    size_t const size = (size_t)(lexer->endPtr - lexer->currPtr);
+    return ZL_returnValue(2 + size + lexer->pageTokens.size());
 }
@@ -35,10 +35,37 @@ ZL_Report ZL_ParquetLexer_init(
         ZL_ErrorContext* opctx);
 
 /**
- * Returns true if the lexer has reached the end of the input buffer.
+ * Returns true if the lexer has reached the end of the input buffer, or the end
+ * of the row group selected by ZL_ParquetLexer_initRowGroup().
  */
 bool ZL_ParquetLexer_finished(const ZL_ParquetLexer* lexer);
 
+/**
+ * @returns The number of row groups of the file, or 0 if the lexer has not been
+ * successfully initialized.
+ */
+size_t ZL_ParquetLexer_numRowGroups(const ZL_ParquetLexer* lexer);
+
+/**
+ * @returns The offset of the row group @p rowGroup in the input buffer, or the
+ * offset of the footer if @p rowGroup is the number of row groups.
+ */
+size_t ZL_ParquetLexer_rowGroupOffset(
+        const ZL_ParquetLexer* lexer,
+        size_t rowGroup);
+
+/**
+ * Restricts the lexer to the row group @p rowGroup of the initialized file.
+ * Row groups don't depend on each other, so they can be lexed in any order.
+ * The tokens of the first row group start with the Magic token, and the tokens
+ * of the last row group end with the Footer token, so lexing all the row groups
+ * in order produces the same tokens as lexing the whole file.
+ */
+ZL_Report ZL_ParquetLexer_initRowGroup(
+        ZL_ParquetLexer* lexer,
+        size_t rowGroup,
+        ZL_ErrorContext* opctx);
+
 /**
  * The type of token in a parquet file.
  */
@@ -46,7 +73,19 @@ typedef enum {
     ZL_ParquetTokenType_Magic,
     ZL_ParquetTokenType_Footer,
     ZL_ParquetTokenType_PageHeader,
+    /// Values of a PLAIN encoded data page
     ZL_ParquetTokenType_DataPage,
+    /// Values of a dictionary page, which are PLAIN encoded
+    ZL_ParquetTokenType_DictionaryPage,
+    /// Headers of the encoded values of a data page: the bit width and run
+    /// headers of dictionary indices, or the header and block headers of
+    /// deltas. Also holds encoded values which can't be decoded.
+    ZL_ParquetTokenType_EncodingHeader,
+    /// Dictionary indices of a RLE_DICTIONARY or PLAIN_DICTIONARY encoded data
+    /// page: the value of a RLE run, or a bit-packed run
+    ZL_ParquetTokenType_DictionaryIndices,
+    /// Bit-packed miniblock of a DELTA_BINARY_PACKED encoded data page
+    ZL_ParquetTokenType_DeltaMiniblock,
 } ZL_ParquetTokenType;
 
 typedef struct {
@@ -57,14 +96,22 @@ typedef struct {
     /// Type of the token.
     ZL_ParquetTokenType type;
 
-    /// The following fields are only valid for DataPage tokens.
+    /// The following fields are only valid for page data tokens, i.e. all
+    /// tokens except Magic, Footer and PageHeader.
 
-    /// The tag associated with the data page. All column chunks with the same
-    /// schema path should have the same tag.
+    /// The tag associated with the page data. All column chunks with the same
+    /// schema path should have the same tag. Dictionary values share the tag of
+    /// the PLAIN values of their column, while dictionary indices and deltas
+    /// get a tag of their own, shared with their encoding headers.
     uint32_t tag;
-    /// The type and width of the elements in the data page.
+    /// The type and width of the elements in the page data. Encoding headers
+    /// are serial.
     ZL_Type dataType;
     size_t dataWidth;
+    /// Non-zero for bit-packed tokens, whose elements take @p bitWidth bits
+    /// each, LSB first, and unpack to elements of @p dataType and
+    /// @p dataWidth. Bit-packed tokens hold a multiple of 8 elements.
+    uint32_t bitWidth;
 } ZL_ParquetToken;
 
 /**
@@ -84,8 +131,8 @@ ZL_Report ZL_ParquetLexer_lex(
         ZL_ErrorContext* opctx);
 
 /**
- * @returns The maximum number of tokens that can be lexed from the input if it
- * is a valid Parquet file.
+ * @returns The maximum number of tokens that can be lexed from the input, or
+ * from the selected row group, if it is a valid Parquet file.
  * @note Will return an error if the lexer has not been successfully
  * initialized.
  */
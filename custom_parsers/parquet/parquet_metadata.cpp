@@ -56,7 +56,7 @@ PageType getPageType(int32_t val)
             return PageType::INDEX_PAGE;
         case 2:
             return PageType::DICTIONARY_PAGE;
-        case 4:
+        case 3:
             return PageType::DATA_PAGE_V2;
         default:
             throw std::runtime_error("Invalid Parquet Page Type!");
@@ -144,6 +144,27 @@ uint32_t readColumnChunkMetadata(
                 read += reader.readI64(metadata.numBytes);
                 break;
             }
+            case 9: /* Data Page Offset */
+            {
+                throwIfTTypeNE(type, TType::T_I64);
+                int64_t offset{};
+                read += reader.readI64(offset);
+                // The dictionary page, if any, comes first
+                if (metadata.offset < 0 || offset < metadata.offset) {
+                    metadata.offset = offset;
+                }
+                break;
+            }
+            case 11: /* Dictionary Page Offset */
+            {
+                throwIfTTypeNE(type, TType::T_I64);
+                int64_t offset{};
+                read += reader.readI64(offset);
+                if (metadata.offset < 0 || offset < metadata.offset) {
+                    metadata.offset = offset;
+                }
+                break;
+            }
             default:
                 read += reader.skip(type);
                 break;
@@ -271,6 +292,37 @@ uint32_t readDataPageHeader(ThriftCompactReader& reader, PageHeader& header)
     return read;
 }
 
+uint32_t readDictionaryPageHeader(
+        ThriftCompactReader& reader,
+        PageHeader& header)
+{
+    uint32_t read = 0;
+    read += reader.readStructBegin();
+    while (true) {
+        TType type{};
+        int16_t fieldId{};
+        read += reader.readFieldBegin(type, fieldId);
+
+        if (type == TType::T_STOP)
+            break;
+
+        switch (fieldId) {
+            case 2: /* Encoding */ {
+                throwIfTTypeNE(type, TType::T_I32);
+                int32_t encoding{};
+                read += reader.readI32(encoding);
+                header.encoding = getEncoding(encoding);
+                break;
+            }
+            default:
+                read += reader.skip(type);
+                break;
+        }
+    }
+    read += reader.readStructEnd();
+    return read;
+}
+
 struct SchemaElement {
     std::string name;
     bool isLeaf = false;
@@ -462,6 +514,11 @@ uint32_t readPageHeader(ThriftCompactReader& reader, PageHeader& header)
                 read += readDataPageHeader(reader, header);
                 break;
             }
+            case 7: { /* Dictionary Page Header */
+                throwIfTTypeNE(type, TType::T_STRUCT);
+                read += readDictionaryPageHeader(reader, header);
+                break;
+            }
             default:
                 read += reader.skip(type);
                 break;
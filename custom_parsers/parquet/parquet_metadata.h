@@ -27,6 +27,8 @@ struct ColumnChunkMetadata {
     DataType type;
     /// The uncompressed size of the chunk
     int64_t numBytes;
+    /// The offset of the first page of the chunk in the file, or -1 if unknown
+    int64_t offset = -1;
     /// The schema path
     SchemaPath path_in_schema;
 };
@@ -78,7 +80,7 @@ struct PageHeader {
     PageType pageType;
     /// The page size
     int32_t numBytes;
-    /// The page encoding
+    /// The page encoding, of either the data page or the dictionary page
     Encoding encoding;
     Encoding dl_encoding;
     Encoding rl_encoding;
@@ -0,0 +1,169 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <arrow/api.h> // @manual
+#include <parquet/exception.h>
+#include <stdint.h>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "custom_parsers/parquet/parquet_graph.h"
+#include "custom_parsers/parquet/parquet_lexer.h"
+#include "custom_parsers/parquet/tests/test_utils.h"
+#include "custom_parsers/shared_components/clustering.h"
+#include "openzl/common/errors_internal.h"
+#include "openzl/cpp/ThreadPool.hpp"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_compressor.h"
+#include "openzl/zl_decompress.h"
+
+namespace zstrong {
+namespace parquet {
+namespace testing {
+
+namespace {
+std::shared_ptr<arrow::Table> generate_large_table(size_t numRows)
+{
+    std::vector<std::optional<int64_t>> ints(numRows);
+    std::vector<std::optional<double>> doubles(numRows);
+    std::vector<std::optional<std::string>> strs(numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+        ints[i]    = (int64_t)((i * 2654435761u) % 1000003);
+        doubles[i] = (double)i * 0.25;
+        strs[i]    = "value-" + std::to_string(i % 97);
+    }
+
+    std::shared_ptr<arrow::Schema> schema =
+            arrow::schema({ arrow::field("int", arrow::int64()),
+                            arrow::field("double", arrow::float64()),
+                            arrow::field("str", arrow::utf8()) });
+
+    return arrow::Table::Make(
+            schema,
+            { to_arrow_array<int64_t>(ints),
+              to_arrow_array<double>(doubles),
+              to_arrow_array<std::string>(strs) });
+}
+
+/// Runs tasks on a ThreadPool, and records the largest batch of tasks it was
+/// given, i.e. how much work could run in parallel.
+class BatchRecordingPool {
+   public:
+    explicit BatchRecordingPool(size_t nbThreads) : pool_(nbThreads) {}
+
+    ZL_WorkerPool get()
+    {
+        ZL_WorkerPool workerPool;
+        workerPool.opaque   = this;
+        workerPool.runTasks = [](void* opaque,
+                                 ZL_WorkerTaskFn task,
+                                 void* taskCtx,
+                                 size_t nbTasks) {
+            auto* const self    = static_cast<BatchRecordingPool*>(opaque);
+            self->maxBatchSize_ = std::max(self->maxBatchSize_, nbTasks);
+            self->pool_.runTasks(task, taskCtx, nbTasks);
+        };
+        return workerPool;
+    }
+
+    size_t maxBatchSize() const
+    {
+        return maxBatchSize_;
+    }
+
+   private:
+    openzl::ThreadPool pool_;
+    size_t maxBatchSize_ = 0;
+};
+
+size_t numRowGroups(const std::string& input)
+{
+    auto lexer = ZL_ParquetLexer_create();
+    ZL_REQUIRE_SUCCESS(
+            ZL_ParquetLexer_init(lexer, input.data(), input.size(), nullptr));
+    size_t const numRowGroups = ZL_ParquetLexer_numRowGroups(lexer);
+    ZL_ParquetLexer_free(lexer);
+    return numRowGroups;
+}
+
+std::string compress(
+        const std::string& input,
+        int nbWorkers,
+        BatchRecordingPool* pool)
+{
+    auto compressor = ZL_Compressor_create();
+    ZL_REQUIRE_SUCCESS(ZL_Compressor_setParameter(
+            compressor, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION));
+    auto const clustering = ZS2_createGraph_genericClustering(compressor);
+    auto const graph = ZL_Parquet_registerRowGroupGraph(compressor, clustering);
+    ZL_REQUIRE(ZL_GraphID_isValid(graph));
+    ZL_REQUIRE_SUCCESS(ZL_Compressor_selectStartingGraphID(compressor, graph));
+
+    auto cctx = ZL_CCtx_create();
+    ZL_REQUIRE_SUCCESS(ZL_CCtx_refCompressor(cctx, compressor));
+    ZL_REQUIRE_SUCCESS(
+            ZL_CCtx_setParameter(cctx, ZL_CParam_nbWorkers, nbWorkers));
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        ZL_REQUIRE_SUCCESS(ZL_CCtx_setWorkerPool(cctx, &workerPool));
+    }
+
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    auto const report = ZL_CCtx_compress(
+            cctx,
+            compressed.data(),
+            compressed.size(),
+            input.data(),
+            input.size());
+    ZL_REQUIRE_SUCCESS(report);
+    compressed.resize(ZL_validResult(report));
+
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return compressed;
+}
+
+void testRowGroupsRoundTrip(const std::string& input)
+{
+    // Row groups are grouped into chunks of at least 8 MiB: make sure the
+    // input is cut into several chunks
+    ASSERT_GT(input.size(), (size_t)16 << 20);
+    ASSERT_GT(numRowGroups(input), 2);
+
+    auto const serial = compress(input, 1, nullptr);
+    BatchRecordingPool pool(3);
+    auto const parallel = compress(input, 4, &pool);
+    EXPECT_EQ(parallel, serial);
+    // Chunks were handed to the workers together, so compression scales with
+    // the number of workers
+    EXPECT_GT(pool.maxBatchSize(), 1);
+
+    std::string decompressed(input.size(), '\0');
+    auto const report = ZL_decompress(
+            decompressed.data(),
+            decompressed.size(),
+            parallel.data(),
+            parallel.size());
+    ZL_REQUIRE_SUCCESS(report);
+    ASSERT_EQ(ZL_validResult(report), input.size());
+    EXPECT_EQ(decompressed, input);
+}
+} // namespace
+
+TEST(ParquetGraphTest, TestRowGroupsRoundTripWithWorkers)
+{
+    auto const input =
+            to_canonical_parquet(generate_large_table(800000), 50000);
+    testRowGroupsRoundTrip(input);
+}
+
+TEST(ParquetGraphTest, TestEncodedRowGroupsRoundTripWithWorkers)
+{
+    auto const input = to_encoded_parquet(
+            generate_large_table(2000000), { "int" }, 100000);
+    testRowGroupsRoundTrip(input);
+}
+
+} // namespace testing
+} // namespace parquet
+} // namespace zstrong
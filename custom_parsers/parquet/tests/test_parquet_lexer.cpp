@@ -122,6 +122,19 @@ void validateTokens(
     }
     EXPECT_EQ(sum, input.size());
 }
+
+std::vector<ZL_ParquetToken> lexAll(ZL_ParquetLexer* lexer)
+{
+    auto const bound = ZL_ParquetLexer_maxNumTokens(lexer, nullptr);
+    EXPECT_FALSE(ZL_isError(bound));
+    std::vector<ZL_ParquetToken> tokens(ZL_validResult(bound));
+    auto const res =
+            ZL_ParquetLexer_lex(lexer, tokens.data(), tokens.size(), nullptr);
+    EXPECT_FALSE(ZL_isError(res));
+    EXPECT_TRUE(ZL_ParquetLexer_finished(lexer));
+    tokens.resize(ZL_validResult(res));
+    return tokens;
+}
 } // namespace
 
 TEST(ParquetLexerTest, TestInitValidParquet)
@@ -225,6 +238,144 @@ TEST(ParquetLexerTest, TestLexNestedParquet)
 
     ZL_ParquetLexer_free(lexer);
 }
+
+TEST(ParquetLexerTest, TestLexEncodedParquet)
+{
+    auto lexer = ZL_ParquetLexer_create();
+    EXPECT_NE(lexer, nullptr);
+
+    // Deltas of "int" vary, so their miniblocks aren't empty
+    auto i64array = to_arrow_array<int64_t>({ 100, 250, 300, 475, 500 });
+    auto strarray = to_arrow_array<std::string>(
+            { "hello", "world", "hello", "hello", "is" });
+    std::shared_ptr<arrow::Schema> schema =
+            arrow::schema({ arrow::field("int", arrow::int64()),
+                            arrow::field("str", arrow::utf8()) });
+    auto input = to_encoded_parquet(
+            arrow::Table::Make(schema, { i64array, strarray }), { "int" }, 3);
+
+    ZL_REQUIRE_SUCCESS(
+            ZL_ParquetLexer_init(lexer, input.data(), input.size(), nullptr));
+    auto const tokens = lexAll(lexer);
+
+    // Per row group: the delta page of "int", then the dictionary and the
+    // indices of "str", each preceded by its page header. Encoded pages are
+    // split into their headers and their values.
+    EXPECT_EQ(tokens.front().type, ZL_ParquetTokenType_Magic);
+    EXPECT_EQ(tokens.back().type, ZL_ParquetTokenType_Footer);
+    std::vector<uint32_t> headerTags;
+    std::vector<uint32_t> deltaTags;
+    std::vector<uint32_t> indicesTags;
+    size_t numPageHeaders = 0;
+    size_t numDictPages   = 0;
+    for (auto const& token : tokens) {
+        switch (token.type) {
+            case ZL_ParquetTokenType_PageHeader:
+                ++numPageHeaders;
+                break;
+            case ZL_ParquetTokenType_DictionaryPage:
+                // Dictionary values are plain encoded and share the column tag
+                ++numDictPages;
+                EXPECT_EQ(token.dataType, ZL_Type_serial);
+                EXPECT_EQ(token.tag, getTag({ "str" }));
+                break;
+            case ZL_ParquetTokenType_EncodingHeader:
+                EXPECT_EQ(token.dataType, ZL_Type_serial);
+                EXPECT_EQ(token.bitWidth, 0);
+                headerTags.push_back(token.tag);
+                break;
+            case ZL_ParquetTokenType_DeltaMiniblock:
+                // Bit-packed tokens hold a multiple of 8 values
+                EXPECT_EQ(token.dataType, ZL_Type_numeric);
+                EXPECT_GT(token.bitWidth, 0);
+                EXPECT_EQ(token.size % token.bitWidth, 0);
+                deltaTags.push_back(token.tag);
+                break;
+            case ZL_ParquetTokenType_DictionaryIndices:
+                EXPECT_EQ(token.dataType, ZL_Type_numeric);
+                EXPECT_EQ(token.dataWidth, 1);
+                if (token.bitWidth != 0) {
+                    EXPECT_EQ(token.size % token.bitWidth, 0);
+                }
+                indicesTags.push_back(token.tag);
+                break;
+            default:
+                break;
+        }
+    }
+    EXPECT_EQ(numPageHeaders, 2 * 3);
+    EXPECT_EQ(numDictPages, 2);
+    ASSERT_FALSE(deltaTags.empty());
+    ASSERT_FALSE(indicesTags.empty());
+
+    // Deltas and indices get tags of their own, shared with their headers
+    uint32_t const deltaTag   = deltaTags.front();
+    uint32_t const indicesTag = indicesTags.front();
+    EXPECT_NE(deltaTag, getTag({ "int" }));
+    EXPECT_NE(indicesTag, getTag({ "str" }));
+    EXPECT_NE(indicesTag, deltaTag);
+    for (auto tag : deltaTags) {
+        EXPECT_EQ(tag, deltaTag);
+    }
+    for (auto tag : indicesTags) {
+        EXPECT_EQ(tag, indicesTag);
+    }
+    for (auto tag : headerTags) {
+        EXPECT_TRUE(tag == deltaTag || tag == indicesTag);
+    }
+
+    size_t sum = 0;
+    for (auto const& token : tokens) {
+        sum += token.size;
+    }
+    EXPECT_EQ(sum, input.size());
+
+    ZL_ParquetLexer_free(lexer);
+}
+
+TEST(ParquetLexerTest, TestLexRowGroups)
+{
+    auto lexer = ZL_ParquetLexer_create();
+    EXPECT_NE(lexer, nullptr);
+
+    auto input = to_encoded_parquet(generate_nested_table(), { "int" }, 2);
+
+    ZL_REQUIRE_SUCCESS(
+            ZL_ParquetLexer_init(lexer, input.data(), input.size(), nullptr));
+    auto const numRowGroups = ZL_ParquetLexer_numRowGroups(lexer);
+    EXPECT_EQ(numRowGroups, 3);
+    EXPECT_EQ(ZL_ParquetLexer_rowGroupOffset(lexer, 0), 0);
+    EXPECT_EQ(
+            ZL_ParquetLexer_rowGroupOffset(lexer, numRowGroups),
+            input.size());
+    auto const expected = lexAll(lexer);
+
+    // Row groups can be lexed independently, in any order
+    std::vector<std::vector<ZL_ParquetToken>> rowGroups(numRowGroups);
+    for (size_t rg = numRowGroups; rg-- > 0;) {
+        ZL_REQUIRE_SUCCESS(ZL_ParquetLexer_initRowGroup(lexer, rg, nullptr));
+        rowGroups[rg] = lexAll(lexer);
+        ASSERT_FALSE(rowGroups[rg].empty());
+        EXPECT_EQ(
+                rowGroups[rg].front().ptr,
+                input.data() + ZL_ParquetLexer_rowGroupOffset(lexer, rg));
+    }
+    EXPECT_TRUE(ZL_isError(
+            ZL_ParquetLexer_initRowGroup(lexer, numRowGroups, nullptr)));
+
+    std::vector<ZL_ParquetToken> tokens;
+    for (auto const& rowGroup : rowGroups) {
+        tokens.insert(tokens.end(), rowGroup.begin(), rowGroup.end());
+    }
+    ASSERT_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        EXPECT_EQ(tokens[i].type, expected[i].type);
+        EXPECT_EQ(tokens[i].ptr, expected[i].ptr);
+        EXPECT_EQ(tokens[i].size, expected[i].size);
+    }
+
+    ZL_ParquetLexer_free(lexer);
+}
 } // namespace testing
 } // namespace parquet
 } // namespace zstrong
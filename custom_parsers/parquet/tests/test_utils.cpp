@@ -28,6 +28,32 @@ std::string to_canonical_parquet(
     return buffer->ToString();
 }
 
+std::string to_encoded_parquet(
+        const std::shared_ptr<arrow::Table> table,
+        const std::vector<std::string>& delta_columns,
+        std::optional<size_t> opt_group_size)
+{
+    size_t group_size =
+            opt_group_size.value_or(::parquet::DEFAULT_MAX_ROW_GROUP_LENGTH);
+    PARQUET_ASSIGN_OR_THROW(auto out, arrow::io::BufferOutputStream::Create());
+    ::parquet::WriterProperties::Builder builder;
+    builder.compression(::parquet::Compression::UNCOMPRESSED)
+            ->enable_dictionary()
+            ->disable_write_page_index();
+    for (const auto& column : delta_columns) {
+        builder.disable_dictionary(column)->encoding(
+                column, ::parquet::Encoding::DELTA_BINARY_PACKED);
+    }
+    PARQUET_THROW_NOT_OK(::parquet::arrow::WriteTable(
+            *table,
+            arrow::default_memory_pool(),
+            out,
+            group_size,
+            builder.build()));
+    PARQUET_ASSIGN_OR_THROW(auto buffer, out->Finish());
+    return buffer->ToString();
+}
+
 std::shared_ptr<arrow::Array> to_arrow_array(
         const std::vector<std::optional<std::string>>& array,
         size_t N)
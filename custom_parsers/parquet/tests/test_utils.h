@@ -17,6 +17,14 @@ using namespace facebook::security::lionhead::fdp;
 std::string to_canonical_parquet(
         const std::shared_ptr<arrow::Table> table,
         std::optional<size_t> opt_group_size = std::nullopt);
+/**
+ * Writes @p table uncompressed with dictionary encoding enabled, except for the
+ * columns in @p delta_columns which are DELTA_BINARY_PACKED encoded.
+ */
+std::string to_encoded_parquet(
+        const std::shared_ptr<arrow::Table> table,
+        const std::vector<std::string>& delta_columns,
+        std::optional<size_t> opt_group_size = std::nullopt);
 std::shared_ptr<arrow::Array> to_arrow_array(
         const std::vector<std::optional<std::string>>& array,
         size_t N);
@@ -1,12 +1,15 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include <stdio.h>
+#include <algorithm>
 #include <chrono>
+#include <thread>
 
 #include <folly/FileUtil.h>
 #include <folly/init/Init.h>
 
 #include "custom_parsers/pytorch_model_parser.h"
+#include "openzl/cpp/ThreadPool.hpp"
 #include "tools/zstrong_cpp.h"
 
 namespace {
@@ -26,6 +29,12 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // Tensors are (de)compressed in parallel, using every core.
+    // The pool must outlive the contexts.
+    const size_t nbWorkers = std::max(1u, std::thread::hardware_concurrency());
+    openzl::ThreadPool pool(nbWorkers - 1);
+    const ZL_WorkerPool workerPool = pool.get();
+
     zstrong::CCtx cctx;
     zstrong::CGraph cgraph;
 
@@ -37,6 +46,12 @@ int main(int argc, char** argv)
     try {
         cgraph.unwrap(ZL_Compressor_setParameter(
                 cgraph.get(), ZL_CParam_formatVersion, 14));
+        cgraph.unwrap(ZL_Compressor_setParameter(
+                cgraph.get(), ZL_CParam_nbWorkers, (int)nbWorkers));
+        cctx.unwrap(ZL_CCtx_setWorkerPool(cctx.get(), &workerPool));
+        dctx.unwrap(ZL_DCtx_setParameter(
+                dctx.get(), ZL_DParam_nbWorkers, (int)nbWorkers));
+        dctx.unwrap(ZL_DCtx_setWorkerPool(dctx.get(), &workerPool));
         cgraph.unwrap(
                 ZL_Compressor_selectStartingGraphID(cgraph.get(), graphID));
         cctx.unwrap(ZL_CCtx_refCompressor(cctx.get(), cgraph.get()));
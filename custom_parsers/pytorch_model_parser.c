@@ -4,16 +4,15 @@
 
 #include <string.h>
 
+#include "custom_parsers/pytorch_pickle.h"
+#include "custom_parsers/safetensors_lexer.h"
 #include "custom_parsers/zip_lexer.h"
 #include "openzl/common/assertion.h"
 #include "openzl/shared/estimate.h"
+#include "openzl/shared/utils.h"
 #include "openzl/zl_errors.h"
 #include "openzl/zl_graph_api.h"
 
-#include <stdio.h>
-#include <time.h>
-static double ZS2_ZipLexer_finished_time_ms = 0.0;
-
 typedef enum {
     PytorchModelSuccessor_U8            = 0,
     PytorchModelSuccessor_F16           = 1,
@@ -22,10 +21,16 @@ typedef enum {
     PytorchModelSuccessor_OtherFiles    = 4,
     PytorchModelSuccessor_Precompressed = 5,
     PytorchModelSuccessor_Metadata      = 6,
-    PytorchModelSuccessor_NumSuccessors = 7,
+    PytorchModelSuccessor_BF16          = 7,
+    PytorchModelSuccessor_I16           = 8,
+    PytorchModelSuccessor_I32           = 9,
+    PytorchModelSuccessor_I64           = 10,
+    PytorchModelSuccessor_NumSuccessors = 11,
 } PytorchModelSuccessor;
 
-static PytorchModelSuccessor selectSuccessor(const char* ptr, size_t size)
+/// Selects the successor of a tensor whose dtype is unknown, based on its
+/// content.
+static PytorchModelSuccessor guessSuccessor(const char* ptr, size_t size)
 {
     const size_t width = ZL_guessFloatWidth(ptr, size);
     switch (width) {
@@ -35,7 +40,8 @@ static PytorchModelSuccessor selectSuccessor(const char* ptr, size_t size)
         case 1:
             return PytorchModelSuccessor_U8;
         case 2:
-            return PytorchModelSuccessor_F16;
+            // bfloat16 is the most common 16-bit format of model weights
+            return PytorchModelSuccessor_BF16;
         case 4:
             return PytorchModelSuccessor_F32;
         case 8:
@@ -43,6 +49,57 @@ static PytorchModelSuccessor selectSuccessor(const char* ptr, size_t size)
     }
 }
 
+static PytorchModelSuccessor
+selectSuccessor(ZS2_TensorDType dtype, const char* ptr, size_t size)
+{
+    const size_t width = ZS2_TensorDType_eltWidth(dtype);
+    if (width == 0 || size % width != 0) {
+        return guessSuccessor(ptr, size);
+    }
+    switch (dtype) {
+        case ZS2_TensorDType_Bool:
+        case ZS2_TensorDType_U8:
+        case ZS2_TensorDType_I8:
+            return PytorchModelSuccessor_U8;
+        case ZS2_TensorDType_I16:
+            return PytorchModelSuccessor_I16;
+        case ZS2_TensorDType_I32:
+            return PytorchModelSuccessor_I32;
+        case ZS2_TensorDType_I64:
+            return PytorchModelSuccessor_I64;
+        case ZS2_TensorDType_F16:
+            return PytorchModelSuccessor_F16;
+        case ZS2_TensorDType_BF16:
+            return PytorchModelSuccessor_BF16;
+        case ZS2_TensorDType_F32:
+            return PytorchModelSuccessor_F32;
+        case ZS2_TensorDType_F64:
+            return PytorchModelSuccessor_F64;
+        case ZS2_TensorDType_Unknown:
+        default:
+            ZL_ASSERT_FAIL("unreachable");
+            return guessSuccessor(ptr, size);
+    }
+}
+
+static size_t successorEltWidth(unsigned successor)
+{
+    switch (successor) {
+        case PytorchModelSuccessor_F16:
+        case PytorchModelSuccessor_BF16:
+        case PytorchModelSuccessor_I16:
+            return 2;
+        case PytorchModelSuccessor_F32:
+        case PytorchModelSuccessor_I32:
+            return 4;
+        case PytorchModelSuccessor_F64:
+        case PytorchModelSuccessor_I64:
+            return 8;
+        default:
+            return 1;
+    }
+}
+
 static bool
 startsWithPrefix(const char* filename, size_t filenameSize, const char* prefix)
 {
@@ -72,132 +129,332 @@ static bool isDataFile(const char* filename, size_t filenameSize)
             || hasDir(filename, filenameSize, "xl_model_weights/");
 }
 
+/// @returns The offset of the name of the file, without its directory
+static size_t baseNameOffset(const char* filename, size_t filenameSize)
+{
+    size_t offset = filenameSize;
+    while (offset > 0 && filename[offset - 1] != '/') {
+        --offset;
+    }
+    return offset;
+}
+
+/// @returns true if the file is the pickled object of a torch.save() archive
+static bool isPickleFile(const char* filename, size_t filenameSize)
+{
+    const size_t offset = baseNameOffset(filename, filenameSize);
+    return filenameSize - offset == strlen("data.pkl")
+            && memcmp(filename + offset, "data.pkl", strlen("data.pkl")) == 0;
+}
+
+/// Segments of the input, each of which is sent to the successor of its tag.
+typedef struct {
+    size_t* sizes;
+    unsigned* tags;
+    size_t nbSegments;
+    size_t capacity;
+    size_t maxSegmentSize;
+} PytorchModelSegments;
+
+/**
+ * Appends a token, which is never merged with the previous segment unless the
+ * whole token fits in it. So segments are cut at tensor boundaries, and can be
+ * compressed independently. Tokens larger than the maximum segment size are
+ * split into segments of a whole number of elements, to optimize
+ * (de)compression speed by improving memory locality.
+ */
 static ZL_Report
-pytorchModelDynGraph(ZL_Graph* gctx, ZL_Edge* sctxs[], size_t nbIns)
+PytorchModelSegments_add(PytorchModelSegments* segs, size_t size, unsigned tag)
 {
-#ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
-    // Allow interesting fuzzing with smaller inputs
-    const size_t kMultiplier = 4;
-#else
-    const size_t kMultiplier = 1024;
-#endif
-    const size_t kMaxSegmentSize = 1024 * kMultiplier;
+    if (size == 0) {
+        return ZL_returnSuccess();
+    }
+    const size_t n = segs->nbSegments;
+    if (n > 0 && segs->tags[n - 1] == tag
+        && segs->sizes[n - 1] + size <= segs->maxSegmentSize) {
+        segs->sizes[n - 1] += size;
+        return ZL_returnSuccess();
+    }
+    const size_t eltWidth = successorEltWidth(tag);
+    const size_t chunkSize =
+            segs->maxSegmentSize - segs->maxSegmentSize % eltWidth;
+    while (size > 0) {
+        ZL_RET_R_IF_GE(corruption, segs->nbSegments, segs->capacity);
+        const size_t segmentSize = ZL_MIN(size, chunkSize);
+        segs->sizes[segs->nbSegments] = segmentSize;
+        segs->tags[segs->nbSegments]  = tag;
+        ++segs->nbSegments;
+        size -= segmentSize;
+    }
+    return ZL_returnSuccess();
+}
 
-    ZL_RET_R_IF(graph_invalidNumInputs, nbIns != 1);
-    ZL_Edge* sctx               = sctxs[0];
-    ZL_Input const* const input = ZL_Edge_getData(sctx);
-    const size_t inputSize      = ZL_Input_numElts(input);
+static ZL_Report PytorchModelSegments_init(
+        PytorchModelSegments* segs,
+        ZL_Graph* gctx,
+        size_t maxNbSegments,
+        size_t maxSegmentSize)
+{
+    segs->sizes =
+            ZL_Graph_getScratchSpace(gctx, maxNbSegments * sizeof(size_t));
+    segs->tags =
+            ZL_Graph_getScratchSpace(gctx, maxNbSegments * sizeof(unsigned));
+    ZL_RET_R_IF_NULL(allocation, segs->sizes);
+    ZL_RET_R_IF_NULL(allocation, segs->tags);
+    segs->nbSegments     = 0;
+    segs->capacity       = maxNbSegments;
+    segs->maxSegmentSize = maxSegmentSize;
+    return ZL_returnSuccess();
+}
 
+/**
+ * Finds the stored `data.pkl` of a torch.save() archive, and parses the dtype
+ * of its storages. Archives without a pickle, or with one the parser doesn't
+ * understand, have no storages, so the dtype of their tensors is guessed.
+ *
+ * @returns The number of storages
+ */
+static size_t parsePytorchStorages(
+        ZL_Graph* gctx,
+        const void* src,
+        size_t srcSize,
+        ZS2_PytorchStorage** storages)
+{
+    *storages = NULL;
     ZS2_ZipLexer lexer;
-    ZL_RET_R_IF_ERR(ZS2_ZipLexer_init(&lexer, ZL_Input_ptr(input), inputSize));
+    if (ZL_isError(ZS2_ZipLexer_init(&lexer, src, srcSize))) {
+        return 0;
+    }
+    while (!ZS2_ZipLexer_finished(&lexer)) {
+        ZS2_ZipToken tokens[32];
+        const ZL_Report nbTokens = ZS2_ZipLexer_lex(&lexer, tokens, 32);
+        if (ZL_isError(nbTokens)) {
+            return 0;
+        }
+        for (size_t i = 0; i < ZL_validResult(nbTokens); ++i) {
+            const ZS2_ZipToken token = tokens[i];
+            if (token.type != ZS2_ZipTokenType_CompressedData
+                || token.compressionMethod != 0
+                || !isPickleFile(token.filename, token.filenameSize)) {
+                continue;
+            }
+            const size_t capacity =
+                    ZS2_PytorchPickle_maxNumStorages(token.size);
+            const size_t workspaceSize =
+                    ZS2_PytorchPickle_workspaceSize(token.size);
+            ZS2_PytorchStorage* const out = ZL_Graph_getScratchSpace(
+                    gctx, capacity * sizeof(ZS2_PytorchStorage));
+            void* const workspace =
+                    ZL_Graph_getScratchSpace(gctx, workspaceSize);
+            if (out == NULL || workspace == NULL) {
+                return 0;
+            }
+            const ZL_Report nbStorages = ZS2_PytorchPickle_parseStorages(
+                    out,
+                    capacity,
+                    token.ptr,
+                    token.size,
+                    workspace,
+                    workspaceSize);
+            if (ZL_isError(nbStorages)) {
+                return 0;
+            }
+            *storages = out;
+            return ZL_validResult(nbStorages);
+        }
+    }
+    return 0;
+}
+
+static ZL_Report zipSegments(
+        ZL_Graph* gctx,
+        PytorchModelSegments* segs,
+        const void* src,
+        size_t srcSize,
+        size_t maxSegmentSize)
+{
+    ZS2_PytorchStorage* storages = NULL;
+    const size_t nbStorages =
+            parsePytorchStorages(gctx, src, srcSize, &storages);
+
+    ZS2_ZipLexer lexer;
+    ZL_RET_R_IF_ERR(ZS2_ZipLexer_init(&lexer, src, srcSize));
 
     const size_t nbFiles = ZS2_ZipLexer_numFiles(&lexer);
-    const size_t maxNbSegments =
-            nbFiles * 4 + 2 + (inputSize / kMaxSegmentSize);
+    ZL_RET_R_IF_ERR(PytorchModelSegments_init(
+            segs,
+            gctx,
+            nbFiles * 4 + 2 + (srcSize / maxSegmentSize),
+            maxSegmentSize));
 
-    size_t* const segmentSizes =
-            ZL_Graph_getScratchSpace(gctx, maxNbSegments * sizeof(size_t));
-    unsigned* const tags =
-            ZL_Graph_getScratchSpace(gctx, maxNbSegments * sizeof(unsigned));
-    ZL_RET_R_IF_NULL(allocation, segmentSizes);
-    ZL_RET_R_IF_NULL(allocation, tags);
-
-    // Iterate over all the tokens in the Zip file, and fill out segmentSizes
-    // and tags.
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    size_t nbSegments = 0;
+    // Iterate over all the tokens in the Zip file, and tag each of them.
     while (!ZS2_ZipLexer_finished(&lexer)) {
         ZS2_ZipToken tokens[32];
         ZL_TRY_LET_R(nbTokens, ZS2_ZipLexer_lex(&lexer, tokens, 32));
         for (size_t i = 0; i < nbTokens; ++i) {
-            ZL_RET_R_IF_GE(corruption, nbSegments, maxNbSegments);
             const ZS2_ZipToken token = tokens[i];
-
-            // Assign the appropiate tag to the token.
+            unsigned tag;
             if (token.type == ZS2_ZipTokenType_CompressedData) {
                 if (token.compressionMethod != 0) {
-                    tags[nbSegments] = PytorchModelSuccessor_Precompressed;
+                    tag = PytorchModelSuccessor_Precompressed;
                 } else if (isDataFile(token.filename, token.filenameSize)) {
-                    tags[nbSegments] = selectSuccessor(token.ptr, token.size);
+                    // Storages are stored in `<archive>/data/<key>`
+                    const size_t offset =
+                            baseNameOffset(token.filename, token.filenameSize);
+                    const ZS2_TensorDType dtype = ZS2_PytorchPickle_findStorage(
+                            storages,
+                            nbStorages,
+                            token.filename + offset,
+                            token.filenameSize - offset);
+                    tag = selectSuccessor(dtype, token.ptr, token.size);
                 } else {
-                    tags[nbSegments] = PytorchModelSuccessor_OtherFiles;
+                    tag = PytorchModelSuccessor_OtherFiles;
                 }
             } else {
-                tags[nbSegments] = PytorchModelSuccessor_Metadata;
+                tag = PytorchModelSuccessor_Metadata;
             }
+            ZL_RET_R_IF_ERR(PytorchModelSegments_add(segs, token.size, tag));
+        }
+    }
+    return ZL_returnSuccess();
+}
 
-            // Combine consecutive occurrences of the same tag.
-            if (nbSegments > 0 && tags[nbSegments] == tags[nbSegments - 1]
-                && segmentSizes[nbSegments - 1] < kMaxSegmentSize) {
-                segmentSizes[nbSegments - 1] += token.size;
-            } else {
-                segmentSizes[nbSegments] = token.size;
-                ++nbSegments;
-            }
+static ZL_Report safetensorsSegments(
+        ZL_Graph* gctx,
+        PytorchModelSegments* segs,
+        const char* src,
+        size_t srcSize,
+        size_t maxSegmentSize)
+{
+    ZL_TRY_LET_R(headerSize, ZS2_SafetensorsLexer_headerSize(src, srcSize));
+    const size_t capacity = ZS2_SafetensorsLexer_maxNumTensors(headerSize);
+    ZS2_SafetensorsTensor* const tensors = ZL_Graph_getScratchSpace(
+            gctx, capacity * sizeof(ZS2_SafetensorsTensor));
+    ZL_RET_R_IF_NULL(allocation, tensors);
+    ZL_TRY_LET_R(
+            nbTensors,
+            ZS2_SafetensorsLexer_lex(tensors, capacity, src, srcSize));
 
-            // Split large files into smaller segments to optimize
-            // (de)compression speed by improving memory locality.
-            while (segmentSizes[nbSegments - 1] > kMaxSegmentSize) {
-                ZL_RET_R_IF_GE(corruption, nbSegments, maxNbSegments);
-                const size_t segmentSize     = segmentSizes[nbSegments - 1];
-                segmentSizes[nbSegments - 1] = kMaxSegmentSize;
-                segmentSizes[nbSegments]     = segmentSize - kMaxSegmentSize;
-                tags[nbSegments]             = tags[nbSegments - 1];
-                ++nbSegments;
-            }
-        }
+    ZL_RET_R_IF_ERR(PytorchModelSegments_init(
+            segs,
+            gctx,
+            nbTensors * 2 + 2 + (srcSize / maxSegmentSize),
+            maxSegmentSize));
+
+    ZL_RET_R_IF_ERR(PytorchModelSegments_add(
+            segs, headerSize, PytorchModelSuccessor_Metadata));
+    size_t pos = headerSize;
+    for (size_t i = 0; i < nbTensors; ++i) {
+        const ZS2_SafetensorsTensor tensor = tensors[i];
+        ZL_ASSERT_LE(pos, tensor.begin);
+        ZL_RET_R_IF_ERR(PytorchModelSegments_add(
+                segs, tensor.begin - pos, PytorchModelSuccessor_OtherFiles));
+        const size_t size = tensor.end - tensor.begin;
+        ZL_RET_R_IF_ERR(PytorchModelSegments_add(
+                segs,
+                size,
+                selectSuccessor(tensor.dtype, src + tensor.begin, size)));
+        pos = tensor.end;
     }
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
+    return PytorchModelSegments_add(
+            segs, srcSize - pos, PytorchModelSuccessor_OtherFiles);
+}
 
-    double current_duration = end_time_ms - start_time_ms;
-    ZS2_ZipLexer_finished_time_ms += current_duration;
-    fprintf(stderr, "[ZS2_ZipLexer_finished] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms\n", start_time_ms, end_time_ms, ZS2_ZipLexer_finished_time_ms);
-    fprintf(stderr, "nbSegments: %zu\n", nbSegments);
+static ZL_Report
+pytorchModelDynGraph(ZL_Graph* gctx, ZL_Edge* sctxs[], size_t nbIns)
+{
+#ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+    // Allow interesting fuzzing with smaller inputs
+    const size_t kMultiplier = 4;
+#else
+    const size_t kMultiplier = 1024;
+#endif
+    const size_t kMaxSegmentSize = 1024 * kMultiplier;
+
+    ZL_RET_R_IF(graph_invalidNumInputs, nbIns != 1);
+    ZL_Edge* sctx               = sctxs[0];
+    ZL_Input const* const input = ZL_Edge_getData(sctx);
+    const char* const src       = (const char*)ZL_Input_ptr(input);
+    const size_t inputSize      = ZL_Input_numElts(input);
+
+    PytorchModelSegments segs;
+    if (ZS2_isLikelySafetensorsFile(src, inputSize)) {
+        ZL_RET_R_IF_ERR(safetensorsSegments(
+                gctx, &segs, src, inputSize, kMaxSegmentSize));
+    } else {
+        ZL_RET_R_IF_ERR(
+                zipSegments(gctx, &segs, src, inputSize, kMaxSegmentSize));
+    }
 
-    // Split the input according to segmentSizes
+    // Split the input according to the segments. Each segment holds whole
+    // tensors, or a slice of a single tensor, so their successors are
+    // independent, and run in parallel when ZL_CParam_nbWorkers > 1.
     ZL_TRY_LET_T(
             ZL_EdgeList,
             streams,
-            ZL_Edge_runSplitNode(sctx, segmentSizes, nbSegments));
+            ZL_Edge_runSplitNode(sctx, segs.sizes, segs.nbSegments));
     const ZL_GraphIDList graphs = ZL_Graph_getCustomGraphs(gctx);
-    ZL_ASSERT_EQ(streams.nbStreams, nbSegments);
+    ZL_ASSERT_EQ(streams.nbStreams, segs.nbSegments);
 
     // Set the destination for every segment
     for (size_t i = 0; i < streams.nbStreams; ++i) {
         ZL_RET_R_IF_ERR(ZL_Edge_setDestination(
-                streams.streams[i], graphs.graphids[tags[i]]));
+                streams.streams[i], graphs.graphids[segs.tags[i]]));
     }
     return ZL_returnSuccess();
 }
 
-ZL_GraphID ZS2_createGraph_pytorchModelCompressor(ZL_Compressor* cgraph)
+/// @returns A graph compressing floats with @p deconstructNode, which splits
+/// the exponent from the sign & fraction bits
+static ZL_GraphID registerFloatGraph(
+        ZL_Compressor* cgraph,
+        ZL_NodeID interpretNode,
+        ZL_NodeID deconstructNode,
+        ZL_GraphID signFracGraph)
 {
-    ZL_GraphID f16Graph = ZL_Compressor_registerStaticGraph_fromNode(
+    const ZL_GraphID graph = ZL_Compressor_registerStaticGraph_fromNode(
             cgraph,
-            ZL_NODE_BFLOAT16_DECONSTRUCT,
-            ZL_GRAPHLIST(ZL_GRAPH_STORE, ZL_GRAPH_HUFFMAN));
+            deconstructNode,
+            ZL_GRAPHLIST(signFracGraph, ZL_GRAPH_HUFFMAN));
+    return ZL_Compressor_registerStaticGraph_fromNode1o(
+            cgraph, interpretNode, graph);
+}
 
-    f16Graph = ZL_Compressor_registerStaticGraph_fromNode1o(
-            cgraph, ZL_NODE_INTERPRET_AS_LE16, f16Graph);
+ZL_GraphID ZS2_createGraph_pytorchModelCompressor(ZL_Compressor* cgraph)
+{
+    // float16 only uses 11 bits of its 16-bit sign & fraction field
+    const ZL_GraphID bitpack = ZL_Compressor_registerStaticGraph_fromNode1o(
+            cgraph, ZL_NODE_INTERPRET_TOKEN_AS_LE, ZL_GRAPH_BITPACK);
 
-    ZL_GraphID f32Graph = ZL_Compressor_registerStaticGraph_fromNode(
+    ZL_GraphID graphs[PytorchModelSuccessor_NumSuccessors];
+    graphs[PytorchModelSuccessor_U8]  = ZL_GRAPH_HUFFMAN;
+    graphs[PytorchModelSuccessor_F16] = registerFloatGraph(
             cgraph,
+            ZL_NODE_INTERPRET_AS_LE16,
+            ZL_NODE_FLOAT16_DECONSTRUCT,
+            bitpack);
+    graphs[PytorchModelSuccessor_BF16] = registerFloatGraph(
+            cgraph,
+            ZL_NODE_INTERPRET_AS_LE16,
+            ZL_NODE_BFLOAT16_DECONSTRUCT,
+            ZL_GRAPH_STORE);
+    graphs[PytorchModelSuccessor_F32] = registerFloatGraph(
+            cgraph,
+            ZL_NODE_INTERPRET_AS_LE32,
             ZL_NODE_FLOAT32_DECONSTRUCT,
-            ZL_GRAPHLIST(ZL_GRAPH_STORE, ZL_GRAPH_HUFFMAN));
-    f32Graph = ZL_Compressor_registerStaticGraph_fromNode1o(
-            cgraph, ZL_NODE_INTERPRET_AS_LE32, f32Graph);
-
-    const ZL_GraphID f64Graph = ZL_Compressor_registerStaticGraph_fromNode1o(
-            cgraph, ZL_NODE_INTERPRET_AS_LE64, ZL_GRAPH_FIELD_LZ);
-
-    ZL_GraphID graphs[PytorchModelSuccessor_NumSuccessors];
-    graphs[PytorchModelSuccessor_U8]            = ZL_GRAPH_HUFFMAN;
-    graphs[PytorchModelSuccessor_F16]           = f16Graph;
-    graphs[PytorchModelSuccessor_F32]           = f32Graph;
-    graphs[PytorchModelSuccessor_F64]           = f64Graph;
+            ZL_GRAPH_STORE);
+    graphs[PytorchModelSuccessor_F64] =
+            ZL_Compressor_registerStaticGraph_fromNode1o(
+                    cgraph, ZL_NODE_INTERPRET_AS_LE64, ZL_GRAPH_FIELD_LZ);
+    graphs[PytorchModelSuccessor_I16] =
+            ZL_Compressor_registerStaticGraph_fromNode1o(
+                    cgraph, ZL_NODE_INTERPRET_AS_LE16, ZL_GRAPH_FIELD_LZ);
+    graphs[PytorchModelSuccessor_I32] =
+            ZL_Compressor_registerStaticGraph_fromNode1o(
+                    cgraph, ZL_NODE_INTERPRET_AS_LE32, ZL_GRAPH_FIELD_LZ);
+    graphs[PytorchModelSuccessor_I64] =
+            ZL_Compressor_registerStaticGraph_fromNode1o(
+                    cgraph, ZL_NODE_INTERPRET_AS_LE64, ZL_GRAPH_FIELD_LZ);
     graphs[PytorchModelSuccessor_OtherFiles]    = ZL_GRAPH_ZSTD;
     graphs[PytorchModelSuccessor_Precompressed] = ZL_GRAPH_STORE;
     graphs[PytorchModelSuccessor_Metadata]      = ZL_GRAPH_ZSTD;
@@ -9,17 +9,27 @@
 ZL_BEGIN_C_DECLS
 
 /**
- * This graph compresses Zip files containing PyTorch models.
- * It lexes the Zip file using the ZS2_ZipLexer, and searches for files with
- * a `data/` or `xl_model_weights/` in their path that aren't already
- * compressed. The floating point format for each of these files is detected,
- * and the file is compressed using the appropriate float compressor.
+ * This graph compresses PyTorch models, saved either as Zip files or as
+ * safetensors files.
+ *
+ * Zip files are lexed using the ZS2_ZipLexer, which finds the files with a
+ * `data/` or `xl_model_weights/` in their path that aren't already compressed.
+ * The dtype of each of these tensors is read from the pickled object of the
+ * archive (`data.pkl`, see ZS2_PytorchPickle_parseStorages()). Safetensors
+ * files declare the dtype & offsets of their tensors in their header.
+ * Each tensor is compressed by the graph of its dtype, e.g. bfloat16 tensors
+ * are deconstructed by ZL_NODE_BFLOAT16_DECONSTRUCT. When the dtype is
+ * unknown, the floating point format is detected from the content instead.
  * All other files are either stored if they are already compressed, or
  * compressed with Zstandard.
  *
+ * The input is segmented at tensor boundaries, with tensors larger than 1 MiB
+ * split into slices. Segments are compressed independently, and in parallel
+ * when ZL_CParam_nbWorkers > 1.
+ *
  * @warning This graph will fail to compress if the input is not a valid Zip
- * file. Or if the entries in the Zip file central directory is not in order of
- * occurrence (unlikely).
+ * or safetensors file. Or if the entries in the Zip file central directory is
+ * not in order of occurrence (unlikely).
  */
 ZL_GraphID ZS2_createGraph_pytorchModelCompressor(ZL_Compressor* cgraph);
 
@@ -0,0 +1,688 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "custom_parsers/pytorch_pickle.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "openzl/common/assertion.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+
+// Pickle opcodes, see Lib/pickletools.py in CPython.
+// Only the ones with a special meaning to the parser are named.
+#define PKL_MARK '('
+#define PKL_STOP '.'
+#define PKL_POP '0'
+#define PKL_POP_MARK '1'
+#define PKL_DUP '2'
+#define PKL_GLOBAL 'c'
+#define PKL_STACK_GLOBAL '\x93'
+#define PKL_PERSID 'P'
+#define PKL_BINPERSID 'Q'
+#define PKL_TUPLE 't'
+#define PKL_TUPLE1 '\x85'
+#define PKL_TUPLE2 '\x86'
+#define PKL_TUPLE3 '\x87'
+#define PKL_BINUNICODE 'X'
+#define PKL_SHORT_BINUNICODE '\x8c'
+#define PKL_BINUNICODE8 '\x8d'
+#define PKL_PUT 'p'
+#define PKL_BINPUT 'q'
+#define PKL_LONG_BINPUT 'r'
+#define PKL_MEMOIZE '\x94'
+#define PKL_GET 'g'
+#define PKL_BINGET 'h'
+#define PKL_LONG_BINGET 'j'
+
+// The parser keeps the top of the stack only. Persistent ids are small
+// tuples, so only the depth of larger values needs to be tracked.
+#define kStackWindow 256
+#define kMaxMarks 64
+
+typedef enum {
+    PickleValue_Other = 0,
+    PickleValue_String,
+    PickleValue_StorageType,
+    PickleValue_Storage,
+} PickleValueKind;
+
+typedef struct {
+    /// The string, or the storage key
+    const char* ptr;
+    uint32_t size;
+    uint8_t kind;  //< PickleValueKind
+    uint8_t dtype; //< ZS2_TensorDType
+} PickleValue;
+
+ZL_RESULT_DECLARE_TYPE(PickleValue);
+
+typedef struct {
+    size_t index;
+    PickleValue value;
+} PickleMemoEntry;
+
+typedef struct {
+    PickleValue stack[kStackWindow];
+    size_t depth;
+    size_t marks[kMaxMarks];
+    size_t nbMarks;
+
+    // Memoized values, sorted by index. Only strings and storage types are
+    // memoized, other values read back from the memo are Other.
+    PickleMemoEntry* memo;
+    size_t memoSize;
+    size_t memoCapacity;
+    size_t nextMemoIndex;
+
+    ZS2_PytorchStorage* storages;
+    size_t nbStorages;
+    size_t storagesCapacity;
+} PickleMachine;
+
+static const PickleValue kOtherValue = { NULL, 0, PickleValue_Other, 0 };
+
+static ZL_Report PickleMachine_push(PickleMachine* m, PickleValue value)
+{
+    m->stack[m->depth % kStackWindow] = value;
+    ++m->depth;
+    return ZL_returnSuccess();
+}
+
+static size_t PickleMachine_floor(const PickleMachine* m)
+{
+    return m->nbMarks == 0 ? 0 : m->marks[m->nbMarks - 1];
+}
+
+/// Pops @p count values, and returns the first one popped if it is still in
+/// the window, or Other.
+static ZL_RESULT_OF(PickleValue)
+        PickleMachine_pop(PickleMachine* m, size_t count)
+{
+    ZL_RET_T_IF_LT(
+            PickleValue,
+            corruption,
+            m->depth - PickleMachine_floor(m),
+            count,
+            "Pickle stack underflow");
+    m->depth -= count;
+    if (count == 0) {
+        return ZL_RESULT_WRAP_VALUE(PickleValue, kOtherValue);
+    }
+    return ZL_RESULT_WRAP_VALUE(
+            PickleValue, m->stack[(m->depth + count - 1) % kStackWindow]);
+}
+
+/// @returns The value @p offset values below the top of the stack, or Other
+/// if it went out of the window
+static PickleValue PickleMachine_peek(const PickleMachine* m, size_t offset)
+{
+    if (offset >= m->depth || offset >= kStackWindow) {
+        return kOtherValue;
+    }
+    return m->stack[(m->depth - 1 - offset) % kStackWindow];
+}
+
+static ZL_Report PickleMachine_mark(PickleMachine* m)
+{
+    ZL_RET_R_IF_GE(
+            temporaryLibraryLimitation,
+            m->nbMarks,
+            kMaxMarks,
+            "Pickle nested too deeply");
+    m->marks[m->nbMarks++] = m->depth;
+    return ZL_returnSuccess();
+}
+
+/// Pops the values up to the last mark, and the mark itself.
+/// @returns The number of values popped.
+static ZL_Report PickleMachine_popMark(PickleMachine* m)
+{
+    ZL_RET_R_IF_EQ(corruption, m->nbMarks, 0, "Pickle mark not found");
+    const size_t count = m->depth - m->marks[--m->nbMarks];
+    m->depth -= count;
+    return ZL_returnValue(count);
+}
+
+static bool PickleValue_isString(PickleValue value, const char* str)
+{
+    return value.kind == PickleValue_String && value.size == strlen(str)
+            && memcmp(value.ptr, str, value.size) == 0;
+}
+
+/// Builds a tuple out of the @p count values above the stack's depth, which
+/// have already been popped. Recognizes the persistent ids of storages:
+/// ('storage', storage_type, key, location, numel)
+static PickleValue PickleMachine_makeTuple(const PickleMachine* m, size_t count)
+{
+    if (count < 3 || count > kStackWindow) {
+        return kOtherValue;
+    }
+    const PickleValue tag  = m->stack[m->depth % kStackWindow];
+    const PickleValue type = m->stack[(m->depth + 1) % kStackWindow];
+    const PickleValue key  = m->stack[(m->depth + 2) % kStackWindow];
+    if (!PickleValue_isString(tag, "storage")
+        || type.kind != PickleValue_StorageType
+        || key.kind != PickleValue_String) {
+        return kOtherValue;
+    }
+    const PickleValue storage = {
+        key.ptr, key.size, PickleValue_Storage, type.dtype
+    };
+    return storage;
+}
+
+static ZS2_TensorDType storageTypeToDType(
+        const char* module,
+        size_t moduleSize,
+        const char* name,
+        size_t nameSize)
+{
+    static const struct {
+        const char* name;
+        ZS2_TensorDType dtype;
+    } kStorageTypes[] = {
+        { "FloatStorage", ZS2_TensorDType_F32 },
+        { "DoubleStorage", ZS2_TensorDType_F64 },
+        { "HalfStorage", ZS2_TensorDType_F16 },
+        { "BFloat16Storage", ZS2_TensorDType_BF16 },
+        { "LongStorage", ZS2_TensorDType_I64 },
+        { "IntStorage", ZS2_TensorDType_I32 },
+        { "ShortStorage", ZS2_TensorDType_I16 },
+        { "CharStorage", ZS2_TensorDType_I8 },
+        { "ByteStorage", ZS2_TensorDType_U8 },
+        { "BoolStorage", ZS2_TensorDType_Bool },
+    };
+    if (moduleSize != 5 || memcmp(module, "torch", 5) != 0) {
+        return ZS2_TensorDType_Unknown;
+    }
+    for (size_t i = 0; i < ZL_ARRAY_SIZE(kStorageTypes); ++i) {
+        if (nameSize == strlen(kStorageTypes[i].name)
+            && memcmp(name, kStorageTypes[i].name, nameSize) == 0) {
+            return kStorageTypes[i].dtype;
+        }
+    }
+    return ZS2_TensorDType_Unknown;
+}
+
+static PickleValue makeStorageType(
+        const char* module,
+        size_t moduleSize,
+        const char* name,
+        size_t nameSize)
+{
+    const ZS2_TensorDType dtype =
+            storageTypeToDType(module, moduleSize, name, nameSize);
+    if (dtype == ZS2_TensorDType_Unknown) {
+        return kOtherValue;
+    }
+    const PickleValue value = {
+        NULL, 0, PickleValue_StorageType, (uint8_t)dtype
+    };
+    return value;
+}
+
+static PickleValue makeString(const char* ptr, size_t size)
+{
+    if (size > UINT32_MAX) {
+        return kOtherValue;
+    }
+    const PickleValue value = { ptr, (uint32_t)size, PickleValue_String, 0 };
+    return value;
+}
+
+static void PickleMachine_put(PickleMachine* m, size_t index)
+{
+    if (index >= m->nextMemoIndex) {
+        m->nextMemoIndex = index + 1;
+    }
+    const PickleValue value = PickleMachine_peek(m, 0);
+    // Pickler memo indices are increasing, others are dropped
+    const bool inOrder =
+            m->memoSize == 0 || m->memo[m->memoSize - 1].index < index;
+    if (value.kind == PickleValue_Other || !inOrder
+        || m->memoSize == m->memoCapacity) {
+        return;
+    }
+    m->memo[m->memoSize].index = index;
+    m->memo[m->memoSize].value = value;
+    ++m->memoSize;
+}
+
+static PickleValue PickleMachine_get(const PickleMachine* m, size_t index)
+{
+    size_t lo = 0;
+    size_t hi = m->memoSize;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (m->memo[mid].index < index) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < m->memoSize && m->memo[lo].index == index) {
+        return m->memo[lo].value;
+    }
+    return kOtherValue;
+}
+
+static void PickleMachine_persistentLoad(PickleMachine* m, PickleValue pid)
+{
+    if (pid.kind != PickleValue_Storage
+        || m->nbStorages == m->storagesCapacity) {
+        return;
+    }
+    ZS2_PytorchStorage* const storage = &m->storages[m->nbStorages++];
+    storage->key                      = pid.ptr;
+    storage->keySize                  = pid.size;
+    storage->dtype                    = (ZS2_TensorDType)pid.dtype;
+}
+
+/// Skips the newline terminated argument at @p *ip
+static ZL_RESULT_OF(size_t) readLine(const char** ip, const char* iend)
+{
+    const char* const nl = (const char*)memchr(*ip, '\n', (size_t)(iend - *ip));
+    ZL_RET_T_IF_NULL(size_t, corruption, nl, "Unterminated pickle line");
+    const size_t size = (size_t)(nl - *ip);
+    *ip               = nl + 1;
+    return ZL_RESULT_WRAP_VALUE(size_t, size);
+}
+
+/// Reads the newline terminated decimal memo index at @p *ip
+static ZL_RESULT_OF(size_t) readMemoIndex(const char** ip, const char* iend)
+{
+    const char* const arg = *ip;
+    ZL_TRY_LET_T(size_t, size, readLine(ip, iend));
+    ZL_RET_T_IF_EQ(size_t, corruption, size, 0, "Empty memo index");
+    size_t index = 0;
+    for (size_t i = 0; i < size; ++i) {
+        ZL_RET_T_IF(
+                size_t,
+                corruption,
+                arg[i] < '0' || arg[i] > '9',
+                "Memo index must be a decimal number");
+        const size_t digit = (size_t)(arg[i] - '0');
+        ZL_RET_T_IF_GT(
+                size_t,
+                corruption,
+                index,
+                (SIZE_MAX - digit) / 10,
+                "Memo index overflow");
+        index = index * 10 + digit;
+    }
+    return ZL_RESULT_WRAP_VALUE(size_t, index);
+}
+
+/// Reads the little-endian length of an opcode argument of @p width bytes
+static ZL_RESULT_OF(size_t)
+        readLength(const char** ip, const char* iend, size_t width)
+{
+    ZL_RET_T_IF_LT(size_t, corruption, (size_t)(iend - *ip), width);
+    uint64_t length;
+    switch (width) {
+        case 1:
+            length = (uint8_t)**ip;
+            break;
+        case 4:
+            length = ZL_readLE32(*ip);
+            break;
+        default:
+            ZL_ASSERT_EQ(width, 8);
+            length = ZL_readLE64(*ip);
+            break;
+    }
+    ZL_RET_T_IF_GT(size_t, corruption, length, (uint64_t)SIZE_MAX);
+    *ip += width;
+    return ZL_RESULT_WRAP_VALUE(size_t, (size_t)length);
+}
+
+static ZL_Report skip(const char** ip, const char* iend, size_t size)
+{
+    ZL_RET_R_IF_LT(corruption, (size_t)(iend - *ip), size);
+    *ip += size;
+    return ZL_returnSuccess();
+}
+
+/// Skips the argument of an opcode with a length prefix of @p width bytes
+static ZL_Report skipCounted(const char** ip, const char* iend, size_t width)
+{
+    ZL_TRY_LET_T(size_t, size, readLength(ip, iend, width));
+    return skip(ip, iend, size);
+}
+
+/// Pushes the string argument of a BINUNICODE-like opcode
+static ZL_Report
+pushString(PickleMachine* m, const char** ip, const char* iend, size_t width)
+{
+    ZL_TRY_LET_T(size_t, size, readLength(ip, iend, width));
+    const char* const ptr = *ip;
+    ZL_RET_R_IF_ERR(skip(ip, iend, size));
+    return PickleMachine_push(m, makeString(ptr, size));
+}
+
+/// Replaces the top @p nbPopped values by a single Other value
+static ZL_Report replaceTop(PickleMachine* m, size_t nbPopped)
+{
+    ZL_RESULT_OF(PickleValue) popped = PickleMachine_pop(m, nbPopped);
+    ZL_RET_R_IF_ERR(popped);
+    return PickleMachine_push(m, kOtherValue);
+}
+
+static ZL_Report PickleMachine_run(
+        PickleMachine* m,
+        const char* ip,
+        const char* const iend)
+{
+    while (ip < iend) {
+        const char op = *ip++;
+        switch (op) {
+            case PKL_STOP:
+                return ZL_returnSuccess();
+
+            // No effect on the stack
+            case '\x80': // PROTO
+                ZL_RET_R_IF_ERR(skip(&ip, iend, 1));
+                break;
+            case '\x95': // FRAME
+                ZL_RET_R_IF_ERR(skip(&ip, iend, 8));
+                break;
+
+            case PKL_MARK:
+                ZL_RET_R_IF_ERR(PickleMachine_mark(m));
+                break;
+
+            // Push a value
+            case PKL_BINUNICODE:
+            case 'T': // BINSTRING
+                ZL_RET_R_IF_ERR(pushString(m, &ip, iend, 4));
+                break;
+            case PKL_SHORT_BINUNICODE:
+            case 'U': // SHORT_BINSTRING
+                ZL_RET_R_IF_ERR(pushString(m, &ip, iend, 1));
+                break;
+            case PKL_BINUNICODE8:
+                ZL_RET_R_IF_ERR(pushString(m, &ip, iend, 8));
+                break;
+            case 'B': // BINBYTES
+                ZL_RET_R_IF_ERR(skipCounted(&ip, iend, 4));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case 'C': // SHORT_BINBYTES
+            case '\x8a': // LONG1
+                ZL_RET_R_IF_ERR(skipCounted(&ip, iend, 1));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case '\x8b': // LONG4
+                ZL_RET_R_IF_ERR(skipCounted(&ip, iend, 4));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case '\x8e': // BINBYTES8
+            case '\x96': // BYTEARRAY8
+                ZL_RET_R_IF_ERR(skipCounted(&ip, iend, 8));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case 'K': // BININT1
+            case '\x82': // EXT1
+                ZL_RET_R_IF_ERR(skip(&ip, iend, 1));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case 'M': // BININT2
+            case '\x83': // EXT2
+                ZL_RET_R_IF_ERR(skip(&ip, iend, 2));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case 'J': // BININT
+            case '\x84': // EXT4
+                ZL_RET_R_IF_ERR(skip(&ip, iend, 4));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case 'G': // BINFLOAT
+                ZL_RET_R_IF_ERR(skip(&ip, iend, 8));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case 'I': // INT
+            case 'L': // LONG
+            case 'F': // FLOAT
+            case 'S': // STRING
+            case 'V': // UNICODE
+            case PKL_PERSID: {
+                ZL_TRY_LET_T(size_t, size, readLine(&ip, iend));
+                (void)size;
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            }
+            case 'N':    // NONE
+            case '\x88': // NEWTRUE
+            case '\x89': // NEWFALSE
+            case '}':    // EMPTY_DICT
+            case ']':    // EMPTY_LIST
+            case ')':    // EMPTY_TUPLE
+            case '\x8f': // EMPTY_SET
+            case '\x97': // NEXT_BUFFER
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case PKL_GLOBAL: {
+                const char* const module = ip;
+                ZL_TRY_LET_T(size_t, moduleSize, readLine(&ip, iend));
+                const char* const name = ip;
+                ZL_TRY_LET_T(size_t, nameSize, readLine(&ip, iend));
+                const PickleValue type =
+                        makeStorageType(module, moduleSize, name, nameSize);
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, type));
+                break;
+            }
+            case PKL_STACK_GLOBAL: {
+                const PickleValue name   = PickleMachine_peek(m, 0);
+                const PickleValue module = PickleMachine_peek(m, 1);
+                PickleValue type         = kOtherValue;
+                if (name.kind == PickleValue_String
+                    && module.kind == PickleValue_String) {
+                    type = makeStorageType(
+                            module.ptr, module.size, name.ptr, name.size);
+                }
+                ZL_RET_R_IF_ERR(PickleMachine_pop(m, 2));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, type));
+                break;
+            }
+
+            // Memo
+            case PKL_PUT: {
+                ZL_TRY_LET_T(size_t, index, readMemoIndex(&ip, iend));
+                PickleMachine_put(m, index);
+                break;
+            }
+            case PKL_BINPUT:
+            case PKL_LONG_BINPUT: {
+                ZL_TRY_LET_T(
+                        size_t,
+                        index,
+                        readLength(&ip, iend, op == PKL_BINPUT ? 1 : 4));
+                PickleMachine_put(m, index);
+                break;
+            }
+            case PKL_MEMOIZE:
+                PickleMachine_put(m, m->nextMemoIndex);
+                break;
+            case PKL_GET: {
+                ZL_TRY_LET_T(size_t, index, readMemoIndex(&ip, iend));
+                ZL_RET_R_IF_ERR(
+                        PickleMachine_push(m, PickleMachine_get(m, index)));
+                break;
+            }
+            case PKL_BINGET:
+            case PKL_LONG_BINGET: {
+                ZL_TRY_LET_T(
+                        size_t,
+                        index,
+                        readLength(&ip, iend, op == PKL_BINGET ? 1 : 4));
+                ZL_RET_R_IF_ERR(PickleMachine_push(
+                        m, PickleMachine_get(m, index)));
+                break;
+            }
+
+            // Stack manipulation
+            case PKL_POP:
+                ZL_RET_R_IF_ERR(PickleMachine_pop(m, 1));
+                break;
+            case PKL_POP_MARK:
+                ZL_RET_R_IF_ERR(PickleMachine_popMark(m));
+                break;
+            case PKL_DUP:
+                ZL_RET_R_IF_ERR(
+                        PickleMachine_push(m, PickleMachine_peek(m, 0)));
+                break;
+
+            // Build values out of the stack
+            case PKL_TUPLE: {
+                ZL_TRY_LET_R(count, PickleMachine_popMark(m));
+                ZL_RET_R_IF_ERR(PickleMachine_push(
+                        m, PickleMachine_makeTuple(m, count)));
+                break;
+            }
+            case PKL_TUPLE1:
+            case PKL_TUPLE2:
+            case PKL_TUPLE3: {
+                const size_t count = (size_t)(op - PKL_TUPLE1) + 1;
+                ZL_RET_R_IF_ERR(PickleMachine_pop(m, count));
+                ZL_RET_R_IF_ERR(PickleMachine_push(
+                        m, PickleMachine_makeTuple(m, count)));
+                break;
+            }
+            case 'd':    // DICT
+            case 'l':    // LIST
+            case 'o':    // OBJ
+            case '\x91': // FROZENSET
+                ZL_RET_R_IF_ERR(PickleMachine_popMark(m));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            case 'i': { // INST
+                ZL_TRY_LET_T(size_t, moduleSize, readLine(&ip, iend));
+                ZL_TRY_LET_T(size_t, nameSize, readLine(&ip, iend));
+                (void)moduleSize;
+                (void)nameSize;
+                ZL_RET_R_IF_ERR(PickleMachine_popMark(m));
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            }
+            case 'e':    // APPENDS
+            case 'u':    // SETITEMS
+            case '\x90': // ADDITEMS
+                ZL_RET_R_IF_ERR(PickleMachine_popMark(m));
+                break;
+            case 'a': // APPEND
+            case 'b': // BUILD
+                ZL_RET_R_IF_ERR(PickleMachine_pop(m, 1));
+                break;
+            case 's': // SETITEM
+                ZL_RET_R_IF_ERR(PickleMachine_pop(m, 2));
+                break;
+            case 'R':    // REDUCE
+            case '\x81': // NEWOBJ
+                ZL_RET_R_IF_ERR(replaceTop(m, 2));
+                break;
+            case '\x92': // NEWOBJ_EX
+                ZL_RET_R_IF_ERR(replaceTop(m, 3));
+                break;
+            case '\x98': // READONLY_BUFFER
+                ZL_RET_R_IF_ERR(replaceTop(m, 1));
+                break;
+            case PKL_BINPERSID: {
+                ZL_TRY_LET_T(PickleValue, pid, PickleMachine_pop(m, 1));
+                PickleMachine_persistentLoad(m, pid);
+                ZL_RET_R_IF_ERR(PickleMachine_push(m, kOtherValue));
+                break;
+            }
+            default:
+                ZL_RET_R_ERR(
+                        corruption,
+                        "Unknown pickle opcode %u",
+                        (unsigned)(uint8_t)op);
+        }
+    }
+    ZL_RET_R_ERR(corruption, "Pickle is missing its STOP opcode");
+}
+
+static int ZS2_PytorchStorage_cmp(const void* lhsPtr, const void* rhsPtr)
+{
+    const ZS2_PytorchStorage* const lhs = (const ZS2_PytorchStorage*)lhsPtr;
+    const ZS2_PytorchStorage* const rhs = (const ZS2_PytorchStorage*)rhsPtr;
+    if (lhs->keySize != rhs->keySize) {
+        return lhs->keySize < rhs->keySize ? -1 : 1;
+    }
+    return memcmp(lhs->key, rhs->key, lhs->keySize);
+}
+
+size_t ZS2_PytorchPickle_maxNumStorages(size_t pklSize)
+{
+    // Each storage takes at least a BINGET and a BINPERSID opcode
+    return pklSize / 3 + 1;
+}
+
+size_t ZS2_PytorchPickle_workspaceSize(size_t pklSize)
+{
+    // Each memoized value takes at least a two byte opcode, and a MEMOIZE
+    return (pklSize / 3 + 1) * sizeof(PickleMemoEntry);
+}
+
+ZL_Report ZS2_PytorchPickle_parseStorages(
+        ZS2_PytorchStorage* storages,
+        size_t storagesCapacity,
+        const void* pkl,
+        size_t pklSize,
+        void* workspace,
+        size_t workspaceSize)
+{
+    ZL_RET_R_IF_LT(
+            parameter_invalid,
+            workspaceSize,
+            ZS2_PytorchPickle_workspaceSize(pklSize));
+    PickleMachine m;
+    m.depth            = 0;
+    m.nbMarks          = 0;
+    m.memo             = (PickleMemoEntry*)workspace;
+    m.memoSize         = 0;
+    m.memoCapacity     = workspaceSize / sizeof(PickleMemoEntry);
+    m.nextMemoIndex    = 0;
+    m.storages         = storages;
+    m.nbStorages       = 0;
+    m.storagesCapacity = storagesCapacity;
+
+    const char* const src = (const char*)pkl;
+    ZL_RET_R_IF_ERR(PickleMachine_run(&m, src, src + pklSize));
+
+    if (m.nbStorages == 0) {
+        return ZL_returnValue(0);
+    }
+    qsort(storages,
+          m.nbStorages,
+          sizeof(*storages),
+          ZS2_PytorchStorage_cmp);
+    size_t nbUnique = 1;
+    for (size_t i = 1; i < m.nbStorages; ++i) {
+        if (ZS2_PytorchStorage_cmp(&storages[nbUnique - 1], &storages[i])
+            != 0) {
+            storages[nbUnique++] = storages[i];
+        }
+    }
+    return ZL_returnValue(nbUnique);
+}
+
+ZS2_TensorDType ZS2_PytorchPickle_findStorage(
+        const ZS2_PytorchStorage* storages,
+        size_t numStorages,
+        const char* key,
+        size_t keySize)
+{
+    if (numStorages == 0) {
+        return ZS2_TensorDType_Unknown;
+    }
+    const ZS2_PytorchStorage target = { key, keySize, ZS2_TensorDType_Unknown };
+    const ZS2_PytorchStorage* const found = (const ZS2_PytorchStorage*)bsearch(
+            &target,
+            storages,
+            numStorages,
+            sizeof(*storages),
+            ZS2_PytorchStorage_cmp);
+    return found == NULL ? ZS2_TensorDType_Unknown : found->dtype;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef CUSTOM_PARSERS_PYTORCH_PICKLE_H
+#define CUSTOM_PARSERS_PYTORCH_PICKLE_H
+
+#include <stddef.h>
+
+#include "custom_parsers/tensor_dtype.h"
+#include "openzl/shared/portability.h"
+#include "openzl/zl_errors.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * A tensor storage of a PyTorch archive. Its data lives in the archive entry
+ * `<archive>/data/<key>`.
+ */
+typedef struct {
+    /// Pointer to the key of the storage in the pickle.
+    /// @warning Not zero terminated.
+    const char* key;
+    size_t keySize;
+    ZS2_TensorDType dtype;
+} ZS2_PytorchStorage;
+
+/// @returns The maximum number of storages a pickle of @p pklSize bytes holds
+size_t ZS2_PytorchPickle_maxNumStorages(size_t pklSize);
+
+/// @returns The workspace size ZS2_PytorchPickle_parseStorages() needs for a
+/// pickle of @p pklSize bytes
+size_t ZS2_PytorchPickle_workspaceSize(size_t pklSize);
+
+/**
+ * Runs the pickled object of a PyTorch archive (`<archive>/data.pkl`, written
+ * by torch.save()) through a minimal pickle machine, which only tracks the
+ * values needed to resolve the persistent ids of tensor storages:
+ * ('storage', torch.<Type>Storage, key, location, numel).
+ *
+ * @param storages Filled with the storages found, sorted for
+ *                 ZS2_PytorchPickle_findStorage(). Storages shared by several
+ *                 tensors are only listed once.
+ * @param workspace Must be ZS2_PytorchPickle_workspaceSize(pklSize) bytes.
+ *
+ * @returns The number of storages, or an error if the pickle is invalid or
+ * exceeds the limits of the parser.
+ */
+ZL_Report ZS2_PytorchPickle_parseStorages(
+        ZS2_PytorchStorage* storages,
+        size_t storagesCapacity,
+        const void* pkl,
+        size_t pklSize,
+        void* workspace,
+        size_t workspaceSize);
+
+/// @returns The dtype of the storage named @p key, or ZS2_TensorDType_Unknown
+ZS2_TensorDType ZS2_PytorchPickle_findStorage(
+        const ZS2_PytorchStorage* storages,
+        size_t numStorages,
+        const char* key,
+        size_t keySize);
+
+ZL_END_C_DECLS
+
+#endif
@@ -0,0 +1,311 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "custom_parsers/safetensors_lexer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+
+static const size_t kHeaderSizeSize = 8;
+/// The reference implementation refuses headers larger than 100MB
+static const uint64_t kMaxHeaderSize = 100 << 20;
+/// Nesting limit of the values skipped in the header
+static const size_t kMaxDepth = 64;
+
+ZL_Report ZS2_SafetensorsLexer_headerSize(const void* src, size_t srcSize)
+{
+    ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, kHeaderSizeSize + 2);
+    const uint64_t jsonSize = ZL_readLE64(src);
+    ZL_RET_R_IF_GT(corruption, jsonSize, kMaxHeaderSize);
+    ZL_RET_R_IF_GT(srcSize_tooSmall, jsonSize, srcSize - kHeaderSizeSize);
+    ZL_RET_R_IF_NE(
+            corruption,
+            ((const char*)src)[kHeaderSizeSize],
+            '{',
+            "Safetensors header must be a JSON object");
+    return ZL_returnValue(kHeaderSizeSize + (size_t)jsonSize);
+}
+
+size_t ZS2_SafetensorsLexer_maxNumTensors(size_t headerSize)
+{
+    // The smallest tensor entry is "":{"dtype":"U8","data_offsets":[0,0]}
+    return headerSize / 32 + 1;
+}
+
+bool ZS2_isLikelySafetensorsFile(const void* src, size_t srcSize)
+{
+    return !ZL_isError(ZS2_SafetensorsLexer_headerSize(src, srcSize));
+}
+
+typedef struct {
+    const char* ptr;
+    const char* end;
+} JsonCursor;
+
+static void JsonCursor_skipSpaces(JsonCursor* c)
+{
+    while (c->ptr < c->end
+           && (*c->ptr == ' ' || *c->ptr == '\t' || *c->ptr == '\n'
+               || *c->ptr == '\r')) {
+        ++c->ptr;
+    }
+}
+
+/// Skips spaces and consumes @p expected
+static ZL_Report JsonCursor_expect(JsonCursor* c, char expected)
+{
+    JsonCursor_skipSpaces(c);
+    ZL_RET_R_IF_EQ(corruption, c->ptr, c->end, "Truncated safetensors header");
+    ZL_RET_R_IF_NE(
+            corruption,
+            *c->ptr,
+            expected,
+            "Unexpected character in safetensors header");
+    ++c->ptr;
+    return ZL_returnSuccess();
+}
+
+/// Skips spaces, and consumes @p expected if it is the next character
+static bool JsonCursor_accept(JsonCursor* c, char expected)
+{
+    JsonCursor_skipSpaces(c);
+    if (c->ptr < c->end && *c->ptr == expected) {
+        ++c->ptr;
+        return true;
+    }
+    return false;
+}
+
+typedef struct {
+    const char* ptr;
+    size_t size;
+} JsonString;
+
+ZL_RESULT_DECLARE_TYPE(JsonString);
+
+/// Reads a string. Escape sequences are left as is, since none of the strings
+/// the lexer compares against contain any.
+static ZL_RESULT_OF(JsonString) JsonCursor_readString(JsonCursor* c)
+{
+    ZL_RET_T_IF_ERR(JsonString, JsonCursor_expect(c, '"'));
+    const char* const begin = c->ptr;
+    while (c->ptr < c->end && *c->ptr != '"') {
+        const bool escape = *c->ptr == '\\' && c->end - c->ptr > 1;
+        c->ptr += escape ? 2 : 1;
+    }
+    ZL_RET_T_IF_GE(
+            JsonString,
+            corruption,
+            c->ptr,
+            c->end,
+            "Unterminated string in safetensors header");
+    JsonString str = { begin, (size_t)(c->ptr - begin) };
+    ++c->ptr;
+    return ZL_RESULT_WRAP_VALUE(JsonString, str);
+}
+
+static bool JsonString_eq(JsonString str, const char* expected)
+{
+    return str.size == strlen(expected)
+            && memcmp(str.ptr, expected, str.size) == 0;
+}
+
+static ZL_RESULT_OF(size_t) JsonCursor_readOffset(JsonCursor* c)
+{
+    JsonCursor_skipSpaces(c);
+    const char* const begin = c->ptr;
+    size_t value            = 0;
+    while (c->ptr < c->end && *c->ptr >= '0' && *c->ptr <= '9') {
+        const size_t digit = (size_t)(*c->ptr - '0');
+        ZL_RET_T_IF_GT(
+                size_t,
+                corruption,
+                value,
+                (SIZE_MAX - digit) / 10,
+                "Tensor offset overflow");
+        value = value * 10 + digit;
+        ++c->ptr;
+    }
+    ZL_RET_T_IF_EQ(
+            size_t,
+            corruption,
+            c->ptr,
+            begin,
+            "Tensor offsets must be non-negative integers");
+    return ZL_RESULT_WRAP_VALUE(size_t, value);
+}
+
+/// Skips any JSON value, nested at most @p depth levels
+static ZL_Report JsonCursor_skipValue(JsonCursor* c, size_t depth)
+{
+    ZL_RET_R_IF_EQ(
+            temporaryLibraryLimitation,
+            depth,
+            0,
+            "Safetensors header nested too deeply");
+    JsonCursor_skipSpaces(c);
+    ZL_RET_R_IF_EQ(corruption, c->ptr, c->end, "Truncated safetensors header");
+    switch (*c->ptr) {
+        case '"': {
+            ZL_TRY_LET_T(JsonString, str, JsonCursor_readString(c));
+            (void)str;
+            return ZL_returnSuccess();
+        }
+        case '[':
+        case '{': {
+            const bool isObject = *c->ptr == '{';
+            const char close    = isObject ? '}' : ']';
+            ++c->ptr;
+            if (JsonCursor_accept(c, close)) {
+                return ZL_returnSuccess();
+            }
+            do {
+                if (isObject) {
+                    ZL_TRY_LET_T(JsonString, key, JsonCursor_readString(c));
+                    (void)key;
+                    ZL_RET_R_IF_ERR(JsonCursor_expect(c, ':'));
+                }
+                ZL_RET_R_IF_ERR(JsonCursor_skipValue(c, depth - 1));
+            } while (JsonCursor_accept(c, ','));
+            return JsonCursor_expect(c, close);
+        }
+        default: {
+            // Numbers & literals
+            const char* const begin = c->ptr;
+            while (c->ptr < c->end && *c->ptr != ',' && *c->ptr != ']'
+                   && *c->ptr != '}' && *c->ptr != ' ' && *c->ptr != '\n'
+                   && *c->ptr != '\r' && *c->ptr != '\t') {
+                ++c->ptr;
+            }
+            ZL_RET_R_IF_EQ(corruption, c->ptr, begin, "Missing JSON value");
+            return ZL_returnSuccess();
+        }
+    }
+}
+
+static ZS2_TensorDType parseDType(JsonString str)
+{
+    static const struct {
+        const char* name;
+        ZS2_TensorDType dtype;
+    } kDTypes[] = {
+        { "BOOL", ZS2_TensorDType_Bool }, { "U8", ZS2_TensorDType_U8 },
+        { "I8", ZS2_TensorDType_I8 },     { "I16", ZS2_TensorDType_I16 },
+        { "I32", ZS2_TensorDType_I32 },   { "I64", ZS2_TensorDType_I64 },
+        { "F16", ZS2_TensorDType_F16 },   { "BF16", ZS2_TensorDType_BF16 },
+        { "F32", ZS2_TensorDType_F32 },   { "F64", ZS2_TensorDType_F64 },
+    };
+    for (size_t i = 0; i < ZL_ARRAY_SIZE(kDTypes); ++i) {
+        if (JsonString_eq(str, kDTypes[i].name)) {
+            return kDTypes[i].dtype;
+        }
+    }
+    return ZS2_TensorDType_Unknown;
+}
+
+/// Parses the description of a tensor: {"dtype":..., "data_offsets":[b, e]}
+/// Offsets are relative to the data section.
+static ZL_Report JsonCursor_readTensor(
+        JsonCursor* c,
+        ZS2_SafetensorsTensor* tensor)
+{
+    bool hasOffsets = false;
+    tensor->dtype   = ZS2_TensorDType_Unknown;
+    ZL_RET_R_IF_ERR(JsonCursor_expect(c, '{'));
+    if (!JsonCursor_accept(c, '}')) {
+        do {
+            ZL_TRY_LET_T(JsonString, key, JsonCursor_readString(c));
+            ZL_RET_R_IF_ERR(JsonCursor_expect(c, ':'));
+            if (JsonString_eq(key, "dtype")) {
+                ZL_TRY_LET_T(JsonString, dtype, JsonCursor_readString(c));
+                tensor->dtype = parseDType(dtype);
+            } else if (JsonString_eq(key, "data_offsets")) {
+                ZL_RET_R_IF_ERR(JsonCursor_expect(c, '['));
+                ZL_TRY_LET_T(size_t, begin, JsonCursor_readOffset(c));
+                ZL_RET_R_IF_ERR(JsonCursor_expect(c, ','));
+                ZL_TRY_LET_T(size_t, end, JsonCursor_readOffset(c));
+                ZL_RET_R_IF_ERR(JsonCursor_expect(c, ']'));
+                ZL_RET_R_IF_GT(corruption, begin, end);
+                tensor->begin = begin;
+                tensor->end   = end;
+                hasOffsets    = true;
+            } else {
+                ZL_RET_R_IF_ERR(JsonCursor_skipValue(c, kMaxDepth));
+            }
+        } while (JsonCursor_accept(c, ','));
+        ZL_RET_R_IF_ERR(JsonCursor_expect(c, '}'));
+    }
+    ZL_RET_R_IF(corruption, !hasOffsets, "Tensor is missing its data_offsets");
+    return ZL_returnSuccess();
+}
+
+static int ZS2_SafetensorsTensor_cmp(const void* lhsPtr, const void* rhsPtr)
+{
+    const ZS2_SafetensorsTensor* const lhs =
+            (const ZS2_SafetensorsTensor*)lhsPtr;
+    const ZS2_SafetensorsTensor* const rhs =
+            (const ZS2_SafetensorsTensor*)rhsPtr;
+    if (lhs->begin != rhs->begin) {
+        return lhs->begin < rhs->begin ? -1 : 1;
+    }
+    if (lhs->end != rhs->end) {
+        return lhs->end < rhs->end ? -1 : 1;
+    }
+    return 0;
+}
+
+ZL_Report ZS2_SafetensorsLexer_lex(
+        ZS2_SafetensorsTensor* tensors,
+        size_t tensorsCapacity,
+        const void* src,
+        size_t srcSize)
+{
+    ZL_TRY_LET_R(headerSize, ZS2_SafetensorsLexer_headerSize(src, srcSize));
+    const size_t dataSize = srcSize - headerSize;
+
+    JsonCursor c     = { (const char*)src + kHeaderSizeSize,
+                         (const char*)src + headerSize };
+    size_t nbTensors = 0;
+    ZL_RET_R_IF_ERR(JsonCursor_expect(&c, '{'));
+    if (!JsonCursor_accept(&c, '}')) {
+        do {
+            ZL_TRY_LET_T(JsonString, name, JsonCursor_readString(&c));
+            ZL_RET_R_IF_ERR(JsonCursor_expect(&c, ':'));
+            if (JsonString_eq(name, "__metadata__")) {
+                ZL_RET_R_IF_ERR(JsonCursor_skipValue(&c, kMaxDepth));
+                continue;
+            }
+            ZL_RET_R_IF_GE(
+                    internalBuffer_tooSmall, nbTensors, tensorsCapacity);
+            ZS2_SafetensorsTensor* const tensor = &tensors[nbTensors++];
+            ZL_RET_R_IF_ERR(JsonCursor_readTensor(&c, tensor));
+            ZL_RET_R_IF_GT(
+                    corruption,
+                    tensor->end,
+                    dataSize,
+                    "Tensor out of bounds");
+            tensor->begin += headerSize;
+            tensor->end += headerSize;
+        } while (JsonCursor_accept(&c, ','));
+        ZL_RET_R_IF_ERR(JsonCursor_expect(&c, '}'));
+    }
+    // The header may be padded with spaces
+    JsonCursor_skipSpaces(&c);
+    ZL_RET_R_IF_NE(
+            corruption,
+            c.ptr,
+            c.end,
+            "Trailing bytes in safetensors header");
+
+    qsort(tensors, nbTensors, sizeof(*tensors), ZS2_SafetensorsTensor_cmp);
+    for (size_t i = 1; i < nbTensors; ++i) {
+        ZL_RET_R_IF_GT(
+                corruption,
+                tensors[i - 1].end,
+                tensors[i].begin,
+                "Overlapping tensors");
+    }
+    return ZL_returnValue(nbTensors);
+}
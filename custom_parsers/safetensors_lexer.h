@@ -0,0 +1,62 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef CUSTOM_PARSERS_SAFETENSORS_LEXER_H
+#define CUSTOM_PARSERS_SAFETENSORS_LEXER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "custom_parsers/tensor_dtype.h"
+#include "openzl/shared/portability.h"
+#include "openzl/zl_errors.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * A tensor of a safetensors file. A safetensors file is made of:
+ * - The little-endian 64-bit size of the header.
+ * - The JSON header, mapping each tensor name to its dtype, shape, and
+ *   `data_offsets` within the data section.
+ * - The data section, holding the tensors.
+ */
+typedef struct {
+    /// Offset of the tensor in the source buffer, not in the data section.
+    size_t begin;
+    size_t end;
+    ZS2_TensorDType dtype;
+} ZS2_SafetensorsTensor;
+
+/**
+ * @returns The size of the header, including its 8-byte size prefix, which is
+ * the offset of the data section. Or an error if @p src is not a safetensors
+ * file.
+ */
+ZL_Report ZS2_SafetensorsLexer_headerSize(const void* src, size_t srcSize);
+
+/// @returns An upper bound on the number of tensors in a header of
+/// @p headerSize bytes
+size_t ZS2_SafetensorsLexer_maxNumTensors(size_t headerSize);
+
+/**
+ * Lexes the header of the safetensors file @p src.
+ *
+ * @param tensors Filled with the tensors, sorted by offset. They are validated
+ *                to be within @p src, and to not overlap each other.
+ *                Tensors with a dtype the lexer doesn't know are
+ *                ZS2_TensorDType_Unknown.
+ *
+ * @returns The number of tensors, or an error if @p src is not a valid
+ * safetensors file.
+ */
+ZL_Report ZS2_SafetensorsLexer_lex(
+        ZS2_SafetensorsTensor* tensors,
+        size_t tensorsCapacity,
+        const void* src,
+        size_t srcSize);
+
+/// @returns true if the input buffer is likely a safetensors file.
+bool ZS2_isLikelySafetensorsFile(const void* src, size_t srcSize);
+
+ZL_END_C_DECLS
+
+#endif
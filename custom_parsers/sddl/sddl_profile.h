@@ -17,6 +17,10 @@ extern "C" {
  * profile sets up. (That default is the generic clustering graph, with its
  * default successor set.)
  *
+ * The description parses the input as a whole, so the input is not cut into
+ * chunks. With ZL_CParam_nbWorkers > 1, only the compression of the
+ * dispatched streams runs in parallel, not the parsing.
+ *
  * @param description should point to a compiled description, such as is
  *                    produced by @ref openzl::sddl::Compiler::compile().
  */
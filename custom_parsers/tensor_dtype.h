@@ -0,0 +1,55 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef CUSTOM_PARSERS_TENSOR_DTYPE_H
+#define CUSTOM_PARSERS_TENSOR_DTYPE_H
+
+#include <stddef.h>
+
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * The element type of a tensor, as declared by the model file's metadata.
+ */
+typedef enum {
+    ZS2_TensorDType_Unknown = 0,
+    ZS2_TensorDType_Bool,
+    ZS2_TensorDType_U8,
+    ZS2_TensorDType_I8,
+    ZS2_TensorDType_I16,
+    ZS2_TensorDType_I32,
+    ZS2_TensorDType_I64,
+    ZS2_TensorDType_F16,
+    ZS2_TensorDType_BF16,
+    ZS2_TensorDType_F32,
+    ZS2_TensorDType_F64,
+} ZS2_TensorDType;
+
+/// @returns The width of an element of @p dtype in bytes, or 0 if unknown.
+ZL_INLINE size_t ZS2_TensorDType_eltWidth(ZS2_TensorDType dtype)
+{
+    switch (dtype) {
+        case ZS2_TensorDType_Bool:
+        case ZS2_TensorDType_U8:
+        case ZS2_TensorDType_I8:
+            return 1;
+        case ZS2_TensorDType_I16:
+        case ZS2_TensorDType_F16:
+        case ZS2_TensorDType_BF16:
+            return 2;
+        case ZS2_TensorDType_I32:
+        case ZS2_TensorDType_F32:
+            return 4;
+        case ZS2_TensorDType_I64:
+        case ZS2_TensorDType_F64:
+            return 8;
+        case ZS2_TensorDType_Unknown:
+        default:
+            return 0;
+    }
+}
+
+ZL_END_C_DECLS
+
+#endif
@@ -1,11 +1,32 @@
 # Copyright (c) Meta Platforms, Inc. and affiliates.
 
+import collections
 import hashlib
+import io
+import json
 import os
+import pickle
 import random
+import struct
 import sys
 import tempfile
+import types
 import zipfile
+from unittest import mock
+
+# dtype: (safetensors name, torch storage type, struct format)
+DTYPES = {
+    "bool": ("BOOL", "BoolStorage", "?"),
+    "uint8": ("U8", "ByteStorage", "B"),
+    "int8": ("I8", "CharStorage", "b"),
+    "int16": ("I16", "ShortStorage", "h"),
+    "int32": ("I32", "IntStorage", "i"),
+    "int64": ("I64", "LongStorage", "q"),
+    "float16": ("F16", "HalfStorage", "e"),
+    "bfloat16": ("BF16", "BFloat16Storage", None),
+    "float32": ("F32", "FloatStorage", "f"),
+    "float64": ("F64", "DoubleStorage", "d"),
+}
 
 
 def write_data_file(zf, filename, small):
@@ -50,9 +71,124 @@ def generate_zipfile(small):
             return f.read()
 
 
-def generate_corpus(small):
+def generate_tensor(dtype, numel):
+    fmt = DTYPES[dtype][2]
+    if dtype == "bfloat16":
+        values = struct.pack(f"<{numel}f", *(random.gauss(0, 1) for _ in range(numel)))
+        return b"".join(values[i + 2 : i + 4] for i in range(0, len(values), 4))
+    if fmt in "efd":
+        values = [random.gauss(0, 1) for _ in range(numel)]
+    elif fmt == "?":
+        values = [random.random() < 0.5 for _ in range(numel)]
+    else:
+        bits = struct.calcsize(fmt) * 8
+        lo = 0 if fmt == "B" else -(1 << (bits - 1))
+        hi = (1 << bits) - 1 if fmt == "B" else (1 << (bits - 1)) - 1
+        values = [min(max(int(random.gauss(0, 1000)), lo), hi) for _ in range(numel)]
+    return struct.pack(f"<{numel}{fmt}", *values)
+
+
+def generate_tensors(small):
+    tensors = {}
+    for i in range(random.randint(0, 20)):
+        dtype = random.choice(list(DTYPES))
+        numel = random.randint(0, 50 if small else 5000)
+        tensors[f"layer{i}.weight"] = (dtype, numel, generate_tensor(dtype, numel))
+    return tensors
+
+
+class FakeTensor:
+    def __init__(self, storage, numel):
+        self.storage = storage
+        self.numel = numel
+
+    def __reduce__(self):
+        rebuild = sys.modules["torch._utils"]._rebuild_tensor_v2
+        args = (self.storage, 0, (self.numel,), (1,), False, collections.OrderedDict())
+        return (rebuild, args)
+
+
+class FakeStorage:
+    def __init__(self, storage_type, key, numel):
+        self.storage_type = storage_type
+        self.key = key
+        self.numel = numel
+
+
+class TorchPickler(pickle.Pickler):
+    def persistent_id(self, obj):
+        if isinstance(obj, FakeStorage):
+            return ("storage", obj.storage_type, obj.key, "cpu", obj.numel)
+        return None
+
+
+def fake_torch_modules():
+    """Modules standing in for torch, so that the pickle references the same
+    globals as torch.save()."""
+    torch = types.ModuleType("torch")
+    for _, storage_type, _ in DTYPES.values():
+        setattr(torch, storage_type, type(storage_type, (), {"__module__": "torch"}))
+    utils = types.ModuleType("torch._utils")
+
+    def _rebuild_tensor_v2(*args):
+        raise NotImplementedError
+
+    _rebuild_tensor_v2.__module__ = "torch._utils"
+    _rebuild_tensor_v2.__qualname__ = "_rebuild_tensor_v2"
+    utils._rebuild_tensor_v2 = _rebuild_tensor_v2
+    torch._utils = utils
+    return {"torch": torch, "torch._utils": utils}
+
+
+def generate_torch_archive(small):
+    """Generates a zip file laid out like torch.save() does."""
+    tensors = generate_tensors(small)
+    with mock.patch.dict(sys.modules, fake_torch_modules()):
+        torch = sys.modules["torch"]
+        state_dict = collections.OrderedDict()
+        for key, (name, (dtype, numel, _)) in enumerate(tensors.items()):
+            storage_type = getattr(torch, DTYPES[dtype][1])
+            storage = FakeStorage(storage_type, str(key), numel)
+            state_dict[name] = FakeTensor(storage, numel)
+        pkl = io.BytesIO()
+        TorchPickler(pkl, protocol=2).dump(state_dict)
+
+    with tempfile.NamedTemporaryFile() as f:
+        with zipfile.ZipFile(f.name, "w") as zf:
+            zf.writestr("archive/data.pkl", pkl.getvalue())
+            zf.writestr("archive/byteorder", "little")
+            for key, (_, _, data) in enumerate(tensors.values()):
+                zf.writestr(f"archive/data/{key}", data)
+            zf.writestr("archive/version", "3\n")
+
+        with open(f.name, "rb") as f:
+            return f.read()
+
+
+def generate_safetensors(small):
+    tensors = generate_tensors(small)
+    header = {"__metadata__": {"format": "pt"}}
+    offset = 0
+    for name, (dtype, numel, data) in tensors.items():
+        header[name] = {
+            "dtype": DTYPES[dtype][0],
+            "shape": [numel],
+            "data_offsets": [offset, offset + len(data)],
+        }
+        offset += len(data)
+    header = json.dumps(header).encode()
+    header += b" " * (-len(header) % 8)
+    data = b"".join(data for _, _, data in tensors.values())
+    return struct.pack("<Q", len(header)) + header + data
+
+
+def generate_corpus(small, models):
     for _ in range(100):
         yield generate_zipfile(small)
+    if models:
+        for _ in range(50):
+            yield generate_torch_archive(small)
+            yield generate_safetensors(small)
 
 
 def main(test_suite, test_case, out_dir):
@@ -60,7 +196,7 @@ def main(test_suite, test_case, out_dir):
         raise ValueError(f"Unknown test suite: {test_suite}")
     small = test_suite == "ZipLexerTest"
 
-    corpus = generate_corpus(small)
+    corpus = generate_corpus(small, test_suite == "PytorchModelParserTest")
 
     os.makedirs(out_dir, exist_ok=True)
     for blob in corpus:
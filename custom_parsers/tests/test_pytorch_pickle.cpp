@@ -0,0 +1,268 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <stdint.h>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "custom_parsers/pytorch_pickle.h"
+#include "openzl/common/errors_internal.h"
+
+using namespace ::testing;
+
+namespace {
+// torch.save() of {w: float32[4], b: bfloat16[2], n: int64[1], w2: w}
+std::array<uint8_t, 365> kProtocol2Pickle = {
+    0x80, 0x02, 0x63, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x69, 0x6f,
+    0x6e, 0x73, 0x0a, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x65, 0x64, 0x44, 0x69,
+    0x63, 0x74, 0x0a, 0x71, 0x00, 0x29, 0x52, 0x71, 0x01, 0x28, 0x58, 0x01,
+    0x00, 0x00, 0x00, 0x77, 0x71, 0x02, 0x63, 0x74, 0x6f, 0x72, 0x63, 0x68,
+    0x2e, 0x5f, 0x75, 0x74, 0x69, 0x6c, 0x73, 0x0a, 0x5f, 0x72, 0x65, 0x62,
+    0x75, 0x69, 0x6c, 0x64, 0x5f, 0x74, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x5f,
+    0x76, 0x32, 0x0a, 0x71, 0x03, 0x28, 0x28, 0x58, 0x07, 0x00, 0x00, 0x00,
+    0x73, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x71, 0x04, 0x63, 0x74, 0x6f,
+    0x72, 0x63, 0x68, 0x0a, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x53, 0x74, 0x6f,
+    0x72, 0x61, 0x67, 0x65, 0x0a, 0x71, 0x05, 0x58, 0x01, 0x00, 0x00, 0x00,
+    0x30, 0x71, 0x06, 0x58, 0x03, 0x00, 0x00, 0x00, 0x63, 0x70, 0x75, 0x71,
+    0x07, 0x4b, 0x04, 0x74, 0x71, 0x08, 0x51, 0x4b, 0x00, 0x4b, 0x04, 0x85,
+    0x71, 0x09, 0x4b, 0x01, 0x85, 0x71, 0x0a, 0x89, 0x68, 0x00, 0x29, 0x52,
+    0x71, 0x0b, 0x74, 0x71, 0x0c, 0x52, 0x71, 0x0d, 0x58, 0x01, 0x00, 0x00,
+    0x00, 0x62, 0x71, 0x0e, 0x68, 0x03, 0x28, 0x28, 0x68, 0x04, 0x63, 0x74,
+    0x6f, 0x72, 0x63, 0x68, 0x0a, 0x42, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x31,
+    0x36, 0x53, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x0a, 0x71, 0x0f, 0x58,
+    0x01, 0x00, 0x00, 0x00, 0x31, 0x71, 0x10, 0x68, 0x07, 0x4b, 0x02, 0x74,
+    0x71, 0x11, 0x51, 0x4b, 0x00, 0x4b, 0x02, 0x85, 0x71, 0x12, 0x68, 0x0a,
+    0x89, 0x68, 0x00, 0x29, 0x52, 0x71, 0x13, 0x74, 0x71, 0x14, 0x52, 0x71,
+    0x15, 0x58, 0x01, 0x00, 0x00, 0x00, 0x6e, 0x71, 0x16, 0x68, 0x03, 0x28,
+    0x28, 0x68, 0x04, 0x63, 0x74, 0x6f, 0x72, 0x63, 0x68, 0x0a, 0x4c, 0x6f,
+    0x6e, 0x67, 0x53, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x0a, 0x71, 0x17,
+    0x58, 0x01, 0x00, 0x00, 0x00, 0x32, 0x71, 0x18, 0x68, 0x07, 0x4b, 0x01,
+    0x74, 0x71, 0x19, 0x51, 0x4b, 0x00, 0x4b, 0x01, 0x85, 0x71, 0x1a, 0x68,
+    0x0a, 0x89, 0x68, 0x00, 0x29, 0x52, 0x71, 0x1b, 0x74, 0x71, 0x1c, 0x52,
+    0x71, 0x1d, 0x58, 0x02, 0x00, 0x00, 0x00, 0x77, 0x32, 0x71, 0x1e, 0x68,
+    0x03, 0x28, 0x28, 0x68, 0x04, 0x68, 0x05, 0x68, 0x06, 0x68, 0x07, 0x4b,
+    0x04, 0x74, 0x71, 0x1f, 0x51, 0x4b, 0x00, 0x4b, 0x04, 0x85, 0x71, 0x20,
+    0x68, 0x0a, 0x89, 0x68, 0x00, 0x29, 0x52, 0x71, 0x21, 0x74, 0x71, 0x22,
+    0x52, 0x71, 0x23, 0x75, 0x2e,
+};
+
+// The same object with pickle protocol 4
+std::array<uint8_t, 319> kProtocol4Pickle = {
+    0x80, 0x04, 0x95, 0x34, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8c,
+    0x0b, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73,
+    0x94, 0x8c, 0x0b, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x65, 0x64, 0x44, 0x69,
+    0x63, 0x74, 0x94, 0x93, 0x94, 0x29, 0x52, 0x94, 0x28, 0x8c, 0x01, 0x77,
+    0x94, 0x8c, 0x0c, 0x74, 0x6f, 0x72, 0x63, 0x68, 0x2e, 0x5f, 0x75, 0x74,
+    0x69, 0x6c, 0x73, 0x94, 0x8c, 0x12, 0x5f, 0x72, 0x65, 0x62, 0x75, 0x69,
+    0x6c, 0x64, 0x5f, 0x74, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x5f, 0x76, 0x32,
+    0x94, 0x93, 0x94, 0x28, 0x28, 0x8c, 0x07, 0x73, 0x74, 0x6f, 0x72, 0x61,
+    0x67, 0x65, 0x94, 0x8c, 0x05, 0x74, 0x6f, 0x72, 0x63, 0x68, 0x94, 0x8c,
+    0x0c, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x53, 0x74, 0x6f, 0x72, 0x61, 0x67,
+    0x65, 0x94, 0x93, 0x94, 0x8c, 0x01, 0x30, 0x94, 0x8c, 0x03, 0x63, 0x70,
+    0x75, 0x94, 0x4b, 0x04, 0x74, 0x94, 0x51, 0x4b, 0x00, 0x4b, 0x04, 0x85,
+    0x94, 0x4b, 0x01, 0x85, 0x94, 0x89, 0x68, 0x02, 0x29, 0x52, 0x94, 0x74,
+    0x94, 0x52, 0x94, 0x8c, 0x01, 0x62, 0x94, 0x68, 0x07, 0x28, 0x28, 0x68,
+    0x08, 0x68, 0x09, 0x8c, 0x0f, 0x42, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x31,
+    0x36, 0x53, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x94, 0x93, 0x94, 0x8c,
+    0x01, 0x31, 0x94, 0x68, 0x0d, 0x4b, 0x02, 0x74, 0x94, 0x51, 0x4b, 0x00,
+    0x4b, 0x02, 0x85, 0x94, 0x68, 0x10, 0x89, 0x68, 0x02, 0x29, 0x52, 0x94,
+    0x74, 0x94, 0x52, 0x94, 0x8c, 0x01, 0x6e, 0x94, 0x68, 0x07, 0x28, 0x28,
+    0x68, 0x08, 0x68, 0x09, 0x8c, 0x0b, 0x4c, 0x6f, 0x6e, 0x67, 0x53, 0x74,
+    0x6f, 0x72, 0x61, 0x67, 0x65, 0x94, 0x93, 0x94, 0x8c, 0x01, 0x32, 0x94,
+    0x68, 0x0d, 0x4b, 0x01, 0x74, 0x94, 0x51, 0x4b, 0x00, 0x4b, 0x01, 0x85,
+    0x94, 0x68, 0x10, 0x89, 0x68, 0x02, 0x29, 0x52, 0x94, 0x74, 0x94, 0x52,
+    0x94, 0x8c, 0x02, 0x77, 0x32, 0x94, 0x68, 0x07, 0x28, 0x28, 0x68, 0x08,
+    0x68, 0x0b, 0x68, 0x0c, 0x68, 0x0d, 0x4b, 0x04, 0x74, 0x94, 0x51, 0x4b,
+    0x00, 0x4b, 0x04, 0x85, 0x94, 0x68, 0x10, 0x89, 0x68, 0x02, 0x29, 0x52,
+    0x94, 0x74, 0x94, 0x52, 0x94, 0x75, 0x2e,
+};
+
+// The same object with pickle protocol 0, which has text persistent ids
+std::array<uint8_t, 506> kProtocol0Pickle = {
+    0x63, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73,
+    0x0a, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x65, 0x64, 0x44, 0x69, 0x63, 0x74,
+    0x0a, 0x70, 0x30, 0x0a, 0x28, 0x74, 0x52, 0x70, 0x31, 0x0a, 0x56, 0x77,
+    0x0a, 0x70, 0x32, 0x0a, 0x63, 0x74, 0x6f, 0x72, 0x63, 0x68, 0x2e, 0x5f,
+    0x75, 0x74, 0x69, 0x6c, 0x73, 0x0a, 0x5f, 0x72, 0x65, 0x62, 0x75, 0x69,
+    0x6c, 0x64, 0x5f, 0x74, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x5f, 0x76, 0x32,
+    0x0a, 0x70, 0x33, 0x0a, 0x28, 0x50, 0x28, 0x27, 0x73, 0x74, 0x6f, 0x72,
+    0x61, 0x67, 0x65, 0x27, 0x2c, 0x20, 0x3c, 0x63, 0x6c, 0x61, 0x73, 0x73,
+    0x20, 0x27, 0x74, 0x6f, 0x72, 0x63, 0x68, 0x2e, 0x46, 0x6c, 0x6f, 0x61,
+    0x74, 0x53, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x27, 0x3e, 0x2c, 0x20,
+    0x27, 0x30, 0x27, 0x2c, 0x20, 0x27, 0x63, 0x70, 0x75, 0x27, 0x2c, 0x20,
+    0x34, 0x29, 0x0a, 0x49, 0x30, 0x0a, 0x28, 0x49, 0x34, 0x0a, 0x74, 0x70,
+    0x34, 0x0a, 0x28, 0x49, 0x31, 0x0a, 0x74, 0x70, 0x35, 0x0a, 0x49, 0x30,
+    0x30, 0x0a, 0x67, 0x30, 0x0a, 0x28, 0x74, 0x52, 0x70, 0x36, 0x0a, 0x74,
+    0x70, 0x37, 0x0a, 0x52, 0x70, 0x38, 0x0a, 0x73, 0x56, 0x62, 0x0a, 0x70,
+    0x39, 0x0a, 0x67, 0x33, 0x0a, 0x28, 0x50, 0x28, 0x27, 0x73, 0x74, 0x6f,
+    0x72, 0x61, 0x67, 0x65, 0x27, 0x2c, 0x20, 0x3c, 0x63, 0x6c, 0x61, 0x73,
+    0x73, 0x20, 0x27, 0x74, 0x6f, 0x72, 0x63, 0x68, 0x2e, 0x42, 0x46, 0x6c,
+    0x6f, 0x61, 0x74, 0x31, 0x36, 0x53, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65,
+    0x27, 0x3e, 0x2c, 0x20, 0x27, 0x31, 0x27, 0x2c, 0x20, 0x27, 0x63, 0x70,
+    0x75, 0x27, 0x2c, 0x20, 0x32, 0x29, 0x0a, 0x49, 0x30, 0x0a, 0x28, 0x49,
+    0x32, 0x0a, 0x74, 0x70, 0x31, 0x30, 0x0a, 0x67, 0x35, 0x0a, 0x49, 0x30,
+    0x30, 0x0a, 0x67, 0x30, 0x0a, 0x28, 0x74, 0x52, 0x70, 0x31, 0x31, 0x0a,
+    0x74, 0x70, 0x31, 0x32, 0x0a, 0x52, 0x70, 0x31, 0x33, 0x0a, 0x73, 0x56,
+    0x6e, 0x0a, 0x70, 0x31, 0x34, 0x0a, 0x67, 0x33, 0x0a, 0x28, 0x50, 0x28,
+    0x27, 0x73, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x27, 0x2c, 0x20, 0x3c,
+    0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x27, 0x74, 0x6f, 0x72, 0x63, 0x68,
+    0x2e, 0x4c, 0x6f, 0x6e, 0x67, 0x53, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65,
+    0x27, 0x3e, 0x2c, 0x20, 0x27, 0x32, 0x27, 0x2c, 0x20, 0x27, 0x63, 0x70,
+    0x75, 0x27, 0x2c, 0x20, 0x31, 0x29, 0x0a, 0x49, 0x30, 0x0a, 0x28, 0x49,
+    0x31, 0x0a, 0x74, 0x70, 0x31, 0x35, 0x0a, 0x67, 0x35, 0x0a, 0x49, 0x30,
+    0x30, 0x0a, 0x67, 0x30, 0x0a, 0x28, 0x74, 0x52, 0x70, 0x31, 0x36, 0x0a,
+    0x74, 0x70, 0x31, 0x37, 0x0a, 0x52, 0x70, 0x31, 0x38, 0x0a, 0x73, 0x56,
+    0x77, 0x32, 0x0a, 0x70, 0x31, 0x39, 0x0a, 0x67, 0x33, 0x0a, 0x28, 0x50,
+    0x28, 0x27, 0x73, 0x74, 0x6f, 0x72, 0x61, 0x67, 0x65, 0x27, 0x2c, 0x20,
+    0x3c, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x27, 0x74, 0x6f, 0x72, 0x63,
+    0x68, 0x2e, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x53, 0x74, 0x6f, 0x72, 0x61,
+    0x67, 0x65, 0x27, 0x3e, 0x2c, 0x20, 0x27, 0x30, 0x27, 0x2c, 0x20, 0x27,
+    0x63, 0x70, 0x75, 0x27, 0x2c, 0x20, 0x34, 0x29, 0x0a, 0x49, 0x30, 0x0a,
+    0x28, 0x49, 0x34, 0x0a, 0x74, 0x70, 0x32, 0x30, 0x0a, 0x67, 0x35, 0x0a,
+    0x49, 0x30, 0x30, 0x0a, 0x67, 0x30, 0x0a, 0x28, 0x74, 0x52, 0x70, 0x32,
+    0x31, 0x0a, 0x74, 0x70, 0x32, 0x32, 0x0a, 0x52, 0x70, 0x32, 0x33, 0x0a,
+    0x73, 0x2e,
+};
+
+ZL_Report parseStorages(
+        std::vector<ZS2_PytorchStorage>& storages,
+        std::string_view pkl)
+{
+    storages.resize(ZS2_PytorchPickle_maxNumStorages(pkl.size()));
+    std::vector<char> workspace(ZS2_PytorchPickle_workspaceSize(pkl.size()));
+    const auto report = ZS2_PytorchPickle_parseStorages(
+            storages.data(),
+            storages.size(),
+            pkl.data(),
+            pkl.size(),
+            workspace.data(),
+            workspace.size());
+    if (!ZL_isError(report)) {
+        storages.resize(ZL_validResult(report));
+    }
+    return report;
+}
+
+ZS2_TensorDType findStorage(
+        const std::vector<ZS2_PytorchStorage>& storages,
+        std::string_view key)
+{
+    return ZS2_PytorchPickle_findStorage(
+            storages.data(), storages.size(), key.data(), key.size());
+}
+
+void testStateDict(std::string_view pkl)
+{
+    std::vector<ZS2_PytorchStorage> storages;
+    ZL_REQUIRE_SUCCESS(parseStorages(storages, pkl));
+    // w & w2 share the same storage
+    ASSERT_EQ(storages.size(), 3);
+    ASSERT_EQ(findStorage(storages, "0"), ZS2_TensorDType_F32);
+    ASSERT_EQ(findStorage(storages, "1"), ZS2_TensorDType_BF16);
+    ASSERT_EQ(findStorage(storages, "2"), ZS2_TensorDType_I64);
+    ASSERT_EQ(findStorage(storages, "3"), ZS2_TensorDType_Unknown);
+    ASSERT_EQ(findStorage(storages, "00"), ZS2_TensorDType_Unknown);
+}
+
+template <size_t N>
+std::string_view toStringView(const std::array<uint8_t, N>& data)
+{
+    return { (const char*)data.data(), data.size() };
+}
+} // namespace
+
+TEST(PytorchPickleTest, Protocol2)
+{
+    testStateDict(toStringView(kProtocol2Pickle));
+}
+
+TEST(PytorchPickleTest, Protocol4)
+{
+    testStateDict(toStringView(kProtocol4Pickle));
+}
+
+TEST(PytorchPickleTest, TextPersistentIdsAreIgnored)
+{
+    std::vector<ZS2_PytorchStorage> storages;
+    ZL_REQUIRE_SUCCESS(
+            parseStorages(storages, toStringView(kProtocol0Pickle)));
+    ASSERT_EQ(storages.size(), 0);
+}
+
+TEST(PytorchPickleTest, NotAStorage)
+{
+    // ('storage', torch.FloatStorage, 0) has an integer key
+    const std::string pkl(
+            "\x80\x02(X\x07\x00\x00\x00storagectorch\nFloatStorage\nK\x00tQ.",
+            40);
+    std::vector<ZS2_PytorchStorage> storages;
+    ZL_REQUIRE_SUCCESS(parseStorages(storages, pkl));
+    ASSERT_EQ(storages.size(), 0);
+}
+
+TEST(PytorchPickleTest, UnknownStorageType)
+{
+    const std::string pkl(
+            "\x80\x02(X\x07\x00\x00\x00storagectorch\nQInt8Storage\n"
+            "X\x01\x00\x00\x00" "0tQ.",
+            44);
+    std::vector<ZS2_PytorchStorage> storages;
+    ZL_REQUIRE_SUCCESS(parseStorages(storages, pkl));
+    ASSERT_EQ(storages.size(), 0);
+}
+
+TEST(PytorchPickleTest, Truncated)
+{
+    const auto pkl = toStringView(kProtocol2Pickle);
+    std::vector<ZS2_PytorchStorage> storages;
+    for (size_t size = 0; size < pkl.size(); ++size) {
+        ASSERT_TRUE(ZL_isError(parseStorages(storages, pkl.substr(0, size))));
+    }
+}
+
+TEST(PytorchPickleTest, Corrupted)
+{
+    std::vector<ZS2_PytorchStorage> storages;
+    // Unknown opcode
+    ASSERT_TRUE(ZL_isError(parseStorages(storages, "\x80\x02\xff.")));
+    // Stack underflow
+    ASSERT_TRUE(ZL_isError(parseStorages(storages, "\x80\x02\x30.")));
+    ASSERT_TRUE(ZL_isError(parseStorages(storages, "\x80\x02(K\x01\x86.")));
+    // Mark underflow
+    ASSERT_TRUE(ZL_isError(parseStorages(storages, "\x80\x02K\x01t.")));
+}
+
+TEST(PytorchPickleTest, TextMemoIndices)
+{
+    std::vector<ZS2_PytorchStorage> storages;
+    ZL_REQUIRE_SUCCESS(parseStorages(storages, "\x80\x02K\x01p12\ng12\n0."));
+    // Empty, non-numeric, and overflowing indices
+    for (const char* pkl : {
+                 "\x80\x02K\x01p\n.",
+                 "\x80\x02K\x01p \n.",
+                 "\x80\x02K\x01p-1\n.",
+                 "\x80\x02K\x01p1x\n.",
+                 "\x80\x02K\x01p99999999999999999999999\n.",
+                 "\x80\x02g\n.",
+                 "\x80\x02g\n1\n.",
+         }) {
+        ASSERT_TRUE(ZL_isError(parseStorages(storages, pkl))) << pkl;
+    }
+}
+
+TEST(PytorchPickleTest, DeepNesting)
+{
+    std::string pkl = "\x80\x02";
+    for (size_t i = 0; i < 1000; ++i) {
+        pkl += "(K\x01";
+    }
+    for (size_t i = 0; i < 1000; ++i) {
+        pkl += "t";
+    }
+    pkl += ".";
+    std::vector<ZS2_PytorchStorage> storages;
+    ASSERT_TRUE(ZL_isError(parseStorages(storages, pkl)));
+}
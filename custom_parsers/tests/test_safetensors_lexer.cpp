@@ -0,0 +1,176 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "custom_parsers/safetensors_lexer.h"
+#include "openzl/common/errors_internal.h"
+
+using namespace ::testing;
+
+namespace {
+std::string makeSafetensors(std::string_view header, size_t dataSize)
+{
+    std::string data;
+    for (size_t i = 0; i < 8; ++i) {
+        data.push_back((char)((header.size() >> (8 * i)) & 0xFF));
+    }
+    data.append(header);
+    data.append(dataSize, 'x');
+    return data;
+}
+
+ZL_Report lex(std::vector<ZS2_SafetensorsTensor>& tensors, std::string_view src)
+{
+    const auto headerSize =
+            ZS2_SafetensorsLexer_headerSize(src.data(), src.size());
+    if (ZL_isError(headerSize)) {
+        return headerSize;
+    }
+    tensors.resize(
+            ZS2_SafetensorsLexer_maxNumTensors(ZL_validResult(headerSize)));
+    const auto report = ZS2_SafetensorsLexer_lex(
+            tensors.data(), tensors.size(), src.data(), src.size());
+    if (!ZL_isError(report)) {
+        tensors.resize(ZL_validResult(report));
+    }
+    return report;
+}
+
+void expectTensor(
+        const ZS2_SafetensorsTensor& tensor,
+        size_t begin,
+        size_t end,
+        ZS2_TensorDType dtype)
+{
+    EXPECT_EQ(tensor.begin, begin);
+    EXPECT_EQ(tensor.end, end);
+    EXPECT_EQ(tensor.dtype, dtype);
+}
+} // namespace
+
+TEST(SafetensorsLexerTest, Basic)
+{
+    const std::string header =
+            R"({"__metadata__":{"format":"pt","nested":{"a":[1,{"b":null}]}},)"
+            R"("b":{"dtype":"BF16","shape":[2,3],"data_offsets":[16,28]},)"
+            R"("a":{"dtype":"F32","shape":[4],"data_offsets":[0,16]},)"
+            R"("c \"quoted\"":{"shape":[],"dtype":"I64",)"
+            R"("data_offsets":[28,36]}})"
+            "    ";
+    const auto src = makeSafetensors(header, 36);
+    ASSERT_TRUE(ZS2_isLikelySafetensorsFile(src.data(), src.size()));
+
+    std::vector<ZS2_SafetensorsTensor> tensors;
+    ZL_REQUIRE_SUCCESS(lex(tensors, src));
+    ASSERT_EQ(tensors.size(), 3);
+    const size_t dataBegin = 8 + header.size();
+    expectTensor(tensors[0], dataBegin, dataBegin + 16, ZS2_TensorDType_F32);
+    expectTensor(
+            tensors[1], dataBegin + 16, dataBegin + 28, ZS2_TensorDType_BF16);
+    expectTensor(
+            tensors[2], dataBegin + 28, dataBegin + 36, ZS2_TensorDType_I64);
+}
+
+TEST(SafetensorsLexerTest, DTypes)
+{
+    const std::vector<std::pair<std::string, ZS2_TensorDType>> dtypes = {
+        { "BOOL", ZS2_TensorDType_Bool }, { "U8", ZS2_TensorDType_U8 },
+        { "I8", ZS2_TensorDType_I8 },     { "I16", ZS2_TensorDType_I16 },
+        { "I32", ZS2_TensorDType_I32 },   { "I64", ZS2_TensorDType_I64 },
+        { "F16", ZS2_TensorDType_F16 },   { "BF16", ZS2_TensorDType_BF16 },
+        { "F32", ZS2_TensorDType_F32 },   { "F64", ZS2_TensorDType_F64 },
+        { "F8_E4M3", ZS2_TensorDType_Unknown },
+    };
+    for (const auto& [name, dtype] : dtypes) {
+        const auto src = makeSafetensors(
+                R"({"t":{"dtype":")" + name
+                        + R"(","shape":[8],"data_offsets":[0,8]}})",
+                8);
+        std::vector<ZS2_SafetensorsTensor> tensors;
+        ZL_REQUIRE_SUCCESS(lex(tensors, src));
+        ASSERT_EQ(tensors.size(), 1);
+        ASSERT_EQ(tensors[0].dtype, dtype) << name;
+    }
+}
+
+TEST(SafetensorsLexerTest, Empty)
+{
+    const auto src = makeSafetensors("{}", 0);
+    std::vector<ZS2_SafetensorsTensor> tensors;
+    ZL_REQUIRE_SUCCESS(lex(tensors, src));
+    ASSERT_EQ(tensors.size(), 0);
+}
+
+TEST(SafetensorsLexerTest, Gaps)
+{
+    // Tensors don't need to cover the whole data section
+    const auto src = makeSafetensors(
+            R"({"a":{"dtype":"U8","data_offsets":[4,8]},)"
+            R"("b":{"dtype":"U8","data_offsets":[8,8]}})",
+            12);
+    std::vector<ZS2_SafetensorsTensor> tensors;
+    ZL_REQUIRE_SUCCESS(lex(tensors, src));
+    ASSERT_EQ(tensors.size(), 2);
+}
+
+TEST(SafetensorsLexerTest, Invalid)
+{
+    const std::vector<std::string> headers = {
+        // Overlapping tensors
+        R"({"a":{"dtype":"U8","data_offsets":[0,8]},)"
+        R"("b":{"dtype":"U8","data_offsets":[4,12]}})",
+        // Out of bounds
+        R"({"a":{"dtype":"U8","data_offsets":[0,17]}})",
+        // Reversed offsets
+        R"({"a":{"dtype":"U8","data_offsets":[8,0]}})",
+        // Negative offsets
+        R"({"a":{"dtype":"U8","data_offsets":[-1,0]}})",
+        // Missing offsets
+        R"({"a":{"dtype":"U8","shape":[0]}})",
+        // Offset overflow
+        R"({"a":{"dtype":"U8","data_offsets":[0,99999999999999999999999]}})",
+        // Truncated
+        R"({"a":{"dtype":"U8","data_offsets":[0,8]})",
+        R"({"a":{"dtype":"U8)",
+        // Trailing bytes
+        R"({"a":{"dtype":"U8","data_offsets":[0,8]}}x)",
+        // Not an object
+        R"({"a":[0,8]})",
+        R"({"a" {"dtype":"U8","data_offsets":[0,8]}})",
+    };
+    for (const auto& header : headers) {
+        const auto src = makeSafetensors(header, 16);
+        std::vector<ZS2_SafetensorsTensor> tensors;
+        ASSERT_TRUE(ZL_isError(lex(tensors, src))) << header;
+    }
+}
+
+TEST(SafetensorsLexerTest, DeepNesting)
+{
+    const std::string header = R"({"__metadata__":)" + std::string(1000, '[')
+            + std::string(1000, ']') + "}";
+    const auto src = makeSafetensors(header, 0);
+    std::vector<ZS2_SafetensorsTensor> tensors;
+    ASSERT_TRUE(ZL_isError(lex(tensors, src)));
+}
+
+TEST(SafetensorsLexerTest, NotSafetensors)
+{
+    const std::string header = R"({"a":{"dtype":"U8","data_offsets":[0,8]}})";
+    auto src                 = makeSafetensors(header, 8);
+    // Header larger than the source
+    src[0] = (char)(header.size() + 9);
+    ASSERT_FALSE(ZS2_isLikelySafetensorsFile(src.data(), src.size()));
+    // Not a JSON object
+    src = makeSafetensors("[]", 8);
+    ASSERT_FALSE(ZS2_isLikelySafetensorsFile(src.data(), src.size()));
+    // Zip file
+    src = std::string("PK\x03\x04", 4) + std::string(100, '\0');
+    ASSERT_FALSE(ZS2_isLikelySafetensorsFile(src.data(), src.size()));
+    ASSERT_FALSE(ZS2_isLikelySafetensorsFile(src.data(), 4));
+}
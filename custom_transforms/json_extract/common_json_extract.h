@@ -55,9 +55,6 @@ inline bool getBit(uint64_t const* bitmask, size_t pos)
  * @param isInSet predicate that tells whether a character in @p src should have
  * the corresponding bit set.
  * @param offset Positions [0, offset) are already set in @p bitmaskA
- * @param extendBlock If set, and the last bit in the bitmask is set, consume
- * bytes in the input until isInSet returns false. This avoids duplicate
- * symbols during encoding.
  *
  * @returns The block of source data that the bitmap covers.
  */
@@ -66,22 +63,16 @@ std::string_view buildBitmaskFallback(
         uint64_t* bitmask,
         std::string_view& src,
         Pred&& isInSet,
-        size_t offset,
-        bool extendBlock = false)
+        size_t offset)
 {
     ZL_ASSERT_LE(offset, src.size());
     ZL_ASSERT_LE(offset, kBlockSize);
-    size_t blockSize = std::min(src.size(), kBlockSize);
+    size_t const blockSize = std::min(src.size(), kBlockSize);
     for (size_t i = offset; i < blockSize; ++i) {
         if (isInSet(src[i])) {
             setBit(bitmask, i);
         }
     }
-    if (extendBlock && blockSize > 0 && getBit(bitmask, blockSize - 1)) {
-        while (blockSize < src.size() && isInSet(src[blockSize])) {
-            ++blockSize;
-        }
-    }
     auto const block = src.substr(0, blockSize);
     src              = src.substr(blockSize);
     return block;
@@ -5,6 +5,7 @@
 #include "openzl/codecs/common/copy.h"
 #include "openzl/common/assertion.h"
 #include "openzl/shared/bits.h"
+#include "openzl/shared/cpu.h"
 #include "openzl/zl_ctransform.h"
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
@@ -17,10 +18,17 @@
 #include <string_view>
 #include <vector>
 
-#ifdef __AVX2__
+#if ZL_CAN_AVX2
 #    include <immintrin.h>
 #endif
 
+#if ZL_ARCH_ARM64 && defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define ZL_JSON_EXTRACT_NEON 1
+#else
+#    define ZL_JSON_EXTRACT_NEON 0
+#endif
+
 namespace zstrong {
 namespace {
 
@@ -155,10 +163,46 @@ class Extracted {
     }
 };
 
+/* The encoder works in two stages, in the style of simdjson:
+ * - Stage 1 classifies 64 bytes at a time with vector lookups (AVX2 or NEON,
+ *   with a scalar fallback), producing bitmasks of the token bytes of each
+ *   block, and of the token bytes that can't be part of an int or a float.
+ *   The token boundaries are then flattened into a tape of positions.
+ * - Stage 2 walks the tape, and dispatches each token to its stream. The
+ *   bitmasks tell whether a token is int-like or float-like, so stage 2 never
+ *   reads the token bytes, except to copy them.
+ * Tokens are the maximal runs of isInSet() characters. Quotes, escapes and
+ * the other structural characters all delimit tokens, so the only state
+ * carried across blocks is whether the previous block ended within a token.
+ */
+
+size_t constexpr kIndexBlockSize = 64;
+/// Number of blocks indexed by stage 1 before stage 2 consumes them
+size_t constexpr kChunkNbBlocks = 64;
+size_t constexpr kChunkSize     = kIndexBlockSize * kChunkNbBlocks;
+
+/// The bitmasks of a chunk, one word per block. Bit i of a word describes
+/// byte i of its block.
+struct ChunkMasks {
+    /// Bytes that are isInSet()
+    uint64_t tokens[kChunkNbBlocks];
+    /// Token bytes that are not isFloatChar()
+    uint64_t notFloat[kChunkNbBlocks];
+    /// Token bytes that are not isIntChar()
+    uint64_t notInt[kChunkNbBlocks];
+};
+
+/// The positions of the token boundaries of a chunk, relative to the chunk,
+/// in increasing order. They alternate between token starts and token ends.
+struct ChunkTape {
+    uint32_t positions[kChunkSize];
+    size_t size;
+};
+
 /// @returns true iff @p c is a character that should be extracted from the
 /// JSON. All characters in this set are extracted from the JSON, without
 /// exception.
-bool isInSet(char c)
+constexpr bool isInSet(char c)
 {
     auto const u = static_cast<uint8_t>(c);
     if (u < 32 || u > 126)
@@ -178,17 +222,36 @@ bool isInSet(char c)
     return true;
 }
 
-#ifdef __AVX2__
+constexpr bool isIntChar(char c)
+{
+    return (c >= '0' && c <= '9') || (c == '-');
+}
+
+constexpr bool isFloatChar(char c)
+{
+    return isIntChar(c) || (c == '+') || (c == '.') || (c == 'e')
+            || (c == 'E');
+}
+
+/// Determines if @p token is likely an integer.
+bool isInt(std::string_view token)
+{
+    return std::all_of(token.begin(), token.end(), isIntChar);
+}
+
+/// Determines if @p token is likely a float.
+bool isFloat(std::string_view token)
+{
+    return std::all_of(token.begin(), token.end(), isFloatChar);
+}
+
+#if ZL_CAN_AVX2 || ZL_JSON_EXTRACT_NEON
 /**
- * Builds a 32-bit bitmask for whether each byte in @p srcV is in @p bitmapV.
- * This is used in several contexts, so the bitmap is variable.
- * This algorithm is based on the universal algorithm describe in:
+ * Bitmaps of the sets of characters, for the vector lookups of stage 1.
+ * This algorithm is based on the universal algorithm described in:
  * http://0x80.pl/articles/simd-byte-lookup.html
- *
- * @param checkMSB If true, then we check that the MSB of each value is 0.
- * Otherwise, we do not check this bit, and assume that it is zero.
- *
- * NOTE: This implementation only works for sets containing characters [0, 128).
+ * It only works for sets containing characters [0, 128), so the MSB of token
+ * bytes is checked separately.
  *
  * Python function to generate a bitmap given a predicate is_in_set():
  *
@@ -204,139 +267,312 @@ bool isInSet(char c)
  *     b_hi = b >> 64
  *     return hex(b_lo).upper(), hex(b_hi).upper()
  */
-ZL_FORCE_INLINE uint32_t
-isInSetV(const __m256i bitmapV, const __m256i srcV, bool checkMSB)
+uint64_t constexpr kTokenBitmapLo = 0xFCFCFCFCFCF8FCFC;
+uint64_t constexpr kTokenBitmapHi = 0x7CFC5CD85CF4FCFC;
+uint64_t constexpr kFloatBitmapLo = 0x808580808080808;
+uint64_t constexpr kFloatBitmapHi = 0x004040004000808;
+uint64_t constexpr kIntBitmapLo   = 0x808080808080808;
+uint64_t constexpr kIntBitmapHi   = 0x000040000000808;
+/// Byte i holds bit (i % 8), to map the high nibble to its bit in the bitmap
+uint64_t constexpr kNibbleBits = 0x8040201008040201;
+#endif
+
+#if ZL_CAN_AVX2
+ZL_TARGET_AVX2_BEGIN
+
+/// @returns the mask of the bytes whose low nibble is @p loV and whose high
+/// nibble selected @p bitV, that are in the set @p bitmapV.
+inline uint32_t lookupAvx2(__m256i bitmapV, __m256i loV, __m256i bitV)
 {
-    __m256i const loV     = _mm256_and_si256(srcV, _mm256_set1_epi8(0x0F));
     __m256i const bitsetV = _mm256_shuffle_epi8(bitmapV, loV);
+    __m256i const maskV =
+            _mm256_cmpeq_epi8(_mm256_and_si256(bitsetV, bitV), bitV);
+    return (uint32_t)_mm256_movemask_epi8(maskV);
+}
 
-    __m256i const hiV = _mm256_and_si256(
-            _mm256_srli_epi16(srcV, 4), _mm256_set1_epi8(0x0F));
-    __m256i const bitmaskV =
-            _mm256_shuffle_epi8(_mm256_set1_epi64x(0x8040201008040201), hiV);
-
-    __m256i maskV =
-            _mm256_cmpeq_epi8(_mm256_and_si256(bitsetV, bitmaskV), bitmaskV);
-    if (checkMSB) {
-        maskV = _mm256_and_si256(
-                maskV, _mm256_cmpgt_epi8(_mm256_set1_epi8(0x08), hiV));
+void classifyBlocksAvx2(
+        ChunkMasks& masks,
+        size_t first,
+        char const* src,
+        size_t nbBlocks)
+{
+    __m256i const tokenV = _mm256_setr_epi64x(
+            (long long)kTokenBitmapLo,
+            (long long)kTokenBitmapHi,
+            (long long)kTokenBitmapLo,
+            (long long)kTokenBitmapHi);
+    __m256i const floatV = _mm256_setr_epi64x(
+            (long long)kFloatBitmapLo,
+            (long long)kFloatBitmapHi,
+            (long long)kFloatBitmapLo,
+            (long long)kFloatBitmapHi);
+    __m256i const intV = _mm256_setr_epi64x(
+            (long long)kIntBitmapLo,
+            (long long)kIntBitmapHi,
+            (long long)kIntBitmapLo,
+            (long long)kIntBitmapHi);
+    __m256i const nibbleBitsV = _mm256_set1_epi64x((long long)kNibbleBits);
+    __m256i const nibbleV     = _mm256_set1_epi8(0x0F);
+    for (size_t b = 0; b < nbBlocks; ++b) {
+        uint64_t tokens = 0;
+        uint64_t floats = 0;
+        uint64_t ints   = 0;
+        for (size_t i = 0; i < 2; ++i) {
+            __m256i const srcV = _mm256_loadu_si256(
+                    (__m256i const*)(src + b * kIndexBlockSize + 32 * i));
+            __m256i const loV = _mm256_and_si256(srcV, nibbleV);
+            __m256i const hiV =
+                    _mm256_and_si256(_mm256_srli_epi16(srcV, 4), nibbleV);
+            __m256i const bitV  = _mm256_shuffle_epi8(nibbleBitsV, hiV);
+            uint32_t const nonAscii = (uint32_t)_mm256_movemask_epi8(srcV);
+            tokens |= (uint64_t)(lookupAvx2(tokenV, loV, bitV) & ~nonAscii)
+                    << (32 * i);
+            floats |= (uint64_t)lookupAvx2(floatV, loV, bitV) << (32 * i);
+            ints |= (uint64_t)lookupAvx2(intV, loV, bitV) << (32 * i);
+        }
+        masks.tokens[first + b]   = tokens;
+        masks.notFloat[first + b] = tokens & ~floats;
+        masks.notInt[first + b]   = tokens & ~ints;
     }
+}
 
-    return (uint32_t)_mm256_movemask_epi8(maskV);
+ZL_TARGET_END
+#endif
+
+#if ZL_JSON_EXTRACT_NEON
+/// @returns the bytes whose low nibble is @p loV and whose high nibble
+/// selected @p bitV, that are in the set @p bitmapV.
+ZL_FORCE_INLINE uint8x16_t
+lookupNeon(uint8x16_t bitmapV, uint8x16_t loV, uint8x16_t bitV)
+{
+    return vtstq_u8(vqtbl1q_u8(bitmapV, loV), bitV);
 }
 
-/**
- * Determines if every character in @p token is in the set defined by @p
- * bitmapV.
- *
- * WARNING: Assumes it is safe to access up to 32-bytes beyond token.end().
- */
-ZL_FORCE_INLINE bool isTokenInSet(__m256i const bitmapV, std::string_view token)
+/// @returns the 64-bit mask of the MSBs of @p m, whose bytes are 0 or 0xFF.
+ZL_FORCE_INLINE uint64_t movemaskNeon(uint8x16_t const m[4])
 {
-    size_t const size = alignUp(token.size(), 32);
-    ZL_ASSERT_GE(size, 32);
-
-    size_t i;
-    for (i = 0; ZL_UNLIKELY(i + 32 < size); i += 32) {
-        uint32_t const mask = isInSetV(
-                bitmapV,
-                _mm256_loadu_si256((__m256i_u*)(token.data() + i)),
-                /* checkMSB */ false);
-        if (~mask) {
-            return false;
+    uint8x16_t const bitsV = vreinterpretq_u8_u64(vdupq_n_u64(kNibbleBits));
+    uint8x16_t const sum0 =
+            vpaddq_u8(vandq_u8(m[0], bitsV), vandq_u8(m[1], bitsV));
+    uint8x16_t const sum1 =
+            vpaddq_u8(vandq_u8(m[2], bitsV), vandq_u8(m[3], bitsV));
+    uint8x16_t sum = vpaddq_u8(sum0, sum1);
+    sum            = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+
+void classifyBlocksNeon(
+        ChunkMasks& masks,
+        size_t first,
+        char const* src,
+        size_t nbBlocks)
+{
+    uint8x16_t const tokenV = vreinterpretq_u8_u64(vcombine_u64(
+            vcreate_u64(kTokenBitmapLo), vcreate_u64(kTokenBitmapHi)));
+    uint8x16_t const floatV = vreinterpretq_u8_u64(vcombine_u64(
+            vcreate_u64(kFloatBitmapLo), vcreate_u64(kFloatBitmapHi)));
+    uint8x16_t const intV = vreinterpretq_u8_u64(vcombine_u64(
+            vcreate_u64(kIntBitmapLo), vcreate_u64(kIntBitmapHi)));
+    uint8x16_t const nibbleBitsV =
+            vreinterpretq_u8_u64(vdupq_n_u64(kNibbleBits));
+    uint8x16_t const nibbleV = vdupq_n_u8(0x0F);
+    uint8x16_t const msbV    = vdupq_n_u8(0x80);
+    for (size_t b = 0; b < nbBlocks; ++b) {
+        uint8x16_t tokens[4];
+        uint8x16_t floats[4];
+        uint8x16_t ints[4];
+        for (size_t i = 0; i < 4; ++i) {
+            uint8x16_t const srcV = vld1q_u8(
+                    (uint8_t const*)src + b * kIndexBlockSize + 16 * i);
+            uint8x16_t const loV = vandq_u8(srcV, nibbleV);
+            uint8x16_t const bitV =
+                    vqtbl1q_u8(nibbleBitsV, vshrq_n_u8(srcV, 4));
+            uint8x16_t const asciiV = vcltq_u8(srcV, msbV);
+            tokens[i] = vandq_u8(lookupNeon(tokenV, loV, bitV), asciiV);
+            floats[i] = lookupNeon(floatV, loV, bitV);
+            ints[i]   = lookupNeon(intV, loV, bitV);
         }
+        uint64_t const tokenMask  = movemaskNeon(tokens);
+        masks.tokens[first + b]   = tokenMask;
+        masks.notFloat[first + b] = tokenMask & ~movemaskNeon(floats);
+        masks.notInt[first + b]   = tokenMask & ~movemaskNeon(ints);
     }
-    uint32_t const mask = isInSetV(
-            bitmapV,
-            _mm256_loadu_si256((__m256i_u*)(token.data() + i)),
-            /* checkMSB */ false);
-    if (~mask << (size - token.size())) {
-        return false;
+}
+#endif
+
+enum : uint8_t {
+    kTokenByte    = 1,
+    kNotFloatByte = 2,
+    kNotIntByte   = 4,
+};
+
+struct ByteClasses {
+    uint8_t classes[256];
+};
+
+constexpr ByteClasses makeByteClasses()
+{
+    ByteClasses table{};
+    for (size_t i = 0; i < 256; ++i) {
+        char const c = char(i);
+        if (isInSet(c)) {
+            table.classes[i] = kTokenByte;
+            if (!isFloatChar(c)) {
+                table.classes[i] |= kNotFloatByte;
+            }
+            if (!isIntChar(c)) {
+                table.classes[i] |= kNotIntByte;
+            }
+        }
     }
-    return true;
+    return table;
 }
 
-#endif
+constexpr ByteClasses kByteClasses = makeByteClasses();
 
-/// Determines of @p token is likely an integer.
-/// WARNING: If kFast we assume we can access up to 32 bytes beyond token.end()
-template <bool kFast>
-ZL_FORCE_INLINE bool isInt(std::string_view token)
+void classifyBlocksScalar(
+        ChunkMasks& masks,
+        size_t first,
+        char const* src,
+        size_t nbBlocks)
 {
-#ifdef __AVX2__
-    if constexpr (kFast) {
-        uint64_t const kBitsetLo = 0x808080808080808;
-        uint64_t const kBitsetHi = 0x000040000000808;
-        __m256i const kBitmapV =
-                _mm256_setr_epi64x(kBitsetLo, kBitsetHi, kBitsetLo, kBitsetHi);
-        return isTokenInSet(kBitmapV, token);
+    for (size_t b = 0; b < nbBlocks; ++b) {
+        uint64_t tokens   = 0;
+        uint64_t notFloat = 0;
+        uint64_t notInt   = 0;
+        for (size_t i = 0; i < kIndexBlockSize; ++i) {
+            uint64_t const c =
+                    kByteClasses
+                            .classes[(uint8_t)src[b * kIndexBlockSize + i]];
+            tokens |= (c & 1) << i;
+            notFloat |= ((c >> 1) & 1) << i;
+            notInt |= ((c >> 2) & 1) << i;
+        }
+        masks.tokens[first + b]   = tokens;
+        masks.notFloat[first + b] = notFloat;
+        masks.notInt[first + b]   = notInt;
     }
-#endif
-    return std::all_of(token.begin(), token.end(), [](char c) {
-        return (c >= '0' && c <= '9') || (c == '-');
-    });
 }
 
-/// Determines of @p token is likely a float.
-/// WARNING: If kFast we assume we can access up to 32 bytes beyond token.end()
-template <bool kFast>
-ZL_FORCE_INLINE bool isFloat(std::string_view token)
+/// Fills blocks [first, first + nbBlocks) of @p masks, from the blocks in
+/// @p src.
+void classifyBlocks(
+        ChunkMasks& masks,
+        size_t first,
+        char const* src,
+        size_t nbBlocks)
 {
-#ifdef __AVX2__
-    if constexpr (kFast) {
-        uint64_t const kBitsetLo = 0x808580808080808;
-        uint64_t const kBitsetHi = 0x004040004000808;
-        __m256i const kBitmapV =
-                _mm256_setr_epi64x(kBitsetLo, kBitsetHi, kBitsetLo, kBitsetHi);
-        return isTokenInSet(kBitmapV, token);
+#if ZL_JSON_EXTRACT_NEON
+    if (ZL_cpuHas(ZL_CpuFeature_neon)) {
+        classifyBlocksNeon(masks, first, src, nbBlocks);
+        return;
     }
 #endif
-    return std::all_of(token.begin(), token.end(), [](char c) {
-        return (c >= '0' && c <= '9') || (c == '+') || (c == '-') || (c == '.')
-                || (c == 'e') || (c == 'E');
-    });
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        classifyBlocksAvx2(masks, first, src, nbBlocks);
+        return;
+    }
+#endif
+    classifyBlocksScalar(masks, first, src, nbBlocks);
 }
 
-/// Equivalent to buildBitmaskFallback(bitmask, src, isInSet, 0, true).
-ZL_FORCE_NOINLINE std::string_view buildBitmask(
-        uint64_t* bitmask,
-        std::string_view& src)
+/**
+ * Stage 1: classifies the @p size bytes of @p chunk into @p masks, and
+ * flattens its token boundaries into @p tape.
+ *
+ * @param inToken Whether the byte before @p chunk is part of a token. Updated
+ * to whether the last byte of @p chunk is part of a token.
+ */
+ZL_FORCE_NOINLINE void indexChunk(
+        ChunkMasks& masks,
+        ChunkTape& tape,
+        uint64_t& inToken,
+        char const* chunk,
+        size_t size)
 {
-    std::fill(bitmask, bitmask + kBitmaskSize, 0);
-    size_t blockSize = 0;
-#ifdef __AVX2__
-    blockSize = alignDown(std::min(src.size(), kBlockSize), 32);
-
-    uint32_t* bitmask32 = (uint32_t*)bitmask;
-
-    uint64_t const kBitsetLo = 0xFCFCFCFCFCF8FCFC;
-    uint64_t const kBitsetHi = 0x7CFC5CD85CF4FCFC;
-    __m256i const kBitmapV =
-            _mm256_setr_epi64x(kBitsetLo, kBitsetHi, kBitsetLo, kBitsetHi);
-
-    for (size_t i = 0, o = 0; i < blockSize; i += 32, ++o) {
-        __m256i const srcV =
-                _mm256_loadu_si256((const __m256i_u*)(src.data() + i));
-        uint32_t const mask = isInSetV(kBitmapV, srcV, /* checkMSB */ true);
-        bitmask32[o]        = mask;
+    ZL_ASSERT(size <= kChunkSize);
+    size_t const nbFull = size / kIndexBlockSize;
+    classifyBlocks(masks, 0, chunk, nbFull);
+    size_t nbBlocks = nbFull;
+    if (size % kIndexBlockSize != 0) {
+        // The padding is not part of any token, so the last token ends at the
+        // end of the input.
+        char tail[kIndexBlockSize] = {};
+        std::memcpy(
+                tail,
+                chunk + nbFull * kIndexBlockSize,
+                size % kIndexBlockSize);
+        classifyBlocks(masks, nbFull, tail, 1);
+        ++nbBlocks;
     }
-#endif
 
-    return buildBitmaskFallback(
-            bitmask, src, isInSet, blockSize, /* extendBlock */ true);
+    uint32_t* out  = tape.positions;
+    uint64_t carry = inToken;
+    for (size_t b = 0; b < nbBlocks; ++b) {
+        uint64_t const tokens = masks.tokens[b];
+        uint64_t bounds       = tokens ^ ((tokens << 1) | carry);
+        carry                 = tokens >> 63;
+
+        uint32_t const base  = uint32_t(b * kIndexBlockSize);
+        uint32_t* const last = out + ZL_popcount64(bounds);
+        while (out + 4 <= last) {
+            out[0] = base + (uint32_t)ZL_ctz64(bounds);
+            bounds &= bounds - 1;
+            out[1] = base + (uint32_t)ZL_ctz64(bounds);
+            bounds &= bounds - 1;
+            out[2] = base + (uint32_t)ZL_ctz64(bounds);
+            bounds &= bounds - 1;
+            out[3] = base + (uint32_t)ZL_ctz64(bounds);
+            bounds &= bounds - 1;
+            out += 4;
+        }
+        for (; out < last; ++out) {
+            *out = base + (uint32_t)ZL_ctz64(bounds);
+            bounds &= bounds - 1;
+        }
+    }
+    tape.size = size_t(out - tape.positions);
+    inToken   = carry;
+}
+
+/// @returns true iff none of the bits [begin, end) of @p mask are set.
+ZL_FORCE_INLINE bool noneInRange(uint64_t const* mask, size_t begin, size_t end)
+{
+    ZL_ASSERT_LT(begin, end);
+    size_t idx        = begin / kIndexBlockSize;
+    size_t const last = (end - 1) / kIndexBlockSize;
+    uint64_t bits     = mask[idx] >> (begin % kIndexBlockSize);
+    for (; idx < last; ++idx) {
+        if (bits != 0) {
+            return false;
+        }
+        bits = mask[idx + 1];
+        begin = (idx + 1) * kIndexBlockSize;
+    }
+    size_t const width = end - begin;
+    if (width < 64) {
+        bits &= (uint64_t(1) << width) - 1;
+    }
+    return bits == 0;
 }
 
 /// Given a token, in which every character isInSet, determine which stream to
 /// dispatch it to.
 /// WARNING: If kFast we assume we can access up to 32 bytes beyond token.end()
 template <bool kFast>
-ZL_FORCE_INLINE Token
-dispatchToken(Extracted& extracted, std::string_view token)
+ZL_FORCE_INLINE Token dispatchToken(
+        Extracted& extracted,
+        std::string_view token,
+        bool floatLike,
+        bool intLike)
 {
     ZL_ASSERT(std::all_of(token.begin(), token.end(), isInSet));
+    ZL_ASSERT_EQ(floatLike, isFloat(token));
+    ZL_ASSERT(!floatLike || intLike == isInt(token));
     Token out;
-    if (isFloat<kFast>(token)) {
-        if (isInt<kFast>(token)) {
+    if (floatLike) {
+        if (intLike) {
             extracted.pushInt<kFast>(token);
             out = Token::INT;
         } else {
@@ -358,18 +594,17 @@ dispatchToken(Extracted& extracted, std::string_view token)
 }
 
 /**
- * Given the @p bitmask describing whether each char in @p src isInSet, locate
- * each token and extract it using @p dispatchToken.
+ * Stage 2: extracts every token of @p src, indexing it one chunk at a time.
  */
-ZL_FORCE_NOINLINE void extractTokens(
-        Extracted& extracted,
-        std::string_view src,
-        uint64_t const* bitmask)
+ZL_FORCE_NOINLINE void extractTokens(Extracted& extracted, std::string_view src)
 {
-    size_t idx           = 0;
-    int64_t mask         = (int64_t)bitmask[idx];
-    uint32_t skipped     = 0;
+    ChunkMasks masks;
+    ChunkTape tape;
+    uint64_t inToken = 0;
+    // End of the previous token, where the next JSON content starts
     char const* tokenEnd = src.data();
+    // Start of a token that spans the end of the previous chunk, if any
+    char const* spanning = nullptr;
     Token prev           = Token(0);
     char const* fastEnd;
     if (src.size() > 32) {
@@ -377,73 +612,72 @@ ZL_FORCE_NOINLINE void extractTokens(
     } else {
         fastEnd = src.data();
     }
-    for (;;) {
-        while (mask == 0) {
-            // Mask has no remaining tokens => go to the next mask
-            ++idx;
-            if (idx == kBitmaskSize) {
-                // Push the final JSON
-                extracted.pushJson<false>(
-                        std::string_view{ tokenEnd, src.end() });
-                goto end;
-            }
-            mask    = (int64_t)bitmask[idx];
-            skipped = 0;
-        }
-        ZL_ASSERT_NE(mask, 0);
-
-        // Skip to the start of the token
-        {
-            auto const toSkip = countFirstZeros(mask);
-            mask              = skipN(mask, toSkip);
-            skipped += toSkip;
-            ZL_ASSERT_LT(skipped, 64);
-        }
 
-        char const* const start = src.data() + idx * 64 + skipped;
-
-        while (~mask == 0) {
-            // The token extends byeond the current mask
-            ++idx;
-            if (idx == kBitmaskSize) {
-                extracted.pushJson<false>(std::string_view{ tokenEnd, start });
-                // The token extends to the end of the input
-                dispatchToken<false>(
-                        extracted, std::string_view{ start, src.end() });
-                goto end;
-            }
-            mask    = (int64_t)bitmask[idx];
-            skipped = 0;
-        }
-        ZL_ASSERT_NE(~mask, 0);
-
-        // Skip to the end of the token
-        {
-            auto const toSkip = countFirstZeros(~mask);
-            mask              = skipN(mask, toSkip);
-            skipped += toSkip;
-            ZL_ASSERT_LE(skipped, 64);
-        }
+    // Tokens spanning chunks are classified from their content
+    auto const pushSpanning = [&](char const* end) {
+        std::string_view const token{ spanning, size_t(end - spanning) };
+        extracted.pushJson<false>(std::string_view{ tokenEnd, spanning });
+        bool const floatLike = isFloat(token);
+        dispatchToken<false>(
+                extracted, token, floatLike, floatLike && isInt(token));
+        tokenEnd = end;
+        spanning = nullptr;
+        prev     = Token(0);
+    };
 
-        char const* end = src.data() + idx * 64 + skipped;
-        Token next;
-        if (end < fastEnd) {
-            extracted.pushJson<true>(std::string_view{ tokenEnd, start });
-            next = dispatchToken<true>(
-                    extracted, std::string_view{ start, end });
-        } else {
-            extracted.pushJson<false>(std::string_view{ tokenEnd, start });
-            next = dispatchToken<false>(
-                    extracted, std::string_view{ start, end });
+    for (size_t pos = 0; pos < src.size(); pos += kChunkSize) {
+        char const* const chunk = src.data() + pos;
+        indexChunk(
+                masks,
+                tape,
+                inToken,
+                chunk,
+                std::min(src.size() - pos, kChunkSize));
+
+        size_t i = 0;
+        if (spanning != nullptr) {
+            if (tape.size == 0) {
+                // The token spans the whole chunk
+                continue;
+            }
+            pushSpanning(chunk + tape.positions[0]);
+            i = 1;
         }
+        for (; i + 1 < tape.size; i += 2) {
+            uint32_t const begin    = tape.positions[i];
+            uint32_t const end      = tape.positions[i + 1];
+            char const* const start = chunk + begin;
+            std::string_view const token{ start, size_t(end - begin) };
+            bool const floatLike = noneInRange(masks.notFloat, begin, end);
+            bool const intLike =
+                    floatLike && noneInRange(masks.notInt, begin, end);
+            Token next;
+            if (token.end() < fastEnd) {
+                extracted.pushJson<true>(std::string_view{ tokenEnd, start });
+                next = dispatchToken<true>(
+                        extracted, token, floatLike, intLike);
+            } else {
+                extracted.pushJson<false>(
+                        std::string_view{ tokenEnd, start });
+                next = dispatchToken<false>(
+                        extracted, token, floatLike, intLike);
+            }
 
-        ZL_ASSERT(!(prev == next && tokenEnd == start));
-        prev = next;
+            ZL_ASSERT(!(prev == next && tokenEnd == start));
+            prev = next;
 
-        tokenEnd = end;
+            tokenEnd = token.end();
+        }
+        if (i < tape.size) {
+            spanning = chunk + tape.positions[i];
+        }
     }
-end:
-    ZL_ASSERT_EQ(idx, kBitmaskSize);
+    if (spanning != nullptr) {
+        // The token extends to the end of the input
+        pushSpanning(src.end());
+    }
+    // Push the final JSON
+    extracted.pushJson<false>(std::string_view{ tokenEnd, src.end() });
 }
 
 void validateExtraction(Extracted const& extracted)
@@ -471,13 +705,8 @@ ZL_Report jsonExtractEncode(ZL_Encoder* eictx, const ZL_Input* input) noexcept
     std::string_view src{ (char const*)ZL_Input_ptr(input),
                           ZL_Input_numElts(input) };
 
-    std::array<uint64_t, kBitmaskSize> bitmask;
     Extracted extracted(eictx, src);
-
-    while (!src.empty()) {
-        auto const block = buildBitmask(bitmask.data(), src);
-        extractTokens(extracted, block, bitmask.data());
-    }
+    extractTokens(extracted, src);
     validateExtraction(extracted);
 
     ZL_RET_R_IF_ERR(extracted.commit());
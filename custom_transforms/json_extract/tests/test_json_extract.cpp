@@ -10,6 +10,7 @@
 #include "custom_transforms/json_extract/decode_json_extract.h"
 #include "custom_transforms/json_extract/encode_json_extract.h"
 #include "custom_transforms/json_extract/tests/json_extract_test_data.h"
+#include "openzl/shared/cpu.h"
 #include "tools/zstrong_cpp.h"
 
 using namespace ::testing;
@@ -113,5 +114,57 @@ TEST(TestJsonExtract, JsonLikeData)
     }
 }
 
+TEST(TestJsonExtract, ChunkBoundaries)
+{
+    // Tokens starting, ending, and spanning across the 64-byte blocks and the
+    // 4KiB chunks of the structural index.
+    for (size_t const size : { 63, 64, 65, 4095, 4096, 4097, 12288, 12290 }) {
+        for (size_t const gap : { 1, 2, 31, 64, 65, 4096, 5000 }) {
+            std::string data;
+            data.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                data.push_back(i % gap == gap - 1 ? ',' : "12a"[i / gap % 3]);
+            }
+            testRoundTripJson(data);
+            data.back() = '"';
+            testRoundTripJson(data);
+        }
+    }
+}
+
+TEST(TestJsonExtract, ScalarMatchesVector)
+{
+#if ZL_ARCH_ARM64 && defined(__ARM_NEON)
+    // The vector path must actually run on arm64
+    ASSERT_TRUE(ZL_cpuHas(ZL_CpuFeature_neon));
+#endif
+    std::mt19937 gen(0xdeadbeef);
+    std::uniform_int_distribution<size_t> sizeDist(0, 65536);
+    std::string const alphabet = "\"\\,:[]{} \t0123456789-+.eEtruefalsn\x80";
+    std::uniform_int_distribution<size_t> charDist(0, alphabet.size() - 1);
+    for (size_t i = 0; i < 20; ++i) {
+        auto const size = sizeDist(gen);
+        std::string data;
+        data.reserve(size);
+        for (size_t j = 0; j < size; ++j) {
+            data.push_back(alphabet[charDist(gen)]);
+        }
+        for (auto const& input : { data, genJsonLikeData(gen, size) }) {
+            ZL_cpuFeatures_setMask(0);
+            auto const scalar = compressJson(input);
+            // Each vector classifier on its own: AVX2 on x86-64, NEON on arm64
+            for (unsigned const mask : { (unsigned)ZL_CpuFeature_avx2,
+                                         (unsigned)ZL_CpuFeature_neon,
+                                         (unsigned)ZL_CPU_FEATURES_ALL }) {
+                ZL_cpuFeatures_setMask(mask);
+                auto const vector = compressJson(input);
+                ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+                EXPECT_EQ(scalar, vector) << "cpu features mask " << mask;
+                EXPECT_EQ(decompressJson(vector), input);
+            }
+        }
+    }
+}
+
 } // namespace
 } // namespace zstrong::tests
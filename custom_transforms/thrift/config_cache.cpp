@@ -0,0 +1,103 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "custom_transforms/thrift/config_cache.h" // @manual
+
+#include <algorithm>
+#include <new>
+
+namespace zstrong::thrift {
+namespace {
+// Nodes cloned with distinct configs all share the cache of their codec.
+// Beyond this many configs, the oldest one is evicted.
+constexpr size_t kMaxCachedConfigs = 8;
+
+bool samePaths(
+        const std::map<ThriftPath, PathInfo>& lhs,
+        const std::map<ThriftPath, PathInfo>& rhs)
+{
+    return std::equal(
+            lhs.begin(),
+            lhs.end(),
+            rhs.begin(),
+            rhs.end(),
+            [](const auto& l, const auto& r) {
+                return l.first == r.first && l.second.id == r.second.id
+                        && l.second.type == r.second.type;
+            });
+}
+
+template <typename Slots>
+void makeRoom(Slots& slots)
+{
+    if (slots.size() >= kMaxCachedConfigs) {
+        slots.erase(slots.begin());
+    }
+}
+} // namespace
+
+const CompiledPaths& EncoderConfigCache::Entry::paths(
+        unsigned int formatVersion)
+{
+    if (paths_ == nullptr || pathsFormatVersion_ != formatVersion) {
+        paths_ = std::make_unique<const CompiledPaths>(config_, formatVersion);
+        pathsFormatVersion_ = formatVersion;
+    }
+    return *paths_;
+}
+
+EncoderConfigCache::Entry& EncoderConfigCache::get(
+        std::string_view serializedConfig)
+{
+    for (const auto& slot : slots_) {
+        if (slot.serializedConfig == serializedConfig) {
+            return *slot.entry;
+        }
+    }
+    auto entry = std::make_unique<Entry>(serializedConfig);
+    makeRoom(slots_);
+    slots_.push_back(
+            Slot{ std::string(serializedConfig), std::move(entry) });
+    return *slots_.back().entry;
+}
+
+const CompiledPaths& DecoderPathsCache::get(
+        const DecoderConfig& config,
+        unsigned int formatVersion)
+{
+    for (const auto& slot : slots_) {
+        if (slot.formatVersion == formatVersion
+            && slot.rootType == config.getRootType()
+            && samePaths(slot.pathMap, config.pathMap())) {
+            return *slot.paths;
+        }
+    }
+    auto paths = std::make_unique<const CompiledPaths>(config, formatVersion);
+    makeRoom(slots_);
+    slots_.push_back(Slot{ formatVersion,
+                           config.getRootType(),
+                           config.pathMap(),
+                           std::move(paths) });
+    return *slots_.back().paths;
+}
+
+void* createEncoderConfigCache() noexcept
+{
+    return new (std::nothrow) EncoderConfigCache();
+}
+
+void freeEncoderConfigCache(void* state) noexcept
+{
+    delete static_cast<EncoderConfigCache*>(state);
+}
+
+void* createDecoderPathsCache() noexcept
+{
+    return new (std::nothrow) DecoderPathsCache();
+}
+
+void freeDecoderPathsCache(void* state) noexcept
+{
+    delete static_cast<DecoderPathsCache*>(state);
+}
+
+} // namespace zstrong::thrift
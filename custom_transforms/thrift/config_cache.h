@@ -0,0 +1,97 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "custom_transforms/thrift/parse_config.h" // @manual
+#include "custom_transforms/thrift/path_tracker.h" // @manual
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zstrong::thrift {
+
+/**
+ * Caches the configs parsed by the Thrift encoders, along with their paths
+ * compiled for the PathTracker, so that repeated compressions with the same
+ * config skip both. It lives in the codec state of a CCtx, and holds a few
+ * configs at once since every clone of a Thrift node shares the same state.
+ */
+class EncoderConfigCache {
+   public:
+    class Entry {
+       public:
+        explicit Entry(std::string_view serializedConfig)
+                : config_(serializedConfig)
+        {
+        }
+
+        const EncoderConfig& config() const
+        {
+            return config_;
+        }
+
+        /// @returns The config's paths, compiled on first use
+        /// @throws if the paths are invalid for @p formatVersion.
+        const CompiledPaths& paths(unsigned int formatVersion);
+
+       private:
+        const EncoderConfig config_;
+        unsigned int pathsFormatVersion_{ 0 };
+        std::unique_ptr<const CompiledPaths> paths_;
+    };
+
+    /**
+     * @returns The entry for @p serializedConfig, parsing it on a cache miss.
+     * The entry stays valid until the next call.
+     * @throws if the config is invalid.
+     */
+    Entry& get(std::string_view serializedConfig);
+
+   private:
+    struct Slot {
+        std::string serializedConfig;
+        std::unique_ptr<Entry> entry;
+    };
+
+    std::vector<Slot> slots_;
+};
+
+/**
+ * Caches the paths compiled by the Thrift decoders. The decoder config is
+ * transported in each frame along with its original size, so the cache is
+ * keyed on the paths of the config instead of its serialization.
+ */
+class DecoderPathsCache {
+   public:
+    /**
+     * @returns The paths compiled from @p config, which stay valid until the
+     * next call.
+     * @throws if the config is invalid.
+     */
+    const CompiledPaths& get(
+            const DecoderConfig& config,
+            unsigned int formatVersion);
+
+   private:
+    struct Slot {
+        unsigned int formatVersion;
+        TType rootType;
+        std::map<ThriftPath, PathInfo> pathMap;
+        std::unique_ptr<const CompiledPaths> paths;
+    };
+
+    std::vector<Slot> slots_;
+};
+
+/// Codec state callbacks managing an EncoderConfigCache
+void* createEncoderConfigCache() noexcept;
+void freeEncoderConfigCache(void* state) noexcept;
+
+/// Codec state callbacks managing a DecoderPathsCache
+void* createDecoderPathsCache() noexcept;
+void freeDecoderPathsCache(void* state) noexcept;
+
+} // namespace zstrong::thrift
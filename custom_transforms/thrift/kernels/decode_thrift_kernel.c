@@ -60,6 +60,42 @@ ZS2_ThriftKernel_serializeI32(uint32_t val, uint8_t** op, uint8_t* oend)
     return ZS2_ThriftKernel_serializeLength(zz, op, oend);
 }
 
+/* Worst case sizes of the compact encoding of each value */
+#define ZS2_THRIFT_KERNEL_I32_MAX_SIZE ZL_VARINT_LENGTH_32
+#define ZS2_THRIFT_KERNEL_I64_MAX_SIZE ZL_VARINT_LENGTH_64
+#define ZS2_THRIFT_KERNEL_FLOAT_SIZE 4
+
+/* Returns whether @p nbElts values of at most @p eltMaxSize bytes each fit in
+ * [op, oend), including the slack overwritten by the fast varint encoders.
+ * When they do, the values are serialized without per-value bounds checks.
+ */
+ZL_FORCE_INLINE int ZS2_ThriftKernel_fitsWorstCase(
+        uint8_t const* op,
+        uint8_t const* oend,
+        size_t nbElts,
+        size_t eltMaxSize)
+{
+    size_t const capacity = (size_t)(oend - op);
+    if (capacity < ZL_VARINT_FAST_OVERWRITE_64) {
+        return 0;
+    }
+    return nbElts <= (capacity - ZL_VARINT_FAST_OVERWRITE_64) / eltMaxSize;
+}
+
+ZL_FORCE_INLINE void ZS2_ThriftKernel_serializeI64Unchecked(
+        uint64_t val,
+        uint8_t** op)
+{
+    *op += ZL_varintEncode64Fast(ZS2_ThriftKernel_zigzagEncode64(val), *op);
+}
+
+ZL_FORCE_INLINE void ZS2_ThriftKernel_serializeI32Unchecked(
+        uint32_t val,
+        uint8_t** op)
+{
+    *op += ZL_varintEncode32Fast(ZS2_ThriftKernel_zigzagEncode32(val), *op);
+}
+
 ZL_FORCE_INLINE ZL_Report ZS2_ThriftKernel_serializeMapHeader(
         uint8_t** op,
         uint8_t* oend,
@@ -109,6 +145,15 @@ ZL_FORCE_INLINE ZL_Report ZS2_ThriftKernel_serializeArrayI64_inline(
     ZL_RET_R_IF_ERR(
             ZS2_ThriftKernel_serializeArrayHeader(op, oend, 0x6, arraySize));
 
+    if (ZS2_ThriftKernel_fitsWorstCase(
+                *op, oend, arraySize, ZS2_THRIFT_KERNEL_I64_MAX_SIZE)) {
+        for (size_t i = 0; i < arraySize; ++i) {
+            ZS2_ThriftKernel_serializeI64Unchecked(values[i], op);
+        }
+        ZL_ASSERT_LE(*op, oend);
+        return ZL_returnSuccess();
+    }
+
     for (size_t i = 0; i < arraySize; ++i) {
         ZL_RET_R_IF_ERR(ZS2_ThriftKernel_serializeI64(values[i], op, oend));
     }
@@ -130,7 +175,21 @@ ZL_Report ZS2_ThriftKernel_serializeMapI32Float(
     ZL_RET_R_IF_ERR(
             ZS2_ThriftKernel_serializeMapHeader(&op, oend, 0x5, 0xD, mapSize));
 
-    // TODO: Unroll to remove bounds checks, speed up varint encoding
+    if (ZS2_ThriftKernel_fitsWorstCase(
+                op,
+                oend,
+                mapSize,
+                ZS2_THRIFT_KERNEL_I32_MAX_SIZE
+                        + ZS2_THRIFT_KERNEL_FLOAT_SIZE)) {
+        for (size_t i = 0; i < mapSize; ++i) {
+            ZS2_ThriftKernel_serializeI32Unchecked(keys[i], &op);
+            ZL_writeBE32(op, floats[i]);
+            op += 4;
+        }
+        ZL_ASSERT_LE(op, oend);
+        return ZL_returnValue((size_t)(op - ostart));
+    }
+
     for (size_t i = 0; i < mapSize; ++i) {
         ZL_RET_R_IF_ERR(ZS2_ThriftKernel_serializeI32(keys[i], &op, oend));
         ZL_RET_R_IF_GT(internalBuffer_tooSmall, 4, (size_t)(oend - op));
@@ -291,12 +350,28 @@ ZL_Report ZS2_ThriftKernel_serializeMapI32MapI64Float(
                 srcSize_tooSmall,
                 innerMapSize,
                 (size_t)(innerKeysEnd - *innerKeysPtr));
-        for (size_t j = 0; j < innerMapSize; ++j) {
-            ZL_RET_R_IF_ERR(ZS2_ThriftKernel_serializeI64(
-                    (*innerKeysPtr)[j], &op, oend));
-            ZL_RET_R_IF_GT(internalBuffer_tooSmall, 4, (size_t)(oend - op));
-            ZL_writeBE32(op, (*innerValuesPtr)[j]);
-            op += 4;
+        if (ZS2_ThriftKernel_fitsWorstCase(
+                    op,
+                    oend,
+                    innerMapSize,
+                    ZS2_THRIFT_KERNEL_I64_MAX_SIZE
+                            + ZS2_THRIFT_KERNEL_FLOAT_SIZE)) {
+            for (size_t j = 0; j < innerMapSize; ++j) {
+                ZS2_ThriftKernel_serializeI64Unchecked(
+                        (*innerKeysPtr)[j], &op);
+                ZL_writeBE32(op, (*innerValuesPtr)[j]);
+                op += 4;
+            }
+            ZL_ASSERT_LE(op, oend);
+        } else {
+            for (size_t j = 0; j < innerMapSize; ++j) {
+                ZL_RET_R_IF_ERR(ZS2_ThriftKernel_serializeI64(
+                        (*innerKeysPtr)[j], &op, oend));
+                ZL_RET_R_IF_GT(
+                        internalBuffer_tooSmall, 4, (size_t)(oend - op));
+                ZL_writeBE32(op, (*innerValuesPtr)[j]);
+                op += 4;
+            }
         }
         *innerKeysPtr += innerMapSize;
         *innerValuesPtr += innerMapSize;
@@ -336,6 +411,15 @@ ZL_Report ZS2_ThriftKernel_serializeArrayI32(
     ZL_RET_R_IF_ERR(
             ZS2_ThriftKernel_serializeArrayHeader(&op, oend, 0x5, arraySize));
 
+    if (ZS2_ThriftKernel_fitsWorstCase(
+                op, oend, arraySize, ZS2_THRIFT_KERNEL_I32_MAX_SIZE)) {
+        for (size_t i = 0; i < arraySize; ++i) {
+            ZS2_ThriftKernel_serializeI32Unchecked(values[i], &op);
+        }
+        ZL_ASSERT_LE(op, oend);
+        return ZL_returnValue((size_t)(op - ostart));
+    }
+
     for (size_t i = 0; i < arraySize; ++i) {
         ZL_RET_R_IF_ERR(ZS2_ThriftKernel_serializeI32(values[i], &op, oend));
     }
@@ -56,6 +56,14 @@ TEST(ThriftKernelTest, ArrayI64)
         ASSERT_EQ(ZL_validResult(ret), out.size());
 
         ASSERT_EQ(folly::crange(out), data);
+
+        // Room for the worst case serializes without per-value bounds checks
+        std::vector<uint8_t> large(16 + 10 * extracted.size());
+        ret = ZS2_ThriftKernel_serializeArrayI64(
+                large.data(), large.size(), extracted.data(), extracted.size());
+        ASSERT_FALSE(ZL_isError(ret));
+        ASSERT_EQ(ZL_validResult(ret), data.size());
+        ASSERT_EQ(folly::crange(large).subpiece(0, data.size()), data);
     };
 
     testRoundTrip({});
@@ -98,6 +106,14 @@ TEST(ThriftKernelTest, ArrayI32)
         ASSERT_EQ(ZL_validResult(ret), out.size());
 
         ASSERT_EQ(folly::crange(out), data);
+
+        // Room for the worst case serializes without per-value bounds checks
+        std::vector<uint8_t> large(16 + 5 * extracted.size());
+        ret = ZS2_ThriftKernel_serializeArrayI32(
+                large.data(), large.size(), extracted.data(), extracted.size());
+        ASSERT_FALSE(ZL_isError(ret));
+        ASSERT_EQ(ZL_validResult(ret), data.size());
+        ASSERT_EQ(folly::crange(large).subpiece(0, data.size()), data);
     };
 
     testRoundTrip({});
@@ -204,6 +220,18 @@ TEST(ThriftKernelTest, MapI32Float)
         ASSERT_EQ(ZL_validResult(ret), out.size());
 
         ASSERT_EQ(folly::crange(out), data);
+
+        // Room for the worst case serializes without per-value bounds checks
+        std::vector<uint8_t> large(16 + 9 * keys.size());
+        ret = ZS2_ThriftKernel_serializeMapI32Float(
+                large.data(),
+                large.size(),
+                keys.data(),
+                values.data(),
+                keys.size());
+        ASSERT_FALSE(ZL_isError(ret));
+        ASSERT_EQ(ZL_validResult(ret), data.size());
+        ASSERT_EQ(folly::crange(large).subpiece(0, data.size()), data);
     };
 
     testRoundTrip({});
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 namespace zstrong::thrift {
 namespace detail {
 constexpr std::string_view kOldStyleVsfErrorMsg =
@@ -10,25 +12,21 @@ constexpr std::string_view kOldStyleVsfErrorMsg =
         "as string data and lengths are combined in a single stream of type ZL_Type_string.";
 } // namespace detail
 
-/*********************
- * PathTracker::Node *
- *********************/
-
-template <typename StreamSetType>
-class PathTracker<StreamSetType>::Node {
-   private:
-    static constexpr size_t kVecSlots = 1024;
+/***********************
+ * CompiledPaths::Node *
+ ***********************/
 
+class CompiledPaths::Node {
    public:
     explicit Node(
-            const PathTracker& pt,
             ThriftNodeId id,
             TType type,
-            Stream* stream)
+            const Fallbacks& fallbacks,
+            uint32_t slot)
             : id_(id),
               type_(coerceType(type)),
-              fallbacks_(pt.fallbacks_),
-              stream_(stream)
+              fallbacks_(fallbacks),
+              slot_(slot)
     {
     }
 
@@ -42,6 +40,28 @@ class PathTracker<StreamSetType>::Node {
         return type_;
     }
 
+    /// @returns The slot of the node's stream, 0 if it has no stream
+    uint32_t slot() const
+    {
+        return slot_;
+    }
+
+    /// @returns The configured field with the lowest id, or nullptr
+    const Node* firstField() const
+    {
+        return firstField_;
+    }
+
+    /**
+     * @returns The configured field of the parent struct following this one
+     * in id order, wrapping around to the first field. Returns nullptr for
+     * nodes which are not struct fields, including fallbacks.
+     */
+    const Node* nextField() const
+    {
+        return nextField_;
+    }
+
     static bool isInlinedId(ThriftNodeId id)
     {
         bool const isInlined = id == ThriftNodeId::kMapKey
@@ -63,29 +83,7 @@ class PathTracker<StreamSetType>::Node {
             TType type) const;
 
     /// @returns The ThriftNodeId::kLengths child node or fallback
-    ZL_FORCE_INLINE_ATTR const Node& lengths() const
-    {
-        if (lengths_ != nullptr) {
-            // Already validated the type by construction in addChild().
-            assert((lengths_->checkType(TType::T_U32), true));
-            return *lengths_;
-        } else {
-            return fallbacks_.lengths;
-        }
-    }
-
-    Stream& getStream() const
-    {
-        if (stream_ == NULL) {
-            throw std::runtime_error("Tried to get NULL stream from Node!");
-        }
-        return *stream_;
-    }
-
-    bool hasStream() const
-    {
-        return stream_ != nullptr;
-    }
+    ZL_FORCE_INLINE_ATTR const Node& lengths() const;
 
     /// @returns The ThriftNodeId::kMapKey child node or fallback
     ZL_FORCE_INLINE_ATTR const Node& mapKey(TType type) const
@@ -106,15 +104,17 @@ class PathTracker<StreamSetType>::Node {
     }
 
     /// @returns The ThriftNodeId::kStop child node
-    const Node& stop() const
-    {
-        return fallbacks_.thriftTypes[static_cast<size_t>(TType::T_STOP)];
-    }
+    const Node& stop() const;
+
+    ZL_FORCE_INLINE_ATTR void checkType(TType t) const;
+
+   private:
+    friend class CompiledPaths;
 
-    /// Used during graph construction only, can be called on any id
+    /// Used during compilation only, can be called on any id
     Node* child(ThriftNodeId id);
 
-    /// Used during graph construction only, can be called on any id
+    /// Used during compilation only, can be called on any id
     void addChild(ThriftNodeId id, Node& child);
 
     void setType(TType type)
@@ -122,72 +122,99 @@ class PathTracker<StreamSetType>::Node {
         type_ = coerceType(type);
     }
 
-    ZL_FORCE_INLINE_ATTR void checkType(TType t) const;
-
-    void setStream(Stream* stream)
-    {
-        if constexpr (std::is_same_v<StreamSetType, WriteStreamSet>) {
-            // TODO: if type() is added to ReadStream, remove "if constexpr"
-            assert(type_ == stream->type());
-        }
-        stream_ = stream;
-    }
-
-   private:
     ZL_FORCE_INLINE_ATTR const Node& checkedNodeOrFallback(
             const Node* node,
-            TType type) const
-    {
-        if (node != nullptr) {
-            node->checkType(type);
-            return *node;
-        } else {
-            auto& fallback = fallbacks_.thriftTypes[static_cast<size_t>(type)];
-            assert((fallback.checkType(type), true));
-            return fallback;
-        }
-    }
+            TType type) const;
+
+    const Node* findSparse(ThriftNodeId id) const;
 
     const ThriftNodeId id_;
     TType type_;
-    folly::F14FastMap<ThriftNodeId, Node*> childrenMap_;
-    std::vector<Node*> children_;
-    const PathTracker::Fallbacks& fallbacks_;
-    Stream* stream_;
+    const Fallbacks& fallbacks_;
+    uint32_t slot_;
+
+    // Jump table of the children with ids in [minId_, minId_ + tableSize_)
+    const Node* const* table_{ nullptr };
+    int64_t minId_{ 0 };
+    uint64_t tableSize_{ 0 };
+    // Children outside of the jump table, sorted by id
+    std::vector<std::pair<ThriftNodeId, const Node*>> sparse_;
+    // Children by id, only used during compilation
+    std::map<ThriftNodeId, Node*> children_;
+
+    const Node* firstField_{ nullptr };
+    const Node* nextField_{ nullptr };
     Node* lengths_{ nullptr };
     Node* mapKey_{ nullptr };
     Node* mapValue_{ nullptr };
     Node* listElem_{ nullptr };
 };
 
-template <typename StreamSetType>
-const typename PathTracker<StreamSetType>::Node& PathTracker<
-        StreamSetType>::Node::childOrFallback(ThriftNodeId id, TType type) const
+/****************************
+ * CompiledPaths::Fallbacks *
+ ****************************/
+
+struct CompiledPaths::Fallbacks {
+    static constexpr size_t kArraySize =
+            static_cast<size_t>(TType::T_FLOAT) + 1;
+
+    explicit Fallbacks(CompiledPaths& paths);
+
+    std::array<Node, kArraySize> thriftTypes;
+    Node lengths;
+};
+
+inline const CompiledPaths::Node& CompiledPaths::Node::childOrFallback(
+        ThriftNodeId id,
+        TType type) const
 {
     assert(!isInlinedId(id));
-    auto idx          = static_cast<size_t>(id);
+    const auto idx =
+            static_cast<uint64_t>(static_cast<int64_t>(id) - minId_);
     const Node* child = nullptr;
-    if (idx < kVecSlots) {
-        if (children_.size() > idx) {
-            child = children_[idx];
-        }
-        if (child == nullptr) {
-            child = &fallbacks_.thriftTypes[static_cast<size_t>(type)];
-        }
-    } else {
-        auto it = childrenMap_.find(id);
-        if (it == childrenMap_.end()) {
-            child = &fallbacks_.thriftTypes[static_cast<size_t>(type)];
-        } else {
-            child = it->second;
-        }
+    if (idx < tableSize_) {
+        child = table_[idx];
+    } else if (!sparse_.empty()) {
+        child = findSparse(id);
+    }
+    if (child == nullptr) {
+        child = &fallbacks_.thriftTypes[static_cast<size_t>(type)];
     }
     child->checkType(type);
     return *child;
 }
 
-template <typename StreamSetType>
-void PathTracker<StreamSetType>::Node::checkType(TType t) const
+inline const CompiledPaths::Node& CompiledPaths::Node::lengths() const
+{
+    if (lengths_ != nullptr) {
+        // Already validated the type by construction in addChild().
+        assert((lengths_->checkType(TType::T_U32), true));
+        return *lengths_;
+    } else {
+        return fallbacks_.lengths;
+    }
+}
+
+inline const CompiledPaths::Node& CompiledPaths::Node::stop() const
+{
+    return fallbacks_.thriftTypes[static_cast<size_t>(TType::T_STOP)];
+}
+
+inline const CompiledPaths::Node& CompiledPaths::Node::checkedNodeOrFallback(
+        const Node* node,
+        TType type) const
+{
+    if (node != nullptr) {
+        node->checkType(type);
+        return *node;
+    } else {
+        auto& fallback = fallbacks_.thriftTypes[static_cast<size_t>(type)];
+        assert((fallback.checkType(type), true));
+        return fallback;
+    }
+}
+
+inline void CompiledPaths::Node::checkType(TType t) const
 {
     t = coerceType(t);
     if (t != type()) {
@@ -201,91 +228,58 @@ void PathTracker<StreamSetType>::Node::checkType(TType t) const
     }
 }
 
+/**************************
+ * PathTracker::Iterator  *
+ **************************/
+
 template <typename StreamSetType>
-typename PathTracker<StreamSetType>::Node*
-PathTracker<StreamSetType>::Node::child(ThriftNodeId id)
+PathTracker<StreamSetType>::Iterator::Iterator(
+        const Iterator* parent,
+        const Node& node,
+        ThriftNodeId id,
+        TType type,
+        size_t depth,
+        Stream* const* streams)
+        : parent_(parent),
+          node_(node),
+          id_(id),
+          type_(type),
+          depth_(depth),
+          streams_(streams),
+          expectedField_(node.firstField())
 {
-    if (id == ThriftNodeId::kMapKey) {
-        return mapKey_;
-    }
-    if (id == ThriftNodeId::kMapValue) {
-        return mapValue_;
-    }
-    if (id == ThriftNodeId::kListElem) {
-        return listElem_;
-    }
-    if (id == ThriftNodeId::kLength) {
-        return lengths_;
-    } else if (id == ThriftNodeId::kStop) {
-        throw std::runtime_error{
-            "kStop should never be used in a Thrift config path"
-        };
-    }
-    assert(!isInlinedId(id));
-    auto idx = static_cast<size_t>(id);
-    if (idx < kVecSlots) {
-        if (children_.size() <= idx) {
-            return nullptr;
-        }
-        return children_[idx];
-    } else {
-        auto it = childrenMap_.find(id);
-        if (it == childrenMap_.end()) {
-            return nullptr;
-        }
-        return it->second;
+    if (depth_ > kMaxThriftDepth) {
+        throw std::runtime_error("Exceeded maximum thrift recursion depth!");
     }
 }
 
 template <typename StreamSetType>
-void PathTracker<StreamSetType>::Node::addChild(ThriftNodeId id, Node& child)
+typename PathTracker<StreamSetType>::Stream&
+PathTracker<StreamSetType>::Iterator::stream() const
 {
-    if (id == ThriftNodeId::kMapKey) {
-        mapKey_ = &child;
-    } else if (id == ThriftNodeId::kMapValue) {
-        mapValue_ = &child;
-    } else if (id == ThriftNodeId::kListElem) {
-        listElem_ = &child;
-    } else if (id == ThriftNodeId::kLength) {
-        lengths_ = &child;
-        // Enforce that the type of the lengths field is always T_U32.
-        // Otherwise an invalid config could set the type of kLengths
-        // to something else. Setting this here lets us assume that the
-        // type of lengths_ is always T_U32, so we don't need to check
-        // it during (un)parsing.
-        if (lengths_->type_ != TType::T_U32) {
-            assert(lengths_->type() == TType::T_VOID);
-            lengths_->setType(TType::T_U32);
-        }
-    } else if (id == ThriftNodeId::kStop) {
-        throw std::runtime_error{
-            "kStop should never be used in a Thrift config path"
-        };
-    } else {
-        assert(!isInlinedId(id));
-        auto idx = static_cast<size_t>(id);
-        if (idx < kVecSlots) {
-            if (children_.size() <= idx) {
-                children_.resize(idx + 1);
-            }
-            children_[idx] = &child;
-        } else {
-            childrenMap_.emplace(id, &child);
-        }
+    Stream* const stream = streams_[node_.slot()];
+    if (stream == nullptr) {
+        throw std::runtime_error("Tried to get NULL stream from Node!");
     }
+    return *stream;
 }
 
-/**************************
- * PathTracker::Iterator  *
- **************************/
-
 template <typename StreamSetType>
 typename PathTracker<StreamSetType>::Iterator
 PathTracker<StreamSetType>::Iterator::child(ThriftNodeId id, TType type) const
 {
-    assert(!node_.isInlinedId(id));
-    const auto& c = node_.childOrFallback(id, type);
-    return Iterator(this, c, id, type, depth_ + 1);
+    assert(!Node::isInlinedId(id));
+    const Node* c = expectedField_;
+    if (c != nullptr && c->id() == id) {
+        c->checkType(type);
+    } else {
+        c = &node_.childOrFallback(id, type);
+    }
+    // Unknown fields leave the expectation untouched
+    if (c->nextField() != nullptr) {
+        expectedField_ = c->nextField();
+    }
+    return Iterator(this, *c, id, type, depth_ + 1, streams_);
 }
 
 template <typename StreamSetType>
@@ -297,7 +291,8 @@ PathTracker<StreamSetType>::Iterator::lengths() const
             node_.lengths(),
             ThriftNodeId::kLength,
             TType::T_U32,
-            depth_ + 1);
+            depth_ + 1,
+            streams_);
 }
 
 template <typename StreamSetType>
@@ -305,7 +300,12 @@ typename PathTracker<StreamSetType>::Iterator
 PathTracker<StreamSetType>::Iterator::mapKey(TType type) const
 {
     return Iterator(
-            this, node_.mapKey(type), ThriftNodeId::kMapKey, type, depth_ + 1);
+            this,
+            node_.mapKey(type),
+            ThriftNodeId::kMapKey,
+            type,
+            depth_ + 1,
+            streams_);
 }
 
 template <typename StreamSetType>
@@ -317,7 +317,8 @@ PathTracker<StreamSetType>::Iterator::mapValue(TType type) const
             node_.mapValue(type),
             ThriftNodeId::kMapValue,
             type,
-            depth_ + 1);
+            depth_ + 1,
+            streams_);
 }
 
 template <typename StreamSetType>
@@ -329,7 +330,8 @@ PathTracker<StreamSetType>::Iterator::listElem(TType type) const
             node_.listElem(type),
             ThriftNodeId::kListElem,
             type,
-            depth_ + 1);
+            depth_ + 1,
+            streams_);
 }
 
 template <typename StreamSetType>
@@ -337,7 +339,12 @@ typename PathTracker<StreamSetType>::Iterator
 PathTracker<StreamSetType>::Iterator::stop() const
 {
     return Iterator(
-            this, node_.stop(), ThriftNodeId::kStop, TType::T_STOP, depth_ + 1);
+            this,
+            node_.stop(),
+            ThriftNodeId::kStop,
+            TType::T_STOP,
+            depth_ + 1,
+            streams_);
 }
 
 template <typename StreamSetType>
@@ -357,146 +364,79 @@ std::string PathTracker<StreamSetType>::Iterator::pathStr() const
     return pathToStr(path());
 }
 
-/**************************
- * PathTracker::Fallbacks *
- **************************/
-
-template <typename StreamSetType>
-struct PathTracker<StreamSetType>::Fallbacks {
-    using StreamSet = PathTracker<StreamSetType>::StreamSet;
-
-    static constexpr size_t kArraySize =
-            static_cast<size_t>(TType::T_FLOAT) + 1;
-
-    static std::array<Node, kArraySize> makeThriftTypes(
-            const PathTracker& pt,
-            StreamSet& ss)
-    {
-        static const std::map<TType, SingletonId> stream_map = {
-            { TType::T_BOOL, SingletonId::kBool },
-            { TType::T_BYTE, SingletonId::kInt8 },
-            { TType::T_I16, SingletonId::kInt16 },
-            { TType::T_I32, SingletonId::kInt32 },
-            { TType::T_I64, SingletonId::kInt64 },
-            { TType::T_FLOAT, SingletonId::kFloat32 },
-            { TType::T_DOUBLE, SingletonId::kFloat64 },
-            { TType::T_STRING, SingletonId::kBinary },
-        };
-        const auto id = static_cast<ThriftNodeId>(0);
-
-        auto makeNode = [&](size_t i) {
-            const auto type  = static_cast<TType>(i);
-            auto streamIdIt  = stream_map.find(type);
-            auto streamIdOpt = streamIdIt != stream_map.end()
-                    ? std::optional<SingletonId>(streamIdIt->second)
-                    : std::nullopt;
-            auto stream = streamIdOpt ? &ss.getStream(*streamIdOpt) : nullptr;
-            return Node(pt, id, type, stream);
-        };
-
-        auto makeNodes = [&]<size_t... I>(auto& make, std::index_sequence<I...>)
-                -> std::array<Node, kArraySize> { return { { make(I)... } }; };
-
-        return makeNodes(makeNode, std::make_index_sequence<kArraySize>{});
-    }
-
-    Fallbacks(const PathTracker& pt, const BaseConfig& config, StreamSet& ss)
-            : thriftTypes(makeThriftTypes(pt, ss)),
-              lengths(pt,
-                      ThriftNodeId::kLength,
-                      TType::T_U32,
-                      &ss.getStream(SingletonId::kLengths))
-    {
-        (void)config;
-    }
-
-    std::array<Node, kArraySize> thriftTypes;
-    Node lengths;
-};
-
 /***********************
  * PathTracker Methods *
  ***********************/
 
 template <typename StreamSetType>
-TType PathTracker<StreamSetType>::coerceType(TType type)
+PathTracker<StreamSetType>::PathTracker(
+        const BaseConfig& config,
+        StreamSet& ss,
+        unsigned int formatVersion)
+        : ownedPaths_(std::make_unique<CompiledPaths>(config, formatVersion)),
+          paths_(*ownedPaths_),
+          streams_(bindStreams(paths_, ss)),
+          rootIt_(nullptr,
+                  paths_.root(),
+                  paths_.root().id(),
+                  paths_.root().type(),
+                  0,
+                  streams_.data())
 {
-    if (type == TType::T_SET) {
-        // lists and sets are equivalent, reduce one into the other.
-        type = TType::T_LIST;
-    }
-    return type;
 }
 
 template <typename StreamSetType>
-void PathTracker<StreamSetType>::addStringLengthsNode(
-        Node& stringDataNode,
-        const LogicalId id)
+PathTracker<StreamSetType>::PathTracker(
+        const CompiledPaths& paths,
+        StreamSet& ss)
+        : paths_(paths),
+          streams_(bindStreams(paths_, ss)),
+          rootIt_(nullptr,
+                  paths_.root(),
+                  paths_.root().id(),
+                  paths_.root().type(),
+                  0,
+                  streams_.data())
 {
-    if (stringDataNode.child(ThriftNodeId::kLength) != nullptr) {
-        throw std::runtime_error{ fmt::format(
-                "Attempting to add two length nodes to the same string node! {}",
-                detail::kOldStyleVsfErrorMsg) };
-    }
-    auto stream = &ss_.getStringLengthStream(id);
-    auto node   = std::make_unique<Node>(
-            *this, ThriftNodeId::kLength, TType::T_U32, stream);
-    stringDataNode.addChild(ThriftNodeId::kLength, *node);
-    nodes_.push_back(std::move(node));
 }
 
 template <typename StreamSetType>
-void PathTracker<StreamSetType>::fillGraph(const unsigned int formatVersion)
+std::vector<typename PathTracker<StreamSetType>::Stream*>
+PathTracker<StreamSetType>::bindStreams(
+        const CompiledPaths& paths,
+        StreamSet& ss)
 {
-    for (const auto& [path, info] : config_.pathMap()) {
-        Node* cur = &root_;
-        for (const auto id : path) {
-            Node* next = cur->child(id);
-            // TODO: do better job guessing / inferring type.
-            TType type = TType::T_VOID;
-            if (id == ThriftNodeId::kMapKey || id == ThriftNodeId::kMapValue) {
-                type = TType::T_MAP;
-            } else if (id == ThriftNodeId::kListElem) {
-                // could also be a set but we treat them as equivalent
-                type = TType::T_LIST;
-            } else if (!isSpecialId(id)) {
-                type = TType::T_STRUCT;
-            }
-            if (type != TType::T_VOID) {
-                if (cur->type() == TType::T_VOID) {
-                    cur->setType(type);
-                } else {
-                    cur->checkType(type);
+    using Kind = CompiledPaths::StreamRef::Kind;
+    std::vector<Stream*> streams;
+    streams.reserve(paths.slots().size());
+    for (const auto& ref : paths.slots()) {
+        switch (ref.kind) {
+            case Kind::kNone:
+                streams.push_back(nullptr);
+                break;
+            case Kind::kSingleton:
+                streams.push_back(
+                        &ss.getStream(static_cast<SingletonId>(ref.id)));
+                break;
+            case Kind::kLogical: {
+                auto& stream = ss.getStream(static_cast<LogicalId>(ref.id));
+                if constexpr (std::is_same_v<StreamSetType, WriteStreamSet>) {
+                    // TODO: if type() is added to ReadStream, remove "if
+                    // constexpr"
+                    assert(ref.type == stream.type());
                 }
+                streams.push_back(&stream);
+                break;
             }
-            if (next == nullptr) {
-                auto node = std::make_unique<Node>(
-                        *this, id, TType::T_VOID, nullptr);
-                next = node.get();
-                cur->addChild(id, *next);
-                nodes_.push_back(std::move(node));
-            }
-            cur = next;
-        }
-
-        if (formatVersion >= kMinFormatVersionStringVSF) {
-            if (cur->hasStream()) {
-                throw std::runtime_error{ fmt::format(
-                        "Attempting to set two different streams on the same node! {}",
-                        detail::kOldStyleVsfErrorMsg) };
-            }
-            if (info.type == TType::T_STRING) {
-                addStringLengthsNode(*cur, info.id);
-            }
-        }
-
-        auto stream = &ss_.getStream(info.id);
-        if (cur->type() != TType::T_VOID) {
-            cur->checkType(info.type);
+            case Kind::kStringLengths:
+                streams.push_back(&ss.getStringLengthStream(
+                        static_cast<LogicalId>(ref.id)));
+                break;
+            default:
+                throw std::runtime_error{ "Unknown stream slot kind!" };
         }
-        cur->setType(info.type);
-        cur->setStream(stream);
     }
+    return streams;
 }
 
 } // namespace zstrong::thrift
@@ -0,0 +1,310 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "custom_transforms/thrift/path_tracker.h" // @manual
+
+#include <algorithm>
+#include <optional>
+
+namespace zstrong::thrift {
+namespace {
+// Field ids are only laid out in a jump table when it is dense enough, other
+// fields are found by binary search.
+constexpr int64_t kMinJumpTableSize       = 64;
+constexpr int64_t kJumpTableSlotsPerField = 4;
+
+using Kind = CompiledPaths::StreamRef::Kind;
+
+template <typename Make, size_t... I>
+auto makeNodes(Make&& make, std::index_sequence<I...>)
+        -> std::array<decltype(make(0)), sizeof...(I)>
+{
+    return { { make(I)... } };
+}
+} // namespace
+
+/****************************
+ * CompiledPaths::Fallbacks *
+ ****************************/
+
+CompiledPaths::Fallbacks::Fallbacks(CompiledPaths& paths)
+        : thriftTypes(makeNodes(
+                  [&](size_t i) {
+                      static const std::map<TType, SingletonId> stream_map = {
+                          { TType::T_BOOL, SingletonId::kBool },
+                          { TType::T_BYTE, SingletonId::kInt8 },
+                          { TType::T_I16, SingletonId::kInt16 },
+                          { TType::T_I32, SingletonId::kInt32 },
+                          { TType::T_I64, SingletonId::kInt64 },
+                          { TType::T_FLOAT, SingletonId::kFloat32 },
+                          { TType::T_DOUBLE, SingletonId::kFloat64 },
+                          { TType::T_STRING, SingletonId::kBinary },
+                      };
+                      const auto id   = static_cast<ThriftNodeId>(0);
+                      const auto type = static_cast<TType>(i);
+                      auto streamIdIt = stream_map.find(type);
+                      uint32_t slot   = 0;
+                      if (streamIdIt != stream_map.end()) {
+                          slot = paths.addSlot(
+                                  Kind::kSingleton,
+                                  static_cast<uint32_t>(streamIdIt->second),
+                                  type);
+                      }
+                      return Node(id, type, *this, slot);
+                  },
+                  std::make_index_sequence<kArraySize>{})),
+          lengths(ThriftNodeId::kLength,
+                  TType::T_U32,
+                  *this,
+                  paths.addSlot(
+                          Kind::kSingleton,
+                          static_cast<uint32_t>(SingletonId::kLengths),
+                          TType::T_U32))
+{
+}
+
+/***********************
+ * CompiledPaths::Node *
+ ***********************/
+
+CompiledPaths::Node* CompiledPaths::Node::child(ThriftNodeId id)
+{
+    if (id == ThriftNodeId::kMapKey) {
+        return mapKey_;
+    }
+    if (id == ThriftNodeId::kMapValue) {
+        return mapValue_;
+    }
+    if (id == ThriftNodeId::kListElem) {
+        return listElem_;
+    }
+    if (id == ThriftNodeId::kLength) {
+        return lengths_;
+    } else if (id == ThriftNodeId::kStop) {
+        throw std::runtime_error{
+            "kStop should never be used in a Thrift config path"
+        };
+    }
+    assert(!isInlinedId(id));
+    auto it = children_.find(id);
+    if (it == children_.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void CompiledPaths::Node::addChild(ThriftNodeId id, Node& child)
+{
+    if (id == ThriftNodeId::kMapKey) {
+        mapKey_ = &child;
+    } else if (id == ThriftNodeId::kMapValue) {
+        mapValue_ = &child;
+    } else if (id == ThriftNodeId::kListElem) {
+        listElem_ = &child;
+    } else if (id == ThriftNodeId::kLength) {
+        lengths_ = &child;
+        // Enforce that the type of the lengths field is always T_U32.
+        // Otherwise an invalid config could set the type of kLengths
+        // to something else. Setting this here lets us assume that the
+        // type of lengths_ is always T_U32, so we don't need to check
+        // it during (un)parsing.
+        if (lengths_->type_ != TType::T_U32) {
+            assert(lengths_->type() == TType::T_VOID);
+            lengths_->setType(TType::T_U32);
+        }
+    } else if (id == ThriftNodeId::kStop) {
+        throw std::runtime_error{
+            "kStop should never be used in a Thrift config path"
+        };
+    } else {
+        assert(!isInlinedId(id));
+        children_.emplace(id, &child);
+    }
+}
+
+const CompiledPaths::Node* CompiledPaths::Node::findSparse(
+        ThriftNodeId id) const
+{
+    auto it = std::lower_bound(
+            sparse_.begin(),
+            sparse_.end(),
+            id,
+            [](const auto& child, ThriftNodeId key) {
+                return child.first < key;
+            });
+    if (it == sparse_.end() || it->first != id) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+/*************************
+ * CompiledPaths Methods *
+ *************************/
+
+CompiledPaths::CompiledPaths(
+        const BaseConfig& config,
+        const unsigned int formatVersion)
+{
+    // Slot 0 is the absence of stream
+    slots_.push_back({ Kind::kNone, 0, TType::T_VOID });
+    fallbacks_ = std::make_unique<const Fallbacks>(*this);
+    root_      = std::make_unique<Node>(
+            ThriftNodeId::kRoot, config.getRootType(), *fallbacks_, 0);
+    fillGraph(config, formatVersion);
+    compile();
+}
+
+CompiledPaths::~CompiledPaths() = default;
+
+uint32_t
+CompiledPaths::addSlot(StreamRef::Kind kind, uint32_t id, TType type)
+{
+    slots_.push_back({ kind, id, type });
+    return static_cast<uint32_t>(slots_.size() - 1);
+}
+
+void CompiledPaths::addStringLengthsNode(
+        Node& stringDataNode,
+        const LogicalId id)
+{
+    if (stringDataNode.child(ThriftNodeId::kLength) != nullptr) {
+        throw std::runtime_error{ fmt::format(
+                "Attempting to add two length nodes to the same string node! {}",
+                detail::kOldStyleVsfErrorMsg) };
+    }
+    const uint32_t slot = addSlot(
+            Kind::kStringLengths, static_cast<uint32_t>(id), TType::T_U32);
+    auto node = std::make_unique<Node>(
+            ThriftNodeId::kLength, TType::T_U32, *fallbacks_, slot);
+    stringDataNode.addChild(ThriftNodeId::kLength, *node);
+    nodes_.push_back(std::move(node));
+}
+
+void CompiledPaths::fillGraph(
+        const BaseConfig& config,
+        const unsigned int formatVersion)
+{
+    for (const auto& [path, info] : config.pathMap()) {
+        Node* cur = root_.get();
+        for (const auto id : path) {
+            Node* next = cur->child(id);
+            // TODO: do better job guessing / inferring type.
+            TType type = TType::T_VOID;
+            if (id == ThriftNodeId::kMapKey || id == ThriftNodeId::kMapValue) {
+                type = TType::T_MAP;
+            } else if (id == ThriftNodeId::kListElem) {
+                // could also be a set but we treat them as equivalent
+                type = TType::T_LIST;
+            } else if (!isSpecialId(id)) {
+                type = TType::T_STRUCT;
+            }
+            if (type != TType::T_VOID) {
+                if (cur->type() == TType::T_VOID) {
+                    cur->setType(type);
+                } else {
+                    cur->checkType(type);
+                }
+            }
+            if (next == nullptr) {
+                auto node = std::make_unique<Node>(
+                        id, TType::T_VOID, *fallbacks_, 0);
+                next = node.get();
+                cur->addChild(id, *next);
+                nodes_.push_back(std::move(node));
+            }
+            cur = next;
+        }
+
+        if (formatVersion >= kMinFormatVersionStringVSF) {
+            if (cur->slot() != 0) {
+                throw std::runtime_error{ fmt::format(
+                        "Attempting to set two different streams on the same node! {}",
+                        detail::kOldStyleVsfErrorMsg) };
+            }
+            if (info.type == TType::T_STRING) {
+                addStringLengthsNode(*cur, info.id);
+            }
+        }
+
+        if (cur->type() != TType::T_VOID) {
+            cur->checkType(info.type);
+        }
+        cur->setType(info.type);
+        cur->slot_ = addSlot(
+                Kind::kLogical, static_cast<uint32_t>(info.id), cur->type());
+    }
+}
+
+void CompiledPaths::compile()
+{
+    std::vector<Node*> nodes;
+    nodes.reserve(nodes_.size() + 1);
+    nodes.push_back(root_.get());
+    for (const auto& node : nodes_) {
+        nodes.push_back(node.get());
+    }
+
+    // Size every jump table first: nodes point into table_, which must not
+    // reallocate afterwards.
+    std::vector<size_t> offsets(nodes.size());
+    size_t tableSize = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        Node& node = *nodes[i];
+        std::optional<int64_t> minId;
+        int64_t maxId    = 0;
+        int64_t nbFields = 0;
+        for (const auto& [id, child] : node.children_) {
+            if (isSpecialId(id)) {
+                continue;
+            }
+            const auto fieldId = static_cast<int64_t>(id);
+            minId              = minId.value_or(fieldId);
+            maxId              = fieldId;
+            ++nbFields;
+        }
+        offsets[i] = tableSize;
+        if (minId.has_value()) {
+            const int64_t span = maxId - *minId + 1;
+            if (span <= kMinJumpTableSize
+                || span <= kJumpTableSlotsPerField * nbFields) {
+                node.minId_     = *minId;
+                node.tableSize_ = static_cast<uint64_t>(span);
+                tableSize += node.tableSize_;
+            }
+        }
+    }
+    table_.assign(tableSize, nullptr);
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        Node& node  = *nodes[i];
+        node.table_ = table_.data() + offsets[i];
+        Node* prevField = nullptr;
+        for (const auto& [id, child] : node.children_) {
+            const auto idx = static_cast<uint64_t>(
+                    static_cast<int64_t>(id) - node.minId_);
+            if (!isSpecialId(id) && idx < node.tableSize_) {
+                table_[offsets[i] + idx] = child;
+            } else {
+                // children_ is ordered, so sparse_ is sorted
+                node.sparse_.emplace_back(id, child);
+            }
+            if (isSpecialId(id)) {
+                continue;
+            }
+            // Link the fields in id order, the last one wrapping around to
+            // the first so that consecutive structs are predicted too.
+            if (prevField == nullptr) {
+                node.firstField_ = child;
+            } else {
+                prevField->nextField_ = child;
+            }
+            prevField = child;
+        }
+        if (prevField != nullptr) {
+            prevField->nextField_ = node.firstField_;
+        }
+        node.children_.clear();
+    }
+}
+
+} // namespace zstrong::thrift
@@ -10,12 +10,95 @@
 #include <folly/Conv.h>
 #include <folly/Portability.h>
 #include <folly/container/F14Map.h>
+#include <array>
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace zstrong::thrift {
 
+/**
+ * CompiledPaths is a parse config compiled ahead of time into the graph that
+ * the PathTracker walks. The fields of each struct node are resolved through a
+ * flat jump table indexed by field id, and each field links to the field
+ * expected to follow it, so that structs serialized in field order skip the
+ * lookup entirely.
+ *
+ * Nodes refer to their stream through a slot rather than a pointer, so the
+ * compiled paths don't depend on any stream set. They are immutable once
+ * built, and can be cached and shared by every (un)parse using the same config.
+ */
+class CompiledPaths {
+   public:
+    class Node;
+
+    /// Identifies the stream bound to a slot
+    struct StreamRef {
+        enum class Kind : uint8_t {
+            kNone,
+            kSingleton,
+            kLogical,
+            kStringLengths,
+        };
+        Kind kind;
+        /// The SingletonId or LogicalId of the stream
+        uint32_t id;
+        TType type;
+    };
+
+    CompiledPaths(const BaseConfig& config, unsigned int formatVersion);
+    ~CompiledPaths();
+
+    // No moves allowed! Nodes keep raw refs to members.
+    CompiledPaths(CompiledPaths&&)            = delete;
+    CompiledPaths& operator=(CompiledPaths&&) = delete;
+
+    const Node& root() const
+    {
+        return *root_;
+    }
+
+    /// @returns The stream of each slot. Slot 0 never has a stream.
+    const std::vector<StreamRef>& slots() const
+    {
+        return slots_;
+    }
+
+    static TType coerceType(TType type)
+    {
+        if (type == TType::T_SET) {
+            // lists and sets are equivalent, reduce one into the other.
+            type = TType::T_LIST;
+        }
+        return type;
+    }
+
+   private:
+    struct Fallbacks;
+
+    uint32_t addSlot(StreamRef::Kind kind, uint32_t id, TType type);
+    void addStringLengthsNode(Node& stringDataNode, LogicalId id);
+    void fillGraph(const BaseConfig& config, unsigned int formatVersion);
+    void compile();
+
+    std::vector<StreamRef> slots_;
+
+    // Nodes for each thrift type, for when we don't have a node corresponding
+    // to a path.
+    std::unique_ptr<const Fallbacks> fallbacks_;
+
+    std::unique_ptr<Node> root_;
+
+    // Owning refs to all the dynamic nodes. This vector is otherwise unused.
+    std::vector<std::unique_ptr<Node>> nodes_;
+
+    // The jump tables of every node, laid out contiguously
+    std::vector<const Node*> table_;
+};
+
 /**
  * The PathTracker provides the tools to walk a materialized parse config as
  * the parser walks the thrift object, so that the parser can look up the
@@ -27,15 +110,8 @@ class PathTracker {
     // Either WriteStreamSet or ReadStreamSet
     using StreamSet = StreamSetType;
     using Stream    = typename StreamSet::StreamType;
+    using Node      = CompiledPaths::Node;
 
-   private:
-    // Forward declarations of internal types.
-
-    struct Fallbacks;
-
-    class Node;
-
-   public:
     /**
      * The Iterator represents the current position in the current level of a
      * thrift struct tree traversal. It expects to be used by a recursive
@@ -50,18 +126,8 @@ class PathTracker {
                 const Node& node,
                 ThriftNodeId id,
                 TType type,
-                size_t depth)
-                : parent_(parent),
-                  node_(node),
-                  id_(id),
-                  type_(type),
-                  depth_(depth)
-        {
-            if (depth_ > kMaxThriftDepth) {
-                throw std::runtime_error(
-                        "Exceeded maximum thrift recursion depth!");
-            }
-        }
+                size_t depth,
+                Stream* const* streams);
 
         ThriftNodeId id() const
         {
@@ -73,10 +139,7 @@ class PathTracker {
             return type_;
         }
 
-        Stream& stream() const
-        {
-            return node_.getStream();
-        }
+        ZL_FORCE_INLINE_ATTR Stream& stream() const;
 
         /**
          * @pre The ID is not kLengths, kMapKey, kMapValue, kListElem, or kStop.
@@ -106,21 +169,21 @@ class PathTracker {
         const ThriftNodeId id_;
         const TType type_;
         const size_t depth_;
+        Stream* const* streams_;
+        // The field child() expects next, advanced as fields are visited so
+        // that fields in schema order are found without a lookup.
+        mutable const Node* expectedField_;
     };
 
    public:
+    /// Compiles @p config for this tracker only
     PathTracker(
             const BaseConfig& config,
             StreamSet& ss,
-            unsigned int formatVersion)
-            : config_(config),
-              ss_(ss),
-              fallbacks_(*this, config, ss),
-              root_(*this, ThriftNodeId::kRoot, config.getRootType(), nullptr),
-              rootIt_(nullptr, root_, root_.id(), root_.type(), 0)
-    {
-        fillGraph(formatVersion);
-    }
+            unsigned int formatVersion);
+
+    /// Binds already compiled @p paths, which must outlive the tracker
+    PathTracker(const CompiledPaths& paths, StreamSet& ss);
 
     // No moves allowed! Inner children keep raw refs to members.
     PathTracker(PathTracker&&)            = delete;
@@ -140,24 +203,14 @@ class PathTracker {
     static constexpr size_t kMaxThriftDepth =
             std::is_same_v<StreamSet, WriteStreamSet> ? 128 : 256;
 
-    static TType coerceType(TType type);
-
-    void fillGraph(unsigned int formatVersion);
-
-   private:
-    void addStringLengthsNode(Node& stringDataNode, LogicalId id);
-
-    const BaseConfig& config_;
-    StreamSet& ss_;
-
-    // Nodes for each thrift type, for when we don't have a node corresponding
-    // to a path.
-    const Fallbacks fallbacks_;
-
-    // Owning refs to all the dynamic nodes. This vector is otherwise unused.
-    std::vector<std::unique_ptr<Node>> nodes_;
+    /// @returns The stream of each slot of @p paths
+    static std::vector<Stream*> bindStreams(
+            const CompiledPaths& paths,
+            StreamSet& ss);
 
-    Node root_;
+    const std::unique_ptr<const CompiledPaths> ownedPaths_;
+    const CompiledPaths& paths_;
+    std::vector<Stream*> streams_;
     Iterator rootIt_;
 };
 
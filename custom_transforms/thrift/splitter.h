@@ -47,6 +47,21 @@ class BaseParser {
     {
     }
 
+    /// Parses with @p paths compiled ahead of time from @p config
+    BaseParser(
+            const EncoderConfig& config,
+            const CompiledPaths& paths,
+            ReadStream& src,
+            WriteStreamSet& dsts)
+            : rs_(src),
+              wss_(dsts),
+              typeStream_(wss_.getStream(SingletonId::kTypes)),
+              fieldDeltaStream_(wss_.getStream(SingletonId::kFieldDeltas)),
+              tracker_(paths, wss_),
+              config_(config)
+    {
+    }
+
     void parse()
     {
         while (1) {
@@ -303,6 +318,21 @@ class DBaseParser {
     {
     }
 
+    /// Unparses with @p paths compiled ahead of time from @p config
+    DBaseParser(
+            const DecoderConfig& config,
+            const CompiledPaths& paths,
+            ReadStreamSet& srcs,
+            FixedWriteStream& dst)
+            : ws_(dst),
+              rss_(srcs),
+              typeStream_(rss_.getStream(SingletonId::kTypes)),
+              fieldDeltaStream_(rss_.getStream(SingletonId::kFieldDeltas)),
+              tracker_(paths, rss_),
+              config_(config)
+    {
+    }
+
     void unparse()
     {
         while (1) {
@@ -323,4 +323,32 @@ TEST(SplitTest, CompactAgainstBinary)
     }
 }
 
+TEST(SplitTest, CompiledPathsMatchPerParseTracker)
+{
+    std::string const configStr =
+            buildValidEncoderConfig(kMinFormatVersionEncode);
+    EncoderConfig const config(configStr);
+    // Shared by every parse, as the codec state cache does
+    CompiledPaths const paths(config, ZL_MAX_FORMAT_VERSION);
+    std::mt19937 gen(0xdeadbeef);
+
+    for (size_t _ = 0; _ < 100; _++) {
+        std::string const data = generateRandomThrift<CompactSerializer>(gen);
+        WriteStreamSet const expected =
+                thriftSplitIntoWriteStreams<CompactParser>(data, configStr);
+
+        ReadStream srcStream{ folly::ByteRange{ data } };
+        WriteStreamSet actual{ config, ZL_MAX_FORMAT_VERSION };
+        CompactParser parser{ config, paths, srcStream, actual };
+        parser.parse();
+
+        EXPECT_EQ(expected.getVariableStreams(), actual.getVariableStreams());
+        EXPECT_EQ(
+                expected.getVariableStringLengthStreams(),
+                actual.getVariableStringLengthStreams());
+        EXPECT_EQ(
+                expected.getSingletonStreams(), actual.getSingletonStreams());
+    }
+}
+
 } // namespace zstrong::thrift::tests
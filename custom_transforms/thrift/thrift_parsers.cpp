@@ -3,6 +3,7 @@
 #include "custom_transforms/thrift/thrift_parsers.h"    // @manual
 #include "custom_transforms/thrift/binary_splitter.h"   // @manual
 #include "custom_transforms/thrift/compact_splitter.h"  // @manual
+#include "custom_transforms/thrift/config_cache.h"      // @manual
 #include "custom_transforms/thrift/constants.h"         // @manual
 #include "custom_transforms/thrift/debug.h"             // @manual
 #include "custom_transforms/thrift/directed_selector.h" // @manual
@@ -21,6 +22,7 @@
 
 #include <exception>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -334,7 +336,14 @@ ZL_Report configurableEncode(ZL_Encoder* eictx, const ZL_Input* in)
         ZL_RET_R_IF_EQ(corruption, gp.paramId, ZL_LP_INVALID_PARAMID);
         std::string_view const encoderConfigStr(
                 (const char*)gp.paramPtr, gp.paramSize);
-        EncoderConfig config = EncoderConfig(encoderConfigStr);
+        // The cache is only missing if its allocation failed
+        auto* const cache =
+                static_cast<EncoderConfigCache*>(ZL_Encoder_getState(eictx));
+        std::optional<EncoderConfigCache::Entry> uncached;
+        EncoderConfigCache::Entry& cached = cache != nullptr
+                ? cache->get(encoderConfigStr)
+                : uncached.emplace(encoderConfigStr);
+        const EncoderConfig& config = cached.config();
 
         // Fail compression if config uses unsupported features
         ZL_RET_R_IF_LT(
@@ -356,7 +365,9 @@ ZL_Report configurableEncode(ZL_Encoder* eictx, const ZL_Input* in)
         // Encode the input stream!
         ReadStream srcStream{ srcRange };
         WriteStreamSet dstStreamSet(config, formatVersion);
-        Parser parser{ config, srcStream, dstStreamSet, formatVersion };
+        Parser parser{
+            config, cached.paths(formatVersion), srcStream, dstStreamSet
+        };
         try {
             parser.parse();
         } catch (const std::exception& ex) {
@@ -502,6 +513,12 @@ ZL_Report configurableDecode(
             ZL_Input_contentSize(configZStream)
         };
         DecoderConfig const config(configRange);
+        auto* const cache =
+                static_cast<DecoderPathsCache*>(ZL_Decoder_getState(dictx));
+        std::optional<CompiledPaths> uncached;
+        const CompiledPaths& paths = cache != nullptr
+                ? cache->get(config, formatVersion)
+                : uncached.emplace(config, formatVersion);
 
         // Set up input and output streams
         ReadStreamSet srcStreams{ config,           compulsorySrcs,
@@ -510,9 +527,7 @@ ZL_Report configurableDecode(
         ZSDecodeWriteStream dstStream{ dictx, config.getOriginalSize() };
 
         // Decode the input streams!
-        DParser parser{
-            config, srcStreams, dstStream.writeStream(), formatVersion
-        };
+        DParser parser{ config, paths, srcStreams, dstStream.writeStream() };
         try {
             parser.unparse();
         } catch (const std::exception& ex) {
@@ -622,30 +637,45 @@ ZL_VOGraphDesc const thriftBinaryConfigurableGd = {
     .nbVOs          = kVariableOutcomeTypes.size(),
 };
 
+// Each CCtx / DCtx caches the configs used by its Thrift codecs
+ZL_CodecStateManager const kEncoderStateMgr = {
+    .stateAlloc = createEncoderConfigCache,
+    .stateFree  = freeEncoderConfigCache,
+};
+
+ZL_CodecStateManager const kDecoderStateMgr = {
+    .stateAlloc = createDecoderPathsCache,
+    .stateFree  = freeDecoderPathsCache,
+};
+
 } // namespace
 
 ZL_VOEncoderDesc const thriftCompactConfigurableSplitter = {
     .gd          = thriftCompactConfigurableGd,
     .transform_f = configurableEncodeCompact,
     .name        = "Thrift Compact Encode",
+    .trStateMgr  = kEncoderStateMgr,
 };
 
 ZL_VODecoderDesc const thriftCompactConfigurableUnSplitter = {
     .gd          = thriftCompactConfigurableGd,
     .transform_f = configurableDecodeCompact,
     .name        = "Thrift Compact Decode",
+    .trStateMgr  = kDecoderStateMgr,
 };
 
 ZL_VOEncoderDesc const thriftBinaryConfigurableSplitter = {
     .gd          = thriftBinaryConfigurableGd,
     .transform_f = configurableEncodeBinary,
     .name        = "Thrift Binary Encode",
+    .trStateMgr  = kEncoderStateMgr,
 };
 
 ZL_VODecoderDesc const thriftBinaryConfigurableUnSplitter = {
     .gd          = thriftBinaryConfigurableGd,
     .transform_f = configurableDecodeBinary,
     .name        = "Thrift Binary Decode",
+    .trStateMgr  = kDecoderStateMgr,
 };
 
 ZL_Report registerCustomTransforms(ZL_DCtx* dctx)
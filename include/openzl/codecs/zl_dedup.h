@@ -3,6 +3,7 @@
 #ifndef ZSTRONG_CODECS_DEDUP_H
 #define ZSTRONG_CODECS_DEDUP_H
 
+#include "openzl/zl_compressor.h" // ZL_Compressor_parameterizeNode
 #include "openzl/zl_nodes.h"
 
 #if defined(__cplusplus)
@@ -19,6 +20,47 @@ extern "C" {
         ZL_StandardNodeID_dedup_num \
     }
 
+// Deduplicate Chunks - Dedup_Chunks
+// Input : 1 serial stream
+// Output 0 : serial stream, the unique chunks, concatenated
+// Output 1 : numeric stream, the size of each unique chunk
+// Output 2 : numeric stream, for each chunk of the input, the index of its
+//            unique chunk, numbered in order of first occurrence
+// Result : the input is cut into content-defined chunks, using a rolling
+//          hash, so that repeated regions produce the same chunks, even when
+//          they are shifted. Repeated chunks are only stored once.
+//          This node is meant to run before an LZ backend like zstd or
+//          field_lz, which then only processes unique bytes, and can't find
+//          repetitions further than its window anyway.
+// Requires format version 22 or above.
+#define ZL_NODE_DEDUP_CHUNKS           \
+    (ZL_NodeID)                        \
+    {                                  \
+        ZL_StandardNodeID_dedup_chunks \
+    }
+
+// Target average chunk size, in bytes, rounded down to a power of 2.
+// Chunks are at least a quarter, and at most 8 times that size.
+// Smaller chunks find more duplicates, at the cost of more references.
+// Valid range : [256, 4 MiB]
+#define ZL_DEDUP_CHUNKS_AVG_SIZE_PID 1
+#define ZL_DEDUP_CHUNKS_AVG_SIZE_DEFAULT 4096
+
+// Maximum number of unique chunks indexed, which caps the index memory
+// (about 32 bytes per entry). Once reached, new chunks are no longer indexed,
+// but can still be matched against indexed ones.
+#define ZL_DEDUP_CHUNKS_MAX_INDEX_PID 2
+#define ZL_DEDUP_CHUNKS_MAX_INDEX_DEFAULT (1 << 18)
+
+/**
+ * Helper function to parameterize the `ZL_NODE_DEDUP_CHUNKS` node.
+ */
+ZL_RESULT_OF(ZL_NodeID)
+ZL_Compressor_parameterizeDedupChunksNode(
+        ZL_Compressor* compressor,
+        int avgChunkSize,
+        int maxIndexedChunks);
+
 #if defined(__cplusplus)
 }
 #endif
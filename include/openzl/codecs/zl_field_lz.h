@@ -46,7 +46,15 @@ extern "C" {
 /// @returns ZL_GRAPH_FIELD_LZ
 ZL_GraphID ZL_Compressor_registerFieldLZGraph(ZL_Compressor* cgraph);
 
-/// @returns ZL_GRAPH_FIELD_LZ with overridden compression level
+/**
+ * @returns ZL_GRAPH_FIELD_LZ with overridden compression level.
+ *
+ * Levels 1 to 5 are fast. Levels 6 to 9 are meant for archival: they use lazy
+ * (6, 7) and optimal (8, 9) parsing, and long distance matching for large
+ * inputs, for up to 10x the encoding time of level 5, at the same decoding
+ * speed. They are only used when requested with this override, the global
+ * compression level selects at most level 5.
+ */
 ZL_GraphID ZL_Compressor_registerFieldLZGraph_withLevel(
         ZL_Compressor* cgraph,
         int compressionLevel);
@@ -67,7 +75,7 @@ ZL_GraphID ZL_Compressor_registerFieldLZGraph_withLiteralsGraph(
         ZL_Compressor* cgraph,
         ZL_GraphID literalsGraph);
 
-/// Set this integer parameter to override the compression level
+/// Set this integer parameter to override the compression level (1-9)
 #define ZL_FIELD_LZ_COMPRESSION_LEVEL_OVERRIDE_PID 181
 
 /// Set this integer paramter to override the literals graph
@@ -0,0 +1,32 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_CODECS_PFOR_H
+#define ZSTRONG_CODECS_PFOR_H
+
+#include "openzl/zl_nodes.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Patched Frame Of Reference
+// Input : 1 numeric stream (all widths supported)
+// Output : 1 serial stream
+// Result : values are cut into blocks of 128, each one coded independently,
+//          either as offsets from its minimum, or as deltas.
+//          Offsets are bitpacked, using the bit width which minimizes the
+//          block size. Offsets which don't fit are stored as exceptions.
+//          This is a single pass equivalent of delta + zigzag + bitpack,
+//          which suits sorted or slowly varying integers, like timestamps.
+// Requires format version 22 or above.
+#define ZL_NODE_PFOR           \
+    (ZL_NodeID)                \
+    {                          \
+        ZL_StandardNodeID_pfor \
+    }
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -25,6 +25,7 @@
 #include "openzl/zl_reflection.h"               // IWYU pragma: export
 #include "openzl/zl_selector.h"                 // IWYU pragma: export
 #include "openzl/zl_selector_declare_helper.h"  // IWYU pragma: export
+#include "openzl/zl_trace.h"                    // IWYU pragma: export
 #include "openzl/zl_version.h"                  // IWYU pragma: export
 
 #endif
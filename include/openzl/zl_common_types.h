@@ -57,6 +57,52 @@ typedef struct {
     size_t nbNodeIDs;
 } ZL_NodeIDList;
 
+/**
+ * A task scheduled by OpenZL onto a ZL_WorkerPool.
+ * @p taskID is in the range [0, nbTasks).
+ */
+typedef void (*ZL_WorkerTaskFn)(void* taskCtx, size_t taskID);
+
+/**
+ * A pool of workers, provided by the user, which OpenZL employs to run
+ * independent tasks concurrently. OpenZL never creates threads on its own.
+ *
+ * runTasks() must invoke @p task exactly once for each taskID in
+ * [0, nbTasks), in any order and from any thread, and only return once all
+ * of them have completed. Tasks do not fail from the pool's perspective:
+ * errors are collected by OpenZL and reported by the calling operation.
+ */
+typedef struct {
+    void* opaque;
+    void (*runTasks)(
+            void* opaque,
+            ZL_WorkerTaskFn task,
+            void* taskCtx,
+            size_t nbTasks);
+} ZL_WorkerPool;
+
+/**
+ * Input buffer of a streaming operation.
+ * The operation reads from `src + pos`, and updates @p pos
+ * to reflect how much was consumed, necessarily <= @p size.
+ */
+typedef struct {
+    const void* src;
+    size_t size;
+    size_t pos;
+} ZL_InBuffer;
+
+/**
+ * Output buffer of a streaming operation.
+ * The operation writes into `dst + pos`, and updates @p pos
+ * to reflect how much was written, necessarily <= @p size.
+ */
+typedef struct {
+    void* dst;
+    size_t size;
+    size_t pos;
+} ZL_OutBuffer;
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif
@@ -4,6 +4,7 @@
 #define ZSTRONG_ZS2_COMPRESS_H
 
 #include <stddef.h>                  // size_t
+#include "openzl/zl_common_types.h"  // ZL_WorkerPool
 #include "openzl/zl_errors.h"        // ZL_Report, ZL_isError()
 #include "openzl/zl_introspection.h" // ZL_CompressIntrospectionHooks
 #include "openzl/zl_opaque_types.h"  // ZL_CCtx, ZL_TypedRef
@@ -121,6 +122,33 @@ typedef enum {
     /// one must pass a negative threshold value.
     ZL_CParam_minStreamSize = 11,
 
+    /// Number of workers employed to compress independent work in parallel:
+    /// Chunks produced by a Segmenter, or else the Successors of the first
+    /// Graph which has more than one.
+    /// Only effective when a worker pool is attached via
+    /// ZL_CCtx_setWorkerPool().
+    /// Successors remain serial when permissive compression is enabled,
+    /// or when introspection hooks are attached.
+    /// Values 0 and 1 mean single-threaded (blocking) mode.
+    /// The produced frame is byte-identical to single-threaded mode.
+    /// @default 0 (single-threaded)
+    ZL_CParam_nbWorkers = 12,
+
+    /// Append a seek table to the frame, listing the compressed and
+    /// decompressed size of each Chunk.
+    /// It enables random access with ZL_DCtx_decompressChunkAt() and
+    /// ZL_DCtx_decompressRange(), which only decode the Chunks they need.
+    /// Requires format version >= ZL_SEEK_TABLE_VERSION_MIN.
+    /// Valid values for this parameter use the ZL_TernaryParam format.
+    /// @default ZL_TernaryParam_disable
+    ZL_CParam_seekTable = 13,
+
+    /// Amount of input accumulated by ZL_CCtx_compressStream()
+    /// before compressing it as a new block of Chunk(s).
+    /// Memory usage of streaming compression is roughly 3x this size.
+    /// @default 0 means ZL_STREAMBLOCKSIZE_DEFAULT
+    ZL_CParam_streamBlockSize = 14,
+
     // Other possible parameters (ideas) :
     //  - Backup when a node errors out (continue with generic LZ, or error
     //  out)
@@ -135,6 +163,7 @@ typedef enum {
 #define ZL_COMPRESSIONLEVEL_DEFAULT 6
 #define ZL_DECOMPRESSIONLEVEL_DEFAULT 3
 #define ZL_MINSTREAMSIZE_DEFAULT 10
+#define ZL_STREAMBLOCKSIZE_DEFAULT (4 << 20)
 
 /**
  * @brief Sets a global compression parameter via the CCtx.
@@ -256,6 +285,88 @@ ZL_Report ZL_CCtx_attachIntrospectionHooks(
  */
 ZL_Report ZL_CCtx_detachAllIntrospectionHooks(ZL_CCtx* cctx);
 
+/**
+ * @brief Attach a worker pool to the CCtx, for multi-threaded compression.
+ *
+ * The pool is employed when ZL_CParam_nbWorkers > 1.
+ * Otherwise, or when no pool is attached, compression is single-threaded.
+ * Passing NULL detaches the current pool.
+ *
+ * @note This copies the content of the @p pool struct into the CCtx. The
+ * caller is responsible for maintaining the lifetime of the pool itself.
+ * This choice remains sticky, until set again.
+ */
+ZL_Report ZL_CCtx_setWorkerPool(ZL_CCtx* cctx, const ZL_WorkerPool* pool);
+
+/**
+ * @brief Attach a tracer to the CCtx, recording the execution of each codec
+ * and function graph. See zl_trace.h. Passing NULL detaches the current
+ * tracer.
+ *
+ * @note The caller is responsible for maintaining the lifetime of the
+ * @p tracer, until it is detached or the CCtx is freed.
+ * This choice remains sticky, until set again.
+ */
+ZL_Report ZL_CCtx_setTracer(ZL_CCtx* cctx, ZL_Tracer* tracer);
+
+// ----------------------------------------------------
+// Streaming compression
+// ----------------------------------------------------
+
+typedef enum {
+    /// Consume input, only emitting the blocks which are complete
+    ZL_FlushMode_continue = 0,
+    /// Compress all input received so far, and emit it completely.
+    /// Doing so often reduces compression ratio.
+    ZL_FlushMode_flush = 1,
+    /// Compress all input received so far, and close the frame.
+    ZL_FlushMode_end = 2,
+} ZL_FlushMode;
+
+/**
+ * @brief Compresses a serial input provided incrementally, into a single
+ * frame.
+ *
+ * Input is accumulated into blocks of ZL_CParam_streamBlockSize bytes.
+ * Each complete block is compressed by the selected Compressor, as if it was
+ * a standalone input, and its Chunk(s) are emitted into @p output as soon as
+ * they are ready. Memory usage is therefore bounded, whatever the total size
+ * of the content, which doesn't need to be known upfront.
+ *
+ * A frame starts with the first invocation, and is completed by an invocation
+ * with @p mode == ZL_FlushMode_end, which must be repeated until it returns 0.
+ * Parameters are applied when the frame starts, and remain unchanged until it
+ * completes. Streaming requires format version >=
+ * ZL_UNKNOWN_SIZE_VERSION_MIN.
+ *
+ * The produced frame doesn't store its content size in its header.
+ * It can still be decompressed by all decompression functions,
+ * ZL_getDecompressedSize() scanning its chunks to retrieve it.
+ *
+ * @param input reads from `input->src + input->pos`, and updates `input->pos`
+ * @param output writes into `output->dst + output->pos`, and updates
+ * `output->pos`
+ *
+ * @returns the amount of compressed data still buffered within @p cctx,
+ * waiting to be emitted. With ZL_FlushMode_flush and ZL_FlushMode_end,
+ * 0 means the operation is complete. Otherwise, returns an error, in which
+ * case the frame is abandoned, and the next invocation starts a new one.
+ *
+ * @note Only single serial inputs are supported for the time being.
+ */
+ZL_Report ZL_CCtx_compressStream(
+        ZL_CCtx* cctx,
+        ZL_InBuffer* input,
+        ZL_OutBuffer* output,
+        ZL_FlushMode mode);
+
+/**
+ * @brief Abandons the frame currently being compressed by
+ * ZL_CCtx_compressStream(), if any.
+ * The next invocation of ZL_CCtx_compressStream() starts a new frame.
+ */
+ZL_Report ZL_CCtx_resetStream(ZL_CCtx* cctx);
+
 // ----------------------------------------------------
 // Typed inputs
 // ----------------------------------------------------
@@ -299,6 +410,42 @@ ZL_Report ZL_CCtx_compressMultiTypedRef(
         const ZL_TypedRef* inputs[],
         size_t nbInputs);
 
+/**
+ * Destination of a frame emitted as a sequence of segments,
+ * see ZL_CCtx_compressMultiTypedRefToSink().
+ */
+typedef struct {
+    /**
+     * Receives the next @p size bytes of the frame.
+     * @p src is only valid during the invocation.
+     * @returns 0 on success. Any other value aborts compression.
+     */
+    int (*write)(void* opaque, const void* src, size_t size);
+    void* opaque;
+} ZL_WriteSink;
+
+/**
+ * Compresses multiple typed inputs, like ZL_CCtx_compressMultiTypedRef(),
+ * but hands the frame to @p sink as a sequence of segments,
+ * instead of assembling it into a single destination buffer.
+ *
+ * Large stored streams, and Chunks compressed by workers, are passed directly
+ * from the memory which holds them, without being copied. Headers, checksums
+ * and small streams are gathered into an internal staging buffer in between.
+ * Segments are therefore suitable for `writev()`, or a network stack.
+ * Their concatenation is byte-identical to the frame produced by
+ * ZL_CCtx_compressMultiTypedRef() with the same parameters.
+ *
+ * @returns The total number of bytes written into @p sink, if successful.
+ * Otherwise, returns an error, in which case the segments already written
+ * don't form a valid frame.
+ */
+ZL_Report ZL_CCtx_compressMultiTypedRefToSink(
+        ZL_CCtx* cctx,
+        const ZL_WriteSink* sink,
+        const ZL_TypedRef* inputs[],
+        size_t nbInputs);
+
 /* ZL_TypedRef* is an object that references an input buffer
  * and tag it with additional Type information */
 
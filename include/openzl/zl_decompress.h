@@ -4,7 +4,8 @@
 #define ZSTRONG_ZS2_DECOMPRESS_H
 
 // basic definitions
-#include "openzl/zl_errors.h" // ZL_Report, ZL_isError()
+#include "openzl/zl_common_types.h" // ZL_WorkerPool
+#include "openzl/zl_errors.h"       // ZL_Report, ZL_isError()
 #include "openzl/zl_output.h"
 
 #if defined(__cplusplus)
@@ -123,6 +124,19 @@ typedef enum {
      */
     ZL_DParam_checkContentChecksum = 3,
 
+    /**
+     * @brief Number of workers employed to decode Chunks in parallel.
+     *
+     * Frames made of multiple Chunks decode their Chunks in parallel,
+     * while a frame made of a single Chunk decodes its independent
+     * decoder stages in parallel instead.
+     * Only effective when a worker pool is attached via
+     * ZL_DCtx_setWorkerPool().
+     * Values 0 and 1 mean single-threaded mode.
+     * @note Default 0 means single-threaded
+     */
+    ZL_DParam_nbWorkers = 4,
+
 } ZL_DParam;
 
 /**
@@ -172,6 +186,37 @@ ZL_Report ZL_DCtx_resetParameters(ZL_DCtx* dctx);
 #include "openzl/zl_data.h" // ZL_DataArenaType
 ZL_Report ZL_DCtx_setStreamArena(ZL_DCtx* dctx, ZL_DataArenaType sat);
 
+/**
+ * @brief Attaches a worker pool to the DCtx, for multi-threaded decompression.
+ *
+ * The pool is employed when ZL_DParam_nbWorkers > 1.
+ * Otherwise, or when no pool is attached, decompression is single-threaded.
+ * Passing NULL detaches the current pool.
+ *
+ * @param dctx Decompression context
+ * @param pool Worker pool to attach, or NULL
+ * @return Error code or success
+ *
+ * @note This copies the content of the @p pool struct into the DCtx. The
+ * caller is responsible for maintaining the lifetime of the pool itself.
+ * This choice remains sticky, until set again.
+ */
+ZL_Report ZL_DCtx_setWorkerPool(ZL_DCtx* dctx, const ZL_WorkerPool* pool);
+
+/**
+ * @brief Attaches a tracer to the DCtx, recording the execution of each
+ * decoder. See zl_trace.h. Passing NULL detaches the current tracer.
+ *
+ * @param dctx Decompression context
+ * @param tracer Tracer to attach, or NULL
+ * @return Error code or success
+ *
+ * @note The caller is responsible for maintaining the lifetime of the
+ * @p tracer, until it is detached or the DCtx is freed.
+ * This choice remains sticky, until set again.
+ */
+ZL_Report ZL_DCtx_setTracer(ZL_DCtx* dctx, ZL_Tracer* tracer);
+
 /**
  * @brief Gets a verbose error string containing context about the error.
  *
@@ -587,6 +632,159 @@ size_t ZL_TypedBuffer_eltWidth(const ZL_TypedBuffer* tbuffer);
  */
 const uint32_t* ZL_TypedBuffer_rStringLens(const ZL_TypedBuffer* tbuffer);
 
+// ---------------------------------------------
+// Random access, for frames with a seek table
+// ---------------------------------------------
+
+/* Frames compressed with ZL_CParam_seekTable enabled list the position and
+ * size of each of their Chunks. The following functions employ this table
+ * to only decode the Chunks they need.
+ * They all require @p compressed to be exactly one complete frame,
+ * and fail with ZL_ErrorCode_frameParameter_unsupported
+ * on frames without a seek table. */
+
+/**
+ * @brief Gets the number of Chunks in a frame with a seek table.
+ *
+ * @param compressed Pointer to a complete compressed frame
+ * @param cSize Exact size of the compressed frame
+ * @return Number of Chunks, or error code
+ */
+ZL_Report ZL_getNumChunks(const void* compressed, size_t cSize);
+
+/**
+ * @brief Decompresses a single Chunk of a frame into multiple TypedBuffers.
+ *
+ * Each output receives the portion of the frame's output
+ * regenerated by Chunk @p chunkIndex.
+ *
+ * @param dctx Decompression context
+ * @param outputs Array of ZL_TypedBuffer* objects, like
+ *                ZL_DCtx_decompressMultiTBuffer()
+ * @param nbOutputs Exact number of outputs of the frame
+ * @param chunkIndex Index of the Chunk to decompress,
+ *                   < ZL_getNumChunks()
+ * @param compressed Pointer to a complete compressed frame
+ * @param cSize Exact size of the compressed frame
+ * @return Error code or number of decompressed TypedBuffers
+ */
+ZL_Report ZL_DCtx_decompressChunkAt(
+        ZL_DCtx* dctx,
+        ZL_TypedBuffer* outputs[],
+        size_t nbOutputs,
+        size_t chunkIndex,
+        const void* compressed,
+        size_t cSize);
+
+/**
+ * @brief Decompresses a range of elements from one output of a frame.
+ *
+ * Only the Chunks overlapping the range [@p eltBegin, @p eltEnd) are decoded.
+ *
+ * @param dctx Decompression context
+ * @param output TypedBuffer receiving the elements, either empty
+ *               (ZL_TypedBuffer_create()) or pre-allocated
+ * @param outputIndex Index of the frame's output to read from
+ * @param eltBegin Index of the first element to decompress
+ * @param eltEnd Index after the last element to decompress,
+ *               <= number of elements of the output
+ * @param compressed Pointer to a complete compressed frame
+ * @param cSize Exact size of the compressed frame
+ * @return Error code or number of decompressed elements
+ */
+ZL_Report ZL_DCtx_decompressRange(
+        ZL_DCtx* dctx,
+        ZL_TypedBuffer* output,
+        int outputIndex,
+        size_t eltBegin,
+        size_t eltEnd,
+        const void* compressed,
+        size_t cSize);
+
+// ---------------------------------------------
+// Streaming decompression
+// ---------------------------------------------
+
+/**
+ * @brief Decompresses a frame provided incrementally,
+ * emitting its content as soon as each Chunk is decoded.
+ *
+ * Compressed data is consumed from @p input, and buffered internally only when
+ * a Chunk is split across invocations. Each decoded Chunk is then written into
+ * @p output, possibly across multiple invocations when @p output is too small.
+ * Memory usage is therefore bounded by the size of the largest Chunk, and
+ * doesn't depend on the size of the frame.
+ *
+ * Once a frame is complete, the next invocation starts a new one.
+ * Input following the end of the frame is generally left unconsumed,
+ * except when it was already buffered by a previous invocation,
+ * in which case it's kept for the next frame.
+ * Parameters are applied when the frame starts.
+ *
+ * @param input reads from `input->src + input->pos`, and updates `input->pos`
+ * @param output writes into `output->dst + output->pos`, and updates
+ * `output->pos`
+ *
+ * @returns 0 when the frame is completely decoded and flushed. Otherwise, a
+ * hint for the amount of compressed data still needed to make progress,
+ * which is >= 1. Or an error, in which case the frame is abandoned.
+ *
+ * @note Only supports frames of format version >= ZL_CHUNK_VERSION_MIN
+ * with a single output of type serial, struct or numeric.
+ * Content is emitted as raw bytes, in native endianness for numerics.
+ * Frames with multiple outputs or String outputs are rejected:
+ * they are supported by ZL_DCtx_decompressStreamMulti().
+ */
+ZL_Report ZL_DCtx_decompressStream(
+        ZL_DCtx* dctx,
+        ZL_InBuffer* input,
+        ZL_OutBuffer* output);
+
+/**
+ * @brief Destination of one output of a frame
+ * decompressed by ZL_DCtx_decompressStreamMulti().
+ */
+typedef struct {
+    ZL_OutBuffer content; /**< Content, as raw bytes. For String outputs,
+                               the concatenation of all strings */
+    ZL_OutBuffer lengths; /**< String outputs only : the length of each
+                               string, as 32-bit unsigned values in native
+                               endianness. Ignored for other types */
+} ZL_StreamOutput;
+
+/**
+ * @brief Decompresses a frame provided incrementally, like
+ * ZL_DCtx_decompressStream(), into one destination per output of the frame.
+ *
+ * Each decoded Chunk is written into all @p outputs before the next Chunk is
+ * decoded. When any of them is full, the invocation stops, and returns 1:
+ * the caller must then make room into the buffers whose `pos == size`.
+ *
+ * @param outputs one destination per output of the frame, in order
+ * @param nbOutputs Exact number of outputs of the frame,
+ *                  which must remain the same until the frame is complete
+ *
+ * @returns same as ZL_DCtx_decompressStream()
+ *
+ * @note Supports frames of format version >= ZL_CHUNK_VERSION_MIN.
+ * @note The `lengths` buffer of String outputs must be non-NULL.
+ * Content and lengths of a String output are emitted independently,
+ * so the caller must combine them to delimit strings,
+ * possibly across invocations.
+ */
+ZL_Report ZL_DCtx_decompressStreamMulti(
+        ZL_DCtx* dctx,
+        ZL_InBuffer* input,
+        ZL_StreamOutput outputs[],
+        size_t nbOutputs);
+
+/**
+ * @brief Abandons the frame currently being decompressed by
+ * ZL_DCtx_decompressStream(), if any.
+ * The next invocation of ZL_DCtx_decompressStream() starts a new frame.
+ */
+ZL_Report ZL_DCtx_resetStream(ZL_DCtx* dctx);
+
 // -----------------------------
 // Advanced & unstable functions
 // -----------------------------
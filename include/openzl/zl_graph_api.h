@@ -169,6 +169,26 @@ typedef struct ZL_GraphParameters_s ZL_RuntimeGraphParameters;
  * */
 void* ZL_Graph_getScratchSpace(ZL_Graph* gctx, size_t size);
 
+/* Parallel tasks:
+ * A Function Graph can split some of its own work, e.g. parsing, into
+ * independent tasks, which run on the ZL_WorkerPool attached to the
+ * compression (see ZL_CCtx_setWorkerPool()).
+ * ZL_Graph_getNbWorkers() tells how many tasks can run concurrently:
+ * ZL_CParam_nbWorkers when a worker pool is attached, 1 otherwise.
+ * ZL_Graph_runTasks() invokes @p task once for each taskID in [0, nbTasks),
+ * and returns once all of them have completed. Tasks run on the worker pool
+ * when ZL_Graph_getNbWorkers() > 1, and serially on the calling thread
+ * otherwise. Tasks must not invoke any ZL_Graph or ZL_Edge function, so any
+ * scratch space must be requested beforehand. Errors are reported through
+ * @p taskCtx.
+ * */
+size_t ZL_Graph_getNbWorkers(const ZL_Graph* gctx);
+void ZL_Graph_runTasks(
+        ZL_Graph* gctx,
+        ZL_WorkerTaskFn task,
+        void* taskCtx,
+        size_t nbTasks);
+
 /**
  * A measurement of graph performance.
  * Currently this is compressed size, but it is expected to be expanded to
@@ -80,6 +80,9 @@ typedef enum {
     ZL_StandardNodeID_quantize_offsets,
     ZL_StandardNodeID_quantize_lengths,
 
+    ZL_StandardNodeID_pfor,
+    ZL_StandardNodeID_dedup_chunks,
+
     ZL_StandardNodeID_public_end // last id, used to detect end of public range
 } ZL_StandardNodeID;
 
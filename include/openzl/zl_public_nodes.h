@@ -31,6 +31,7 @@
 #include "openzl/codecs/zl_interleave.h"           // IWYU pragma: export
 #include "openzl/codecs/zl_merge_sorted.h"         // IWYU pragma: export
 #include "openzl/codecs/zl_parse_int.h"            // IWYU pragma: export
+#include "openzl/codecs/zl_pfor.h"                 // IWYU pragma: export
 #include "openzl/codecs/zl_prefix.h"               // IWYU pragma: export
 #include "openzl/codecs/zl_quantize.h"             // IWYU pragma: export
 #include "openzl/codecs/zl_range_pack.h"           // IWYU pragma: export
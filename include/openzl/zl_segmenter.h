@@ -64,6 +64,10 @@ extern "C" {
  * Occasionally, the segmenter may receive an explicit order to flush all
  * remaining data, in which case, it *must* generate one or more Chunks with
  * whatever data is left from Input.
+ *
+ * Meanwhile, ZL_CCtx_compressStream() invokes the Segmenter once per
+ * accumulated block of ZL_CParam_streamBlockSize bytes, presenting each block
+ * as a complete Input. Chunk decisions therefore can't span blocks.
  */
 
 typedef struct ZL_Segmenter_s ZL_Segmenter;
@@ -308,8 +312,13 @@ void* ZL_Segmenter_getScratchSpace(ZL_Segmenter* segCtx, size_t size);
  * @return ZL_Report indicating success or failure of the chunk processing
  * operation
  *
- * @note Future multi-threading support may make this function non-blocking,
- *       processing chunks in parallel.
+ * @note In multi-threaded mode (see ZL_CParam_nbWorkers), this function is
+ *       non-blocking: the Chunk is scheduled, and compressed later, in
+ *       parallel with other Chunks. @p rGraphParams is copied, so it doesn't
+ *       need to outlive the call. In this mode, the returned value is the
+ *       compressed size of the Chunks flushed during this call (possibly 0),
+ *       and errors may be reported by a later call.
+ *       Chunks are still output in order.
  *
  * @note Chunking is not the same as Streaming operation - the entire input must
  * be present and fully consumed. Future streaming capabilities may require
@@ -0,0 +1,132 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef OPENZL_ZL_TRACE_H
+#define OPENZL_ZL_TRACE_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t
+
+#include "openzl/zl_errors.h"       // ZL_Report
+#include "openzl/zl_opaque_types.h" // ZL_Tracer
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @file zl_trace.h
+ *
+ * Built-in tracing of compression and decompression operations.
+ *
+ * A ZL_Tracer collects one event per codec or function graph execution:
+ * its ID, name, start and end timestamps, and bytes consumed and produced.
+ * It is enabled at runtime by attaching it to a ZL_CCtx or a ZL_DCtx, see
+ * ZL_CCtx_setTracer() and ZL_DCtx_setTracer(). When no tracer is attached,
+ * the cost is a single pointer check per codec execution.
+ *
+ * Events are recorded into fixed-size ring buffers, one per context,
+ * including the internal contexts employed by worker threads. Each ring has
+ * a single writer, so recording never takes a lock. When a ring is full, the
+ * oldest events are overwritten.
+ *
+ * Collected events can be inspected individually, or exported as a Chrome
+ * trace (JSON, loadable by chrome://tracing and Perfetto), or as a summary
+ * aggregating executions per codec and graph.
+ *
+ * @note A tracer, and the contexts it is attached to, must not be used from
+ * multiple threads simultaneously. Worker threads started by the contexts
+ * themselves are taken care of. Events must be read after the operations
+ * they trace have completed.
+ *
+ * @note Tracing requires the library to be compiled with the
+ * ZL_ALLOW_INTROSPECTION option. Otherwise, no event is ever recorded.
+ */
+
+typedef enum {
+    ZL_TraceEventType_codecEncode = 0,
+    ZL_TraceEventType_graphEncode = 1,
+    ZL_TraceEventType_codecDecode = 2,
+} ZL_TraceEventType;
+
+/// Names longer than this are truncated.
+#define ZL_TRACE_NAME_SIZE_MAX 48
+
+typedef struct {
+    ZL_TraceEventType type;
+    /// Identifies the ring, hence the context, which recorded the event.
+    unsigned ringID;
+    /// Codec ID for codec events, Graph ID for graph events.
+    unsigned id;
+    /// Nanoseconds since the tracer was created or last reset.
+    uint64_t startNs;
+    uint64_t endNs;
+    size_t bytesIn;
+    /// Total size of the outputs. Always 0 for graph events,
+    /// since their outputs are measured by their successors.
+    size_t bytesOut;
+    char name[ZL_TRACE_NAME_SIZE_MAX];
+} ZL_TraceEvent;
+
+/**
+ * Creates a tracer, whose rings can each hold @p eventsPerRing events.
+ * @p eventsPerRing == 0 selects a default capacity.
+ * @returns The tracer, or NULL on allocation failure.
+ */
+ZL_Tracer* ZL_Tracer_create(size_t eventsPerRing);
+
+/**
+ * Frees the @p tracer. It must first be detached from all contexts.
+ */
+void ZL_Tracer_free(ZL_Tracer* tracer);
+
+/**
+ * Discards all recorded events, and restarts the clock.
+ * Rings remain allocated and attached to their contexts.
+ */
+void ZL_Tracer_reset(ZL_Tracer* tracer);
+
+/**
+ * @returns The number of events currently held by the @p tracer.
+ */
+size_t ZL_Tracer_nbEvents(const ZL_Tracer* tracer);
+
+/**
+ * @returns The number of events overwritten because their ring was full.
+ */
+size_t ZL_Tracer_nbDroppedEvents(const ZL_Tracer* tracer);
+
+/**
+ * @returns The @p idx-th event, with @p idx < ZL_Tracer_nbEvents().
+ * Events are grouped per ring, and ordered by completion within a ring.
+ */
+const ZL_TraceEvent* ZL_Tracer_getEvent(const ZL_Tracer* tracer, size_t idx);
+
+/**
+ * Receives the text produced by exporters, chunk by chunk.
+ */
+typedef void (*ZL_Tracer_WriteFn)(void* opaque, const char* data, size_t size);
+
+/**
+ * Exports all events in the Chrome Trace Event format.
+ * Each ring is presented as a separate thread.
+ */
+ZL_Report ZL_Tracer_exportChromeTrace(
+        const ZL_Tracer* tracer,
+        ZL_Tracer_WriteFn write,
+        void* opaque);
+
+/**
+ * Exports a human-readable table, with one line per codec or graph,
+ * featuring its number of executions, total and average duration,
+ * bytes in and out, and throughput. Lines are sorted by total duration.
+ */
+ZL_Report ZL_Tracer_exportSummary(
+        const ZL_Tracer* tracer,
+        ZL_Tracer_WriteFn write,
+        void* opaque);
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+#endif // OPENZL_ZL_TRACE_H
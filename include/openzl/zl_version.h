@@ -60,11 +60,18 @@ extern "C" {
 /// format changes. But note that once a library with
 /// max format version X is released, we must support X
 /// through our support window.
-#define ZL_MAX_FORMAT_VERSION (21)
+#define ZL_MAX_FORMAT_VERSION (24)
 
 /// Minimum wire format version required to support chunking.
 #define ZL_CHUNK_VERSION_MIN (21)
 
+/// Minimum wire format version required to support the seek table.
+#define ZL_SEEK_TABLE_VERSION_MIN (23)
+
+/// Minimum wire format version required to support frames of unknown content
+/// size, as produced by streaming compression.
+#define ZL_UNKNOWN_SIZE_VERSION_MIN (24)
+
 /// Minimum wire format version required to support typed input.
 #define ZL_TYPED_INPUT_VERSION_MIN (14)
 
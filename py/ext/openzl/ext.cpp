@@ -95,7 +95,10 @@ void registerCParam(nb::module_& m)
             .value("PermissiveCompression", CParam::PermissiveCompression)
             .value("CompressedChecksum", CParam::CompressedChecksum)
             .value("ContentChecksum", CParam::ContentChecksum)
-            .value("MinStreamSize", CParam::MinStreamSize);
+            .value("MinStreamSize", CParam::MinStreamSize)
+            .value("NbWorkers", CParam::NbWorkers)
+            .value("SeekTable", CParam::SeekTable)
+            .value("StreamBlockSize", CParam::StreamBlockSize);
 }
 
 void registerDParam(nb::module_& m)
@@ -103,7 +106,8 @@ void registerDParam(nb::module_& m)
     nb::enum_<DParam>(m, "DParam")
             .value("StickyParameters", DParam::StickyParameters)
             .value("CheckCompressedChecksum", DParam::CheckCompressedChecksum)
-            .value("CheckContentChecksum", DParam::CheckContentChecksum);
+            .value("CheckContentChecksum", DParam::CheckContentChecksum)
+            .value("NbWorkers", DParam::NbWorkers);
 }
 
 template <typename... Args>
@@ -5,12 +5,13 @@
 #include "openzl/codecs/common/bitstream/ff_bitstream.h"
 #include "openzl/common/assertion.h"
 #include "openzl/shared/bits.h"
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/mem.h" // ZL_writeLE64
 #include "openzl/shared/portability.h"
 #include "openzl/shared/utils.h"
 #include "openzl/zl_errors.h"
 
-#define ZS_HAS_FAST_BITPACK (ZL_HAS_AVX2 && ZL_HAS_BMI2)
+#define ZS_HAS_FAST_BITPACK (ZL_CAN_AVX2 && ZL_CAN_BMI2)
 
 #if ZS_HAS_FAST_BITPACK
 #    include <immintrin.h>
@@ -284,6 +285,8 @@ static size_t ZS_bitpackEncode64_generic(
 
 #if ZS_HAS_FAST_BITPACK
 
+ZL_TARGET_AVX2_BMI2_BEGIN
+
 #    define ZS_BITPACK_ENCODE_8_T_FN(type) ZS_bitpackEncode8_##type##_bmi2
 
 #    define ZS_BITPACK_ENCODE_8_T(type, convert16Fn, leftoversFn)       \
@@ -442,11 +445,12 @@ static void convert8U32ToU16(uint16_t* dst, uint32_t const* src)
 
 static void convert8U64ToU16(uint16_t* dst, uint64_t const* src)
 {
-    uint32_t const* src32 = (const uint32_t*)src;
-    __m128i const src0V   = _mm_loadu_si128((__m128i_u const*)(src32 + 0x0));
-    __m128i const src2V   = _mm_loadu_si128((__m128i_u const*)(src32 + 0x3));
-    __m128i const src4V   = _mm_loadu_si128((__m128i_u const*)(src32 + 0x8));
-    __m128i const src6V   = _mm_loadu_si128((__m128i_u const*)(src32 + 0xB));
+    // Offsets in units of 32-bit words
+    uint8_t const* src8 = (uint8_t const*)src;
+    __m128i const src0V = _mm_loadu_si128((__m128i_u const*)(src8 + 4 * 0x0));
+    __m128i const src2V = _mm_loadu_si128((__m128i_u const*)(src8 + 4 * 0x3));
+    __m128i const src4V = _mm_loadu_si128((__m128i_u const*)(src8 + 4 * 0x8));
+    __m128i const src6V = _mm_loadu_si128((__m128i_u const*)(src8 + 4 * 0xB));
     // 0, 2, 1, 3
     __m128i const src02V = _mm_or_si128(src0V, src2V);
     // 4, 6, 5, 7
@@ -464,6 +468,8 @@ ZS_BITPACK_ENCODE_16_T(uint16_t, convert8U16ToU16, ZS_bitpackEncode16_generic)
 ZS_BITPACK_ENCODE_16_T(uint32_t, convert8U32ToU16, ZS_bitpackEncode32_generic)
 ZS_BITPACK_ENCODE_16_T(uint64_t, convert8U64ToU16, ZS_bitpackEncode64_generic)
 
+ZL_TARGET_END
+
 #endif // ZS_HAS_FAST_BITPACK
 
 size_t ZS_bitpackEncode8(
@@ -478,12 +484,13 @@ size_t ZS_bitpackEncode8(
     if (ret != (size_t)-1)
         return ret;
 #if ZS_HAS_FAST_BITPACK
-    return ZS_BITPACK_ENCODE_8_T_FN(uint8_t)(
-            (uint8_t*)dst, src, nbElts, (size_t)nbBits);
-#else
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        return ZS_BITPACK_ENCODE_8_T_FN(uint8_t)(
+                (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+    }
+#endif
     return ZS_bitpackEncode8_generic(
             (uint8_t*)dst, src, nbElts, (size_t)nbBits);
-#endif
 }
 
 static size_t
@@ -513,16 +520,17 @@ size_t ZS_bitpackEncode16(
     }
 
 #if ZS_HAS_FAST_BITPACK
-    if (nbBits <= 8) {
-        return ZS_BITPACK_ENCODE_8_T_FN(uint16_t)(
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        if (nbBits <= 8) {
+            return ZS_BITPACK_ENCODE_8_T_FN(uint16_t)(
+                    (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+        }
+        return ZS_BITPACK_ENCODE_16_T_FN(uint16_t)(
                 (uint8_t*)dst, src, nbElts, (size_t)nbBits);
     }
-    return ZS_BITPACK_ENCODE_16_T_FN(uint16_t)(
-            (uint8_t*)dst, src, nbElts, (size_t)nbBits);
-#else
+#endif
     return ZS_bitpackEncode16_generic(
             (uint8_t*)dst, src, nbElts, (size_t)nbBits);
-#endif
 }
 
 static void ZS_writeLEN32(uint8_t* dst, uint32_t val, size_t n)
@@ -584,13 +592,15 @@ size_t ZS_bitpackEncode32(
     }
 
 #if ZS_HAS_FAST_BITPACK
-    if (nbBits <= 8) {
-        return ZS_BITPACK_ENCODE_8_T_FN(uint32_t)(
-                (uint8_t*)dst, src, nbElts, (size_t)nbBits);
-    }
-    if (nbBits <= 16) {
-        return ZS_BITPACK_ENCODE_16_T_FN(uint32_t)(
-                (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        if (nbBits <= 8) {
+            return ZS_BITPACK_ENCODE_8_T_FN(uint32_t)(
+                    (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+        }
+        if (nbBits <= 16) {
+            return ZS_BITPACK_ENCODE_16_T_FN(uint32_t)(
+                    (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+        }
     }
 #endif
 
@@ -666,13 +676,15 @@ size_t ZS_bitpackEncode64(
     }
 
 #if ZS_HAS_FAST_BITPACK
-    if (nbBits <= 8) {
-        return ZS_BITPACK_ENCODE_8_T_FN(uint64_t)(
-                (uint8_t*)dst, src, nbElts, (size_t)nbBits);
-    }
-    if (nbBits <= 16) {
-        return ZS_BITPACK_ENCODE_16_T_FN(uint64_t)(
-                (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        if (nbBits <= 8) {
+            return ZS_BITPACK_ENCODE_8_T_FN(uint64_t)(
+                    (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+        }
+        if (nbBits <= 16) {
+            return ZS_BITPACK_ENCODE_16_T_FN(uint64_t)(
+                    (uint8_t*)dst, src, nbElts, (size_t)nbBits);
+        }
     }
 #endif
 
@@ -951,6 +963,8 @@ static size_t ZS_bitpackDecode8_generic(
 
 #if ZS_HAS_FAST_BITPACK
 
+ZL_TARGET_AVX2_BMI2_BEGIN
+
 static size_t ZS_bitpackDecode16_bmi2(
         uint16_t* op,
         size_t nbElts,
@@ -1147,6 +1161,8 @@ ZS_BITPACK_DECODE_16_T(uint16_t, convert8U16ToU16, ZS_bitpackDecode16_generic)
 ZS_BITPACK_DECODE_16_T(uint32_t, convert8U16ToU32, ZS_bitpackDecode32_generic)
 ZS_BITPACK_DECODE_16_T(uint64_t, convert8U16ToU64, ZS_bitpackDecode64_generic)
 
+ZL_TARGET_END
+
 #endif // ZS_HAS_FAST_BITPACK
 
 size_t ZS_bitpackDecode8(
@@ -1166,10 +1182,12 @@ size_t ZS_bitpackDecode8(
         return bit1depack8(dst, nbElts, src, srcCapacity);
 
 #if ZS_HAS_FAST_BITPACK
-    return ZS_BITPACK_DECODE_8_T_FN(uint8_t)(dst, nbElts, src, (size_t)nbBits);
-#else
-    return ZS_bitpackDecode8_generic(dst, nbElts, src, (size_t)nbBits);
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        return ZS_BITPACK_DECODE_8_T_FN(uint8_t)(
+                dst, nbElts, src, (size_t)nbBits);
+    }
 #endif
+    return ZS_bitpackDecode8_generic(dst, nbElts, src, (size_t)nbBits);
 }
 
 static size_t
@@ -1198,15 +1216,16 @@ size_t ZS_bitpackDecode16(
     }
 
 #if ZS_HAS_FAST_BITPACK
-    if (nbBits <= 8) {
-        return ZS_BITPACK_DECODE_8_T_FN(uint16_t)(
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        if (nbBits <= 8) {
+            return ZS_BITPACK_DECODE_8_T_FN(uint16_t)(
+                    dst, nbElts, src, (size_t)nbBits);
+        }
+        return ZS_BITPACK_DECODE_16_T_FN(uint16_t)(
                 dst, nbElts, src, (size_t)nbBits);
     }
-    return ZS_BITPACK_DECODE_16_T_FN(uint16_t)(
-            dst, nbElts, src, (size_t)nbBits);
-#else
-    return ZS_bitpackDecode16_generic(dst, nbElts, src, (size_t)nbBits);
 #endif
+    return ZS_bitpackDecode16_generic(dst, nbElts, src, (size_t)nbBits);
 }
 
 static uint32_t ZS_readLEN32(uint8_t const* src, size_t n)
@@ -1274,12 +1293,14 @@ size_t ZS_bitpackDecode32(
     }
 
 #if ZS_HAS_FAST_BITPACK
-    if (nbBits <= 8) {
-        return ZS_BITPACK_DECODE_8_T_FN(uint32_t)(
-                dst, nbElts, src, (size_t)nbBits);
-    } else if (nbBits <= 16) {
-        return ZS_BITPACK_DECODE_16_T_FN(uint32_t)(
-                dst, nbElts, src, (size_t)nbBits);
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        if (nbBits <= 8) {
+            return ZS_BITPACK_DECODE_8_T_FN(uint32_t)(
+                    dst, nbElts, src, (size_t)nbBits);
+        } else if (nbBits <= 16) {
+            return ZS_BITPACK_DECODE_16_T_FN(uint32_t)(
+                    dst, nbElts, src, (size_t)nbBits);
+        }
     }
 #endif
 
@@ -1356,12 +1377,14 @@ size_t ZS_bitpackDecode64(
     }
 
 #if ZS_HAS_FAST_BITPACK
-    if (nbBits <= 8) {
-        return ZS_BITPACK_DECODE_8_T_FN(uint64_t)(
-                dst, nbElts, src, (size_t)nbBits);
-    } else if (nbBits <= 16) {
-        return ZS_BITPACK_DECODE_16_T_FN(uint64_t)(
-                dst, nbElts, src, (size_t)nbBits);
+    if (ZL_cpuHas(ZL_CpuFeature_avx2 | ZL_CpuFeature_bmi2)) {
+        if (nbBits <= 8) {
+            return ZS_BITPACK_DECODE_8_T_FN(uint64_t)(
+                    dst, nbElts, src, (size_t)nbBits);
+        } else if (nbBits <= 16) {
+            return ZS_BITPACK_DECODE_16_T_FN(uint64_t)(
+                    dst, nbElts, src, (size_t)nbBits);
+        }
     }
 #endif
 
@@ -12,14 +12,6 @@
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_bitpack_typed_int_time_ms = 0.0;
-static double EI_bitpack_typed_serial_time_ms = 0.0;
-
-static size_t EI_bitpack_typed_int_contentsize = 0;
-static size_t EI_bitpack_typed_serial_contentsize = 0;
-
 static uint32_t computeMaxValue8(uint8_t const* src, size_t nbElts)
 {
     uint32_t max = 0;
@@ -100,8 +92,6 @@ static ZL_Report checkEtlWidth(size_t eltWidth)
 ZL_Report
 EI_bitpack_typed(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -154,30 +144,6 @@ EI_bitpack_typed(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 
     ZL_RET_R_IF_ERR(ZL_Output_commit(out, dstSize));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-
-    ZL_Type currentType = ZL_Input_type(in);
-    switch (currentType){
-        case ZL_Type_serial:
-            EI_bitpack_typed_serial_time_ms += current_duration;
-            EI_bitpack_typed_serial_contentsize += ZL_Input_contentSize(in);
-            fprintf(stderr, "[EI_bitpack_typed_serial] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | contentsize: %zu\n", start_time_ms, end_time_ms, EI_bitpack_typed_serial_time_ms, current_duration, EI_bitpack_typed_serial_contentsize);
-            break;
-        case ZL_Type_struct:
-            break;
-        case ZL_Type_numeric:
-            EI_bitpack_typed_int_time_ms += current_duration;
-            EI_bitpack_typed_int_contentsize += ZL_Input_contentSize(in);
-            fprintf(stderr, "[EI_bitpack_typed_numeric] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | contentsize: %zu\n", start_time_ms, end_time_ms, EI_bitpack_typed_int_time_ms, current_duration, EI_bitpack_typed_int_contentsize);
-            break;
-        case ZL_Type_string:
-            break;
-    }
-
     return ZL_returnValue(1);
 }
 
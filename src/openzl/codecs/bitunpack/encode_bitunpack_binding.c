@@ -12,11 +12,6 @@
 #include "openzl/zl_errors.h"
 #include "openzl/zl_public_nodes.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_bitunpack_time_ms = 0.0;
-static size_t EI_bitunpack_contentsize = 0;
-
 static ZL_Report getNbBits(ZL_Encoder* eictx)
 {
     ZL_IntParam const nbBits =
@@ -46,9 +41,6 @@ static size_t getEltWidth(const size_t nbBits)
 
 ZL_Report EI_bitunpack(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -59,8 +51,6 @@ ZL_Report EI_bitunpack(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     const void* const src = ZL_Input_ptr(in);
     size_t const srcSize  = ZL_Input_numElts(in);
 
-    EI_bitunpack_contentsize += ZL_Input_contentSize(in);
-
     size_t const nbElts = srcSize * 8 / nbBits;
 
     // Make sure we fit well, and that remaining bits are zero
@@ -102,13 +92,6 @@ ZL_Report EI_bitunpack(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 
     ZL_Encoder_sendCodecHeader(eictx, &header, headerSize);
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_bitunpack_time_ms += current_duration;
-    fprintf(stderr, "[EI_bitunpack] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_bitunpack_time_ms, current_duration, EI_bitunpack_contentsize);
     return ZL_returnValue(1);
 }
 
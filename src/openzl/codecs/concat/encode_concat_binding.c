@@ -7,24 +7,8 @@
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_concat_serial_time_ms = 0.0;
-static double EI_concat_struct_time_ms = 0.0;
-static double EI_concat_numeric_time_ms = 0.0;
-static double EI_concat_string_time_ms = 0.0;
-
-static size_t EI_concat_serial_contentsize = 0;
-static size_t EI_concat_struct_contentsize = 0;
-static size_t EI_concat_numeric_contentsize = 0;
-static size_t EI_concat_string_contentsize = 0;
-
-
 ZL_Report EI_concat(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_GE(nbIns, 1);
     ZL_ASSERT_NN(ins);
     size_t nbElts   = 0;
@@ -108,34 +92,5 @@ ZL_Report EI_concat(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 
     ZL_RET_R_IF_ERR(ZL_Output_commit(out, nbElts));
     ZL_RET_R_IF_ERR(ZL_Output_commit(sizes, nbIns));
-
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-
-    switch (type){
-        case ZL_Type_serial:
-            EI_concat_serial_time_ms += current_duration;
-            EI_concat_serial_contentsize += nbElts * eltWidth;
-            fprintf(stderr, "[EI_concat_serial] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_concat_serial_time_ms, current_duration, EI_concat_serial_contentsize);
-            break;
-        case ZL_Type_struct:
-            EI_concat_struct_time_ms += current_duration;
-            EI_concat_struct_contentsize += nbElts * eltWidth;
-            fprintf(stderr, "[EI_concat_struct] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_concat_struct_time_ms, current_duration, EI_concat_struct_contentsize);
-            break;
-        case ZL_Type_numeric:
-            EI_concat_numeric_time_ms += current_duration;
-            EI_concat_numeric_contentsize += nbElts * eltWidth;
-            fprintf(stderr, "[EI_concat_numeric] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_concat_numeric_time_ms, current_duration, EI_concat_numeric_contentsize);
-            break;
-        case ZL_Type_string:
-            EI_concat_string_time_ms += current_duration;
-            EI_concat_string_contentsize += eltsCapacity;
-            fprintf(stderr, "[EI_concat_string] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_concat_string_time_ms, current_duration, EI_concat_string_contentsize);
-            break;
-    }
     return ZL_returnSuccess();
 }
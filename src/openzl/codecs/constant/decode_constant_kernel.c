@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "openzl/common/assertion.h"
+#include "openzl/shared/cpu.h"
 
 // Local noinline attribute for decode_constant_kernel
 #ifdef _MSC_VER
@@ -33,10 +34,12 @@ ZL_FORCE_INLINE void ZS_decodeConstant_impl_fallback(
     memcpy(nextElt, kEltBuffer, eltWidth);
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
 #    include <immintrin.h>
 
-ZL_FORCE_INLINE void ZS_decodeConstant_impl_avx2(
+ZL_TARGET_AVX2_BEGIN
+
+static ZL_CONSTANT_NOINLINE void ZS_decodeConstant_avx2(
         uint8_t* const dst,
         size_t const dstNbElts,
         const uint8_t* const src,
@@ -70,7 +73,9 @@ ZL_FORCE_INLINE void ZS_decodeConstant_impl_avx2(
             nextElt, remDstNbElts, src, eltWidth, kEltBuffer, kEltWidth);
 }
 
-#endif // ZL_HAS_AVX2
+ZL_TARGET_END
+
+#endif // ZL_CAN_AVX2
 
 ZL_FORCE_INLINE void ZS_decodeConstant_impl(
         uint8_t* const dst,
@@ -87,18 +92,15 @@ ZL_FORCE_INLINE void ZS_decodeConstant_impl(
             nextElt += kEltWidth;
         }
     } else {
-#if ZL_HAS_AVX2
-        if (eltWidth <= 16) {
-            ZS_decodeConstant_impl_avx2(
-                    dst, dstNbElts, src, eltWidth, kEltBuffer, kEltWidth);
-        } else {
-            ZS_decodeConstant_impl_fallback(
+#if ZL_CAN_AVX2
+        if (eltWidth <= 16 && ZL_cpuHas(ZL_CpuFeature_avx2)) {
+            ZS_decodeConstant_avx2(
                     dst, dstNbElts, src, eltWidth, kEltBuffer, kEltWidth);
+            return;
         }
-#else
+#endif
         ZS_decodeConstant_impl_fallback(
                 dst, dstNbElts, src, eltWidth, kEltBuffer, kEltWidth);
-#endif
     }
 }
 
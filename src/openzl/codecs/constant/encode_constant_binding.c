@@ -9,20 +9,9 @@
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_constant_typed_serial_time_ms = 0.0;
-static double EI_constant_typed_struct_time_ms = 0.0;
-
-static size_t EI_constant_typed_serial_contentsize = 0;
-static size_t EI_constant_typed_struct_contentsize = 0;
-
 ZL_Report
 EI_constant_typed(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -52,29 +41,5 @@ EI_constant_typed(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     ZS_encodeConstant(outPtr, src, eltWidth);
     ZL_RET_R_IF_ERR(ZL_Output_commit(out, 1));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-
-    ZL_Type currentType = ZL_Input_type(in);
-    switch (currentType){
-        case ZL_Type_serial:
-            EI_constant_typed_serial_time_ms += current_duration;
-            EI_constant_typed_serial_contentsize += ZL_Input_contentSize(in);
-            fprintf(stderr, "[EI_constant_typed_serial] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_constant_typed_serial_time_ms, current_duration, EI_constant_typed_serial_contentsize);
-            break;
-        case ZL_Type_struct:
-            EI_constant_typed_struct_time_ms += current_duration;
-            EI_constant_typed_struct_contentsize += ZL_Input_contentSize(in);
-            fprintf(stderr, "[EI_constant_typed_struct] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_constant_typed_struct_time_ms, current_duration, EI_constant_typed_struct_contentsize);
-            break;
-        case ZL_Type_numeric:
-            break;
-        case ZL_Type_string:
-            break;
-    }
-
     return ZL_returnSuccess();
 }
@@ -12,25 +12,6 @@
 #include "openzl/zl_ctransform.h"
 #include "openzl/zl_data.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_convert_serial_to_num8_time_ms = 0.0;
-static double EI_convert_serial_to_num_le16_time_ms = 0.0;
-static double EI_convert_serial_to_num_le32_time_ms = 0.0;
-static double EI_convert_serial_to_num_le64_time_ms = 0.0;
-
-static double EI_convert_serial_to_num_be16_time_ms = 0.0;
-static double EI_convert_serial_to_num_be32_time_ms = 0.0;
-static double EI_convert_serial_to_num_be64_time_ms = 0.0;
-
-static double EI_convert_serial_to_struct_time_ms = 0.0;
-
-static double EI_convert_num_to_struct_le_time_ms = 0.0;
-static double EI_convert_num_to_serial_le_time_ms = 0.0;
-static double EI_convert_struct_to_num_le_time_ms = 0.0;
-static double EI_convert_struct_to_serial_time_ms = 0.0;
-static double EI_separate_VSF_components_time_ms = 0.0;
-
 /* --------- Conversion transforms --------- */
 
 static ZL_Report convertToNumWithOptionalSwap(
@@ -102,18 +83,8 @@ ZL_Report EI_convert_serial_to_num8(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_convert_serial_to_num8_report = EI_convert_serial_to_num_generic(eictx, ins, nbIns, 1, !ZL_isLittleEndian());
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_num8_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_num_le8] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_num8_time_ms, current_duration);
-    return EI_convert_serial_to_num8_report;
+    return EI_convert_serial_to_num_generic(
+            eictx, ins, nbIns, 1, !ZL_isLittleEndian());
 }
 
 ZL_Report EI_convert_serial_to_num_le16(
@@ -121,18 +92,8 @@ ZL_Report EI_convert_serial_to_num_le16(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_convert_serial_to_num_le16_report = EI_convert_serial_to_num_generic(eictx, ins, nbIns, 2, !ZL_isLittleEndian());
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_num_le16_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_num_le16] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_num_le16_time_ms, current_duration);
-    return EI_convert_serial_to_num_le16_report;
+    return EI_convert_serial_to_num_generic(
+            eictx, ins, nbIns, 2, !ZL_isLittleEndian());
 }
 
 ZL_Report EI_convert_serial_to_num_le32(
@@ -140,18 +101,8 @@ ZL_Report EI_convert_serial_to_num_le32(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_convert_serial_to_num_le32_report = EI_convert_serial_to_num_generic(eictx, ins, nbIns, 4, !ZL_isLittleEndian());
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_num_le32_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_num_le32] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_num_le32_time_ms, current_duration);
-    return EI_convert_serial_to_num_le32_report;
+    return EI_convert_serial_to_num_generic(
+            eictx, ins, nbIns, 4, !ZL_isLittleEndian());
 }
 
 ZL_Report EI_convert_serial_to_num_le64(
@@ -159,19 +110,8 @@ ZL_Report EI_convert_serial_to_num_le64(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_convert_serial_to_num_le64_report = EI_convert_serial_to_num_generic(eictx, ins, nbIns, 8, !ZL_isLittleEndian());
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_num_le64_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_num_le64] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_num_le64_time_ms, current_duration);
-
-    return EI_convert_serial_to_num_le64_report;
+    return EI_convert_serial_to_num_generic(
+            eictx, ins, nbIns, 8, !ZL_isLittleEndian());
 }
 
 ZL_Report EI_convert_serial_to_num_be16(
@@ -179,19 +119,8 @@ ZL_Report EI_convert_serial_to_num_be16(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_convert_serial_to_num_be16_report = EI_convert_serial_to_num_generic(eictx, ins, nbIns, 2, ZL_isLittleEndian());
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_num_be16_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_num_be16] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_num_be16_time_ms, current_duration);
-
-    return EI_convert_serial_to_num_be16_report;
+    return EI_convert_serial_to_num_generic(
+            eictx, ins, nbIns, 2, ZL_isLittleEndian());
 }
 
 ZL_Report EI_convert_serial_to_num_be32(
@@ -199,18 +128,8 @@ ZL_Report EI_convert_serial_to_num_be32(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_convert_serial_to_num_be32_report = EI_convert_serial_to_num_generic(eictx, ins, nbIns, 4, ZL_isLittleEndian());
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_num_be32_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_num_be32] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_num_be32_time_ms, current_duration);
-    return EI_convert_serial_to_num_be32_report;
+    return EI_convert_serial_to_num_generic(
+            eictx, ins, nbIns, 4, ZL_isLittleEndian());
 }
 
 ZL_Report EI_convert_serial_to_num_be64(
@@ -218,18 +137,8 @@ ZL_Report EI_convert_serial_to_num_be64(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_convert_serial_to_num_be64_report = EI_convert_serial_to_num_generic(eictx, ins, nbIns, 8, ZL_isLittleEndian());
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_num_be64_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_num_be64] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_num_be64_time_ms, current_duration);
-    return EI_convert_serial_to_num_be64_report;
+    return EI_convert_serial_to_num_generic(
+            eictx, ins, nbIns, 8, ZL_isLittleEndian());
 }
 
 static ZL_Report EI_convert_serial_to_struct_generic(
@@ -255,9 +164,6 @@ ZL_Report EI_convert_serial_to_struct(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -268,17 +174,8 @@ ZL_Report EI_convert_serial_to_struct(
     ZL_RET_R_IF_EQ(
             nodeParameter_invalid, tokenSize.paramId, ZL_LP_INVALID_PARAMID);
     ZL_RET_R_IF_LE(nodeParameter_invalidValue, tokenSize.paramValue, 0);
-    ZL_Report EI_convert_serial_to_struct_report = EI_convert_serial_to_struct_generic(eictx, in, (size_t)tokenSize.paramValue);
-
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_serial_to_struct_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_serial_to_struct] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_serial_to_struct_time_ms, current_duration);
-
-    return EI_convert_serial_to_struct_report;
+    return EI_convert_serial_to_struct_generic(
+            eictx, in, (size_t)tokenSize.paramValue);
 }
 
 ZL_Report EI_convert_struct_to_num_le(
@@ -286,23 +183,11 @@ ZL_Report EI_convert_struct_to_num_le(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
-    ZL_Report EI_convert_struct_to_num_le_report = convertToNumWithOptionalSwap(eictx, in, ZL_Input_eltWidth(in), !ZL_isLittleEndian());
-
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_struct_to_num_le_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_struct_to_num_le] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_struct_to_num_le_time_ms, current_duration);
-
-    return EI_convert_struct_to_num_le_report;
+    return convertToNumWithOptionalSwap(
+            eictx, in, ZL_Input_eltWidth(in), !ZL_isLittleEndian());
 }
 
 ZL_Report EI_convert_struct_to_num_be(
@@ -324,9 +209,6 @@ ZL_Report EI_convert_num_to_struct_le(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -342,14 +224,6 @@ ZL_Report EI_convert_num_to_struct_le(
     ZL_RET_R_IF_NULL(
             allocation, ENC_refTypedStream(eictx, 0, eltWidth, nbElts, in, 0));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-    double current_duration = end_time_ms - start_time_ms;
-
-    EI_convert_num_to_struct_le_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_num_to_struct_le] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_num_to_struct_le_time_ms, current_duration);
     return ZL_returnValue(1);
 }
 
@@ -372,8 +246,6 @@ ZL_Report EI_convert_num_to_serial_le(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -388,16 +260,7 @@ ZL_Report EI_convert_num_to_serial_le(
     uint8_t header[1]  = { (uint8_t)ZL_nextPow2(eltWidth) };
     size_t const hSize = sizeof(header);
     ZL_Encoder_sendCodecHeader(eictx, header, hSize);
-    ZL_Report EI_convert_num_to_serial_le_report = EI_convert_to_serial(eictx, ins, nbIns);
-
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_num_to_serial_le_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_num_to_serial_le] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_num_to_serial_le_time_ms, current_duration);
-    return EI_convert_num_to_serial_le_report;
+    return EI_convert_to_serial(eictx, ins, nbIns);
 }
 
 #include "openzl/shared/varint.h"
@@ -406,10 +269,6 @@ ZL_Report EI_convert_struct_to_serial(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -422,16 +281,7 @@ ZL_Report EI_convert_struct_to_serial(
     ZL_ASSERT_LE(hSize, sizeof(header));
     ZL_ASSERT_NN(eictx);
     ZL_Encoder_sendCodecHeader(eictx, header, hSize);
-    ZL_Report EI_convert_to_serial_report = EI_convert_to_serial(eictx, ins, nbIns);
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_convert_struct_to_serial_time_ms += current_duration;
-    fprintf(stderr, "[EI_convert_struct_to_serial] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_convert_struct_to_serial_time_ms, current_duration);
-    return EI_convert_to_serial_report;
+    return EI_convert_to_serial(eictx, ins, nbIns);
 }
 
 ZL_Report EI_separate_VSF_components(
@@ -439,9 +289,6 @@ ZL_Report EI_separate_VSF_components(
         const ZL_Input* ins[],
         size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -458,14 +305,6 @@ ZL_Report EI_separate_VSF_components(
     NUMOP_writeNumerics_fromU32(dst, numWidth, fieldSizes, nbFields);
     ZL_RET_R_IF_ERR(ZL_Output_commit(sizeStream, nbFields));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_separate_VSF_components_time_ms += current_duration;
-    fprintf(stderr, "[EI_separate_VSF_components] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_separate_VSF_components_time_ms, current_duration);
-
     return ZL_returnValue(2);
 }
 
@@ -15,11 +15,6 @@
 #include "openzl/zl_localParams.h"
 #include "openzl/zl_public_nodes.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_setStringLens_time_ms = 0.0;
-static size_t EI_setStringLens_contentsize = 0;
-
 /* ----- Set String Sizes --------- */
 
 struct ZL_SetStringLensState_s {
@@ -74,9 +69,6 @@ static ZL_SetStringLensInstructions getStringLens(
 ZL_Report
 EI_setStringLens(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -115,15 +107,6 @@ EI_setStringLens(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 
     ZL_RET_R_IF_ERR(ZL_Output_commit(out, nbStrings));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_setStringLens_time_ms += current_duration;
-    EI_setStringLens_contentsize += ZL_Input_contentSize(in);
-    fprintf(stderr, "[EI_setStringLens] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f | content_size: %zu\n", start_time_ms, end_time_ms, EI_setStringLens_time_ms, current_duration, EI_setStringLens_contentsize);
-
     return ZL_returnSuccess();
 }
 
@@ -21,6 +21,7 @@
 #include "openzl/codecs/merge_sorted/decode_merge_sorted_binding.h"
 #include "openzl/codecs/parse_int/decode_parse_int_binding.h"
 #include "openzl/codecs/parse_int/graph_parse_int.h"
+#include "openzl/codecs/pfor/decode_pfor_binding.h"
 #include "openzl/codecs/prefix/decode_prefix_binding.h"
 #include "openzl/codecs/quantize/decode_quantize_binding.h"
 #include "openzl/codecs/range_pack/decode_range_pack_binding.h"
@@ -103,6 +104,8 @@ const StandardDTransform SDecoders_array[ZL_StandardTransformID_end] = {
     REGISTER_TTRANSFORM(ZL_StandardTransformID_fse_ncount, 15, FSE_NCOUNT),
     REGISTER_TTRANSFORM(ZL_StandardTransformID_huffman_v2, 15, HUFFMAN_V2),
     REGISTER_TTRANSFORM(ZL_StandardTransformID_huffman_struct_v2, 15, HUFFMAN_STRUCT_V2),
+    REGISTER_TTRANSFORM(ZL_StandardTransformID_rans, 22, RANS),
+    REGISTER_TTRANSFORM(ZL_StandardTransformID_rans_struct, 22, RANS_STRUCT),
     REGISTER_DEPRECATED_TTRANSFORM_G(ZL_StandardTransformID_rolz, 3, 12, DI_ROLZ, PIPE_GRAPH),
     REGISTER_DEPRECATED_TTRANSFORM_G(ZL_StandardTransformID_fastlz, 3, 12, DI_FASTLZ, PIPE_GRAPH),
     REGISTER_TTRANSFORM_G(ZL_StandardTransformID_zstd, 3, DI_ZSTD, PIPE_GRAPH),
@@ -115,6 +118,8 @@ const StandardDTransform SDecoders_array[ZL_StandardTransformID_end] = {
     REGISTER_TTRANSFORM(ZL_StandardTransformID_float_deconstruct, 4, FLOAT_DECONSTRUCT),
     REGISTER_TTRANSFORM(ZL_StandardTransformID_bitunpack, 6, BITUNPACK),
     REGISTER_TTRANSFORM(ZL_StandardTransformID_range_pack, 8, RANGE_PACK),
+    REGISTER_TTRANSFORM(ZL_StandardTransformID_pfor, 22, PFOR),
+    REGISTER_TTRANSFORM(ZL_StandardTransformID_dedup_chunks, 22, DEDUP_CHUNKS),
     REGISTER_TTRANSFORM(ZL_StandardTransformID_tokenize_fixed, 8, TOKENIZE_FIXED),
     REGISTER_TTRANSFORM(ZL_StandardTransformID_tokenize_numeric, 8, TOKENIZE_NUMERIC),
     REGISTER_TTRANSFORM(ZL_StandardTransformID_tokenize_string, 11, TOKENIZE_VSF),
@@ -0,0 +1,59 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/dedup/decode_cdc_kernel.h"
+
+#include <string.h> // memcpy
+
+#include "openzl/common/assertion.h"
+
+ZL_Report ZS_cdcDecodedSize(
+        size_t* uniqueOffsets,
+        uint32_t const* uniqueSizes,
+        size_t nbUnique,
+        size_t uniqueSize,
+        uint32_t const* refs,
+        size_t nbChunks)
+{
+    size_t offset = 0;
+    for (size_t n = 0; n < nbUnique; ++n) {
+        uniqueOffsets[n] = offset;
+        offset += uniqueSizes[n];
+        ZL_RET_R_IF_GT(corruption, offset, uniqueSize);
+    }
+    ZL_RET_R_IF_NE(
+            corruption, offset, uniqueSize, "Incorrect sum of chunk sizes");
+
+    // Unique chunks must be referenced in order of first occurrence
+    size_t nextUnique = 0;
+    size_t dstSize    = 0;
+    for (size_t n = 0; n < nbChunks; ++n) {
+        uint32_t const ref = refs[n];
+        ZL_RET_R_IF_GT(corruption, ref, nextUnique, "Reference out of order");
+        ZL_RET_R_IF_EQ(corruption, ref, nbUnique, "Reference out of bounds");
+        nextUnique += (ref == nextUnique);
+        ZL_RET_R_IF(
+                integerOverflow,
+                dstSize > SIZE_MAX - uniqueSizes[ref],
+                "Regenerated size overflows");
+        dstSize += uniqueSizes[ref];
+    }
+    ZL_RET_R_IF_NE(
+            corruption, nextUnique, nbUnique, "Unreferenced unique chunks");
+    return ZL_returnValue(dstSize);
+}
+
+void ZS_cdcDecode(
+        uint8_t* dst,
+        uint8_t const* unique,
+        size_t const* uniqueOffsets,
+        uint32_t const* uniqueSizes,
+        uint32_t const* refs,
+        size_t nbChunks)
+{
+    uint8_t* op = dst;
+    for (size_t n = 0; n < nbChunks; ++n) {
+        uint32_t const ref = refs[n];
+        memcpy(op, unique + uniqueOffsets[ref], uniqueSizes[ref]);
+        op += uniqueSizes[ref];
+    }
+}
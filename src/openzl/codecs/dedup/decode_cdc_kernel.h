@@ -0,0 +1,45 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_DEDUP_DECODE_CDC_KERNEL_H
+#define ZSTRONG_TRANSFORMS_DEDUP_DECODE_CDC_KERNEL_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uintX_t
+
+#include "openzl/shared/portability.h"
+#include "openzl/zl_errors.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * Validates the chunk references, and computes the position of each
+ * unique chunk. See encode_cdc_kernel.h for the format.
+ *
+ * @param uniqueOffsets Capacity nbUnique, filled with the position of each
+ * unique chunk within the concatenation of unique chunks
+ * @returns the regenerated size
+ */
+ZL_Report ZS_cdcDecodedSize(
+        size_t* uniqueOffsets,
+        uint32_t const* uniqueSizes,
+        size_t nbUnique,
+        size_t uniqueSize,
+        uint32_t const* refs,
+        size_t nbChunks);
+
+/**
+ * Regenerates the source, by copying each referenced chunk.
+ * @pre The references have been validated by ZS_cdcDecodedSize(),
+ * and @p dst has the capacity it returned.
+ */
+void ZS_cdcDecode(
+        uint8_t* dst,
+        uint8_t const* unique,
+        size_t const* uniqueOffsets,
+        uint32_t const* uniqueSizes,
+        uint32_t const* refs,
+        size_t nbChunks);
+
+ZL_END_C_DECLS
+
+#endif
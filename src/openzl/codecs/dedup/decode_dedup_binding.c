@@ -2,8 +2,10 @@
 
 #include "openzl/codecs/dedup/decode_dedup_binding.h"
 
+#include "openzl/codecs/dedup/decode_cdc_kernel.h"
 #include "openzl/common/assertion.h"
 #include "openzl/decompress/dictx.h" // DI_outStream_asReference
+#include "openzl/shared/numeric_operations.h"
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 
@@ -34,3 +36,60 @@ ZL_Report DI_dedup_num(
     }
     return ZL_returnSuccess();
 }
+
+ZL_Report DI_dedup_chunks(ZL_Decoder* dictx, const ZL_Input* ins[])
+{
+    ZL_ASSERT_NN(dictx);
+    ZL_ASSERT_NN(ins);
+    const ZL_Input* const unique      = ins[0];
+    const ZL_Input* const uniqueSizes = ins[1];
+    const ZL_Input* const refs        = ins[2];
+    ZL_ASSERT_EQ(ZL_Input_type(unique), ZL_Type_serial);
+    ZL_ASSERT_EQ(ZL_Input_type(uniqueSizes), ZL_Type_numeric);
+    ZL_ASSERT_EQ(ZL_Input_type(refs), ZL_Type_numeric);
+    size_t const nbUnique = ZL_Input_numElts(uniqueSizes);
+    size_t const nbChunks = ZL_Input_numElts(refs);
+    ZL_RET_R_IF_GT(
+            corruption,
+            nbUnique,
+            nbChunks,
+            "More unique chunks than chunks");
+
+    uint32_t* const sizes32 =
+            ZL_Decoder_getScratchSpace(dictx, nbUnique * sizeof(uint32_t));
+    ZL_RET_R_IF_NULL(allocation, sizes32);
+    uint32_t* const refs32 =
+            ZL_Decoder_getScratchSpace(dictx, nbChunks * sizeof(uint32_t));
+    ZL_RET_R_IF_NULL(allocation, refs32);
+    size_t* const offsets =
+            ZL_Decoder_getScratchSpace(dictx, nbUnique * sizeof(size_t));
+    ZL_RET_R_IF_NULL(allocation, offsets);
+    ZL_RET_R_IF_ERR(NUMOP_write32_fromNumerics(
+            sizes32,
+            nbUnique,
+            ZL_Input_ptr(uniqueSizes),
+            ZL_Input_eltWidth(uniqueSizes)));
+    ZL_RET_R_IF_ERR(NUMOP_write32_fromNumerics(
+            refs32, nbChunks, ZL_Input_ptr(refs), ZL_Input_eltWidth(refs)));
+
+    ZL_TRY_LET_R(
+            dstSize,
+            ZS_cdcDecodedSize(
+                    offsets,
+                    sizes32,
+                    nbUnique,
+                    ZL_Input_numElts(unique),
+                    refs32,
+                    nbChunks));
+    ZL_Output* const out = ZL_Decoder_create1OutStream(dictx, dstSize, 1);
+    ZL_RET_R_IF_NULL(allocation, out);
+    ZS_cdcDecode(
+            ZL_Output_ptr(out),
+            ZL_Input_ptr(unique),
+            offsets,
+            sizes32,
+            refs32,
+            nbChunks);
+    ZL_RET_R_IF_ERR(ZL_Output_commit(out, dstSize));
+    return ZL_returnValue(1);
+}
@@ -22,6 +22,14 @@ ZL_Report DI_dedup_num(
         .transform_f = DI_dedup_num, .name = "dedup_num_decoder" \
     }
 
+// dedup_chunks decoder: regenerates the serial input from its unique chunks
+ZL_Report DI_dedup_chunks(ZL_Decoder* dictx, const ZL_Input* ins[]);
+
+#define DI_DEDUP_CHUNKS(id)                                    \
+    {                                                          \
+        .transform_f = DI_dedup_chunks, .name = "dedup_chunks" \
+    }
+
 ZL_END_C_DECLS
 
 #endif
@@ -0,0 +1,363 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/dedup/encode_cdc_kernel.h"
+
+#include <string.h> // memcmp, memcpy
+
+#include "openzl/common/assertion.h"
+#include "openzl/common/map.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/cpu.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+#include "openzl/shared/xxhash.h"
+
+/* Gear hash : h = (h << 1) + gear[byte]. Each byte is shifted out after
+ * 64 steps, so the hash at position i only depends on src[i-63..i].
+ * Random values, generated with splitmix64. */
+static uint64_t const ZS_cdcGear[256] = {
+    0xA81C83B8D847A417ULL, 0x0A84C4AF74A8BBCFULL, 0x45896A166A808038ULL,
+    0x28EEA1CDE346DA54ULL, 0x057D527730A0E676ULL, 0x866383D9D07DE35EULL,
+    0x15ABA267AE7D1478ULL, 0x12B713E726BB11C5ULL, 0x73DC420C86C7E3AAULL,
+    0xC06233AF3106EBAEULL, 0xFF5B8C3B6C811FACULL, 0x4673B9A5035847DCULL,
+    0x91A16859077920E9ULL, 0x95F823AC610C65B5ULL, 0xC3B202E8029178DDULL,
+    0xBA0D865F85C01831ULL, 0x0F72D77B395C3374ULL, 0xDD3D58C84CD02DA2ULL,
+    0x85EA660F666B2BB7ULL, 0x3A19CA1E6DC56A19ULL, 0xB3CF81BE4AA2EBD4ULL,
+    0xB9D428F710384EA2ULL, 0xA1F6295A41604ECEULL, 0xAF20DA28E0B2F0BBULL,
+    0x0EA5696D09F3C97BULL, 0x71699A0B7C89B383ULL, 0xFC1734CCD57898B0ULL,
+    0xF2BD56242B0E8C93ULL, 0xD14A00D49C95CDB4ULL, 0xCCA3F142E00F0239ULL,
+    0x021ADF3E58B9A674ULL, 0x172A3FD3FC812CCAULL, 0x6739EDC366FABC22ULL,
+    0x3913F82191FE1AD1ULL, 0x79D01BF5A743BD94ULL, 0x30A774C25C4CEFB9ULL,
+    0x479BCC94592886BDULL, 0x1D0A5B47834A1C8EULL, 0x20EB4339A68D85A5ULL,
+    0x3D01A4C778D0F24FULL, 0x46CE228A0310732BULL, 0x1BF5DD8557A2F3B1ULL,
+    0xB19F2CD5A588400DULL, 0xBB65F3DECD69F1EDULL, 0xF3D33FEDE9EC09B6ULL,
+    0xA043ED16F450FE63ULL, 0x03360CA6A76D4E63ULL, 0x5563ADE51525E038ULL,
+    0x16C7AA7CD4E77A10ULL, 0xFB7F6E9FFC940DC2ULL, 0xA1139D6C7A391447ULL,
+    0x3D79E8F902306D97ULL, 0xF10FEC9AE01D82BDULL, 0xD4C6FF3F3505F80AULL,
+    0xBBD6CBF64E34192EULL, 0xFF10F9A31F934E2EULL, 0x106CDFA1FE8EBCB2ULL,
+    0x8F107D555C1F25DBULL, 0x63C91A395D37DD93ULL, 0x8086FB09F3CB1F6FULL,
+    0x2E19A47160E297E9ULL, 0x509E7AC3E989E43CULL, 0x0533C078921F4213ULL,
+    0x4DF3B7CC7BB4E517ULL, 0x88AC661C3523C977ULL, 0x33C56C5152C8F05DULL,
+    0xA44EFE501E318797ULL, 0xC544BEFBD1F13EB2ULL, 0x674556A15A4EEF65ULL,
+    0x1D6394546B03DF06ULL, 0x85D332483BA3D05AULL, 0x557CEBB9253E02A7ULL,
+    0x11A2B1C6DD42778BULL, 0x7E5F0C443846692FULL, 0x405EC9FED00DBC1CULL,
+    0xCEDB80F0CBA44834ULL, 0xE74B768D45FFC199ULL, 0x26416B122A652F96ULL,
+    0x06EEC32165EF1755ULL, 0xA0A61940092E24C4ULL, 0xC13BBAEAC00F37FDULL,
+    0x75A2104A6F6FBD1AULL, 0x2FF850A8A75E03F3ULL, 0xB379C3B7AD32C5E2ULL,
+    0x466B7A0F2834E8B7ULL, 0xDDA1638FDD7EED62ULL, 0xF4E7C2F27C30BB05ULL,
+    0xFD2FC21E1A4CE61AULL, 0x1CED4CB211A4DA3BULL, 0xC37556CE432C0A52ULL,
+    0x5D34D73F1DF03BF4ULL, 0x49BEB7344DC3F9B5ULL, 0xBA98BBA735A61A84ULL,
+    0x2F9A9E1F2ACAC5FAULL, 0x603275A96A7889C9ULL, 0x47969562DAF53DA6ULL,
+    0xE8A653F3D5D7CE2EULL, 0x9498A84D0AFBF263ULL, 0x1AFC3838E80D4861ULL,
+    0x2905A7924A7396B2ULL, 0xF67866BD1A7B77C1ULL, 0xFAF0EA43A8C703F3ULL,
+    0x4CBA3A46D9D94D0DULL, 0x8203B4A70524974CULL, 0x90A70AE26769E939ULL,
+    0xE39E9A65225B973AULL, 0xF50AFE30BB7A258FULL, 0x6B1DB371E0FD4663ULL,
+    0x69919A3C5A99EBB0ULL, 0x98A725911D863662ULL, 0x639B2A0B23F64635ULL,
+    0x4F427C23C3AD843CULL, 0x2B2BA8D7E4D1D32CULL, 0x805542F3A05C847AULL,
+    0x4BE9EB1AA329335BULL, 0x8E29FBA1C67CC826ULL, 0x9EAF776EC3AA4D36ULL,
+    0x6D4DE2CEFB30D47DULL, 0xEDFF44F1CC553BC1ULL, 0x06BDC87CB35FF405ULL,
+    0x70F5DCF91940F8D5ULL, 0xA614FFEDDD3A85C7ULL, 0x00D926DEC7256613ULL,
+    0x0D0202EE732F99B9ULL, 0x052A6E7F8ECB1CE4ULL, 0x2CA4DE4261A4EFE7ULL,
+    0x09E72C2366819860ULL, 0x8D8293607CA8FCB9ULL, 0x13736D4B9E32DD7FULL,
+    0xEF9737C6321806D5ULL, 0xB59E7133A092A0F6ULL, 0x2F41A6517FC0C6A0ULL,
+    0xE44987CC7E1AD4FFULL, 0xFC9639AA8E10AF5AULL, 0x1AB7B3BE1995EDA0ULL,
+    0x2876B5A9C052FF11ULL, 0x636A47931C84C6D3ULL, 0xD1E7C6A9CBA7C2BDULL,
+    0xCB312B54F7186B44ULL, 0x62F2F49674A12DFBULL, 0x64586EE76E496896ULL,
+    0xB4DDE6EC7622CEFCULL, 0x6217D450D728A12BULL, 0x816B39B24F1C2C53ULL,
+    0x97D32819D92D39B9ULL, 0x6A6BF4C9EC162F91ULL, 0x793E7BC0E4D52AF7ULL,
+    0xCCFCE2E2ABC6B202ULL, 0xBC2F6BE0CBE73477ULL, 0xB0C4DB8B97F99C27ULL,
+    0x6FE17D4C319B898AULL, 0x5E96DAC36A3BA725ULL, 0x76FB1D20F0CCEFF1ULL,
+    0xF023B119E158F435ULL, 0x3905A48E401071E8ULL, 0xA858AF3F80335171ULL,
+    0x7DF2F50AA133239BULL, 0xF0D70A4D7AFE7248ULL, 0xD620BB6CF0BE933CULL,
+    0x6F02FA558DF6FF69ULL, 0x2F608A04A11308DFULL, 0xD86D7AA913289F38ULL,
+    0xD1434E05053708F1ULL, 0xB0980B400AFBBDF2ULL, 0x5E18412532A4D231ULL,
+    0xAB9154864CBBDD11ULL, 0x84DF065D39FA4239ULL, 0x6F8B80C090C7B8E0ULL,
+    0xB4993C7BC649B5CDULL, 0x908F38FEA7FEE5A4ULL, 0xE646A6121014DBCCULL,
+    0xCACC3D8F5E701AC8ULL, 0x3A5200C2E156429EULL, 0x948813C4F508BD53ULL,
+    0xF65E7D4421733ED5ULL, 0xCAE3289650F9AE12ULL, 0x42335D1764DC5F57ULL,
+    0x829CB74EC010C152ULL, 0x08A7B0C4CB3FEC87ULL, 0x8BC83A534C1317D5ULL,
+    0x92DFC2F82F3ADC85ULL, 0x5EEBEAD814AE2E25ULL, 0x6240C96892640A6AULL,
+    0x927E568DB85919B0ULL, 0xF89ADC1677C47269ULL, 0x726ABC82EEC147B6ULL,
+    0x4ABD31EB696A355AULL, 0xE10BD87032A622E3ULL, 0xC13ACE5B2DECEB31ULL,
+    0x63A3AA1760DCF2C6ULL, 0x0762915DD5A534C7ULL, 0xF1EF71DF3592CAF6ULL,
+    0xBDCFE048072AB81AULL, 0x8EA22546EA374206ULL, 0x18C3C5737409B5CCULL,
+    0xAA23B77DA18B0C1AULL, 0x153A77D60EC706D6ULL, 0xD3E8BF51272CA0E0ULL,
+    0x5F8279DC02C84578ULL, 0x18FDECB36F5A9068ULL, 0xF1CAC15FA1CEBB5FULL,
+    0x0BB771BCA0095415ULL, 0x9CD6A9E81062A4A7ULL, 0x5165EA901BF32CE1ULL,
+    0x1FA3EF001BDEA827ULL, 0x0FED1D20EE5D61FFULL, 0xB443CB9E01050C92ULL,
+    0xBD132D42223F8A8FULL, 0x89C84B34BA3A250DULL, 0x800A9392546F8A14ULL,
+    0xD2313B02D75D03F7ULL, 0x511AC20EB2B1C518ULL, 0x74A1E8FAFED8AD91ULL,
+    0x34F3CC741AF5F657ULL, 0xC427AE4E757D33FBULL, 0xDC085AED8D7D2CCBULL,
+    0x8DF454E4F250E5AFULL, 0x84E1C1EE4E75D3BEULL, 0xA123DE55627B60EFULL,
+    0x02D74ECC1E926855ULL, 0x16CBE62B56268BE6ULL, 0xEFC75A01DEEA725EULL,
+    0x02C200EF4FC93380ULL, 0x1BCDFC44B00915ACULL, 0x65AA96602B7F3BF0ULL,
+    0xCEF16C6FCA5F7657ULL, 0xDC33021C6F897205ULL, 0x28B90A93C85CE2AEULL,
+    0xDD4820B97C78C451ULL, 0xE5708401C7BCC47BULL, 0xA05E0DC1BE8F185CULL,
+    0xF9BF42D9D7172CA7ULL, 0x10668455D29C3711ULL, 0x5DA1686474C7C169ULL,
+    0xCEBEEAA332925CD5ULL, 0xE283C4E45F30F297ULL, 0x766CF7BD97D20AF5ULL,
+    0x41EF87D6BBDFD830ULL, 0xDDA7F06B00AE83F1ULL, 0x6314C9D157BFF1BAULL,
+    0x66008E1FED472834ULL, 0x9FB5C99644A75ADEULL, 0xCEFF845F6E645D90ULL,
+    0x4912503E7062E9C8ULL, 0xF34C8E05FC053F01ULL, 0x9875C71DDC5B8E10ULL,
+    0x943D594D4A5DA26DULL, 0xF7FB2F29F5223B76ULL, 0xFE2B579D535A5B2EULL,
+    0x808B7B32ABB078A0ULL, 0x8B8B9FD625184406ULL, 0xAE6E795EA376EA4DULL,
+    0x52D6AF98F194DEDFULL, 0x9D939360A6696793ULL, 0x89FC3C962DC934F8ULL,
+    0x92CF48CE2D8794EEULL,
+};
+
+ZS_CdcParams ZS_cdcParams(size_t avgChunkSize)
+{
+    ZL_ASSERT_GE(avgChunkSize, ZS_CDC_AVG_CHUNK_SIZE_MIN);
+    ZL_ASSERT_LE(avgChunkSize, ZS_CDC_AVG_CHUNK_SIZE_MAX);
+    unsigned const maskBits = (unsigned)ZL_highbit64(avgChunkSize);
+    size_t const avg        = (size_t)1 << maskBits;
+    ZS_CdcParams const params = {
+        .minChunkSize = avg / 4,
+        .maxChunkSize = avg * 8,
+        .maskBits     = maskBits,
+    };
+    return params;
+}
+
+size_t ZS_cdcMaxNbChunks(size_t srcSize, ZS_CdcParams const* params)
+{
+    // All chunks but the last one are at least minChunkSize bytes
+    return srcSize / params->minChunkSize + 1;
+}
+
+size_t ZS_cdcCandidatesWords(size_t srcSize)
+{
+    return (srcSize + 63) / 64;
+}
+
+/// @returns the gear hash of the bytes preceding @p pos
+static uint64_t ZS_cdcWarmUp(uint8_t const* src, size_t pos)
+{
+    uint64_t h = 0;
+    for (size_t i = pos >= ZS_CDC_WINDOW_SIZE - 1
+                 ? pos - (ZS_CDC_WINDOW_SIZE - 1)
+                 : 0;
+         i < pos;
+         ++i) {
+        h = (h << 1) + ZS_cdcGear[src[i]];
+    }
+    return h;
+}
+
+/// Marks the candidates of [begin, end)
+/// @pre begin is a multiple of 64
+static void ZS_cdcFindCandidates_scalar(
+        uint64_t* candidates,
+        uint8_t const* src,
+        size_t begin,
+        size_t end,
+        uint64_t mask)
+{
+    ZL_ASSERT_EQ(begin % 64, 0);
+    uint64_t h = ZS_cdcWarmUp(src, begin);
+    for (size_t w = begin; w < end; w += 64) {
+        size_t const wEnd = ZL_MIN(w + 64, end);
+        uint64_t bits     = 0;
+        for (size_t i = w; i < wEnd; ++i) {
+            h = (h << 1) + ZS_cdcGear[src[i]];
+            bits |= (uint64_t)((h & mask) == 0) << (i - w);
+        }
+        candidates[w / 64] = bits;
+    }
+}
+
+#if ZL_CAN_AVX2
+#    include <immintrin.h>
+
+#    define ZS_CDC_NB_LANES 8
+
+ZL_TARGET_AVX2_BEGIN
+
+/// Advances the hashes of 4 lanes by 1 byte, and marks their candidates
+ZL_FORCE_INLINE __m256i ZS_cdcStep_avx2(
+        __m256i* h,
+        __m256i* bits,
+        __m256i bytes,
+        __m256i bit,
+        __m256i mask)
+{
+    __m256i const g = _mm256_i64gather_epi64(
+            (void const*)ZS_cdcGear,
+            _mm256_and_si256(bytes, _mm256_set1_epi64x(0xFF)),
+            8);
+    *h                = _mm256_add_epi64(_mm256_slli_epi64(*h, 1), g);
+    __m256i const hit = _mm256_cmpeq_epi64(
+            _mm256_and_si256(*h, mask), _mm256_setzero_si256());
+    *bits = _mm256_or_si256(*bits, _mm256_and_si256(hit, bit));
+    return _mm256_srli_epi64(bytes, 8);
+}
+
+/**
+ * Marks the candidates of [0, ZS_CDC_NB_LANES * regionSize), cut in one
+ * region per lane. Each lane starts from the hash of the bytes preceding its
+ * region, so the result is the same as a sequential scan.
+ * @pre regionSize is a multiple of 64
+ */
+static void ZS_cdcFindCandidates_avx2(
+        uint64_t* candidates,
+        uint8_t const* src,
+        size_t regionSize,
+        uint64_t mask)
+{
+    ZL_ASSERT_EQ(regionSize % 64, 0);
+    size_t const r = regionSize;
+    uint64_t init[ZS_CDC_NB_LANES];
+    for (size_t k = 0; k < ZS_CDC_NB_LANES; ++k) {
+        init[k] = ZS_cdcWarmUp(src, k * r);
+    }
+    __m256i h0          = _mm256_loadu_si256((__m256i_u const*)(init + 0));
+    __m256i h1          = _mm256_loadu_si256((__m256i_u const*)(init + 4));
+    __m256i const maskV = _mm256_set1_epi64x((long long)mask);
+
+    for (size_t w = 0; w < r; w += 64) {
+        __m256i bits0 = _mm256_setzero_si256();
+        __m256i bits1 = _mm256_setzero_si256();
+        __m256i bit   = _mm256_set1_epi64x(1);
+        for (size_t j = 0; j < 64; j += 8) {
+            uint8_t const* const p = src + w + j;
+            __m256i b0             = _mm256_setr_epi64x(
+                    (long long)ZL_readLE64(p + 0 * r),
+                    (long long)ZL_readLE64(p + 1 * r),
+                    (long long)ZL_readLE64(p + 2 * r),
+                    (long long)ZL_readLE64(p + 3 * r));
+            __m256i b1 = _mm256_setr_epi64x(
+                    (long long)ZL_readLE64(p + 4 * r),
+                    (long long)ZL_readLE64(p + 5 * r),
+                    (long long)ZL_readLE64(p + 6 * r),
+                    (long long)ZL_readLE64(p + 7 * r));
+            for (size_t i = 0; i < 8; ++i) {
+                b0  = ZS_cdcStep_avx2(&h0, &bits0, b0, bit, maskV);
+                b1  = ZS_cdcStep_avx2(&h1, &bits1, b1, bit, maskV);
+                bit = _mm256_slli_epi64(bit, 1);
+            }
+        }
+        uint64_t out[ZS_CDC_NB_LANES];
+        _mm256_storeu_si256((__m256i_u*)(out + 0), bits0);
+        _mm256_storeu_si256((__m256i_u*)(out + 4), bits1);
+        for (size_t k = 0; k < ZS_CDC_NB_LANES; ++k) {
+            candidates[(k * r + w) / 64] = out[k];
+        }
+    }
+}
+
+ZL_TARGET_END
+
+#endif // ZL_CAN_AVX2
+
+void ZS_cdcFindCandidates(
+        uint64_t* candidates,
+        void const* src,
+        size_t srcSize,
+        unsigned maskBits)
+{
+    ZL_ASSERT_GE(maskBits, 1);
+    ZL_ASSERT_LT(maskBits, 64);
+    uint8_t const* const ip = (uint8_t const*)src;
+    uint64_t const mask     = UINT64_MAX << (64 - maskBits);
+    size_t begin            = 0;
+#if ZL_CAN_AVX2
+    // Lanes only pay off when each one gets enough bytes past its warm-up
+    size_t const regionSize = (srcSize / ZS_CDC_NB_LANES) & ~(size_t)63;
+    if (regionSize >= 16 * ZS_CDC_WINDOW_SIZE
+        && ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        ZS_cdcFindCandidates_avx2(candidates, ip, regionSize, mask);
+        begin = ZS_CDC_NB_LANES * regionSize;
+    }
+#endif
+    ZS_cdcFindCandidates_scalar(candidates, ip, begin, srcSize, mask);
+}
+
+size_t ZS_cdcNextBoundary(
+        uint64_t const* candidates,
+        size_t start,
+        size_t srcSize,
+        ZS_CdcParams const* params)
+{
+    ZL_ASSERT_LT(start, srcSize);
+    if (srcSize - start <= params->minChunkSize) {
+        return srcSize;
+    }
+    size_t const limit = ZL_MIN(start + params->maxChunkSize, srcSize);
+    // A candidate at position i ends the chunk after src[i]
+    size_t pos = start + params->minChunkSize - 1;
+    while (pos < limit) {
+        uint64_t const word = candidates[pos / 64] >> (pos % 64);
+        if (word != 0) {
+            size_t const found = pos + (size_t)ZL_ctz64(word);
+            return found < limit ? found + 1 : limit;
+        }
+        pos = (pos | 63) + 1;
+    }
+    return limit;
+}
+
+/// First occurrence of a unique chunk in the source
+typedef struct {
+    size_t pos;
+    uint32_t size;
+    uint32_t index;
+} ZS_CdcChunk;
+
+ZL_DECLARE_MAP_TYPE(ZS_CdcIndex, uint64_t, ZS_CdcChunk);
+
+ZL_Report ZS_cdcDedup(
+        ZS_CdcDedupOutput* out,
+        void const* src,
+        size_t srcSize,
+        uint64_t const* candidates,
+        ZS_CdcParams const* params,
+        size_t maxIndexedChunks)
+{
+    ZL_ASSERT_LE(params->maxChunkSize, UINT32_MAX);
+    uint8_t const* const ip = (uint8_t const*)src;
+    size_t const maxNbChunks = ZS_cdcMaxNbChunks(srcSize, params);
+    ZL_RET_R_IF_GT(integerOverflow, maxNbChunks, UINT32_MAX);
+    ZS_CdcIndex index = ZS_CdcIndex_create(
+            (uint32_t)ZL_MIN(maxIndexedChunks, maxNbChunks));
+    out->uniqueSize   = 0;
+    out->nbUnique     = 0;
+    out->nbChunks     = 0;
+
+    for (size_t start = 0; start < srcSize;) {
+        size_t const end =
+                ZS_cdcNextBoundary(candidates, start, srcSize, params);
+        size_t const size         = end - start;
+        uint8_t const* const chunk = ip + start;
+        uint64_t const fingerprint = XXH3_64bits(chunk, size);
+        ZS_CdcIndex_Entry const* const entry =
+                ZS_CdcIndex_findVal(&index, fingerprint);
+        // Fingerprints may collide : matches are confirmed
+        if (entry != NULL && entry->val.size == size
+            && memcmp(ip + entry->val.pos, chunk, size) == 0) {
+            out->refs[out->nbChunks++] = entry->val.index;
+        } else {
+            uint32_t const uniqueIndex = (uint32_t)out->nbUnique;
+            if (entry == NULL
+                && ZS_CdcIndex_size(&index)
+                        < ZS_CdcIndex_maxCapacity(&index)) {
+                ZS_CdcIndex_Entry const newEntry = {
+                    .key = fingerprint,
+                    .val = { start, (uint32_t)size, uniqueIndex },
+                };
+                ZS_CdcIndex_Insert const insert =
+                        ZS_CdcIndex_insert(&index, &newEntry);
+                if (insert.badAlloc) {
+                    ZS_CdcIndex_destroy(&index);
+                    ZL_RET_R_ERR(allocation);
+                }
+            }
+            memcpy(out->unique + out->uniqueSize, chunk, size);
+            out->uniqueSize += size;
+            out->uniqueSizes[out->nbUnique++] = (uint32_t)size;
+            out->refs[out->nbChunks++]        = uniqueIndex;
+        }
+        start = end;
+    }
+    ZS_CdcIndex_destroy(&index);
+    ZL_ASSERT_LE(out->nbChunks, maxNbChunks);
+    return ZL_returnSuccess();
+}
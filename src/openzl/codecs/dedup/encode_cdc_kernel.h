@@ -0,0 +1,109 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_DEDUP_ENCODE_CDC_KERNEL_H
+#define ZSTRONG_TRANSFORMS_DEDUP_ENCODE_CDC_KERNEL_H
+
+/**
+ * Content-defined chunking (CDC) deduplication.
+ *
+ * The source is cut into chunks at positions which only depend on the
+ * 64 bytes preceding them, using a gear rolling hash, so that repeated
+ * content produces the same chunks wherever it is. Chunks are fingerprinted,
+ * and only the first occurrence of each one is kept.
+ *
+ * The result is :
+ * - the concatenation of unique chunks
+ * - the size of each unique chunk
+ * - for each chunk of the source, the index of its unique chunk.
+ *   Unique chunks are numbered in order of first occurrence,
+ *   so a chunk seen for the first time is referenced by the number of
+ *   unique chunks seen before it.
+ */
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uintX_t
+
+#include "openzl/shared/portability.h"
+#include "openzl/zl_errors.h"
+
+ZL_BEGIN_C_DECLS
+
+/// Number of bytes the gear hash depends on
+#define ZS_CDC_WINDOW_SIZE 64
+
+#define ZS_CDC_AVG_CHUNK_SIZE_MIN 256
+#define ZS_CDC_AVG_CHUNK_SIZE_MAX (1u << 22)
+
+typedef struct {
+    size_t minChunkSize;
+    size_t maxChunkSize;
+    unsigned maskBits; ///< log2 of the average distance between candidates
+} ZS_CdcParams;
+
+/**
+ * @returns the chunking parameters for an average chunk size of
+ * @p avgChunkSize, rounded down to a power of 2.
+ * Chunks are at least a quarter, and at most 8 times that size.
+ * @pre ZS_CDC_AVG_CHUNK_SIZE_MIN <= avgChunkSize <= ZS_CDC_AVG_CHUNK_SIZE_MAX
+ */
+ZS_CdcParams ZS_cdcParams(size_t avgChunkSize);
+
+/// @returns the maximum number of chunks of a source of @p srcSize bytes
+size_t ZS_cdcMaxNbChunks(size_t srcSize, ZS_CdcParams const* params);
+
+/// @returns the number of words of the candidates bitmap
+size_t ZS_cdcCandidatesWords(size_t srcSize);
+
+/**
+ * Marks the candidate chunk boundaries of @p src in @p candidates :
+ * bit i is set when the gear hash of the bytes ending at src[i]
+ * has its @p maskBits high bits equal to 0.
+ * Vectorized with AVX2 when available, which produces the same bitmap.
+ *
+ * @param candidates Capacity ZS_cdcCandidatesWords(srcSize)
+ */
+void ZS_cdcFindCandidates(
+        uint64_t* candidates,
+        void const* src,
+        size_t srcSize,
+        unsigned maskBits);
+
+/**
+ * @returns the end of the chunk starting at @p start, which is the first
+ * candidate ending at least minChunkSize bytes after @p start,
+ * or maxChunkSize bytes after @p start, whichever comes first.
+ */
+size_t ZS_cdcNextBoundary(
+        uint64_t const* candidates,
+        size_t start,
+        size_t srcSize,
+        ZS_CdcParams const* params);
+
+typedef struct {
+    uint8_t* unique;       ///< Capacity srcSize
+    uint32_t* uniqueSizes; ///< Capacity ZS_cdcMaxNbChunks(srcSize)
+    uint32_t* refs;        ///< Capacity ZS_cdcMaxNbChunks(srcSize)
+    size_t uniqueSize;
+    size_t nbUnique;
+    size_t nbChunks;
+} ZS_CdcDedupOutput;
+
+/**
+ * Chunks @p src, and deduplicates its chunks into @p out.
+ * At most @p maxIndexedChunks unique chunks are indexed, which bounds the
+ * memory usage : once the index is full, new chunks can still be matched
+ * against the indexed ones, but are not indexed themselves.
+ *
+ * @param candidates Filled by ZS_cdcFindCandidates()
+ */
+ZL_Report ZS_cdcDedup(
+        ZS_CdcDedupOutput* out,
+        void const* src,
+        size_t srcSize,
+        uint64_t const* candidates,
+        ZS_CdcParams const* params,
+        size_t maxIndexedChunks);
+
+ZL_END_C_DECLS
+
+#endif
@@ -2,9 +2,13 @@
 
 #include "openzl/codecs/dedup/encode_dedup_binding.h"
 
+#include <limits.h> // INT_MAX
 #include <string.h> // memcmp
+#include "openzl/codecs/dedup/encode_cdc_kernel.h"
+#include "openzl/codecs/zl_dedup.h" // ZL_DEDUP_CHUNKS_*_PID
 #include "openzl/common/assertion.h"
 #include "openzl/compress/enc_interface.h" // ENC_refTypedStream
+#include "openzl/shared/numeric_operations.h"
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 
@@ -68,3 +72,115 @@ EI_dedup_num_trusted(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
     return EI_dedup_num_internal(eictx, ins, nbIns, 1 /* trusted */);
 }
+
+static ZL_Report EI_dedup_chunks_intParam(
+        ZL_Encoder* eictx,
+        int paramId,
+        int defaultValue,
+        int minValue,
+        int maxValue)
+{
+    ZL_IntParam const param = ZL_Encoder_getLocalIntParam(eictx, paramId);
+    if (param.paramId != paramId) {
+        return ZL_returnValue((size_t)defaultValue);
+    }
+    ZL_RET_R_IF_LT(nodeParameter_invalidValue, param.paramValue, minValue);
+    ZL_RET_R_IF_GT(nodeParameter_invalidValue, param.paramValue, maxValue);
+    return ZL_returnValue((size_t)param.paramValue);
+}
+
+static ZL_Report EI_dedup_chunks_writeNumerics(
+        ZL_Encoder* eictx,
+        int outcomeIdx,
+        const uint32_t* src32,
+        size_t nbElts)
+{
+    size_t const numWidth = NUMOP_numericWidthForArray32(src32, nbElts);
+    ZL_Output* const out =
+            ZL_Encoder_createTypedStream(eictx, outcomeIdx, nbElts, numWidth);
+    ZL_RET_R_IF_NULL(allocation, out);
+    NUMOP_writeNumerics_fromU32(ZL_Output_ptr(out), numWidth, src32, nbElts);
+    return ZL_Output_commit(out, nbElts);
+}
+
+ZL_Report
+EI_dedup_chunks(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
+{
+    ZL_ASSERT_NN(eictx);
+    ZL_ASSERT_EQ(nbIns, 1);
+    ZL_ASSERT_NN(ins);
+    const ZL_Input* const in = ins[0];
+    ZL_ASSERT_NN(in);
+    ZL_ASSERT_EQ(ZL_Input_type(in), ZL_Type_serial);
+    const void* const src = ZL_Input_ptr(in);
+    size_t const srcSize  = ZL_Input_numElts(in);
+
+    ZL_TRY_LET_R(
+            avgChunkSize,
+            EI_dedup_chunks_intParam(
+                    eictx,
+                    ZL_DEDUP_CHUNKS_AVG_SIZE_PID,
+                    ZL_DEDUP_CHUNKS_AVG_SIZE_DEFAULT,
+                    ZS_CDC_AVG_CHUNK_SIZE_MIN,
+                    ZS_CDC_AVG_CHUNK_SIZE_MAX));
+    ZL_TRY_LET_R(
+            maxIndexedChunks,
+            EI_dedup_chunks_intParam(
+                    eictx,
+                    ZL_DEDUP_CHUNKS_MAX_INDEX_PID,
+                    ZL_DEDUP_CHUNKS_MAX_INDEX_DEFAULT,
+                    1,
+                    INT_MAX));
+    ZS_CdcParams const params = ZS_cdcParams(avgChunkSize);
+
+    size_t const maxNbChunks = ZS_cdcMaxNbChunks(srcSize, &params);
+    uint64_t* const candidates = ZL_Encoder_getScratchSpace(
+            eictx, ZS_cdcCandidatesWords(srcSize) * sizeof(uint64_t));
+    ZL_RET_R_IF_NULL(allocation, candidates);
+    uint32_t* const sizesAndRefs = ZL_Encoder_getScratchSpace(
+            eictx, 2 * maxNbChunks * sizeof(uint32_t));
+    ZL_RET_R_IF_NULL(allocation, sizesAndRefs);
+    ZL_Output* const uniqueStream =
+            ZL_Encoder_createTypedStream(eictx, 0, srcSize, 1);
+    ZL_RET_R_IF_NULL(allocation, uniqueStream);
+
+    ZS_cdcFindCandidates(candidates, src, srcSize, params.maskBits);
+    ZS_CdcDedupOutput dedup = {
+        .unique      = ZL_Output_ptr(uniqueStream),
+        .uniqueSizes = sizesAndRefs,
+        .refs        = sizesAndRefs + maxNbChunks,
+    };
+    ZL_RET_R_IF_ERR(ZS_cdcDedup(
+            &dedup, src, srcSize, candidates, &params, maxIndexedChunks));
+    ZL_DLOG(BLOCK,
+            "EI_dedup_chunks: %zu bytes => %zu unique bytes (%zu / %zu chunks)",
+            srcSize,
+            dedup.uniqueSize,
+            dedup.nbUnique,
+            dedup.nbChunks);
+
+    ZL_RET_R_IF_ERR(ZL_Output_commit(uniqueStream, dedup.uniqueSize));
+    ZL_RET_R_IF_ERR(EI_dedup_chunks_writeNumerics(
+            eictx, 1, dedup.uniqueSizes, dedup.nbUnique));
+    ZL_RET_R_IF_ERR(EI_dedup_chunks_writeNumerics(
+            eictx, 2, dedup.refs, dedup.nbChunks));
+    return ZL_returnValue(3);
+}
+
+ZL_RESULT_OF(ZL_NodeID)
+ZL_Compressor_parameterizeDedupChunksNode(
+        ZL_Compressor* compressor,
+        int avgChunkSize,
+        int maxIndexedChunks)
+{
+    ZL_LocalParams localParams = {
+        .intParams = ZL_INTPARAMS(
+                { ZL_DEDUP_CHUNKS_AVG_SIZE_PID, avgChunkSize },
+                { ZL_DEDUP_CHUNKS_MAX_INDEX_PID, maxIndexedChunks }),
+    };
+    ZL_NodeParameters params = {
+        .localParams = &localParams,
+    };
+    return ZL_Compressor_parameterizeNode(
+            compressor, ZL_NODE_DEDUP_CHUNKS, &params);
+}
@@ -39,6 +39,20 @@ EI_dedup_num_trusted(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
         .name = "!zl.private.dedup_num_trusted"                         \
     }
 
+/* EI_dedup_chunks:
+ * cuts a serial input into content-defined chunks,
+ * and only keeps the first occurrence of each chunk.
+ * Outputs the unique chunks, their sizes, and a reference per chunk.
+ */
+ZL_Report
+EI_dedup_chunks(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
+
+#define EI_DEDUP_CHUNKS(id)                                           \
+    {                                                                 \
+        .gd = DEDUP_CHUNKS_GRAPH(id), .transform_f = EI_dedup_chunks, \
+        .name = "!zl.dedup_chunks"                                    \
+    }
+
 ZL_END_C_DECLS
 
 #endif
@@ -12,4 +12,11 @@
         .soTypes             = ZL_STREAMTYPELIST(ZL_Type_numeric),    \
     }
 
+#define DEDUP_CHUNKS_GRAPH(id)                                       \
+    {                                                                \
+        .CTid = id, .inputTypes = ZL_STREAMTYPELIST(ZL_Type_serial), \
+        .soTypes = ZL_STREAMTYPELIST(                                \
+                ZL_Type_serial, ZL_Type_numeric, ZL_Type_numeric),   \
+    }
+
 #endif
@@ -7,6 +7,7 @@
 #include <stddef.h> // size_t
 #include <stdint.h> // uint32_t
 
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/mem.h"
 #include "openzl/shared/portability.h"
 
@@ -64,10 +65,12 @@ static void ZS_deltaDecode64_scalar(
     }
 }
 
-#if ZL_HAS_SSSE3
+#if ZL_CAN_SSSE3
 
 #    include <tmmintrin.h>
 
+ZL_TARGET_SSSE3_BEGIN
+
 static size_t nbEltsToVectorize(size_t nbElts, size_t eltsPerIter)
 {
     return (nbElts / eltsPerIter) * eltsPerIter;
@@ -160,7 +163,9 @@ static void ZS_deltaDecode32_ssse3(
     }
 }
 
-#endif // ZL_HAS_SSSE3
+ZL_TARGET_END
+
+#endif // ZL_CAN_SSSE3
 
 void ZS_deltaDecode8(
         uint8_t* dst,
@@ -171,11 +176,13 @@ void ZS_deltaDecode8(
     if (nbElts == 0) {
         return;
     }
-#if ZL_HAS_SSSE3
-    ZS_deltaDecode8_ssse3(dst, first, deltas, nbElts);
-#else
-    ZS_deltaDecode8_scalar(dst, first, deltas, nbElts);
+#if ZL_CAN_SSSE3
+    if (ZL_cpuHas(ZL_CpuFeature_ssse3)) {
+        ZS_deltaDecode8_ssse3(dst, first, deltas, nbElts);
+        return;
+    }
 #endif
+    ZS_deltaDecode8_scalar(dst, first, deltas, nbElts);
 }
 
 void ZS_deltaDecode16(
@@ -187,11 +194,13 @@ void ZS_deltaDecode16(
     if (nbElts == 0) {
         return;
     }
-#if ZL_HAS_SSSE3
-    ZS_deltaDecode16_ssse3(dst, first, deltas, nbElts);
-#else
-    ZS_deltaDecode16_scalar(dst, first, deltas, nbElts);
+#if ZL_CAN_SSSE3
+    if (ZL_cpuHas(ZL_CpuFeature_ssse3)) {
+        ZS_deltaDecode16_ssse3(dst, first, deltas, nbElts);
+        return;
+    }
 #endif
+    ZS_deltaDecode16_scalar(dst, first, deltas, nbElts);
 }
 
 void ZS_deltaDecode32(
@@ -203,11 +212,13 @@ void ZS_deltaDecode32(
     if (nbElts == 0) {
         return;
     }
-#if ZL_HAS_SSSE3
-    ZS_deltaDecode32_ssse3(dst, first, deltas, nbElts);
-#else
-    ZS_deltaDecode32_scalar(dst, first, deltas, nbElts);
+#if ZL_CAN_SSSE3
+    if (ZL_cpuHas(ZL_CpuFeature_ssse3)) {
+        ZS_deltaDecode32_ssse3(dst, first, deltas, nbElts);
+        return;
+    }
 #endif
+    ZS_deltaDecode32_scalar(dst, first, deltas, nbElts);
 }
 
 void ZS_deltaDecode64(
@@ -3,6 +3,9 @@
 #ifndef ZSTRONG_TRANSFORMS_DISPATCH_STRING_COMMON_DISPATCH_STRING_H
 #define ZSTRONG_TRANSFORMS_DISPATCH_STRING_COMMON_DISPATCH_STRING_H
 
+#include <stdint.h> // uint32_t
+#include <string.h> // memcpy
+
 #include "openzl/shared/portability.h"
 
 ZL_BEGIN_C_DECLS
@@ -12,6 +15,23 @@ ZL_BEGIN_C_DECLS
 #define ZL_DISPATCH_STRING_MAX_DISPATCHES_V20 256
 #define ZL_DISPATCH_STRING_MAX_DISPATCHES 2048
 
+// Beyond this nb of destinations, lengths and contents are dispatched in
+// separate passes
+#define ZL_DISPATCH_STRING_ONE_PASS_MAX 32
+
+/* Copies a string of @strLen bytes, using a fixed-size copy for short strings.
+ * Requires ZL_DISPATCH_STRING_BLK_SIZE bytes to be readable from @src
+ * and writable into @dst. */
+ZL_FORCE_INLINE void
+ZL_DispatchString_copy(void* dst, const void* src, uint32_t strLen)
+{
+    if (strLen <= ZL_DISPATCH_STRING_BLK_SIZE) {
+        memcpy(dst, src, ZL_DISPATCH_STRING_BLK_SIZE);
+    } else {
+        memcpy(dst, src, strLen);
+    }
+}
+
 ZL_END_C_DECLS
 
 #endif
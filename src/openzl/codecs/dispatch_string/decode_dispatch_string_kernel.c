@@ -7,23 +7,31 @@
 
 #include "openzl/codecs/dispatch_string/common_dispatch_string.h"
 
-void ZL_DispatchString_decode(
+/* Mirrors the encoder : beyond ZL_DISPATCH_STRING_ONE_PASS_MAX sources,
+ * lengths and contents are gathered in 2 separate passes,
+ * so that each pass reads only half as many streams concurrently. */
+
+ZL_FORCE_INLINE void ZL_DispatchString_decode_internal(
         void* restrict dst,
         uint32_t dstStrLens[],
         size_t dstNbStrs,
-        const uint8_t nbSrcs,
+        size_t nbSrcs,
         const char* const* const restrict srcBuffers,
         const uint32_t* const* const restrict srcStrLens,
         const size_t srcNbStrs[],
-        const uint8_t inputIndices[])
+        const void* inputIndices,
+        int idx16)
 {
-    const char* srcPtrs[ZL_DISPATCH_STRING_MAX_DISPATCHES_V20];
+#define ZL_DISPATCH_STRING_SRC_IDX(i)                     \
+    (idx16 ? (size_t)((const uint16_t*)inputIndices)[i] \
+           : (size_t)((const uint8_t*)inputIndices)[i])
+    const char* srcPtrs[ZL_DISPATCH_STRING_MAX_DISPATCHES];
     for (size_t i = 0; i < nbSrcs; ++i) {
         srcPtrs[i] = srcBuffers[i];
     }
 
-    size_t currSrc[ZL_DISPATCH_STRING_MAX_DISPATCHES_V20]              = { 0 };
-    size_t firstNonblockCopyIdx[ZL_DISPATCH_STRING_MAX_DISPATCHES_V20] = { 0 };
+    size_t currSrc[ZL_DISPATCH_STRING_MAX_DISPATCHES]              = { 0 };
+    size_t firstNonblockCopyIdx[ZL_DISPATCH_STRING_MAX_DISPATCHES] = { 0 };
 
     assert(srcNbStrs != NULL);
     for (size_t i = 0; i < nbSrcs; ++i) {
@@ -43,8 +51,31 @@ void ZL_DispatchString_decode(
         }
     }
 
+    if (nbSrcs > ZL_DISPATCH_STRING_ONE_PASS_MAX) {
+        // first pass : lengths
+        for (size_t i = 0; i < dstNbStrs; ++i) {
+            const size_t srcIndex = ZL_DISPATCH_STRING_SRC_IDX(i);
+            assert(srcIndex < nbSrcs);
+            dstStrLens[i] = srcStrLens[srcIndex][currSrc[srcIndex]++];
+        }
+        memset(currSrc, 0, nbSrcs * sizeof(currSrc[0]));
+        // second pass : contents
+        for (size_t i = 0; i < dstNbStrs; ++i) {
+            const size_t srcIndex = ZL_DISPATCH_STRING_SRC_IDX(i);
+            const uint32_t strLen = dstStrLens[i];
+            if (currSrc[srcIndex]++ < firstNonblockCopyIdx[srcIndex]) {
+                ZL_DispatchString_copy(dst, srcPtrs[srcIndex], strLen);
+            } else {
+                memcpy(dst, srcPtrs[srcIndex], strLen);
+            }
+            dst = (char*)dst + strLen;
+            srcPtrs[srcIndex] += strLen;
+        }
+        return;
+    }
+
     for (size_t i = 0; i < dstNbStrs; ++i) {
-        const uint8_t srcIndex = inputIndices[i];
+        const size_t srcIndex = ZL_DISPATCH_STRING_SRC_IDX(i);
         assert(srcIndex < nbSrcs);
         const size_t currIdx  = currSrc[srcIndex];
         const uint32_t strLen = srcStrLens[srcIndex][currIdx];
@@ -59,6 +90,29 @@ void ZL_DispatchString_decode(
         ++currSrc[srcIndex];
         srcPtrs[srcIndex] += strLen;
     }
+#undef ZL_DISPATCH_STRING_SRC_IDX
+}
+
+void ZL_DispatchString_decode(
+        void* restrict dst,
+        uint32_t dstStrLens[],
+        size_t dstNbStrs,
+        const uint8_t nbSrcs,
+        const char* const* const restrict srcBuffers,
+        const uint32_t* const* const restrict srcStrLens,
+        const size_t srcNbStrs[],
+        const uint8_t inputIndices[])
+{
+    ZL_DispatchString_decode_internal(
+            dst,
+            dstStrLens,
+            dstNbStrs,
+            nbSrcs,
+            srcBuffers,
+            srcStrLens,
+            srcNbStrs,
+            inputIndices,
+            0);
 }
 
 void ZL_DispatchString_decode16(
@@ -71,46 +125,14 @@ void ZL_DispatchString_decode16(
         const size_t srcNbStrs[],
         const uint16_t inputIndices[])
 {
-    const char* srcPtrs[ZL_DISPATCH_STRING_MAX_DISPATCHES];
-    for (size_t i = 0; i < nbSrcs; ++i) {
-        srcPtrs[i] = srcBuffers[i];
-    }
-
-    size_t currSrc[ZL_DISPATCH_STRING_MAX_DISPATCHES]              = { 0 };
-    size_t firstNonblockCopyIdx[ZL_DISPATCH_STRING_MAX_DISPATCHES] = { 0 };
-
-    assert(srcNbStrs != NULL);
-    for (size_t i = 0; i < nbSrcs; ++i) {
-        assert(srcStrLens[i] != NULL);
-        size_t cumLen = 0;
-        if (srcNbStrs[i] == 0) { // special case of empty src
-            continue;
-        }
-        for (size_t idx = srcNbStrs[i] - 1; idx > 0; --idx) {
-            cumLen += srcStrLens[i][idx];
-            if (cumLen >= ZL_DISPATCH_STRING_BLK_SIZE) {
-                firstNonblockCopyIdx[i] =
-                        idx + 1; // idx is the last block copy, so idx + 1 is
-                                 // the first non-block copy
-                break;
-            }
-        }
-    }
-
-    for (size_t i = 0; i < dstNbStrs; ++i) {
-        const uint16_t srcIndex = inputIndices[i];
-        assert(srcIndex < nbSrcs);
-        const size_t currIdx  = currSrc[srcIndex];
-        const uint32_t strLen = srcStrLens[srcIndex][currIdx];
-        if (strLen <= ZL_DISPATCH_STRING_BLK_SIZE
-            && currIdx < firstNonblockCopyIdx[srcIndex]) {
-            memcpy(dst, srcPtrs[srcIndex], ZL_DISPATCH_STRING_BLK_SIZE);
-        } else {
-            memcpy(dst, srcPtrs[srcIndex], strLen);
-        }
-        dstStrLens[i] = strLen;
-        dst           = (char*)dst + strLen;
-        ++currSrc[srcIndex];
-        srcPtrs[srcIndex] += strLen;
-    }
+    ZL_DispatchString_decode_internal(
+            dst,
+            dstStrLens,
+            dstNbStrs,
+            nbSrcs,
+            srcBuffers,
+            srcStrLens,
+            srcNbStrs,
+            inputIndices,
+            1);
 }
@@ -10,10 +10,6 @@
 #include "openzl/zl_ctransform.h"
 #include "openzl/zl_graph_api.h" // ZL_Edge_runNode_withParams
 
-#include <stdio.h>
-#include <time.h>
-static double EI_dispatch_string_time_ms = 0.0;
-
 size_t ZL_DispatchString_maxDispatches(void)
 {
     return ZL_DISPATCH_STRING_MAX_DISPATCHES;
@@ -22,9 +18,6 @@ size_t ZL_DispatchString_maxDispatches(void)
 ZL_Report
 EI_dispatch_string(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* const in = ins[0];
@@ -138,14 +131,6 @@ EI_dispatch_string(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     }
     ZL_RET_R_IF_ERR(ZL_Output_commit(indices_out, nbElts));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_dispatch_string_time_ms += current_duration;
-    fprintf(stderr, "[EI_dispatch_string] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f \n", start_time_ms, end_time_ms, EI_dispatch_string_time_ms, current_duration);
-
     return ZL_returnSuccess();
 }
 
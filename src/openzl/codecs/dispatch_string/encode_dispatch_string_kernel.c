@@ -7,20 +7,28 @@
 
 #include "openzl/codecs/dispatch_string/common_dispatch_string.h"
 
-#include <stdio.h>
-#include <time.h>
-static double ZL_DispatchString_encode16_time_ms = 0.0;
-
-void ZL_DispatchString_encode(
-        uint8_t nbDsts,
+/* Each string is written into 2 destination streams :
+ * its content and its length.
+ * With many destinations, the nb of streams written concurrently exceeds
+ * what the L1 TLB and the cache can track, and speed collapses.
+ * Beyond ZL_DISPATCH_STRING_ONE_PASS_MAX destinations,
+ * lengths and contents are therefore dispatched in 2 separate passes,
+ * each one writing only half as many streams. */
+
+ZL_FORCE_INLINE void ZL_DispatchString_encode_internal(
+        size_t nbDsts,
         void** restrict dstBuffers,
         uint32_t** restrict dstStrLens,
         size_t dstSizes[],
         const void* restrict src,
         const uint32_t srcStrLens[],
         const size_t nbStrs,
-        const uint8_t outputIndices[])
+        const void* outputIndices,
+        int idx16)
 {
+#define ZL_DISPATCH_STRING_DST_IDX(i)                      \
+    (idx16 ? (size_t)((const uint16_t*)outputIndices)[i] \
+           : (size_t)((const uint8_t*)outputIndices)[i])
     for (size_t i = 0; i < nbDsts; ++i) {
         assert(dstBuffers[i] != NULL);
         assert(dstStrLens[i] != NULL);
@@ -32,7 +40,7 @@ void ZL_DispatchString_encode(
     }
 
     const char* srcPtr = src;
-    void* dstPtrs[ZL_DISPATCH_STRING_MAX_DISPATCHES_V20];
+    void* dstPtrs[ZL_DISPATCH_STRING_MAX_DISPATCHES];
     for (size_t i = 0; i < nbDsts; ++i) {
         dstPtrs[i] = dstBuffers[i];
     }
@@ -51,24 +59,45 @@ void ZL_DispatchString_encode(
         }
     }
 
+    if (nbDsts > ZL_DISPATCH_STRING_ONE_PASS_MAX) {
+        // first pass : lengths
+        for (size_t i = 0; i < nbStrs; ++i) {
+            const size_t dstIdx = ZL_DISPATCH_STRING_DST_IDX(i);
+            assert(dstIdx < nbDsts);
+            dstStrLens[dstIdx][dstSizes[dstIdx]++] = srcStrLens[i];
+        }
+        // second pass : contents
+        for (size_t i = 0; i < firstNonBlkIdx; ++i) {
+            const size_t dstIdx       = ZL_DISPATCH_STRING_DST_IDX(i);
+            const uint32_t currStrLen = srcStrLens[i];
+            ZL_DispatchString_copy(dstPtrs[dstIdx], srcPtr, currStrLen);
+            srcPtr += currStrLen;
+            dstPtrs[dstIdx] = (char*)dstPtrs[dstIdx] + currStrLen;
+        }
+        for (size_t i = firstNonBlkIdx; i < nbStrs; ++i) {
+            const size_t dstIdx       = ZL_DISPATCH_STRING_DST_IDX(i);
+            const uint32_t currStrLen = srcStrLens[i];
+            memcpy(dstPtrs[dstIdx], srcPtr, currStrLen);
+            srcPtr += currStrLen;
+            dstPtrs[dstIdx] = (char*)dstPtrs[dstIdx] + currStrLen;
+        }
+        return;
+    }
+
     for (size_t i = 0; i < firstNonBlkIdx; ++i) {
-        const uint8_t dstIdx = outputIndices[i];
+        const size_t dstIdx = ZL_DISPATCH_STRING_DST_IDX(i);
         assert(dstIdx < nbDsts);
         const size_t currN        = dstSizes[dstIdx];
         const uint32_t currStrLen = srcStrLens[i];
         dstStrLens[dstIdx][currN] = currStrLen;
-        if (currStrLen <= ZL_DISPATCH_STRING_BLK_SIZE) {
-            memcpy(dstPtrs[dstIdx], srcPtr, ZL_DISPATCH_STRING_BLK_SIZE);
-        } else {
-            memcpy(dstPtrs[dstIdx], srcPtr, currStrLen);
-        }
+        ZL_DispatchString_copy(dstPtrs[dstIdx], srcPtr, currStrLen);
         srcPtr += currStrLen;
         dstPtrs[dstIdx] = (char*)dstPtrs[dstIdx] + currStrLen;
         ++dstSizes[dstIdx];
     }
     // end condition
     for (size_t i = firstNonBlkIdx; i < nbStrs; ++i) {
-        const uint8_t dstIdx = outputIndices[i];
+        const size_t dstIdx = ZL_DISPATCH_STRING_DST_IDX(i);
         assert(dstIdx < nbDsts);
         const size_t currN        = dstSizes[dstIdx];
         const uint32_t currStrLen = srcStrLens[i];
@@ -78,7 +107,29 @@ void ZL_DispatchString_encode(
         dstPtrs[dstIdx] = (char*)dstPtrs[dstIdx] + currStrLen;
         ++dstSizes[dstIdx];
     }
-    return;
+#undef ZL_DISPATCH_STRING_DST_IDX
+}
+
+void ZL_DispatchString_encode(
+        uint8_t nbDsts,
+        void** restrict dstBuffers,
+        uint32_t** restrict dstStrLens,
+        size_t dstSizes[],
+        const void* restrict src,
+        const uint32_t srcStrLens[],
+        const size_t nbStrs,
+        const uint8_t outputIndices[])
+{
+    ZL_DispatchString_encode_internal(
+            nbDsts,
+            dstBuffers,
+            dstStrLens,
+            dstSizes,
+            src,
+            srcStrLens,
+            nbStrs,
+            outputIndices,
+            0);
 }
 
 void ZL_DispatchString_encode16(
@@ -91,74 +142,14 @@ void ZL_DispatchString_encode16(
         const size_t nbStrs,
         const uint16_t outputIndices[])
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
-    for (size_t i = 0; i < nbDsts; ++i) {
-        assert(dstBuffers[i] != NULL);
-        assert(dstStrLens[i] != NULL);
-    }
-
-    // check for the degenerate case of empty input & output
-    if (nbDsts != 0) {
-        memset(dstSizes, 0, nbDsts * sizeof(size_t));
-    }
-
-    const char* srcPtr = src;
-    void* dstPtrs[ZL_DISPATCH_STRING_MAX_DISPATCHES];
-    for (size_t i = 0; i < nbDsts; ++i) {
-        dstPtrs[i] = dstBuffers[i];
-    }
-
-    // find the first idx where we aren't guaranteed to be able to read
-    // ZL_DISPATCH_STRING_BLK_SIZE bytes without overflowing
-    size_t firstNonBlkIdx = 0;
-    size_t endSum         = 0;
-    if (nbStrs != 0) { // check for degenerate case of empty input & output
-        for (size_t i = nbStrs - 1; i > 0; --i) {
-            endSum += srcStrLens[i];
-            if (endSum >= ZL_DISPATCH_STRING_BLK_SIZE) {
-                firstNonBlkIdx = i + 1;
-                break;
-            }
-        }
-    }
-
-    for (size_t i = 0; i < firstNonBlkIdx; ++i) {
-        const uint16_t dstIdx = outputIndices[i];
-        assert(dstIdx < nbDsts);
-        const size_t currN        = dstSizes[dstIdx];
-        const uint32_t currStrLen = srcStrLens[i];
-        dstStrLens[dstIdx][currN] = currStrLen;
-        if (currStrLen <= ZL_DISPATCH_STRING_BLK_SIZE) {
-            memcpy(dstPtrs[dstIdx], srcPtr, ZL_DISPATCH_STRING_BLK_SIZE);
-        } else {
-            memcpy(dstPtrs[dstIdx], srcPtr, currStrLen);
-        }
-        srcPtr += currStrLen;
-        dstPtrs[dstIdx] = (char*)dstPtrs[dstIdx] + currStrLen;
-        ++dstSizes[dstIdx];
-    }
-    // end condition
-    for (size_t i = firstNonBlkIdx; i < nbStrs; ++i) {
-        const uint16_t dstIdx = outputIndices[i];
-        assert(dstIdx < nbDsts);
-        const size_t currN        = dstSizes[dstIdx];
-        const uint32_t currStrLen = srcStrLens[i];
-        dstStrLens[dstIdx][currN] = currStrLen;
-        memcpy(dstPtrs[dstIdx], srcPtr, currStrLen);
-        srcPtr += currStrLen;
-        dstPtrs[dstIdx] = (char*)dstPtrs[dstIdx] + currStrLen;
-        ++dstSizes[dstIdx];
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    ZL_DispatchString_encode16_time_ms += current_duration;
-    // fprintf(stderr, "[ZL_DispatchString_encode16] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms\n", start_time_ms, end_time_ms, ZL_DispatchString_encode16_time_ms);
-
-    return;
+    ZL_DispatchString_encode_internal(
+            nbDsts,
+            dstBuffers,
+            dstStrLens,
+            dstSizes,
+            src,
+            srcStrLens,
+            nbStrs,
+            outputIndices,
+            1);
 }
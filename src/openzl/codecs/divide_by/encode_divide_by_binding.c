@@ -9,10 +9,6 @@
 #include "openzl/shared/varint.h" // ZL_varintEncode64Fast
 #include "openzl/zl_public_nodes.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_divide_by_int_time_ms = 0.0;
-
 /*
  * This function returns the divisor to use for the divide by transform.
  * @p divisor is used as the divisor if it is not 0. Otherwise, the GCD of the
@@ -85,9 +81,6 @@ static ZL_RESULT_OF(uint64_t) getDivisor(
 ZL_Report
 EI_divide_by_int(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -118,13 +111,6 @@ EI_divide_by_int(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     ZL_Encoder_sendCodecHeader(eictx, header, encodeSize);
     ZL_RET_R_IF_ERR(ZL_Output_commit(out, nbInts));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_divide_by_int_time_ms += current_duration;
-    fprintf(stderr, "[EI_divide_by_int] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_divide_by_int_time_ms, current_duration);
     return ZL_returnSuccess();
 }
 
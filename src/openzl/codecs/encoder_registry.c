@@ -19,6 +19,7 @@
 #include "openzl/codecs/lz/encode_lz_binding.h"
 #include "openzl/codecs/merge_sorted/encode_merge_sorted_binding.h"
 #include "openzl/codecs/parse_int/encode_parse_int_binding.h"
+#include "openzl/codecs/pfor/encode_pfor_binding.h"
 #include "openzl/codecs/prefix/encode_prefix_binding.h"
 #include "openzl/codecs/quantize/encode_quantize_binding.h"
 #include "openzl/codecs/range_pack/encode_range_pack_binding.h"
@@ -93,6 +94,8 @@ const CNode ER_standardNodes[STANDARD_ENCODERS_NB] = {
 
     REGISTER_TRANSFORM(ZL_StandardNodeID_bitunpack, ZL_StandardTransformID_bitunpack, 6, EI_BITUNPACK),
     REGISTER_TRANSFORM(ZL_StandardNodeID_range_pack, ZL_StandardTransformID_range_pack, 8, EI_RANGE_PACK),
+    REGISTER_TRANSFORM(ZL_StandardNodeID_pfor, ZL_StandardTransformID_pfor, 22, EI_PFOR),
+    REGISTER_TRANSFORM(ZL_StandardNodeID_dedup_chunks, ZL_StandardTransformID_dedup_chunks, 22, EI_DEDUP_CHUNKS),
     REGISTER_TRANSFORM(ZL_StandardNodeID_merge_sorted, ZL_StandardTransformID_merge_sorted, 9, EI_MERGE_SORTED),
     REGISTER_TRANSFORM(ZL_StandardNodeID_prefix, ZL_StandardTransformID_prefix, 11, EI_PREFIX),
     REGISTER_TRANSFORM(ZL_StandardNodeID_divide_by, ZL_StandardTransformID_divide_by, 16, EI_DIVIDE_BY_INT),
@@ -115,6 +118,8 @@ const CNode ER_standardNodes[STANDARD_ENCODERS_NB] = {
     REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_huffman_v2, ZL_StandardTransformID_huffman_v2, 15, EI_HUFFMAN_V2),
     REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_huffman_struct_v2, ZL_StandardTransformID_huffman_struct_v2, 15, EI_HUFFMAN_STRUCT_V2),
     REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_fse_ncount, ZL_StandardTransformID_fse_ncount, 15, EI_FSE_NCOUNT),
+    REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_rans, ZL_StandardTransformID_rans, 22, EI_RANS),
+    REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_rans_struct, ZL_StandardTransformID_rans_struct, 22, EI_RANS_STRUCT),
     REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_zstd, ZL_StandardTransformID_zstd, 3, EI_ZSTD),
     REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_bitpack_serial, ZL_StandardTransformID_bitpack_serial, 3, EI_BITPACK_SERIALIZED),
     REGISTER_TRANSFORM(ZL_PrivateStandardNodeID_bitpack_int, ZL_StandardTransformID_bitpack_int, 3, EI_BITPACK_INTEGER),
@@ -0,0 +1,44 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_ENTROPY_COMMON_RANS_KERNEL_H
+#define ZSTRONG_TRANSFORMS_ENTROPY_COMMON_RANS_KERNEL_H
+
+/**
+ * Static rANS with ZS_RANS_NB_STATES interleaved states.
+ *
+ * Symbol n is coded by state (n % ZS_RANS_NB_STATES). Each state is kept
+ * within [ZS_RANS_L, ZS_RANS_L << 16), and is renormalized by exchanging
+ * 16-bit words with a single stream shared by all states.
+ * Keeping states below 2^31 lets the encoder divide with a 32-bit
+ * reciprocal, and the vectorized decoder compare states as signed integers.
+ *
+ * Format :
+ * - ZS_RANS_NB_STATES final encoder states, LE32, in state order
+ * - 16-bit LE words, in the order they are consumed by the decoder
+ *
+ * Probabilities are normalized to a total of (1 << tableLog),
+ * every present symbol receiving at least 1.
+ */
+
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+#define ZS_RANS_NB_STATES 32
+#define ZS_RANS_L (1u << 15)
+#define ZS_RANS_HEADER_SIZE (4 * ZS_RANS_NB_STATES)
+
+#define ZS_RANS_MIN_TABLELOG 5
+/// Decoding tables of 8-bit symbols pack symbol, frequency and bias
+/// within 32 bits, and must remain within L1 cache
+#define ZS_RANS_MAX_TABLELOG_8 12
+#define ZS_RANS_MAX_TABLELOG_16 15
+
+ZL_INLINE unsigned ZS_ransMaxTableLog(size_t eltWidth)
+{
+    return eltWidth == 1 ? ZS_RANS_MAX_TABLELOG_8 : ZS_RANS_MAX_TABLELOG_16;
+}
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_TRANSFORMS_ENTROPY_COMMON_RANS_KERNEL_H
@@ -6,6 +6,7 @@
 #define HUF_STATIC_LINKING_ONLY
 
 #include "openzl/codecs/entropy/decode_huffman_kernel.h"
+#include "openzl/codecs/entropy/decode_rans_kernel.h"
 #include "openzl/codecs/entropy/deprecated/common_entropy.h"
 #include "openzl/common/assertion.h"
 #include "openzl/decompress/dictx.h"
@@ -115,6 +116,69 @@ ZL_Report DI_fse_v2(ZL_Decoder* dictx, const ZL_Input* in[])
     return ZL_returnSuccess();
 }
 
+static ZL_Report
+DI_rans_impl(ZL_Decoder* dictx, const ZL_Input* in[], size_t eltWidth)
+{
+    ZL_Input const* const normStream = in[0];
+    ZL_Input const* const bitsStream = in[1];
+
+    ZL_ASSERT_EQ(ZL_Input_type(normStream), ZL_Type_numeric);
+    ZL_ASSERT_EQ(ZL_Input_type(bitsStream), ZL_Type_serial);
+
+    ZL_RET_R_IF_NE(corruption, ZL_Input_eltWidth(normStream), 2);
+
+    uint16_t const* const norm = ZL_Input_ptr(normStream);
+    size_t const nbSymbols     = ZL_Input_numElts(normStream);
+    ZL_TRY_LET_R(tableLog, ZS_ransValidNorm(norm, nbSymbols, eltWidth));
+
+    size_t dstSize;
+    {
+        ZL_RBuffer const header = ZL_Decoder_getCodecHeader(dictx);
+        ZL_RET_R_IF_LT(corruption, header.size, 2, "Min size = 2 bytes");
+        ZL_RET_R_IF_GT(corruption, header.size, 9, "Max size = 9 bytes");
+        uint8_t const* ptr      = (uint8_t const*)header.start;
+        unsigned const nbStates = *ptr++;
+        ZL_RET_R_IF_NE(
+                corruption,
+                nbStates,
+                ZS_RANS_NB_STATES,
+                "Unsupported number of states");
+        dstSize = ZL_readLE64_N(ptr, header.size - 1);
+        ZL_RET_R_IF_LT(corruption, dstSize, 2, "Must have at least 2 elements");
+    }
+    void* const dtable = ZL_Decoder_getScratchSpace(
+            dictx, ZS_ransDTableSize((unsigned)tableLog, eltWidth));
+    ZL_RET_R_IF_NULL(allocation, dtable);
+    ZS_ransBuildDTable(dtable, norm, nbSymbols, (unsigned)tableLog, eltWidth);
+
+    ZL_Output* const outStream =
+            ZL_Decoder_create1OutStream(dictx, dstSize, eltWidth);
+    ZL_RET_R_IF_NULL(allocation, outStream);
+
+    ZL_RET_R_IF_ERR(ZS_ransDecode(
+            ZL_Output_ptr(outStream),
+            dstSize,
+            eltWidth,
+            ZL_Input_ptr(bitsStream),
+            ZL_Input_numElts(bitsStream),
+            dtable,
+            (unsigned)tableLog));
+
+    ZL_RET_R_IF_ERR(ZL_Output_commit(outStream, dstSize));
+
+    return ZL_returnSuccess();
+}
+
+ZL_Report DI_rans(ZL_Decoder* dictx, const ZL_Input* in[])
+{
+    return DI_rans_impl(dictx, in, 1);
+}
+
+ZL_Report DI_rans_struct(ZL_Decoder* dictx, const ZL_Input* in[])
+{
+    return DI_rans_impl(dictx, in, 2);
+}
+
 ZL_Report DI_fse_ncount(ZL_Decoder* dictx, const ZL_Input* in[])
 {
     ZL_Input const* const srcStream = in[0];
@@ -13,6 +13,9 @@ ZL_Report DI_fse_v2(ZL_Decoder* dictx, const ZL_Input* in[]);
 ZL_Report DI_huffman_v2(ZL_Decoder* dictx, const ZL_Input* in[]);
 ZL_Report DI_huffman_struct_v2(ZL_Decoder* dictx, const ZL_Input* in[]);
 
+ZL_Report DI_rans(ZL_Decoder* dictx, const ZL_Input* in[]);
+ZL_Report DI_rans_struct(ZL_Decoder* dictx, const ZL_Input* in[]);
+
 ZL_Report DI_fse_ncount(ZL_Decoder* dictx, const ZL_Input* in[]);
 
 ZL_Report DI_fse_typed(ZL_Decoder* dictx, const ZL_Input* in[]);
@@ -39,6 +42,16 @@ ZL_Report DI_huffman_fixed(ZL_Decoder* dictx, const ZL_Input* in[]);
         .transform_f = DI_huffman_struct_v2, .name = "huffman struct v2" \
     }
 
+#define DI_RANS(id)                            \
+    {                                          \
+        .transform_f = DI_rans, .name = "rans" \
+    }
+
+#define DI_RANS_STRUCT(id)                                   \
+    {                                                        \
+        .transform_f = DI_rans_struct, .name = "rans struct" \
+    }
+
 // Following ZL_TypedEncoderDesc declaration,
 // presumed to be used as initializer only
 #define DI_FSE(id)                                 \
@@ -0,0 +1,404 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/entropy/decode_rans_kernel.h"
+
+#include "openzl/common/assertion.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/cpu.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+#include "openzl/zl_errors.h"
+
+/* Decoding tables :
+ * - 8-bit symbols : freq << 20 | bias << 8 | symbol, with bias < freq < 2^12
+ * - 16-bit symbols : freq << 16 | bias, then a separate array of symbols
+ * where bias is the position of the slot within the range of its symbol.
+ * Decoding a symbol is then : x = freq * (x >> tableLog) + bias. */
+
+static uint16_t const* ZS_ransDTableSymbols(
+        void const* dtable,
+        unsigned tableLog)
+{
+    return (uint16_t const*)(void const*)((uint8_t const*)dtable
+                                          + ((size_t)4 << tableLog));
+}
+
+ZL_Report ZS_ransValidNorm(
+        uint16_t const* norm,
+        size_t nbSymbols,
+        size_t eltWidth)
+{
+    ZL_RET_R_IF_NOT(corruption, eltWidth == 1 || eltWidth == 2);
+    ZL_RET_R_IF_LT(corruption, nbSymbols, 2);
+    ZL_RET_R_IF_GT(corruption, nbSymbols, (size_t)1 << (8 * eltWidth));
+    unsigned const maxTableLog = ZS_ransMaxTableLog(eltWidth);
+    uint64_t sum               = 0;
+    uint32_t largest           = 0;
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        sum += norm[s];
+        largest = ZL_MAX(largest, norm[s]);
+    }
+    ZL_RET_R_IF_NOT(corruption, ZL_isPow2(sum) && sum != 0);
+    unsigned const tableLog = (unsigned)ZL_highbit64(sum);
+    ZL_RET_R_IF_LT(corruption, tableLog, ZS_RANS_MIN_TABLELOG);
+    ZL_RET_R_IF_GT(corruption, tableLog, maxTableLog);
+    ZL_RET_R_IF_EQ(corruption, largest, sum, "Must have 2 present symbols");
+    return ZL_returnValue(tableLog);
+}
+
+void ZS_ransBuildDTable(
+        void* dtable,
+        uint16_t const* norm,
+        size_t nbSymbols,
+        unsigned tableLog,
+        size_t eltWidth)
+{
+    uint32_t* const table = (uint32_t*)dtable;
+    uint16_t* const sym16 =
+            (uint16_t*)(void*)((uint8_t*)dtable + ((size_t)4 << tableLog));
+    uint32_t slot         = 0;
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        uint32_t const freq = norm[s];
+        ZL_ASSERT_LE(slot + freq, 1u << tableLog);
+        if (eltWidth == 1) {
+            uint32_t const e = (freq << 20) | (uint32_t)s;
+            for (uint32_t k = 0; k < freq; ++k) {
+                table[slot + k] = e | (k << 8);
+            }
+        } else {
+            for (uint32_t k = 0; k < freq; ++k) {
+                table[slot + k] = (freq << 16) | k;
+                sym16[slot + k] = (uint16_t)s;
+            }
+        }
+        slot += freq;
+    }
+    ZL_ASSERT_EQ(slot, 1u << tableLog);
+    if (eltWidth == 2) {
+        sym16[slot] = 0; // padding, read by vectorized gathers
+    }
+}
+
+/// Decodes symbols [@p n, @p nbElts), one at a time.
+/// @returns false if @p src is too small
+ZL_FORCE_INLINE bool ZS_ransDecode_scalar(
+        void* dst,
+        size_t n,
+        size_t nbElts,
+        size_t kEltWidth,
+        uint32_t states[ZS_RANS_NB_STATES],
+        uint8_t const** ipPtr,
+        uint8_t const* iend,
+        void const* dtable,
+        unsigned tableLog)
+{
+    uint32_t const* const table = (uint32_t const*)dtable;
+    uint16_t const* const sym16 =
+            ZS_ransDTableSymbols(dtable, tableLog);
+    uint32_t const mask = (1u << tableLog) - 1;
+    uint8_t const* ip   = *ipPtr;
+    for (; n < nbElts; ++n) {
+        uint32_t* const state = &states[n % ZS_RANS_NB_STATES];
+        uint32_t x            = *state;
+        uint32_t const slot   = x & mask;
+        uint32_t const e      = table[slot];
+        if (kEltWidth == 1) {
+            x = (e >> 20) * (x >> tableLog) + ((e >> 8) & 0xFFF);
+            ((uint8_t*)dst)[n] = (uint8_t)e;
+        } else {
+            x = (e >> 16) * (x >> tableLog) + (e & 0xFFFF);
+            ((uint16_t*)dst)[n] = sym16[slot];
+        }
+        uint32_t const renorm = x < ZS_RANS_L;
+        if (ZL_UNLIKELY(iend - ip < 2)) {
+            if (renorm) {
+                return false;
+            }
+        } else {
+            uint32_t const next = (x << 16) | ZL_readLE16(ip);
+            x                   = renorm ? next : x;
+            ip += 2 * renorm;
+        }
+        *state = x;
+    }
+    *ipPtr = ip;
+    return true;
+}
+
+#if ZL_CAN_AVX2
+#    include <immintrin.h>
+
+/* For each mask of lanes to renormalize, the index of the word each lane
+ * reads (3 bits per lane), and the number of words read (bits 24+). */
+static uint32_t const ZS_ransRenormLUT[256] = {
+    0x00000000, 0x01000000, 0x01000000, 0x02000008, 0x01000000, 0x02000040,
+    0x02000040, 0x03000088, 0x01000000, 0x02000200, 0x02000200, 0x03000408,
+    0x02000200, 0x03000440, 0x03000440, 0x04000688, 0x01000000, 0x02001000,
+    0x02001000, 0x03002008, 0x02001000, 0x03002040, 0x03002040, 0x04003088,
+    0x02001000, 0x03002200, 0x03002200, 0x04003408, 0x03002200, 0x04003440,
+    0x04003440, 0x05004688, 0x01000000, 0x02008000, 0x02008000, 0x03010008,
+    0x02008000, 0x03010040, 0x03010040, 0x04018088, 0x02008000, 0x03010200,
+    0x03010200, 0x04018408, 0x03010200, 0x04018440, 0x04018440, 0x05020688,
+    0x02008000, 0x03011000, 0x03011000, 0x0401A008, 0x03011000, 0x0401A040,
+    0x0401A040, 0x05023088, 0x03011000, 0x0401A200, 0x0401A200, 0x05023408,
+    0x0401A200, 0x05023440, 0x05023440, 0x0602C688, 0x01000000, 0x02040000,
+    0x02040000, 0x03080008, 0x02040000, 0x03080040, 0x03080040, 0x040C0088,
+    0x02040000, 0x03080200, 0x03080200, 0x040C0408, 0x03080200, 0x040C0440,
+    0x040C0440, 0x05100688, 0x02040000, 0x03081000, 0x03081000, 0x040C2008,
+    0x03081000, 0x040C2040, 0x040C2040, 0x05103088, 0x03081000, 0x040C2200,
+    0x040C2200, 0x05103408, 0x040C2200, 0x05103440, 0x05103440, 0x06144688,
+    0x02040000, 0x03088000, 0x03088000, 0x040D0008, 0x03088000, 0x040D0040,
+    0x040D0040, 0x05118088, 0x03088000, 0x040D0200, 0x040D0200, 0x05118408,
+    0x040D0200, 0x05118440, 0x05118440, 0x06160688, 0x03088000, 0x040D1000,
+    0x040D1000, 0x0511A008, 0x040D1000, 0x0511A040, 0x0511A040, 0x06163088,
+    0x040D1000, 0x0511A200, 0x0511A200, 0x06163408, 0x0511A200, 0x06163440,
+    0x06163440, 0x071AC688, 0x01000000, 0x02200000, 0x02200000, 0x03400008,
+    0x02200000, 0x03400040, 0x03400040, 0x04600088, 0x02200000, 0x03400200,
+    0x03400200, 0x04600408, 0x03400200, 0x04600440, 0x04600440, 0x05800688,
+    0x02200000, 0x03401000, 0x03401000, 0x04602008, 0x03401000, 0x04602040,
+    0x04602040, 0x05803088, 0x03401000, 0x04602200, 0x04602200, 0x05803408,
+    0x04602200, 0x05803440, 0x05803440, 0x06A04688, 0x02200000, 0x03408000,
+    0x03408000, 0x04610008, 0x03408000, 0x04610040, 0x04610040, 0x05818088,
+    0x03408000, 0x04610200, 0x04610200, 0x05818408, 0x04610200, 0x05818440,
+    0x05818440, 0x06A20688, 0x03408000, 0x04611000, 0x04611000, 0x0581A008,
+    0x04611000, 0x0581A040, 0x0581A040, 0x06A23088, 0x04611000, 0x0581A200,
+    0x0581A200, 0x06A23408, 0x0581A200, 0x06A23440, 0x06A23440, 0x07C2C688,
+    0x02200000, 0x03440000, 0x03440000, 0x04680008, 0x03440000, 0x04680040,
+    0x04680040, 0x058C0088, 0x03440000, 0x04680200, 0x04680200, 0x058C0408,
+    0x04680200, 0x058C0440, 0x058C0440, 0x06B00688, 0x03440000, 0x04681000,
+    0x04681000, 0x058C2008, 0x04681000, 0x058C2040, 0x058C2040, 0x06B03088,
+    0x04681000, 0x058C2200, 0x058C2200, 0x06B03408, 0x058C2200, 0x06B03440,
+    0x06B03440, 0x07D44688, 0x03440000, 0x04688000, 0x04688000, 0x058D0008,
+    0x04688000, 0x058D0040, 0x058D0040, 0x06B18088, 0x04688000, 0x058D0200,
+    0x058D0200, 0x06B18408, 0x058D0200, 0x06B18440, 0x06B18440, 0x07D60688,
+    0x04688000, 0x058D1000, 0x058D1000, 0x06B1A008, 0x058D1000, 0x06B1A040,
+    0x06B1A040, 0x07D63088, 0x058D1000, 0x06B1A200, 0x06B1A200, 0x07D63408,
+    0x06B1A200, 0x07D63440, 0x07D63440, 0x08FAC688,
+};
+
+ZL_TARGET_AVX2_BEGIN
+
+/// Reloads the lanes of @p x which dropped below ZS_RANS_L,
+/// reading their words in lane order.
+static __m256i ZS_ransRenorm_avx2(__m256i x, uint8_t const** ipPtr)
+{
+    __m256i const need =
+            _mm256_cmpgt_epi32(_mm256_set1_epi32((int)ZS_RANS_L), x);
+    uint32_t const lut =
+            ZS_ransRenormLUT[_mm256_movemask_ps(_mm256_castsi256_ps(need))];
+    __m256i const idx = _mm256_and_si256(
+            _mm256_srlv_epi32(
+                    _mm256_set1_epi32((int)lut),
+                    _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21)),
+            _mm256_set1_epi32(7));
+    __m256i const words = _mm256_cvtepu16_epi32(
+            _mm_loadu_si128((__m128i_u const*)*ipPtr));
+    __m256i const next = _mm256_or_si256(
+            _mm256_slli_epi32(x, 16),
+            _mm256_permutevar8x32_epi32(words, idx));
+    *ipPtr += 2 * (lut >> 24);
+    return _mm256_blendv_epi8(x, next, need);
+}
+
+/// Decodes 8 symbols, @returns them within the low byte of each lane
+static __m256i ZS_ransStep8_avx2(
+        __m256i* x,
+        uint32_t const* table,
+        __m256i mask,
+        __m128i tableLog)
+{
+    __m256i const e = _mm256_i32gather_epi32(
+            (int const*)table, _mm256_and_si256(*x, mask), 4);
+    __m256i const freq = _mm256_srli_epi32(e, 20);
+    __m256i const bias =
+            _mm256_and_si256(_mm256_srli_epi32(e, 8), _mm256_set1_epi32(0xFFF));
+    *x = _mm256_add_epi32(
+            _mm256_mullo_epi32(freq, _mm256_srl_epi32(*x, tableLog)), bias);
+    return _mm256_and_si256(e, _mm256_set1_epi32(0xFF));
+}
+
+/// Decodes 8 symbols, @returns them within the low 16 bits of each lane
+static __m256i ZS_ransStep16_avx2(
+        __m256i* x,
+        uint32_t const* table,
+        void const* sym16,
+        __m256i mask,
+        __m128i tableLog)
+{
+    __m256i const slot = _mm256_and_si256(*x, mask);
+    __m256i const e = _mm256_i32gather_epi32((int const*)table, slot, 4);
+    __m256i const symbols =
+            _mm256_i32gather_epi32((int const*)sym16, slot, 2);
+    __m256i const freq = _mm256_srli_epi32(e, 16);
+    __m256i const bias = _mm256_and_si256(e, _mm256_set1_epi32(0xFFFF));
+    *x = _mm256_add_epi32(
+            _mm256_mullo_epi32(freq, _mm256_srl_epi32(*x, tableLog)), bias);
+    return _mm256_and_si256(symbols, _mm256_set1_epi32(0xFFFF));
+}
+
+/// Decodes groups of ZS_RANS_NB_STATES symbols, 8 states per vector,
+/// as long as @p ip is far enough from @p iend to skip bound checks.
+/// @returns the number of decoded symbols
+static size_t ZS_ransDecode_avx2(
+        void* dst,
+        size_t nbElts,
+        size_t eltWidth,
+        uint32_t states[ZS_RANS_NB_STATES],
+        uint8_t const** ipPtr,
+        uint8_t const* iend,
+        void const* dtable,
+        unsigned tableLog)
+{
+    ZL_STATIC_ASSERT(ZS_RANS_NB_STATES == 32, "4 vectors of 8 states");
+    uint32_t const* const table = (uint32_t const*)dtable;
+    // Symbols are gathered as 32-bit loads, then masked
+    void const* const sym16 =
+            (uint8_t const*)dtable + ((size_t)4 << tableLog);
+    __m256i const mask = _mm256_set1_epi32((int)((1u << tableLog) - 1));
+    __m128i const shift = _mm_cvtsi32_si128((int)tableLog);
+    __m256i x0 = _mm256_loadu_si256((__m256i_u const*)(states + 0));
+    __m256i x1 = _mm256_loadu_si256((__m256i_u const*)(states + 8));
+    __m256i x2 = _mm256_loadu_si256((__m256i_u const*)(states + 16));
+    __m256i x3 = _mm256_loadu_si256((__m256i_u const*)(states + 24));
+    uint8_t const* ip = *ipPtr;
+    size_t n          = 0;
+    // Each renormalization reads 16 bytes
+    while (nbElts - n >= ZS_RANS_NB_STATES && iend - ip >= 4 * 16) {
+        if (eltWidth == 1) {
+            __m256i const s0 = ZS_ransStep8_avx2(&x0, table, mask, shift);
+            __m256i const s1 = ZS_ransStep8_avx2(&x1, table, mask, shift);
+            __m256i const s2 = ZS_ransStep8_avx2(&x2, table, mask, shift);
+            __m256i const s3 = ZS_ransStep8_avx2(&x3, table, mask, shift);
+            // Packing interleaves 128-bit lanes, permute them back
+            __m256i const s = _mm256_packus_epi16(
+                    _mm256_packus_epi32(s0, s1), _mm256_packus_epi32(s2, s3));
+            _mm256_storeu_si256(
+                    (__m256i_u*)((uint8_t*)dst + n),
+                    _mm256_permutevar8x32_epi32(
+                            s, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+        } else {
+            __m256i const s0 =
+                    ZS_ransStep16_avx2(&x0, table, sym16, mask, shift);
+            __m256i const s1 =
+                    ZS_ransStep16_avx2(&x1, table, sym16, mask, shift);
+            __m256i const s2 =
+                    ZS_ransStep16_avx2(&x2, table, sym16, mask, shift);
+            __m256i const s3 =
+                    ZS_ransStep16_avx2(&x3, table, sym16, mask, shift);
+            uint16_t* const dst16 = (uint16_t*)dst + n;
+            _mm256_storeu_si256(
+                    (__m256i_u*)dst16,
+                    _mm256_permute4x64_epi64(
+                            _mm256_packus_epi32(s0, s1), 0xD8));
+            _mm256_storeu_si256(
+                    (__m256i_u*)(dst16 + 16),
+                    _mm256_permute4x64_epi64(
+                            _mm256_packus_epi32(s2, s3), 0xD8));
+        }
+        x0 = ZS_ransRenorm_avx2(x0, &ip);
+        x1 = ZS_ransRenorm_avx2(x1, &ip);
+        x2 = ZS_ransRenorm_avx2(x2, &ip);
+        x3 = ZS_ransRenorm_avx2(x3, &ip);
+        n += ZS_RANS_NB_STATES;
+    }
+    _mm256_storeu_si256((__m256i_u*)(states + 0), x0);
+    _mm256_storeu_si256((__m256i_u*)(states + 8), x1);
+    _mm256_storeu_si256((__m256i_u*)(states + 16), x2);
+    _mm256_storeu_si256((__m256i_u*)(states + 24), x3);
+    *ipPtr = ip;
+    return n;
+}
+
+ZL_TARGET_END
+
+#endif // ZL_CAN_AVX2
+
+ZL_FORCE_INLINE ZL_Report ZS_ransDecode_impl(
+        void* dst,
+        size_t nbElts,
+        size_t kEltWidth,
+        void const* src,
+        size_t srcSize,
+        void const* dtable,
+        unsigned tableLog)
+{
+    ZL_RET_R_IF_LT(corruption, srcSize, ZS_RANS_HEADER_SIZE);
+    uint8_t const* ip         = (uint8_t const*)src;
+    uint8_t const* const iend = ip + srcSize;
+    uint32_t states[ZS_RANS_NB_STATES];
+    for (size_t i = 0; i < ZS_RANS_NB_STATES; ++i) {
+        states[i] = ZL_readLE32(ip + 4 * i);
+    }
+    ip += ZS_RANS_HEADER_SIZE;
+
+    size_t n = 0;
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        n = ZS_ransDecode_avx2(
+                dst, nbElts, kEltWidth, states, &ip, iend, dtable, tableLog);
+    }
+#endif
+    ZL_RET_R_IF_NOT(
+            corruption,
+            ZS_ransDecode_scalar(
+                    dst,
+                    n,
+                    nbElts,
+                    kEltWidth,
+                    states,
+                    &ip,
+                    iend,
+                    dtable,
+                    tableLog),
+            "Source is too small");
+
+    // The encoder starts from ZS_RANS_L and emits every word it produces
+    ZL_RET_R_IF_NE(corruption, (size_t)(iend - ip), 0, "Trailing words");
+    for (size_t i = 0; i < ZS_RANS_NB_STATES; ++i) {
+        ZL_RET_R_IF_NE(corruption, states[i], ZS_RANS_L, "Invalid state");
+    }
+    return ZL_returnValue(srcSize);
+}
+
+static ZL_Report ZS_ransDecode8(
+        void* dst,
+        size_t nbElts,
+        void const* src,
+        size_t srcSize,
+        void const* dtable,
+        unsigned tableLog)
+{
+    return ZS_ransDecode_impl(dst, nbElts, 1, src, srcSize, dtable, tableLog);
+}
+
+static ZL_Report ZS_ransDecode16(
+        void* dst,
+        size_t nbElts,
+        void const* src,
+        size_t srcSize,
+        void const* dtable,
+        unsigned tableLog)
+{
+    return ZS_ransDecode_impl(dst, nbElts, 2, src, srcSize, dtable, tableLog);
+}
+
+ZL_Report ZS_ransDecode(
+        void* dst,
+        size_t nbElts,
+        size_t eltWidth,
+        void const* src,
+        size_t srcSize,
+        void const* dtable,
+        unsigned tableLog)
+{
+    ZL_RET_R_IF_GT(corruption, tableLog, ZS_ransMaxTableLog(eltWidth));
+    switch (eltWidth) {
+        case 1:
+            return ZS_ransDecode8(dst, nbElts, src, srcSize, dtable, tableLog);
+        case 2:
+            return ZS_ransDecode16(
+                    dst, nbElts, src, srcSize, dtable, tableLog);
+        default:
+            ZL_RET_R_ERR(GENERIC, "Unsupported element width");
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_ENTROPY_DECODE_RANS_KERNEL_H
+#define ZSTRONG_TRANSFORMS_ENTROPY_DECODE_RANS_KERNEL_H
+
+#include <stddef.h> // size_t
+
+#include "openzl/codecs/entropy/common_rans_kernel.h"
+#include "openzl/common/base_types.h" // ZL_Report
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * Checks that @p norm is a valid normalized count for symbols of
+ * @p eltWidth bytes : it must sum to a power of 2 no larger than
+ * ZS_ransMaxTableLog(eltWidth), with at least 2 present symbols.
+ * @returns The table log
+ */
+ZL_Report ZS_ransValidNorm(
+        uint16_t const* norm,
+        size_t nbSymbols,
+        size_t eltWidth);
+
+/// @returns the size in bytes of the decoding table
+ZL_INLINE size_t ZS_ransDTableSize(unsigned tableLog, size_t eltWidth)
+{
+    // 8-bit symbols : 1 packed uint32_t per slot
+    // 16-bit symbols : 1 uint32_t then 1 uint16_t per slot,
+    // plus room to load the last uint16_t as a uint32_t
+    return eltWidth == 1 ? ((size_t)4 << tableLog)
+                         : ((size_t)6 << tableLog) + 2;
+}
+
+/// Builds the decoding table, of ZS_ransDTableSize() bytes.
+/// @pre ZS_ransValidNorm(norm, nbSymbols, eltWidth) returned @p tableLog
+void ZS_ransBuildDTable(
+        void* dtable,
+        uint16_t const* norm,
+        size_t nbSymbols,
+        unsigned tableLog,
+        size_t eltWidth);
+
+/**
+ * Decodes @p nbElts symbols of @p eltWidth bytes (1 or 2) into @p dst.
+ * @returns The number of bytes consumed from @p src, or an error when
+ * @p src is corrupted. All of @p src must be consumed.
+ */
+ZL_Report ZS_ransDecode(
+        void* dst,
+        size_t nbElts,
+        size_t eltWidth,
+        void const* src,
+        size_t srcSize,
+        void const* dtable,
+        unsigned tableLog);
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_TRANSFORMS_ENTROPY_DECODE_RANS_KERNEL_H
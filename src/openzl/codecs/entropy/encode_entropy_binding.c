@@ -11,6 +11,7 @@
 #include "openzl/codecs/entropy/deprecated/common_entropy.h"
 #include "openzl/codecs/entropy/encode_entropy_selector.h"
 #include "openzl/codecs/entropy/encode_huffman_kernel.h"
+#include "openzl/codecs/entropy/encode_rans_kernel.h"
 #include "openzl/common/assertion.h"
 #include "openzl/common/errors_internal.h" // ZS2_RET_IF*
 #include "openzl/compress/enc_interface.h"
@@ -28,13 +29,6 @@
 
 #define ENTROPY_HISTORAM_PID 246
 
-#include <stdio.h>
-#include <time.h>
-static double EI_huffman_v2_time_ms = 0.0;
-static double EI_huffman_struct_v2_time_ms = 0.0;
-static double EI_fse_v2_time_ms = 0.0;
-static double EI_fse_ncount_time_ms = 0.0;
-
 static ZL_Histogram const* getHistogram(ZL_Encoder* eictx, const ZL_Input* in)
 {
     ZL_RefParam param = ZL_Encoder_getLocalParam(eictx, ENTROPY_HISTORAM_PID);
@@ -59,9 +53,6 @@ static ZL_Histogram const* getHistogram(ZL_Encoder* eictx, const ZL_Input* in)
 
 ZL_Report EI_fse_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -147,21 +138,11 @@ ZL_Report EI_fse_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
             "FSE source is not compressible (should be impossible to trigger for user)");
     ZL_RET_R_IF_ERR(ZL_Output_commit(bitStream, bitSize));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_fse_v2_time_ms += current_duration;
-    fprintf(stderr, "[EI_fse_v2] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_fse_v2_time_ms, current_duration);
     return ZL_returnSuccess();
 }
 
 ZL_Report EI_fse_ncount(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -207,21 +188,11 @@ ZL_Report EI_fse_ncount(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 
     ZL_RET_R_IF_ERR(ZL_Output_commit(dstStream, ncountSize));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_fse_ncount_time_ms += current_duration;
-    fprintf(stderr, "[EI_fse_ncount] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_fse_ncount_time_ms, current_duration);
     return ZL_returnSuccess();
 }
 
 ZL_Report EI_huffman_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -312,22 +283,12 @@ ZL_Report EI_huffman_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
             "Huffman source is not compressible (should be impossible to trigger for user)");
     ZL_RET_R_IF_ERR(ZL_Output_commit(bitStream, bitSize));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_huffman_v2_time_ms += current_duration;
-    fprintf(stderr, "[EI_huffman_v2] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_huffman_v2_time_ms, current_duration);
     return ZL_returnSuccess();
 }
 
 ZL_Report
 EI_huffman_struct_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -405,13 +366,98 @@ EI_huffman_struct_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     ZL_ASSERT_LE(ZL_WC_size(&bits), bitCapacity);
     ZL_RET_R_IF_ERR(ZL_Output_commit(bitStream, ZL_WC_size(&bits)));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
+    return ZL_returnSuccess();
+}
+
+ZL_Report EI_rans(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
+{
+    ZL_ASSERT_EQ(nbIns, 1);
+    ZL_ASSERT_NN(ins);
+    const ZL_Input* in    = ins[0];
+    size_t const eltWidth = ZL_Input_eltWidth(in);
+    ZL_ASSERT(
+            ZL_Input_type(in) == ZL_Type_serial
+            || ZL_Input_type(in) == ZL_Type_struct);
+    ZL_RET_R_IF_NOT(node_invalid_input, eltWidth == 1 || eltWidth == 2);
+
+    void const* src               = ZL_Input_ptr(in);
+    size_t const srcSize          = ZL_Input_numElts(in);
+    ZL_Histogram const* histogram = getHistogram(eictx, in);
+    ZL_RET_R_IF_NULL(allocation, histogram);
+
+    ZL_RET_R_IF_LT(
+            node_invalid_input,
+            srcSize,
+            2,
+            "Must not use rANS for 0 or 1 element (should be impossible for users to trigger)");
+    ZL_RET_R_IF_EQ(
+            node_invalid_input,
+            histogram->count[histogram->maxSymbol],
+            histogram->total,
+            "Must not use rANS on constant data (should be impossible for users to trigger)");
+
+    size_t cardinality = 0;
+    for (size_t s = 0; s <= histogram->maxSymbol; ++s) {
+        cardinality += histogram->count[s] != 0;
+    }
+    unsigned const maxTableLog = ZS_ransMaxTableLog(eltWidth);
+    ZL_RET_R_IF_GT(
+            node_invalid_input,
+            cardinality,
+            (size_t)1 << maxTableLog,
+            "Too many symbols for rANS");
+
+    // 1. Send header
+    {
+        size_t const nbBytes = (size_t)(ZL_nextPow2(srcSize + 1) + 7) / 8;
+        uint8_t header[sizeof(uint64_t) + 1];
+        header[0] = (uint8_t)ZS_RANS_NB_STATES;
+        ZL_writeLE64_N(header + 1, srcSize, nbBytes);
+        ZL_ASSERT_EQ(ZL_readLE64_N(header + 1, nbBytes), srcSize);
+        ZL_Encoder_sendCodecHeader(eictx, header, nbBytes + 1);
+    }
+
+    // 2. Build table
+    ZS_RansCElt* ctable;
+    unsigned tableLog;
+    {
+        size_t const normSize = histogram->maxSymbol + 1;
+        ZL_Output* const normStream =
+                ZL_Encoder_createTypedStream(eictx, 0, normSize, 2);
+        ZL_RET_R_IF_NULL(allocation, normStream);
+        uint16_t* const norm = ZL_Output_ptr(normStream);
+
+        tableLog = ZS_ransOptimalTableLog(srcSize, cardinality, maxTableLog);
+        ZL_RET_R_IF_ERR(ZS_ransNormalizeCount(
+                norm, histogram->count, normSize, srcSize, tableLog));
+
+        ctable = ZL_Encoder_getScratchSpace(
+                eictx, sizeof(ZS_RansCElt) * normSize);
+        ZL_RET_R_IF_NULL(allocation, ctable);
+        ZS_ransBuildCTable(ctable, norm, normSize, tableLog);
+
+        ZL_RET_R_IF_ERR(ZL_Output_setIntMetadata(normStream, 0, (int)tableLog));
+        ZL_RET_R_IF_ERR(ZL_Output_commit(normStream, normSize));
+    }
+
+    // 3. Encode
+    size_t const bitCapacity = ZS_ransEncodeBound(srcSize);
+    ZL_Output* bitStream =
+            ZL_Encoder_createTypedStream(eictx, 1, bitCapacity, 1);
+    ZL_RET_R_IF_NULL(allocation, bitStream);
+
+    ZL_TRY_LET_R(
+            bitSize,
+            ZS_ransEncode(
+                    ZL_Output_ptr(bitStream),
+                    bitCapacity,
+                    src,
+                    srcSize,
+                    eltWidth,
+                    ctable,
+                    tableLog));
+    ZL_RET_R_IF_ERR(ZL_Output_commit(bitStream, bitSize));
 
-    double current_duration = end_time_ms - start_time_ms;
-    EI_huffman_struct_v2_time_ms += current_duration;
-    fprintf(stderr, "[EI_huffman_struct_v2] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_huffman_struct_v2_time_ms, current_duration);
     return ZL_returnSuccess();
 }
 
@@ -570,15 +616,36 @@ static ZL_RESULT_OF(ZL_EdgeList)
 typedef enum {
     EBM_huf,
     EBM_fse,
+    EBM_rans,
     EBM_any,
 } EntropyBackendMode;
 
-static EntropyBackendMode resolveMode(
-        DataStatsU8* stats,
-        EntropyBackendMode mode)
+/// Below this many elements, the rANS states cost more than they save
+#define ENTROPY_RANS_MIN_ELTS (1u << 13)
+
+/**
+ * rANS compresses as well as FSE, and decodes faster than both FSE and
+ * Huffman, but is only worth its larger header on large enough inputs.
+ * @returns The max decompression level at which rANS replaces @p mode
+ */
+static int ransMaxDecompressionLevel(EntropyBackendMode mode)
+{
+    return mode == EBM_huf ? 1 : 2;
+}
+
+static bool useRans(ZL_Graph* gctx, size_t nbElts, EntropyBackendMode mode)
+{
+    ZL_NodeID const rans = { ZL_PrivateStandardNodeID_rans };
+    return nbElts >= ENTROPY_RANS_MIN_ELTS
+            && ZL_Graph_getCParam(gctx, ZL_CParam_decompressionLevel)
+            <= ransMaxDecompressionLevel(mode)
+            && ZL_Graph_isNodeSupported(gctx, rans);
+}
+
+static EntropyBackendMode
+resolveMode(ZL_Graph* gctx, DataStatsU8* stats, EntropyBackendMode mode)
 {
     // TODO: Better selection between Huffman & FSE
-    // Take decompression speed into account
     if (mode == EBM_any) {
         size_t const nbElts = DataStatsU8_totalElements(stats);
         size_t const fseSize =
@@ -587,10 +654,10 @@ static EntropyBackendMode resolveMode(
         size_t const hufSize =
                 DataStatsU8_estimateHuffmanSizeFast(stats, /* delta */ false);
         size_t const minGain = nbElts / 32;
-        if (fseSize + minGain < hufSize) {
-            return EBM_fse;
-        } else {
-            return EBM_huf;
+        mode = fseSize + minGain < hufSize ? EBM_fse : EBM_huf;
+        // Trade the selection for decompression speed when asked to
+        if (useRans(gctx, nbElts, mode)) {
+            return EBM_rans;
         }
     }
     return mode;
@@ -714,15 +781,19 @@ entropyCompressChunk(ZL_Graph* gctx, ZL_Edge* chunk, EntropyBackendMode mode)
             return ZL_returnSuccess();
         }
 
+        // rANS needs a table log large enough for every symbol
+        bool const rans = mode == EBM_any
+                && histogram->cardinality <= (1u << 12)
+                && useRans(gctx, nbElts, EBM_huf);
+        ZL_NodeID const node = rans
+                ? (ZL_NodeID){ ZL_PrivateStandardNodeID_rans_struct }
+                : (ZL_NodeID){ ZL_PrivateStandardNodeID_huffman_struct_v2 };
+
         // TODO: Allow tokenization
         ZL_TRY_LET_T(
                 ZL_EdgeList,
                 streams,
-                runNode_wHistogram(
-                        chunk,
-                        (ZL_NodeID){
-                                ZL_PrivateStandardNodeID_huffman_struct_v2 },
-                        histogram));
+                runNode_wHistogram(chunk, node, histogram));
         ZL_ASSERT_EQ(streams.nbEdges, 2);
         ZL_RET_R_IF_ERR(ZL_Edge_setDestination(streams.edges[0], ZL_GRAPH_FSE));
         ZL_RET_R_IF_ERR(
@@ -766,8 +837,8 @@ entropyCompressChunk(ZL_Graph* gctx, ZL_Edge* chunk, EntropyBackendMode mode)
         return ZL_Edge_setDestination(chunk, ZL_GRAPH_STORE);
     }
 
-    // Select between FSE & Huffman
-    mode = resolveMode(&stats, mode);
+    // Select between FSE, Huffman & rANS
+    mode = resolveMode(gctx, &stats, mode);
 
     ZL_Histogram* histogram = getHistogram8(gctx, &stats);
     if (mode == EBM_huf) {
@@ -784,13 +855,13 @@ entropyCompressChunk(ZL_Graph* gctx, ZL_Edge* chunk, EntropyBackendMode mode)
                 ZL_Edge_setDestination(streams.edges[1], ZL_GRAPH_STORE));
         return ZL_returnSuccess();
     } else {
+        ZL_NodeID const node = mode == EBM_rans
+                ? (ZL_NodeID){ ZL_PrivateStandardNodeID_rans }
+                : (ZL_NodeID){ ZL_PrivateStandardNodeID_fse_v2 };
         ZL_TRY_LET_T(
                 ZL_EdgeList,
                 streams,
-                runNode_wHistogram(
-                        chunk,
-                        (ZL_NodeID){ ZL_PrivateStandardNodeID_fse_v2 },
-                        histogram));
+                runNode_wHistogram(chunk, node, histogram));
         ZL_ASSERT_EQ(streams.nbEdges, 2);
         ZL_RET_R_IF_ERR(ZL_Edge_setDestination(
                 streams.edges[0],
@@ -896,8 +967,7 @@ EI_huffmanDynamicGraph(ZL_Graph* gctx, ZL_Edge* inputs[], size_t nbIns)
         ZL_ASSERT_EQ(streams.nbEdges, 1);
         return ZL_Edge_setDestination(streams.edges[0], ZL_GRAPH_STORE);
     }
-    ZL_Report EI_huffmanDynamicGraph_report = entropyDynamicGraph(gctx, input, EBM_huf);
-    return EI_huffmanDynamicGraph_report;
+    return entropyDynamicGraph(gctx, input, EBM_huf);
 }
 
 ZL_Report
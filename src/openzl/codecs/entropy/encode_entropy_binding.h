@@ -14,6 +14,8 @@ ZL_Report EI_huffman_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
 ZL_Report
 EI_huffman_struct_v2(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
 
+ZL_Report EI_rans(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
+
 ZL_Report EI_fse_ncount(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
 
 ZL_Report EI_fse_typed(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
@@ -51,6 +53,18 @@ EI_entropyDynamicGraph(ZL_Graph* gctx, ZL_Edge* inputs[], size_t nbIns);
         .name        = "!zl.private.huffman_struct_v2" \
     }
 
+#define EI_RANS(id)                                   \
+    {                                                 \
+        .gd = RANS_GRAPH(id), .transform_f = EI_rans, \
+        .name = "!zl.private.rans"                    \
+    }
+
+#define EI_RANS_STRUCT(id)                                   \
+    {                                                        \
+        .gd = RANS_STRUCT_GRAPH(id), .transform_f = EI_rans, \
+        .name = "!zl.private.rans_struct"                    \
+    }
+
 // Following ZL_TypedEncoderDesc declaration,
 // presumed to be used as initializer only
 #define EI_FSE(id)                                                       \
@@ -0,0 +1,212 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/entropy/encode_rans_kernel.h"
+
+#include <string.h> // memmove
+
+#include "openzl/common/assertion.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+#include "openzl/zl_errors.h"
+
+unsigned ZS_ransOptimalTableLog(
+        size_t nbElts,
+        size_t cardinality,
+        unsigned maxTableLog)
+{
+    ZL_ASSERT_GE(cardinality, 2);
+    ZL_ASSERT_LE(cardinality, (size_t)1 << maxTableLog);
+    // No need for more precision than there are elements
+    unsigned tableLog = (unsigned)ZL_highbit64((uint64_t)nbElts) + 1;
+    // Leave some room beyond the minimum of 1 per symbol
+    unsigned const minTableLog =
+            (unsigned)ZL_highbit64((uint64_t)cardinality - 1) + 2;
+    tableLog = ZL_MAX(tableLog, minTableLog);
+    tableLog = ZL_MAX(tableLog, ZS_RANS_MIN_TABLELOG);
+    return ZL_MIN(tableLog, maxTableLog);
+}
+
+ZL_Report ZS_ransNormalizeCount(
+        uint16_t* norm,
+        unsigned const* count,
+        size_t nbSymbols,
+        size_t total,
+        unsigned tableLog)
+{
+    uint64_t const tableSize = (uint64_t)1 << tableLog;
+    ZL_RET_R_IF_GT(GENERIC, tableLog, ZS_RANS_MAX_TABLELOG_16);
+    ZL_RET_R_IF_EQ(GENERIC, total, 0);
+
+    size_t nbPresent = 0;
+    size_t largest   = 0;
+    uint64_t sum     = 0;
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        if (count[s] == 0) {
+            norm[s] = 0;
+            continue;
+        }
+        uint64_t n = ((uint64_t)count[s] * tableSize + total / 2) / total;
+        n          = ZL_MAX(n, 1);
+        norm[s]    = (uint16_t)ZL_MIN(n, tableSize - 1);
+        sum += norm[s];
+        ++nbPresent;
+        if (count[s] > count[largest]) {
+            largest = s;
+        }
+    }
+    ZL_RET_R_IF_LT(GENERIC, nbPresent, 2, "Can't encode constant data");
+    ZL_RET_R_IF_GT(GENERIC, nbPresent, tableSize, "Too many symbols");
+
+    if (sum < tableSize) {
+        norm[largest] = (uint16_t)(norm[largest] + (tableSize - sum));
+        return ZL_returnSuccess();
+    }
+    // Rounding and the minimum of 1 overshot : take the excess back from
+    // symbols which can spare it, in proportion to their frequency.
+    // Every present symbol can keep 1, so this terminates.
+    while (sum > tableSize) {
+        uint64_t const excess = sum - tableSize;
+        uint64_t const spare  = sum - nbPresent;
+        ZL_ASSERT_GE(spare, excess);
+        for (size_t s = 0; s < nbSymbols && sum > tableSize; ++s) {
+            if (norm[s] <= 1) {
+                continue;
+            }
+            uint64_t dec = (uint64_t)(norm[s] - 1) * excess / spare;
+            dec          = ZL_MAX(dec, 1);
+            dec          = ZL_MIN(dec, sum - tableSize);
+            norm[s]      = (uint16_t)(norm[s] - dec);
+            sum -= dec;
+        }
+    }
+    return ZL_returnSuccess();
+}
+
+void ZS_ransBuildCTable(
+        ZS_RansCElt* ctable,
+        uint16_t const* norm,
+        size_t nbSymbols,
+        unsigned tableLog)
+{
+    ZL_ASSERT_LE(tableLog, ZS_RANS_MAX_TABLELOG_16);
+    uint32_t start = 0;
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        uint32_t const freq = norm[s];
+        ZS_RansCElt* const e = &ctable[s];
+        if (freq == 0) {
+            memset(e, 0, sizeof(*e));
+            continue;
+        }
+        // Renormalization keeps states within [ZS_RANS_L, ZS_RANS_L << 16)
+        e->xMax     = ((ZS_RANS_L >> tableLog) << 16) * freq;
+        e->cmplFreq = (uint16_t)((1u << tableLog) - freq);
+        if (freq == 1) {
+            e->rcpFreq  = ~0u;
+            e->rcpShift = 0;
+            e->bias     = start + (1u << tableLog) - 1;
+        } else {
+            // Exact division of 31-bit states:
+            // x / freq == (x * rcpFreq) >> (32 + rcpShift)
+            uint32_t shift = 0;
+            while (freq > (1u << shift)) {
+                ++shift;
+            }
+            e->rcpFreq = (uint32_t)((((uint64_t)1 << (shift + 31)) + freq - 1)
+                                    / freq);
+            e->rcpShift = (uint16_t)(shift - 1);
+            e->bias     = start;
+        }
+        start += freq;
+    }
+    ZL_ASSERT_EQ(start, 1u << tableLog);
+}
+
+ZL_FORCE_INLINE ZL_Report ZS_ransEncode_impl(
+        void* dst,
+        size_t dstCapacity,
+        void const* src,
+        size_t nbElts,
+        size_t kEltWidth,
+        ZS_RansCElt const* ctable)
+{
+    ZL_RET_R_IF_LT(
+            dstCapacity_tooSmall, dstCapacity, ZS_ransEncodeBound(nbElts));
+    uint8_t* const ostart = (uint8_t*)dst;
+    uint8_t* op           = ostart + ZS_ransEncodeBound(nbElts);
+    uint8_t const* src8   = (uint8_t const*)src;
+    uint16_t const* src16 = (uint16_t const*)src;
+
+    uint32_t states[ZS_RANS_NB_STATES];
+    for (size_t i = 0; i < ZS_RANS_NB_STATES; ++i) {
+        states[i] = ZS_RANS_L;
+    }
+
+    // Encode backwards, so that the decoder reads forwards
+    for (size_t n = nbElts; n-- > 0;) {
+        size_t const symbol      = kEltWidth == 1 ? src8[n] : src16[n];
+        ZS_RansCElt const* const e = &ctable[symbol];
+        uint32_t* const state      = &states[n % ZS_RANS_NB_STATES];
+        uint32_t x                 = *state;
+        ZL_ASSERT_NE(e->xMax, 0, "Symbol not present in the table");
+        // Branchless renormalization : the word is always written,
+        // but only kept when needed. The header leaves room below op.
+        uint32_t const renorm = x >= e->xMax;
+        ZL_writeLE16(op - 2, (uint16_t)x);
+        op -= 2 * renorm;
+        x >>= 16 * renorm;
+        uint32_t const q =
+                (uint32_t)(((uint64_t)x * e->rcpFreq) >> 32) >> e->rcpShift;
+        *state = x + e->bias + q * e->cmplFreq;
+    }
+
+    op -= ZS_RANS_HEADER_SIZE;
+    for (size_t i = 0; i < ZS_RANS_NB_STATES; ++i) {
+        ZL_writeLE32(op + 4 * i, states[i]);
+    }
+    ZL_ASSERT_GE(op, ostart);
+    size_t const dstSize =
+            (size_t)(ostart + ZS_ransEncodeBound(nbElts) - op);
+    memmove(ostart, op, dstSize);
+    return ZL_returnValue(dstSize);
+}
+
+static ZL_Report ZS_ransEncode8(
+        void* dst,
+        size_t dstCapacity,
+        void const* src,
+        size_t nbElts,
+        ZS_RansCElt const* ctable)
+{
+    return ZS_ransEncode_impl(dst, dstCapacity, src, nbElts, 1, ctable);
+}
+
+static ZL_Report ZS_ransEncode16(
+        void* dst,
+        size_t dstCapacity,
+        void const* src,
+        size_t nbElts,
+        ZS_RansCElt const* ctable)
+{
+    return ZS_ransEncode_impl(dst, dstCapacity, src, nbElts, 2, ctable);
+}
+
+ZL_Report ZS_ransEncode(
+        void* dst,
+        size_t dstCapacity,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        ZS_RansCElt const* ctable,
+        unsigned tableLog)
+{
+    ZL_RET_R_IF_GT(GENERIC, tableLog, ZS_ransMaxTableLog(eltWidth));
+    switch (eltWidth) {
+        case 1:
+            return ZS_ransEncode8(dst, dstCapacity, src, nbElts, ctable);
+        case 2:
+            return ZS_ransEncode16(dst, dstCapacity, src, nbElts, ctable);
+        default:
+            ZL_RET_R_ERR(GENERIC, "Unsupported element width");
+    }
+}
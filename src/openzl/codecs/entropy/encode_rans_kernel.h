@@ -0,0 +1,74 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_ENTROPY_ENCODE_RANS_KERNEL_H
+#define ZSTRONG_TRANSFORMS_ENTROPY_ENCODE_RANS_KERNEL_H
+
+#include <stddef.h> // size_t
+
+#include "openzl/codecs/entropy/common_rans_kernel.h"
+#include "openzl/common/base_types.h" // ZL_Report
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+typedef struct {
+    uint32_t xMax;     // states >= xMax must be renormalized first
+    uint32_t rcpFreq;  // fixed-point reciprocal of the frequency
+    uint32_t bias;     // start, adjusted when frequency == 1
+    uint16_t cmplFreq; // (1 << tableLog) - frequency
+    uint16_t rcpShift;
+} ZS_RansCElt;
+
+/// @returns the maximum encoded size of @p nbElts symbols
+ZL_INLINE size_t ZS_ransEncodeBound(size_t nbElts)
+{
+    return ZS_RANS_HEADER_SIZE + 2 * nbElts;
+}
+
+/// @returns the table log to use for @p nbElts symbols,
+/// of which @p cardinality are distinct.
+/// @pre cardinality <= (1 << maxTableLog)
+unsigned ZS_ransOptimalTableLog(
+        size_t nbElts,
+        size_t cardinality,
+        unsigned maxTableLog);
+
+/**
+ * Normalizes @p count so that it sums to (1 << tableLog),
+ * keeping every present symbol at a frequency of at least 1.
+ * @param total The sum of @p count
+ * @returns An error if there are more than (1 << tableLog) present symbols,
+ * or less than 2.
+ */
+ZL_Report ZS_ransNormalizeCount(
+        uint16_t* norm,
+        unsigned const* count,
+        size_t nbSymbols,
+        size_t total,
+        unsigned tableLog);
+
+/// Builds the encoding table of @p nbSymbols elements.
+/// @pre @p norm sums to (1 << tableLog)
+void ZS_ransBuildCTable(
+        ZS_RansCElt* ctable,
+        uint16_t const* norm,
+        size_t nbSymbols,
+        unsigned tableLog);
+
+/**
+ * Encodes @p nbElts symbols of @p eltWidth bytes (1 or 2).
+ * @pre Every symbol of @p src has a non-zero frequency in @p ctable
+ * @returns The encoded size, or an error if @p dstCapacity is too small.
+ */
+ZL_Report ZS_ransEncode(
+        void* dst,
+        size_t dstCapacity,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        ZS_RansCElt const* ctable,
+        unsigned tableLog);
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_TRANSFORMS_ENTROPY_ENCODE_RANS_KERNEL_H
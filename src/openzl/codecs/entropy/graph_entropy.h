@@ -19,6 +19,8 @@
 #define FSE_V2_GRAPH(id) ENTROPY_V2_GRAPH(id, ZL_Type_serial)
 #define HUFFMAN_V2_GRAPH(id) ENTROPY_V2_GRAPH(id, ZL_Type_serial)
 #define HUFFMAN_STRUCT_V2_GRAPH(id) ENTROPY_V2_GRAPH(id, ZL_Type_struct)
+#define RANS_GRAPH(id) ENTROPY_V2_GRAPH(id, ZL_Type_serial)
+#define RANS_STRUCT_GRAPH(id) ENTROPY_V2_GRAPH(id, ZL_Type_struct)
 
 #define FSE_NCOUNT_GRAPH(id)                                          \
     {                                                                 \
@@ -1,6 +1,7 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 #include "openzl/codecs/flatpack/decode_flatpack_kernel.h"
 
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/mem.h"
 
 // Local noinline attribute for decode_flatpack_kernel
@@ -12,7 +13,7 @@
 #    define ZL_FLATPACK_NOINLINE
 #endif
 
-#define ZS_FLAT_HAS_NEEDED_EXTS (ZL_HAS_BMI2 && ZL_HAS_SSE42)
+#define ZS_FLAT_HAS_NEEDED_EXTS (ZL_CAN_BMI2 && ZL_CAN_SSE42)
 
 static ZS_FlatPackSize const ZS_FlatPack_kError = { 257 };
 
@@ -63,6 +64,8 @@ static ZS_FlatPackSize ZS_flatpackDecodeEnd(
 
 #    include <immintrin.h>
 
+ZL_TARGET_SSE42_BMI2_BEGIN
+
 static __m128i
 ZS_loadAlphabet16(uint8_t const* alphabet, size_t offset, size_t alphabetSize)
 {
@@ -354,6 +357,8 @@ static ZL_FLATPACK_NOINLINE ZS_FlatPackSize ZS_flatpackDecodeGeneric(
             dst, dstEnd, alphabet, alphabetSize, packed, packedEnd, nbBits);
 }
 
+ZL_TARGET_END
+
 #endif
 
 ZS_FlatPackSize ZS_flatpackDecode(
@@ -378,62 +383,64 @@ ZS_FlatPackSize ZS_flatpackDecode(
     ZL_ASSERT_LE(nbBits, 8);
 
 #if ZS_FLAT_HAS_NEEDED_EXTS
-    if (alphabetSize <= 16) {
-        return ZS_flatpackDecode16(
-                dst,
-                dst + nbElts,
-                alphabet,
-                alphabetSize,
-                packed,
-                packed + packedSize,
-                nbBits);
-    } else if (alphabetSize <= 32) {
-        return ZS_flatpackDecode32(
-                dst,
-                dst + nbElts,
-                alphabet,
-                alphabetSize,
-                packed,
-                packed + packedSize,
-                nbBits);
-    } else if (alphabetSize <= 48) {
-        return ZS_flatpackDecode48(
-                dst,
-                dst + nbElts,
-                alphabet,
-                alphabetSize,
-                packed,
-                packed + packedSize,
-                nbBits);
-    } else if (alphabetSize <= 64) {
-        return ZS_flatpackDecode64(
-                dst,
-                dst + nbElts,
-                alphabet,
-                alphabetSize,
-                packed,
-                packed + packedSize,
-                nbBits);
-    } else if (alphabetSize <= 128) {
-        return ZS_flatpackDecode128(
-                dst,
-                dst + nbElts,
-                alphabet,
-                alphabetSize,
-                packed,
-                packed + packedSize,
-                nbBits);
-    } else {
-        return ZS_flatpackDecodeGeneric(
-                dst,
-                dst + nbElts,
-                alphabet,
-                alphabetSize,
-                packed,
-                packed + packedSize,
-                nbBits);
+    if (ZL_cpuHas(ZL_CpuFeature_bmi2 | ZL_CpuFeature_sse42)) {
+        if (alphabetSize <= 16) {
+            return ZS_flatpackDecode16(
+                    dst,
+                    dst + nbElts,
+                    alphabet,
+                    alphabetSize,
+                    packed,
+                    packed + packedSize,
+                    nbBits);
+        } else if (alphabetSize <= 32) {
+            return ZS_flatpackDecode32(
+                    dst,
+                    dst + nbElts,
+                    alphabet,
+                    alphabetSize,
+                    packed,
+                    packed + packedSize,
+                    nbBits);
+        } else if (alphabetSize <= 48) {
+            return ZS_flatpackDecode48(
+                    dst,
+                    dst + nbElts,
+                    alphabet,
+                    alphabetSize,
+                    packed,
+                    packed + packedSize,
+                    nbBits);
+        } else if (alphabetSize <= 64) {
+            return ZS_flatpackDecode64(
+                    dst,
+                    dst + nbElts,
+                    alphabet,
+                    alphabetSize,
+                    packed,
+                    packed + packedSize,
+                    nbBits);
+        } else if (alphabetSize <= 128) {
+            return ZS_flatpackDecode128(
+                    dst,
+                    dst + nbElts,
+                    alphabet,
+                    alphabetSize,
+                    packed,
+                    packed + packedSize,
+                    nbBits);
+        } else {
+            return ZS_flatpackDecodeGeneric(
+                    dst,
+                    dst + nbElts,
+                    alphabet,
+                    alphabetSize,
+                    packed,
+                    packed + packedSize,
+                    nbBits);
+        }
     }
-#else
+#endif
     return ZS_flatpackDecodeEnd(
             dst,
             dst + nbElts,
@@ -442,5 +449,4 @@ ZS_FlatPackSize ZS_flatpackDecode(
             packed,
             packed + packedSize,
             nbBits);
-#endif
 }
@@ -4,16 +4,8 @@
 #include "openzl/codecs/flatpack/encode_flatpack_kernel.h"
 #include "openzl/zl_errors.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_flatpack_time_ms = 0.0;
-
 ZL_Report EI_flatpack(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -44,13 +36,5 @@ ZL_Report EI_flatpack(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     ZL_RET_R_IF_ERR(
             ZL_Output_commit(packed, ZS_FlatPack_packedSize(size, nbElts)));
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_flatpack_time_ms += current_duration;
-    fprintf(stderr, "[EI_flatpack] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_flatpack_time_ms, current_duration);
-
     return ZL_returnValue(2);
 }
@@ -1,9 +1,10 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include "openzl/codecs/float_deconstruct/encode_float_deconstruct_kernel.h"
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/mem.h"
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
 #    include <immintrin.h>
 
 static size_t const DWORDS_PER_AVX2_VEC = 8;
@@ -40,7 +41,8 @@ static void float32_deconstruct_encode_scalar(
     }
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
+ZL_TARGET_AVX2_BEGIN
 
 // Outline the mask definition to prevent a bad compiler optimization
 ZL_FORCE_NOINLINE __m256i getFloat32CrossLaneShuffleMask(void)
@@ -129,6 +131,7 @@ static void float32_deconstruct_encode_AVX2(
             signFrac + 3 * nbEltsEncoded,
             nbEltsRemaining);
 }
+ZL_TARGET_END
 #endif
 
 static void bfloat16_deconstruct_encode_scalar(
@@ -146,7 +149,8 @@ static void bfloat16_deconstruct_encode_scalar(
     }
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
+ZL_TARGET_AVX2_BEGIN
 static void bfloat16_deconstruct_encode_AVX2(
         uint16_t const* __restrict const src16,
         uint8_t* __restrict const exponent,
@@ -224,6 +228,7 @@ static void bfloat16_deconstruct_encode_AVX2(
             signFrac + nbEltsEncoded,
             nbEltsRemaining);
 }
+ZL_TARGET_END
 #endif
 
 static void float16_deconstruct_encode_scalar(
@@ -242,7 +247,8 @@ static void float16_deconstruct_encode_scalar(
     }
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
+ZL_TARGET_AVX2_BEGIN
 static void float16_deconstruct_encode_AVX2(
         uint16_t const* __restrict const src16,
         uint8_t* __restrict const exponent,
@@ -265,6 +271,7 @@ static void float16_deconstruct_encode_AVX2(
         ZL_writeCE16(signFrac + 2 * i, frac | sign);
     }
 }
+ZL_TARGET_END
 #endif
 
 void FLTDECON_float32_deconstruct_encode(
@@ -273,11 +280,13 @@ void FLTDECON_float32_deconstruct_encode(
         uint8_t* __restrict const signFrac,
         size_t const nbElts)
 {
-#if ZL_HAS_AVX2
-    float32_deconstruct_encode_AVX2(src32, exponent, signFrac, nbElts);
-#else
-    float32_deconstruct_encode_scalar(src32, exponent, signFrac, nbElts);
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        float32_deconstruct_encode_AVX2(src32, exponent, signFrac, nbElts);
+        return;
+    }
 #endif
+    float32_deconstruct_encode_scalar(src32, exponent, signFrac, nbElts);
 }
 
 void FLTDECON_bfloat16_deconstruct_encode(
@@ -286,11 +295,13 @@ void FLTDECON_bfloat16_deconstruct_encode(
         uint8_t* __restrict const signFrac,
         size_t const nbElts)
 {
-#if ZL_HAS_AVX2
-    bfloat16_deconstruct_encode_AVX2(src16, exponent, signFrac, nbElts);
-#else
-    bfloat16_deconstruct_encode_scalar(src16, exponent, signFrac, nbElts);
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        bfloat16_deconstruct_encode_AVX2(src16, exponent, signFrac, nbElts);
+        return;
+    }
 #endif
+    bfloat16_deconstruct_encode_scalar(src16, exponent, signFrac, nbElts);
 }
 
 void FLTDECON_float16_deconstruct_encode(
@@ -299,9 +310,11 @@ void FLTDECON_float16_deconstruct_encode(
         uint8_t* __restrict const signFrac,
         size_t const nbElts)
 {
-#if ZL_HAS_AVX2
-    float16_deconstruct_encode_AVX2(src16, exponent, signFrac, nbElts);
-#else
-    float16_deconstruct_encode_scalar(src16, exponent, signFrac, nbElts);
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        float16_deconstruct_encode_AVX2(src16, exponent, signFrac, nbElts);
+        return;
+    }
 #endif
+    float16_deconstruct_encode_scalar(src16, exponent, signFrac, nbElts);
 }
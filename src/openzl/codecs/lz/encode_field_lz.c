@@ -14,7 +14,24 @@ size_t ZL_FieldLz_maxNbSequences(size_t nbElts, size_t eltWidth)
     return nbElts / minMatch + 1;
 }
 
-static bool resolveLevel(
+/// Parameters of the hash chain match finders, for levels 6 to 9
+typedef struct {
+    ZS_MatchFinderStrategy_e strategy;
+    unsigned hashLog;
+    unsigned chainLog;
+    unsigned searchLog;
+    unsigned targetLength;
+    unsigned windowLog;
+} ZS_FieldLz_HcLevel;
+
+static const ZS_FieldLz_HcLevel kHcLevels[] = {
+    { ZS_MatchFinderStrategy_lazy, 20, 20, 4, 32, 24 },
+    { ZS_MatchFinderStrategy_lazy2, 21, 22, 5, 64, 26 },
+    { ZS_MatchFinderStrategy_opt, 22, 23, 5, 128, 27 },
+    { ZS_MatchFinderStrategy_opt2, 22, 24, 7, 512, 28 },
+};
+
+static ZS_matchFinder const* resolveLevel(
         ZS_MatchFinderParameters* params,
         size_t nbElts,
         size_t eltWidth,
@@ -22,10 +39,31 @@ static bool resolveLevel(
 {
     if (level <= 0)
         level = 3;
-    if (level >= 5)
-        level = 5;
-    bool greedy = level > 3;
+    if (level >= 9)
+        level = 9;
     memset(params, 0, sizeof(*params));
+    params->fieldSize = (uint32_t)eltWidth;
+    unsigned const srcLog = (unsigned)ZL_highbit32((unsigned)nbElts + 1) + 1;
+
+    if (level >= 6) {
+        ZS_FieldLz_HcLevel const* const hc = &kHcLevels[level - 6];
+        params->strategy       = hc->strategy;
+        params->lzHashLog      = ZL_MAX(ZL_MIN(hc->hashLog, srcLog), 10);
+        params->lzChainLog     = ZL_MAX(ZL_MIN(hc->chainLog, srcLog), 10);
+        params->lzSearchLog    = hc->searchLog;
+        params->lzTargetLength = hc->targetLength;
+        params->windowLog      = hc->windowLog;
+        // Long distance matching reaches beyond the window, and finds the
+        // long repeats that the hash chains may miss in large sources.
+        size_t const srcSize   = nbElts * eltWidth;
+        unsigned const byteLog = (unsigned)ZL_highbit64((uint64_t)srcSize + 1);
+        params->ldmEnabled     = level == 9 || (srcSize >> hc->windowLog) > 0;
+        params->ldmMinLength   = 64;
+        params->ldmHashLog     = ZL_MIN(ZL_MAX(byteLog, 17u) - 7, 22u);
+        return level <= 7 ? &ZS_lazyTokenLzMatchFinder
+                          : &ZS_optTokenLzMatchFinder;
+    }
+
     params->lzLargeMatch = true;
     if (level == 1) {
         params->lzTableLog   = 18;
@@ -43,14 +81,12 @@ static bool resolveLevel(
     if (level == 5) {
         params->lzTableLog = 22;
     }
-    unsigned const srcLog = (unsigned)ZL_highbit32((unsigned)nbElts + 1) + 1;
     if (srcLog < params->lzTableLog)
         params->lzTableLog = srcLog;
     if (params->lzTableLog < 10)
         params->lzTableLog = 10;
 
-    params->fieldSize = (uint32_t)eltWidth;
-    return greedy;
+    return level > 3 ? &ZS_greedyTokenLzMatchFinder : &ZS_tokenLzMatchFinder;
 }
 
 static ZL_Report writeOutSequences(
@@ -160,9 +196,14 @@ ZL_Report ZS2_FieldLz_compress(
 
     ZL_Report ret;
     size_t const srcSize = nbElts * eltWidth;
+    ZL_RET_R_IF_GT(srcSize_tooLarge, srcSize, ZS_window_maxIndex());
     ZS_MatchFinderParameters params;
-    bool const greedy = resolveLevel(&params, nbElts, eltWidth, level);
-    params.alloc      = alloc;
+    ZS_matchFinder const* const matchFinder =
+            resolveLevel(&params, nbElts, eltWidth, level);
+    params.alloc = alloc;
+    uint32_t const windowSize = params.windowLog
+            ? 1u << params.windowLog
+            : 1u << 23;
 
     ZS_seqStore seqStore;
     ZS_window window;
@@ -170,11 +211,9 @@ ZL_Report ZS2_FieldLz_compress(
         int error = ZS_seqStore_initBound(
                 &seqStore, srcSize, ZL_MAX(eltWidth, 4), alloc);
         error |=
-                ZS_window_init(&window, ZL_MIN((uint32_t)srcSize, 1u << 23), 8);
+                ZS_window_init(&window, ZL_MIN((uint32_t)srcSize, windowSize), 8);
         ZL_RET_R_IF(allocation, error);
     }
-    ZS_matchFinder const* matchFinder =
-            greedy ? &ZS_greedyTokenLzMatchFinder : &ZS_tokenLzMatchFinder;
     ZS_matchFinderCtx* mfCtx = matchFinder->ctx_create(&window, &params);
     ZL_RET_R_IF_NULL(allocation, mfCtx);
 
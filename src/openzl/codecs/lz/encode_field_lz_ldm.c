@@ -0,0 +1,159 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/lz/encode_field_lz_ldm.h"
+
+#include <string.h> // memcmp, memmove, memset
+
+#include "openzl/codecs/common/count.h"
+#include "openzl/codecs/dedup/encode_cdc_kernel.h"
+#include "openzl/common/assertion.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+
+/// One anchor every 2^kLdmSampleLog bytes on average
+#define kLdmSampleLog 5
+/// Number of bytes following an anchor which select its bucket
+#define kLdmKeySize 32
+#define kLdmBucketLog 2
+#define kLdmBucketSize (1u << kLdmBucketLog)
+
+typedef struct {
+    uint32_t pos; ///< Position + 1 of the anchor, 0 when empty
+    uint32_t checksum;
+} ZS_LdmEntry;
+
+static uint64_t ZS_ldmKey(uint8_t const* ptr)
+{
+    uint64_t key = 0;
+    for (size_t i = 0; i < kLdmKeySize; i += 8) {
+        key = (key ^ ZL_readLE64(ptr + i)) * 0x9E3779B97F4A7C15ULL;
+        key ^= key >> 29;
+    }
+    return key;
+}
+
+/// @returns the length of the match between the anchors @p pos and @p cand,
+/// extended backwards down to @p lowLimit, and writes its start.
+static size_t ZS_ldmMatchLength(
+        size_t* start,
+        uint8_t const* src,
+        size_t srcSize,
+        size_t pos,
+        size_t cand,
+        size_t lowLimit,
+        uint32_t fieldSize)
+{
+    size_t const fieldMask = fieldSize - 1;
+    size_t const forward =
+            ZS_count(src + pos, src + cand, src + srcSize) & ~fieldMask;
+    if (forward == 0) {
+        return 0;
+    }
+    size_t backward = 0;
+    while (cand >= backward + fieldSize && pos - backward - fieldSize >= lowLimit
+           && !memcmp(src + pos - backward - fieldSize,
+                      src + cand - backward - fieldSize,
+                      fieldSize)) {
+        backward += fieldSize;
+    }
+    *start = pos - backward;
+    return backward + forward;
+}
+
+int ZS_FieldLz_findLongMatches(
+        ZS_LdmMatches* ldm,
+        uint8_t const* src,
+        size_t srcSize,
+        uint32_t fieldSize,
+        uint32_t hashLog,
+        uint32_t minLength,
+        ZL_FieldLz_Allocator alloc)
+{
+    ZL_ASSERT(ZL_isPow2(fieldSize));
+    ZL_ASSERT_GE(minLength, kLdmKeySize);
+    ZL_ASSERT_LT(srcSize, (size_t)UINT32_MAX);
+    ldm->matches   = NULL;
+    ldm->nbMatches = 0;
+    ldm->next      = 0;
+    if (srcSize < 2 * (size_t)minLength) {
+        return 0;
+    }
+
+    size_t const maxNbMatches = srcSize / minLength;
+    size_t const nbWords      = ZS_cdcCandidatesWords(srcSize);
+    size_t const nbEntries    = (size_t)1 << (hashLog + kLdmBucketLog);
+    ldm->matches              = (ZS_LdmMatch*)alloc.alloc(
+            alloc.opaque, maxNbMatches * sizeof(ZS_LdmMatch));
+    uint64_t* const candidates = (uint64_t*)alloc.alloc(
+            alloc.opaque, nbWords * sizeof(uint64_t));
+    ZS_LdmEntry* const table = (ZS_LdmEntry*)alloc.alloc(
+            alloc.opaque, nbEntries * sizeof(ZS_LdmEntry));
+    if (ldm->matches == NULL || candidates == NULL || table == NULL) {
+        return 1;
+    }
+    memset(table, 0, nbEntries * sizeof(ZS_LdmEntry));
+
+    ZS_cdcFindCandidates(candidates, src, srcSize, kLdmSampleLog);
+
+    size_t const fieldMask = fieldSize - 1;
+    size_t matchEnd        = 0;
+    for (size_t w = 0; w < nbWords; ++w) {
+        uint64_t bits = candidates[w];
+        while (bits != 0) {
+            size_t const anchor = (w * 64 + (size_t)ZL_ctz64(bits)) & ~fieldMask;
+            bits &= bits - 1;
+            if (anchor < matchEnd || anchor + kLdmKeySize > srcSize) {
+                continue;
+            }
+            uint64_t const key      = ZS_ldmKey(src + anchor);
+            uint32_t const checksum = (uint32_t)key;
+            ZS_LdmEntry* const bucket =
+                    table + ((key >> (64 - hashLog)) << kLdmBucketLog);
+
+            size_t bestStart  = 0;
+            size_t bestLength = 0;
+            size_t bestCand   = 0;
+            for (size_t i = 0; i < kLdmBucketSize; ++i) {
+                if (bucket[i].pos == 0 || bucket[i].checksum != checksum) {
+                    continue;
+                }
+                size_t const cand = bucket[i].pos - 1;
+                if (cand >= anchor) {
+                    continue;
+                }
+                size_t start;
+                size_t const length = ZS_ldmMatchLength(
+                        &start,
+                        src,
+                        srcSize,
+                        anchor,
+                        cand,
+                        matchEnd,
+                        fieldSize);
+                if (length > bestLength) {
+                    bestStart  = start;
+                    bestLength = length;
+                    bestCand   = cand;
+                }
+            }
+
+            // Insert the anchor at the front of its bucket
+            memmove(bucket + 1,
+                    bucket,
+                    (kLdmBucketSize - 1) * sizeof(ZS_LdmEntry));
+            bucket[0].pos      = (uint32_t)anchor + 1;
+            bucket[0].checksum = checksum;
+
+            if (bestLength >= minLength) {
+                ZL_ASSERT_LT(ldm->nbMatches, maxNbMatches);
+                ZS_LdmMatch* const match = &ldm->matches[ldm->nbMatches++];
+                match->start             = (uint32_t)bestStart;
+                match->length            = (uint32_t)bestLength;
+                match->offset            = (uint32_t)(anchor - bestCand);
+                matchEnd                 = bestStart + bestLength;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_LZ_ENCODE_FIELD_LZ_LDM_H
+#define ZSTRONG_TRANSFORMS_LZ_ENCODE_FIELD_LZ_LDM_H
+
+/**
+ * Long distance matching (LDM) for Field LZ.
+ *
+ * Anchors are sampled with the content-defined chunking gear hash, so that
+ * repeated content produces the same anchors wherever it is. Only anchors are
+ * indexed, which finds long repeats at any distance in the source, in linear
+ * time, and with a table much smaller than the window.
+ * The hash chain match finders use these matches as extra candidates.
+ */
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uintX_t
+
+#include "openzl/codecs/lz/common_field_lz.h"
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+typedef struct {
+    uint32_t start;  ///< Position of the match in the source
+    uint32_t length; ///< Bytes, a multiple of the field size
+    uint32_t offset; ///< Bytes, a multiple of the field size
+} ZS_LdmMatch;
+
+typedef struct {
+    ZS_LdmMatch* matches; ///< Sorted, and non overlapping
+    size_t nbMatches;
+    size_t next; ///< First match which may cover the next queried position
+} ZS_LdmMatches;
+
+/**
+ * Finds matches of at least @p minLength bytes in @p src, which start on a
+ * field boundary, and whose offsets are multiples of @p fieldSize.
+ * Anchors are indexed in a table of 2^hashLog buckets.
+ *
+ * @returns 0 on success, or non-zero on allocation failure
+ */
+int ZS_FieldLz_findLongMatches(
+        ZS_LdmMatches* ldm,
+        uint8_t const* src,
+        size_t srcSize,
+        uint32_t fieldSize,
+        uint32_t hashLog,
+        uint32_t minLength,
+        ZL_FieldLz_Allocator alloc);
+
+/**
+ * @returns the match covering position @p pos of the source, or NULL.
+ * Positions should be queried in increasing order: matches which end before
+ * a queried position are never returned again.
+ */
+ZL_INLINE ZS_LdmMatch const* ZS_LdmMatches_find(ZS_LdmMatches* ldm, size_t pos)
+{
+    while (ldm->next < ldm->nbMatches) {
+        ZS_LdmMatch const* const match = &ldm->matches[ldm->next];
+        if (pos < match->start) {
+            return NULL;
+        }
+        if (pos < (size_t)match->start + match->length) {
+            return match;
+        }
+        ++ldm->next;
+    }
+    return NULL;
+}
+
+ZL_END_C_DECLS
+
+#endif
@@ -14,10 +14,6 @@
 #include "openzl/zl_portability.h"
 #include "openzl/zl_selector.h"
 
-#include <stdio.h>
-#include <time.h>
-static double ZS2_transposedLiteralStreamSelector_impl_time_ms = 0.0;
-
 static size_t reportToSize(ZL_GraphReport report)
 {
     if (ZL_isError(report.finalCompressedSize))
@@ -99,10 +95,6 @@ ZL_GraphID ZS2_transposedLiteralStreamSelector_impl(
         const ZL_Input* input,
         const ZS2_transposedLiteralStreamSelector_Successors* successors)
 {
-
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     if (ZL_Selector_getCParam(selCtx, ZL_CParam_decompressionLevel) == 1) {
         return ZL_fastTransposedLiteralStreamSelector(
                 selCtx, input, successors);
@@ -149,14 +141,6 @@ ZL_GraphID ZS2_transposedLiteralStreamSelector_impl(
     bool const delta          = gainSize(deltaHuffSize, kDeltaGain) < huffSize;
     size_t const bestHuffSize = delta ? deltaHuffSize : huffSize;
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    ZS2_transposedLiteralStreamSelector_impl_time_ms += current_duration;
-    fprintf(stderr, "[ZS2_transposedLiteralStreamSelector] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, ZS2_transposedLiteralStreamSelector_impl_time_ms, current_duration);
-
     // If we don't get enough ratio, don't compress at all
     {
         if (gainSize(bestHuffSize, kHuffGain) >= inputSize) {
@@ -12,11 +12,6 @@
 #include "openzl/zl_graph_api.h"
 #include "openzl/zl_reflection.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_fieldLz_time_ms = 0.0;
-static size_t EI_fieldLz_contentsize = 0;
-
 /**
  * Set the maximum bytes to process to 4B to avoid overflow in the match finder.
  * It could likely be higher, but this is close enough to 2^32-1.
@@ -36,9 +31,6 @@ static ZL_FieldLz_Allocator getAlloc(ZL_Encoder* eictx)
 
 ZL_Report EI_fieldLz(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_RESULT_DECLARE_SCOPE_REPORT(eictx);
 
     ZL_ASSERT_EQ(nbIns, 1);
@@ -48,8 +40,6 @@ ZL_Report EI_fieldLz(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     size_t const eltWidth = ZL_Input_eltWidth(in);
     size_t const maxNbSeq = ZL_FieldLz_maxNbSequences(nbElts, eltWidth);
 
-    EI_fieldLz_contentsize += ZL_Input_contentSize(in);
-
     ZL_ASSERT_EQ(ZL_Input_type(in), ZL_Type_struct);
     // TODO(terrelln): Enable field-lz for more field sizes
     if (!ZL_isPow2(eltWidth) || eltWidth == 1 || eltWidth > 8) {
@@ -99,8 +89,10 @@ ZL_Report EI_fieldLz(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     ZL_IntParam compressionLevelOverride = ZL_Encoder_getLocalIntParam(
             eictx, ZL_FIELD_LZ_COMPRESSION_LEVEL_OVERRIDE_PID);
     if (compressionLevelOverride.paramId == ZL_LP_INVALID_PARAMID) {
-        compressionLevel =
-                ZL_Encoder_getCParam(eictx, ZL_CParam_compressionLevel);
+        // Levels above 5 spend much more time for their ratio gains, so they
+        // must be requested explicitly with the override.
+        compressionLevel = ZL_MIN(
+                ZL_Encoder_getCParam(eictx, ZL_CParam_compressionLevel), 5);
     } else {
         compressionLevel = compressionLevelOverride.paramValue;
     }
@@ -134,13 +126,6 @@ ZL_Report EI_fieldLz(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     ZL_LOG(TRANSFORM, "#extraLiteralLengths = %zu", dst.nbExtraLiteralLengths);
     ZL_LOG(TRANSFORM, "#extraMatchLengths = %zu", dst.nbExtraMatchLengths);
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_fieldLz_time_ms += current_duration;
-    fprintf(stderr, "[EI_fieldLz] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | content_size: %zu | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_fieldLz_time_ms, EI_fieldLz_contentsize, current_duration);
     return ZL_returnValue(5);
 }
 
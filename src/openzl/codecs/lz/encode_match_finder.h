@@ -14,6 +14,9 @@ typedef enum {
     ZS_MatchFinderStrategy_greedy,
     ZS_MatchFinderStrategy_lazy,
     ZS_MatchFinderStrategy_lazy2,
+    ZS_MatchFinderStrategy_opt,  //< Price-based optimal parsing
+    ZS_MatchFinderStrategy_opt2, //< Optimal parsing, with a first pass to
+                                 // collect the statistics
 } ZS_MatchFinderStrategy_e;
 
 /**
@@ -39,6 +42,13 @@ typedef struct {
     unsigned lzTableLog;
     unsigned lzRowLog;
     bool lzLargeMatch;
+    unsigned lzTargetLength; //< Stop searching at a match of this many fields
+
+    bool ldmEnabled;       //< Long distance matching
+    unsigned ldmHashLog;   //< Log # of LDM buckets
+    unsigned ldmMinLength; //< Minimum match length for LDM, in bytes
+
+    unsigned windowLog; //< Log of the maximum LZ distance (0 == default)
 
     unsigned tableLog;
     unsigned rowLog;
@@ -75,6 +85,11 @@ typedef struct {
 
 extern const ZS_matchFinder ZS_tokenLzMatchFinder;
 extern const ZS_matchFinder ZS_greedyTokenLzMatchFinder;
+/// Hash chain match finder with lazy parsing (strategy lazy or lazy2)
+extern const ZS_matchFinder ZS_lazyTokenLzMatchFinder;
+/// Hash chain match finder with price-based optimal parsing
+/// (strategy opt or opt2)
+extern const ZS_matchFinder ZS_optTokenLzMatchFinder;
 
 ZL_END_C_DECLS
 
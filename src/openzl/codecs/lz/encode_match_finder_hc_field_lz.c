@@ -0,0 +1,986 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+/**
+ * Hash chain match finders for the high Field LZ levels. They produce the
+ * same sequences as the faster match finders, so they trade encoding speed
+ * for ratio, without changing the decoding speed.
+ *
+ * - ZS_lazyTokenLzMatchFinder defers a match when the next field (or the
+ *   field after it, for lazy2) starts a better one.
+ * - ZS_optTokenLzMatchFinder finds the cheapest parse of each block of fields,
+ *   given every match found at every position. Prices come from the
+ *   statistics of the literals, offsets and lengths emitted so far. The opt2
+ *   strategy parses the beginning of the source twice, so that the first
+ *   blocks are priced with real statistics.
+ *
+ * Both take long distance matches (see encode_field_lz_ldm.h) as extra
+ * candidates, which reach beyond the hash chain window.
+ */
+
+#include <string.h>
+
+#include "openzl/codecs/common/count.h"
+#include "openzl/codecs/common/window.h"
+#include "openzl/codecs/lz/encode_field_lz_ldm.h"
+#include "openzl/codecs/lz/encode_field_lz_sequences.h"
+#include "openzl/codecs/lz/encode_match_finder.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/hash.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/portability.h"
+#include "openzl/shared/utils.h"
+
+#define kNumRep 3
+#define kSearchStrength 8
+#define kMaxSearchLog 8
+#define kMaxNbMatches (kNumRep + (1u << kMaxSearchLog) + 1)
+
+/// Number of fields parsed at once by the optimal parser
+#define kOptNum (1u << 12)
+/// Bytes parsed by the first pass of the opt2 strategy
+#define kOptSeedSize (1u << 20)
+
+/// Prices are in 1/256th of a bit
+#define kBitCostAccuracy 8
+#define kBitCostMultiplier (1 << kBitCostAccuracy)
+#define kMaxPrice (1 << 30)
+
+/// Literals are transposed, so each byte of a field has its own statistics
+#define kNbLitLanes 8
+#define kLitSumMax (1u << 17)
+#define kCodeSumMax (1u << 14)
+
+/// The offset of a match is stored as an offBase :
+/// a repcode index if < kNumRep, otherwise the offset (in bytes) + kNumRep.
+#define ZS_OFFBASE_IS_REP(offBase) ((offBase) < kNumRep)
+#define ZS_OFFSET_TO_OFFBASE(offset) ((offset) + kNumRep)
+#define ZS_OFFBASE_TO_OFFSET(offBase) ((offBase) - kNumRep)
+
+typedef struct {
+    uint32_t offBase;
+    uint32_t length; ///< In bytes
+} ZS_HcMatch;
+
+typedef struct {
+    int price; ///< From the start of the block
+    uint32_t offBase;
+    uint32_t mlen;   ///< Fields of the match ending here, 0 after a literal
+    uint32_t litlen; ///< Fields of the literals ending here
+    uint32_t rep[kNumRep];
+} ZS_OptNode;
+
+typedef struct {
+    uint32_t pos;  ///< Field of the block where the match starts
+    uint32_t mlen; ///< In fields
+    uint32_t offBase;
+} ZS_OptMatch;
+
+typedef struct {
+    uint32_t litFreq[kNbLitLanes][256];
+    uint32_t litSum[kNbLitLanes];
+    uint32_t ofFreq[kNumRep + 1];
+    uint32_t ofSum;
+    uint32_t llFreq[kMaxLitLengthCode + 1];
+    uint32_t llSum;
+    uint32_t mlFreq[kMaxMatchLengthCode + 1];
+    uint32_t mlSum;
+    uint32_t offCodeFreq[32];
+    uint32_t offCodeSum;
+    bool dirty; ///< The prices must be updated
+
+    int litPrice[kNbLitLanes][256];
+    int ofPrice[kNumRep + 1];
+    int llPrice[kMaxLitLengthCode + 1];
+    int mlPrice[kMaxMatchLengthCode + 1];
+    int offCodePrice[32];
+} ZS_OptStats;
+
+typedef struct {
+    ZS_matchFinderCtx base;
+    ZS_MatchFinderParameters params;
+    uint32_t* hashTable;
+    uint32_t* chainTable;
+    uint32_t nextToUpdate;
+    ZS_LdmMatches ldm;
+    ZS_HcMatch matches[kMaxNbMatches];
+    // Only used by the optimal parser
+    ZS_OptStats* stats;
+    ZS_OptNode* opt;
+    ZS_OptMatch* path;
+} ZS_hcTokenLzCtx;
+
+static uint32_t minMatchLength(uint32_t fieldSize)
+{
+    return fieldSize < 4 ? 4 : fieldSize;
+}
+
+static ZS_hcTokenLzCtx* ZS_hcTokenLzCtx_create(
+        ZS_window const* window,
+        ZS_MatchFinderParameters const* params)
+{
+    ZL_ASSERT_LE(params->lzSearchLog, kMaxSearchLog);
+    ZS_hcTokenLzCtx* const ctx =
+            params->alloc.alloc(params->alloc.opaque, sizeof(ZS_hcTokenLzCtx));
+    if (!ctx) {
+        return NULL;
+    }
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->params = *params;
+
+    size_t const hashSize  = sizeof(uint32_t) << params->lzHashLog;
+    size_t const chainSize = sizeof(uint32_t) << params->lzChainLog;
+    ctx->hashTable = params->alloc.alloc(params->alloc.opaque, hashSize);
+    ctx->chainTable = params->alloc.alloc(params->alloc.opaque, chainSize);
+    if (!ctx->hashTable || !ctx->chainTable) {
+        return NULL;
+    }
+    // The chain table is only read through the positions already inserted
+    memset(ctx->hashTable, 0, hashSize);
+
+    ctx->base.window = window;
+    return ctx;
+}
+
+static ZS_matchFinderCtx* ZS_lazyTokenLzMatchFinderCtx_create(
+        ZS_window const* window,
+        ZS_MatchFinderParameters const* params)
+{
+    ZS_hcTokenLzCtx* const ctx = ZS_hcTokenLzCtx_create(window, params);
+    return ctx ? &ctx->base : NULL;
+}
+
+static ZS_matchFinderCtx* ZS_optTokenLzMatchFinderCtx_create(
+        ZS_window const* window,
+        ZS_MatchFinderParameters const* params)
+{
+    ZS_hcTokenLzCtx* const ctx = ZS_hcTokenLzCtx_create(window, params);
+    if (!ctx) {
+        return NULL;
+    }
+    ctx->stats = params->alloc.alloc(params->alloc.opaque, sizeof(ZS_OptStats));
+    ctx->opt   = params->alloc.alloc(
+            params->alloc.opaque, (kOptNum + 1) * sizeof(ZS_OptNode));
+    ctx->path = params->alloc.alloc(
+            params->alloc.opaque, (kOptNum + 1) * sizeof(ZS_OptMatch));
+    if (!ctx->stats || !ctx->opt || !ctx->path) {
+        return NULL;
+    }
+    return &ctx->base;
+}
+
+/// Prepares the context to parse @p src, which must be the whole window.
+static void ZS_hc_start(
+        ZS_hcTokenLzCtx* ctx,
+        uint8_t const* src,
+        size_t size,
+        bool findLongMatches)
+{
+    ZS_window const* const window = ctx->base.window;
+    ctx->nextToUpdate = (uint32_t)(src - window->base);
+    ctx->ldm.next     = 0;
+    if (findLongMatches && ctx->params.ldmEnabled) {
+        int const error = ZS_FieldLz_findLongMatches(
+                &ctx->ldm,
+                src,
+                size,
+                ctx->params.fieldSize,
+                ctx->params.ldmHashLog,
+                ctx->params.ldmMinLength,
+                ctx->params.alloc);
+        if (error) {
+            // Long distance matches are optional
+            ctx->ldm.nbMatches = 0;
+        }
+    }
+}
+
+ZL_FORCE_INLINE size_t
+ZS_hc_hash(uint8_t const* ptr, uint32_t hashLog, uint32_t kFieldSize)
+{
+    return ZL_hashPtr(ptr, hashLog, ZL_MIN(minMatchLength(kFieldSize), 8));
+}
+
+/// Inserts the fields up to @p target (excluded) in the hash chains
+ZL_FORCE_INLINE void ZS_hc_insert(
+        ZS_hcTokenLzCtx* ctx,
+        uint8_t const* base,
+        uint32_t target,
+        uint32_t kFieldSize)
+{
+    int const kFieldBits     = ZL_highbit32(kFieldSize);
+    uint32_t const hashLog   = ctx->params.lzHashLog;
+    uint32_t const chainMask = (1u << ctx->params.lzChainLog) - 1;
+    uint32_t* const table    = ctx->hashTable;
+    uint32_t* const chain    = ctx->chainTable;
+    uint32_t idx             = ctx->nextToUpdate;
+    for (; idx < target; idx += kFieldSize) {
+        size_t const h = ZS_hc_hash(base + idx, hashLog, kFieldSize);
+        chain[(idx >> kFieldBits) & chainMask] = table[h];
+        table[h]                               = idx;
+    }
+    ctx->nextToUpdate = idx;
+}
+
+/**
+ * Fills ctx->matches with the matches at @p ip : first the repcodes, then the
+ * hash chain candidates, then the long distance match. Each match is longer
+ * than the previous one, so each length is covered by the cheapest offset.
+ * The search stops at the first match of lzTargetLength fields.
+ *
+ * @returns the number of matches
+ * @pre ip + minMatchLength(kFieldSize) <= iend
+ */
+ZL_FORCE_INLINE size_t ZS_hc_getMatches(
+        ZS_hcTokenLzCtx* ctx,
+        uint8_t const* src,
+        uint8_t const* ip,
+        uint8_t const* iend,
+        uint32_t const rep[kNumRep],
+        uint32_t const kFieldSize)
+{
+    ZS_HcMatch* const matches = ctx->matches;
+    int const kFieldBits      = ZL_highbit32(kFieldSize);
+    size_t const kFieldMask   = kFieldSize - 1;
+    size_t const targetLength = (size_t)ctx->params.lzTargetLength
+            << kFieldBits;
+    size_t const maxLength = (size_t)(iend - ip);
+    size_t bestLength      = minMatchLength(kFieldSize) - 1;
+    size_t nbMatches       = 0;
+    ZL_ASSERT_LT(bestLength, maxLength);
+
+    for (uint32_t r = 0; r < kNumRep; ++r) {
+        if (rep[r] > (size_t)(ip - src)) {
+            continue;
+        }
+        size_t const length = ZS_count(ip, ip - rep[r], iend) & ~kFieldMask;
+        if (length > bestLength) {
+            matches[nbMatches].offBase  = r;
+            matches[nbMatches].length   = (uint32_t)length;
+            bestLength                  = length;
+            ++nbMatches;
+            if (length >= targetLength || length == maxLength) {
+                return nbMatches;
+            }
+        }
+    }
+
+    {
+        ZS_window const* const window = ctx->base.window;
+        uint8_t const* const base     = window->base;
+        uint32_t const current        = (uint32_t)(ip - base);
+        uint32_t const lowLimit       = ZL_MAX(
+                ZS_window_getLowestMatchIndex(window, current),
+                (uint32_t)(src - base));
+        uint32_t const chainMask  = (1u << ctx->params.lzChainLog) - 1;
+        uint32_t const chainReach = (chainMask + 1) << kFieldBits;
+        uint32_t const* const chain = ctx->chainTable;
+        uint32_t nbAttempts         = 1u << ctx->params.lzSearchLog;
+
+        ZS_hc_insert(ctx, base, current, kFieldSize);
+        // Older positions may have been overwritten in the chain table
+        uint32_t const minChain = ctx->nextToUpdate > chainReach
+                ? ctx->nextToUpdate - chainReach
+                : 0;
+        uint32_t matchIdx = ctx->hashTable[ZS_hc_hash(
+                ip, ctx->params.lzHashLog, kFieldSize)];
+        for (; matchIdx >= lowLimit && nbAttempts > 0; --nbAttempts) {
+            // The lazy parser may search behind the last inserted position
+            if (matchIdx < current) {
+                uint8_t const* const match = base + matchIdx;
+                if (match[bestLength] == ip[bestLength]) {
+                    size_t const length =
+                            ZS_count(ip, match, iend) & ~kFieldMask;
+                    if (length > bestLength) {
+                        matches[nbMatches].offBase =
+                                ZS_OFFSET_TO_OFFBASE(current - matchIdx);
+                        matches[nbMatches].length = (uint32_t)length;
+                        bestLength                = length;
+                        ++nbMatches;
+                        if (length >= targetLength || length == maxLength) {
+                            break;
+                        }
+                    }
+                }
+            }
+            if (matchIdx <= minChain) {
+                break;
+            }
+            matchIdx = chain[(matchIdx >> kFieldBits) & chainMask];
+        }
+    }
+
+    if (ctx->ldm.nbMatches > 0) {
+        size_t const pos = (size_t)(ip - src);
+        ZS_LdmMatch const* const match = ZS_LdmMatches_find(&ctx->ldm, pos);
+        if (match != NULL) {
+            size_t const length = (size_t)match->start + match->length - pos;
+            if (length > bestLength) {
+                matches[nbMatches].offBase =
+                        ZS_OFFSET_TO_OFFBASE(match->offset);
+                matches[nbMatches].length = (uint32_t)length;
+                ++nbMatches;
+            }
+        }
+    }
+    ZL_ASSERT_LE(nbMatches, kMaxNbMatches);
+    return nbMatches;
+}
+
+/// Updates the repcodes the same way as the decoder
+ZL_FORCE_INLINE void ZS_hc_updateReps(uint32_t rep[kNumRep], uint32_t offBase)
+{
+    if (ZS_OFFBASE_IS_REP(offBase)) {
+        uint32_t const offset = rep[offBase];
+        for (uint32_t r = offBase; r > 0; --r) {
+            rep[r] = rep[r - 1];
+        }
+        rep[0] = offset;
+    } else {
+        memmove(&rep[1], &rep[0], (kNumRep - 1) * sizeof(rep[0]));
+        rep[0] = ZS_OFFBASE_TO_OFFSET(offBase);
+    }
+}
+
+ZL_FORCE_INLINE void ZS_hc_storeSequence(
+        ZS_seqStore* seqs,
+        uint8_t const* anchor,
+        uint8_t const* ip,
+        uint8_t const* iend,
+        ZS_HcMatch match,
+        uint32_t rep[kNumRep],
+        int kFieldBits)
+{
+    ZS_sequence seq;
+    seq.literalLength = (uint32_t)(ip - anchor);
+    seq.matchLength   = match.length;
+    if (ZS_OFFBASE_IS_REP(match.offBase)) {
+        seq.matchType = ZS_mt_rep;
+        seq.matchCode = match.offBase;
+    } else {
+        seq.matchType = ZS_mt_lz;
+        seq.matchCode = ZS_OFFBASE_TO_OFFSET(match.offBase) >> kFieldBits;
+    }
+    ZS_hc_updateReps(rep, match.offBase);
+    ZS_seqStore_store(seqs, anchor, iend, &seq);
+}
+
+/// Estimates the bits saved by a match, as in zstd's lazy parser, counting
+/// the length in fields
+ZL_FORCE_INLINE int64_t ZS_lazy_gain(ZS_HcMatch match, int kFieldBits)
+{
+    uint32_t const offCode = ZS_OFFBASE_IS_REP(match.offBase)
+            ? match.offBase + 1
+            : (ZS_OFFBASE_TO_OFFSET(match.offBase) >> kFieldBits) + kNumRep
+                    + 1;
+    return (int64_t)(match.length >> kFieldBits) * 4 - ZL_highbit32(offCode);
+}
+
+ZL_FORCE_INLINE void ZS_lazyTokenLzMatchFinder_parseT(
+        ZS_matchFinderCtx* baseCtx,
+        ZS_seqStore* seqs,
+        uint8_t const* src,
+        size_t size,
+        uint32_t const kFieldSize)
+{
+    ZS_hcTokenLzCtx* const ctx =
+            ZL_CONTAINER_OF(baseCtx, ZS_hcTokenLzCtx, base);
+    int const kFieldBits     = ZL_highbit32(kFieldSize);
+    uint32_t const kMinMatch = minMatchLength(kFieldSize);
+    uint32_t const depth =
+            ctx->params.strategy == ZS_MatchFinderStrategy_lazy2 ? 2 : 1;
+    size_t const targetLength = (size_t)ctx->params.lzTargetLength
+            << kFieldBits;
+
+    uint8_t const* ip         = src;
+    uint8_t const* anchor     = src;
+    uint8_t const* const iend = src + size;
+    uint32_t rep[kNumRep] = { kFieldSize, 2 * kFieldSize, 4 * kFieldSize };
+
+    ZS_hc_start(ctx, src, size, true);
+    if (size < kMinMatch) {
+        ZS_seqStore_storeLastLiterals(seqs, anchor, size);
+        return;
+    }
+    uint8_t const* const ilimit = iend - kMinMatch;
+
+    while (ip <= ilimit) {
+        size_t const nbMatches =
+                ZS_hc_getMatches(ctx, src, ip, iend, rep, kFieldSize);
+        if (nbMatches == 0) {
+            size_t const step =
+                    ((size_t)(ip - anchor) >> (kSearchStrength + kFieldBits))
+                    + 1;
+            ip += step << kFieldBits;
+            continue;
+        }
+        ZS_HcMatch best = ctx->matches[nbMatches - 1];
+
+        // Take a match starting 1 (or 2) fields later if it is better
+        for (bool improved = true; improved && best.length < targetLength;) {
+            improved = false;
+            for (uint32_t d = 1; d <= depth && !improved; ++d) {
+                uint8_t const* const ip2 = ip + ((size_t)d << kFieldBits);
+                if (ip2 > ilimit) {
+                    break;
+                }
+                size_t const nb2 =
+                        ZS_hc_getMatches(ctx, src, ip2, iend, rep, kFieldSize);
+                if (nb2 == 0) {
+                    continue;
+                }
+                ZS_HcMatch const match2 = ctx->matches[nb2 - 1];
+                if (ZS_lazy_gain(match2, kFieldBits)
+                    > ZS_lazy_gain(best, kFieldBits) + (d == 1 ? 4 : 7)) {
+                    best     = match2;
+                    ip       = ip2;
+                    improved = true;
+                }
+            }
+        }
+
+        // Catch up
+        {
+            uint32_t const offset = ZS_OFFBASE_IS_REP(best.offBase)
+                    ? rep[best.offBase]
+                    : ZS_OFFBASE_TO_OFFSET(best.offBase);
+            uint8_t const* match = ip - offset;
+            while (ip > anchor && (size_t)(match - src) >= kFieldSize
+                   && !memcmp(ip - kFieldSize, match - kFieldSize, kFieldSize)) {
+                ip -= kFieldSize;
+                match -= kFieldSize;
+                best.length += kFieldSize;
+            }
+        }
+
+        ZS_hc_storeSequence(seqs, anchor, ip, iend, best, rep, kFieldBits);
+        anchor = ip = ip + best.length;
+    }
+    ZL_ASSERT_LE(anchor, iend);
+    ZS_seqStore_storeLastLiterals(seqs, anchor, (size_t)(iend - anchor));
+}
+
+/* *********************************
+ *  Prices
+ ***********************************/
+
+/// @returns log2(rawStat + 1) in 1/256th of bits, linearly interpolated
+static uint32_t ZS_opt_weight(uint32_t rawStat)
+{
+    uint32_t const stat = rawStat + 1;
+    uint32_t const hb   = (uint32_t)ZL_highbit32(stat);
+    return hb * kBitCostMultiplier + ((stat << kBitCostAccuracy) >> hb);
+}
+
+static void ZS_opt_setPrices(
+        int* prices,
+        uint32_t const* freqs,
+        size_t nbSymbols,
+        uint32_t sum)
+{
+    uint32_t const sumWeight = ZS_opt_weight(sum);
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        prices[s] = (int)sumWeight - (int)ZS_opt_weight(freqs[s]);
+    }
+}
+
+/// Halves the frequencies, keeping them non-zero.
+/// @returns the new sum
+static uint32_t ZS_opt_downscale(uint32_t* freqs, size_t nbSymbols)
+{
+    uint32_t sum = 0;
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        freqs[s] = 1 + (freqs[s] >> 1);
+        sum += freqs[s];
+    }
+    return sum;
+}
+
+static uint32_t ZS_opt_sum(uint32_t const* freqs, size_t nbSymbols)
+{
+    uint32_t sum = 0;
+    for (size_t s = 0; s < nbSymbols; ++s) {
+        sum += freqs[s];
+    }
+    return sum;
+}
+
+/// Initializes the literals statistics from the beginning of the source, and
+/// favors short lengths and repcodes.
+static void ZS_opt_initStats(
+        ZS_OptStats* stats,
+        uint8_t const* src,
+        size_t size,
+        uint32_t fieldSize)
+{
+    memset(stats, 0, sizeof(*stats));
+    size_t const sampleSize = ZL_MIN(size, (size_t)1 << 16);
+    for (size_t i = 0; i < sampleSize; ++i) {
+        stats->litFreq[(i & (fieldSize - 1)) & (kNbLitLanes - 1)][src[i]]++;
+    }
+    for (size_t l = 0; l < kNbLitLanes; ++l) {
+        for (size_t s = 0; s < 256; ++s) {
+            stats->litFreq[l][s] = 1 + (stats->litFreq[l][s] >> 3);
+        }
+        stats->litSum[l] = ZS_opt_sum(stats->litFreq[l], 256);
+    }
+    for (uint32_t c = 0; c <= kMaxLitLengthCode; ++c) {
+        stats->llFreq[c] = c < 4 ? 4 : 1;
+    }
+    for (uint32_t c = 0; c <= kMaxMatchLengthCode; ++c) {
+        stats->mlFreq[c] = c < 4 ? 4 : 1;
+    }
+    for (uint32_t c = 0; c < 32; ++c) {
+        stats->offCodeFreq[c] = 1;
+    }
+    stats->ofFreq[0]  = 4;
+    stats->ofFreq[1]  = 2;
+    stats->ofFreq[2]  = 1;
+    stats->ofFreq[3]  = 4;
+    stats->llSum      = ZS_opt_sum(stats->llFreq, kMaxLitLengthCode + 1);
+    stats->mlSum      = ZS_opt_sum(stats->mlFreq, kMaxMatchLengthCode + 1);
+    stats->offCodeSum = ZS_opt_sum(stats->offCodeFreq, 32);
+    stats->ofSum      = ZS_opt_sum(stats->ofFreq, kNumRep + 1);
+    stats->dirty      = true;
+}
+
+static void ZS_opt_updatePrices(ZS_OptStats* stats)
+{
+    if (!stats->dirty) {
+        return;
+    }
+    for (size_t l = 0; l < kNbLitLanes; ++l) {
+        ZS_opt_setPrices(
+                stats->litPrice[l], stats->litFreq[l], 256, stats->litSum[l]);
+    }
+    ZS_opt_setPrices(stats->ofPrice, stats->ofFreq, kNumRep + 1, stats->ofSum);
+    ZS_opt_setPrices(
+            stats->llPrice,
+            stats->llFreq,
+            kMaxLitLengthCode + 1,
+            stats->llSum);
+    ZS_opt_setPrices(
+            stats->mlPrice,
+            stats->mlFreq,
+            kMaxMatchLengthCode + 1,
+            stats->mlSum);
+    ZS_opt_setPrices(
+            stats->offCodePrice, stats->offCodeFreq, 32, stats->offCodeSum);
+    stats->dirty = false;
+}
+
+/// Records a sequence of @p litLength bytes of literals, and a match of
+/// @p mlCode fields above the minimum
+static void ZS_opt_recordSequence(
+        ZS_OptStats* stats,
+        uint8_t const* literals,
+        size_t litLength,
+        uint32_t offBase,
+        uint32_t mlCode,
+        uint32_t fieldSize)
+{
+    int const fieldBits = ZL_highbit32(fieldSize);
+    for (size_t i = 0; i < litLength; ++i) {
+        size_t const lane = (i & (fieldSize - 1)) & (kNbLitLanes - 1);
+        stats->litFreq[lane][literals[i]]++;
+        if (++stats->litSum[lane] > kLitSumMax) {
+            stats->litSum[lane] = ZS_opt_downscale(stats->litFreq[lane], 256);
+        }
+    }
+    {
+        size_t const llFields = litLength >> fieldBits;
+        stats->llFreq[ZL_MIN(llFields, kMaxLitLengthCode)]++;
+        if (++stats->llSum > kCodeSumMax) {
+            stats->llSum =
+                    ZS_opt_downscale(stats->llFreq, kMaxLitLengthCode + 1);
+        }
+    }
+    stats->mlFreq[ZL_MIN(mlCode, kMaxMatchLengthCode)]++;
+    if (++stats->mlSum > kCodeSumMax) {
+        stats->mlSum = ZS_opt_downscale(stats->mlFreq, kMaxMatchLengthCode + 1);
+    }
+    if (ZS_OFFBASE_IS_REP(offBase)) {
+        stats->ofFreq[offBase]++;
+    } else {
+        uint32_t const offFields =
+                ZS_OFFBASE_TO_OFFSET(offBase) >> fieldBits;
+        stats->ofFreq[kNumRep]++;
+        stats->offCodeFreq[ZL_highbit32(offFields)]++;
+        if (++stats->offCodeSum > kCodeSumMax) {
+            stats->offCodeSum = ZS_opt_downscale(stats->offCodeFreq, 32);
+        }
+    }
+    if (++stats->ofSum > kCodeSumMax) {
+        stats->ofSum = ZS_opt_downscale(stats->ofFreq, kNumRep + 1);
+    }
+    stats->dirty = true;
+}
+
+ZL_FORCE_INLINE int ZS_opt_litPrice(
+        ZS_OptStats const* stats,
+        uint8_t const* literal,
+        uint32_t kFieldSize)
+{
+    int price = 0;
+    for (uint32_t i = 0; i < kFieldSize; ++i) {
+        price += stats->litPrice[i & (kNbLitLanes - 1)][literal[i]];
+    }
+    return price;
+}
+
+/// Extra lengths are quantized : a code, and highbit(extra + 1) raw bits
+ZL_FORCE_INLINE int ZS_opt_extraPrice(uint32_t extra)
+{
+    return (2 + ZL_highbit32(extra + 1)) * kBitCostMultiplier;
+}
+
+ZL_FORCE_INLINE int ZS_opt_llPrice(ZS_OptStats const* stats, uint32_t llFields)
+{
+    if (llFields < kMaxLitLengthCode) {
+        return stats->llPrice[llFields];
+    }
+    return stats->llPrice[kMaxLitLengthCode]
+            + ZS_opt_extraPrice(llFields - kMaxLitLengthCode);
+}
+
+ZL_FORCE_INLINE int ZS_opt_mlPrice(ZS_OptStats const* stats, uint32_t mlCode)
+{
+    if (mlCode < kMaxMatchLengthCode) {
+        return stats->mlPrice[mlCode];
+    }
+    return stats->mlPrice[kMaxMatchLengthCode]
+            + ZS_opt_extraPrice(mlCode - kMaxMatchLengthCode);
+}
+
+/// Offsets are quantized : a code, and highbit(offset) raw bits
+ZL_FORCE_INLINE int
+ZS_opt_offPrice(ZS_OptStats const* stats, uint32_t offBase, int kFieldBits)
+{
+    if (ZS_OFFBASE_IS_REP(offBase)) {
+        return stats->ofPrice[offBase];
+    }
+    uint32_t const offFields = ZS_OFFBASE_TO_OFFSET(offBase) >> kFieldBits;
+    int const offCode        = ZL_highbit32(offFields);
+    return stats->ofPrice[kNumRep] + stats->offCodePrice[offCode]
+            + offCode * kBitCostMultiplier;
+}
+
+/* *********************************
+ *  Optimal parser
+ ***********************************/
+
+/**
+ * Parses @p src block by block. Each block starts at a position with a match,
+ * and the cheapest path is computed forward, one field at a time, until no
+ * match reaches further. A match of at least lzTargetLength fields ends the
+ * block immediately.
+ *
+ * A node's price includes the literal length price of the sequence it is in,
+ * so that the literal length code is charged as the run grows.
+ */
+ZL_FORCE_INLINE void ZS_opt_parseT(
+        ZS_hcTokenLzCtx* ctx,
+        ZS_seqStore* seqs,
+        uint8_t const* src,
+        size_t size,
+        bool findLongMatches,
+        uint32_t const kFieldSize)
+{
+    ZS_OptStats* const stats       = ctx->stats;
+    ZS_OptNode* const opt          = ctx->opt;
+    ZS_OptMatch* const path        = ctx->path;
+    ZS_HcMatch const* const matches = ctx->matches;
+    int const kFieldBits           = ZL_highbit32(kFieldSize);
+    uint32_t const kMinMatch       = minMatchLength(kFieldSize);
+    uint32_t const minMatchFields  = kMinMatch >> kFieldBits;
+    uint32_t const targetFields    = ctx->params.lzTargetLength;
+    bool const skipUnpromising =
+            ctx->params.strategy != ZS_MatchFinderStrategy_opt2;
+
+    uint8_t const* ip         = src;
+    uint8_t const* anchor     = src;
+    uint8_t const* const iend = src + size;
+    uint32_t rep[kNumRep] = { kFieldSize, 2 * kFieldSize, 4 * kFieldSize };
+
+    ZS_hc_start(ctx, src, size, findLongMatches);
+    if (size < kMinMatch) {
+        ZS_seqStore_storeLastLiterals(seqs, anchor, size);
+        return;
+    }
+    uint8_t const* const ilimit = iend - kMinMatch;
+
+    while (ip <= ilimit) {
+        size_t nbMatches =
+                ZS_hc_getMatches(ctx, src, ip, iend, rep, kFieldSize);
+        if (nbMatches == 0) {
+            ip += kFieldSize;
+            continue;
+        }
+        ZS_opt_updatePrices(stats);
+
+        opt[0].price   = 0;
+        opt[0].offBase = 0;
+        opt[0].mlen    = 0;
+        opt[0].litlen  = (uint32_t)((size_t)(ip - anchor) >> kFieldBits);
+        memcpy(opt[0].rep, rep, sizeof(rep));
+
+        uint32_t last            = 0;
+        uint32_t end             = 0;
+        ZS_HcMatch lastStretch   = { 0, 0 };
+        for (uint32_t cur = 0;;) {
+            if (nbMatches > 0) {
+                ZS_HcMatch const longest = matches[nbMatches - 1];
+                uint32_t const longestFields = longest.length >> kFieldBits;
+                if (longestFields >= targetFields
+                    || cur + longestFields >= kOptNum) {
+                    end         = cur;
+                    lastStretch = longest;
+                    break;
+                }
+                int const basePrice = opt[cur].price + ZS_opt_llPrice(stats, 0);
+                uint32_t mlen       = minMatchFields;
+                for (size_t m = 0; m < nbMatches; ++m) {
+                    uint32_t const offBase = matches[m].offBase;
+                    uint32_t const maxMlen = matches[m].length >> kFieldBits;
+                    int const offPrice     = basePrice
+                            + ZS_opt_offPrice(stats, offBase, kFieldBits);
+                    for (; mlen <= maxMlen; ++mlen) {
+                        uint32_t const pos = cur + mlen;
+                        int const price    = offPrice
+                                + ZS_opt_mlPrice(stats, mlen - minMatchFields);
+                        while (last < pos) {
+                            opt[++last].price = kMaxPrice;
+                        }
+                        if (price < opt[pos].price) {
+                            ZS_OptNode* const node = &opt[pos];
+                            node->price            = price;
+                            node->offBase          = offBase;
+                            node->mlen             = mlen;
+                            node->litlen           = 0;
+                            memcpy(node->rep, opt[cur].rep, sizeof(node->rep));
+                            ZS_hc_updateReps(node->rep, offBase);
+                        }
+                    }
+                }
+            }
+
+            if (++cur > last) {
+                end = last;
+                break;
+            }
+
+            // Reach cur with a literal
+            {
+                ZS_OptNode const* const prev = &opt[cur - 1];
+                uint32_t const litlen        = prev->litlen + 1;
+                uint8_t const* const literal =
+                        ip + ((size_t)(cur - 1) << kFieldBits);
+                int const price = prev->price
+                        + ZS_opt_litPrice(stats, literal, kFieldSize)
+                        + ZS_opt_llPrice(stats, litlen)
+                        - ZS_opt_llPrice(stats, litlen - 1);
+                if (price <= opt[cur].price) {
+                    ZS_OptNode* const node = &opt[cur];
+                    node->price            = price;
+                    node->offBase          = 0;
+                    node->mlen             = 0;
+                    node->litlen           = litlen;
+                    memcpy(node->rep, prev->rep, sizeof(node->rep));
+                }
+            }
+
+            nbMatches                    = 0;
+            uint8_t const* const curPtr = ip + ((size_t)cur << kFieldBits);
+            if (curPtr > ilimit) {
+                continue;
+            }
+            if (skipUnpromising && cur < last
+                && opt[cur + 1].price
+                        <= opt[cur].price + kBitCostMultiplier / 2) {
+                continue;
+            }
+            nbMatches = ZS_hc_getMatches(
+                    ctx, src, curPtr, iend, opt[cur].rep, kFieldSize);
+        }
+
+        // Walk the cheapest path back from the end of the block
+        size_t nbPath = 0;
+        if (lastStretch.length > 0) {
+            path[nbPath].pos     = end;
+            path[nbPath].mlen    = lastStretch.length >> kFieldBits;
+            path[nbPath].offBase = lastStretch.offBase;
+            ++nbPath;
+        }
+        for (uint32_t pos = end; pos > 0;) {
+            ZS_OptNode const* const node = &opt[pos];
+            if (node->mlen > 0) {
+                pos -= node->mlen;
+                path[nbPath].pos     = pos;
+                path[nbPath].mlen    = node->mlen;
+                path[nbPath].offBase = node->offBase;
+                ++nbPath;
+            } else {
+                if (node->litlen >= pos) {
+                    break;
+                }
+                pos -= node->litlen;
+            }
+        }
+        ZL_ASSERT_LE(nbPath, kOptNum + 1);
+
+        // Emit the sequences in order
+        while (nbPath > 0) {
+            ZS_OptMatch const* const m = &path[--nbPath];
+            uint8_t const* const matchPtr = ip + ((size_t)m->pos << kFieldBits);
+            ZS_HcMatch const match        = { m->offBase,
+                                              m->mlen << kFieldBits };
+            ZL_ASSERT(!memcmp(rep, opt[m->pos].rep, sizeof(rep)));
+            ZS_opt_recordSequence(
+                    stats,
+                    anchor,
+                    (size_t)(matchPtr - anchor),
+                    m->offBase,
+                    m->mlen - minMatchFields,
+                    kFieldSize);
+            ZS_hc_storeSequence(
+                    seqs, anchor, matchPtr, iend, match, rep, kFieldBits);
+            anchor = matchPtr + match.length;
+        }
+        ip += ((size_t)end << kFieldBits) + lastStretch.length;
+        ZL_ASSERT_GE(ip, anchor);
+    }
+    ZL_ASSERT_LE(anchor, iend);
+    ZS_seqStore_storeLastLiterals(seqs, anchor, (size_t)(iend - anchor));
+}
+
+ZL_FORCE_INLINE void ZS_optTokenLzMatchFinder_parseT(
+        ZS_matchFinderCtx* baseCtx,
+        ZS_seqStore* seqs,
+        uint8_t const* src,
+        size_t size,
+        uint32_t const kFieldSize)
+{
+    ZS_hcTokenLzCtx* const ctx =
+            ZL_CONTAINER_OF(baseCtx, ZS_hcTokenLzCtx, base);
+    ZS_opt_initStats(ctx->stats, src, size, kFieldSize);
+    if (ctx->params.strategy == ZS_MatchFinderStrategy_opt2) {
+        // Parse the beginning of the source once to collect the statistics,
+        // then start over.
+        size_t const seedSize = ZL_MIN(size, (size_t)kOptSeedSize);
+        ZS_opt_parseT(ctx, seqs, src, seedSize, false, kFieldSize);
+        ZS_seqStore_reset(seqs);
+        memset(ctx->hashTable,
+               0,
+               sizeof(uint32_t) << ctx->params.lzHashLog);
+    }
+    ZS_opt_parseT(ctx, seqs, src, size, true, kFieldSize);
+}
+
+static void ZS_lazyTokenLzMatchFinder_parseAny(
+        ZS_matchFinderCtx* baseCtx,
+        ZS_seqStore* seqs,
+        uint8_t const* src,
+        size_t size,
+        uint32_t const fieldSize)
+{
+    ZS_lazyTokenLzMatchFinder_parseT(baseCtx, seqs, src, size, fieldSize);
+}
+
+static void ZS_optTokenLzMatchFinder_parseAny(
+        ZS_matchFinderCtx* baseCtx,
+        ZS_seqStore* seqs,
+        uint8_t const* src,
+        size_t size,
+        uint32_t const fieldSize)
+{
+    ZS_optTokenLzMatchFinder_parseT(baseCtx, seqs, src, size, fieldSize);
+}
+
+#define ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(kStrategy, kFieldSize)       \
+    static void ZS_##kStrategy##TokenLzMatchFinder_parse_##kFieldSize( \
+            ZS_matchFinderCtx* baseCtx,                                \
+            ZS_seqStore* seqs,                                         \
+            uint8_t const* src,                                        \
+            size_t size)                                               \
+    {                                                                  \
+        ZS_##kStrategy##TokenLzMatchFinder_parseT(                     \
+                baseCtx, seqs, src, size, kFieldSize);                 \
+    }
+
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(lazy, 1)
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(lazy, 2)
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(lazy, 4)
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(lazy, 8)
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(opt, 1)
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(opt, 2)
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(opt, 4)
+ZS_HC_TOKEN_LZ_MATCH_FINDER_PARSE(opt, 8)
+
+static void ZS_lazyTokenLzMatchFinder_parse(
+        ZS_matchFinderCtx* baseCtx,
+        ZS_seqStore* seqs,
+        uint8_t const* src,
+        size_t size)
+{
+    ZS_hcTokenLzCtx* const ctx =
+            ZL_CONTAINER_OF(baseCtx, ZS_hcTokenLzCtx, base);
+    uint32_t const fieldSize = ctx->params.fieldSize;
+    switch (fieldSize) {
+        default:
+            ZS_lazyTokenLzMatchFinder_parseAny(
+                    baseCtx, seqs, src, size, fieldSize);
+            break;
+        case 1:
+            ZS_lazyTokenLzMatchFinder_parse_1(baseCtx, seqs, src, size);
+            break;
+        case 2:
+            ZS_lazyTokenLzMatchFinder_parse_2(baseCtx, seqs, src, size);
+            break;
+        case 4:
+            ZS_lazyTokenLzMatchFinder_parse_4(baseCtx, seqs, src, size);
+            break;
+        case 8:
+            ZS_lazyTokenLzMatchFinder_parse_8(baseCtx, seqs, src, size);
+            break;
+    }
+}
+
+static void ZS_optTokenLzMatchFinder_parse(
+        ZS_matchFinderCtx* baseCtx,
+        ZS_seqStore* seqs,
+        uint8_t const* src,
+        size_t size)
+{
+    ZS_hcTokenLzCtx* const ctx =
+            ZL_CONTAINER_OF(baseCtx, ZS_hcTokenLzCtx, base);
+    uint32_t const fieldSize = ctx->params.fieldSize;
+    switch (fieldSize) {
+        default:
+            ZS_optTokenLzMatchFinder_parseAny(
+                    baseCtx, seqs, src, size, fieldSize);
+            break;
+        case 1:
+            ZS_optTokenLzMatchFinder_parse_1(baseCtx, seqs, src, size);
+            break;
+        case 2:
+            ZS_optTokenLzMatchFinder_parse_2(baseCtx, seqs, src, size);
+            break;
+        case 4:
+            ZS_optTokenLzMatchFinder_parse_4(baseCtx, seqs, src, size);
+            break;
+        case 8:
+            ZS_optTokenLzMatchFinder_parse_8(baseCtx, seqs, src, size);
+            break;
+    }
+}
+
+const ZS_matchFinder ZS_lazyTokenLzMatchFinder = {
+    .name       = "lazyTokenLz",
+    .ctx_create = ZS_lazyTokenLzMatchFinderCtx_create,
+    .parse      = ZS_lazyTokenLzMatchFinder_parse,
+};
+
+const ZS_matchFinder ZS_optTokenLzMatchFinder = {
+    .name       = "optTokenLz",
+    .ctx_create = ZS_optTokenLzMatchFinderCtx_create,
+    .parse      = ZS_optTokenLzMatchFinder_parse,
+};
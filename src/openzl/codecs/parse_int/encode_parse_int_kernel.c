@@ -7,9 +7,10 @@
 #include "openzl/codecs/parse_int/common_parse_int.h"
 #include "openzl/codecs/parse_int/encode_parse_int_gen_lut.h"
 #include "openzl/common/assertion.h"
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/overflow.h"
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
 #    include <immintrin.h>
 #endif
 
@@ -22,7 +23,9 @@ static bool checkNumStringEquality(const char* data, size_t size, int64_t num)
     return memcmp(data, numBuff, size) == 0;
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
+ZL_TARGET_AVX2_BEGIN
+
 /// Multiply @p result by 10000 and add @p add.
 /// @returns true if either operation overflows.
 static bool overflowAccumulate(uint64_t* result, uint64_t add)
@@ -148,7 +151,9 @@ ZL_parseInt64Unsafe_AVX(int64_t* value, char const* ptr, char const* end)
         return true;
     }
 }
-#endif // ZL_HAS_AVX2
+
+ZL_TARGET_END
+#endif // ZL_CAN_AVX2
 
 bool ZL_parseInt(
         int64_t* nums,
@@ -198,11 +203,12 @@ bool ZL_parseInt(
  */
 bool ZL_parseInt64Unsafe(int64_t* value, const char* ptr, const char* end)
 {
-#if ZL_HAS_AVX2
-    return ZL_parseInt64Unsafe_AVX(value, ptr, end);
-#else
-    return ZL_parseInt64_fallback(value, ptr, end);
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        return ZL_parseInt64Unsafe_AVX(value, ptr, end);
+    }
 #endif
+    return ZL_parseInt64_fallback(value, ptr, end);
 }
 
 /**
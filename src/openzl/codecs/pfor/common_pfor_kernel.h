@@ -0,0 +1,101 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_PFOR_COMMON_PFOR_KERNEL_H
+#define ZSTRONG_TRANSFORMS_PFOR_COMMON_PFOR_KERNEL_H
+
+/**
+ * Patched frame-of-reference (PFOR) integer coding.
+ *
+ * Values are cut into blocks of ZS_PFOR_BLOCK_SIZE (the last one may be
+ * shorter). Each block is coded independently, either as offsets from a
+ * base value (FOR), or as deltas, themselves offset from the smallest delta.
+ * Offsets are bitpacked with a per-block bit width. Offsets which don't fit
+ * are patched : their high bits are stored separately, as exceptions.
+ *
+ * Block format :
+ * - 1 byte : mode (high bit, 1 == delta) | nbBits (0 - 64)
+ * - 1 byte : nbExceptions
+ * - 1 byte : exceptionBits, only present when nbExceptions > 0
+ * - eltWidth bytes : base, LE
+ * - eltWidth bytes : minDelta, LE, only present in delta mode
+ * - nbElts values of nbBits each, bitpacked
+ * - nbExceptions positions, 1 byte each
+ * - nbExceptions values of exceptionBits each, bitpacked
+ *
+ * Decoding, with all arithmetic modulo 2^(8 * eltWidth) :
+ * - FOR   : out[i] = base + offset[i]
+ * - delta : out[i] = out[i-1] + minDelta + offset[i], with out[-1] = base
+ * The encoder sets offset[0] = 0 in delta mode.
+ *
+ * The size of a block only depends on its first bytes,
+ * so it's possible to skip blocks without decoding them.
+ */
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uintX_t
+
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+#define ZS_PFOR_BLOCK_SIZE 128
+#define ZS_PFOR_MODE_DELTA 0x80
+#define ZS_PFOR_NBBITS_MASK 0x7F
+
+/// @returns the size of the block header, excluding the base values
+ZL_INLINE size_t ZS_pforBlockHeaderSize(unsigned nbExceptions)
+{
+    return nbExceptions > 0 ? 3 : 2;
+}
+
+/// @returns the number of bytes used by @p nbElts values of @p nbBits each
+ZL_INLINE size_t ZS_pforPackedSize(size_t nbElts, unsigned nbBits)
+{
+    return (nbElts * nbBits + 7) / 8;
+}
+
+/// @returns the mask of the bits of an integer of @p eltWidth bytes
+ZL_INLINE uint64_t ZS_pforWidthMask(size_t eltWidth)
+{
+    return eltWidth >= 8 ? UINT64_MAX : ((uint64_t)1 << (8 * eltWidth)) - 1;
+}
+
+/// Reads element @p i of a native integer array, zero-extended
+ZL_FORCE_INLINE uint64_t
+ZS_pforRead(void const* src, size_t i, size_t kEltWidth)
+{
+    switch (kEltWidth) {
+        case 1:
+            return ((uint8_t const*)src)[i];
+        case 2:
+            return ((uint16_t const*)src)[i];
+        case 4:
+            return ((uint32_t const*)src)[i];
+        default:
+            return ((uint64_t const*)src)[i];
+    }
+}
+
+/// Writes element @p i of a native integer array, truncating @p val
+ZL_FORCE_INLINE void
+ZS_pforWrite(void* dst, size_t i, uint64_t val, size_t kEltWidth)
+{
+    switch (kEltWidth) {
+        case 1:
+            ((uint8_t*)dst)[i] = (uint8_t)val;
+            break;
+        case 2:
+            ((uint16_t*)dst)[i] = (uint16_t)val;
+            break;
+        case 4:
+            ((uint32_t*)dst)[i] = (uint32_t)val;
+            break;
+        default:
+            ((uint64_t*)dst)[i] = val;
+            break;
+    }
+}
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_TRANSFORMS_PFOR_COMMON_PFOR_KERNEL_H
@@ -0,0 +1,61 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/pfor/decode_pfor_binding.h"
+#include "openzl/codecs/pfor/decode_pfor_kernel.h"
+
+#include "openzl/common/assertion.h"
+#include "openzl/shared/utils.h"
+#include "openzl/shared/varint.h"
+#include "openzl/zl_data.h"
+#include "openzl/zl_dtransform.h"
+#include "openzl/zl_errors.h"
+
+ZL_Report DI_pfor(ZL_Decoder* dictx, const ZL_Input* ins[])
+{
+    ZL_ASSERT_NN(dictx);
+    ZL_ASSERT_NN(ins);
+    const ZL_Input* const in = ins[0];
+    ZL_ASSERT_NN(in);
+    ZL_ASSERT_EQ(ZL_Input_type(in), ZL_Type_serial);
+    void const* const src = ZL_Input_ptr(in);
+    size_t const srcSize  = ZL_Input_numElts(in);
+
+    ZL_RBuffer const header = ZL_Decoder_getCodecHeader(dictx);
+    ZL_RET_R_IF_LT(header_unknown, header.size, 2);
+    uint8_t const* hdr          = (uint8_t const*)header.start;
+    uint8_t const* const hdrEnd = hdr + header.size;
+    size_t const eltWidth       = *hdr++;
+    ZL_RET_R_IF(
+            header_unknown,
+            !ZL_isLegalIntegerWidth(eltWidth),
+            "pfor decoder got an illegal eltWidth (%zu)",
+            eltWidth);
+    ZL_TRY_LET_T(uint64_t, nbElts, ZL_varintDecode(&hdr, hdrEnd));
+    ZL_RET_R_IF_NE(header_unknown, hdr, hdrEnd);
+
+    // Each block uses at least 2 + eltWidth bytes : don't allocate for garbage
+    uint64_t const nbBlocks =
+            (nbElts + ZS_PFOR_BLOCK_SIZE - 1) / ZS_PFOR_BLOCK_SIZE;
+    ZL_RET_R_IF_GT(
+            corruption,
+            nbBlocks,
+            srcSize / (ZS_pforBlockHeaderSize(0) + eltWidth),
+            "pfor source too small for the number of elements");
+
+    ZL_Output* const out =
+            ZL_Decoder_create1OutStream(dictx, (size_t)nbElts, eltWidth);
+    ZL_RET_R_IF_NULL(allocation, out);
+    ZL_TRY_LET_R(
+            srcConsumed,
+            ZS_pforDecode(
+                    ZL_Output_ptr(out),
+                    (size_t)nbElts,
+                    eltWidth,
+                    src,
+                    srcSize));
+    ZL_RET_R_IF_NE(
+            corruption, srcConsumed, srcSize, "entire source not consumed");
+    ZL_RET_R_IF_ERR(ZL_Output_commit(out, (size_t)nbElts));
+
+    return ZL_returnValue(1);
+}
@@ -0,0 +1,21 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_PFOR_DECODE_PFOR_BINDING_H
+#define ZSTRONG_TRANSFORMS_PFOR_DECODE_PFOR_BINDING_H
+
+#include "openzl/codecs/pfor/graph_pfor.h"
+#include "openzl/shared/portability.h"
+#include "openzl/zl_dtransform.h" // ZL_Decoder
+
+ZL_BEGIN_C_DECLS
+
+ZL_Report DI_pfor(ZL_Decoder* dictx, const ZL_Input* ins[]);
+
+#define DI_PFOR(id)                            \
+    {                                          \
+        .transform_f = DI_pfor, .name = "pfor" \
+    }
+
+ZL_END_C_DECLS
+
+#endif
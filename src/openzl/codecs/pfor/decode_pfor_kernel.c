@@ -0,0 +1,232 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/pfor/decode_pfor_kernel.h"
+
+#include "openzl/codecs/bitpack/common_bitpack_kernel.h"
+#include "openzl/common/assertion.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+
+typedef struct {
+    int isDelta;
+    unsigned nbBits;
+    unsigned nbExceptions;
+    unsigned exceptionBits;
+    uint64_t base;
+    uint64_t minDelta;
+    size_t headerSize; ///< Including the base values
+    size_t cSize;
+} ZS_PforBlockHeader;
+
+static ZL_Report ZS_pforReadBlockHeader(
+        ZS_PforBlockHeader* hdr,
+        uint8_t const* src,
+        size_t srcSize,
+        size_t nbElts,
+        size_t eltWidth)
+{
+    unsigned const maxBits = 8 * (unsigned)eltWidth;
+    ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, 2);
+    hdr->isDelta       = (src[0] & ZS_PFOR_MODE_DELTA) != 0;
+    hdr->nbBits        = src[0] & ZS_PFOR_NBBITS_MASK;
+    hdr->nbExceptions  = src[1];
+    hdr->exceptionBits = 0;
+    ZL_RET_R_IF_GT(corruption, hdr->nbBits, maxBits);
+    if (hdr->nbExceptions > 0) {
+        ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, 3);
+        hdr->exceptionBits = src[2];
+        ZL_RET_R_IF_GT(corruption, hdr->nbExceptions, nbElts);
+        ZL_RET_R_IF_EQ(corruption, hdr->exceptionBits, 0);
+        ZL_RET_R_IF_GT(
+                corruption, hdr->nbBits + hdr->exceptionBits, maxBits);
+    }
+    size_t const baseSize = hdr->isDelta ? 2 * eltWidth : eltWidth;
+    hdr->headerSize = ZS_pforBlockHeaderSize(hdr->nbExceptions) + baseSize;
+    ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, hdr->headerSize);
+    uint8_t const* const bases = src + hdr->headerSize - baseSize;
+    hdr->base                  = ZL_readLE64_N(bases, eltWidth);
+    hdr->minDelta =
+            hdr->isDelta ? ZL_readLE64_N(bases + eltWidth, eltWidth) : 0;
+    hdr->cSize = hdr->headerSize + ZS_pforPackedSize(nbElts, hdr->nbBits)
+            + hdr->nbExceptions
+            + ZS_pforPackedSize(hdr->nbExceptions, hdr->exceptionBits);
+    ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, hdr->cSize);
+    return ZL_returnSuccess();
+}
+
+ZL_Report ZS_pforBlockCSize(
+        void const* src,
+        size_t srcSize,
+        size_t nbElts,
+        size_t eltWidth)
+{
+    ZL_ASSERT(ZL_isLegalIntegerWidth(eltWidth));
+    ZS_PforBlockHeader hdr = { 0 };
+    ZL_RET_R_IF_ERR(ZS_pforReadBlockHeader(
+            &hdr, (uint8_t const*)src, srcSize, nbElts, eltWidth));
+    return ZL_returnValue(hdr.cSize);
+}
+
+ZL_FORCE_INLINE ZL_Report ZS_pforDecodeBlock_impl(
+        void* dst,
+        size_t nbElts,
+        uint8_t const* src,
+        size_t srcSize,
+        size_t kEltWidth)
+{
+    ZL_ASSERT_LE(nbElts, ZS_PFOR_BLOCK_SIZE);
+    ZS_PforBlockHeader hdr = { 0 };
+    ZL_RET_R_IF_ERR(
+            ZS_pforReadBlockHeader(&hdr, src, srcSize, nbElts, kEltWidth));
+    uint8_t const* ip         = src + hdr.headerSize;
+    uint8_t const* const iend = src + hdr.cSize;
+
+    ip += ZS_bitpackDecode(
+            dst,
+            nbElts,
+            kEltWidth,
+            ip,
+            (size_t)(iend - ip),
+            (int)hdr.nbBits);
+
+    if (hdr.nbExceptions > 0) {
+        uint8_t const* const positions = ip;
+        ip += hdr.nbExceptions;
+        uint64_t highs[ZS_PFOR_BLOCK_SIZE];
+        ip += ZS_bitpackDecode64(
+                highs,
+                hdr.nbExceptions,
+                ip,
+                (size_t)(iend - ip),
+                (int)hdr.exceptionBits);
+        for (size_t n = 0; n < hdr.nbExceptions; ++n) {
+            size_t const pos = positions[n];
+            ZL_RET_R_IF_GE(corruption, pos, nbElts);
+            uint64_t const val = ZS_pforRead(dst, pos, kEltWidth)
+                    | (highs[n] << hdr.nbBits);
+            ZS_pforWrite(dst, pos, val, kEltWidth);
+        }
+    }
+    ZL_ASSERT_EQ(ip, iend);
+
+    if (hdr.isDelta) {
+        uint64_t acc = hdr.base;
+        for (size_t i = 0; i < nbElts; ++i) {
+            acc += ZS_pforRead(dst, i, kEltWidth) + hdr.minDelta;
+            ZS_pforWrite(dst, i, acc, kEltWidth);
+        }
+    } else if (hdr.base != 0) {
+        for (size_t i = 0; i < nbElts; ++i) {
+            ZS_pforWrite(
+                    dst,
+                    i,
+                    ZS_pforRead(dst, i, kEltWidth) + hdr.base,
+                    kEltWidth);
+        }
+    }
+    return ZL_returnValue(hdr.cSize);
+}
+
+ZL_FORCE_INLINE ZL_Report ZS_pforDecode_impl(
+        void* dst,
+        size_t nbElts,
+        uint8_t const* src,
+        size_t srcSize,
+        size_t kEltWidth)
+{
+    uint8_t const* ip         = src;
+    uint8_t const* const iend = src + srcSize;
+    for (size_t n = 0; n < nbElts; n += ZS_PFOR_BLOCK_SIZE) {
+        size_t const blockSize = ZL_MIN(ZS_PFOR_BLOCK_SIZE, nbElts - n);
+        ZL_TRY_LET_R(
+                cSize,
+                ZS_pforDecodeBlock_impl(
+                        (uint8_t*)dst + n * kEltWidth,
+                        blockSize,
+                        ip,
+                        (size_t)(iend - ip),
+                        kEltWidth));
+        ip += cSize;
+    }
+    return ZL_returnValue((size_t)(ip - src));
+}
+
+ZL_Report ZS_pforDecodeBlock(
+        void* dst,
+        size_t nbElts,
+        size_t eltWidth,
+        void const* src,
+        size_t srcSize)
+{
+    uint8_t const* const ip = (uint8_t const*)src;
+    switch (eltWidth) {
+        case 1:
+            return ZS_pforDecodeBlock_impl(dst, nbElts, ip, srcSize, 1);
+        case 2:
+            return ZS_pforDecodeBlock_impl(dst, nbElts, ip, srcSize, 2);
+        case 4:
+            return ZS_pforDecodeBlock_impl(dst, nbElts, ip, srcSize, 4);
+        case 8:
+            return ZS_pforDecodeBlock_impl(dst, nbElts, ip, srcSize, 8);
+        default:
+            ZL_RET_R_ERR(GENERIC, "Unsupported element width");
+    }
+}
+
+static ZL_Report ZS_pforDecode8(
+        void* dst,
+        size_t nbElts,
+        uint8_t const* src,
+        size_t srcSize)
+{
+    return ZS_pforDecode_impl(dst, nbElts, src, srcSize, 1);
+}
+
+static ZL_Report ZS_pforDecode16(
+        void* dst,
+        size_t nbElts,
+        uint8_t const* src,
+        size_t srcSize)
+{
+    return ZS_pforDecode_impl(dst, nbElts, src, srcSize, 2);
+}
+
+static ZL_Report ZS_pforDecode32(
+        void* dst,
+        size_t nbElts,
+        uint8_t const* src,
+        size_t srcSize)
+{
+    return ZS_pforDecode_impl(dst, nbElts, src, srcSize, 4);
+}
+
+static ZL_Report ZS_pforDecode64(
+        void* dst,
+        size_t nbElts,
+        uint8_t const* src,
+        size_t srcSize)
+{
+    return ZS_pforDecode_impl(dst, nbElts, src, srcSize, 8);
+}
+
+ZL_Report ZS_pforDecode(
+        void* dst,
+        size_t nbElts,
+        size_t eltWidth,
+        void const* src,
+        size_t srcSize)
+{
+    uint8_t const* const ip = (uint8_t const*)src;
+    switch (eltWidth) {
+        case 1:
+            return ZS_pforDecode8(dst, nbElts, ip, srcSize);
+        case 2:
+            return ZS_pforDecode16(dst, nbElts, ip, srcSize);
+        case 4:
+            return ZS_pforDecode32(dst, nbElts, ip, srcSize);
+        case 8:
+            return ZS_pforDecode64(dst, nbElts, ip, srcSize);
+        default:
+            ZL_RET_R_ERR(GENERIC, "Unsupported element width");
+    }
+}
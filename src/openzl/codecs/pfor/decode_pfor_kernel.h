@@ -0,0 +1,52 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_PFOR_DECODE_PFOR_KERNEL_H
+#define ZSTRONG_TRANSFORMS_PFOR_DECODE_PFOR_KERNEL_H
+
+#include <stddef.h> // size_t
+
+#include "openzl/codecs/pfor/common_pfor_kernel.h"
+#include "openzl/shared/portability.h"
+#include "openzl/zl_errors.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * @returns The compressed size of the block starting at @p src,
+ * which decodes into @p nbElts values, without decoding it.
+ * Used to skip ahead to a later block.
+ */
+ZL_Report ZS_pforBlockCSize(
+        void const* src,
+        size_t srcSize,
+        size_t nbElts,
+        size_t eltWidth);
+
+/**
+ * Decodes a single block of @p nbElts values into @p dst.
+ *
+ * @pre @p nbElts <= ZS_PFOR_BLOCK_SIZE
+ * @returns The nb of bytes consumed from @p src, or an error on corruption.
+ */
+ZL_Report ZS_pforDecodeBlock(
+        void* dst,
+        size_t nbElts,
+        size_t eltWidth,
+        void const* src,
+        size_t srcSize);
+
+/**
+ * Decodes @p nbElts values of @p eltWidth bytes each into @p dst.
+ *
+ * @returns The nb of bytes consumed from @p src, or an error on corruption.
+ */
+ZL_Report ZS_pforDecode(
+        void* dst,
+        size_t nbElts,
+        size_t eltWidth,
+        void const* src,
+        size_t srcSize);
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_TRANSFORMS_PFOR_DECODE_PFOR_KERNEL_H
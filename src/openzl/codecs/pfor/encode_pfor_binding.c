@@ -0,0 +1,44 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/pfor/encode_pfor_binding.h"
+#include "openzl/codecs/pfor/encode_pfor_kernel.h"
+
+#include "openzl/common/assertion.h"
+#include "openzl/common/errors_internal.h"
+#include "openzl/shared/varint.h"
+#include "openzl/zl_ctransform.h"
+#include "openzl/zl_data.h"
+#include "openzl/zl_errors.h"
+
+ZL_Report EI_pfor(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
+{
+    ZL_ASSERT_NN(eictx);
+    ZL_ASSERT_EQ(nbIns, 1);
+    ZL_ASSERT_NN(ins);
+    const ZL_Input* const in = ins[0];
+    ZL_ASSERT_NN(in);
+    ZL_ASSERT_EQ(ZL_Input_type(in), ZL_Type_numeric);
+    size_t const eltWidth = ZL_Input_eltWidth(in);
+    size_t const nbElts   = ZL_Input_numElts(in);
+    ZL_ASSERT(ZL_isLegalIntegerWidth(eltWidth));
+
+    size_t const dstCapacity = ZS_pforEncodeBound(nbElts, eltWidth);
+    ZL_Output* const out =
+            ZL_Encoder_createTypedStream(eictx, 0, dstCapacity, 1);
+    ZL_RET_R_IF_NULL(allocation, out);
+    size_t const dstSize = ZS_pforEncode(
+            ZL_Output_ptr(out),
+            dstCapacity,
+            ZL_Input_ptr(in),
+            nbElts,
+            eltWidth);
+    ZL_RET_R_IF_ERR(ZL_Output_commit(out, dstSize));
+
+    // Header : element width, then the number of elements
+    uint8_t header[1 + ZL_VARINT_LENGTH_64];
+    header[0]               = (uint8_t)eltWidth;
+    size_t const headerSize = 1 + ZL_varintEncode(nbElts, header + 1);
+    ZL_Encoder_sendCodecHeader(eictx, header, headerSize);
+
+    return ZL_returnValue(1);
+}
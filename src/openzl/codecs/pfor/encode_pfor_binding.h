@@ -0,0 +1,21 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_PFOR_ENCODE_PFOR_BINDING_H
+#define ZSTRONG_TRANSFORMS_PFOR_ENCODE_PFOR_BINDING_H
+
+#include "openzl/codecs/pfor/graph_pfor.h"
+#include "openzl/shared/portability.h"
+#include "openzl/zl_ctransform.h" // ZL_Encoder
+
+ZL_BEGIN_C_DECLS
+
+ZL_Report EI_pfor(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns);
+
+#define EI_PFOR(id)                                                      \
+    {                                                                    \
+        .gd = PFOR_GRAPH(id), .transform_f = EI_pfor, .name = "!zl.pfor" \
+    }
+
+ZL_END_C_DECLS
+
+#endif
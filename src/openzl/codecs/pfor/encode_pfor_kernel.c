@@ -0,0 +1,307 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/codecs/pfor/encode_pfor_kernel.h"
+
+#include <string.h> // memcpy, memset
+
+#include "openzl/codecs/bitpack/common_bitpack_kernel.h"
+#include "openzl/common/assertion.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/mem.h"
+#include "openzl/shared/utils.h"
+
+size_t ZS_pforEncodeBound(size_t nbElts, size_t eltWidth)
+{
+    size_t const nbBlocks =
+            (nbElts + ZS_PFOR_BLOCK_SIZE - 1) / ZS_PFOR_BLOCK_SIZE;
+    return nbBlocks * (ZS_pforBlockHeaderSize(1) + 2 * eltWidth)
+            + nbElts * eltWidth;
+}
+
+/// Layout of a block, chosen to minimize its size
+typedef struct {
+    unsigned nbBits;
+    unsigned nbExceptions;
+    unsigned exceptionBits;
+    size_t cSize;
+} ZS_PforBlockPlan;
+
+/// Offsets from a base, along with the histogram of their bit lengths
+typedef struct {
+    uint64_t offsets[ZS_PFOR_BLOCK_SIZE];
+    unsigned lenCount[65];
+    unsigned maxLen;
+} ZS_PforOffsets;
+
+static unsigned ZS_pforBitLength(uint64_t val)
+{
+    return val == 0 ? 0 : (unsigned)ZL_highbit64(val) + 1;
+}
+
+static void ZS_pforCountLengths(ZS_PforOffsets* offs, size_t nbElts)
+{
+    memset(offs->lenCount, 0, sizeof(offs->lenCount));
+    offs->maxLen = 0;
+    for (size_t i = 0; i < nbElts; ++i) {
+        unsigned const len = ZS_pforBitLength(offs->offsets[i]);
+        offs->lenCount[len]++;
+        offs->maxLen = ZL_MAX(offs->maxLen, len);
+    }
+}
+
+/**
+ * Picks the bit width which minimizes the block size. Offsets longer than
+ * nbBits become exceptions, which cost a position byte, plus their high bits.
+ * On ties, prefers fewer exceptions, which are slower to decode.
+ */
+static ZS_PforBlockPlan ZS_pforPlan(
+        ZS_PforOffsets const* offs,
+        size_t nbElts,
+        size_t baseSize)
+{
+    unsigned const maxLen = offs->maxLen;
+    ZS_PforBlockPlan best = {
+        .nbBits        = maxLen,
+        .nbExceptions  = 0,
+        .exceptionBits = 0,
+        .cSize         = ZS_pforBlockHeaderSize(0) + baseSize
+                + ZS_pforPackedSize(nbElts, maxLen),
+    };
+    unsigned nbExceptions = 0;
+    for (unsigned nbBits = maxLen; nbBits-- > 0;) {
+        nbExceptions += offs->lenCount[nbBits + 1];
+        unsigned const exceptionBits = maxLen - nbBits;
+        size_t const cSize           = ZS_pforBlockHeaderSize(nbExceptions)
+                + baseSize + ZS_pforPackedSize(nbElts, nbBits) + nbExceptions
+                + ZS_pforPackedSize(nbExceptions, exceptionBits);
+        if (cSize < best.cSize) {
+            best.nbBits        = nbBits;
+            best.nbExceptions  = nbExceptions;
+            best.exceptionBits = exceptionBits;
+            best.cSize         = cSize;
+        }
+    }
+    return best;
+}
+
+static uint64_t ZS_pforSignExtend(uint64_t val, size_t eltWidth)
+{
+    unsigned const shift = 64 - 8 * (unsigned)eltWidth;
+    return (uint64_t)((int64_t)(val << shift) >> shift);
+}
+
+/// Frame of reference : offsets from @p base
+static void ZS_pforOffsetsFOR(
+        ZS_PforOffsets* offs,
+        uint64_t const* vals,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t base)
+{
+    uint64_t const mask = ZS_pforWidthMask(eltWidth);
+    for (size_t i = 0; i < nbElts; ++i) {
+        offs->offsets[i] = (vals[i] - base) & mask;
+    }
+    ZS_pforCountLengths(offs, nbElts);
+}
+
+/// Deltas, as offsets from the smallest (signed) delta.
+/// The first offset is 0, and the base is adjusted accordingly.
+/// @returns the base, and writes the smallest delta into @p minDelta
+static uint64_t ZS_pforOffsetsDelta(
+        ZS_PforOffsets* offs,
+        uint64_t* minDelta,
+        uint64_t const* vals,
+        size_t nbElts,
+        size_t eltWidth)
+{
+    ZL_ASSERT_GE(nbElts, 2);
+    uint64_t const mask = ZS_pforWidthMask(eltWidth);
+    int64_t minS        = INT64_MAX;
+    for (size_t i = 1; i < nbElts; ++i) {
+        uint64_t const delta = (vals[i] - vals[i - 1]) & mask;
+        int64_t const s      = (int64_t)ZS_pforSignExtend(delta, eltWidth);
+        offs->offsets[i]     = delta;
+        minS                 = ZL_MIN(minS, s);
+    }
+    *minDelta        = (uint64_t)minS & mask;
+    offs->offsets[0] = 0;
+    for (size_t i = 1; i < nbElts; ++i) {
+        offs->offsets[i] = (offs->offsets[i] - *minDelta) & mask;
+    }
+    ZS_pforCountLengths(offs, nbElts);
+    return (vals[0] - *minDelta) & mask;
+}
+
+static size_t ZS_pforWriteBlock(
+        uint8_t* dst,
+        size_t dstCapacity,
+        ZS_PforOffsets* offs,
+        ZS_PforBlockPlan const* plan,
+        size_t nbElts,
+        size_t eltWidth,
+        int isDelta,
+        uint64_t base,
+        uint64_t minDelta)
+{
+    ZL_ASSERT_GE(dstCapacity, plan->cSize);
+    ZL_ASSERT_LE(plan->nbBits, ZS_PFOR_NBBITS_MASK);
+    ZL_ASSERT_LE(plan->nbExceptions, nbElts);
+    uint8_t* op         = dst;
+    uint8_t* const oend = dst + dstCapacity;
+    op[0] = (uint8_t)((isDelta ? ZS_PFOR_MODE_DELTA : 0) | plan->nbBits);
+    op[1] = (uint8_t)plan->nbExceptions;
+    if (plan->nbExceptions > 0) {
+        op[2] = (uint8_t)plan->exceptionBits;
+    }
+    op += ZS_pforBlockHeaderSize(plan->nbExceptions);
+    ZL_writeLE64_N(op, base, eltWidth);
+    op += eltWidth;
+    if (isDelta) {
+        ZL_writeLE64_N(op, minDelta, eltWidth);
+        op += eltWidth;
+    }
+
+    // Extract exceptions, then keep only the low bits in place
+    uint8_t positions[ZS_PFOR_BLOCK_SIZE];
+    uint64_t highs[ZS_PFOR_BLOCK_SIZE];
+    size_t nbExceptions = 0;
+    if (plan->nbExceptions > 0) {
+        uint64_t const lowMask = ((uint64_t)1 << plan->nbBits) - 1;
+        for (size_t i = 0; i < nbElts; ++i) {
+            if (offs->offsets[i] > lowMask) {
+                positions[nbExceptions] = (uint8_t)i;
+                highs[nbExceptions]     = offs->offsets[i] >> plan->nbBits;
+                offs->offsets[i] &= lowMask;
+                ++nbExceptions;
+            }
+        }
+    }
+    ZL_ASSERT_EQ(nbExceptions, plan->nbExceptions);
+
+    op += ZS_bitpackEncode64(
+            op,
+            (size_t)(oend - op),
+            offs->offsets,
+            nbElts,
+            (int)plan->nbBits);
+    if (nbExceptions > 0) {
+        memcpy(op, positions, nbExceptions);
+        op += nbExceptions;
+        op += ZS_bitpackEncode64(
+                op,
+                (size_t)(oend - op),
+                highs,
+                nbExceptions,
+                (int)plan->exceptionBits);
+    }
+    ZL_ASSERT_EQ((size_t)(op - dst), plan->cSize);
+    return (size_t)(op - dst);
+}
+
+static size_t ZS_pforEncodeBlock(
+        uint8_t* dst,
+        size_t dstCapacity,
+        uint64_t const* vals,
+        size_t nbElts,
+        size_t eltWidth)
+{
+    // Try both the unsigned and the signed minimum as a base : the signed one
+    // wins on small negative values, but loses on large positive outliers.
+    uint64_t const mask = ZS_pforWidthMask(eltWidth);
+    uint64_t minU       = UINT64_MAX;
+    int64_t minS        = INT64_MAX;
+    for (size_t i = 0; i < nbElts; ++i) {
+        minU = ZL_MIN(minU, vals[i]);
+        minS = ZL_MIN(minS, (int64_t)ZS_pforSignExtend(vals[i], eltWidth));
+    }
+    ZS_PforOffsets forOffs;
+    uint64_t forBase = minU;
+    ZS_pforOffsetsFOR(&forOffs, vals, nbElts, eltWidth, forBase);
+    ZS_PforBlockPlan forPlan = ZS_pforPlan(&forOffs, nbElts, eltWidth);
+    if (((uint64_t)minS & mask) != minU && forPlan.nbBits > 0) {
+        ZS_PforOffsets signedOffs;
+        uint64_t const signedBase = (uint64_t)minS & mask;
+        ZS_pforOffsetsFOR(&signedOffs, vals, nbElts, eltWidth, signedBase);
+        ZS_PforBlockPlan const signedPlan =
+                ZS_pforPlan(&signedOffs, nbElts, eltWidth);
+        if (signedPlan.cSize < forPlan.cSize) {
+            forOffs = signedOffs;
+            forBase = signedBase;
+            forPlan = signedPlan;
+        }
+    }
+    if (nbElts >= 2 && forPlan.nbBits > 0) {
+        ZS_PforOffsets deltaOffs;
+        uint64_t minDelta = 0;
+        uint64_t const deltaBase = ZS_pforOffsetsDelta(
+                &deltaOffs, &minDelta, vals, nbElts, eltWidth);
+        ZS_PforBlockPlan const deltaPlan =
+                ZS_pforPlan(&deltaOffs, nbElts, 2 * eltWidth);
+        // On ties, FOR is faster to decode
+        if (deltaPlan.cSize < forPlan.cSize) {
+            return ZS_pforWriteBlock(
+                    dst,
+                    dstCapacity,
+                    &deltaOffs,
+                    &deltaPlan,
+                    nbElts,
+                    eltWidth,
+                    1,
+                    deltaBase,
+                    minDelta);
+        }
+    }
+    return ZS_pforWriteBlock(
+            dst,
+            dstCapacity,
+            &forOffs,
+            &forPlan,
+            nbElts,
+            eltWidth,
+            0,
+            forBase,
+            0);
+}
+
+size_t ZS_pforEncode(
+        void* dst,
+        size_t dstCapacity,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth)
+{
+    ZL_ASSERT(ZL_isLegalIntegerWidth(eltWidth));
+    ZL_ASSERT_GE(dstCapacity, ZS_pforEncodeBound(nbElts, eltWidth));
+    uint8_t* const ostart = (uint8_t*)dst;
+    uint8_t* op           = ostart;
+    uint8_t* const oend   = ostart + dstCapacity;
+    uint64_t vals[ZS_PFOR_BLOCK_SIZE];
+    for (size_t n = 0; n < nbElts; n += ZS_PFOR_BLOCK_SIZE) {
+        size_t const blockSize = ZL_MIN(ZS_PFOR_BLOCK_SIZE, nbElts - n);
+        void const* const block = (uint8_t const*)src + n * eltWidth;
+        switch (eltWidth) {
+            case 1:
+                for (size_t i = 0; i < blockSize; ++i) {
+                    vals[i] = ZS_pforRead(block, i, 1);
+                }
+                break;
+            case 2:
+                for (size_t i = 0; i < blockSize; ++i) {
+                    vals[i] = ZS_pforRead(block, i, 2);
+                }
+                break;
+            case 4:
+                for (size_t i = 0; i < blockSize; ++i) {
+                    vals[i] = ZS_pforRead(block, i, 4);
+                }
+                break;
+            default:
+                memcpy(vals, block, blockSize * sizeof(vals[0]));
+                break;
+        }
+        op += ZS_pforEncodeBlock(
+                op, (size_t)(oend - op), vals, blockSize, eltWidth);
+    }
+    return (size_t)(op - ostart);
+}
@@ -0,0 +1,37 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_PFOR_ENCODE_PFOR_KERNEL_H
+#define ZSTRONG_TRANSFORMS_PFOR_ENCODE_PFOR_KERNEL_H
+
+#include <stddef.h> // size_t
+
+#include "openzl/codecs/pfor/common_pfor_kernel.h"
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * @returns The minimum destination buffer capacity to ensure
+ * that ZS_pforEncode() will succeed.
+ */
+size_t ZS_pforEncodeBound(size_t nbElts, size_t eltWidth);
+
+/**
+ * Encodes @p nbElts integers of @p eltWidth bytes each, block by block.
+ * Each block picks the mode and bit width which minimize its size.
+ *
+ * @pre @p dstCapacity >= ZS_pforEncodeBound(@p nbElts, @p eltWidth)
+ * @pre @p eltWidth is 1, 2, 4 or 8
+ *
+ * @returns The nb of bytes written into @p dst.
+ */
+size_t ZS_pforEncode(
+        void* dst,
+        size_t dstCapacity,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth);
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_TRANSFORMS_PFOR_ENCODE_PFOR_KERNEL_H
@@ -0,0 +1,19 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_TRANSFORMS_PFOR_GRAPH_PFOR_H
+#define ZSTRONG_TRANSFORMS_PFOR_GRAPH_PFOR_H
+
+/**
+ * Contains graph definitions for the pfor transform
+ * used by both encode and decoder sides
+ */
+
+#include "openzl/zl_data.h" // st_*
+
+#define PFOR_GRAPH(id)                                                \
+    {                                                                 \
+        .CTid = id, .inputTypes = ZL_STREAMTYPELIST(ZL_Type_numeric), \
+        .soTypes = ZL_STREAMTYPELIST(ZL_Type_serial),                 \
+    }
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "openzl/codecs/common/copy.h"
 #include "openzl/common/assertion.h"
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/numeric_operations.h"
 #include "openzl/shared/overflow.h"
 #include "openzl/zl_errors.h"
@@ -63,7 +64,7 @@ ZL_FORCE_NOINLINE ZL_Report ZS_decodePrefix_fallback(
     return ZL_returnSuccess();
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
 #    include <immintrin.h>
 
 // clang-format off
@@ -105,25 +106,17 @@ static const uint8_t blendMasks[][sizeof(__m256i)]
         };
 // clang-format on
 
-#endif // ZL_HAS_AVX2
+ZL_TARGET_AVX2_BEGIN
 
-ZL_Report ZS_decodePrefix(
+static ZL_Report ZS_decodePrefix_avx2(
         uint8_t* const out,
         uint32_t* const fieldSizes,
         const uint8_t* const suffixes,
         size_t const nbElts,
         const uint32_t* const eltWidths,
-        const uint32_t* const matchSizes)
+        const uint32_t* const matchSizes,
+        size_t const nbWildcopies)
 {
-    // Calculate the number of safe wildcopies
-    size_t nbWildcopies = nbElts;
-
-    for (size_t suffixSum = 0;
-         nbWildcopies > 0 && suffixSum < ZS_WILDCOPY_OVERLENGTH;
-         --nbWildcopies) {
-        suffixSum += eltWidths[nbWildcopies - 1];
-    }
-
     const uint8_t* currSuffixPtr = suffixes;
     uint8_t* prevOutPtr          = out;
     uint8_t* currOutPtr          = out;
@@ -133,19 +126,16 @@ ZL_Report ZS_decodePrefix(
             ZS_WILDCOPY_OVERLENGTH >= 32,
             "Ensure that it's safe to load a vector");
 
-#if ZL_HAS_AVX2
     __m256i vec = _mm256_setzero_si256();
-#endif // ZL_HAS_AVX2
     for (size_t i = 0; i < nbWildcopies; ++i) {
         uint32_t const currEltWidth  = eltWidths[i];
         uint32_t const currMatchSize = matchSizes[i];
         ZL_RET_R_IF_GT(corruption, currMatchSize, prevFieldSize);
 
-// Write the shared prefix and the suffix
-// We branch between two implementations, where one is an optimized version that
-// reduces store-forward stalls. This happens while copying the prefix because
-// our read may overlap multiple store-forward buffers
-#if ZL_HAS_AVX2
+        // Write the shared prefix and the suffix.
+        // The vector version reduces store-forward stalls, which happen while
+        // copying the prefix, because our read may overlap multiple
+        // store-forward buffers.
         if (currMatchSize <= sizeof(__m256i)) {
             // Blend the previous field with the current suffix offset by
             // `currMatchSize` This won't underflow as any `matchSize` can be
@@ -158,8 +148,8 @@ ZL_Report ZS_decodePrefix(
                             (__m256i const*)(blendMasks[currMatchSize])));
             _mm256_storeu_si256((__m256i_u*)(currOutPtr), vec);
             if (currMatchSize + currEltWidth > sizeof(__m256i)) {
-                uint32_t remSuffix =
-                        (currMatchSize + currEltWidth) - sizeof(__m256i);
+                uint32_t const remSuffix = (uint32_t)(
+                        (currMatchSize + currEltWidth) - sizeof(__m256i));
                 ZS_wildcopy(
                         currOutPtr + sizeof(__m256i),
                         currSuffixPtr + (currEltWidth - remSuffix),
@@ -175,14 +165,59 @@ ZL_Report ZS_decodePrefix(
                     currEltWidth,
                     ZS_wo_no_overlap);
         }
-#else
+
+        // Setup for next iteration
+        prevFieldSize = currMatchSize + currEltWidth;
+        prevOutPtr    = currOutPtr;
+        currOutPtr += prevFieldSize;
+        currSuffixPtr += currEltWidth;
+        ZL_RET_R_IF(
+                corruption,
+                ZL_overflowAddU32(currMatchSize, currEltWidth, &fieldSizes[i]));
+    }
+
+    // Fallback to copy rest of elements
+    return ZS_decodePrefix_fallback(
+            prevOutPtr,
+            currOutPtr,
+            fieldSizes + nbWildcopies,
+            currSuffixPtr,
+            nbElts - nbWildcopies,
+            eltWidths + nbWildcopies,
+            matchSizes + nbWildcopies,
+            prevFieldSize);
+}
+
+ZL_TARGET_END
+
+#endif // ZL_CAN_AVX2
+
+static ZL_Report ZS_decodePrefix_scalar(
+        uint8_t* const out,
+        uint32_t* const fieldSizes,
+        const uint8_t* const suffixes,
+        size_t const nbElts,
+        const uint32_t* const eltWidths,
+        const uint32_t* const matchSizes,
+        size_t const nbWildcopies)
+{
+    const uint8_t* currSuffixPtr = suffixes;
+    uint8_t* prevOutPtr          = out;
+    uint8_t* currOutPtr          = out;
+    uint32_t prevFieldSize       = 0;
+
+    for (size_t i = 0; i < nbWildcopies; ++i) {
+        uint32_t const currEltWidth  = eltWidths[i];
+        uint32_t const currMatchSize = matchSizes[i];
+        ZL_RET_R_IF_GT(corruption, currMatchSize, prevFieldSize);
+
+        // Write the shared prefix and the suffix
         memcpy(currOutPtr, prevOutPtr, currMatchSize);
         ZS_wildcopy(
                 currOutPtr + currMatchSize,
                 currSuffixPtr,
                 currEltWidth,
                 ZS_wo_no_overlap);
-#endif // ZL_HAS_AVX2
 
         // Setup for next iteration
         prevFieldSize = currMatchSize + currEltWidth;
@@ -205,3 +240,42 @@ ZL_Report ZS_decodePrefix(
             matchSizes + nbWildcopies,
             prevFieldSize);
 }
+
+ZL_Report ZS_decodePrefix(
+        uint8_t* const out,
+        uint32_t* const fieldSizes,
+        const uint8_t* const suffixes,
+        size_t const nbElts,
+        const uint32_t* const eltWidths,
+        const uint32_t* const matchSizes)
+{
+    // Calculate the number of safe wildcopies
+    size_t nbWildcopies = nbElts;
+
+    for (size_t suffixSum = 0;
+         nbWildcopies > 0 && suffixSum < ZS_WILDCOPY_OVERLENGTH;
+         --nbWildcopies) {
+        suffixSum += eltWidths[nbWildcopies - 1];
+    }
+
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        return ZS_decodePrefix_avx2(
+                out,
+                fieldSizes,
+                suffixes,
+                nbElts,
+                eltWidths,
+                matchSizes,
+                nbWildcopies);
+    }
+#endif
+    return ZS_decodePrefix_scalar(
+            out,
+            fieldSizes,
+            suffixes,
+            nbElts,
+            eltWidths,
+            matchSizes,
+            nbWildcopies);
+}
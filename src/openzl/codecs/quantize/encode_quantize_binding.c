@@ -7,11 +7,6 @@
 #include "openzl/common/errors_internal.h" // ZS2_RET_IF*
 #include "openzl/zl_ctransform.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_quantizeLengths_time_ms = 0.0;
-static double EI_quantizeOffsets_time_ms = 0.0;
-
 static ZL_Report EI_quantize(
         ZL_Encoder* eictx,
         const ZL_Input* in,
@@ -48,37 +43,17 @@ static ZL_Report EI_quantize(
 ZL_Report
 EI_quantizeOffsets(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
-    ZL_Report EI_quantizeOffsets_report = EI_quantize(eictx, in, &ZL_quantizeOffsetsParams);
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_quantizeOffsets_time_ms += current_duration;
-    fprintf(stderr, "[EI_quantizeOffsets] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_quantizeOffsets_time_ms, current_duration);
-    return EI_quantizeOffsets_report;
+    return EI_quantize(eictx, in, &ZL_quantizeOffsetsParams);
 }
 
 ZL_Report
 EI_quantizeLengths(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
-    ZL_Report EI_quantizeLengths_report = EI_quantize(eictx, in, &ZL_quantizeLengthsParams);
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_quantizeLengths_time_ms += current_duration;
-    fprintf(stderr, "[EI_quantizeLengths] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_quantizeLengths_time_ms, current_duration);
-    return EI_quantizeLengths_report;
+    return EI_quantize(eictx, in, &ZL_quantizeLengthsParams);
 }
@@ -7,6 +7,16 @@
 #include <assert.h>
 #include <string.h> // memcpy
 
+#include "openzl/shared/portability.h" // ZL_FORCE_INLINE
+
+/* Structures with more fields than this are rejoined in tiles of this many
+ * fields, to keep the nb of source buffers read concurrently within TLB
+ * capacity. */
+#define ZS_RJ_TILE_FIELDS 16
+/* Tiles are applied to blocks of output of about this size, which remain in L1
+ * cache while each tile of fields is written. */
+#define ZS_RJ_BLOCK_SIZE (8 << 10)
+
 static size_t sumArrayST(const size_t array[], size_t arraySize)
 {
     size_t total = 0;
@@ -19,9 +29,111 @@ static size_t sumArrayST(const size_t array[], size_t arraySize)
     return total;
 }
 
+// Variants dedicated to structures where all fields share the same size,
+// so that each copy has a compile-time size.
+#define ZS_RJ_GEN_UNIFORM(fs)                                  \
+    static void rejoin_uniform##fs(                            \
+            void* restrict dst,                                \
+            const void* restrict srcs[],                       \
+            size_t nbFields,                                   \
+            size_t nbElts)                                     \
+    {                                                          \
+        char* op = (char*)dst;                                 \
+        for (size_t e = 0; e < nbElts; e++) {                  \
+            for (size_t f = 0; f < nbFields; f++) {            \
+                memcpy(op, (const char*)srcs[f] + e * fs, fs); \
+                op += fs;                                      \
+            }                                                  \
+        }                                                      \
+    }
+
+ZS_RJ_GEN_UNIFORM(1)
+ZS_RJ_GEN_UNIFORM(2)
+ZS_RJ_GEN_UNIFORM(4)
+ZS_RJ_GEN_UNIFORM(8)
+
+/* Copies one field, using an 8-bytes copy when @copy8 is set.
+ * Other fixed sizes use static size copies too. */
+ZL_FORCE_INLINE void
+rejoin_copyField(void* dst, const void* src, size_t fs, int copy8)
+{
+    if (copy8) {
+        memcpy(dst, src, 8);
+        return;
+    }
+    switch (fs) {
+        case 1:
+            memcpy(dst, src, 1);
+            break;
+        case 2:
+            memcpy(dst, src, 2);
+            break;
+        case 4:
+            memcpy(dst, src, 4);
+            break;
+        case 8:
+            memcpy(dst, src, 8);
+            break;
+        default:
+            memcpy(dst, src, fs);
+            break;
+    }
+}
+
+/* Rejoins structures with many fields,
+ * one block of structures and one tile of fields at a time.
+ * Within structures [0, @nbFastElts), fields followed by at least 8 bytes
+ * of the same tile employ 8-bytes copies:
+ * the overflow is then overwritten by the next fields of the same tile.
+ * Overflowing past the tile is not allowed,
+ * since it would corrupt fields written by a previous tile.
+ * @nbFastElts must leave enough elements in each source for 8-bytes reads.
+ */
+static void rejoin_tiled(
+        void* restrict dst,
+        const void* restrict srcs[],
+        const size_t fieldSizes[],
+        size_t nbFields,
+        size_t nbElts,
+        size_t structSize,
+        size_t nbFastElts)
+{
+    size_t const blockElts =
+            (structSize < ZS_RJ_BLOCK_SIZE) ? ZS_RJ_BLOCK_SIZE / structSize : 1;
+    for (size_t start = 0; start < nbElts; start += blockElts) {
+        size_t const end =
+                (nbElts - start < blockElts) ? nbElts : start + blockElts;
+        size_t tileOffset = 0;
+        for (size_t first = 0; first < nbFields; first += ZS_RJ_TILE_FIELDS) {
+            size_t const last = (nbFields - first < ZS_RJ_TILE_FIELDS)
+                    ? nbFields
+                    : first + ZS_RJ_TILE_FIELDS;
+            size_t tileSize = 0;
+            for (size_t f = first; f < last; f++) {
+                tileSize += fieldSizes[f];
+            }
+            for (size_t e = start; e < end; e++) {
+                char* op       = (char*)dst + e * structSize + tileOffset;
+                size_t inTile  = 0;
+                int const fast = e < nbFastElts;
+                for (size_t f = first; f < last; f++) {
+                    size_t const fs = fieldSizes[f];
+                    int const copy8 =
+                            fast && fs <= 8 && inTile + 8 <= tileSize;
+                    rejoin_copyField(
+                            op + inTile,
+                            (const char*)srcs[f] + e * fs,
+                            fs,
+                            copy8);
+                    inTile += fs;
+                }
+            }
+            tileOffset += tileSize;
+        }
+    }
+}
+
 // Variant dedicated to all @fieldSizes <= 8
-// Note : in the future more variant could be created for other sizes,
-// typically 4 and 16, maybe 2 and 1, possibly 32, etc.
 static size_t rejoin_max8(
         void* restrict dst,
         size_t dstCapacity,
@@ -112,6 +224,26 @@ size_t ZS_dispatchArrayFixedSizeStruct_decode(
     size_t const dstSize    = structSize * nbElts;
     assert(dstSize <= dstCapacity);
 
+    // Shortcut to variants with static size copies
+    if (minFieldSize == maxFieldSize && nbFields <= ZS_RJ_TILE_FIELDS) {
+        switch (minFieldSize) {
+            case 1:
+                rejoin_uniform1(dst, srcs, nbFields, nbElts);
+                return dstSize;
+            case 2:
+                rejoin_uniform2(dst, srcs, nbFields, nbElts);
+                return dstSize;
+            case 4:
+                rejoin_uniform4(dst, srcs, nbFields, nbElts);
+                return dstSize;
+            case 8:
+                rejoin_uniform8(dst, srcs, nbFields, nbElts);
+                return dstSize;
+            default:
+                break;
+        }
+    }
+
     // Shortcut to 8-bytes variant
     if (maxFieldSize <= 8 && minFieldSize >= 1) {
         return rejoin_max8(
@@ -119,6 +251,19 @@ size_t ZS_dispatchArrayFixedSizeStruct_decode(
     }
 
     // Generic variant (slower)
+    if (nbFields > ZS_RJ_TILE_FIELDS) {
+        // Leaves enough elements for 8-bytes reads of 1-byte fields
+        size_t const nbFastElts = (nbElts > 8) ? nbElts - 8 : 0;
+        rejoin_tiled(
+                dst,
+                srcs,
+                fieldSizes,
+                nbFields,
+                nbElts,
+                structSize,
+                nbFastElts);
+        return dstSize;
+    }
     size_t pos = 0;
     for (size_t e = 0; e < nbElts; e++) {
         for (size_t f = 0; f < nbFields; f++) {
@@ -1,9 +1,51 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include <assert.h>
+#include <stdint.h> // uint8_t
 #include <string.h> // memcpy
 
 #include "openzl/codecs/splitByStruct/encode_splitByStruct_kernel.h"
+#include "openzl/shared/portability.h" // ZL_FORCE_INLINE
+
+/* Structures with more members than this are split in tiles of this many
+ * members, to keep the nb of destination buffers written concurrently within
+ * what the TLB and the L1 write buffers can track. */
+#define ZS_DAFSS_TILE_MEMBERS 8
+/* Tiles are applied to blocks of input of about this size, which remain in L1
+ * cache while each tile of members is extracted. */
+#define ZS_DAFSS_BLOCK_SIZE (8 << 10)
+
+// Functions dedicated to structures with all members of the same size
+static void ZS_dafss_uniform1(
+        void* restrict dstBuffers[],
+        size_t nbStructMembers,
+        const void* src,
+        size_t nbStructs);
+static void ZS_dafss_uniform2(
+        void* restrict dstBuffers[],
+        size_t nbStructMembers,
+        const void* src,
+        size_t nbStructs);
+static void ZS_dafss_uniform4(
+        void* restrict dstBuffers[],
+        size_t nbStructMembers,
+        const void* src,
+        size_t nbStructs);
+static void ZS_dafss_uniform8(
+        void* restrict dstBuffers[],
+        size_t nbStructMembers,
+        const void* src,
+        size_t nbStructs);
+
+// Function for structures with too many members for the TLB
+static void ZS_dafss_tiled(
+        void* restrict dstBuffers[],
+        size_t nbStructMembers,
+        const void* src,
+        size_t nbStructs,
+        const size_t* structMemberSizes,
+        size_t structSize,
+        int copy8);
 
 // Function dedicated to structures with all member sizes <= 8
 static void ZS_dafss_nosmsgt8(
@@ -36,6 +78,11 @@ static void ZS_dafss_anysms(
  * which is fairly common (ex: sao, vrs),
  * in which case, speed jumps to 5.4 GB/s.
  *
+ * Structures where all members share the same size 1, 2, 4 or 8
+ * (ex: arrays of int32 records) get their own instantiation,
+ * where each copy has a compile-time size.
+ * Structures with many members are handled in tiles, see below.
+ *
  * A JIT compiler could do better,
  * by taking full advantage of the fixed structure of fixed size
  * to produce a more compact code with less branches,
@@ -82,6 +129,11 @@ static void ZS_dafss_anysms(
  * could be to cut the job into several "batches",
  * in charge of a subset of members suitable for TLB capacity,
  * and run them in parallel in different threads.
+ *
+ * This batching is what ZS_dafss_tiled() does, in a single thread:
+ * input is cut into blocks which fit in L1 cache,
+ * and each block is scanned once per tile of ZS_DAFSS_TILE_MEMBERS members.
+ * Only structures with more members than a tile employ it.
  */
 
 void ZS_dispatchArrayFixedSizeStruct(
@@ -107,10 +159,12 @@ void ZS_dispatchArrayFixedSizeStruct(
     }
 
     int smsgt8        = 0;
+    int uniform       = 1;
     size_t structSize = 0;
 
     for (size_t n = 0; n < nbStructMembers; n++) {
         smsgt8 |= (structMemberSizes[n] > 8);
+        uniform &= (structMemberSizes[n] == structMemberSizes[0]);
         structSize += structMemberSizes[n];
     }
     // Since srcSize > 0, only non-empty struct are valid at this stage
@@ -119,12 +173,43 @@ void ZS_dispatchArrayFixedSizeStruct(
     size_t const nbStructs = srcSize / structSize;
     assert(nbStructs * structSize == srcSize); /* exact multiple */
 
+    if (uniform && nbStructMembers <= ZS_DAFSS_TILE_MEMBERS) {
+        switch (structMemberSizes[0]) {
+            case 1:
+                ZS_dafss_uniform1(dstBuffers, nbStructMembers, src, nbStructs);
+                return;
+            case 2:
+                ZS_dafss_uniform2(dstBuffers, nbStructMembers, src, nbStructs);
+                return;
+            case 4:
+                ZS_dafss_uniform4(dstBuffers, nbStructMembers, src, nbStructs);
+                return;
+            case 8:
+                ZS_dafss_uniform8(dstBuffers, nbStructMembers, src, nbStructs);
+                return;
+            default:
+                break;
+        }
+    }
+
     if (!smsgt8) {
         ZS_dafss_nosmsgt8(
                 dstBuffers, nbStructMembers, src, nbStructs, structMemberSizes);
         return;
     }
 
+    if (nbStructMembers > ZS_DAFSS_TILE_MEMBERS) {
+        ZS_dafss_tiled(
+                dstBuffers,
+                nbStructMembers,
+                src,
+                nbStructs,
+                structMemberSizes,
+                structSize,
+                0);
+        return;
+    }
+
     ZS_dafss_anysms(
             dstBuffers, nbStructMembers, src, nbStructs, structMemberSizes);
 }
@@ -153,7 +238,22 @@ static void ZS_dafss_nosmsgt8(
     size_t const nbSafeRounds_precalc[8] = { 8, 4, 3, 2, 2, 2, 2, 1 };
     size_t const nbSafeRounds = nbSafeRounds_precalc[smallestSms - 1];
 
-    if (nbStructs > nbSafeRounds) {
+    if (nbStructs > nbSafeRounds && nbStructMembers > ZS_DAFSS_TILE_MEMBERS) {
+        size_t structSize = 0;
+        for (size_t n = 0; n < nbStructMembers; n++) {
+            structSize += structMemberSizes[n];
+        }
+        size_t const nbFastStructs = nbStructs - nbSafeRounds;
+        ZS_dafss_tiled(
+                dstBuffers,
+                nbStructMembers,
+                src,
+                nbFastStructs,
+                structMemberSizes,
+                structSize,
+                1);
+        src = (const char*)src + nbFastStructs * structSize;
+    } else if (nbStructs > nbSafeRounds) {
         for (size_t n = 0; n < (nbStructs - nbSafeRounds); n++) {
             for (size_t bufid = 0; bufid < nbStructMembers; bufid++) {
                 size_t const sms = structMemberSizes[bufid];
@@ -187,3 +287,108 @@ static void ZS_dafss_anysms(
         }
     }
 }
+
+#define ZS_DAFSS_GEN_UNIFORM(sms)                                       \
+    static void ZS_dafss_uniform##sms(                                  \
+            void* restrict dstBuffers[],                                \
+            size_t nbStructMembers,                                     \
+            const void* src,                                            \
+            size_t nbStructs)                                           \
+    {                                                                   \
+        const uint8_t* ip = (const uint8_t*)src;                        \
+        for (size_t n = 0; n < nbStructs; n++) {                        \
+            for (size_t bufid = 0; bufid < nbStructMembers; bufid++) {  \
+                memcpy((uint8_t*)dstBuffers[bufid] + n * sms, ip, sms); \
+                ip += sms;                                              \
+            }                                                           \
+        }                                                               \
+        for (size_t bufid = 0; bufid < nbStructMembers; bufid++) {      \
+            dstBuffers[bufid] = (uint8_t*)dstBuffers[bufid]             \
+                    + nbStructs * sms;                                  \
+        }                                                               \
+    }
+
+ZS_DAFSS_GEN_UNIFORM(1)
+ZS_DAFSS_GEN_UNIFORM(2)
+ZS_DAFSS_GEN_UNIFORM(4)
+ZS_DAFSS_GEN_UNIFORM(8)
+
+/* Extracts one tile of members from a block of structures.
+ * @src points at the first member of the tile within the first structure.
+ * @copy8 : all members have a size <= 8, and 8 bytes can be read and written
+ *          at every member position (the caller keeps a safety margin).
+ */
+ZL_FORCE_INLINE void ZS_dafss_extractTile(
+        void* restrict dstBuffers[],
+        size_t nbTileMembers,
+        const uint8_t* src,
+        size_t nbStructs,
+        const size_t* structMemberSizes,
+        size_t structSize,
+        int copy8)
+{
+    for (size_t n = 0; n < nbStructs; n++) {
+        const uint8_t* ip = src + n * structSize;
+        for (size_t bufid = 0; bufid < nbTileMembers; bufid++) {
+            size_t const sms = structMemberSizes[bufid];
+            if (copy8) {
+                memcpy(dstBuffers[bufid], ip, 8);
+            } else {
+                memcpy(dstBuffers[bufid], ip, sms);
+            }
+            dstBuffers[bufid] = (char*)(dstBuffers[bufid]) + sms;
+            ip += sms;
+        }
+    }
+}
+
+static void ZS_dafss_tiled(
+        void* restrict dstBuffers[],
+        size_t nbStructMembers,
+        const void* src,
+        size_t nbStructs,
+        const size_t* structMemberSizes,
+        size_t structSize,
+        int copy8)
+{
+    const uint8_t* const src8 = (const uint8_t*)src;
+    size_t const blockStructs = (structSize < ZS_DAFSS_BLOCK_SIZE)
+            ? ZS_DAFSS_BLOCK_SIZE / structSize
+            : 1;
+    for (size_t start = 0; start < nbStructs; start += blockStructs) {
+        size_t const nbBlockStructs = (nbStructs - start < blockStructs)
+                ? nbStructs - start
+                : blockStructs;
+        const uint8_t* tileSrc = src8 + start * structSize;
+        for (size_t first = 0; first < nbStructMembers;
+             first += ZS_DAFSS_TILE_MEMBERS) {
+            size_t const nbTileMembers =
+                    (nbStructMembers - first < ZS_DAFSS_TILE_MEMBERS)
+                    ? nbStructMembers - first
+                    : ZS_DAFSS_TILE_MEMBERS;
+            if (copy8) {
+                ZS_dafss_extractTile(
+                        dstBuffers + first,
+                        nbTileMembers,
+                        tileSrc,
+                        nbBlockStructs,
+                        structMemberSizes + first,
+                        structSize,
+                        1);
+            } else {
+                ZS_dafss_extractTile(
+                        dstBuffers + first,
+                        nbTileMembers,
+                        tileSrc,
+                        nbBlockStructs,
+                        structMemberSizes + first,
+                        structSize,
+                        0);
+            }
+            for (size_t bufid = first; bufid < first + nbTileMembers;
+                 bufid++) {
+                tileSrc += structMemberSizes[bufid];
+            }
+        }
+    }
+}
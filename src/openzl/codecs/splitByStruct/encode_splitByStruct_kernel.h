@@ -5,6 +5,10 @@
 
 #include <stddef.h> // size_t
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 /* ZS_dispatchArrayFixedSizeStruct():
  *
  * dispatch input @src
@@ -35,4 +39,8 @@ void ZS_dispatchArrayFixedSizeStruct(
         size_t srcSize,
         const size_t* structMemberSizes);
 
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
 #endif
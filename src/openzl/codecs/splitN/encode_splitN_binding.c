@@ -18,12 +18,6 @@
 #define ZL_SPLITN_NBSEGMENTS_PID 324
 #define ZL_SPLITN_PARSINGF_PID 436
 
-#include <stdio.h>
-#include <time.h>
-static double EI_splitN_time_ms = 0.0;
-static double EI_splitN_struct_time_ms = 0.0;
-static double EI_splitN_num_time_ms = 0.0;
-
 struct ZL_SplitState_s {
     ZL_Encoder* eictx;
 };
@@ -110,9 +104,6 @@ static ZL_RESULT_OF(ZL_SplitInstructions)
 // into output streams, as described in ZL_SPLITN_SEGMENTSIZES_PID parameter.
 ZL_Report EI_splitN(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -166,29 +157,6 @@ ZL_Report EI_splitN(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
             inSize,
             "split instructions do not map exactly the entire input");
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-    double current_duration = end_time_ms - start_time_ms;
-
-    ZL_Type currentType = ZL_Input_type(in);
-    switch (currentType){
-        case ZL_Type_serial:
-            EI_splitN_time_ms += current_duration;
-            fprintf(stderr, "[EI_splitN_serial] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_splitN_time_ms, current_duration);
-            break;
-        case ZL_Type_struct:
-            EI_splitN_struct_time_ms += current_duration;
-            // fprintf(stderr, "[EI_splitN_struct] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_splitN_struct_time_ms, current_duration);
-            break;
-        case ZL_Type_numeric:
-            EI_splitN_num_time_ms += current_duration;
-            // fprintf(stderr, "[EI_splitN_numeric] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_splitN_num_time_ms, current_duration);
-            break;
-        case ZL_Type_string:
-            break;
-    }
-
     return ZL_returnSuccess();
 }
 
@@ -7,24 +7,25 @@
 
 #include "openzl/codecs/tokenize/encode_tokenize_binding.h"
 #include "openzl/codecs/tokenize/encode_tokenize_kernel.h"
+#include "openzl/codecs/tokenize/encode_tokenize_kernel_sort.h"
 #include "openzl/compress/enc_interface.h"
 #include "openzl/compress/private_nodes.h"
 #include "openzl/shared/bits.h"
+#include "openzl/shared/estimate.h"
 #include "openzl/shared/pdqsort.h"
 #include "openzl/zl_ctransform.h"
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 
-#include <stdio.h>
-#include <time.h>
-
-static double EI_tokenize_serial_time_ms = 0.0;
-static double EI_tokenize_struct_time_ms = 0.0;
-static double EI_tokenize_numeric_time_ms = 0.0;
-static double EI_tokenizeVSF_time_ms = 0.0;
-
 #define ZL_TOKENIZE_TOKENIZER_PID 1
 
+// Numeric inputs whose value range is at most this many times their number of
+// elements are tokenized through a direct-mapped table.
+#define ZL_TOKENIZE_DIRECT_RANGE_FACTOR 4
+// Above this estimated cardinality, sorted alphabets are built with a radix
+// sort, since the hash map no longer fits in cache.
+#define ZL_TOKENIZE_RADIX_MIN_CARDINALITY (1u << 18)
+
 struct ZL_CustomTokenizeState_s {
     ZL_Encoder* eictx;
     void const* opaque;
@@ -77,9 +78,8 @@ typedef struct {
 
 // Tokenize uses only one map from uint64 -> size_t for simplicity.
 // If we want to specialize for eltWidths, we could be a bit more efficient.
-// For now we use the default hash function (xxh3) and equality functions.
-// This provides a very strong hash function, but we may be able to sacrifice
-// some hash quality for speed later on.
+// Numeric inputs only fall back to the map when neither the direct-mapped
+// table nor the radix sort applies, see tokenizeImpl().
 ZL_DECLARE_MAP_TYPE(Map8, uint64_t, size_t);
 
 ZL_FORCE_INLINE uint64_t
@@ -132,6 +132,100 @@ ZL_FORCE_INLINE ZL_Report writeIndicesImpl(
     return ZL_returnSuccess();
 }
 
+static size_t getMinIdxSpace(size_t const alphabetSize)
+{
+    if (alphabetSize <= (1u << 8)) {
+        return 1;
+    }
+    if (alphabetSize <= (1u << 16)) {
+        return 2;
+    }
+    return 4;
+}
+
+static ZL_Report tokenizeDirect(
+        ZL_Encoder* eictx,
+        const ZL_Input* in,
+        ZL_ElementRange range,
+        bool sort)
+{
+    void const* const input = ZL_Input_ptr(in);
+    size_t const nbElts     = ZL_Input_numElts(in);
+    size_t const eltWidth   = ZL_Input_eltWidth(in);
+    size_t const rangeSize  = (size_t)(range.max - range.min) + 1;
+
+    uint32_t* const table = ZL_Encoder_getScratchSpace(
+            eictx, rangeSize * sizeof(uint32_t));
+    ZL_RET_R_IF_NULL(allocation, table);
+    size_t const alphabetSize = ZS_tokenizeDirect_buildTable(
+            table, rangeSize, input, nbElts, eltWidth, range.min, sort);
+
+    ZL_Output* const alphabet =
+            ZL_Encoder_createTypedStream(eictx, 0, alphabetSize, eltWidth);
+    ZL_RET_R_IF_NULL(allocation, alphabet);
+    size_t const idxWidth = getMinIdxSpace(alphabetSize);
+    ZL_Output* const indices =
+            ZL_Encoder_createTypedStream(eictx, 1, nbElts, idxWidth);
+    ZL_RET_R_IF_NULL(allocation, indices);
+
+    ZS_tokenizeDirect_writeAlphabet(
+            ZL_Output_ptr(alphabet), table, rangeSize, eltWidth, range.min);
+    ZS_tokenizeDirect_writeIndices(
+            ZL_Output_ptr(indices),
+            idxWidth,
+            table,
+            input,
+            nbElts,
+            eltWidth,
+            range.min);
+
+    ZL_RET_R_IF_ERR(ZL_Output_commit(alphabet, alphabetSize));
+    ZL_RET_R_IF_ERR(ZL_Output_commit(indices, nbElts));
+    return ZL_returnSuccess();
+}
+
+static ZL_Report
+tokenizeRadix(ZL_Encoder* eictx, const ZL_Input* in, ZL_ElementRange range)
+{
+    void const* const input = ZL_Input_ptr(in);
+    size_t const nbElts     = ZL_Input_numElts(in);
+    size_t const eltWidth   = ZL_Input_eltWidth(in);
+
+    void* const workspace = ZL_Encoder_getScratchSpace(
+            eictx, ZS_tokenizeRadix_wkspSize(nbElts));
+    ZL_RET_R_IF_NULL(allocation, workspace);
+    size_t alphabetSize;
+    uint64_t const* const entries = ZS_tokenizeRadix_sort(
+            &alphabetSize,
+            input,
+            nbElts,
+            eltWidth,
+            range.min,
+            range.max,
+            workspace);
+
+    ZL_Output* const alphabet =
+            ZL_Encoder_createTypedStream(eictx, 0, alphabetSize, eltWidth);
+    ZL_RET_R_IF_NULL(allocation, alphabet);
+    size_t const idxWidth = getMinIdxSpace(alphabetSize);
+    ZL_Output* const indices =
+            ZL_Encoder_createTypedStream(eictx, 1, nbElts, idxWidth);
+    ZL_RET_R_IF_NULL(allocation, indices);
+
+    ZS_tokenizeRadix_write(
+            ZL_Output_ptr(alphabet),
+            ZL_Output_ptr(indices),
+            idxWidth,
+            entries,
+            nbElts,
+            eltWidth,
+            range.min);
+
+    ZL_RET_R_IF_ERR(ZL_Output_commit(alphabet, alphabetSize));
+    ZL_RET_R_IF_ERR(ZL_Output_commit(indices, nbElts));
+    return ZL_returnSuccess();
+}
+
 ZL_FORCE_INLINE ZL_Report tokenizeImpl(
         ZL_Encoder* eictx,
         const ZL_Input* in,
@@ -145,7 +239,36 @@ ZL_FORCE_INLINE ZL_Report tokenizeImpl(
     size_t const nbElts     = ZL_Input_numElts(in);
 
     // Reserve up to 256 entries to skip past the small growth stage.
-    if (!Map8_reserve(tokToIdx, ZL_MIN(256, (uint32_t)nbElts), false)) {
+    uint64_t reserveHint = 256;
+
+    // Pick the cheapest strategy for numeric inputs. All strategies produce
+    // the same alphabet & indices.
+    if (eltWidth >= 4 && ZL_Input_type(in) == ZL_Type_numeric) {
+        ZL_ElementRange const range =
+                ZL_computeUnsignedRange(input, nbElts, eltWidth);
+        uint64_t const rangeMinusOne = range.max - range.min;
+        if (rangeMinusOne < ZS_TOKENIZE_DIRECT_RANGE_MAX
+            && rangeMinusOne < ZL_TOKENIZE_DIRECT_RANGE_FACTOR
+                            * ZL_MAX(nbElts, 256)) {
+            return tokenizeDirect(eictx, in, range, sort);
+        }
+        uint64_t const earlyExit = sort ? ZL_TOKENIZE_RADIX_MIN_CARDINALITY
+                                        : ZL_ESTIMATE_CARDINALITY_16BITS;
+        ZL_CardinalityEstimate const cardinality =
+                ZL_estimateCardinality_fixed(
+                        input, nbElts, eltWidth, earlyExit);
+        if (sort && cardinality.estimate >= ZL_TOKENIZE_RADIX_MIN_CARDINALITY
+            && rangeMinusOne <= UINT32_MAX && nbElts <= UINT32_MAX) {
+            return tokenizeRadix(eictx, in, range);
+        }
+        // The estimate is only meaningful below the early exit threshold
+        reserveHint = ZL_MIN(cardinality.estimate, earlyExit);
+    }
+
+    if (!Map8_reserve(
+                tokToIdx,
+                (uint32_t)ZL_MIN(reserveHint, nbElts),
+                false)) {
         ZL_RET_R_ERR(allocation);
     }
 
@@ -446,45 +569,7 @@ ZL_Report EI_tokenize(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
         ZL_Report const report = (param.customTokenizeFn)(&ctx, in);
         ZL_RET_R(report);
     }
-    ZL_Type currentType = ZL_Input_type(in);
-
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-    ZL_Report EI_tokenize_report = EI_tokenizeImpl(eictx, in, EI_tokenizeShouldSort(eictx));
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-    double current_duration = end_time_ms - start_time_ms;
-
-    switch (currentType){
-        case ZL_Type_serial:
-            EI_tokenize_serial_time_ms += current_duration;
-            fprintf(stderr, "[EI_tokenize_serial] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_tokenize_serial_time_ms, current_duration);
-            break;
-        case ZL_Type_struct:
-            EI_tokenize_struct_time_ms += current_duration;
-            fprintf(stderr, "[EI_tokenize_struct] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_tokenize_struct_time_ms, current_duration);
-            break;
-        case ZL_Type_numeric:
-            EI_tokenize_numeric_time_ms += current_duration;
-            fprintf(stderr, "[EI_tokenize_numeric] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_tokenize_numeric_time_ms, current_duration);
-            break;
-        case ZL_Type_string:
-            break;
-    }
-    return EI_tokenize_report;
-}
-
-static size_t getMinIdxSpace(size_t const alphabetSize)
-{
-    if (alphabetSize <= (1u << 8)) {
-        return 1;
-    }
-    if (alphabetSize <= (1u << 16)) {
-        return 2;
-    }
-    return 4;
+    return EI_tokenizeImpl(eictx, in, EI_tokenizeShouldSort(eictx));
 }
 
 static ZL_Report EI_tokenizeVSFImpl(
@@ -548,9 +633,6 @@ static ZL_Report EI_tokenizeVSFImpl(
 
 ZL_Report EI_tokenizeVSF(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in = ins[0];
@@ -558,13 +640,6 @@ ZL_Report EI_tokenizeVSF(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     ZL_Report report   = EI_tokenizeVSFImpl(
             eictx, &tokToIdx, in, EI_tokenizeShouldSort(eictx));
     MapVSF_destroy(&tokToIdx);
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_tokenizeVSF_time_ms += current_duration;
-    fprintf(stderr, "[EI_tokenizeVSF] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_tokenizeVSF_time_ms, current_duration);
     return report;
 }
 
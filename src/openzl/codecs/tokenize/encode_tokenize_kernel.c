@@ -126,3 +126,134 @@ ZL_Report ZS_tokenizeVSFEncode(
 
     return ZL_returnSuccess();
 }
+
+ZL_FORCE_INLINE size_t tokenizeDirect_buildTable_impl(
+        uint32_t* table,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue,
+        size_t rangeSize,
+        bool sort)
+{
+    uint8_t const* const src8 = (uint8_t const*)src;
+    memset(table, 0xFF, rangeSize * sizeof(*table));
+    if (sort) {
+        // Mark present values, then number them in increasing order
+        for (size_t i = 0; i < nbElts; ++i) {
+            uint64_t const value = ZL_readN(src8 + i * eltWidth, eltWidth);
+            table[value - minValue] = 0;
+        }
+        uint32_t alphabetSize = 0;
+        for (size_t v = 0; v < rangeSize; ++v) {
+            if (table[v] == 0) {
+                table[v] = alphabetSize++;
+            }
+        }
+        return alphabetSize;
+    }
+    uint32_t alphabetSize = 0;
+    for (size_t i = 0; i < nbElts; ++i) {
+        uint64_t const value = ZL_readN(src8 + i * eltWidth, eltWidth);
+        uint32_t* const entry = &table[value - minValue];
+        if (*entry == ZS_TOKENIZE_DIRECT_ABSENT) {
+            *entry = alphabetSize++;
+        }
+    }
+    return alphabetSize;
+}
+
+size_t ZS_tokenizeDirect_buildTable(
+        uint32_t* table,
+        size_t rangeSize,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue,
+        bool sort)
+{
+    ZL_ASSERT_LE(rangeSize, ZS_TOKENIZE_DIRECT_RANGE_MAX);
+    switch (eltWidth) {
+        case 4:
+            return tokenizeDirect_buildTable_impl(
+                    table, src, nbElts, 4, minValue, rangeSize, sort);
+        case 8:
+            return tokenizeDirect_buildTable_impl(
+                    table, src, nbElts, 8, minValue, rangeSize, sort);
+        default:
+            return tokenizeDirect_buildTable_impl(
+                    table, src, nbElts, eltWidth, minValue, rangeSize, sort);
+    }
+}
+
+void ZS_tokenizeDirect_writeAlphabet(
+        void* alphabet,
+        uint32_t const* table,
+        size_t rangeSize,
+        size_t eltWidth,
+        uint64_t minValue)
+{
+    uint8_t* const alphabet8 = (uint8_t*)alphabet;
+    for (size_t v = 0; v < rangeSize; ++v) {
+        uint32_t const index = table[v];
+        if (index != ZS_TOKENIZE_DIRECT_ABSENT) {
+            ZL_writeN(alphabet8 + index * eltWidth, minValue + v, eltWidth);
+        }
+    }
+}
+
+ZL_FORCE_INLINE void tokenizeDirect_writeIndices_impl(
+        void* indices,
+        size_t idxWidth,
+        uint32_t const* table,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue)
+{
+    uint8_t const* const src8 = (uint8_t const*)src;
+    uint8_t* const indices8   = (uint8_t*)indices;
+    for (size_t i = 0; i < nbElts; ++i) {
+        uint64_t const value = ZL_readN(src8 + i * eltWidth, eltWidth);
+        ZL_writeN(indices8 + i * idxWidth, table[value - minValue], idxWidth);
+    }
+}
+
+#define ZS_TOKENIZE_DIRECT_WRITE_INDICES(eltWidth, idxWidth) \
+    tokenizeDirect_writeIndices_impl(                        \
+            indices, idxWidth, table, src, nbElts, eltWidth, minValue)
+
+void ZS_tokenizeDirect_writeIndices(
+        void* indices,
+        size_t idxWidth,
+        uint32_t const* table,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue)
+{
+    // Specialize the hot loop for the common element & index widths
+    switch (eltWidth * 16 + idxWidth) {
+        case 4 * 16 + 1:
+            ZS_TOKENIZE_DIRECT_WRITE_INDICES(4, 1);
+            break;
+        case 4 * 16 + 2:
+            ZS_TOKENIZE_DIRECT_WRITE_INDICES(4, 2);
+            break;
+        case 4 * 16 + 4:
+            ZS_TOKENIZE_DIRECT_WRITE_INDICES(4, 4);
+            break;
+        case 8 * 16 + 1:
+            ZS_TOKENIZE_DIRECT_WRITE_INDICES(8, 1);
+            break;
+        case 8 * 16 + 2:
+            ZS_TOKENIZE_DIRECT_WRITE_INDICES(8, 2);
+            break;
+        case 8 * 16 + 4:
+            ZS_TOKENIZE_DIRECT_WRITE_INDICES(8, 4);
+            break;
+        default:
+            ZS_TOKENIZE_DIRECT_WRITE_INDICES(eltWidth, idxWidth);
+            break;
+    }
+}
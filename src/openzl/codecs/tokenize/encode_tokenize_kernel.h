@@ -54,6 +54,44 @@ ZL_Report ZS_tokenizeVSFEncode(
         size_t idxWidth,
         bool sort);
 
+/* Direct-mapped tokenization of numeric inputs whose values all lie within a
+ * small range [minValue, minValue + rangeSize). A table of @p rangeSize
+ * indices, directly addressed by (value - minValue), replaces the hash map.
+ * The alphabet is in numeric order when @p sort, and in order of first
+ * occurrence otherwise, exactly like the hash-based tokenization.
+ */
+
+#define ZS_TOKENIZE_DIRECT_RANGE_MAX (1u << 20)
+#define ZS_TOKENIZE_DIRECT_ABSENT UINT32_MAX
+
+/// Fills @p table, which has room for @p rangeSize indices, with the alphabet
+/// index of each value, or ZS_TOKENIZE_DIRECT_ABSENT for absent values.
+/// @returns the alphabet size
+size_t ZS_tokenizeDirect_buildTable(
+        uint32_t* table,
+        size_t rangeSize,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue,
+        bool sort);
+
+void ZS_tokenizeDirect_writeAlphabet(
+        void* alphabet,
+        uint32_t const* table,
+        size_t rangeSize,
+        size_t eltWidth,
+        uint64_t minValue);
+
+void ZS_tokenizeDirect_writeIndices(
+        void* indices,
+        size_t idxWidth,
+        uint32_t const* table,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue);
+
 ZL_END_C_DECLS
 
 #endif // ZSTRONG_TRANSFORMS_TOKENIZE_ENCODE_TOKENIZE_KERNEL_H
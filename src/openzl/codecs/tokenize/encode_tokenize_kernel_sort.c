@@ -1,6 +1,8 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include "openzl/codecs/tokenize/encode_tokenize_kernel_sort.h"
+#include "openzl/shared/bits.h"
+#include "openzl/shared/mem.h"
 
 static int vsfComparator(const void* lhs, const void* rhs);
 
@@ -33,3 +35,163 @@ void pqdsortVsf(VSFKey* data, size_t nbElts)
 {
     pdqsort_branchless(data, data + nbElts);
 }
+
+#define ZS_TOKENIZE_RADIX_BITS 11
+#define ZS_TOKENIZE_RADIX_SIZE (1 << ZS_TOKENIZE_RADIX_BITS)
+#define ZS_TOKENIZE_RADIX_MAX_PASSES \
+    ((32 + ZS_TOKENIZE_RADIX_BITS - 1) / ZS_TOKENIZE_RADIX_BITS)
+
+size_t ZS_tokenizeRadix_wkspSize(size_t nbElts)
+{
+    return 2 * nbElts * sizeof(uint64_t);
+}
+
+ZL_FORCE_INLINE void tokenizeRadix_pack(
+        uint64_t* entries,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue)
+{
+    uint8_t const* const src8 = (uint8_t const*)src;
+    for (size_t i = 0; i < nbElts; ++i) {
+        uint64_t const value = ZL_readN(src8 + i * eltWidth, eltWidth);
+        entries[i]           = ((value - minValue) << 32) | i;
+    }
+}
+
+uint64_t const* ZS_tokenizeRadix_sort(
+        size_t* alphabetSize,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue,
+        uint64_t maxValue,
+        void* workspace)
+{
+    ZL_ASSERT_LE(minValue, maxValue);
+    ZL_ASSERT_LE(maxValue - minValue, UINT32_MAX);
+    ZL_ASSERT_LE(nbElts, UINT32_MAX);
+    uint64_t* entries = (uint64_t*)workspace;
+    uint64_t* tmp     = entries + nbElts;
+
+    if (eltWidth == 4) {
+        tokenizeRadix_pack(entries, src, nbElts, 4, minValue);
+    } else if (eltWidth == 8) {
+        tokenizeRadix_pack(entries, src, nbElts, 8, minValue);
+    } else {
+        tokenizeRadix_pack(entries, src, nbElts, eltWidth, minValue);
+    }
+
+    // Only sort on the digits which the value range needs
+    uint64_t const range = maxValue - minValue;
+    int const nbPasses   = range == 0
+              ? 0
+              : (ZL_highbit64(range) + ZS_TOKENIZE_RADIX_BITS)
+                    / ZS_TOKENIZE_RADIX_BITS;
+    ZL_ASSERT_LE(nbPasses, ZS_TOKENIZE_RADIX_MAX_PASSES);
+
+    // Histograms of all passes are gathered in one pass over the entries
+    uint32_t counts[ZS_TOKENIZE_RADIX_MAX_PASSES][ZS_TOKENIZE_RADIX_SIZE];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i < nbElts; ++i) {
+        uint64_t const value = entries[i] >> 32;
+        for (int p = 0; p < nbPasses; ++p) {
+            counts[p][(value >> (p * ZS_TOKENIZE_RADIX_BITS))
+                      & (ZS_TOKENIZE_RADIX_SIZE - 1)]++;
+        }
+    }
+
+    for (int p = 0; p < nbPasses; ++p) {
+        int const shift = 32 + p * ZS_TOKENIZE_RADIX_BITS;
+        // Convert the counts into starting offsets
+        uint32_t sum  = 0;
+        bool skipPass = false;
+        for (size_t d = 0; d < ZS_TOKENIZE_RADIX_SIZE; ++d) {
+            uint32_t const count = counts[p][d];
+            // All the entries share this digit: the pass would be a no-op
+            skipPass |= count == nbElts;
+            counts[p][d] = sum;
+            sum += count;
+        }
+        if (skipPass) {
+            continue;
+        }
+        for (size_t i = 0; i < nbElts; ++i) {
+            uint64_t const entry = entries[i];
+            size_t const d =
+                    (entry >> shift) & (ZS_TOKENIZE_RADIX_SIZE - 1);
+            tmp[counts[p][d]++] = entry;
+        }
+        uint64_t* const sorted = tmp;
+        tmp                    = entries;
+        entries                = sorted;
+    }
+
+    size_t nbDistinct = 0;
+    for (size_t i = 0; i < nbElts; ++i) {
+        nbDistinct += i == 0 || (entries[i] >> 32) != (entries[i - 1] >> 32);
+    }
+    *alphabetSize = nbDistinct;
+    return entries;
+}
+
+ZL_FORCE_INLINE void tokenizeRadix_write_impl(
+        void* alphabet,
+        void* indices,
+        size_t idxWidth,
+        uint64_t const* entries,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue)
+{
+    uint8_t* const alphabet8 = (uint8_t*)alphabet;
+    uint8_t* const indices8  = (uint8_t*)indices;
+    if (nbElts == 0) {
+        return;
+    }
+    uint64_t prevValue = entries[0] >> 32;
+    size_t index       = 0;
+    ZL_writeN(alphabet8, minValue + prevValue, eltWidth);
+    for (size_t i = 0; i < nbElts; ++i) {
+        uint64_t const value = entries[i] >> 32;
+        if (value != prevValue) {
+            ++index;
+            ZL_writeN(alphabet8 + index * eltWidth, minValue + value, eltWidth);
+            prevValue = value;
+        }
+        size_t const pos = (uint32_t)entries[i];
+        ZL_writeN(indices8 + pos * idxWidth, index, idxWidth);
+    }
+}
+
+void ZS_tokenizeRadix_write(
+        void* alphabet,
+        void* indices,
+        size_t idxWidth,
+        uint64_t const* entries,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue)
+{
+    switch (idxWidth) {
+        case 1:
+            tokenizeRadix_write_impl(
+                    alphabet, indices, 1, entries, nbElts, eltWidth, minValue);
+            break;
+        case 2:
+            tokenizeRadix_write_impl(
+                    alphabet, indices, 2, entries, nbElts, eltWidth, minValue);
+            break;
+        default:
+            tokenizeRadix_write_impl(
+                    alphabet,
+                    indices,
+                    idxWidth,
+                    entries,
+                    nbElts,
+                    eltWidth,
+                    minValue);
+            break;
+    }
+}
@@ -5,6 +5,45 @@
 
 #include "openzl/codecs/tokenize/encode_tokenize_kernel.h"
 
+ZL_BEGIN_C_DECLS
+
 void pqdsortVsf(VSFKey* data, size_t nbElts);
 
+/* Radix-sort-based tokenization of numeric inputs, for sorted alphabets.
+ * Each element is packed into a 64-bit entry (value - minValue) << 32 | pos,
+ * and the entries are sorted with an LSD radix sort on the value bits.
+ * The sorted alphabet and the indices are then produced in a single pass
+ * over the sorted entries, without any hash map.
+ * Requires (maxValue - minValue) <= UINT32_MAX and nbElts <= UINT32_MAX.
+ */
+
+/// @returns the workspace size, in bytes, needed by ZS_tokenizeRadix_sort()
+size_t ZS_tokenizeRadix_wkspSize(size_t nbElts);
+
+/// Sorts the entries of @p src.
+/// @p workspace must be at least ZS_tokenizeRadix_wkspSize(nbElts) bytes,
+/// and aligned for uint64_t.
+/// @returns the sorted entries, which point into @p workspace.
+/// @p alphabetSize is set to the number of distinct values.
+uint64_t const* ZS_tokenizeRadix_sort(
+        size_t* alphabetSize,
+        void const* src,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue,
+        uint64_t maxValue,
+        void* workspace);
+
+/// Writes the sorted alphabet and the indices from the sorted @p entries.
+void ZS_tokenizeRadix_write(
+        void* alphabet,
+        void* indices,
+        size_t idxWidth,
+        uint64_t const* entries,
+        size_t nbElts,
+        size_t eltWidth,
+        uint64_t minValue);
+
+ZL_END_C_DECLS
+
 #endif
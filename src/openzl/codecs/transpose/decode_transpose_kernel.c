@@ -5,6 +5,7 @@
 #include <assert.h>
 #include <string.h>
 
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/portability.h"
 #include "openzl/shared/utils.h"
 
@@ -91,13 +92,15 @@ static ZL_TRANSPOSE_DEC_NOINLINE void ZS_splitTransposeDecode_generic(
     ZS_splitTransposeDecode_impl(dst, src, nbElts, eltWidth);
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
 
 #    include <immintrin.h>
 #    if defined(__clang__) && defined(ZS_ENABLE_CLANG_PRAGMA)
 #        define ZS_PRAGMA_VECTORIZE
 #    endif
 
+ZL_TARGET_AVX2_BEGIN
+
 /// Optimized version for 2 byte transpose with AVX2
 static ZL_TRANSPOSE_DEC_NOINLINE void ZS_splitTransposeDecode_2_avx2(
         uint8_t* restrict dst,
@@ -284,7 +287,9 @@ static ZL_TRANSPOSE_DEC_NOINLINE void ZS_splitTransposeDecode_8_avx2(
     }
 }
 
-#endif // ZL_HAS_AVX2
+ZL_TARGET_END
+
+#endif // ZL_CAN_AVX2
 
 void ZS_splitTransposeDecode(
         void* dst,
@@ -292,25 +297,27 @@ void ZS_splitTransposeDecode(
         size_t nbElts,
         size_t eltWidth)
 {
-// TODO: Get the cpuid from the zstrong decoder context.
-#if ZL_HAS_AVX2
-    switch (eltWidth) {
-        case 1:
-            memcpy(dst, src[0], nbElts);
-            break;
-        case 2:
-            ZS_splitTransposeDecode_2_avx2(dst, src, nbElts);
-            break;
-        case 4:
-            ZS_splitTransposeDecode_4_avx2(dst, src, nbElts);
-            break;
-        case 8:
-            ZS_splitTransposeDecode_8_avx2((uint64_t*)dst, src, nbElts);
-            break;
-        default:
-            ZS_splitTransposeDecode_generic(dst, src, nbElts, eltWidth);
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        switch (eltWidth) {
+            case 1:
+                memcpy(dst, src[0], nbElts);
+                break;
+            case 2:
+                ZS_splitTransposeDecode_2_avx2(dst, src, nbElts);
+                break;
+            case 4:
+                ZS_splitTransposeDecode_4_avx2(dst, src, nbElts);
+                break;
+            case 8:
+                ZS_splitTransposeDecode_8_avx2((uint64_t*)dst, src, nbElts);
+                break;
+            default:
+                ZS_splitTransposeDecode_generic(dst, src, nbElts, eltWidth);
+        }
+        return;
     }
-#else
+#endif
     switch (eltWidth) {
         case 1:
             memcpy(dst, src[0], nbElts);
@@ -327,7 +334,6 @@ void ZS_splitTransposeDecode(
         default:
             ZS_splitTransposeDecode_generic(dst, src, nbElts, eltWidth);
     }
-#endif
 }
 
 #if 0
@@ -9,10 +9,6 @@
 #include "openzl/zl_graph_api.h"
 #include "openzl/zl_selector_declare_helper.h"
 
-#include <stdio.h>
-#include <time.h>
-static double EI_transpose_split_time_ms = 0.0;
-
 // EI_transpose design notes:
 // - Accepts a single stream of type ZL_Type_struct
 // - Generates a single stream of type ZL_Type_struct of same size as input
@@ -46,8 +42,6 @@ ZL_Report EI_transpose(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 ZL_Report
 EI_transpose_split(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
     ZL_ASSERT_NN(eictx);
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
@@ -81,13 +75,7 @@ EI_transpose_split(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
     }
 
     ZS_splitTransposeEncode(outPtrs, src, nbElts, eltWidth);
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
 
-    double current_duration = end_time_ms - start_time_ms;
-    EI_transpose_split_time_ms += current_duration;
-    fprintf(stderr, "[EI_transpose_split] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_transpose_split_time_ms, current_duration);
     return ZL_returnSuccess();
 }
 
@@ -5,6 +5,7 @@
 
 #include "encode_transpose_kernel.h"
 
+#include "openzl/shared/cpu.h"
 #include "openzl/shared/portability.h"
 
 // Local noinline attribute for encode_transpose_kernel
@@ -106,9 +107,11 @@ static ZL_TRANSPOSE_ENC_NOINLINE void ZS_splitTransposeEncode_generic(
     ZS_splitTransposeEncode_impl(dst, src, nbElts, eltWidth);
 }
 
-#if ZL_HAS_AVX2
+#if ZL_CAN_AVX2
 #    include <immintrin.h>
 
+ZL_TARGET_AVX2_BEGIN
+
 // ========================================
 // AVX2 Transpose Split 2 - Implementation
 // ========================================
@@ -467,7 +470,9 @@ ZL_FORCE_NOINLINE void ZS_splitTransposeEncode_8_avx2(
     }
 }
 
-#endif // ZL_HAS_AVX2
+ZL_TARGET_END
+
+#endif // ZL_CAN_AVX2
 
 void ZS_splitTransposeEncode(
         uint8_t** dst,
@@ -475,25 +480,28 @@ void ZS_splitTransposeEncode(
         size_t const nbElts,
         size_t const eltWidth)
 {
-#if ZL_HAS_AVX2
-    switch (eltWidth) {
-        case 1:
-            memcpy(dst[0], src, nbElts);
-            break;
-        case 2:
-            ZS_splitTransposeEncode_2_avx2(dst, src, nbElts);
-            break;
-        case 4:
-            ZS_splitTransposeEncode_4_avx2(dst, src, nbElts);
-            break;
-        case 8:
-            ZS_splitTransposeEncode_8_avx2(dst, src, nbElts);
-            break;
-        default:
-            ZS_splitTransposeEncode_generic(dst, src, nbElts, eltWidth);
-            break;
+#if ZL_CAN_AVX2
+    if (ZL_cpuHas(ZL_CpuFeature_avx2)) {
+        switch (eltWidth) {
+            case 1:
+                memcpy(dst[0], src, nbElts);
+                break;
+            case 2:
+                ZS_splitTransposeEncode_2_avx2(dst, src, nbElts);
+                break;
+            case 4:
+                ZS_splitTransposeEncode_4_avx2(dst, src, nbElts);
+                break;
+            case 8:
+                ZS_splitTransposeEncode_8_avx2(dst, src, nbElts);
+                break;
+            default:
+                ZS_splitTransposeEncode_generic(dst, src, nbElts, eltWidth);
+                break;
+        }
+        return;
     }
-#else
+#endif // ZL_CAN_AVX2
     switch (eltWidth) {
         case 1:
             memcpy(dst[0], src, nbElts);
@@ -511,5 +519,4 @@ void ZS_splitTransposeEncode(
             ZS_splitTransposeEncode_generic(dst, src, nbElts, eltWidth);
             break;
     }
-#endif // ZL_HAS_AVX2
 }
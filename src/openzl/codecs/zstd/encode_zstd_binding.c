@@ -12,10 +12,6 @@
 #endif
 #include <zstd.h>
 
-#include <stdio.h>
-#include <time.h>
-static double EI_zstd_time_ms = 0.0;
-
 /// Determines if we should cut blocks for each element.
 /// E.g. if the input is transposed.
 static bool EI_zstd_shouldCutBlocks(ZL_Input const* in)
@@ -159,26 +155,12 @@ void EIZSTD_freeCCtx(void* state)
 
 ZL_Report EI_zstd(ZL_Encoder* eictx, const ZL_Input* ins[], size_t nbIns)
 {
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
-
     ZL_ASSERT_EQ(nbIns, 1);
     ZL_ASSERT_NN(ins);
     const ZL_Input* in    = ins[0];
     ZSTD_CCtx* const cctx = ZL_Encoder_getState(eictx);
     ZL_RET_R_IF_NULL(allocation, cctx);
-    ZL_Report EI_zstd_report = EI_zstdWithCCtx(eictx, cctx, in);
-
-    clock_gettime(CLOCK_MONOTONIC, &end);
-
-    clock_gettime(CLOCK_MONOTONIC, &end);
-    double start_time_ms = (double)start.tv_sec * 1000.0 + (double)start.tv_nsec / 1000000.0;
-    double end_time_ms = (double)end.tv_sec * 1000.0 + (double)end.tv_nsec / 1000000.0;
-
-    double current_duration = end_time_ms - start_time_ms;
-    EI_zstd_time_ms += current_duration;
-    fprintf(stderr, "[EI_zstd] Start: %.4f ms | End: %.4f ms | Accumulated: %.4f ms | Current_duration: %.4f\n", start_time_ms, end_time_ms, EI_zstd_time_ms, current_duration);
-    return EI_zstd_report;
+    return EI_zstdWithCCtx(eictx, cctx, in);
 }
 
 ZL_GraphID ZL_Compressor_registerZstdGraph_withLevel(
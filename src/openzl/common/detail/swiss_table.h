@@ -0,0 +1,589 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_COMMON_DETAIL_SWISS_TABLE_H
+#define ZSTRONG_COMMON_DETAIL_SWISS_TABLE_H
+
+// Only meant to be included by table.h, which provides
+// GenericTable_Policy, GenericTable_Insert and the ZL_TABLE_* attributes.
+
+#if ZL_ARCH_X86_64 || defined(__SSE2__)
+#    include <emmintrin.h>
+#    define ZL_SWISS_SSE2 1
+#elif ZL_ARCH_ARM64 && defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define ZL_SWISS_NEON 1
+#endif
+#ifndef ZL_SWISS_SSE2
+#    define ZL_SWISS_SSE2 0
+#endif
+#ifndef ZL_SWISS_NEON
+#    define ZL_SWISS_NEON 0
+#endif
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * SwissTable is an open-addressing implementation of the table, in the style
+ * of Abseil's flat_hash_map. Slots are organized in groups of 16, and each
+ * slot has a control byte, which is either empty, deleted (a tombstone), or
+ * holds the 7 low bits of the hash of its entry. A lookup compares the control
+ * bytes of a whole group against the hash at once (SSE2 or NEON), and only
+ * calls the equality function on matches, so most probes touch a single cache
+ * line of control bytes and a single slot.
+ *
+ * The high bits of the hash select the first group, and groups are then
+ * probed triangularly. Probing stops at the first group containing an empty
+ * slot. Erasing from a group without any empty slot leaves a tombstone, and
+ * tombstones are purged by rehashing in place once they would push the
+ * occupancy beyond 7/8.
+ *
+ * The table is sized so that its capacity is at most 3/4 of its slots. When
+ * allocations must be avoided, a spare block of the same size is kept for
+ * purging tombstones.
+ */
+
+#define ZL_SWISS_GROUP_SIZE 16
+#define ZL_SWISS_MIN_SLOTS ZL_SWISS_GROUP_SIZE
+#define ZL_SWISS_CTRL_EMPTY ((uint8_t)0x80)
+#define ZL_SWISS_CTRL_DELETED ((uint8_t)0xFE)
+
+typedef struct {
+    /// nbSlots entries, followed by nbSlots control bytes
+    uint8_t* table;
+    uint8_t* ctrl;
+    /// Same-sized block used to purge tombstones without allocating
+    uint8_t* spare;
+    /// nbSlots == 0 means the table is not allocated
+    uint32_t nbSlots;
+    uint32_t groupMask;
+    uint32_t size;
+    uint32_t nbDeleted;
+    /// Inserting into an empty slot requires size + nbDeleted < growthLimit
+    uint32_t growthLimit;
+    uint32_t capacity;
+    uint32_t maxCapacity;
+    Arena* arena;
+} SwissTable;
+
+typedef struct {
+    SwissTable const* table;
+    void* slot;
+    uint32_t index;
+} SwissTable_Iter;
+
+typedef GenericTable_Insert SwissTable_Insert;
+
+typedef bool (*SwissTable_OutlinedReserve)(SwissTable*, uint32_t);
+
+/* -------------------------------------------------------------------------
+ * Group matching
+ *
+ * Matches are returned as a bitmask with one set bit per matching slot,
+ * where slot i is represented by bit (i << ZL_SWISS_LANE_SHIFT).
+ * ------------------------------------------------------------------------- */
+
+typedef uint64_t SwissTable_Mask;
+
+#if ZL_SWISS_NEON
+#    define ZL_SWISS_LANE_SHIFT 2
+#else
+#    define ZL_SWISS_LANE_SHIFT 0
+#endif
+
+#if ZL_SWISS_NEON
+ZL_TABLE_FORCE_INLINE SwissTable_Mask SwissTable_neonMask(uint8x16_t matches)
+{
+    // Narrowing shift keeps 4 bits per byte
+    uint8x8_t const nibbles =
+            vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0)
+            & 0x8888888888888888ULL;
+}
+#endif
+
+ZL_TABLE_FORCE_INLINE SwissTable_Mask
+SwissTable_matchByte(uint8_t const* ctrl, uint8_t byte)
+{
+#if ZL_SWISS_SSE2
+    __m128i const group = _mm_loadu_si128((__m128i const*)(void const*)ctrl);
+    __m128i const match = _mm_cmpeq_epi8(group, _mm_set1_epi8((char)byte));
+    return (uint32_t)_mm_movemask_epi8(match);
+#elif ZL_SWISS_NEON
+    return SwissTable_neonMask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(byte)));
+#else
+    SwissTable_Mask mask = 0;
+    for (size_t i = 0; i < ZL_SWISS_GROUP_SIZE; ++i) {
+        mask |= (SwissTable_Mask)(ctrl[i] == byte) << i;
+    }
+    return mask;
+#endif
+}
+
+/// Matches empty and deleted slots, whose control bytes have the high bit set
+ZL_TABLE_FORCE_INLINE SwissTable_Mask
+SwissTable_matchEmptyOrDeleted(uint8_t const* ctrl)
+{
+#if ZL_SWISS_SSE2
+    __m128i const group = _mm_loadu_si128((__m128i const*)(void const*)ctrl);
+    return (uint32_t)_mm_movemask_epi8(group);
+#elif ZL_SWISS_NEON
+    return SwissTable_neonMask(
+            vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl))));
+#else
+    SwissTable_Mask mask = 0;
+    for (size_t i = 0; i < ZL_SWISS_GROUP_SIZE; ++i) {
+        mask |= (SwissTable_Mask)(ctrl[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+ZL_TABLE_FORCE_INLINE uint32_t SwissTable_lowestLane(SwissTable_Mask mask)
+{
+    ZL_ASSERT_NE(mask, 0);
+    return (uint32_t)ZL_ctz64(mask) >> ZL_SWISS_LANE_SHIFT;
+}
+
+ZL_TABLE_FORCE_INLINE bool SwissTable_isFull(uint8_t ctrl)
+{
+    return ctrl < ZL_SWISS_CTRL_EMPTY;
+}
+
+/**
+ * @returns the hash of @p key. Both the low bits (control byte) and the high
+ * bits (group) are used, so the hash function must mix all of its input bits,
+ * which both the default hash and XXH3 do.
+ */
+ZL_TABLE_FORCE_INLINE size_t
+SwissTable_hash(void const* key, GenericTable_Policy const kPolicy)
+{
+    return kPolicy.hashFn(key);
+}
+
+/// Selects the first group to probe
+ZL_TABLE_FORCE_INLINE size_t SwissTable_h1(size_t hash)
+{
+    return hash >> 7;
+}
+
+/// Stored in the control byte
+ZL_TABLE_FORCE_INLINE uint8_t SwissTable_h2(size_t hash)
+{
+    return (uint8_t)(hash & 0x7F);
+}
+
+/* -------------------------------------------------------------------------
+ * Memory management
+ * ------------------------------------------------------------------------- */
+
+ZL_TABLE_INLINE uint8_t* SwissTable_allocMem(SwissTable* table, size_t size)
+{
+    if (table->arena != NULL) {
+        return (uint8_t*)ALLOC_Arena_malloc(table->arena, size);
+    } else {
+        return (uint8_t*)ZL_malloc(size);
+    }
+}
+
+ZL_TABLE_INLINE void SwissTable_freeMem(SwissTable* table, uint8_t* ptr)
+{
+    if (table->arena != NULL) {
+        ALLOC_Arena_free(table->arena, ptr);
+    } else {
+        ZL_free(ptr);
+    }
+}
+
+/// @returns the offset of the control bytes within a block
+ZL_TABLE_INLINE size_t SwissTable_ctrlOffset(uint32_t nbSlots, size_t entrySize)
+{
+    size_t const slotsSize = (size_t)nbSlots * entrySize;
+    return (slotsSize + ZL_SWISS_GROUP_SIZE - 1)
+            & ~(size_t)(ZL_SWISS_GROUP_SIZE - 1);
+}
+
+/// @returns a block for @p nbSlots slots, or NULL on failure
+ZL_TABLE_INLINE uint8_t*
+SwissTable_allocBlock(SwissTable* table, uint32_t nbSlots, size_t entrySize)
+{
+    size_t slotsSize;
+    if (ZL_overflowMulST(nbSlots, entrySize, &slotsSize)
+        || slotsSize > SIZE_MAX - 2 * (size_t)nbSlots) {
+        return NULL;
+    }
+    size_t const ctrlOffset = SwissTable_ctrlOffset(nbSlots, entrySize);
+    return SwissTable_allocMem(table, ctrlOffset + nbSlots);
+}
+
+/// @returns the number of slots needed to hold @p capacity entries
+ZL_TABLE_INLINE uint32_t SwissTable_nbSlotsFor(uint32_t capacity)
+{
+    uint64_t const minSlots = ((uint64_t)capacity * 4 + 2) / 3;
+    uint32_t const nbSlots  = (uint32_t)1 << ZL_nextPow2(minSlots);
+    return ZL_MAX(nbSlots, ZL_SWISS_MIN_SLOTS);
+}
+
+/* -------------------------------------------------------------------------
+ * Table operations
+ * ------------------------------------------------------------------------- */
+
+ZL_TABLE_INLINE void
+SwissTable_init(SwissTable* table, Arena* arena, uint32_t maxCapacity)
+{
+    memset(table, 0, sizeof(*table));
+    ZL_ASSERT_LE(maxCapacity, ZL_TABLE_MAX_CAPACITY);
+    table->maxCapacity = ZL_MIN(maxCapacity, ZL_TABLE_MAX_CAPACITY);
+    table->arena       = arena;
+}
+
+ZL_TABLE_INLINE SwissTable SwissTable_create(Arena* arena, uint32_t maxCapacity)
+{
+    SwissTable table;
+    SwissTable_init(&table, arena, maxCapacity);
+    return table;
+}
+
+ZL_TABLE_INLINE void SwissTable_destroy(SwissTable* table)
+{
+    SwissTable_freeMem(table, table->table);
+    SwissTable_freeMem(table, table->spare);
+    memset(table, 0, sizeof(*table));
+}
+
+ZL_TABLE_INLINE size_t SwissTable_capacity(SwissTable const* table)
+{
+    return table->capacity;
+}
+
+ZL_TABLE_INLINE size_t SwissTable_maxCapacity(SwissTable const* table)
+{
+    return table->maxCapacity;
+}
+
+ZL_TABLE_INLINE size_t SwissTable_size(SwissTable const* table)
+{
+    return table->size;
+}
+
+ZL_TABLE_INLINE void SwissTable_clear(
+        SwissTable* table,
+        GenericTable_Policy const kPolicy)
+{
+    (void)kPolicy;
+    if (table->nbSlots != 0) {
+        memset(table->ctrl, ZL_SWISS_CTRL_EMPTY, table->nbSlots);
+    }
+    table->size      = 0;
+    table->nbDeleted = 0;
+}
+
+ZL_TABLE_FORCE_INLINE void* SwissTable_getSlot(
+        SwissTable const* table,
+        size_t idx,
+        GenericTable_Policy const kPolicy)
+{
+    ZL_ASSERT_LT(idx, table->nbSlots);
+    return table->table + idx * kPolicy.kEntrySize;
+}
+
+ZL_TABLE_FORCE_INLINE void* SwissTable_find(
+        SwissTable const* table,
+        void const* key,
+        GenericTable_Policy const kPolicy)
+{
+    ZL_ASSERT_NN(key);
+    if (table->nbSlots == 0) {
+        return NULL;
+    }
+    size_t const hash = SwissTable_hash(key, kPolicy);
+    uint8_t const h2  = SwissTable_h2(hash);
+    size_t group      = SwissTable_h1(hash) & table->groupMask;
+    for (size_t step = 1;; ++step) {
+        uint8_t const* const ctrl = table->ctrl + group * ZL_SWISS_GROUP_SIZE;
+        SwissTable_Mask match     = SwissTable_matchByte(ctrl, h2);
+        for (; match != 0; match &= match - 1) {
+            size_t const idx = group * ZL_SWISS_GROUP_SIZE
+                    + SwissTable_lowestLane(match);
+            void* const slot = SwissTable_getSlot(table, idx, kPolicy);
+            if (kPolicy.eqFn(key, slot)) {
+                return slot;
+            }
+        }
+        if (ZL_LIKELY(SwissTable_matchByte(ctrl, ZL_SWISS_CTRL_EMPTY) != 0)) {
+            return NULL;
+        }
+        ZL_ASSERT_LE(step, table->groupMask, "Table must have empty slots");
+        group = (group + step) & table->groupMask;
+    }
+}
+
+/// @returns the index of the first empty or deleted slot on the probe
+/// sequence of @p hash.
+ZL_TABLE_FORCE_INLINE size_t SwissTable_findFreeSlot(
+        uint8_t const* ctrlBase,
+        uint32_t groupMask,
+        size_t hash)
+{
+    size_t group = SwissTable_h1(hash) & groupMask;
+    for (size_t step = 1;; ++step) {
+        uint8_t const* const ctrl = ctrlBase + group * ZL_SWISS_GROUP_SIZE;
+        SwissTable_Mask const freeSlots = SwissTable_matchEmptyOrDeleted(ctrl);
+        if (ZL_LIKELY(freeSlots != 0)) {
+            return group * ZL_SWISS_GROUP_SIZE
+                    + SwissTable_lowestLane(freeSlots);
+        }
+        ZL_ASSERT_LE(step, groupMask, "Table must have empty slots");
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * Moves all the entries of @p table into @p newBlock, which has room for
+ * @p newNbSlots slots. Tombstones are dropped.
+ */
+ZL_TABLE_FORCE_INLINE void SwissTable_moveInto(
+        SwissTable const* table,
+        uint8_t* newBlock,
+        uint32_t newNbSlots,
+        GenericTable_Policy const kPolicy)
+{
+    uint8_t* const newCtrl =
+            newBlock + SwissTable_ctrlOffset(newNbSlots, kPolicy.kEntrySize);
+    uint32_t const newGroupMask = newNbSlots / ZL_SWISS_GROUP_SIZE - 1;
+    memset(newCtrl, ZL_SWISS_CTRL_EMPTY, newNbSlots);
+    for (size_t idx = 0; idx < table->nbSlots; ++idx) {
+        if (!SwissTable_isFull(table->ctrl[idx])) {
+            continue;
+        }
+        void const* const slot = SwissTable_getSlot(table, idx, kPolicy);
+        size_t const hash      = SwissTable_hash(slot, kPolicy);
+        size_t const newIdx =
+                SwissTable_findFreeSlot(newCtrl, newGroupMask, hash);
+        newCtrl[newIdx] = SwissTable_h2(hash);
+        memcpy(newBlock + newIdx * kPolicy.kEntrySize,
+               slot,
+               kPolicy.kEntrySize);
+    }
+}
+
+ZL_TABLE_INLINE void SwissTable_setBlock(
+        SwissTable* table,
+        uint8_t* block,
+        uint32_t nbSlots,
+        size_t entrySize)
+{
+    table->table       = block;
+    table->ctrl        = block + SwissTable_ctrlOffset(nbSlots, entrySize);
+    table->nbSlots     = nbSlots;
+    table->groupMask   = nbSlots / ZL_SWISS_GROUP_SIZE - 1;
+    table->nbDeleted   = 0;
+    table->growthLimit = nbSlots - nbSlots / 8;
+}
+
+/**
+ * Rehashes the table into @p newNbSlots slots, which may be the current
+ * number of slots to purge tombstones.
+ * @returns false on allocation failure, leaving the table untouched
+ */
+ZL_TABLE_FORCE_INLINE bool SwissTable_rehash(
+        SwissTable* table,
+        uint32_t newNbSlots,
+        bool guaranteeNoAllocations,
+        GenericTable_Policy const kPolicy)
+{
+    size_t const entrySize = kPolicy.kEntrySize;
+    if (newNbSlots == table->nbSlots && table->spare != NULL) {
+        // Purge through the spare block, then copy back,
+        // so that neither block changes.
+        size_t const blockSize =
+                SwissTable_ctrlOffset(newNbSlots, entrySize) + newNbSlots;
+        SwissTable_moveInto(table, table->spare, newNbSlots, kPolicy);
+        memcpy(table->table, table->spare, blockSize);
+        table->nbDeleted = 0;
+        return true;
+    }
+
+    bool const keepSpare = guaranteeNoAllocations || table->spare != NULL;
+    uint8_t* const newBlock =
+            SwissTable_allocBlock(table, newNbSlots, entrySize);
+    if (newBlock == NULL) {
+        return false;
+    }
+    uint8_t* newSpare = NULL;
+    if (keepSpare) {
+        newSpare = SwissTable_allocBlock(table, newNbSlots, entrySize);
+        if (newSpare == NULL) {
+            SwissTable_freeMem(table, newBlock);
+            return false;
+        }
+    }
+
+    SwissTable_moveInto(table, newBlock, newNbSlots, kPolicy);
+    SwissTable_freeMem(table, table->table);
+    SwissTable_freeMem(table, table->spare);
+    table->spare = newSpare;
+    SwissTable_setBlock(table, newBlock, newNbSlots, entrySize);
+    return true;
+}
+
+ZL_TABLE_FORCE_INLINE bool SwissTable_reserve(
+        SwissTable* table,
+        uint32_t capacity,
+        bool guaranteeNoAllocations,
+        GenericTable_Policy const kPolicy)
+{
+    ZL_ASSERT_LE(table->maxCapacity, ZL_TABLE_MAX_CAPACITY);
+    if (capacity <= table->capacity) {
+        if (table->nbSlots == 0) {
+            // Nothing is allocated, and nothing needs to be
+            return true;
+        }
+        bool const needsSpare = guaranteeNoAllocations && table->spare == NULL;
+        bool const needsPurge =
+                table->size + table->nbDeleted >= table->growthLimit;
+        if (!needsSpare && !needsPurge) {
+            return true;
+        }
+        return SwissTable_rehash(
+                table, table->nbSlots, guaranteeNoAllocations, kPolicy);
+    }
+    if (capacity > table->maxCapacity) {
+        return false;
+    }
+
+    uint32_t const newCapacity = ZL_MAX(
+            capacity,
+            GenericTable_nextCapacity(
+                    table->capacity, table->maxCapacity, /* pow2 */ true));
+    uint32_t const newNbSlots = SwissTable_nbSlotsFor(newCapacity);
+    ZL_ASSERT_GE(newNbSlots, table->nbSlots);
+    bool const needsRehash = newNbSlots != table->nbSlots
+            || table->size + table->nbDeleted >= table->growthLimit
+            || (guaranteeNoAllocations && table->spare == NULL);
+    if (needsRehash
+        && !SwissTable_rehash(
+                table, newNbSlots, guaranteeNoAllocations, kPolicy)) {
+        return false;
+    }
+    table->capacity = newCapacity;
+    return true;
+}
+
+ZL_TABLE_FORCE_INLINE SwissTable_Insert SwissTable_insert(
+        SwissTable* table,
+        void const* entry,
+        GenericTable_Policy const kPolicy,
+        SwissTable_OutlinedReserve const outlinedReserveFn)
+{
+    ZL_ASSERT_NN(entry);
+    ZL_ASSERT_LE(table->size, table->capacity);
+    if (ZL_UNLIKELY(
+                table->size == table->capacity
+                || table->size + table->nbDeleted >= table->growthLimit)) {
+        // Grows the table, or purges its tombstones
+        if (!outlinedReserveFn(table, table->size + 1)) {
+            return (SwissTable_Insert){ NULL, false, true };
+        }
+    }
+    size_t const hash = SwissTable_hash(entry, kPolicy);
+    uint8_t const h2  = SwissTable_h2(hash);
+    size_t group      = SwissTable_h1(hash) & table->groupMask;
+    for (size_t step = 1;; ++step) {
+        uint8_t const* const ctrl = table->ctrl + group * ZL_SWISS_GROUP_SIZE;
+        SwissTable_Mask match     = SwissTable_matchByte(ctrl, h2);
+        for (; match != 0; match &= match - 1) {
+            size_t const idx = group * ZL_SWISS_GROUP_SIZE
+                    + SwissTable_lowestLane(match);
+            void* const slot = SwissTable_getSlot(table, idx, kPolicy);
+            if (kPolicy.eqFn(entry, slot)) {
+                return (SwissTable_Insert){ slot, false, false };
+            }
+        }
+        if (ZL_LIKELY(SwissTable_matchByte(ctrl, ZL_SWISS_CTRL_EMPTY) != 0)) {
+            break;
+        }
+        ZL_ASSERT_LE(step, table->groupMask, "Table must have empty slots");
+        group = (group + step) & table->groupMask;
+    }
+
+    // Not present: take the first free slot of the probe sequence,
+    // which may precede the group where the search ended.
+    size_t const idx =
+            SwissTable_findFreeSlot(table->ctrl, table->groupMask, hash);
+    if (table->ctrl[idx] == ZL_SWISS_CTRL_DELETED) {
+        --table->nbDeleted;
+    }
+    table->ctrl[idx] = h2;
+    ++table->size;
+    void* const slot = SwissTable_getSlot(table, idx, kPolicy);
+    memcpy(slot, entry, kPolicy.kEntrySize);
+    return (SwissTable_Insert){ slot, true, false };
+}
+
+ZL_TABLE_FORCE_INLINE bool SwissTable_erase(
+        SwissTable* table,
+        void const* key,
+        GenericTable_Policy const kPolicy)
+{
+    void* const slot = SwissTable_find(table, key, kPolicy);
+    if (slot == NULL) {
+        return false;
+    }
+    size_t const idx =
+            (size_t)((uint8_t*)slot - table->table) / kPolicy.kEntrySize;
+    uint8_t const* const groupCtrl =
+            table->ctrl + (idx & ~(size_t)(ZL_SWISS_GROUP_SIZE - 1));
+    // If the group has an empty slot, no probe sequence went past it,
+    // so the slot can be emptied rather than marked as deleted.
+    if (SwissTable_matchByte(groupCtrl, ZL_SWISS_CTRL_EMPTY) != 0) {
+        table->ctrl[idx] = ZL_SWISS_CTRL_EMPTY;
+    } else {
+        table->ctrl[idx] = ZL_SWISS_CTRL_DELETED;
+        ++table->nbDeleted;
+    }
+    --table->size;
+    return true;
+}
+
+ZL_TABLE_INLINE void SwissTable_Iter_skipToFullSlot(
+        SwissTable_Iter* iter,
+        GenericTable_Policy const kPolicy)
+{
+    SwissTable const* const table = iter->table;
+    while (iter->index < table->nbSlots
+           && !SwissTable_isFull(table->ctrl[iter->index])) {
+        ++iter->index;
+    }
+    iter->slot = iter->index < table->nbSlots
+            ? SwissTable_getSlot(table, iter->index, kPolicy)
+            : NULL;
+}
+
+ZL_TABLE_INLINE SwissTable_Iter
+SwissTable_iter(SwissTable const* table, GenericTable_Policy const kPolicy)
+{
+    SwissTable_Iter iter = { table, NULL, 0 };
+    SwissTable_Iter_skipToFullSlot(&iter, kPolicy);
+    return iter;
+}
+
+ZL_TABLE_FORCE_INLINE void* SwissTable_Iter_get(SwissTable_Iter iter)
+{
+    return iter.slot;
+}
+
+ZL_TABLE_INLINE void* SwissTable_Iter_next(
+        SwissTable_Iter* iter,
+        GenericTable_Policy const kPolicy)
+{
+    void* const result = iter->slot;
+    if (result != NULL) {
+        ++iter->index;
+        SwissTable_Iter_skipToFullSlot(iter, kPolicy);
+    }
+    return result;
+}
+
+ZL_END_C_DECLS
+
+#endif
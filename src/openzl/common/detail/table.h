@@ -16,21 +16,23 @@
 ZL_BEGIN_C_DECLS
 
 /**
- * The table is implemented through a type erased GenericTable implementation.
+ * The table is implemented through a type erased implementation.
  * This gets wrapped by the type-safe API generated by macros for each table.
  * The macros generate a static constant GenericTable_Policy that configures the
- * GenericTable for its types and hash/equality functions.
+ * implementation for its types and hash/equality functions.
  *
- * All of the GenericTable functions are "templated" on the constant policy, and
- * are meant to be inlined so that they can do constant propagation on the
+ * All of the implementation functions are "templated" on the constant policy,
+ * and are meant to be inlined so that they can do constant propagation on the
  * policy.
  *
- * The GenericTable is implemented via separate chaining, but with the first
- * element in the chain inlined into the table. This allows fast operations when
- * the load factor is low, and collisions are rare. This is a tradeoff of memory
- * for simplicity and speed, since this table runs with a load factor of 0.5.
- * Later down the line we can re-evaluate this tradeoff, and see if we want to
- * change the implementation.
+ * Two implementations share the same interface:
+ * - SwissTable (see swiss_table.h) is an open-addressing table, probing 16
+ *   control bytes at a time. It is the implementation used by
+ *   ZL_DECLARE_TABLE(), and thus by all maps and sets.
+ * - GenericTable is implemented via separate chaining, but with the first
+ *   element in the chain inlined into the table. It runs with a load factor of
+ *   0.5. It is kept as a baseline for benchmarks, and can be selected through
+ *   ZL_DECLARE_TABLE_WITH_IMPL().
  */
 
 // Attribute for all table functions in the public API
@@ -49,11 +51,53 @@ ZL_BEGIN_C_DECLS
 #    define ZL_TABLE_MEMCMP memcmp
 #endif
 
-/// Make Table_-typed tables call a default (XXH3-backed) hash function.
+/// Hash of an integer key, using the 64-bit finalizer of MurmurHash3. Every
+/// bit of the result depends on all the bits of @p key, which matters because
+/// SwissTable takes its control byte from the low bits: keys differing only in
+/// their high bits (e.g. doubles holding small integers) must still spread.
+ZL_TABLE_FORCE_INLINE size_t ZL_Table_hashInt(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ULL;
+    key ^= key >> 33;
+    return (size_t)key;
+}
+
+/// Hashes the @p keySize bytes of @p key. Keys of 1, 2, 4 or 8 bytes are
+/// hashed as integers, which is much cheaper than XXH3 for such short inputs.
+ZL_TABLE_FORCE_INLINE size_t ZL_Table_hashBytes(void const* key, size_t keySize)
+{
+    switch (keySize) {
+        case 1:
+            return ZL_Table_hashInt(*(uint8_t const*)key);
+        case 2: {
+            uint16_t k;
+            memcpy(&k, key, sizeof(k));
+            return ZL_Table_hashInt(k);
+        }
+        case 4: {
+            uint32_t k;
+            memcpy(&k, key, sizeof(k));
+            return ZL_Table_hashInt(k);
+        }
+        case 8: {
+            uint64_t k;
+            memcpy(&k, key, sizeof(k));
+            return ZL_Table_hashInt(k);
+        }
+        default:
+            return (size_t)XXH3_64bits(key, keySize);
+    }
+}
+
+/// Make Table_-typed tables call a default hash function: integer hashing for
+/// keys of 1, 2, 4 or 8 bytes, XXH3 otherwise.
 #define ZL_DECLARE_TABLE_DEFAULT_HASH_FN(Table_, Key_)                 \
     ZL_TABLE_FORCE_INLINE size_t Table_##_genericHash(void const* key) \
     {                                                                  \
-        return XXH3_64bits(key, sizeof(Key_));                         \
+        return ZL_Table_hashBytes(key, sizeof(Key_));                  \
     }
 
 /// Make Table_-typed tables call the Key_ type's predefined hash function.
@@ -94,17 +138,19 @@ ZL_BEGIN_C_DECLS
         return Table_##_eq((Key_ const*)lhs, (Key_ const*)rhs); \
     }
 
-#define ZL_DECLARE_TABLE(Table_, Entry_, Key_, kPolicy_)                       \
+/// Declares the table @p Table_, implemented by @p Impl_,
+/// which is either SwissTable or GenericTable.
+#define ZL_DECLARE_TABLE_WITH_IMPL(Table_, Entry_, Key_, kPolicy_, Impl_)      \
     typedef struct {                                                           \
-        GenericTable table_;                                                   \
+        Impl_ table_;                                                          \
     } Table_;                                                                  \
                                                                                \
     typedef struct {                                                           \
-        GenericTable_Iter iter_;                                               \
+        Impl_##_Iter iter_;                                                    \
     } Table_##_Iter;                                                           \
                                                                                \
     typedef struct {                                                           \
-        GenericTable_Iter iter_;                                               \
+        Impl_##_Iter iter_;                                                    \
     } Table_##_IterMut;                                                        \
                                                                                \
     typedef struct {                                                           \
@@ -113,91 +159,91 @@ ZL_BEGIN_C_DECLS
         bool badAlloc;                                                         \
     } Table_##_Insert;                                                         \
                                                                                \
-    ZL_DECLARE_TABLE_DETAILS(Table_, Entry_, Key_, kPolicy_)                   \
+    ZL_DECLARE_TABLE_DETAILS(Table_, Entry_, Key_, kPolicy_, Impl_)            \
                                                                                \
     ZL_TABLE_INLINE Table_ Table_##_create(uint32_t maxCapacity)               \
     {                                                                          \
-        return (Table_){ GenericTable_create(NULL, maxCapacity) };             \
+        return (Table_){ Impl_##_create(NULL, maxCapacity) };                  \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Table_ Table_##_createInArena(                             \
             Arena* arena, uint32_t maxCapacity)                                \
     {                                                                          \
-        return (Table_){ GenericTable_create(arena, maxCapacity) };            \
+        return (Table_){ Impl_##_create(arena, maxCapacity) };                 \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE void Table_##_destroy(Table_* table)                       \
     {                                                                          \
-        GenericTable_destroy(&table->table_);                                  \
+        Impl_##_destroy(&table->table_);                                       \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE void Table_##_clear(Table_* table)                         \
     {                                                                          \
-        GenericTable_clear(&table->table_, kPolicy_);                          \
+        Impl_##_clear(&table->table_, kPolicy_);                               \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE size_t Table_##_size(Table_ const* table)                  \
     {                                                                          \
-        return GenericTable_size(&table->table_);                              \
+        return Impl_##_size(&table->table_);                                   \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE size_t Table_##_capacity(Table_ const* table)              \
     {                                                                          \
-        return GenericTable_capacity(&table->table_);                          \
+        return Impl_##_capacity(&table->table_);                               \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE size_t Table_##_maxCapacity(Table_ const* table)           \
     {                                                                          \
-        return GenericTable_maxCapacity(&table->table_);                       \
+        return Impl_##_maxCapacity(&table->table_);                            \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE bool Table_##_reserve(                                     \
             Table_* table, uint32_t capacity, bool guaranteeNoAllocations)     \
     {                                                                          \
-        return GenericTable_reserve(                                           \
+        return Impl_##_reserve(                                                \
                 &table->table_, capacity, guaranteeNoAllocations, kPolicy_);   \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_ const* Table_##_find(                               \
             Table_ const* table, Key_ const* key)                              \
     {                                                                          \
-        return (Entry_ const*)GenericTable_find(                               \
+        return (Entry_ const*)Impl_##_find(                                    \
                 &table->table_, key, kPolicy_);                                \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_* Table_##_findMut(Table_* table, Key_ const* key)   \
     {                                                                          \
-        return (Entry_*)GenericTable_find(&table->table_, key, kPolicy_);      \
+        return (Entry_*)Impl_##_find(&table->table_, key, kPolicy_);           \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_ const* Table_##_findVal(                            \
             Table_ const* table, Key_ const key)                               \
     {                                                                          \
-        return (Entry_ const*)GenericTable_find(                               \
+        return (Entry_ const*)Impl_##_find(                                    \
                 &table->table_, &key, kPolicy_);                               \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_* Table_##_findMutVal(Table_* table, Key_ const key) \
     {                                                                          \
-        return (Entry_*)GenericTable_find(&table->table_, &key, kPolicy_);     \
+        return (Entry_*)Impl_##_find(&table->table_, &key, kPolicy_);          \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE bool Table_##_contains(                                    \
             Table_ const* table, Key_ const* key)                              \
     {                                                                          \
-        return GenericTable_find(&table->table_, key, kPolicy_) != NULL;       \
+        return Impl_##_find(&table->table_, key, kPolicy_) != NULL;            \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE bool Table_##_containsVal(                                 \
             Table_ const* table, Key_ const key)                               \
     {                                                                          \
-        return GenericTable_find(&table->table_, &key, kPolicy_) != NULL;      \
+        return Impl_##_find(&table->table_, &key, kPolicy_) != NULL;           \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Table_##_Insert Table_##_insert(                           \
             Table_* table, Entry_ const* entry)                                \
     {                                                                          \
-        GenericTable_Insert insert = GenericTable_insert(                      \
+        Impl_##_Insert insert = Impl_##_insert(                                \
                 &table->table_, entry, kPolicy_, Detail_##Table_##_reserve);   \
         return (Table_##_Insert){ (Entry_*)insert.ptr,                         \
                                   insert.inserted,                             \
@@ -207,7 +253,7 @@ ZL_BEGIN_C_DECLS
     ZL_TABLE_INLINE Table_##_Insert Table_##_insertVal(                        \
             Table_* table, Entry_ const entry)                                 \
     {                                                                          \
-        GenericTable_Insert insert = GenericTable_insert(                      \
+        Impl_##_Insert insert = Impl_##_insert(                                \
                 &table->table_, &entry, kPolicy_, Detail_##Table_##_reserve);  \
         return (Table_##_Insert){ (Entry_*)insert.ptr,                         \
                                   insert.inserted,                             \
@@ -216,43 +262,43 @@ ZL_BEGIN_C_DECLS
                                                                                \
     ZL_TABLE_INLINE bool Table_##_erase(Table_* table, Key_ const* key)        \
     {                                                                          \
-        return GenericTable_erase(&table->table_, key, kPolicy_);              \
+        return Impl_##_erase(&table->table_, key, kPolicy_);                   \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE bool Table_##_eraseVal(Table_* table, Key_ const key)      \
     {                                                                          \
-        return GenericTable_erase(&table->table_, &key, kPolicy_);             \
+        return Impl_##_erase(&table->table_, &key, kPolicy_);                  \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Table_##_Iter Table_##_iter(Table_ const* table)           \
     {                                                                          \
-        return (Table_##_Iter){ GenericTable_iter(&table->table_, kPolicy_) }; \
+        return (Table_##_Iter){ Impl_##_iter(&table->table_, kPolicy_) };      \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Table_##_IterMut Table_##_iterMut(Table_* table)           \
     {                                                                          \
-        return (Table_##_IterMut){ GenericTable_iter(                          \
+        return (Table_##_IterMut){ Impl_##_iter(                               \
                 &table->table_, kPolicy_) };                                   \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_ const* Table_##_Iter_next(Table_##_Iter* iter)      \
     {                                                                          \
-        return (Entry_ const*)GenericTable_Iter_next(&iter->iter_, kPolicy_);  \
+        return (Entry_ const*)Impl_##_Iter_next(&iter->iter_, kPolicy_);       \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_* Table_##_IterMut_next(Table_##_IterMut* iter)      \
     {                                                                          \
-        return (Entry_*)GenericTable_Iter_next(&iter->iter_, kPolicy_);        \
+        return (Entry_*)Impl_##_Iter_next(&iter->iter_, kPolicy_);             \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_ const* Table_##_Iter_get(Table_##_Iter iter)        \
     {                                                                          \
-        return (Entry_ const*)GenericTable_Iter_get(iter.iter_);               \
+        return (Entry_ const*)Impl_##_Iter_get(iter.iter_);                    \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Entry_* Table_##_IterMut_get(Table_##_IterMut iter)        \
     {                                                                          \
-        return (Entry_*)GenericTable_Iter_get(iter.iter_);                     \
+        return (Entry_*)Impl_##_Iter_get(iter.iter_);                          \
     }                                                                          \
                                                                                \
     ZL_TABLE_INLINE Table_##_Iter Table_##_IterMut_const(                      \
@@ -265,15 +311,18 @@ ZL_BEGIN_C_DECLS
         int x;                                                                 \
     }
 
-#define ZL_DECLARE_TABLE_DETAILS(Table_, Entry_, Key_, kPolicy_) \
-    ZL_TABLE_NO_INLINE bool Detail_##Table_##_reserve(           \
-            GenericTable* table, uint32_t capacity)              \
-    {                                                            \
-        return GenericTable_reserve(                             \
-                table,                                           \
-                capacity,                                        \
-                /* guaranteeNoAllocations */ false,              \
-                kPolicy_);                                       \
+#define ZL_DECLARE_TABLE(Table_, Entry_, Key_, kPolicy_) \
+    ZL_DECLARE_TABLE_WITH_IMPL(Table_, Entry_, Key_, kPolicy_, SwissTable)
+
+#define ZL_DECLARE_TABLE_DETAILS(Table_, Entry_, Key_, kPolicy_, Impl_) \
+    ZL_TABLE_NO_INLINE bool Detail_##Table_##_reserve(                  \
+            Impl_* table, uint32_t capacity)                            \
+    {                                                                   \
+        return Impl_##_reserve(                                         \
+                table,                                                  \
+                capacity,                                               \
+                /* guaranteeNoAllocations */ false,                     \
+                kPolicy_);                                              \
     }
 
 #define ZL_DECLARE_TABLE_POLICY(kPolicy_, Table_, Entry_, HashFn_, EqFn_) \
@@ -867,4 +916,6 @@ ZL_TABLE_FORCE_INLINE bool GenericTable_erase(
 
 ZL_END_C_DECLS
 
+#include "openzl/common/detail/swiss_table.h" // IWYU pragma: export
+
 #endif
@@ -103,6 +103,9 @@ ZL_BEGIN_C_DECLS
  *
  *     size_t ${Map_}_hash($Key_ const* key);
  *     bool ${Map_}_eq($Key_ const* lhs, $Key_ const* rhs);
+ *
+ * The hash must mix all the bits of the key into all of its bits, as e.g.
+ * XXH3 does, since the table uses both its low and its high bits.
  */
 #define ZL_DECLARE_CUSTOM_MAP_TYPE(Map_, Key_, Val_) \
     ZL_DECLARE_TABLE_CUSTOM_HASH_FN(Map_, Key_)      \
@@ -110,16 +113,34 @@ ZL_BEGIN_C_DECLS
     _ZL_DECLARE_MAP_TYPE_IMPL(Map_, Key_, Val_)
 
 /**
- * Common base implementation macro. Don't invoke directly.
+ * The same as ZL_DECLARE_MAP_TYPE() except selects the table implementation
+ * @p Impl_, either SwissTable (the default) or GenericTable.
+ * Only meant to compare implementations in tests and benchmarks.
+ */
+#define ZL_DECLARE_MAP_TYPE_WITH_IMPL(Map_, Key_, Val_, Impl_) \
+    ZL_DECLARE_TABLE_DEFAULT_HASH_FN(Map_, Key_)               \
+    ZL_DECLARE_TABLE_DEFAULT_EQ_FN(Map_, Key_)                 \
+    _ZL_DECLARE_MAP_TYPE_WITH_IMPL(Map_, Key_, Val_, Impl_)
+
+/**
+ * Common base implementation macros. Don't invoke directly.
  */
 #define _ZL_DECLARE_MAP_TYPE_IMPL(Map_, Key_, Val_) \
-    typedef struct {                                \
-        Key_ key;                                   \
-        Val_ val;                                   \
-    } Map_##_Entry;                                 \
-    typedef Key_ Map_##_Key;                        \
-    ZL_DECLARE_TABLE_DEFAULT_POLICY(Map_);          \
-    ZL_DECLARE_TABLE(Map_, Map_##_Entry, Map_##_Key, Detail_##Map_##_kPolicy)
+    _ZL_DECLARE_MAP_TYPE_WITH_IMPL(Map_, Key_, Val_, SwissTable)
+
+#define _ZL_DECLARE_MAP_TYPE_WITH_IMPL(Map_, Key_, Val_, Impl_) \
+    typedef struct {                                            \
+        Key_ key;                                               \
+        Val_ val;                                               \
+    } Map_##_Entry;                                             \
+    typedef Key_ Map_##_Key;                                    \
+    ZL_DECLARE_TABLE_DEFAULT_POLICY(Map_);                      \
+    ZL_DECLARE_TABLE_WITH_IMPL(                                 \
+            Map_,                                               \
+            Map_##_Entry,                                       \
+            Map_##_Key,                                         \
+            Detail_##Map_##_kPolicy,                            \
+            Impl_)
 
 ZL_END_C_DECLS
 
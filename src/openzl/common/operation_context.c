@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "openzl/common/errors_internal.h"
+#include "openzl/common/trace.h"
 
 void ZL_OC_init(ZL_OperationContext* opCtx)
 {
@@ -23,6 +24,8 @@ void ZL_OC_destroy(ZL_OperationContext* opCtx)
     if (opCtx == NULL) {
         return;
     }
+    // Release the trace ring, if any
+    (void)TRACE_attach(opCtx, NULL);
     free(opCtx->defaultScopeContext);
     VECTOR_DESTROY(opCtx->warnings);
     for (size_t i = 0; i < VECTOR_SIZE(opCtx->errorInfos); i++) {
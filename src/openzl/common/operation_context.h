@@ -17,6 +17,7 @@ ZL_BEGIN_C_DECLS
 
 // Forward declare to avoid dependencies
 typedef struct ZL_DynamicErrorInfo_s ZL_DynamicErrorInfo;
+typedef struct ZL_TraceRing_s ZL_TraceRing;
 
 typedef enum {
     ZL_Operation_compress,
@@ -56,6 +57,12 @@ struct ZL_OperationContext_s {
     // common/introspection.h for more details.
     ZL_CompressIntrospectionHooks introspectionHooks;
     bool hasIntrospectionHooks;
+
+    // Tracer attached to the context, and the ring this context records
+    // into. Both NULL when tracing is disabled. The ring is owned by the
+    // tracer, and only written by this context. See common/trace.h.
+    ZL_Tracer* tracer;
+    ZL_TraceRing* traceRing;
 };
 
 void ZL_OC_init(ZL_OperationContext* opCtx);
@@ -80,6 +80,9 @@ ZL_BEGIN_C_DECLS
  *
  *     size_t ${Set_}_hash($Key_ const* key);
  *     bool ${Set_}_eq($Key_ const* lhs, $Key_ const* rhs);
+ *
+ * The hash must mix all the bits of the key into all of its bits, as e.g.
+ * XXH3 does, since the table uses both its low and its high bits.
  */
 #define ZL_DECLARE_CUSTOM_SET_TYPE(Set_, Key_)  \
     typedef Key_ Set_##_Entry;                  \
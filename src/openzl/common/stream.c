@@ -448,6 +448,8 @@ static ZL_Report STREAM_refStreamStringSlice(
     ZL_ASSERT_EQ(ZL_Data_type(dst), ZL_Type_string);
     ZL_ASSERT(dst->buffer._ptr == src->buffer._ptr);
     dst->buffer._ptr = (char*)dst->buffer._ptr + skipped;
+    ZL_ASSERT(dst->stringLens._ptr == src->stringLens._ptr);
+    dst->stringLens._ptr = (uint32_t*)dst->stringLens._ptr + startingEltNum;
     ZL_ASSERT_GE(dst->numElts, numElts);
     dst->numElts       = numElts;
     dst->lastCommmited = numElts;
@@ -763,12 +765,13 @@ static ZL_Report STREAM_commitStrings(ZL_Data* s, size_t numStrings)
             numStrings,
             s->eltsCapacity,
             "Number of strings committed is greater than capacity");
-    uint64_t const totalStringsSize =
-            NUMOP_sumArray32(ZL_Refcount_get(&s->stringLens), numStrings);
+    uint64_t const totalStringsSize = NUMOP_sumArray32(
+            (const uint32_t*)ZL_Refcount_get(&s->stringLens) + s->numElts,
+            numStrings);
     ZL_RET_R_IF_GT(
             streamCapacity_tooSmall,
             totalStringsSize,
-            (uint64_t)s->bufferCapacity,
+            (uint64_t)(s->bufferCapacity - s->bufferUsed),
             "Total string content size is greater than capacity");
 
     // All conditions fulfilled : now set
@@ -1068,6 +1071,12 @@ int STREAM_hasBuffer(const ZL_Data* s)
     return !ZL_Refcount_null(&s->buffer);
 }
 
+const void* STREAM_bufferOwner(const ZL_Data* s)
+{
+    ZL_ASSERT_NN(s);
+    return s->buffer._ref;
+}
+
 /* ======    TypedBuffer interface    ====== */
 
 /* Note: for the time being, TypedBuffer is the same as Stream.
@@ -147,6 +147,12 @@ ZL_RBuffer STREAM_getRBuffer(const ZL_Data* s);
 ZL_WBuffer STREAM_getWBuffer(ZL_Data* s);
 int STREAM_isCommitted(const ZL_Data* s);
 
+// Identifies the reference-counted allocation backing @p s's content,
+// or NULL if @p s doesn't track its buffer.
+// Streams sharing a same owner update a same reference counter,
+// which is not thread-safe.
+const void* STREAM_bufferOwner(const ZL_Data* s);
+
 // Request capacity in nb of elts
 // Note: String type can't get capacity of its primary buffer size this way
 size_t STREAM_eltCapacity(const ZL_Data* s);
@@ -0,0 +1,469 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#    define _POSIX_C_SOURCE 199309L // clock_gettime
+#endif
+
+#include "openzl/common/trace.h"
+
+#include <stdarg.h> // va_list
+#include <stdio.h>  // vsnprintf
+#include <stdlib.h> // qsort
+#include <string.h> // strcmp
+
+#include "openzl/common/allocation.h"
+#include "openzl/common/assertion.h"
+#include "openzl/shared/mem.h" // ZL_memcpy
+
+#if defined(_WIN32)
+#    include <windows.h> // QueryPerformanceCounter
+#elif defined(__APPLE__) && defined(__MACH__)
+#    include <mach/mach_time.h> // mach_absolute_time
+#else
+#    include <time.h> // clock_gettime
+#endif
+
+#define TRACE_EVENTS_PER_RING_DEFAULT 4096
+
+struct ZL_TraceRing_s {
+    ZL_Tracer* tracer;
+    unsigned id;
+    size_t mask;       // capacity - 1, capacity being a power of 2
+    size_t nbRecorded; // since last reset, including overwritten events
+    bool inUse;        // attached to a context
+    ZL_TraceEvent events[];
+};
+
+struct ZL_Tracer_s {
+    size_t eventsPerRing;
+    uint64_t epochNs;
+    ZL_TraceRing** rings;
+    size_t nbRings;
+    size_t ringsCapacity;
+};
+
+/* ===   Clock   === */
+
+uint64_t TRACE_nowNs(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER ticksPerSecond;
+    if (ticksPerSecond.QuadPart == 0)
+        QueryPerformanceFrequency(&ticksPerSecond);
+    LARGE_INTEGER x;
+    QueryPerformanceCounter(&x);
+    // Split the conversion to avoid overflowing 64 bits
+    uint64_t const ticks = (uint64_t)x.QuadPart;
+    uint64_t const freq  = (uint64_t)ticksPerSecond.QuadPart;
+    return (ticks / freq) * 1000000000ULL
+            + ((ticks % freq) * 1000000000ULL) / freq;
+#elif defined(__APPLE__) && defined(__MACH__)
+    static mach_timebase_info_data_t rate;
+    if (rate.denom == 0)
+        mach_timebase_info(&rate);
+    return mach_absolute_time() * (uint64_t)rate.numer / (uint64_t)rate.denom;
+#else
+    struct timespec t = { 0, 0 };
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+#endif
+}
+
+/* ===   Tracer   === */
+
+ZL_Tracer* ZL_Tracer_create(size_t eventsPerRing)
+{
+    if (eventsPerRing == 0)
+        eventsPerRing = TRACE_EVENTS_PER_RING_DEFAULT;
+    size_t capacity = 1;
+    while (capacity < eventsPerRing) {
+        if (capacity > ((size_t)-1 / 2) / sizeof(ZL_TraceEvent))
+            return NULL;
+        capacity *= 2;
+    }
+    ZL_Tracer* const tracer = ZL_calloc(sizeof(*tracer));
+    if (tracer == NULL)
+        return NULL;
+    tracer->eventsPerRing = capacity;
+    tracer->epochNs       = TRACE_nowNs();
+    return tracer;
+}
+
+void ZL_Tracer_free(ZL_Tracer* tracer)
+{
+    if (tracer == NULL)
+        return;
+    for (size_t n = 0; n < tracer->nbRings; n++) {
+        ZL_free(tracer->rings[n]);
+    }
+    ZL_free(tracer->rings);
+    ZL_free(tracer);
+}
+
+void ZL_Tracer_reset(ZL_Tracer* tracer)
+{
+    ZL_ASSERT_NN(tracer);
+    for (size_t n = 0; n < tracer->nbRings; n++) {
+        tracer->rings[n]->nbRecorded = 0;
+    }
+    tracer->epochNs = TRACE_nowNs();
+}
+
+static size_t TRACE_ringNbEvents(const ZL_TraceRing* ring)
+{
+    size_t const capacity = ring->mask + 1;
+    return ring->nbRecorded < capacity ? ring->nbRecorded : capacity;
+}
+
+size_t ZL_Tracer_nbEvents(const ZL_Tracer* tracer)
+{
+    ZL_ASSERT_NN(tracer);
+    size_t total = 0;
+    for (size_t n = 0; n < tracer->nbRings; n++) {
+        total += TRACE_ringNbEvents(tracer->rings[n]);
+    }
+    return total;
+}
+
+size_t ZL_Tracer_nbDroppedEvents(const ZL_Tracer* tracer)
+{
+    ZL_ASSERT_NN(tracer);
+    size_t total = 0;
+    for (size_t n = 0; n < tracer->nbRings; n++) {
+        const ZL_TraceRing* const ring = tracer->rings[n];
+        total += ring->nbRecorded - TRACE_ringNbEvents(ring);
+    }
+    return total;
+}
+
+const ZL_TraceEvent* ZL_Tracer_getEvent(const ZL_Tracer* tracer, size_t idx)
+{
+    ZL_ASSERT_NN(tracer);
+    for (size_t n = 0; n < tracer->nbRings; n++) {
+        const ZL_TraceRing* const ring = tracer->rings[n];
+        size_t const nbEvents          = TRACE_ringNbEvents(ring);
+        if (idx < nbEvents) {
+            size_t const first = ring->nbRecorded - nbEvents;
+            return &ring->events[(first + idx) & ring->mask];
+        }
+        idx -= nbEvents;
+    }
+    return NULL;
+}
+
+/* Hands out a ring released by a previous context when there is one, so that
+ * a long-lived tracer doesn't grow with each context attached to it. Rings keep
+ * their events, new ones are appended after them. */
+static ZL_TraceRing* TRACE_acquireRing(ZL_Tracer* tracer)
+{
+    for (size_t n = 0; n < tracer->nbRings; n++) {
+        if (!tracer->rings[n]->inUse) {
+            tracer->rings[n]->inUse = true;
+            return tracer->rings[n];
+        }
+    }
+    if (tracer->nbRings == tracer->ringsCapacity) {
+        size_t const newCapacity =
+                tracer->ringsCapacity ? 2 * tracer->ringsCapacity : 8;
+        ZL_TraceRing** const rings =
+                ZL_malloc(newCapacity * sizeof(ZL_TraceRing*));
+        if (rings == NULL)
+            return NULL;
+        if (tracer->nbRings) {
+            ZL_memcpy(
+                    rings,
+                    tracer->rings,
+                    tracer->nbRings * sizeof(ZL_TraceRing*));
+        }
+        ZL_free(tracer->rings);
+        tracer->rings         = rings;
+        tracer->ringsCapacity = newCapacity;
+    }
+    ZL_TraceRing* const ring = ZL_malloc(
+            sizeof(ZL_TraceRing)
+            + tracer->eventsPerRing * sizeof(ZL_TraceEvent));
+    if (ring == NULL)
+        return NULL;
+    ring->tracer     = tracer;
+    ring->id         = (unsigned)tracer->nbRings;
+    ring->mask       = tracer->eventsPerRing - 1;
+    ring->nbRecorded = 0;
+    ring->inUse      = true;
+
+    tracer->rings[tracer->nbRings++] = ring;
+    return ring;
+}
+
+/* ===   Recording   === */
+
+void TRACE_record(
+        ZL_TraceRing* ring,
+        ZL_TraceEventType type,
+        unsigned id,
+        const char* name,
+        uint64_t startNs,
+        size_t bytesIn,
+        size_t bytesOut)
+{
+    uint64_t const endNs   = TRACE_nowNs();
+    uint64_t const epoch   = ring->tracer->epochNs;
+    ZL_TraceEvent* const e = &ring->events[ring->nbRecorded & ring->mask];
+    ring->nbRecorded++;
+    e->type     = type;
+    e->ringID   = ring->id;
+    e->id       = id;
+    e->startNs  = startNs > epoch ? startNs - epoch : 0;
+    e->endNs    = endNs > epoch ? endNs - epoch : 0;
+    e->bytesIn  = bytesIn;
+    e->bytesOut = bytesOut;
+    size_t len  = 0;
+    if (name != NULL) {
+        while (len < ZL_TRACE_NAME_SIZE_MAX - 1 && name[len] != '\0') {
+            e->name[len] = name[len];
+            len++;
+        }
+    }
+    e->name[len] = '\0';
+}
+
+ZL_Report TRACE_attach(ZL_OperationContext* opCtx, ZL_Tracer* tracer)
+{
+    ZL_ASSERT_NN(opCtx);
+    if (opCtx->tracer == tracer)
+        return ZL_returnSuccess();
+    if (opCtx->traceRing != NULL) {
+        // Release the ring, for the next context attached to its tracer
+        ZL_ASSERT(opCtx->traceRing->inUse);
+        opCtx->traceRing->inUse = false;
+    }
+    opCtx->tracer    = NULL;
+    opCtx->traceRing = NULL;
+    if (tracer == NULL)
+        return ZL_returnSuccess();
+    ZL_TraceRing* const ring = TRACE_acquireRing(tracer);
+    ZL_RET_R_IF_NULL(allocation, ring);
+    opCtx->tracer    = tracer;
+    opCtx->traceRing = ring;
+    return ZL_returnSuccess();
+}
+
+void TRACE_inherit(
+        ZL_OperationContext* worker,
+        const ZL_OperationContext* parent)
+{
+    ZL_ASSERT_NN(worker);
+    ZL_ASSERT_NN(parent);
+    if (ZL_isError(TRACE_attach(worker, parent->tracer))) {
+        (void)TRACE_attach(worker, NULL);
+    }
+}
+
+/* ===   Export   === */
+
+typedef struct {
+    ZL_Tracer_WriteFn write;
+    void* opaque;
+    size_t pos;
+    char buffer[1024];
+} TRACE_Writer;
+
+static void TRACE_flush(TRACE_Writer* w)
+{
+    if (w->pos)
+        w->write(w->opaque, w->buffer, w->pos);
+    w->pos = 0;
+}
+
+/* Lines are expected to fit in the buffer, longer ones are truncated */
+static void TRACE_printf(TRACE_Writer* w, const char* format, ...)
+{
+    for (;;) {
+        size_t const avail = sizeof(w->buffer) - w->pos;
+        va_list args;
+        va_start(args, format);
+        int const len = vsnprintf(w->buffer + w->pos, avail, format, args);
+        va_end(args);
+        if (len < 0)
+            return;
+        if ((size_t)len < avail) {
+            w->pos += (size_t)len;
+            return;
+        }
+        if (w->pos == 0) {
+            w->pos = sizeof(w->buffer) - 1;
+            return;
+        }
+        TRACE_flush(w);
+    }
+}
+
+static const char* TRACE_typeName(ZL_TraceEventType type)
+{
+    switch (type) {
+        case ZL_TraceEventType_codecEncode:
+            return "codecEncode";
+        case ZL_TraceEventType_graphEncode:
+            return "graphEncode";
+        case ZL_TraceEventType_codecDecode:
+            return "codecDecode";
+        default:
+            return "unknown";
+    }
+}
+
+/* Escapes @p name for inclusion within a JSON string */
+static void TRACE_escapeName(
+        char dst[2 * ZL_TRACE_NAME_SIZE_MAX],
+        const char* name)
+{
+    size_t pos = 0;
+    for (size_t n = 0; name[n] != '\0'; n++) {
+        char const c = name[n];
+        if (c == '"' || c == '\\') {
+            dst[pos++] = '\\';
+            dst[pos++] = c;
+        } else {
+            dst[pos++] = ((unsigned char)c < 0x20) ? '?' : c;
+        }
+    }
+    dst[pos] = '\0';
+}
+
+ZL_Report ZL_Tracer_exportChromeTrace(
+        const ZL_Tracer* tracer,
+        ZL_Tracer_WriteFn write,
+        void* opaque)
+{
+    ZL_RET_R_IF_NULL(parameter_invalid, tracer);
+    ZL_RET_R_IF_NULL(parameter_invalid, write);
+    TRACE_Writer w = { .write = write, .opaque = opaque };
+    const char* sep = "";
+    TRACE_printf(&w, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (size_t r = 0; r < tracer->nbRings; r++) {
+        TRACE_printf(
+                &w,
+                "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                "\"tid\":%zu,\"args\":{\"name\":\"context %zu\"}}",
+                sep,
+                r,
+                r);
+        sep = ",";
+    }
+    size_t const nbEvents = ZL_Tracer_nbEvents(tracer);
+    for (size_t n = 0; n < nbEvents; n++) {
+        const ZL_TraceEvent* const e = ZL_Tracer_getEvent(tracer, n);
+        char name[2 * ZL_TRACE_NAME_SIZE_MAX];
+        TRACE_escapeName(name, e->name);
+        TRACE_printf(
+                &w,
+                "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"id\":%u,"
+                "\"bytesIn\":%zu,\"bytesOut\":%zu}}",
+                sep,
+                name,
+                TRACE_typeName(e->type),
+                e->ringID,
+                (double)e->startNs / 1000.,
+                (double)(e->endNs - e->startNs) / 1000.,
+                e->id,
+                e->bytesIn,
+                e->bytesOut);
+        sep = ",";
+    }
+    TRACE_printf(&w, "\n]}\n");
+    TRACE_flush(&w);
+    return ZL_returnSuccess();
+}
+
+typedef struct {
+    ZL_TraceEventType type;
+    const char* name;
+    size_t nbCalls;
+    uint64_t totalNs;
+    size_t bytesIn;
+    size_t bytesOut;
+} TRACE_Aggregate;
+
+static int TRACE_cmpAggregates(const void* lp, const void* rp)
+{
+    const TRACE_Aggregate* const l = lp;
+    const TRACE_Aggregate* const r = rp;
+    if (l->totalNs != r->totalNs)
+        return l->totalNs > r->totalNs ? -1 : 1;
+    if (l->type != r->type)
+        return l->type < r->type ? -1 : 1;
+    return strcmp(l->name, r->name);
+}
+
+ZL_Report ZL_Tracer_exportSummary(
+        const ZL_Tracer* tracer,
+        ZL_Tracer_WriteFn write,
+        void* opaque)
+{
+    ZL_RET_R_IF_NULL(parameter_invalid, tracer);
+    ZL_RET_R_IF_NULL(parameter_invalid, write);
+    size_t const nbEvents = ZL_Tracer_nbEvents(tracer);
+    TRACE_Aggregate* const aggs =
+            ZL_malloc((nbEvents ? nbEvents : 1) * sizeof(TRACE_Aggregate));
+    ZL_RET_R_IF_NULL(allocation, aggs);
+
+    // Distinct codecs and graphs are few: a linear search is good enough
+    size_t nbAggs = 0;
+    for (size_t n = 0; n < nbEvents; n++) {
+        const ZL_TraceEvent* const e = ZL_Tracer_getEvent(tracer, n);
+        size_t a                     = 0;
+        while (a < nbAggs
+               && (aggs[a].type != e->type || strcmp(aggs[a].name, e->name)))
+            a++;
+        if (a == nbAggs) {
+            aggs[a] = (TRACE_Aggregate){ .type = e->type, .name = e->name };
+            nbAggs++;
+        }
+        aggs[a].nbCalls++;
+        aggs[a].totalNs += e->endNs - e->startNs;
+        aggs[a].bytesIn += e->bytesIn;
+        aggs[a].bytesOut += e->bytesOut;
+    }
+    qsort(aggs, nbAggs, sizeof(*aggs), TRACE_cmpAggregates);
+
+    TRACE_Writer w = { .write = write, .opaque = opaque };
+    TRACE_printf(
+            &w,
+            "%-12s %8s %12s %10s %14s %14s %9s  %s\n",
+            "type",
+            "calls",
+            "total ms",
+            "avg us",
+            "bytes in",
+            "bytes out",
+            "MB/s",
+            "name");
+    for (size_t a = 0; a < nbAggs; a++) {
+        const TRACE_Aggregate* const agg = &aggs[a];
+        // Throughput is measured on the uncompressed side
+        size_t const bytes = agg->type == ZL_TraceEventType_codecDecode
+                ? agg->bytesOut
+                : agg->bytesIn;
+        double const ns    = agg->totalNs ? (double)agg->totalNs : 1.;
+        TRACE_printf(
+                &w,
+                "%-12s %8zu %12.3f %10.2f %14zu %14zu %9.1f  %s\n",
+                TRACE_typeName(agg->type),
+                agg->nbCalls,
+                (double)agg->totalNs / 1e6,
+                (double)agg->totalNs / 1e3 / (double)agg->nbCalls,
+                agg->bytesIn,
+                agg->bytesOut,
+                (double)bytes * 1e3 / ns,
+                agg->name);
+    }
+    if (ZL_Tracer_nbDroppedEvents(tracer)) {
+        TRACE_printf(
+                &w,
+                "(%zu events dropped, increase the ring capacity)\n",
+                ZL_Tracer_nbDroppedEvents(tracer));
+    }
+    TRACE_flush(&w);
+    ZL_free(aggs);
+    return ZL_returnSuccess();
+}
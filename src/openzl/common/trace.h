@@ -0,0 +1,76 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_COMMON_TRACE_H
+#define ZSTRONG_COMMON_TRACE_H
+
+#include "openzl/common/operation_context.h"
+#include "openzl/shared/portability.h"
+#include "openzl/zl_config.h"
+#include "openzl/zl_trace.h"
+
+ZL_BEGIN_C_DECLS
+
+/**
+ * Internal side of the tracing facility, see zl_trace.h for the public API.
+ *
+ * A context records events into the ring referenced by its
+ * ZL_OperationContext. Rings are allocated by the tracer, and handed out to
+ * contexts serially: when a tracer is attached, and when the parent context
+ * prepares a worker context. After that, each ring has a single writer.
+ * Contexts release their ring when detached or destroyed.
+ *
+ * Usage at an execution point:
+ *
+ *     ZL_TraceRing* const ring = TRACE_RING(ctx);
+ *     uint64_t const start     = TRACE_start(ring);
+ *     ... execute ...
+ *     if (ring != NULL)
+ *         TRACE_record(ring, type, id, name, start, bytesIn, bytesOut);
+ */
+
+#if ZL_ALLOW_INTROSPECTION
+#    define TRACE_RING(ctx) (ZL_GET_OPERATION_CONTEXT(ctx)->traceRing)
+#else
+#    define TRACE_RING(ctx) ((ZL_TraceRing*)NULL)
+#endif
+
+/// @returns a monotonic timestamp, in nanoseconds
+uint64_t TRACE_nowNs(void);
+
+/// @returns the start timestamp of an event, or 0 when @p ring is NULL
+ZL_INLINE uint64_t TRACE_start(const ZL_TraceRing* ring)
+{
+    return ring == NULL ? 0 : TRACE_nowNs();
+}
+
+/// Records an event which started at @p startNs, and ends now.
+void TRACE_record(
+        ZL_TraceRing* ring,
+        ZL_TraceEventType type,
+        unsigned id,
+        const char* name,
+        uint64_t startNs,
+        size_t bytesIn,
+        size_t bytesOut);
+
+/**
+ * Attaches @p tracer to @p opCtx, acquiring a ring from it. The ring
+ * previously attached to @p opCtx, if any, is released to its tracer, which
+ * hands it out again to the next context attached to it.
+ * Passing NULL detaches the current tracer.
+ */
+ZL_Report TRACE_attach(ZL_OperationContext* opCtx, ZL_Tracer* tracer);
+
+/**
+ * Makes the worker context @p worker trace into the same tracer as its
+ * @p parent, acquiring a ring for it on first use. Must be invoked from the
+ * parent's thread, before the worker starts.
+ * On allocation failure, the worker is just not traced.
+ */
+void TRACE_inherit(
+        ZL_OperationContext* worker,
+        const ZL_OperationContext* parent);
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_COMMON_TRACE_H
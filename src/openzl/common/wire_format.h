@@ -67,10 +67,13 @@
  *
  * - v20-: checksum properties (1 byte)
  *
- * - v21+: ***if*** Input Sizes are unknown:
- *      - NbInputs x ExtL248: size of each Inputs _at block level_,
+ * - v24+: ***if*** Input Sizes are unknown:
+ *      - NbInputs x VarInt: size of each Inputs _at block level_,
  *                  which is necessarily known
- *      - NbInputStrings x ExtL248: nb of Strings in String Input of same rank.
+ *      - NbInputStrings x VarInt: nb of Strings in String Input of same rank.
+ *      @note: this is the case of frames produced by streaming compression
+ * - v21-v23: unknown Input Sizes were specified with ExtL248 sizes here,
+ *      but never supported: decoders reject such frames.
  *
  * Decoding Map:
  * - For each decoder :
@@ -183,11 +186,35 @@ uint32_t ZL_getMagicNumber(uint32_t version);
 #define FRAME_HEADER_SIZE_MIN \
     (4 /*magic*/ + 4 /*dec.Size*/ + 1 /*eof marker*/) // Just core elts
 
+// Since ZL_CHUNK_VERSION_MIN, the eof marker is located after the chunks,
+// and a frame header can be measured without any following data.
+#define FRAME_HEADER_SIZE_MIN_V21 \
+    (4 /*magic*/ + 1 /*properties*/ + 1 /*nbOutputs*/ + 1 /*dec.Size*/)
+
 typedef struct {
     bool hasContentChecksum;
     bool hasCompressedChecksum;
+    bool hasSeekTable; // format version >= ZL_SEEK_TABLE_VERSION_MIN only
+    // Input sizes are stored in each chunk header instead of the frame header
+    // format version >= ZL_UNKNOWN_SIZE_VERSION_MIN only
+    bool unknownContentSize;
 } ZL_FrameProperties;
 
+/* Seek table :
+ * Optional frame footer, present when the frame property hasSeekTable is set.
+ * It's positioned right after the end-of-frame marker, and describes each
+ * chunk, in frame order, so that any chunk can be located without scanning
+ * the ones before it.
+ * - nbChunks (varint)
+ * - for each chunk:
+ *   - compressed size of the chunk, including its checksums (varint)
+ *   - for each output: decompressed size in bytes, then numElts (varints)
+ * - size of all fields above, in bytes (LE32)
+ * Compressed and decompressed offsets are the prefix sums of these sizes.
+ * The final size field allows locating the table from the end of the frame.
+ */
+#define ZL_SEEK_TABLE_FOOTER_SIZE 4
+
 typedef enum { trt_standard, trt_custom } TransformType_e;
 
 typedef struct {
@@ -225,7 +252,9 @@ typedef enum {
     ZL_StandardTransformID_fse_deprecated           = 15,
     ZL_StandardTransformID_huffman_deprecated       = 16,
     ZL_StandardTransformID_huffman_fixed_deprecated = 17,
-    // 18-19 : available
+    ZL_StandardTransformID_pfor                     = 18,
+    ZL_StandardTransformID_dedup_chunks             = 19,
+
     ZL_StandardTransformID_rolz       = 20,
     ZL_StandardTransformID_fastlz     = 21,
     ZL_StandardTransformID_zstd       = 22,
@@ -255,6 +284,8 @@ typedef enum {
     ZL_StandardTransformID_tokenize_numeric = 37,
     ZL_StandardTransformID_tokenize_string  = 38,
 
+    ZL_StandardTransformID_rans_struct = 39,
+
     ZL_StandardTransformID_splitn          = 40,
     ZL_StandardTransformID_splitByStruct   = 41,
     ZL_StandardTransformID_dispatchN_byTag = 42,
@@ -290,6 +321,8 @@ typedef enum {
 
     ZL_StandardTransformID_interleave_string = 61,
 
+    ZL_StandardTransformID_rans = 62,
+
     ZL_StandardTransformID_end =
             63 // last id, used to detect end of ID range (impacts
                // header encoding) give some room to be able to add new
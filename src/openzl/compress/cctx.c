@@ -12,10 +12,12 @@
 #include "openzl/common/logging.h" // ZL_LOG
 #include "openzl/common/operation_context.h"
 #include "openzl/common/stream.h"               // STREAM_*
+#include "openzl/common/trace.h"                // TRACE_*
 #include "openzl/common/vector.h"               // VECTOR_*
 #include "openzl/compress/cctx.h"               // ZS2_CCtx_*
 #include "openzl/compress/cgraph.h"             // CGRAPH_*
 #include "openzl/compress/cnode.h"              // CNODE_*
+#include "openzl/compress/compress_stream.h"    // CSTREAM_free
 #include "openzl/compress/dyngraph_interface.h" // GCtx
 #include "openzl/compress/enc_interface.h"      // ENC_*
 #include "openzl/compress/gcparams.h"           // GCParams
@@ -24,6 +26,8 @@
 #include "openzl/compress/rtgraphs.h"            // RTGraph, RTStreamID
 #include "openzl/compress/segmenter.h"           // SEGM_*
 #include "openzl/compress/trStates.h"            // TrStates
+#include "openzl/shared/varint.h"                // ZL_varintEncode
+#include "openzl/shared/xxhash.h"                // XXH3_64bits_update
 #include "openzl/zl_buffer.h"                    // ZL_RBuffer
 #include "openzl/zl_compress.h"
 #include "openzl/zl_compressor.h"
@@ -38,9 +42,6 @@
 
 #include "openzl/common/logging.h" // ZL_LOG
 
-#include <stdio.h>
-#include <time.h>
-
 // --------------------------
 // Transform's private header
 // --------------------------
@@ -127,6 +128,36 @@ static void CCTX_TransformHeaders_destroy(CCTX_TransformHeaders* headers)
 // CCtx Lifetime management
 // --------------------------
 
+/* State of a worker compressing Chunks in parallel.
+ * Workers are created on first use, and kept for the lifetime of the CCtx. */
+typedef struct {
+    ZL_CCtx* cctx; // derived from the parent CCtx
+    void* dst;     // worker-owned destination buffer
+    size_t dstCapacity;
+    const CCTX_ChunkJob* job;
+    ZL_Report result;
+} CCTX_ChunkWorker;
+
+typedef struct {
+    ZL_GraphID graphID;
+    const ZL_RuntimeGraphParameters* rgp;
+    const RTStreamID* rtInputs;
+    size_t nbInputs;
+} SuccessorInfo;
+
+/* State of a worker running a contiguous batch of Successors in parallel.
+ * Its RTGraph is merged into the parent's once all batches have completed.
+ * Merged Streams remain hosted by the worker, so it is only cleaned
+ * at the end of the parent's Chunk. */
+typedef struct {
+    ZL_CCtx* cctx; // derived from the parent CCtx
+    const SuccessorInfo* successors;
+    size_t nbSuccessors;
+    size_t forkBase; // nb of parent's Streams at fork time
+    unsigned depth;
+    ZL_Report result;
+} CCTX_SuccessorWorker;
+
 // Note: typedef'd to ZL_CCtx within zs2_compress.h
 struct ZL_CCtx_s {
     const ZL_Compressor* cgraph;
@@ -148,9 +179,22 @@ struct ZL_CCtx_s {
     int segmenterStarted;
     void* dstBuffer;         // where to write chunks
     size_t dstCapacity;      // capacity of dstBuffer
-    size_t currentFrameSize; // already written into dstBuffer
+    size_t currentFrameSize; // already written into the frame
+    size_t dstFlushed;       // frame position of dstBuffer[0]
+    ZL_WriteSink sink;       // write==NULL when writing into dstBuffer
+    VECTOR(uint8_t) sinkStaging; // dstBuffer, when writing into sink
     ZL_OperationContext opCtx;
     int inBackupMode; // tracks when graph is in backup mode, to avoid looping
+    ZL_WorkerPool workerPool; // user-provided, runTasks==NULL when none
+    CCTX_ChunkWorker* chunkWorkers;
+    size_t nbChunkWorkers;
+    CCTX_SuccessorWorker* successorWorkers;
+    size_t nbSuccessorWorkers;
+    size_t nbUsedSuccessorWorkers; // within current Chunk
+    VECTOR(uint8_t) seekEntries; // serialized seek table entries, if enabled
+    size_t nbSeekEntries;
+    int unknownContentSize; // sizes are written into each chunk header
+    CSTREAM_State* cstream; // streaming compression state, created on demand
 };
 
 static ZL_Report CCTX_init(ZL_CCtx* cctx)
@@ -171,6 +215,8 @@ static ZL_Report CCTX_init(ZL_CCtx* cctx)
     TRS_init(&cctx->cachedCodecStates);
     CCTX_TransformHeaders_init(&cctx->trHeaders);
     ZL_OC_init(&cctx->opCtx);
+    VECTOR_INIT(cctx->seekEntries, ZL_CONTAINER_SIZE_LIMIT);
+    VECTOR_INIT(cctx->sinkStaging, ZL_CONTAINER_SIZE_LIMIT);
 
     return ZL_returnSuccess();
 }
@@ -191,6 +237,12 @@ ZL_CCtx* CCTX_create(void)
 void CCTX_cleanChunk(ZL_CCtx* cctx)
 {
     RTGM_reset(&cctx->rtgraph);
+    // Must happen after the parent's reset, since they host merged Streams
+    for (size_t n = 0; n < cctx->nbUsedSuccessorWorkers; n++) {
+        if (cctx->successorWorkers[n].cctx != NULL)
+            CCTX_cleanChunk(cctx->successorWorkers[n].cctx);
+    }
+    cctx->nbUsedSuccessorWorkers = 0;
     CCTX_TransformHeaders_reset(&cctx->trHeaders);
     ALLOC_Arena_freeAll(cctx->chunkArena);
 }
@@ -200,6 +252,7 @@ void CCTX_clean(ZL_CCtx* cctx)
 {
     CCTX_cleanChunk(cctx);
     ALLOC_Arena_freeAll(cctx->sessionArena);
+    cctx->sink.write = NULL;
     ZL_ASSERT_EQ(ALLOC_Arena_memUsed(cctx->codecArena), 0);
     ZL_ASSERT_EQ(ALLOC_Arena_memUsed(cctx->graphArena), 0);
     ZL_ASSERT_EQ(ALLOC_Arena_memUsed(cctx->chunkArena), 0);
@@ -209,14 +262,26 @@ void CCTX_free(ZL_CCtx* cctx)
 {
     if (cctx == NULL)
         return;
+    for (size_t n = 0; n < cctx->nbChunkWorkers; n++) {
+        CCTX_free(cctx->chunkWorkers[n].cctx);
+        ZL_free(cctx->chunkWorkers[n].dst);
+    }
+    ZL_free(cctx->chunkWorkers);
     TRS_destroy(&cctx->cachedCodecStates);
     ZL_Compressor_free(cctx->internal_cgraph);
     RTGM_destroy(&cctx->rtgraph);
+    for (size_t n = 0; n < cctx->nbSuccessorWorkers; n++) {
+        CCTX_free(cctx->successorWorkers[n].cctx);
+    }
+    ZL_free(cctx->successorWorkers);
     CCTX_TransformHeaders_destroy(&cctx->trHeaders);
     ALLOC_Arena_freeArena(cctx->codecArena);
     ALLOC_Arena_freeArena(cctx->graphArena);
     ALLOC_Arena_freeArena(cctx->chunkArena);
     ALLOC_Arena_freeArena(cctx->sessionArena);
+    VECTOR_DESTROY(cctx->seekEntries);
+    VECTOR_DESTROY(cctx->sinkStaging);
+    CSTREAM_free(cctx->cstream);
     ZL_OC_destroy(&cctx->opCtx);
     ZL_free(cctx);
 }
@@ -254,6 +319,33 @@ ZL_Report ZL_CCtx_detachAllIntrospectionHooks(ZL_CCtx* cctx)
     return ZL_returnSuccess();
 }
 
+ZL_Report ZL_CCtx_setWorkerPool(ZL_CCtx* cctx, const ZL_WorkerPool* pool)
+{
+    ZL_ASSERT_NN(cctx);
+    if (pool == NULL) {
+        ZL_zeroes(&cctx->workerPool, sizeof(cctx->workerPool));
+        return ZL_returnSuccess();
+    }
+    ZL_RET_R_IF_NULL(parameter_invalid, pool->runTasks);
+    cctx->workerPool = *pool;
+    return ZL_returnSuccess();
+}
+
+ZL_Report ZL_CCtx_setTracer(ZL_CCtx* cctx, ZL_Tracer* tracer)
+{
+    ZL_ASSERT_NN(cctx);
+    // Workers acquire their own ring from the new tracer on next use
+    for (size_t n = 0; n < cctx->nbChunkWorkers; n++) {
+        if (cctx->chunkWorkers[n].cctx != NULL)
+            (void)TRACE_attach(&cctx->chunkWorkers[n].cctx->opCtx, NULL);
+    }
+    for (size_t n = 0; n < cctx->nbSuccessorWorkers; n++) {
+        if (cctx->successorWorkers[n].cctx != NULL)
+            (void)TRACE_attach(&cctx->successorWorkers[n].cctx->opCtx, NULL);
+    }
+    return TRACE_attach(&cctx->opCtx, tracer);
+}
+
 ZL_Report ZL_CCtx_setParameter(ZL_CCtx* cctx, ZL_CParam gcparam, int value)
 {
     ZL_ASSERT_NN(cctx);
@@ -361,6 +453,16 @@ ZL_Report CCTX_setAppliedParameters(ZL_CCtx* cctx)
     return GCParams_finalize(dst);
 }
 
+ZL_Report CCTX_transferStartingGraphParams(ZL_CCtx* cctx, Arena* arena)
+{
+    ZL_ASSERT_NN(cctx);
+    GCParams* const applied = &cctx->appliedGCParams;
+    if (!applied->explicitStart)
+        return ZL_returnSuccess();
+    return GCParams_setStartingGraphID(
+            applied, applied->startingGraphID, applied->rgp, arena);
+}
+
 void CCTX_setDst(
         ZL_CCtx* cctx,
         void* dst,
@@ -377,6 +479,110 @@ void CCTX_setDst(
     cctx->dstBuffer        = dst;
     cctx->dstCapacity      = dstCapacity;
     cctx->currentFrameSize = writtenSize;
+    cctx->dstFlushed       = 0;
+}
+
+void* CCTX_setSink(ZL_CCtx* cctx, const ZL_WriteSink* sink, size_t capacity)
+{
+    ZL_ASSERT_NN(cctx);
+    ZL_ASSERT_NN(sink);
+    ZL_ASSERT_NN(sink->write);
+    if (VECTOR_SIZE(cctx->sinkStaging) < capacity
+        && VECTOR_RESIZE_UNINITIALIZED(cctx->sinkStaging, capacity)
+                < capacity) {
+        return NULL;
+    }
+    cctx->sink = *sink;
+    return VECTOR_DATA(cctx->sinkStaging);
+}
+
+/* Where the frame continues within dstBuffer */
+static uint8_t* CCTX_dstPtr(const ZL_CCtx* cctx)
+{
+    ZL_ASSERT_LE(cctx->dstFlushed, cctx->currentFrameSize);
+    return (uint8_t*)cctx->dstBuffer
+            + (cctx->currentFrameSize - cctx->dstFlushed);
+}
+
+static size_t CCTX_dstAvail(const ZL_CCtx* cctx)
+{
+    size_t const used = cctx->currentFrameSize - cctx->dstFlushed;
+    ZL_ASSERT_LE(used, cctx->dstCapacity);
+    return cctx->dstCapacity - used;
+}
+
+/* Ensures @p size bytes can be written at CCTX_dstPtr().
+ * When writing into a sink, the staging buffer grows as needed. */
+static ZL_Report CCTX_reserveDst(ZL_CCtx* cctx, size_t size)
+{
+    if (CCTX_dstAvail(cctx) >= size)
+        return ZL_returnSuccess();
+    ZL_RET_R_IF_NULL(dstCapacity_tooSmall, cctx->sink.write);
+    size_t const used     = cctx->currentFrameSize - cctx->dstFlushed;
+    size_t const capacity = ZL_MAX(used + size, 2 * cctx->dstCapacity);
+    ZL_RET_R_IF_LT(
+            allocation,
+            VECTOR_RESIZE_UNINITIALIZED(cctx->sinkStaging, capacity),
+            capacity);
+    cctx->dstBuffer   = VECTOR_DATA(cctx->sinkStaging);
+    cctx->dstCapacity = capacity;
+    return ZL_returnSuccess();
+}
+
+ZL_Report CCTX_flushSink(ZL_CCtx* cctx)
+{
+    size_t const used = cctx->currentFrameSize - cctx->dstFlushed;
+    if (cctx->sink.write == NULL || used == 0)
+        return ZL_returnSuccess();
+    ZL_RET_R_IF_NE(
+            GENERIC,
+            cctx->sink.write(cctx->sink.opaque, cctx->dstBuffer, used),
+            0,
+            "write sink failed");
+    cctx->dstFlushed = cctx->currentFrameSize;
+    return ZL_returnSuccess();
+}
+
+/* Segments at least this large are handed directly to the sink,
+ * smaller ones are gathered into the staging buffer. */
+#define CCTX_SINK_SEGMENT_MIN 512
+
+/* Appends @p size bytes from @p src to the frame */
+static ZL_Report
+CCTX_appendToFrame(ZL_CCtx* cctx, const void* src, size_t size)
+{
+    if (size == 0) // allows NULL src ptrs
+        return ZL_returnSuccess();
+    ZL_ASSERT_NN(src);
+    if (cctx->sink.write != NULL && size >= CCTX_SINK_SEGMENT_MIN) {
+        ZL_RET_R_IF_ERR(CCTX_flushSink(cctx));
+        ZL_RET_R_IF_NE(
+                GENERIC,
+                cctx->sink.write(cctx->sink.opaque, src, size),
+                0,
+                "write sink failed");
+        cctx->currentFrameSize += size;
+        cctx->dstFlushed = cctx->currentFrameSize;
+        return ZL_returnSuccess();
+    }
+    ZL_RET_R_IF_ERR(CCTX_reserveDst(cctx, size));
+    ZL_memcpy(CCTX_dstPtr(cctx), src, size);
+    cctx->currentFrameSize += size;
+    return ZL_returnSuccess();
+}
+
+/* Hashes the part of the frame which remains in dstBuffer,
+ * from frame position @p *hashedPos onwards. */
+static void
+CCTX_hashDst(const ZL_CCtx* cctx, XXH3_state_t* state, size_t* hashedPos)
+{
+    ZL_ASSERT_GE(*hashedPos, cctx->dstFlushed);
+    ZL_ASSERT_LE(*hashedPos, cctx->currentFrameSize);
+    (void)XXH3_64bits_update(
+            state,
+            (const uint8_t*)cctx->dstBuffer + (*hashedPos - cctx->dstFlushed),
+            cctx->currentFrameSize - *hashedPos);
+    *hashedPos = cctx->currentFrameSize;
 }
 
 // @return a read stream by its RTStreamID.
@@ -641,13 +847,6 @@ static size_t GCTX_getNbSuccessors(const ZL_Graph* gctx)
     return nbStreamsWithSuccessors;
 }
 
-typedef struct {
-    ZL_GraphID graphID;
-    const ZL_RuntimeGraphParameters* rgp;
-    const RTStreamID* rtInputs;
-    size_t nbInputs;
-} SuccessorInfo;
-
 /* Implementation notes :
  * - @successorsArray is allocated and owned by the caller,
  *   currently CCTX_runGraph_internal().
@@ -697,6 +896,215 @@ static void GCTX_getSuccessors(
     }
 }
 
+/* Successors can run in parallel when they don't depend on state shared
+ * with the parent CCtx: Segmenters need the session's inputs, introspection
+ * hooks expect a serial traversal, and permissive mode reports backups as
+ * warnings of the parent's operation. */
+static int CCTX_canRunSuccessorsInParallel(
+        const ZL_CCtx* cctx,
+        const SuccessorInfo* successorArray,
+        size_t nbSuccessors)
+{
+    if (nbSuccessors < 2 || CCTX_getNbChunkWorkers(cctx) < 2)
+        return 0;
+    if (cctx->opCtx.hasIntrospectionHooks)
+        return 0;
+    if (CCTX_getAppliedGParam(cctx, ZL_CParam_permissiveCompression)
+        == ZL_TernaryParam_enable)
+        return 0;
+    for (size_t n = 0; n < nbSuccessors; n++) {
+        if (CGRAPH_graphType(cctx->cgraph, successorArray[n].graphID)
+            == gt_segmenter)
+            return 0;
+    }
+    return 1;
+}
+
+static size_t CCTX_successorInputSize(
+        const ZL_CCtx* cctx,
+        const SuccessorInfo* si)
+{
+    size_t size = 0;
+    for (size_t n = 0; n < si->nbInputs; n++) {
+        size += ZL_Data_contentSize(
+                RTGM_getRStream(&cctx->rtgraph, si->rtInputs[n]));
+    }
+    return size;
+}
+
+/* Runs on a worker thread.
+ * Only accesses the worker's own state, and read-only shared resources
+ * (Compressor, parent's Streams). */
+static void CCTX_successorWorkerTask(void* taskCtx, size_t taskID)
+{
+    CCTX_SuccessorWorker* const worker =
+            (CCTX_SuccessorWorker*)taskCtx + taskID;
+    for (size_t n = 0; n < worker->nbSuccessors; n++) {
+        const SuccessorInfo* const si = worker->successors + n;
+        worker->result                = CCTX_runSuccessor(
+                worker->cctx,
+                si->graphID,
+                si->rgp,
+                si->rtInputs,
+                si->nbInputs,
+                worker->depth + 1);
+        if (ZL_isError(worker->result))
+            return;
+    }
+}
+
+static ZL_Report CCTX_reserveSuccessorWorkers(ZL_CCtx* cctx, size_t nbWorkers)
+{
+    if (nbWorkers <= cctx->nbSuccessorWorkers)
+        return ZL_returnSuccess();
+    CCTX_SuccessorWorker* const workers =
+            ZL_calloc(nbWorkers * sizeof(CCTX_SuccessorWorker));
+    ZL_RET_R_IF_NULL(allocation, workers);
+    if (cctx->nbSuccessorWorkers) {
+        ZL_memcpy(
+                workers,
+                cctx->successorWorkers,
+                cctx->nbSuccessorWorkers * sizeof(CCTX_SuccessorWorker));
+    }
+    ZL_free(cctx->successorWorkers);
+    cctx->successorWorkers   = workers;
+    cctx->nbSuccessorWorkers = nbWorkers;
+    return ZL_returnSuccess();
+}
+
+/* Synchronize worker's state with its parent's current Chunk,
+ * and reference the Inputs of its batch at their parent's Stream IDs */
+static ZL_Report CCTX_prepareSuccessorWorker(
+        ZL_CCtx* cctx,
+        CCTX_SuccessorWorker* worker,
+        const SuccessorInfo* successors,
+        size_t nbSuccessors,
+        unsigned depth)
+{
+    if (worker->cctx == NULL) {
+        worker->cctx = CCTX_createDerivedCCtx(cctx);
+        ZL_RET_R_IF_NULL(allocation, worker->cctx);
+    }
+    ZL_CCtx* const wcctx    = worker->cctx;
+    wcctx->cgraph           = cctx->cgraph;
+    wcctx->appliedGCParams  = cctx->appliedGCParams;
+    wcctx->inputs           = cctx->inputs;
+    wcctx->nbInputs         = cctx->nbInputs;
+    wcctx->segmenterStarted = 1;
+    wcctx->inBackupMode     = cctx->inBackupMode;
+    ZL_OC_startOperation(&wcctx->opCtx, ZL_Operation_compress);
+    TRACE_inherit(&wcctx->opCtx, &cctx->opCtx);
+
+    size_t nbInputs = 0;
+    for (size_t n = 0; n < nbSuccessors; n++) {
+        nbInputs += successors[n].nbInputs;
+    }
+    ALLOC_ARENA_MALLOC_CHECKED(RTStreamID, rtsids, nbInputs, wcctx->chunkArena);
+    for (size_t n = 0, i = 0; n < nbSuccessors; n++) {
+        ZL_memcpy(
+                rtsids + i,
+                successors[n].rtInputs,
+                successors[n].nbInputs * sizeof(RTStreamID));
+        i += successors[n].nbInputs;
+    }
+    ZL_RET_R_IF_ERR(
+            RTGM_fork(&wcctx->rtgraph, &cctx->rtgraph, rtsids, nbInputs));
+
+    worker->successors   = successors;
+    worker->nbSuccessors = nbSuccessors;
+    worker->forkBase     = RTGM_getNbStreams(&cctx->rtgraph);
+    worker->depth        = depth;
+    worker->result       = ZL_returnSuccess();
+    return ZL_returnSuccess();
+}
+
+/* Splits Successors into contiguous batches of similar input size,
+ * one per worker, and runs them concurrently.
+ * Each batch builds its part of the RTGraph exactly as serial execution
+ * would, and batches are merged back in order, so the resulting Nodes,
+ * Streams and transform headers are identical to serial mode.
+ *
+ * Note: Successors' Inputs are not released from the parent's RTGraph,
+ * since Streams created by workers may reference them without refcount.
+ * They are released at the end of the Chunk. */
+static ZL_Report CCTX_runSuccessorsInParallel(
+        ZL_CCtx* cctx,
+        const SuccessorInfo* successorArray,
+        size_t nbSuccessors,
+        unsigned depth)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+    size_t const nbChunkWorkers = CCTX_getNbChunkWorkers(cctx);
+    size_t const nbWorkers =
+            nbChunkWorkers < nbSuccessors ? nbChunkWorkers : nbSuccessors;
+    ZL_DLOG(BLOCK,
+            "CCTX_runSuccessorsInParallel (%zu successors, %zu workers)",
+            nbSuccessors,
+            nbWorkers);
+    size_t const firstWorker = cctx->nbUsedSuccessorWorkers;
+    ZL_ERR_IF_ERR(CCTX_reserveSuccessorWorkers(cctx, firstWorker + nbWorkers));
+    CCTX_SuccessorWorker* const workers = cctx->successorWorkers + firstWorker;
+    cctx->nbUsedSuccessorWorkers        = firstWorker + nbWorkers;
+
+    size_t remainingSize = 0;
+    for (size_t n = 0; n < nbSuccessors; n++) {
+        remainingSize += CCTX_successorInputSize(cctx, successorArray + n);
+    }
+    for (size_t w = 0, start = 0; w < nbWorkers; w++) {
+        // Leave at least one Successor per remaining worker
+        size_t const maxEnd = nbSuccessors - (nbWorkers - 1 - w);
+        size_t const target = remainingSize / (nbWorkers - w);
+        size_t batchSize    = 0;
+        size_t end          = start;
+        do {
+            batchSize += CCTX_successorInputSize(cctx, successorArray + end);
+            end++;
+        } while (end < maxEnd && (batchSize < target || w == nbWorkers - 1));
+        remainingSize -= batchSize;
+        ZL_ERR_IF_ERR(CCTX_prepareSuccessorWorker(
+                cctx, &workers[w], successorArray + start, end - start, depth));
+        start = end;
+    }
+
+    cctx->workerPool.runTasks(
+            cctx->workerPool.opaque,
+            CCTX_successorWorkerTask,
+            workers,
+            nbWorkers);
+
+    for (size_t w = 0; w < nbWorkers; w++) {
+        if (ZL_isError(workers[w].result)) {
+            // Nothing merged yet: workers can be released
+            for (size_t n = 0; n < nbWorkers; n++) {
+                CCTX_cleanChunk(workers[n].cctx);
+            }
+            cctx->nbUsedSuccessorWorkers = firstWorker;
+            ZL_ERR_IF_ERR(
+                    workers[w].result,
+                    "Successor batch %zu/%zu failed",
+                    w,
+                    nbWorkers);
+        }
+    }
+
+    // Merge batches back into the parent, in order
+    for (size_t w = 0; w < nbWorkers; w++) {
+        ZL_CCtx* const wcctx = workers[w].cctx;
+        ZL_TRY_LET_R(
+                headerOffset,
+                appendToVector(
+                        &cctx->trHeaders.stagingHeaderStream,
+                        ZL_RBuffer_fromVector(
+                                &wcctx->trHeaders.stagingHeaderStream)));
+        ZL_ERR_IF_ERR(RTGM_merge(
+                &cctx->rtgraph,
+                &wcctx->rtgraph,
+                workers[w].forkBase,
+                headerOffset));
+    }
+    return ZL_returnSuccess();
+}
+
 /* Invoked from CCTX_runGraph_internal() */
 static ZL_Report CCTX_runSuccessors(
         ZL_CCtx* cctx,
@@ -705,6 +1113,10 @@ static ZL_Report CCTX_runSuccessors(
         unsigned depth)
 {
     ZL_DLOG(SEQ, "CCTX_runSuccessors on %zu successors", nbSuccessors);
+    if (CCTX_canRunSuccessorsInParallel(cctx, successorArray, nbSuccessors)) {
+        return CCTX_runSuccessorsInParallel(
+                cctx, successorArray, nbSuccessors, depth);
+    }
     for (size_t n = 0; n < nbSuccessors; n++) {
         const SuccessorInfo* const si = successorArray + n;
         ZL_RET_R_IF_ERR(CCTX_runSuccessor(
@@ -731,7 +1143,7 @@ static ZL_Report CCTX_runGraph_internal(
         size_t nbInputs,
         unsigned depth)
 {
-    (void)graphid; // required only for waypoints
+    (void)graphid; // required only for waypoints and tracing
     // All streams created after this index will be created by the dynamic
     // graph
     WAYPOINT(
@@ -741,8 +1153,27 @@ static ZL_Report CCTX_runGraph_internal(
             graphid,
             inputs,
             nbInputs);
+    // Inputs are measured upfront, since the graph may release them
+    ZL_TraceRing* const traceRing = TRACE_RING(cctx);
+    size_t traceBytesIn           = 0;
+    if (traceRing != NULL) {
+        for (size_t n = 0; n < nbInputs; n++) {
+            traceBytesIn += ZL_Input_contentSize(ZL_Edge_getData(inputs[n]));
+        }
+    }
+    uint64_t const traceStart = TRACE_start(traceRing);
     ZL_Report const graphExecutionReport =
             GCTX_runMultiInputGraph(gctx, inputs, nbInputs);
+    if (traceRing != NULL) {
+        TRACE_record(
+                traceRing,
+                ZL_TraceEventType_graphEncode,
+                graphid.gid,
+                gctx->dgd->name,
+                traceStart,
+                traceBytesIn,
+                0);
+    }
     IF_WAYPOINT_ENABLED(on_migraphEncode_end, gctx)
     {
         if (ZL_isError(graphExecutionReport)) {
@@ -1212,16 +1643,72 @@ ZL_Report CCTX_runSuccessor(
     return r;
 }
 
-/* Expectation :
+/* Appends the description of the chunk just written to the seek table,
+ * if enabled. @p inputs are the inputs of this chunk. */
+static ZL_Report CCTX_recordChunk(
+        ZL_CCtx* cctx,
+        size_t chunkSize,
+        const ZL_Data* inputs[],
+        size_t nbInputs)
+{
+    if (CCTX_getAppliedGParam(cctx, ZL_CParam_seekTable)
+        != ZL_TernaryParam_enable)
+        return ZL_returnSuccess();
+    size_t const pos     = VECTOR_SIZE(cctx->seekEntries);
+    size_t const maxSize = pos + (1 + 2 * nbInputs) * ZL_VARINT_LENGTH_64;
+    ZL_RET_R_IF_LT(
+            allocation,
+            VECTOR_RESIZE_UNINITIALIZED(cctx->seekEntries, maxSize),
+            maxSize);
+    uint8_t* const start = VECTOR_DATA(cctx->seekEntries) + pos;
+    uint8_t* ptr         = start;
+    ptr += ZL_varintEncode(chunkSize, ptr);
+    for (size_t n = 0; n < nbInputs; n++) {
+        ptr += ZL_varintEncode(ZL_Data_contentSize(inputs[n]), ptr);
+        ptr += ZL_varintEncode(ZL_Data_numElts(inputs[n]), ptr);
+    }
+    // Shrinking can't fail
+    (void)VECTOR_RESIZE_UNINITIALIZED(
+            cctx->seekEntries, pos + (size_t)(ptr - start));
+    cctx->nbSeekEntries++;
+    return ZL_returnSuccess();
+}
+
+/* Writes the seek table after the end-of-frame marker.
+ * Format is described in wire_format.h */
+static ZL_Report CCTX_writeSeekTable(ZL_CCtx* cctx)
+{
+    size_t const entriesSize = VECTOR_SIZE(cctx->seekEntries);
+    size_t const tableSize   = ZL_varintSize(cctx->nbSeekEntries) + entriesSize;
+    ZL_DLOG(FRAME,
+            "CCTX_writeSeekTable (%zu chunks, %zu bytes)",
+            cctx->nbSeekEntries,
+            tableSize);
+    ZL_RET_R_IF_GT(temporaryLibraryLimitation, tableSize, UINT32_MAX);
+    ZL_RET_R_IF_ERR(
+            CCTX_reserveDst(cctx, tableSize + ZL_SEEK_TABLE_FOOTER_SIZE));
+    uint8_t* const dst  = CCTX_dstPtr(cctx);
+    size_t const nbSize = ZL_varintEncode(cctx->nbSeekEntries, dst);
+    if (entriesSize) {
+        ZL_memcpy(dst + nbSize, VECTOR_DATA(cctx->seekEntries), entriesSize);
+    }
+    ZL_writeLE32(dst + tableSize, (uint32_t)tableSize);
+    cctx->currentFrameSize += tableSize + ZL_SEEK_TABLE_FOOTER_SIZE;
+    return ZL_returnSuccess();
+}
+
+/* Runs the starting Graph on @p inputs,
+ * appending the resulting Chunk(s) to the frame being written.
+ * Expectation :
  * - cctx is non null
  * - a compressor is set
  * - applied parameters set
  */
-ZL_Report
-CCTX_startCompression(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
+static ZL_Report
+CCTX_compressInputs(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
 {
     ZL_DLOG(FRAME,
-            "CCTX_startCompression (%zu inputs; input[0].size = %zu)",
+            "CCTX_compressInputs (%zu inputs; input[0].size = %zu)",
             nbInputs,
             ZL_Data_contentSize(inputs[0]));
     ZL_ASSERT_NN(cctx);
@@ -1286,23 +1773,85 @@ CCTX_startCompression(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
         ZL_ERR_IF_ERR(CCTX_flushChunk(cctx, inputs, nbInputs));
     }
 
-    // Frame footer
+    return ZL_returnValue(cctx->currentFrameSize);
+}
+
+static void CCTX_resetFrame(ZL_CCtx* cctx, int unknownContentSize)
+{
+    cctx->unknownContentSize = unknownContentSize;
+    cctx->nbSeekEntries      = 0;
+    VECTOR_CLEAR(cctx->seekEntries);
+}
+
+ZL_Report CCTX_writeFrameFooter(ZL_CCtx* cctx)
+{
+    ZL_ASSERT_NN(cctx);
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
     if (CCTX_getAppliedGParam(cctx, ZL_CParam_formatVersion)
         >= ZL_CHUNK_VERSION_MIN) {
         // Append end-of-frame marker
-        ZL_ASSERT_LE(cctx->currentFrameSize, cctx->dstCapacity);
-        ZL_ERR_IF_LT(
-                cctx->dstCapacity - cctx->currentFrameSize,
-                1,
-                dstCapacity_tooSmall);
-        ZL_write8((char*)cctx->dstBuffer + cctx->currentFrameSize, 0);
+        ZL_ERR_IF_ERR(CCTX_reserveDst(cctx, 1));
+        ZL_write8(CCTX_dstPtr(cctx), 0);
         cctx->currentFrameSize += 1;
+
+        if (CCTX_getAppliedGParam(cctx, ZL_CParam_seekTable)
+            == ZL_TernaryParam_enable) {
+            ZL_ERR_IF_ERR(CCTX_writeSeekTable(cctx));
+        }
     }
+    return ZL_returnValue(cctx->currentFrameSize);
+}
+
+size_t CCTX_frameFooterBound(const ZL_CCtx* cctx)
+{
+    ZL_ASSERT_NN(cctx);
+    return 1 + ZL_VARINT_LENGTH_64 + VECTOR_SIZE(cctx->seekEntries)
+            + ZL_SEEK_TABLE_FOOTER_SIZE;
+}
+
+ZL_Report
+CCTX_startCompression(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
+{
+    ZL_DLOG(FRAME, "CCTX_startCompression (%zu inputs)", nbInputs);
+    ZL_ASSERT_NN(cctx);
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+
+    CCTX_resetFrame(cctx, /* unknownContentSize */ 0);
+    ZL_ERR_IF_ERR(CCTX_compressInputs(cctx, inputs, nbInputs));
+    ZL_ERR_IF_ERR(CCTX_writeFrameFooter(cctx));
     ZL_DLOG(FRAME, "Final compressed size: %zu", cctx->currentFrameSize);
 
     return ZL_returnValue(cctx->currentFrameSize);
 }
 
+void CCTX_startStreamFrame(ZL_CCtx* cctx)
+{
+    ZL_ASSERT_NN(cctx);
+    CCTX_resetFrame(cctx, /* unknownContentSize */ 1);
+}
+
+ZL_Report
+CCTX_compressBlock(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
+{
+    ZL_DLOG(FRAME, "CCTX_compressBlock (%zu inputs)", nbInputs);
+    ZL_ASSERT_NN(cctx);
+    ZL_ASSERT(cctx->unknownContentSize);
+    return CCTX_compressInputs(cctx, inputs, nbInputs);
+}
+
+CSTREAM_State* CCTX_getStreamState(const ZL_CCtx* cctx)
+{
+    ZL_ASSERT_NN(cctx);
+    return cctx->cstream;
+}
+
+void CCTX_setStreamState(ZL_CCtx* cctx, CSTREAM_State* cstream)
+{
+    ZL_ASSERT_NN(cctx);
+    ZL_ASSERT_NULL(cctx->cstream);
+    cctx->cstream = cstream;
+}
+
 void* CCTX_getWPtrFromNewStream(
         ZL_CCtx* cctx,
         RTNodeID rtnodeid,
@@ -1476,6 +2025,7 @@ static ZL_Report CCTX_writeChunkHeader(
         .hasCompressedChecksum =
                 CCTX_getAppliedGParam(cctx, ZL_CParam_compressedChecksum)
                 != ZL_TernaryParam_disable,
+        .unknownContentSize = cctx->unknownContentSize,
     };
     return EFH_writeChunkHeader(dst, dstCapacity, &info, gi, formatVersion);
 }
@@ -1492,42 +2042,67 @@ CCTX_flushChunk(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
     GraphInfo gi;
     ZL_ERR_IF_ERR(CCTX_getFinalGraph(cctx, &gi));
 
+    if (cctx->unknownContentSize) {
+        // The chunk header describes the inputs of this chunk
+        ALLOC_ARENA_MALLOC_CHECKED(
+                InputDesc, chunkDescs, nbInputs, cctx->chunkArena);
+        for (size_t n = 0; n < nbInputs; n++) {
+            chunkDescs[n].byteSize = ZL_Data_contentSize(inputs[n]);
+            chunkDescs[n].type     = ZL_Data_type(inputs[n]);
+            chunkDescs[n].numElts  = ZL_Data_numElts(inputs[n]);
+        }
+        gi.inputDescs      = chunkDescs;
+        gi.nbSessionInputs = nbInputs;
+    }
+
     // Write chunk header
-    void* const dst             = cctx->dstBuffer;
-    size_t const capacity       = cctx->dstCapacity;
     size_t const startFrameSize = cctx->currentFrameSize;
-    size_t frameSize            = startFrameSize;
-    ZL_ASSERT_LE(frameSize, capacity);
-
+    if (cctx->sink.write != NULL) {
+        ZL_TRY_LET(size_t, chhBound, EFH_chunkHeaderBound(&gi));
+        ZL_ERR_IF_ERR(CCTX_reserveDst(cctx, chhBound));
+    }
     {
         ZL_TRY_LET(
                 size_t,
                 chhSize,
                 CCTX_writeChunkHeader(
-                        cctx,
-                        (char*)dst + startFrameSize,
-                        capacity - startFrameSize,
-                        &gi));
+                        cctx, CCTX_dstPtr(cctx), CCTX_dstAvail(cctx), &gi));
         ZL_LOG(SEQ,
                "wrote %zu chunk header bytes into buffer of capacity %zu",
                chhSize,
-               capacity - startFrameSize);
-        ZL_ASSERT_LE(chhSize, capacity - startFrameSize);
-        frameSize += chhSize;
+               CCTX_dstAvail(cctx));
+        ZL_ASSERT_LE(chhSize, CCTX_dstAvail(cctx));
+        cctx->currentFrameSize += chhSize;
     }
 
-    // Copy final buffers(s)
+    // The compressed checksum is computed progressively,
+    // since stored buffers may be written directly into the sink
+    int const hasCompressedChecksum =
+            CCTX_getAppliedGParam(cctx, ZL_CParam_compressedChecksum)
+            != ZL_TernaryParam_disable;
+    size_t hashedPos = startFrameSize;
+    if (CCTX_getAppliedGParam(cctx, ZL_CParam_formatVersion)
+        < ZL_CHUNK_VERSION_MIN) {
+        /* versions < ZL_CHUNK_VERSION_MIN checksum the entire frame */
+        hashedPos = 0;
+    }
+    XXH3_state_t hashState;
+    if (hasCompressedChecksum) {
+        (void)XXH3_64bits_reset(&hashState);
+    }
+
+    // Append final buffers(s)
     size_t const nbStoredBuffs = gi.nbStoredBuffs;
     for (size_t n = 0; n < nbStoredBuffs; n++) {
-        size_t const lbsize = gi.storedBuffs[n].size;
+        const void* const lbstart = gi.storedBuffs[n].start;
+        size_t const lbsize       = gi.storedBuffs[n].size;
         ZL_DLOG(FRAME, "writing buffer %zu of size %zu bytes", n, lbsize);
-        ZL_ASSERT_LE(frameSize, capacity);
-        ZL_ERR_IF_GT(lbsize, capacity - frameSize, dstCapacity_tooSmall);
-        if (lbsize) { // no need to copy when size==0, allows NULL src ptrs
-            ZL_ASSERT_NN(gi.storedBuffs[n].start);
-            memcpy((char*)dst + frameSize, gi.storedBuffs[n].start, lbsize);
+        if (hasCompressedChecksum && lbsize) {
+            CCTX_hashDst(cctx, &hashState, &hashedPos);
+            (void)XXH3_64bits_update(&hashState, lbstart, lbsize);
+            hashedPos += lbsize;
         }
-        frameSize += lbsize;
+        ZL_ERR_IF_ERR(CCTX_appendToFrame(cctx, lbstart, lbsize));
     }
 
     // Block footer
@@ -1537,7 +2112,7 @@ CCTX_flushChunk(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
         ZL_ASSERT_EQ(
                 CCTX_getAppliedGParam(cctx, ZL_CParam_contentChecksum),
                 ZL_TernaryParam_enable);
-        ZL_RET_R_IF_LT(dstCapacity_tooSmall, capacity - frameSize, 4);
+        ZL_ERR_IF_ERR(CCTX_reserveDst(cctx, 4));
         uint32_t const formatVersion =
                 (uint32_t)CCTX_getAppliedGParam(cctx, ZL_CParam_formatVersion);
         ZL_TRY_LET(
@@ -1545,39 +2120,27 @@ CCTX_flushChunk(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs)
                 hashT,
                 STREAM_hashLastCommit_xxh3low32(
                         inputs, nbInputs, formatVersion));
-        ZL_writeCE32((char*)dst + frameSize, (uint32_t)hashT);
+        ZL_writeCE32(CCTX_dstPtr(cctx), (uint32_t)hashT);
         ZL_DLOG(SEQ, "chunk content checksum: %08X", (uint32_t)hashT);
-        frameSize += 4;
+        cctx->currentFrameSize += 4;
     }
 
     // Append block compressed checksum
-    if (CCTX_getAppliedGParam(cctx, ZL_CParam_compressedChecksum)
-        != ZL_TernaryParam_disable) {
+    if (hasCompressedChecksum) {
         ZL_ASSERT_EQ(
                 CCTX_getAppliedGParam(cctx, ZL_CParam_compressedChecksum),
                 ZL_TernaryParam_enable);
-        ZL_RET_R_IF_LT(dstCapacity_tooSmall, capacity - frameSize, 4);
-        size_t startHashPosition = startFrameSize;
-        if (CCTX_getAppliedGParam(cctx, ZL_CParam_formatVersion)
-            < ZL_CHUNK_VERSION_MIN) {
-            /* versions < ZL_CHUNK_VERSION_MIN checksum the entire frame */
-            startHashPosition = 0;
-        }
-        ZL_ASSERT_LE(startHashPosition, frameSize);
-        ZL_DLOG(SEQ,
-                "compressed checksum from pos %zu to %zu",
-                startHashPosition,
-                frameSize);
-        uint32_t const hash = (uint32_t)XXH3_64bits(
-                (const char*)dst + startHashPosition,
-                frameSize - startHashPosition);
-        ZL_writeCE32((char*)dst + frameSize, hash);
+        ZL_ERR_IF_ERR(CCTX_reserveDst(cctx, 4));
+        CCTX_hashDst(cctx, &hashState, &hashedPos);
+        uint32_t const hash = (uint32_t)XXH3_64bits_digest(&hashState);
+        ZL_writeCE32(CCTX_dstPtr(cctx), hash);
         ZL_DLOG(SEQ, "chunk compressed checksum: %08X", hash);
-        frameSize += 4;
+        cctx->currentFrameSize += 4;
     }
 
-    // Update dest buffer info
-    cctx->currentFrameSize = frameSize;
+    size_t const frameSize = cctx->currentFrameSize;
+    ZL_ERR_IF_ERR(CCTX_recordChunk(
+            cctx, frameSize - startFrameSize, inputs, nbInputs));
 
     return ZL_returnValue(frameSize - startFrameSize);
 }
@@ -1708,6 +2271,181 @@ ZL_Report CCTX_getFinalGraph(ZL_CCtx* cctx, GraphInfo* gip)
     return ZL_returnSuccess();
 }
 
+size_t CCTX_getNbChunkWorkers(const ZL_CCtx* cctx)
+{
+    ZL_ASSERT_NN(cctx);
+    if (cctx->workerPool.runTasks == NULL)
+        return 1;
+    int const nbWorkers = CCTX_getAppliedGParam(cctx, ZL_CParam_nbWorkers);
+    return (nbWorkers > 1) ? (size_t)nbWorkers : 1;
+}
+
+void CCTX_runTasks(
+        ZL_CCtx* cctx,
+        ZL_WorkerTaskFn task,
+        void* taskCtx,
+        size_t nbTasks)
+{
+    ZL_ASSERT_NN(cctx);
+    ZL_ASSERT_NN(task);
+    ZL_DLOG(BLOCK, "CCTX_runTasks (%zu tasks)", nbTasks);
+    if (nbTasks > 1 && CCTX_getNbChunkWorkers(cctx) > 1) {
+        cctx->workerPool.runTasks(
+                cctx->workerPool.opaque, task, taskCtx, nbTasks);
+        return;
+    }
+    for (size_t n = 0; n < nbTasks; n++) {
+        task(taskCtx, n);
+    }
+}
+
+/* Upper bound of the compressed size of a single Chunk,
+ * including its chunk header and checksums. */
+static size_t CCTX_chunkBound(const CCTX_ChunkJob* job)
+{
+    size_t totalSize = 0;
+    for (size_t n = 0; n < job->nbInputs; n++) {
+        totalSize += ZL_Data_contentSize(job->inputs[n]);
+        if (ZL_Data_type(job->inputs[n]) == ZL_Type_string) {
+            totalSize += ZL_Data_numElts(job->inputs[n]) * sizeof(uint32_t);
+        }
+    }
+    return ZL_compressBound(totalSize);
+}
+
+static ZL_Report CCTX_compressChunk_internal(
+        ZL_CCtx* cctx,
+        const CCTX_ChunkJob* job)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+    ALLOC_ARENA_MALLOC_CHECKED(
+            RTStreamID, rtsids, job->nbInputs, cctx->chunkArena);
+    RTGM_reset(&cctx->rtgraph);
+    for (size_t n = 0; n < job->nbInputs; n++) {
+        ZL_TRY_LET(
+                RTStreamID,
+                rtsid,
+                RTGM_refInput(&cctx->rtgraph, job->inputs[n]));
+        rtsids[n] = rtsid;
+    }
+    // depth 1, same as ZL_Segmenter_processChunk()
+    ZL_ERR_IF_ERR(CCTX_runSuccessor(
+            cctx,
+            job->startingGraphID,
+            job->rgp,
+            rtsids,
+            job->nbInputs,
+            /* depth */ 1));
+    return CCTX_flushChunk(cctx, (void*)job->inputs, job->nbInputs);
+}
+
+/* Runs on a worker thread.
+ * Only accesses the worker's own state, and read-only shared resources
+ * (Compressor, session inputs). */
+static void CCTX_chunkWorkerTask(void* taskCtx, size_t taskID)
+{
+    CCTX_ChunkWorker* const worker = (CCTX_ChunkWorker*)taskCtx + taskID;
+    ZL_CCtx* const wcctx           = worker->cctx;
+    CCTX_setDst(wcctx, worker->dst, worker->dstCapacity, 0);
+    worker->result = CCTX_compressChunk_internal(wcctx, worker->job);
+    CCTX_cleanChunk(wcctx);
+}
+
+static ZL_Report CCTX_reserveChunkWorkers(ZL_CCtx* cctx, size_t nbWorkers)
+{
+    if (nbWorkers <= cctx->nbChunkWorkers)
+        return ZL_returnSuccess();
+    CCTX_ChunkWorker* const workers =
+            ZL_calloc(nbWorkers * sizeof(CCTX_ChunkWorker));
+    ZL_RET_R_IF_NULL(allocation, workers);
+    if (cctx->nbChunkWorkers) {
+        ZL_memcpy(
+                workers,
+                cctx->chunkWorkers,
+                cctx->nbChunkWorkers * sizeof(CCTX_ChunkWorker));
+    }
+    ZL_free(cctx->chunkWorkers);
+    cctx->chunkWorkers   = workers;
+    cctx->nbChunkWorkers = nbWorkers;
+    return ZL_returnSuccess();
+}
+
+/* Synchronize worker's state with its parent's current session */
+static ZL_Report CCTX_prepareChunkWorker(
+        ZL_CCtx* cctx,
+        CCTX_ChunkWorker* worker,
+        const CCTX_ChunkJob* job)
+{
+    if (worker->cctx == NULL) {
+        worker->cctx = CCTX_createDerivedCCtx(cctx);
+        ZL_RET_R_IF_NULL(allocation, worker->cctx);
+    }
+    ZL_CCtx* const wcctx    = worker->cctx;
+    wcctx->cgraph           = cctx->cgraph;
+    wcctx->appliedGCParams  = cctx->appliedGCParams;
+    wcctx->inputs           = cctx->inputs;
+    wcctx->nbInputs         = cctx->nbInputs;
+    wcctx->segmenterStarted = 1; // Chunks can't start a Segmenter
+    wcctx->inBackupMode     = 0;
+    // Chunks are recorded into the seek table by the parent, once stitched
+    wcctx->appliedGCParams.seekTable = ZL_TernaryParam_disable;
+    // Streaming: chunk headers describe their own content size
+    wcctx->unknownContentSize = cctx->unknownContentSize;
+    ZL_OC_startOperation(&wcctx->opCtx, ZL_Operation_compress);
+    TRACE_inherit(&wcctx->opCtx, &cctx->opCtx);
+
+    size_t const chunkBound = CCTX_chunkBound(job);
+    if (worker->dstCapacity < chunkBound) {
+        ZL_free(worker->dst);
+        worker->dstCapacity = 0;
+        worker->dst         = ZL_malloc(chunkBound);
+        ZL_RET_R_IF_NULL(allocation, worker->dst);
+        worker->dstCapacity = chunkBound;
+    }
+    worker->job    = job;
+    worker->result = ZL_returnSuccess();
+    return ZL_returnSuccess();
+}
+
+ZL_Report
+CCTX_compressChunks(ZL_CCtx* cctx, const CCTX_ChunkJob* jobs, size_t nbJobs)
+{
+    ZL_DLOG(BLOCK, "CCTX_compressChunks (%zu chunks)", nbJobs);
+    ZL_ASSERT_NN(cctx);
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+    ZL_ASSERT_NN(cctx->workerPool.runTasks);
+    ZL_ASSERT_LE(nbJobs, CCTX_getNbChunkWorkers(cctx));
+    if (nbJobs == 0)
+        return ZL_returnValue(0);
+
+    ZL_ERR_IF_ERR(CCTX_reserveChunkWorkers(cctx, nbJobs));
+    for (size_t n = 0; n < nbJobs; n++) {
+        ZL_ERR_IF_ERR(CCTX_prepareChunkWorker(
+                cctx, &cctx->chunkWorkers[n], &jobs[n]));
+    }
+
+    cctx->workerPool.runTasks(
+            cctx->workerPool.opaque,
+            CCTX_chunkWorkerTask,
+            cctx->chunkWorkers,
+            nbJobs);
+
+    // Stitch Chunks back into the frame, in order
+    size_t const startFrameSize = cctx->currentFrameSize;
+    for (size_t n = 0; n < nbJobs; n++) {
+        const CCTX_ChunkWorker* const worker = &cctx->chunkWorkers[n];
+        ZL_ERR_IF_ERR(worker->result, "Chunk %zu/%zu failed", n, nbJobs);
+        size_t const chunkSize = ZL_validResult(worker->result);
+        ZL_ERR_IF_ERR(CCTX_appendToFrame(cctx, worker->dst, chunkSize));
+        ZL_ERR_IF_ERR(CCTX_recordChunk(
+                cctx,
+                chunkSize,
+                (void*)worker->job->inputs,
+                worker->job->nbInputs));
+    }
+    return ZL_returnValue(cctx->currentFrameSize - startFrameSize);
+}
+
 ZL_CCtx* CCTX_createDerivedCCtx(const ZL_CCtx* originalCCtx)
 {
     ZL_CCtx* const cctx = CCTX_create();
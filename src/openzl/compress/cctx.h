@@ -3,6 +3,7 @@
 #ifndef ZSTRONG_COMPRESS_CCTX_H
 #define ZSTRONG_COMPRESS_CCTX_H
 
+#include "openzl/compress/compress_stream.h"    // CSTREAM_State
 #include "openzl/compress/encode_frameheader.h" // EFH_FrameInfo, GraphInfo
 #include "openzl/compress/rtgraphs.h"           // RTNodeID
 #include "openzl/shared/portability.h"
@@ -149,6 +150,23 @@ void CCTX_setDst(
         size_t dstCapacity,
         size_t writtenSize);
 
+/**
+ * @brief set @p cctx to hand the frame to @p sink, see
+ * ZL_CCtx_compressMultiTypedRefToSink(). The caller must then write the frame
+ * header into the returned staging buffer, and declare it with CCTX_setDst().
+ * Sink mode lasts until CCTX_clean().
+ *
+ * @return a staging buffer of at least @p capacity bytes,
+ * or NULL on allocation failure.
+ */
+void* CCTX_setSink(ZL_CCtx* cctx, const ZL_WriteSink* sink, size_t capacity);
+
+/**
+ * @brief write the content of the staging buffer into the sink, if any.
+ * Must be invoked once the frame is complete.
+ */
+ZL_Report CCTX_flushSink(ZL_CCtx* cctx);
+
 /**
  * @brief Finalize global parameter values for the current compression session.
  *
@@ -175,6 +193,13 @@ void CCTX_setDst(
  */
 ZL_Report CCTX_setAppliedParameters(ZL_CCtx* cctx);
 
+/**
+ * @brief Copy the runtime parameters of the applied starting graph, if any,
+ * into @p arena, so that they survive CCTX_clean().
+ * Used when a single set of applied parameters spans multiple compressions.
+ */
+ZL_Report CCTX_transferStartingGraphParams(ZL_CCtx* cctx, Arena* arena);
+
 /**
  * @brief Get the finalized value of a soecific global compression parameter.
  *
@@ -252,6 +277,53 @@ ZL_Report CCTX_sendTrHeader(ZL_CCtx* cctx, RTNodeID rtnodeid, ZL_RBuffer trh);
 ZL_Report
 CCTX_startCompression(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t numInputs);
 
+/**
+ * @brief Start a frame which content is provided incrementally.
+ *
+ * Such a frame doesn't know its content size upfront:
+ * each chunk header stores the size of its own content instead.
+ * Content is then appended with CCTX_compressBlock(),
+ * and the frame is closed with CCTX_writeFrameFooter().
+ *
+ * @note the frame header must be written separately by the caller,
+ * stating that content size is unknown.
+ */
+void CCTX_startStreamFrame(ZL_CCtx* cctx);
+
+/**
+ * @brief Compress @p inputs as the next block of a frame started with
+ * CCTX_startStreamFrame(), appending its chunk(s) into the destination buffer
+ * (see CCTX_setDst()). Requires applied parameters.
+ *
+ * @return the total size written into the destination buffer so far,
+ * or an error.
+ */
+ZL_Report
+CCTX_compressBlock(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t numInputs);
+
+/**
+ * @brief Write the frame footer (end-of-frame marker, and optional seek
+ * table) into the destination buffer.
+ *
+ * @return the total size written into the destination buffer so far,
+ * or an error.
+ */
+ZL_Report CCTX_writeFrameFooter(ZL_CCtx* cctx);
+
+/**
+ * @return an upper bound of the size of the frame footer
+ * that CCTX_writeFrameFooter() would write at this point.
+ */
+size_t CCTX_frameFooterBound(const ZL_CCtx* cctx);
+
+/**
+ * Accessors to the streaming compression state owned by @p cctx,
+ * which is NULL until the first invocation of ZL_CCtx_compressStream().
+ * It is released by CCTX_free().
+ */
+CSTREAM_State* CCTX_getStreamState(const ZL_CCtx* cctx);
+void CCTX_setStreamState(ZL_CCtx* cctx, CSTREAM_State* cstream);
+
 /**
  * @brief Execute a transform node with specified parameters and track outputs.
  *
@@ -714,6 +786,59 @@ CCTX_flushChunk(ZL_CCtx* cctx, const ZL_Data* inputs[], size_t nbInputs);
  */
 void CCTX_cleanChunk(ZL_CCtx* cctx);
 
+/**
+ * Description of one Chunk scheduled for compression.
+ * @p inputs are slices of the session's inputs, and must remain valid
+ * until the Chunk is compressed.
+ */
+typedef struct {
+    ZL_Data** inputs;
+    size_t nbInputs;
+    ZL_GraphID startingGraphID;
+    const ZL_RuntimeGraphParameters* rgp; // optional, can be NULL
+} CCTX_ChunkJob;
+
+/**
+ * @brief Number of Chunks, or Successors, that can be compressed concurrently.
+ *
+ * @return the value of ZL_CParam_nbWorkers when a worker pool is attached
+ * and multiple workers are requested, 1 otherwise (single-threaded mode).
+ *
+ * @note Requires applied parameters to be set.
+ */
+size_t CCTX_getNbChunkWorkers(const ZL_CCtx* cctx);
+
+/**
+ * @brief Run @p nbTasks independent tasks, on the worker pool attached to
+ * @p cctx when CCTX_getNbChunkWorkers() > 1, serially otherwise.
+ * Returns once all tasks have completed.
+ *
+ * @note Derived contexts have no worker pool, so tasks never nest.
+ */
+void CCTX_runTasks(
+        ZL_CCtx* cctx,
+        ZL_WorkerTaskFn task,
+        void* taskCtx,
+        size_t nbTasks);
+
+/**
+ * @brief Compress multiple Chunks concurrently, and append them in order.
+ *
+ * Each Chunk is compressed on its own derived context (see
+ * CCTX_createDerivedCCtx()), into a worker-owned buffer, using the worker pool
+ * attached to @p cctx. Once all Chunks are completed, they are appended into
+ * @p cctx's destination buffer, in the order of @p jobs. The result is
+ * byte-identical to invoking CCTX_runSuccessor() + CCTX_flushChunk() on each
+ * Chunk serially.
+ *
+ * @param nbJobs must be <= CCTX_getNbChunkWorkers()
+ *
+ * @return The total size written into @p cctx's destination buffer,
+ * or the first error encountered, in Chunk order.
+ */
+ZL_Report
+CCTX_compressChunks(ZL_CCtx* cctx, const CCTX_ChunkJob* jobs, size_t nbJobs);
+
 /**
  * @brief Clean up compression session state for context reuse.
  *
@@ -19,9 +19,6 @@
 #include "openzl/zl_data.h"
 #include "openzl/zl_errors.h"
 
-#include <stdio.h>
-#include <time.h>
-
 ZL_CCtx* ZL_CCtx_create(void)
 {
     return CCTX_create();
@@ -71,6 +68,8 @@ static ZL_Report writeFrameHeader(
         .hasCompressedChecksum =
                 CCTX_getAppliedGParam(cctx, ZL_CParam_compressedChecksum)
                 != ZL_TernaryParam_disable,
+        .hasSeekTable = CCTX_getAppliedGParam(cctx, ZL_CParam_seekTable)
+                == ZL_TernaryParam_enable,
     };
 
     EFH_FrameInfo const fi = {
@@ -86,10 +85,13 @@ static ZL_Report writeFrameHeader(
     return r;
 }
 
+/* When @p sink is non-NULL, the frame is handed to it,
+ * and @p dst / @p dstCapacity are ignored */
 static ZL_Report CCTX_compressInputs_withGraphSet_stage2(
         ZL_CCtx* cctx,
         void* dst,
         size_t dstCapacity,
+        const ZL_WriteSink* sink,
         const ZL_Data* inputs[],
         size_t nbInputs)
 {
@@ -104,6 +106,13 @@ static ZL_Report CCTX_compressInputs_withGraphSet_stage2(
     // freeze parameters to their final values
     ZL_ERR_IF_ERR(CCTX_setAppliedParameters(cctx));
 
+    if (sink != NULL) {
+        ZL_TRY_LET(size_t, fhBound, EFH_frameHeaderBound(nbInputs));
+        dst = CCTX_setSink(cctx, sink, fhBound);
+        ZL_ERR_IF_NULL(dst, allocation);
+        dstCapacity = fhBound;
+    }
+
     // Write frame header
     ZL_TRY_LET(
             size_t,
@@ -117,16 +126,17 @@ static ZL_Report CCTX_compressInputs_withGraphSet_stage2(
 
     // Pass input(s) to starting Graph, initiating compression
     ZL_TRY_LET(size_t, r, CCTX_startCompression(cctx, inputs, nbInputs));
+    ZL_ERR_IF_ERR(CCTX_flushSink(cctx));
 
     ZL_DLOG(FRAME, "Final compressed size: %zu", r);
     return ZL_returnValue(r);
 }
 
-/* requirement: cctx->graph is set */
-ZL_Report CCTX_compressInputs_withGraphSet(
+static ZL_Report CCTX_compressInputs_withGraphSet_internal(
         ZL_CCtx* cctx,
         void* dst,
         size_t dstCapacity,
+        const ZL_WriteSink* sink,
         const ZL_Data* inputs[],
         size_t nbInputs)
 {
@@ -134,7 +144,7 @@ ZL_Report CCTX_compressInputs_withGraphSet(
     ZL_DLOG(FRAME, "CCTX_compressInputs_withGraphSet");
 
     ZL_Report const r = CCTX_compressInputs_withGraphSet_stage2(
-            cctx, dst, dstCapacity, inputs, nbInputs);
+            cctx, dst, dstCapacity, sink, inputs, nbInputs);
 
     // ensure that Arena memory is always reclaimed at the end,
     // even in cases of errors.
@@ -147,6 +157,18 @@ ZL_Report CCTX_compressInputs_withGraphSet(
     return r;
 }
 
+/* requirement: cctx->graph is set */
+ZL_Report CCTX_compressInputs_withGraphSet(
+        ZL_CCtx* cctx,
+        void* dst,
+        size_t dstCapacity,
+        const ZL_Data* inputs[],
+        size_t nbInputs)
+{
+    return CCTX_compressInputs_withGraphSet_internal(
+            cctx, dst, dstCapacity, NULL, inputs, nbInputs);
+}
+
 static ZL_Report CCTX_compressSerial_withGraphSet(
         ZL_CCtx* cctx,
         void* dst,
@@ -353,6 +375,25 @@ ZL_Report ZL_CCtx_compressMultiTypedRef(
     return rep;
 }
 
+ZL_Report ZL_CCtx_compressMultiTypedRefToSink(
+        ZL_CCtx* cctx,
+        const ZL_WriteSink* sink,
+        const ZL_TypedRef* inputs[],
+        size_t nbInputs)
+{
+    ZL_RET_R_IF_NULL(compressionParameter_invalid, sink);
+    ZL_RET_R_IF_NULL(compressionParameter_invalid, sink->write);
+    ZL_RET_R_IF_NULL(compressionParameter_invalid, inputs);
+    ZL_RET_R_IF_NOT(compressionParameter_invalid, CCTX_isGraphSet(cctx));
+    return CCTX_compressInputs_withGraphSet_internal(
+            cctx,
+            NULL,
+            0,
+            sink,
+            ZL_codemodInputsAsDatas(inputs),
+            nbInputs);
+}
+
 ZL_Report ZL_CCtx_compressTypedRef(
         ZL_CCtx* cctx,
         void* dst,
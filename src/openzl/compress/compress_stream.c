@@ -0,0 +1,363 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+/* Streaming compression : ZL_CCtx_compressStream()
+ *
+ * Input is accumulated into blocks of ZL_CParam_streamBlockSize bytes.
+ * Each block is compressed as a standalone input, producing one or more
+ * Chunk(s) appended to a single frame, which header states that content size
+ * is unknown. Compressed data is staged in an internal buffer when @output
+ * can't receive it directly, so memory usage is bounded by the block size.
+ */
+
+#include "openzl/compress/compress_stream.h"
+#include "openzl/common/allocation.h"
+#include "openzl/common/errors_internal.h"
+#include "openzl/common/logging.h"
+#include "openzl/common/operation_context.h"
+#include "openzl/common/stream.h"               // STREAM_create
+#include "openzl/common/wire_format.h"          // ZL_FrameProperties
+#include "openzl/compress/cctx.h"               // CCTX_compressBlock
+#include "openzl/compress/encode_frameheader.h" // EFH_writeFrameHeader
+#include "openzl/compress/private_nodes.h"      // ZL_GRAPH_SERIAL_COMPRESS
+#include "openzl/shared/mem.h"                  // ZL_memcpy
+#include "openzl/shared/utils.h"                // ZL_MIN
+#include "openzl/zl_compress.h"
+
+typedef enum {
+    CSTREAM_idle = 0,    // no frame started
+    CSTREAM_compressing, // frame header written, accepting input
+    CSTREAM_ending,      // frame footer written, waiting to be flushed
+} CSTREAM_Stage;
+
+struct CSTREAM_State_s {
+    CSTREAM_Stage stage;
+    size_t blockSize;
+    int blockCompressed; // at least one block compressed in current frame
+
+    // Input accumulated, waiting to fill a block
+    uint8_t* inBuff;
+    size_t inCapacity;
+    size_t inSize;
+
+    // Compressed data, waiting to be flushed into output
+    uint8_t* outBuff;
+    size_t outCapacity;
+    size_t outSize;
+    size_t outFlushed;
+
+    // Stores state that must survive the whole frame
+    Arena* frameArena;
+};
+
+static CSTREAM_State* CSTREAM_create(void)
+{
+    CSTREAM_State* const cs = ZL_calloc(sizeof(*cs));
+    if (cs == NULL)
+        return NULL;
+    cs->frameArena = ALLOC_HeapArena_create();
+    if (cs->frameArena == NULL) {
+        ZL_free(cs);
+        return NULL;
+    }
+    return cs;
+}
+
+void CSTREAM_free(CSTREAM_State* cs)
+{
+    if (cs == NULL)
+        return;
+    ZL_free(cs->inBuff);
+    ZL_free(cs->outBuff);
+    ALLOC_Arena_freeArena(cs->frameArena);
+    ZL_free(cs);
+}
+
+static void CSTREAM_resetFrame(CSTREAM_State* cs)
+{
+    cs->stage           = CSTREAM_idle;
+    cs->blockCompressed = 0;
+    cs->inSize          = 0;
+    cs->outSize         = 0;
+    cs->outFlushed      = 0;
+    ALLOC_Arena_freeAll(cs->frameArena);
+}
+
+/* Ensures @p *buff can hold at least @p size bytes.
+ * Content is not preserved. */
+static ZL_Report
+CSTREAM_reserve(uint8_t** buff, size_t* capacity, size_t size)
+{
+    if (*capacity >= size)
+        return ZL_returnSuccess();
+    ZL_free(*buff);
+    *capacity = 0;
+    *buff     = ZL_malloc(size);
+    ZL_RET_R_IF_NULL(allocation, *buff);
+    *capacity = size;
+    return ZL_returnSuccess();
+}
+
+static ZL_GraphID CSTREAM_selectDefaultGraph(
+        ZL_Compressor* compressor,
+        const void* param)
+{
+    (void)compressor;
+    (void)param;
+    return ZL_GRAPH_SERIAL_COMPRESS;
+}
+
+/* Freezes parameters, allocates buffers,
+ * and writes the frame header into the staging buffer */
+static ZL_Report CSTREAM_startFrame(ZL_CCtx* cctx, CSTREAM_State* cs)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+    ZL_ASSERT_EQ(cs->stage, CSTREAM_idle);
+    ZL_OC_startOperation(
+            ZL_CCtx_getOperationContext(cctx), ZL_Operation_compress);
+    if (!CCTX_isGraphSet(cctx)) {
+        ZL_Graph2Desc const defaultGraph = { CSTREAM_selectDefaultGraph,
+                                             NULL };
+        ZL_ERR_IF_ERR(CCTX_setLocalCGraph_usingGraph2Desc(cctx, defaultGraph));
+    }
+    ZL_ERR_IF_ERR(CCTX_setAppliedParameters(cctx));
+
+    uint32_t const formatVersion =
+            (uint32_t)CCTX_getAppliedGParam(cctx, ZL_CParam_formatVersion);
+    ZL_ERR_IF_LT(
+            formatVersion,
+            ZL_UNKNOWN_SIZE_VERSION_MIN,
+            formatVersion_unsupported,
+            "Streaming compression requires format version >= %u",
+            ZL_UNKNOWN_SIZE_VERSION_MIN);
+    // Blocks are compressed one at a time,
+    // with CCTX_clean() reclaiming memory in between
+    ZL_ERR_IF_ERR(CCTX_transferStartingGraphParams(cctx, cs->frameArena));
+
+    cs->blockSize =
+            (size_t)CCTX_getAppliedGParam(cctx, ZL_CParam_streamBlockSize);
+    ZL_ASSERT_GT(cs->blockSize, 0);
+    ZL_ERR_IF_ERR(
+            CSTREAM_reserve(&cs->inBuff, &cs->inCapacity, cs->blockSize));
+    ZL_ERR_IF_ERR(CSTREAM_reserve(
+            &cs->outBuff, &cs->outCapacity, ZL_compressBound(cs->blockSize)));
+
+    ZL_FrameProperties const fprop = {
+        .hasContentChecksum =
+                CCTX_getAppliedGParam(cctx, ZL_CParam_contentChecksum)
+                != ZL_TernaryParam_disable,
+        .hasCompressedChecksum =
+                CCTX_getAppliedGParam(cctx, ZL_CParam_compressedChecksum)
+                != ZL_TernaryParam_disable,
+        .hasSeekTable = CCTX_getAppliedGParam(cctx, ZL_CParam_seekTable)
+                == ZL_TernaryParam_enable,
+        .unknownContentSize = true,
+    };
+    InputDesc const inputDesc = { .type = ZL_Type_serial };
+    EFH_FrameInfo const fi    = {
+           .inputDescs = &inputDesc,
+           .numInputs  = 1,
+           .fprop      = &fprop,
+    };
+    ZL_TRY_LET(
+            size_t,
+            fhSize,
+            EFH_writeFrameHeader(
+                    cs->outBuff, cs->outCapacity, &fi, formatVersion));
+
+    CCTX_startStreamFrame(cctx);
+    cs->outSize    = fhSize;
+    cs->outFlushed = 0;
+    cs->stage      = CSTREAM_compressing;
+    return ZL_returnSuccess();
+}
+
+/* Flushes as much staged compressed data as possible into @p output */
+static void CSTREAM_drain(CSTREAM_State* cs, ZL_OutBuffer* output)
+{
+    size_t const pending = cs->outSize - cs->outFlushed;
+    size_t const toCopy  = ZL_MIN(pending, output->size - output->pos);
+    if (toCopy) {
+        ZL_memcpy(
+                (uint8_t*)output->dst + output->pos,
+                cs->outBuff + cs->outFlushed,
+                toCopy);
+    }
+    output->pos += toCopy;
+    cs->outFlushed += toCopy;
+}
+
+/* Compresses @p src as the next block of the frame.
+ * Compressed data is written directly into @p output when it has enough room,
+ * otherwise it's staged. Requires: no staged data pending. */
+static ZL_Report CSTREAM_compressBlock(
+        ZL_CCtx* cctx,
+        CSTREAM_State* cs,
+        const void* src,
+        size_t srcSize,
+        ZL_OutBuffer* output)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+    ZL_DLOG(BLOCK, "CSTREAM_compressBlock (srcSize=%zu)", srcSize);
+    ZL_ASSERT_EQ(cs->outSize, cs->outFlushed);
+
+    size_t const dstAvail = output->size - output->pos;
+    int const direct      = dstAvail >= ZL_compressBound(srcSize);
+    if (direct) {
+        CCTX_setDst(cctx, (uint8_t*)output->dst + output->pos, dstAvail, 0);
+    } else {
+        CCTX_setDst(cctx, cs->outBuff, cs->outCapacity, 0);
+    }
+
+    ZL_Data* const input = STREAM_create(ZL_DATA_ID_INPUTSTREAM);
+    ZL_ERR_IF_NULL(input, allocation);
+    ZL_Report r = STREAM_refConstBuffer(input, src, ZL_Type_serial, 1, srcSize);
+    if (!ZL_isError(r)) {
+        const ZL_Data* constInput = input;
+        r = CCTX_compressBlock(cctx, &constInput, 1);
+    }
+    STREAM_free(input);
+    // Reclaim Arena memory after each block
+    CCTX_clean(cctx);
+    ZL_ERR_IF_ERR(r);
+
+    if (direct) {
+        output->pos += ZL_validResult(r);
+    } else {
+        cs->outSize    = ZL_validResult(r);
+        cs->outFlushed = 0;
+    }
+    cs->blockCompressed = 1;
+    return ZL_returnSuccess();
+}
+
+static ZL_Report CSTREAM_writeFooter(ZL_CCtx* cctx, CSTREAM_State* cs)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+    ZL_ASSERT_EQ(cs->outSize, cs->outFlushed);
+    // The seek table can exceed the staging buffer for very long streams
+    ZL_ERR_IF_ERR(CSTREAM_reserve(
+            &cs->outBuff, &cs->outCapacity, CCTX_frameFooterBound(cctx)));
+    CCTX_setDst(cctx, cs->outBuff, cs->outCapacity, 0);
+    ZL_TRY_LET(size_t, footerSize, CCTX_writeFrameFooter(cctx));
+    cs->outSize    = footerSize;
+    cs->outFlushed = 0;
+    cs->stage      = CSTREAM_ending;
+    return ZL_returnSuccess();
+}
+
+/* Closes the frame, and resets parameters unless they are sticky,
+ * mirroring the one-shot compression entry points. */
+static ZL_Report CSTREAM_endFrame(ZL_CCtx* cctx, CSTREAM_State* cs)
+{
+    CSTREAM_resetFrame(cs);
+    if (!CCTX_getAppliedGParam(cctx, ZL_CParam_stickyParameters)) {
+        ZL_RET_R_IF_ERR(ZL_CCtx_resetParameters(cctx));
+    }
+    return ZL_returnSuccess();
+}
+
+static ZL_Report CSTREAM_compressStream_internal(
+        ZL_CCtx* cctx,
+        CSTREAM_State* cs,
+        ZL_InBuffer* input,
+        ZL_OutBuffer* output,
+        ZL_FlushMode mode)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(cctx);
+    if (cs->stage == CSTREAM_idle) {
+        ZL_ERR_IF_ERR(CSTREAM_startFrame(cctx, cs));
+    }
+
+    for (;;) {
+        CSTREAM_drain(cs, output);
+        if (cs->outFlushed < cs->outSize) {
+            // output is full
+            break;
+        }
+        if (cs->stage == CSTREAM_ending) {
+            ZL_ERR_IF_ERR(CSTREAM_endFrame(cctx, cs));
+            break;
+        }
+
+        const uint8_t* const src = (const uint8_t*)input->src + input->pos;
+        size_t const srcAvail    = input->size - input->pos;
+        if (cs->inSize == 0 && srcAvail >= cs->blockSize) {
+            // Full block available : compress it without buffering
+            ZL_ERR_IF_ERR(CSTREAM_compressBlock(
+                    cctx, cs, src, cs->blockSize, output));
+            input->pos += cs->blockSize;
+            continue;
+        }
+
+        size_t const toLoad = ZL_MIN(cs->blockSize - cs->inSize, srcAvail);
+        if (toLoad) {
+            ZL_memcpy(cs->inBuff + cs->inSize, src, toLoad);
+        }
+        cs->inSize += toLoad;
+        input->pos += toLoad;
+        ZL_ASSERT_LE(cs->inSize, cs->blockSize);
+
+        // Note : a block is only compressed once input is exhausted
+        // or block is full, so that flushing with empty input is a no-op
+        int const inputExhausted = (input->pos == input->size);
+        if (cs->inSize == cs->blockSize
+            || (inputExhausted && mode != ZL_FlushMode_continue
+                && cs->inSize > 0)
+            || (inputExhausted && mode == ZL_FlushMode_end
+                && !cs->blockCompressed)) {
+            // An empty frame still contains one empty block
+            ZL_ERR_IF_ERR(CSTREAM_compressBlock(
+                    cctx, cs, cs->inBuff, cs->inSize, output));
+            cs->inSize = 0;
+            continue;
+        }
+        ZL_ASSERT(inputExhausted);
+        if (mode != ZL_FlushMode_end)
+            break;
+        ZL_ERR_IF_ERR(CSTREAM_writeFooter(cctx, cs));
+    }
+
+    return ZL_returnValue(cs->outSize - cs->outFlushed);
+}
+
+ZL_Report ZL_CCtx_compressStream(
+        ZL_CCtx* cctx,
+        ZL_InBuffer* input,
+        ZL_OutBuffer* output,
+        ZL_FlushMode mode)
+{
+    ZL_RET_R_IF_NULL(parameter_invalid, cctx);
+    ZL_RET_R_IF_NULL(parameter_invalid, input);
+    ZL_RET_R_IF_NULL(parameter_invalid, output);
+    ZL_RET_R_IF_GT(parameter_invalid, input->pos, input->size);
+    ZL_RET_R_IF_GT(parameter_invalid, output->pos, output->size);
+    ZL_RET_R_IF_GT(parameter_invalid, mode, ZL_FlushMode_end);
+
+    CSTREAM_State* cs = CCTX_getStreamState(cctx);
+    if (cs == NULL) {
+        cs = CSTREAM_create();
+        ZL_RET_R_IF_NULL(allocation, cs);
+        CCTX_setStreamState(cctx, cs);
+    }
+
+    ZL_Report const r =
+            CSTREAM_compressStream_internal(cctx, cs, input, output, mode);
+    if (ZL_isError(r)) {
+        // Abandon the frame
+        CCTX_clean(cctx);
+        if (cs->stage != CSTREAM_idle) {
+            ZL_RET_R_IF_ERR(CSTREAM_endFrame(cctx, cs));
+        }
+    }
+    return r;
+}
+
+ZL_Report ZL_CCtx_resetStream(ZL_CCtx* cctx)
+{
+    ZL_RET_R_IF_NULL(parameter_invalid, cctx);
+    CSTREAM_State* const cs = CCTX_getStreamState(cctx);
+    if (cs != NULL) {
+        CSTREAM_resetFrame(cs);
+    }
+    return ZL_returnSuccess();
+}
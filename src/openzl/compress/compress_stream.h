@@ -0,0 +1,19 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_COMPRESS_COMPRESS_STREAM_H
+#define ZSTRONG_COMPRESS_COMPRESS_STREAM_H
+
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+/* State of ZL_CCtx_compressStream(),
+ * allocated on first invocation and owned by its ZL_CCtx. */
+typedef struct CSTREAM_State_s CSTREAM_State;
+
+/* Compatible with NULL */
+void CSTREAM_free(CSTREAM_State* cstream);
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_COMPRESS_COMPRESS_STREAM_H
@@ -5,7 +5,7 @@
 #include "openzl/common/introspection.h" // WAYPOINT, ZL_CompressIntrospectionHooks
 #include "openzl/common/logging.h"
 #include "openzl/common/vector.h"
-#include "openzl/compress/cctx.h" // CCTX_getAppliedGParam
+#include "openzl/compress/cctx.h" // CCTX_getAppliedGParam, CCTX_runTasks
 #include "openzl/compress/cgraph.h"
 #include "openzl/compress/localparams.h" // LP_*
 #include "openzl/compress/rtgraphs.h"
@@ -15,8 +15,6 @@
 #include "openzl/zl_localParams.h"
 #include "openzl/zl_opaque_types.h"
 
-#include <stdio.h>
-#include <time.h>
 /* ===   state management   === */
 
 void GCTX_destroy(ZL_Graph* gctx)
@@ -63,15 +61,7 @@ GCTX_runMultiInputGraph(ZL_Graph* gctx, ZL_Edge* inputs[], size_t nbInputs)
     ZL_ASSERT_NN(gctx);
     ZL_FunctionGraphFn const graphf = gctx->dgd->graph_f;
     ZL_ASSERT_NN(graphf);
-    // size_t totalContentSize = 0;
-    // for (size_t i = 0; i < nbInputs; i++) {
-    //     if (inputs[i] != NULL) {
-    //         totalContentSize += ZL_Input_contentSize(inputs[i]);
-    //     }
-    // }
-    fprintf(stderr, "functionGraphDesc_name: %s\n", gctx->dgd->name);
-    ZL_Report graphf_report = graphf(gctx, inputs, nbInputs);
-    return graphf_report;
+    return graphf(gctx, inputs, nbInputs);
 }
 
 /* accessors */
@@ -140,6 +130,22 @@ void* ZL_Graph_getScratchSpace(ZL_Graph* gctx, size_t size)
     return ALLOC_Arena_malloc(gctx->graphArena, size);
 }
 
+size_t ZL_Graph_getNbWorkers(const ZL_Graph* gctx)
+{
+    ZL_ASSERT_NN(gctx);
+    return CCTX_getNbChunkWorkers(gctx->cctx);
+}
+
+void ZL_Graph_runTasks(
+        ZL_Graph* gctx,
+        ZL_WorkerTaskFn task,
+        void* taskCtx,
+        size_t nbTasks)
+{
+    ZL_ASSERT_NN(gctx);
+    CCTX_runTasks(gctx->cctx, task, taskCtx, nbTasks);
+}
+
 ZL_RESULT_OF(ZL_EdgeList)
 ZL_Edge_runMultiInputNode(
         ZL_Edge* inputCtxs[],
@@ -8,6 +8,7 @@
 #include "openzl/common/limits.h"
 #include "openzl/common/operation_context.h"
 #include "openzl/common/scope_context.h"
+#include "openzl/common/trace.h" // TRACE_*
 #include "openzl/compress/cctx.h" // CCTX_*
 #include "openzl/compress/cnode.h"
 #include "openzl/compress/localparams.h"
@@ -233,6 +234,36 @@ ZL_Output* ENC_refTypedStream(
             offsetBytes));
 }
 
+static void ENC_traceTransform(
+        const ZL_Encoder* eictx,
+        ZL_TraceRing* traceRing,
+        const InternalTransform_Desc* trDesc,
+        uint64_t startNs,
+        const ZL_Data* inStreams[],
+        size_t nbInStreams)
+{
+    const RTGraph* const rtgm = CCTX_getRTGraph(eictx->cctx);
+    size_t const nbOutStreams = RTGM_getNbOutStreams(rtgm, eictx->rtnodeid);
+    size_t bytesIn            = 0;
+    for (size_t n = 0; n < nbInStreams; n++) {
+        bytesIn += ZL_Data_contentSize(inStreams[n]);
+    }
+    size_t bytesOut = 0;
+    for (size_t n = 0; n < nbOutStreams; n++) {
+        RTStreamID const rtsid =
+                RTGM_getOutStreamID(rtgm, eictx->rtnodeid, (int)n);
+        bytesOut += ZL_Data_contentSize(RTGM_getRStream(rtgm, rtsid));
+    }
+    TRACE_record(
+            traceRing,
+            ZL_TraceEventType_codecEncode,
+            trDesc->publicDesc.gd.CTid,
+            CT_getTrName(trDesc),
+            startNs,
+            bytesIn,
+            bytesOut);
+}
+
 static ZL_Report ENC_runTransform_internal(
         ZL_Encoder* eictx,
         ZL_NodeID nodeid,
@@ -266,8 +297,14 @@ static ZL_Report ENC_runTransform_internal(
                 ZL_codemodDatasAsInputs(inStreams),
                 nbInStreams);
     }
-    ZL_Report codecExecResult = (trDesc->publicDesc.transform_f(
+    ZL_TraceRing* const traceRing = TRACE_RING(eictx);
+    uint64_t const traceStart     = TRACE_start(traceRing);
+    ZL_Report codecExecResult     = (trDesc->publicDesc.transform_f(
             eictx, ZL_codemodDatasAsInputs(inStreams), nbInStreams));
+    if (traceRing != NULL && !ZL_isError(codecExecResult)) {
+        ENC_traceTransform(
+                eictx, traceRing, trDesc, traceStart, inStreams, nbInStreams);
+    }
     if (ZL_isError(codecExecResult)) {
         WAYPOINT(on_codecEncode_end, eictx, NULL, 0, codecExecResult);
         ZL_RET_R_IF_ERR_COERCE(
@@ -46,7 +46,9 @@ static ZL_Report computeFHBound(
     ZL_ASSERT_LE(
             ZL_varintSize(ZL_runtimeNodeInputLimit(ZL_MAX_FORMAT_VERSION)), 2);
 
-    const size_t bound = 4 + (numInputs * 5) + ZL_varintSize(nbTransforms)
+    // Each input stores its size, and its nb of strings, as varints
+    const size_t bound = 4 + (numInputs * 2 * ZL_VARINT_LENGTH_64)
+            + ZL_varintSize(nbTransforms)
             + ZL_varintSize(nbBuffs - 1) + (nbBuffs * 4) + (nbTransforms * 22)
             + (nbRegens * 4) + 4 + 4;
     return ZL_returnValue(bound);
@@ -426,14 +428,39 @@ static ZL_Report EFH_encodeInputSizes(
         ZL_WC* out,
         const InputDesc* inDesc,
         size_t numInputs,
+        const ZL_FrameProperties* fprop,
         uint32_t formatVersion)
 {
     if (formatVersion <= 20)
         return EFH_encodeInputSizes_v20(out, inDesc, numInputs);
     // formatVersion>=21
+    if (fprop->unknownContentSize) {
+        // A single 0 states that all sizes are unknown
+        // They will be provided by each chunk header instead
+        ZL_RET_R_IF_LT(dstCapacity_tooSmall, ZL_WC_avail(out), 1);
+        ZL_WC_push(out, 0);
+        return ZL_returnValue(1);
+    }
     return EFH_encodeInputSizes_v21(out, inDesc, numInputs);
 }
 
+/* When input sizes are unknown at frame level,
+ * each chunk header stores the size of its own inputs */
+static ZL_Report
+EFH_encodeChunkInputSizes(ZL_WC* out, const InputDesc* inDesc, size_t numInputs)
+{
+    size_t const start = ZL_WC_size(out);
+    for (size_t n = 0; n < numInputs; n++) {
+        ZL_RET_R_IF_ERR(EFH_writeVarint(out, (uint64_t)inDesc[n].byteSize));
+    }
+    for (size_t n = 0; n < numInputs; n++) {
+        if (inDesc[n].type == ZL_Type_string) {
+            ZL_RET_R_IF_ERR(EFH_writeVarint(out, inDesc[n].numElts));
+        }
+    }
+    return ZL_returnValue(ZL_WC_size(out) - start);
+}
+
 // writeFrameHeader_internal() :
 // Note : @dstCapacity must be large enough to write the header,
 //        otherwise the function will return an error
@@ -465,6 +492,8 @@ static ZL_Report writeFrameHeader_internal(
             flags |= 1 << 0;
         if (fip->fprop->hasCompressedChecksum)
             flags |= 1 << 1;
+        if (fip->fprop->hasSeekTable)
+            flags |= 1 << 2;
         ZL_WC_push(&out, flags);
     }
 
@@ -601,9 +630,12 @@ static ZL_Report writeFrameHeader_internal(
     }
 
     // Store Sizes of Inputs
-    // @note (@cyan): currently, input size is presumed always known
     ZL_RET_R_IF_ERR(EFH_encodeInputSizes(
-            &out, fip->inputDescs, fip->numInputs, encoder->formatVersion));
+            &out,
+            fip->inputDescs,
+            fip->numInputs,
+            fip->fprop,
+            encoder->formatVersion));
 
     if ((encoder->formatVersion >= ZL_CHUNK_VERSION_MIN)
         && fip->fprop->hasCompressedChecksum) {
@@ -712,6 +744,12 @@ static ZL_Report writeChunkHeaderV8_internal(
         ZL_WC_push(&out, flags);
     }
 
+    if (encoder->formatVersion >= ZL_UNKNOWN_SIZE_VERSION_MIN
+        && fprop->unknownContentSize) {
+        ZL_RET_R_IF_ERR(EFH_encodeChunkInputSizes(
+                &out, gip->inputDescs, gip->nbSessionInputs));
+    }
+
     /* Encode Transform's formatIDs */
     {
         uint8_t* const trt = wksp->scratch3;
@@ -888,3 +926,17 @@ ZL_Report EFH_writeChunkHeader(
     EFH_Interface const encoder = EFH_getFrameHeaderEncoder(version);
     return encoder.writeChunkHeader(&encoder, dst, dstCapacity, info, gip);
 }
+
+ZL_Report EFH_frameHeaderBound(size_t numInputs)
+{
+    return computeFHBound(numInputs, 0, 0, 0);
+}
+
+ZL_Report EFH_chunkHeaderBound(const GraphInfo* gip)
+{
+    return computeFHBound(
+            gip->nbSessionInputs,
+            gip->nbTransforms,
+            gip->nbStoredBuffs,
+            gip->nbDistances);
+}
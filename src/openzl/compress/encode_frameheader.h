@@ -43,6 +43,12 @@ ZL_Report EFH_writeFrameHeader(
         const EFH_FrameInfo* fip,
         uint32_t version);
 
+/**
+ * @returns An upper bound of the size of the frame header
+ * for @p numInputs inputs, or an error if @p numInputs is too large.
+ */
+ZL_Report EFH_frameHeaderBound(size_t numInputs);
+
 /**
  * @brief Comprehensive metadata structure describing a completed compression
  * session.
@@ -84,6 +90,12 @@ ZL_Report EFH_writeChunkHeader(
         const GraphInfo* gip,
         uint32_t version);
 
+/**
+ * @returns An upper bound of the size of the Chunk header described by
+ * @p gip, or an error if the Chunk exceeds format limits.
+ */
+ZL_Report EFH_chunkHeaderBound(const GraphInfo* gip);
+
 /* @note (@cyan) is it really useful to expose this struct ? */
 typedef struct EFH_Interface_s {
     /**
@@ -26,6 +26,8 @@ const GCParams GCParams_default = {
     .compressedChecksum = ZL_TernaryParam_enable,
     .contentChecksum    = ZL_TernaryParam_enable,
     .minStreamSize      = ZL_MINSTREAMSIZE_DEFAULT,
+    .seekTable          = ZL_TernaryParam_disable,
+    .streamBlockSize    = ZL_STREAMBLOCKSIZE_DEFAULT,
 };
 
 typedef struct {
@@ -53,7 +55,10 @@ const GCParamToName GCParams_kAllParams[] = {
     { ZL_CParam_compressedChecksum,
       { (const char*[]){ "compressedChecksum" }, 1 } },
     { ZL_CParam_contentChecksum, { (const char*[]){ "contentChecksum" }, 1 } },
-    { ZL_CParam_minStreamSize, { (const char*[]){ "minStreamSize" }, 1 } }
+    { ZL_CParam_minStreamSize, { (const char*[]){ "minStreamSize" }, 1 } },
+    { ZL_CParam_nbWorkers, { (const char*[]){ "nbWorkers" }, 1 } },
+    { ZL_CParam_seekTable, { (const char*[]){ "seekTable" }, 1 } },
+    { ZL_CParam_streamBlockSize, { (const char*[]){ "streamBlockSize" }, 1 } }
 };
 
 ZL_Report
@@ -88,6 +93,17 @@ GCParams_setParameter(GCParams* gcparams, ZL_CParam paramId, int value)
             // TODO (@Cyan): provide bounds
             gcparams->minStreamSize = (unsigned)value;
             break;
+        case ZL_CParam_nbWorkers:
+            ZL_RET_R_IF_LT(compressionParameter_invalid, value, 0);
+            gcparams->nbWorkers = value;
+            break;
+        case ZL_CParam_seekTable:
+            gcparams->seekTable = (ZL_TernaryParam)value;
+            break;
+        case ZL_CParam_streamBlockSize:
+            ZL_RET_R_IF_LT(compressionParameter_invalid, value, 0);
+            gcparams->streamBlockSize = value;
+            break;
         case ZL_CParam_formatVersion:
             if (!(value == 0 || ZL_isFormatVersionSupported((uint32_t)value)))
                 ZL_RET_R_ERR(formatVersion_unsupported);
@@ -135,6 +151,9 @@ void GCParams_applyDefaults(GCParams* dst, const GCParams* defaults)
     SET_DEFAULT(dst, defaults, compressedChecksum);
     SET_DEFAULT(dst, defaults, contentChecksum);
     SET_DEFAULT(dst, defaults, minStreamSize);
+    SET_DEFAULT(dst, defaults, nbWorkers);
+    SET_DEFAULT(dst, defaults, seekTable);
+    SET_DEFAULT(dst, defaults, streamBlockSize);
 }
 #undef SET_DEFAULT
 
@@ -159,6 +178,16 @@ ZL_Report GCParams_finalize(GCParams* gcparams)
         ZL_ASSERT_SUCCESS(r2);
     }
 
+    // Older decoders don't know about the seek table
+    if (gcparams->seekTable == ZL_TernaryParam_enable) {
+        ZL_RET_R_IF_LT(
+                formatVersion_unsupported,
+                formatVersion,
+                ZL_SEEK_TABLE_VERSION_MIN,
+                "Seek table requires format version >= %u",
+                ZL_SEEK_TABLE_VERSION_MIN);
+    }
+
     return ZL_returnSuccess();
 }
 
@@ -182,6 +211,12 @@ int GCParams_getParameter(const GCParams* gcparams, ZL_CParam paramId)
             return (int)gcparams->contentChecksum;
         case ZL_CParam_minStreamSize:
             return (int)gcparams->minStreamSize;
+        case ZL_CParam_nbWorkers:
+            return gcparams->nbWorkers;
+        case ZL_CParam_seekTable:
+            return (int)gcparams->seekTable;
+        case ZL_CParam_streamBlockSize:
+            return gcparams->streamBlockSize;
         default:
             return 0;
     }
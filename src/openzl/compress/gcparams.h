@@ -67,6 +67,21 @@ typedef struct {
     /// Set to negative value to completely disable auto-store feature
     unsigned minStreamSize;
 
+    /// Number of workers compressing Chunks in parallel
+    /// 0 (default) or 1: single-threaded mode
+    /// Only effective when a worker pool is attached to the CCtx
+    int nbWorkers;
+
+    /// Append a seek table to the frame, for random access to Chunks
+    /// ZL_TernaryParam_enable: Write the seek table
+    /// ZL_TernaryParam_disable (default): No seek table
+    /// Requires format version >= ZL_CHUNK_VERSION_MIN
+    ZL_TernaryParam seekTable;
+
+    /// Size of input blocks accumulated by streaming compression
+    /// Default: ZL_STREAMBLOCKSIZE_DEFAULT
+    int streamBlockSize;
+
     /// Preserve parameters across compression sessions (CCtx level only)
     /// 0 (default): Reset parameters after each session
     /// 1: Keep parameters sticky across sessions
@@ -137,7 +152,8 @@ ZL_Report GCParams_resetStartingGraphID(GCParams* gcparams);
 /// @note stickyParameter is intentionally NOT overridden by defaults
 /// @note Applied parameters: compressionLevel, decompressionLevel,
 /// permissiveCompression,
-///       formatVersion, compressedChecksum, contentChecksum, minStreamSize
+///       formatVersion, compressedChecksum, contentChecksum, minStreamSize,
+///       nbWorkers, seekTable, streamBlockSize
 void GCParams_applyDefaults(GCParams* dst, const GCParams* defaults);
 
 /// Finalizes and validates the parameters, resolving incompatibilities where
@@ -216,7 +232,8 @@ ZL_Report GCParams_forEachParam(
 /// @note Supported parameter names: "stickyParameters", "compressionLevel",
 /// "decompressionLevel",
 ///       "formatVersion", "permissiveCompression", "compressedChecksum",
-///       "contentChecksum", "minStreamSize"
+///       "contentChecksum", "minStreamSize", "nbWorkers", "seekTable",
+///       "streamBlockSize"
 /// @note Use ZL_validResult() to extract the parameter ID from a successful
 /// result
 ZL_Report GCParams_strToParam(const char* param);
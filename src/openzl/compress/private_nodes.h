@@ -109,6 +109,9 @@ typedef enum {
 
     ZL_PrivateStandardNodeID_fse_ncount,
 
+    ZL_PrivateStandardNodeID_rans,
+    ZL_PrivateStandardNodeID_rans_struct,
+
     ZL_PrivateStandardNodeID_zstd,
 
     ZL_PrivateStandardNodeID_bitpack_serial,
@@ -540,3 +540,89 @@ size_t RTGM_streamMemory(RTGraph const* rtgraph)
 {
     return ALLOC_Arena_memAllocated(rtgraph->streamArena);
 }
+
+// ****************    Concurrent construction    *******************
+
+ZL_Report RTGM_fork(
+        RTGraph* fork,
+        const RTGraph* src,
+        const RTStreamID* rtsids,
+        size_t nbRtsids)
+{
+    ZL_ASSERT_NN(fork);
+    ZL_ASSERT_NN(src);
+    ZL_ASSERT_EQ(VECTOR_SIZE(fork->nodes), 0);
+    ZL_ASSERT_EQ(VECTOR_SIZE(fork->streams), 0);
+    size_t const nbStreams = VECTOR_SIZE(src->streams);
+    ZL_RET_R_IF_LT(
+            allocation, VECTOR_RESIZE(fork->streams, nbStreams), nbStreams);
+    for (size_t n = 0; n < nbRtsids; n++) {
+        ZL_IDType const rtsid = rtsids[n].rtsid;
+        ZL_ASSERT_LT(rtsid, nbStreams);
+        RT_CStream* const rtcs = &VECTOR_AT(fork->streams, rtsid);
+        if (rtcs->stream != NULL)
+            continue; // already referenced
+        rtcs->stream = STREAM_createInArena(
+                fork->streamArena, RTGM_genStreamID(fork));
+        ZL_RET_R_IF_NULL(allocation, rtcs->stream);
+        ZL_RET_R_IF_ERR(STREAM_refStreamWithoutRefcount(
+                rtcs->stream, RTGM_getRStream(src, rtsids[n])));
+        rtcs->outcomeID = VECTOR_AT(src->streams, rtsid).outcomeID;
+    }
+    return ZL_returnSuccess();
+}
+
+ZL_Report RTGM_merge(
+        RTGraph* rtgraph,
+        RTGraph* fork,
+        size_t forkBase,
+        size_t headerOffset)
+{
+    ZL_ASSERT_NN(rtgraph);
+    ZL_ASSERT_NN(fork);
+    size_t const dstBase      = VECTOR_SIZE(rtgraph->streams);
+    size_t const nbForkStream = VECTOR_SIZE(fork->streams);
+    ZL_ASSERT_GE(dstBase, forkBase);
+    ZL_ASSERT_GE(nbForkStream, forkBase);
+    ZL_IDType const shift = (ZL_IDType)(dstBase - forkBase);
+
+    // Store requests on referenced Streams
+    for (size_t n = 0; n < forkBase; n++) {
+        if (VECTOR_AT(fork->streams, n).toStore) {
+            ZL_ASSERT_NN(VECTOR_AT(rtgraph->streams, n).stream);
+            VECTOR_AT(rtgraph->streams, n).toStore = 1;
+        }
+    }
+
+    // Transfer created Streams
+    for (size_t n = forkBase; n < nbForkStream; n++) {
+        RT_CStream* const rtcs = &VECTOR_AT(fork->streams, n);
+        ZL_RET_R_IF_NOT(
+                temporaryLibraryLimitation,
+                VECTOR_PUSHBACK(rtgraph->streams, *rtcs));
+        rtcs->stream = NULL;
+    }
+
+    // Transfer created Nodes, renumbering their Streams
+    size_t const nbForkNodes = VECTOR_SIZE(fork->nodes);
+    for (size_t n = 0; n < nbForkNodes; n++) {
+        RTNode node = VECTOR_AT(fork->nodes, n);
+        ALLOC_ARENA_MALLOC_CHECKED(
+                RTStreamID, inRtsids, node.nbInputs, rtgraph->rtsidsArena);
+        for (size_t i = 0; i < node.nbInputs; i++) {
+            ZL_IDType const rtsid = node.inRtsids[i].rtsid;
+            inRtsids[i].rtsid     = (rtsid < forkBase) ? rtsid : rtsid + shift;
+        }
+        ZL_ASSERT_GE(node.startOutRtsids, forkBase);
+        node.inRtsids = inRtsids;
+        node.startOutRtsids += shift;
+        node.nodeHeaderSegment.startPos += headerOffset;
+        ZL_RET_R_IF_NOT(
+                temporaryLibraryLimitation,
+                VECTOR_PUSHBACK(rtgraph->nodes, node));
+    }
+
+    if (fork->nextStreamUniqueID > rtgraph->nextStreamUniqueID)
+        rtgraph->nextStreamUniqueID = fork->nextStreamUniqueID;
+    return ZL_returnSuccess();
+}
@@ -299,6 +299,41 @@ void RTGM_clearRTStream(
  */
 size_t RTGM_streamMemory(const RTGraph* rtgraph);
 
+/* =====   Concurrent construction   ===== */
+
+/**
+ * Prepares the empty @p fork to continue the construction of @p src,
+ * typically on another thread.
+ * @p fork reserves as many Stream IDs as @p src currently has,
+ * and references the listed @p rtsids of @p src at their same IDs,
+ * so that Nodes and Streams created in @p fork receive the IDs
+ * they would have received if created directly into @p src.
+ * References are read-only views, without refcount:
+ * @p src Streams must outlive @p fork's content.
+ */
+ZL_Report RTGM_fork(
+        RTGraph* fork,
+        const RTGraph* src,
+        const RTStreamID* rtsids,
+        size_t nbRtsids);
+
+/**
+ * Appends the Nodes and Streams created in @p fork since RTGM_fork()
+ * into @p rtgraph. Streams are renumbered to follow the ones already present
+ * in @p rtgraph, and store requests on referenced Streams are transferred.
+ * @p forkBase is the number of Streams of the source at RTGM_fork() time.
+ * @p headerOffset is added to the header segment of each appended Node.
+ *
+ * Ownership of appended Streams is transferred to @p rtgraph,
+ * but they remain hosted in @p fork's arena:
+ * @p fork must not be reset before @p rtgraph.
+ */
+ZL_Report RTGM_merge(
+        RTGraph* rtgraph,
+        RTGraph* fork,
+        size_t forkBase,
+        size_t headerOffset);
+
 ZL_END_C_DECLS
 
 #endif // OPENZL_COMPRESS_RTGRAPH_H
@@ -6,6 +6,7 @@
 #include "openzl/common/stream.h" // STREAM_*
 #include "openzl/common/vector.h"
 #include "openzl/compress/cctx.h"        // CCTX_*
+#include "openzl/compress/dyngraph_interface.h" // ZL_transferRuntimeGraphParams
 #include "openzl/compress/localparams.h" // LP_*
 #include "openzl/compress/rtgraphs.h"
 #include "openzl/zl_data.h"   // ZL_Data, ZL_Type
@@ -24,6 +25,9 @@ struct ZL_Segmenter_s {
     size_t* consumed;
     Arena* arena;
     Arena* chunkArena;
+    CCTX_ChunkJob* pendingChunks; // multi-threaded mode only
+    size_t nbPendingChunks;
+    size_t maxPendingChunks; // 1 means single-threaded mode
 };
 
 /**
@@ -56,11 +60,20 @@ ZL_Segmenter* SEGM_init(
     ZL_Segmenter* seg = ALLOC_Arena_malloc(arena, sizeof(ZL_Segmenter));
     if (seg == NULL)
         return NULL;
-    seg->segDesc    = segDesc;
-    seg->cctx       = cctx;
-    seg->rtgm       = rtgm;
-    seg->arena      = arena;
-    seg->chunkArena = chunkArena;
+    seg->segDesc          = segDesc;
+    seg->cctx             = cctx;
+    seg->rtgm             = rtgm;
+    seg->arena            = arena;
+    seg->chunkArena       = chunkArena;
+    seg->nbPendingChunks  = 0;
+    seg->maxPendingChunks = CCTX_getNbChunkWorkers(cctx);
+    seg->pendingChunks    = NULL;
+    if (seg->maxPendingChunks > 1) {
+        seg->pendingChunks = ALLOC_Arena_malloc(
+                arena, seg->maxPendingChunks * sizeof(CCTX_ChunkJob));
+        if (seg->pendingChunks == NULL)
+            return NULL;
+    }
     ZL_ASSERT_EQ(nbInputs, VECTOR_SIZE(rtgm->streams));
     seg->nbInputs = nbInputs;
     seg->inputs   = ALLOC_Arena_malloc(arena, nbInputs * sizeof(ZL_Data*));
@@ -88,6 +101,35 @@ ZL_Segmenter* SEGM_init(
 
 /* ===   internal actions   === */
 
+static void SEGM_releasePendingChunks(ZL_Segmenter* segCtx)
+{
+    for (size_t c = 0; c < segCtx->nbPendingChunks; c++) {
+        const CCTX_ChunkJob* const job = &segCtx->pendingChunks[c];
+        for (size_t n = 0; n < job->nbInputs; n++) {
+            STREAM_free(job->inputs[n]);
+        }
+    }
+    segCtx->nbPendingChunks = 0;
+    // Chunk descriptions live in the chunk arena, which the parent context
+    // doesn't use while Chunks are scheduled: memory usage is bounded by the
+    // nb of Chunks in flight, instead of growing with the whole input.
+    if (segCtx->maxPendingChunks > 1)
+        ALLOC_Arena_freeAll(segCtx->chunkArena);
+}
+
+/* Compress all pending Chunks concurrently, and append them in order.
+ * @return the compressed size of all flushed Chunks, or an error */
+static ZL_Report SEGM_flushPendingChunks(ZL_Segmenter* segCtx)
+{
+    ZL_DLOG(BLOCK,
+            "SEGM_flushPendingChunks (%zu chunks)",
+            segCtx->nbPendingChunks);
+    ZL_Report const r = CCTX_compressChunks(
+            segCtx->cctx, segCtx->pendingChunks, segCtx->nbPendingChunks);
+    SEGM_releasePendingChunks(segCtx);
+    return r;
+}
+
 /**
  * Implementation Notes for SEGM_runSegmenter():
  *
@@ -106,7 +148,14 @@ ZL_Report SEGM_runSegmenter(ZL_Segmenter* segCtx)
     ZL_ASSERT_NN(segCtx);
     ZL_SegmenterFn const segfn = segCtx->segDesc->segmenterFn;
     ZL_ASSERT_NN(segfn);
-    ZL_Report const r = segfn(segCtx);
+    ZL_Report r = segfn(segCtx);
+    if (!ZL_isError(r) && segCtx->nbPendingChunks) {
+        ZL_Report const flushed = SEGM_flushPendingChunks(segCtx);
+        if (ZL_isError(flushed))
+            r = flushed;
+    }
+    // Chunks still pending at this point are abandoned after an error
+    SEGM_releasePendingChunks(segCtx);
     if (!ZL_isError(r)) {
         for (size_t n = 0; n < segCtx->nbInputs; n++) {
             ZL_RET_R_IF_LT(
@@ -240,8 +289,8 @@ void* ZL_Segmenter_getScratchSpace(ZL_Segmenter* segCtx, size_t size)
  * Implementation Notes for ZL_Segmenter_processChunk():
  *
  * Memory Allocation Strategy: Uses chunk arena for temporary allocations
- * (chunkInputs, rtsids) that are freed after processing. Session-lifetime
- * objects like stream references use the main arena.
+ * (chunkInputs and their slice streams, rtsids) that are freed after
+ * processing. Session-lifetime objects use the main arena.
  *
  * Stream Slicing Approach: Creates stream slices via STREAM_refStreamSlice()
  * rather than copying data. This provides zero-copy chunk processing, though it
@@ -257,6 +306,12 @@ void* ZL_Segmenter_getScratchSpace(ZL_Segmenter* segCtx, size_t size)
  *
  * Cleanup Pattern: Manual cleanup with proper STREAM_free() calls to handle
  * reference counting, followed by CCTX_cleanChunk() for context cleanup.
+ *
+ * Multi-threaded Mode: when the CCtx has multiple Chunk workers, the Chunk is
+ * only scheduled. Its description remains in the chunk arena, which is
+ * released once pending Chunks are compressed. They are compressed
+ * concurrently once there is one per worker, or when the Segmenter function
+ * completes. Chunks are appended in order.
  */
 ZL_Report ZL_Segmenter_processChunk(
         ZL_Segmenter* segCtx,
@@ -274,6 +329,10 @@ ZL_Report ZL_Segmenter_processChunk(
     ZL_ERR_IF_NE(
             numInputs, ZL_Segmenter_numInputs(segCtx), graph_invalidNumInputs);
 
+    // In multi-threaded mode, Chunks are scheduled, and compressed later.
+    // Their description survives in the chunk arena until they are flushed.
+    int const scheduled = segCtx->maxPendingChunks > 1;
+
     // Define Graph's inputs as a slice of Session's inputs
     ALLOC_ARENA_MALLOC_CHECKED(
             ZL_Data*, chunkInputs, numInputs, segCtx->chunkArena);
@@ -283,7 +342,7 @@ ZL_Report ZL_Segmenter_processChunk(
                 ZL_Data_numElts(segCtx->inputs[n]),
                 parameter_invalid);
         chunkInputs[n] = STREAM_createInArena(
-                segCtx->arena, (ZL_DataID){ (ZL_IDType)n });
+                segCtx->chunkArena, (ZL_DataID){ (ZL_IDType)n });
         ZL_ERR_IF_NULL(chunkInputs[n], allocation);
         ZL_ERR_IF_ERR(STREAM_refStreamSliceWithoutRefCount(
                 chunkInputs[n],
@@ -293,6 +352,28 @@ ZL_Report ZL_Segmenter_processChunk(
         segCtx->consumed[n] += numElts[n];
     }
 
+    if (scheduled) {
+        ZL_ASSERT_LT(segCtx->nbPendingChunks, segCtx->maxPendingChunks);
+        CCTX_ChunkJob* const job =
+                &segCtx->pendingChunks[segCtx->nbPendingChunks++];
+        *job = (CCTX_ChunkJob){
+            .inputs          = chunkInputs,
+            .nbInputs        = numInputs,
+            .startingGraphID = startingGraphID,
+            .rgp             = NULL,
+        };
+        if (rGraphParams) {
+            // @rGraphParams may not outlive the current invocation
+            job->rgp = ZL_transferRuntimeGraphParams(
+                    segCtx->chunkArena, rGraphParams);
+            ZL_ERR_IF_NULL(job->rgp, allocation);
+        }
+        if (segCtx->nbPendingChunks < segCtx->maxPendingChunks) {
+            return ZL_returnValue(0);
+        }
+        return SEGM_flushPendingChunks(segCtx);
+    }
+
     ALLOC_ARENA_MALLOC_CHECKED(
             RTStreamID, rtsids, numInputs, segCtx->chunkArena);
     RTGM_reset(segCtx->rtgm);
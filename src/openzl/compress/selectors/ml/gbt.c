@@ -1,12 +1,16 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 #include <math.h>
+#include <string.h>
 
 #include "openzl/common/assertion.h"
 #include "openzl/compress/selectors/ml/gbt.h"
+#include "openzl/shared/utils.h"
 #include "openzl/zl_public_nodes.h"
 #include "openzl/zl_selector.h" //ZL_AUTO_FORMAT_VERSION
 
 const size_t kMaxFeaturesCapacity = 1024;
+/// Models with at most this many features don't allocate them on prediction
+#define GBT_STACK_FEATURES 64
 
 float GBTPredictor_Tree_evaluate(
         const GBTPredictor_Tree* tree,
@@ -95,8 +99,14 @@ size_t GBTPredictor_getNumClasses(const GBTPredictor* predictor)
     return predictor->numForests;
 }
 
-ZL_RESULT_OF(Label)
-GBTModel_predict(const GBTModel* model, const ZL_Input* in)
+/**
+ * Fills @p features with the features generated from @p in, in the order of
+ * model->featureLabels. Features the generator doesn't produce are NaN.
+ */
+static ZL_Report GBTModel_generateFeatures(
+        const GBTModel* model,
+        const ZL_Input* in,
+        float* features)
 {
     VECTOR(LabeledFeature) featuresMap = VECTOR_EMPTY(kMaxFeaturesCapacity);
     const ZL_Report report =
@@ -104,29 +114,49 @@ GBTModel_predict(const GBTModel* model, const ZL_Input* in)
 
     if (ZL_isError(report)) {
         VECTOR_DESTROY(featuresMap);
-        ZL_RET_T_IF_ERR(Label, report, "Error in generating features");
-    }
-
-    float* featuresData = (float*)malloc(model->nbFeatures * sizeof(float));
-    if (featuresData == NULL) {
-        VECTOR_DESTROY(featuresMap);
-        ZL_RET_T_IF_NULL(Label, allocation, "Error allocating features");
+        ZL_RET_R_IF_ERR(report, "Error in generating features");
     }
 
     for (size_t i = 0; i < model->nbFeatures; i++) {
-        featuresData[i] = NAN;
+        features[i] = NAN;
         for (size_t j = 0; j < VECTOR_SIZE(featuresMap); j++) {
             if (!strcmp(VECTOR_AT(featuresMap, j).label,
                         model->featureLabels[i])) {
-                featuresData[i] = VECTOR_AT(featuresMap, j).value;
+                features[i] = VECTOR_AT(featuresMap, j).value;
             }
         }
     }
-
-    const size_t classInd = GBTPredictor_predict(
-            model->predictor, featuresData, model->nbFeatures);
-    free(featuresData);
     VECTOR_DESTROY(featuresMap);
+    return ZL_returnSuccess();
+}
+
+/// Predicts with @p compiled if it isn't NULL, with model->predictor otherwise
+static ZL_RESULT_OF(Label) GBTModel_predictWith(
+        const GBTModel* model,
+        const GBTPredictor_Compiled* compiled,
+        const ZL_Input* in)
+{
+    float stackFeatures[GBT_STACK_FEATURES];
+    float* featuresData = stackFeatures;
+    if (model->nbFeatures > GBT_STACK_FEATURES) {
+        featuresData = (float*)malloc(model->nbFeatures * sizeof(float));
+        ZL_RET_T_IF_NULL(
+                Label, allocation, featuresData, "Error allocating features");
+    }
+
+    const ZL_Report report = GBTModel_generateFeatures(model, in, featuresData);
+    size_t classInd        = 0;
+    if (!ZL_isError(report)) {
+        classInd = compiled != NULL
+                ? GBTPredictor_Compiled_predict(
+                          compiled, featuresData, model->nbFeatures)
+                : GBTPredictor_predict(
+                          model->predictor, featuresData, model->nbFeatures);
+    }
+    if (featuresData != stackFeatures) {
+        free(featuresData);
+    }
+    ZL_RET_T_IF_ERR(Label, report);
     ZL_RET_T_IF_GE(
             Label,
             GENERIC,
@@ -137,6 +167,12 @@ GBTModel_predict(const GBTModel* model, const ZL_Input* in)
     return ZL_RESULT_WRAP_VALUE(Label, classification);
 }
 
+ZL_RESULT_OF(Label)
+GBTModel_predict(const GBTModel* model, const ZL_Input* in)
+{
+    return GBTModel_predictWith(model, NULL, in);
+}
+
 const char* GBTModel_Desc_predict(const void* opaque, const ZL_Input* in)
 {
     const GBTModel* model = (const GBTModel*)opaque;
@@ -276,6 +312,510 @@ ZL_Report GBTModel_validate(const GBTModel* model)
     return ZL_returnSuccess();
 }
 
+#define GBT_COMPILED_MAGIC 0x43544247u // "GBTC"
+#define GBT_COMPILED_HEADER_WORDS 8
+/// Number of (tree, input) pairs traversed in lockstep
+#define GBT_LANES 8
+/// Largest stride between the inputs of a batch traversed in lockstep, so that
+/// feature offsets fit in 32 bits
+#define GBT_MAX_LANE_STRIDE (1u << 24)
+
+ZL_STATIC_ASSERT(
+        sizeof(GBTPredictor_CompiledNode) == 16,
+        "Compiled nodes must be packed in 16 bytes");
+ZL_STATIC_ASSERT(
+        sizeof(GBTPredictor_CompiledTree) == 8,
+        "Compiled trees must be packed in 8 bytes");
+
+/// @returns the offset of the nodes in a compiled predictor
+static size_t GBTPredictor_Compiled_nodesOffset(
+        size_t numForests,
+        size_t numTrees)
+{
+    return GBT_COMPILED_HEADER_WORDS * sizeof(uint32_t)
+            + numForests * sizeof(uint32_t)
+            + numTrees * sizeof(GBTPredictor_CompiledTree);
+}
+
+size_t GBTPredictor_compiledBound(const GBTPredictor* predictor)
+{
+    const size_t numForests =
+            predictor->forests == NULL ? 0 : predictor->numForests;
+    size_t numTrees = 0;
+    size_t numNodes = 0;
+    for (size_t f = 0; f < numForests; f++) {
+        const GBTPredictor_Forest* forest = &predictor->forests[f];
+        numTrees += forest->numTrees;
+        for (size_t t = 0; t < forest->numTrees; t++) {
+            numNodes += forest->trees[t].numNodes;
+        }
+    }
+    return GBTPredictor_Compiled_nodesOffset(numForests, numTrees)
+            + numNodes * sizeof(GBTPredictor_CompiledNode);
+}
+
+/**
+ * Lays out @p tree in breadth-first order in @p nodes, whose first node has
+ * index @p base in the compiled predictor. Raises @p numFeatures to the number
+ * of features the tree reads.
+ *
+ * @returns the number of nodes written
+ */
+static ZL_Report GBTPredictor_compileTree(
+        GBTPredictor_CompiledTree* compiledTree,
+        GBTPredictor_CompiledNode* nodes,
+        size_t base,
+        size_t nodesCapacity,
+        const GBTPredictor_Tree* tree,
+        size_t* numFeatures)
+{
+    ZL_RET_R_IF_EQ(GENERIC, tree->numNodes, 0, "Tree is empty");
+    ZL_RET_R_IF_EQ(dstCapacity_tooSmall, nodesCapacity, 0);
+    // Until they are laid out, nodes hold the index of their source node in
+    // leftChildIdx
+    nodes[0].leftChildIdx = 0;
+    size_t numNodes       = 1;
+    size_t levelEnd       = 1;
+    uint32_t depth        = 0;
+    for (size_t i = 0; i < numNodes; i++) {
+        if (i == levelEnd) {
+            ++depth;
+            levelEnd = numNodes;
+        }
+        const GBTPredictor_Node src = tree->nodes[nodes[i].leftChildIdx];
+        GBTPredictor_CompiledNode* const node = &nodes[i];
+        if (src.featureIdx == -1) {
+            node->threshold    = NAN;
+            node->feature      = GBT_COMPILED_DEFAULT_LEFT;
+            node->leftChildIdx = (uint32_t)(base + i);
+            node->value        = src.value;
+            continue;
+        }
+
+        ZL_RET_R_IF_GE(
+                GENERIC,
+                (size_t)src.featureIdx,
+                GBT_COMPILED_MAX_FEATURES,
+                "Feature index is too large to compile");
+        const bool defaultLeft = src.missingChildIdx == src.leftChildIdx;
+        ZL_RET_R_IF(
+                GENERIC,
+                !defaultLeft && src.missingChildIdx != src.rightChildIdx,
+                "Missing child must be the left or the right child");
+        // Each node of a tree has a single parent, so a tree can't have more
+        // nodes reachable from its root than it has nodes.
+        ZL_RET_R_IF_GT(
+                GENERIC,
+                numNodes + 2,
+                tree->numNodes,
+                "Node is reachable from several parents");
+        ZL_RET_R_IF_GT(dstCapacity_tooSmall, numNodes + 2, nodesCapacity);
+        nodes[numNodes].leftChildIdx     = (uint32_t)src.leftChildIdx;
+        nodes[numNodes + 1].leftChildIdx = (uint32_t)src.rightChildIdx;
+
+        node->threshold = src.value;
+        node->feature   = (uint32_t)src.featureIdx
+                | (defaultLeft ? GBT_COMPILED_DEFAULT_LEFT : 0);
+        node->leftChildIdx = (uint32_t)(base + numNodes);
+        node->value        = 0;
+        numNodes += 2;
+        *numFeatures = ZL_MAX(*numFeatures, (size_t)src.featureIdx + 1);
+    }
+    compiledTree->root  = (uint32_t)base;
+    compiledTree->depth = depth;
+    return ZL_returnValue(numNodes);
+}
+
+ZL_Report GBTPredictor_compile(
+        const GBTPredictor* predictor,
+        void* dst,
+        size_t dstCapacity)
+{
+    ZL_RET_R_IF_ERR(GBTPredictor_validate(predictor, -1));
+    ZL_RET_R_IF_NE(
+            parameter_invalid,
+            (uintptr_t)dst % sizeof(uint32_t),
+            0,
+            "Compiled predictor must be aligned on 4 bytes");
+
+    const size_t numForests =
+            predictor->forests == NULL ? 0 : predictor->numForests;
+    size_t numTrees = 0;
+    for (size_t f = 0; f < numForests; f++) {
+        numTrees += predictor->forests[f].numTrees;
+    }
+    // Each tree has at least one node
+    ZL_RET_R_IF_GT(GENERIC, numTrees, GBT_COMPILED_MAX_NODES, "Too many trees");
+    const size_t nodesOffset =
+            GBTPredictor_Compiled_nodesOffset(numForests, numTrees);
+    ZL_RET_R_IF_GT(dstCapacity_tooSmall, nodesOffset, dstCapacity);
+    const size_t nodesCapacity = ZL_MIN(
+            (dstCapacity - nodesOffset) / sizeof(GBTPredictor_CompiledNode),
+            (size_t)GBT_COMPILED_MAX_NODES);
+
+    uint32_t* const header     = (uint32_t*)dst;
+    uint32_t* const forestEnds = header + GBT_COMPILED_HEADER_WORDS;
+    GBTPredictor_CompiledTree* const trees =
+            (GBTPredictor_CompiledTree*)(void*)(forestEnds + numForests);
+    GBTPredictor_CompiledNode* const nodes =
+            (GBTPredictor_CompiledNode*)((char*)dst + nodesOffset);
+
+    size_t treeIdx     = 0;
+    size_t numNodes    = 0;
+    size_t numFeatures = 1;
+    for (size_t f = 0; f < numForests; f++) {
+        const GBTPredictor_Forest* forest = &predictor->forests[f];
+        for (size_t t = 0; t < forest->numTrees; t++, treeIdx++) {
+            ZL_TRY_LET_R(
+                    treeNodes,
+                    GBTPredictor_compileTree(
+                            &trees[treeIdx],
+                            nodes + numNodes,
+                            numNodes,
+                            nodesCapacity - numNodes,
+                            &forest->trees[t],
+                            &numFeatures));
+            numNodes += treeNodes;
+        }
+        forestEnds[f] = (uint32_t)treeIdx;
+    }
+
+    memset(header, 0, GBT_COMPILED_HEADER_WORDS * sizeof(uint32_t));
+    header[0] = GBT_COMPILED_MAGIC;
+    header[1] = (uint32_t)numForests;
+    header[2] = (uint32_t)numTrees;
+    header[3] = (uint32_t)numNodes;
+    header[4] = (uint32_t)numFeatures;
+    return ZL_returnValue(
+            nodesOffset + numNodes * sizeof(GBTPredictor_CompiledNode));
+}
+
+ZL_Report GBTPredictor_Compiled_load(
+        GBTPredictor_Compiled* compiled,
+        const void* src,
+        size_t srcSize)
+{
+    ZL_RET_R_IF_NE(
+            parameter_invalid,
+            (uintptr_t)src % sizeof(uint32_t),
+            0,
+            "Compiled predictor must be aligned on 4 bytes");
+    size_t remaining = GBT_COMPILED_HEADER_WORDS * sizeof(uint32_t);
+    ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, remaining);
+    remaining = srcSize - remaining;
+
+    const uint32_t* const header = (const uint32_t*)src;
+    ZL_RET_R_IF_NE(
+            corruption,
+            header[0],
+            GBT_COMPILED_MAGIC,
+            "Not a compiled GBT predictor");
+    for (size_t i = 5; i < GBT_COMPILED_HEADER_WORDS; i++) {
+        ZL_RET_R_IF_NE(corruption, header[i], 0, "Reserved word must be 0");
+    }
+    const size_t numForests  = header[1];
+    const size_t numTrees    = header[2];
+    const size_t numNodes    = header[3];
+    const size_t numFeatures = header[4];
+    ZL_RET_R_IF_GT(corruption, numNodes, GBT_COMPILED_MAX_NODES);
+    ZL_RET_R_IF_GT(corruption, numFeatures, GBT_COMPILED_MAX_FEATURES);
+
+    ZL_RET_R_IF_GT(srcSize_tooSmall, numForests, remaining / sizeof(uint32_t));
+    remaining -= numForests * sizeof(uint32_t);
+    ZL_RET_R_IF_GT(
+            srcSize_tooSmall,
+            numTrees,
+            remaining / sizeof(GBTPredictor_CompiledTree));
+    remaining -= numTrees * sizeof(GBTPredictor_CompiledTree);
+    ZL_RET_R_IF_NE(
+            corruption,
+            remaining,
+            numNodes * sizeof(GBTPredictor_CompiledNode),
+            "Compiled predictor has the wrong size");
+
+    const uint32_t* const forestEnds = header + GBT_COMPILED_HEADER_WORDS;
+    const GBTPredictor_CompiledTree* const trees =
+            (const GBTPredictor_CompiledTree*)(const void*)(forestEnds
+                                                            + numForests);
+    const GBTPredictor_CompiledNode* const nodes =
+            (const GBTPredictor_CompiledNode*)(const void*)(trees + numTrees);
+
+    size_t forestBegin = 0;
+    for (size_t f = 0; f < numForests; f++) {
+        ZL_RET_R_IF_LT(corruption, forestEnds[f], forestBegin);
+        forestBegin = forestEnds[f];
+    }
+    ZL_RET_R_IF_NE(
+            corruption,
+            forestBegin,
+            numForests == 0 ? 0 : numTrees,
+            "Forests must cover all trees");
+    for (size_t t = 0; t < numTrees; t++) {
+        ZL_RET_R_IF_GE(corruption, trees[t].root, numNodes);
+        ZL_RET_R_IF_GT(corruption, trees[t].depth, numNodes);
+    }
+    for (size_t n = 0; n < numNodes; n++) {
+        const GBTPredictor_CompiledNode node = nodes[n];
+        ZL_RET_R_IF_GE(
+                corruption,
+                node.feature & ~GBT_COMPILED_DEFAULT_LEFT,
+                numFeatures,
+                "Feature index is out of bounds");
+        ZL_RET_R_IF_GE(
+                corruption,
+                node.leftChildIdx,
+                numNodes,
+                "Left child index is out of bounds");
+        // The right child is only taken when the node isn't a leaf
+        const bool isLeaf = isnan(node.threshold)
+                && (node.feature & GBT_COMPILED_DEFAULT_LEFT);
+        ZL_RET_R_IF(
+                corruption,
+                !isLeaf && node.leftChildIdx + 1 >= numNodes,
+                "Right child index is out of bounds");
+    }
+
+    compiled->numForests  = numForests;
+    compiled->numTrees    = numTrees;
+    compiled->numNodes    = numNodes;
+    compiled->numFeatures = numFeatures;
+    compiled->forestEnds  = forestEnds;
+    compiled->trees       = trees;
+    compiled->nodes       = nodes;
+    return ZL_returnSuccess();
+}
+
+/**
+ * Traverses GBT_LANES (tree, input) pairs in lockstep for @p depth steps, and
+ * writes the values of the leaves reached to @p values. Each lane starts from
+ * the node @p nodeIdx and reads the features at `features + featureOffsets`.
+ * Features at or beyond @p nbFeatures are missing. The lanes are independent,
+ * so their loads overlap rather than waiting for each other.
+ */
+static void GBT_traverse(
+        const GBTPredictor_CompiledNode* nodes,
+        const float* features,
+        const uint32_t* nodeIdx,
+        const uint32_t* featureOffsets,
+        uint32_t nbFeatures,
+        size_t depth,
+        float* values)
+{
+    uint32_t idx[GBT_LANES];
+    memcpy(idx, nodeIdx, sizeof(idx));
+    for (size_t d = 0; d < depth; d++) {
+        for (size_t lane = 0; lane < GBT_LANES; lane++) {
+            const GBTPredictor_CompiledNode* node = &nodes[idx[lane]];
+            const uint32_t featureIdx =
+                    node->feature & ~GBT_COMPILED_DEFAULT_LEFT;
+            const float x = featureIdx < nbFeatures
+                    ? features[featureOffsets[lane] + featureIdx]
+                    : NAN;
+            // Comparisons with NaN are false: missing values go right unless
+            // the node sends them left.
+            const bool missingRight =
+                    !(node->feature & GBT_COMPILED_DEFAULT_LEFT);
+            const bool goRight =
+                    (x >= node->threshold) | (missingRight & (isnan(x) != 0));
+            idx[lane] = node->leftChildIdx + goRight;
+        }
+    }
+    for (size_t lane = 0; lane < GBT_LANES; lane++) {
+        values[lane] = nodes[idx[lane]].value;
+    }
+}
+
+/// @returns the sum of the trees of the forest @p forestIdx, in tree order
+static float GBTPredictor_Compiled_evaluateForest(
+        const GBTPredictor_Compiled* compiled,
+        size_t forestIdx,
+        const float* features,
+        uint32_t nbFeatures)
+{
+    static const uint32_t kOffsets[GBT_LANES] = { 0 };
+    const size_t begin = forestIdx == 0 ? 0 : compiled->forestEnds[forestIdx - 1];
+    const size_t end   = compiled->forestEnds[forestIdx];
+    float value        = 0;
+    for (size_t t = begin; t < end; t += GBT_LANES) {
+        const size_t nbTrees = ZL_MIN((size_t)GBT_LANES, end - t);
+        uint32_t roots[GBT_LANES];
+        size_t depth = 0;
+        for (size_t lane = 0; lane < GBT_LANES; lane++) {
+            // Spare lanes evaluate the first tree again
+            const GBTPredictor_CompiledTree tree =
+                    compiled->trees[t + (lane < nbTrees ? lane : 0)];
+            roots[lane] = tree.root;
+            depth       = ZL_MAX(depth, (size_t)tree.depth);
+        }
+        float values[GBT_LANES];
+        GBT_traverse(
+                compiled->nodes,
+                features,
+                roots,
+                kOffsets,
+                nbFeatures,
+                depth,
+                values);
+        for (size_t lane = 0; lane < nbTrees; lane++) {
+            value += values[lane];
+        }
+    }
+    return value;
+}
+
+/// @returns the class of an input, given the highest forest value and index,
+/// like GBTPredictor_predict()
+static size_t GBTPredictor_Compiled_classify(
+        const GBTPredictor_Compiled* compiled,
+        float maxValue,
+        size_t maxInd)
+{
+    if (compiled->numForests == 1) {
+        return maxValue < 0.5 ? 0 : 1;
+    }
+    return maxInd;
+}
+
+size_t GBTPredictor_Compiled_predict(
+        const GBTPredictor_Compiled* compiled,
+        const float* features,
+        size_t nbFeatures)
+{
+    const uint32_t limit =
+            (uint32_t)ZL_MIN(nbFeatures, compiled->numFeatures);
+    size_t maxInd  = 0;
+    float maxValue = -INFINITY;
+    for (size_t f = 0; f < compiled->numForests; f++) {
+        const float currentValue = GBTPredictor_Compiled_evaluateForest(
+                compiled, f, features, limit);
+        if (currentValue > maxValue) {
+            maxValue = currentValue;
+            maxInd   = f;
+        }
+    }
+    return GBTPredictor_Compiled_classify(compiled, maxValue, maxInd);
+}
+
+void GBTPredictor_Compiled_predictBatch(
+        const GBTPredictor_Compiled* compiled,
+        const float* features,
+        size_t featuresStride,
+        size_t nbFeatures,
+        size_t nbInputs,
+        size_t* classes)
+{
+    if (featuresStride > GBT_MAX_LANE_STRIDE) {
+        // Offsets between the inputs don't fit the lanes
+        for (size_t i = 0; i < nbInputs; i++) {
+            classes[i] = GBTPredictor_Compiled_predict(
+                    compiled, features + i * featuresStride, nbFeatures);
+        }
+        return;
+    }
+
+    const uint32_t limit =
+            (uint32_t)ZL_MIN(nbFeatures, compiled->numFeatures);
+    for (size_t i = 0; i < nbInputs; i += GBT_LANES) {
+        const size_t nbLanes = ZL_MIN((size_t)GBT_LANES, nbInputs - i);
+        const float* const inputs = features + i * featuresStride;
+        uint32_t offsets[GBT_LANES];
+        for (size_t lane = 0; lane < GBT_LANES; lane++) {
+            // Spare lanes evaluate the first input again
+            offsets[lane] =
+                    (uint32_t)((lane < nbLanes ? lane : 0) * featuresStride);
+        }
+
+        size_t maxInd[GBT_LANES];
+        float maxValue[GBT_LANES];
+        for (size_t lane = 0; lane < GBT_LANES; lane++) {
+            maxInd[lane]   = 0;
+            maxValue[lane] = -INFINITY;
+        }
+        size_t t = 0;
+        for (size_t f = 0; f < compiled->numForests; f++) {
+            float sums[GBT_LANES] = { 0 };
+            for (; t < compiled->forestEnds[f]; t++) {
+                const GBTPredictor_CompiledTree tree = compiled->trees[t];
+                uint32_t roots[GBT_LANES];
+                for (size_t lane = 0; lane < GBT_LANES; lane++) {
+                    roots[lane] = tree.root;
+                }
+                float values[GBT_LANES];
+                GBT_traverse(
+                        compiled->nodes,
+                        inputs,
+                        roots,
+                        offsets,
+                        limit,
+                        tree.depth,
+                        values);
+                for (size_t lane = 0; lane < GBT_LANES; lane++) {
+                    sums[lane] += values[lane];
+                }
+            }
+            for (size_t lane = 0; lane < GBT_LANES; lane++) {
+                if (sums[lane] > maxValue[lane]) {
+                    maxValue[lane] = sums[lane];
+                    maxInd[lane]   = f;
+                }
+            }
+        }
+        for (size_t lane = 0; lane < nbLanes; lane++) {
+            classes[i + lane] = GBTPredictor_Compiled_classify(
+                    compiled, maxValue[lane], maxInd[lane]);
+        }
+    }
+}
+
+/// A GBTModel along with its compiled predictor, owned by the selector
+typedef struct {
+    const GBTModel* model;
+    GBTPredictor_Compiled compiled;
+} GBTCompiledModel;
+
+/// @returns the compiled @p model, or NULL if its predictor can't be compiled
+static GBTCompiledModel* GBTCompiledModel_create(const GBTModel* model)
+{
+    const size_t bound = GBTPredictor_compiledBound(model->predictor);
+    // The compiled predictor is stored right after the struct
+    GBTCompiledModel* const compiledModel =
+            (GBTCompiledModel*)malloc(sizeof(GBTCompiledModel) + bound);
+    if (compiledModel == NULL) {
+        return NULL;
+    }
+    void* const buffer = compiledModel + 1;
+    const ZL_Report size =
+            GBTPredictor_compile(model->predictor, buffer, bound);
+    if (ZL_isError(size)
+        || ZL_isError(GBTPredictor_Compiled_load(
+                &compiledModel->compiled, buffer, ZL_validResult(size)))) {
+        free(compiledModel);
+        return NULL;
+    }
+    compiledModel->model = model;
+    return compiledModel;
+}
+
+static const char* GBTCompiledModel_predict(
+        const void* opaque,
+        const ZL_Input* in)
+{
+    const GBTCompiledModel* compiledModel = (const GBTCompiledModel*)opaque;
+    ZL_RESULT_OF(Label)
+    result = GBTModel_predictWith(
+            compiledModel->model, &compiledModel->compiled, in);
+    if (ZL_RES_isError(result)) {
+        return "";
+    }
+    return ZL_RES_value(result);
+}
+
+static void GBTCompiledModel_free(const void* opaque)
+{
+    // The selector only hands out a const pointer to the model it owns
+    free((void*)(uintptr_t)opaque);
+}
+
 ZL_GraphID ZL_Compressor_registerGBTModelGraph(
         ZL_Compressor* cgraph,
         const GBTModel* gbtModel,
@@ -292,6 +832,13 @@ ZL_GraphID ZL_Compressor_registerGBTModelGraph(
         .free    = NULL,
         .opaque  = gbtModel,
     };
+    // Models which can't be compiled are evaluated as they are
+    GBTCompiledModel* const compiledModel = GBTCompiledModel_create(gbtModel);
+    if (compiledModel != NULL) {
+        zs2_model.predict = GBTCompiledModel_predict;
+        zs2_model.free    = GBTCompiledModel_free;
+        zs2_model.opaque  = compiledModel;
+    }
 
     ZL_MLSelectorDesc mlSelector = {
         .model        = zs2_model,
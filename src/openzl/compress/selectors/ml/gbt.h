@@ -2,6 +2,8 @@
 #ifndef ZSTRONG_COMPRESS_SELECTORS_ML_GBT_H
 #define ZSTRONG_COMPRESS_SELECTORS_ML_GBT_H
 
+#include <stdint.h>
+
 #include "openzl/compress/selectors/ml/features.h"
 #include "openzl/compress/selectors/ml/mlselector.h"
 #include "openzl/shared/portability.h"
@@ -184,9 +186,117 @@ ZL_Report GBTPredictor_validate_tree(
         const GBTPredictor_Tree* tree,
         int nbFeatures);
 
+/**
+ * A node of a GBTPredictor_Compiled, packed in 16 bytes. The children of an
+ * internal node are stored next to each other, the right child right after the
+ * left one. Leaves point back to themselves: their threshold is NaN and they
+ * send missing values left, so that a tree can be evaluated in a fixed number
+ * of steps without checking for leaves.
+ */
+typedef struct {
+    float threshold;
+    /// Index of the feature, ORed with GBT_COMPILED_DEFAULT_LEFT when missing
+    /// values take the left child rather than the right one
+    uint32_t feature;
+    uint32_t leftChildIdx;
+    /// Value of leaves, 0 for internal nodes
+    float value;
+} GBTPredictor_CompiledNode;
+
+#define GBT_COMPILED_DEFAULT_LEFT 0x80000000u
+#define GBT_COMPILED_MAX_FEATURES (1u << 20)
+#define GBT_COMPILED_MAX_NODES (1u << 27)
+
+typedef struct {
+    /// Index of the root of the tree in GBTPredictor_Compiled::nodes
+    uint32_t root;
+    /// Number of steps from the root to the deepest leaf
+    uint32_t depth;
+} GBTPredictor_CompiledTree;
+
+/**
+ * A GBTPredictor compiled for fast evaluation. It is a view of a flat buffer,
+ * produced by GBTPredictor_compile(), which can be stored and loaded back with
+ * GBTPredictor_Compiled_load() without any allocation:
+ * - A header of 8 32-bit words: magic number, numForests, numTrees, numNodes,
+ *   numFeatures, and 3 reserved words which must be 0.
+ * - The end of each forest in the array of trees.
+ * - The trees, ordered by forest.
+ * - The nodes of all trees, each tree in breadth-first order.
+ * All fields are in native endianness.
+ *
+ * Several trees, or several inputs, are evaluated at once in lockstep, and the
+ * predictions are exactly the ones of GBTPredictor_predict().
+ */
+typedef struct {
+    size_t numForests;
+    size_t numTrees;
+    size_t numNodes;
+    /// Features at or beyond this index are never read
+    size_t numFeatures;
+    const uint32_t* forestEnds;
+    const GBTPredictor_CompiledTree* trees;
+    const GBTPredictor_CompiledNode* nodes;
+} GBTPredictor_Compiled;
+
+/**
+ * @returns An upper bound on the size of the buffer GBTPredictor_compile()
+ * produces for @p predictor.
+ */
+size_t GBTPredictor_compiledBound(const GBTPredictor* predictor);
+
+/**
+ * Compiles @p predictor into the flat buffer @p dst, which must be aligned on 4
+ * bytes. The predictor is validated first, and must be made of actual trees
+ * (no node reachable from two parents), with missing values taking either the
+ * left or the right child of each node.
+ *
+ * @returns The size of the compiled predictor, or an error.
+ */
+ZL_Report GBTPredictor_compile(
+        const GBTPredictor* predictor,
+        void* dst,
+        size_t dstCapacity);
+
+/**
+ * Loads the compiled predictor in @p src, which must be aligned on 4 bytes and
+ * outlive @p compiled. The predictor is validated, so that evaluating it never
+ * reads out of bounds, even if @p src comes from an untrusted source.
+ */
+ZL_Report GBTPredictor_Compiled_load(
+        GBTPredictor_Compiled* compiled,
+        const void* src,
+        size_t srcSize);
+
+/**
+ * Calculates the prediction for a single set of features.
+ *
+ * @returns the index of the classified class.
+ */
+size_t GBTPredictor_Compiled_predict(
+        const GBTPredictor_Compiled* compiled,
+        const float* features,
+        size_t nbFeatures);
+
+/**
+ * Calculates the predictions for @p nbInputs sets of features at once. The
+ * features of the input i are the @p nbFeatures floats at
+ * `features + i * featuresStride`.
+ *
+ * @param classes Filled with the index of the classified class of each input
+ */
+void GBTPredictor_Compiled_predictBatch(
+        const GBTPredictor_Compiled* compiled,
+        const float* features,
+        size_t featuresStride,
+        size_t nbFeatures,
+        size_t nbInputs,
+        size_t* classes);
+
 /**
  * Creates a typed selector based on the information from a GBTModel
- * NOTE: This function does not take ownership of `model`.
+ * NOTE: This function does not take ownership of `model`. Its predictor is
+ * compiled when possible, so that the selector runs the compiled predictor.
  *
  * `model` will be referenced by the new graph and needs to
  * outlive it. The user is responsible of destorying `model` once
@@ -5,6 +5,7 @@
 
 #include "openzl/common/wire_format.h"            // PublicTransformInfo
 #include "openzl/decompress/decode_frameheader.h" // DFH_Struct
+#include "openzl/decompress/decompress_stream.h"  // DSTREAM_State
 #include "openzl/shared/portability.h"
 #include "openzl/zl_data.h"         // ZL_Type
 #include "openzl/zl_decompress.h"   // ZL_DCtx
@@ -66,6 +67,49 @@ const ZL_Data* ZL_DCtx_getConstStream(const ZL_DCtx* dctx, ZL_IDType streamID);
  */
 unsigned ZL_DCtx_getFrameFormatVersion(const ZL_DCtx* dctx);
 
+/****************************************************
+ * Streaming decompression support
+ *
+ * Used by ZL_DCtx_decompressStream(),
+ * which decodes a frame one Chunk at a time.
+ ***************************************************/
+
+DSTREAM_State* DCTX_getStreamState(const ZL_DCtx* dctx);
+void DCTX_setStreamState(ZL_DCtx* dctx, DSTREAM_State* dstream);
+
+/* DCTX_startStreamFrame():
+ * Applies parameters, and decodes the frame header @p src,
+ * which must be complete.
+ * The frame must have exactly @p nbOutputs outputs.
+ * @returns The size of the frame header, or an error.
+ */
+ZL_Report DCTX_startStreamFrame(
+        ZL_DCtx* dctx,
+        const void* src,
+        size_t srcSize,
+        size_t nbOutputs);
+
+/* DCTX_decodeStreamChunk():
+ * Decodes the chunk @p src, which must be exactly one complete chunk,
+ * and verifies its content checksum, if present.
+ * On success, @p chunkOutputs, which must have room for one entry per output
+ * of the frame, references the content regenerated for each output,
+ * which remains valid until the next call, or the end of the frame.
+ * It may reference @p src.
+ */
+ZL_Report DCTX_decodeStreamChunk(
+        ZL_DCtx* dctx,
+        const ZL_Data* chunkOutputs[],
+        const void* src,
+        size_t srcSize);
+
+/* DCTX_endStreamFrame():
+ * Releases the memory employed by the frame,
+ * and resets parameters unless they are sticky.
+ * Also used to abandon the frame after an error.
+ */
+ZL_Report DCTX_endStreamFrame(ZL_DCtx* dctx);
+
 /****************************************************
  * Benchmarking & analysis functions
  *
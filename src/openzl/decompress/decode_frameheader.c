@@ -17,6 +17,7 @@
 #include "openzl/fse/hist.h"           // HIST_count_simple
 #include "openzl/shared/bits.h"
 #include "openzl/shared/mem.h"    // ZL_readLE32, etc.
+#include "openzl/shared/varint.h" // ZL_varintDecode
 #include "openzl/shared/xxhash.h" // XXH3_64bits
 #include "openzl/zl_data.h"
 #include "openzl/zl_decompress.h" // ZS2_* public methods
@@ -34,6 +35,9 @@ struct ZL_FrameInfo {
     uint64_t* decompressedSizes;
     uint64_t* numElts;
     size_t frameHeaderSize;
+    // When content size is not stored in frame header (streaming),
+    // tells if it was recovered by scanning chunk headers
+    bool contentSizeResolved;
 };
 
 static ZL_Type decodeType(uint8_t et)
@@ -90,11 +94,14 @@ static ZL_Report DFH_decodeNbOutputs(
         }
         return ZL_returnValue(nbOutputs);
     } else { // format >= ZL_CHUNK_VERSION_MIN
-        ZL_RET_R_IF_LT(srcSize_tooSmall, cSize, *consumedPtr + 1 + 4);
+        // Only request what's needed, so that the frame header can be measured
+        // without any following data
+        ZL_RET_R_IF_LT(srcSize_tooSmall, cSize, *consumedPtr + 1);
         uint8_t token1 = ((const uint8_t*)cSrc)[*consumedPtr];
         *consumedPtr += 1;
         size_t nbOutputs = (size_t)(token1 & 15);
         if (nbOutputs == 15) {
+            ZL_RET_R_IF_LT(srcSize_tooSmall, cSize, *consumedPtr + 1);
             uint8_t token2 = ((const uint8_t*)cSrc)[*consumedPtr];
             *consumedPtr += 1;
             nbOutputs = ((size_t)token2 << 4) + ((size_t)token1 >> 4) + 15;
@@ -200,14 +207,13 @@ static ZL_Report DFH_decodeOutputSizes_v21(
     const uint8_t* end = ptr + cSize;
 
     ZL_RET_R_IF_LT(srcSize_tooSmall, cSize, 1);
-    {
-        uint8_t const firstByte = ((const uint8_t*)src)[0];
-        // 0 means "final output size(s) are unknown"
-        ZL_RET_R_IF_EQ(
-                temporaryLibraryLimitation,
-                firstByte,
-                0x0,
-                "doesn't support unknown size outputs for the time being");
+    if (((const uint8_t*)src)[0] == 0) {
+        // 0 means "final output size(s) are unknown":
+        // each chunk header stores the size of its own outputs instead.
+        // Sizes are then resolved by DFH_resolveContentSizes().
+        memset(dSizes, 0, nbOutputs * sizeof(*dSizes));
+        memset(numElts, 0, nbOutputs * sizeof(*numElts));
+        return ZL_returnValue(1);
     }
 
     for (size_t n = 0; n < nbOutputs; n++) {
@@ -280,6 +286,13 @@ static ZL_Report DFH_FrameInfo_decodeFrameHeader(
         uint8_t const flags                = ((const uint8_t*)cSrc)[consumed++];
         zfi->properties.hasContentChecksum = ((flags & (1 << 0)) != 0);
         zfi->properties.hasCompressedChecksum = ((flags & (1 << 1)) != 0);
+        zfi->properties.hasSeekTable          = ((flags & (1 << 2)) != 0);
+        ZL_RET_R_IF(
+                corruption,
+                zfi->properties.hasSeekTable
+                        && zfi->formatVersion < ZL_SEEK_TABLE_VERSION_MIN,
+                "Seek table requires format version >= %u",
+                ZL_SEEK_TABLE_VERSION_MIN);
     }
 
     /* nb of outputs */
@@ -321,6 +334,15 @@ static ZL_Report DFH_FrameInfo_decodeFrameHeader(
                     types,
                     zfi->nbOutputs,
                     formatVersion));
+    zfi->properties.unknownContentSize = (formatVersion >= ZL_CHUNK_VERSION_MIN)
+            && (((const uint8_t*)cSrc)[consumed] == 0);
+    // Versions 21 to 23 reserve the 0 size for a different chunk header layout
+    ZL_RET_R_IF(
+            formatVersion_unsupported,
+            zfi->properties.unknownContentSize
+                    && formatVersion < ZL_UNKNOWN_SIZE_VERSION_MIN,
+            "Unknown content size requires format version >= %u",
+            ZL_UNKNOWN_SIZE_VERSION_MIN);
     consumed += oss;
     ZL_DLOG(BLOCK,
             "DFH_FrameInfo_decodeFrameHeader consumed %zu bytes from header",
@@ -353,6 +375,16 @@ ZL_FrameInfo* ZL_FrameInfo_create(const void* cSrc, size_t cSize)
         ZL_FrameInfo_free(zfi);
         return NULL;
     }
+    if (zfi->properties.unknownContentSize) {
+        // Sizes remain unknown if the frame is incomplete
+        DFH_Struct dfh;
+        DFH_init(&dfh);
+        dfh.frameinfo     = zfi;
+        dfh.formatVersion = (uint32_t)zfi->formatVersion;
+        (void)DFH_resolveContentSizes(&dfh, cSrc, cSize);
+        dfh.frameinfo = NULL;
+        DFH_destroy(&dfh);
+    }
     return zfi;
 }
 
@@ -403,6 +435,10 @@ ZL_Report ZL_FrameInfo_getDecompressedSize(
             (int)zfi->nbOutputs,
             "This frame only contains %zu outputs",
             zfi->nbOutputs);
+    ZL_RET_R_IF(
+            srcSize_tooSmall,
+            zfi->properties.unknownContentSize && !zfi->contentSizeResolved,
+            "Content size is only known once the whole frame is provided");
     ZL_ASSERT_NN(zfi->decompressedSizes);
     return ZL_returnValue(zfi->decompressedSizes[outputID]);
 }
@@ -436,6 +472,10 @@ ZL_Report ZL_FrameInfo_getNumElts(const ZL_FrameInfo* zfi, int outputID)
             outType,
             ZL_Type_numeric,
             "this method doesn't support Numeric type yet");
+    ZL_RET_R_IF(
+            srcSize_tooSmall,
+            zfi->properties.unknownContentSize && !zfi->contentSizeResolved,
+            "Content size is only known once the whole frame is provided");
 
     ZL_ASSERT_NN(zfi->numElts);
     return ZL_returnValue(zfi->numElts[outputID]);
@@ -500,6 +540,10 @@ void DFH_init(DFH_Struct* dfh)
     VECTOR_INIT(dfh->nodes, ZL_runtimeNodeLimit(ZL_MAX_FORMAT_VERSION));
     VECTOR_INIT(
             dfh->regenDistances, ZL_runtimeStreamLimit(ZL_MAX_FORMAT_VERSION));
+    VECTOR_INIT(
+            dfh->chunkOutputSizes, ZL_runtimeInputLimit(ZL_MAX_FORMAT_VERSION));
+    VECTOR_INIT(
+            dfh->chunkNumElts, ZL_runtimeInputLimit(ZL_MAX_FORMAT_VERSION));
 }
 
 void DFH_destroy(DFH_Struct* dfh)
@@ -509,6 +553,8 @@ void DFH_destroy(DFH_Struct* dfh)
     VECTOR_DESTROY(dfh->storedStreamSizes);
     VECTOR_DESTROY(dfh->nodes);
     VECTOR_DESTROY(dfh->regenDistances);
+    VECTOR_DESTROY(dfh->chunkOutputSizes);
+    VECTOR_DESTROY(dfh->chunkNumElts);
     ZL_FrameInfo_free(dfh->frameinfo);
     dfh->frameinfo = NULL;
 }
@@ -582,12 +628,182 @@ int FrameInfo_hasCompressedChecksum(const ZL_FrameInfo* fi)
     return fi->properties.hasCompressedChecksum;
 }
 
+int FrameInfo_hasSeekTable(const ZL_FrameInfo* fi)
+{
+    ZL_ASSERT_NN(fi);
+    return fi->properties.hasSeekTable;
+}
+
+int FrameInfo_hasUnknownContentSize(const ZL_FrameInfo* fi)
+{
+    ZL_ASSERT_NN(fi);
+    return fi->properties.unknownContentSize;
+}
+
 size_t FrameInfo_frameHeaderSize(const ZL_FrameInfo* fi)
 {
     ZL_ASSERT_NN(fi);
     return fi->frameHeaderSize;
 }
 
+// -------------------------------------------------
+// Seek table
+// -------------------------------------------------
+
+/* Parses the seek table starting at @p src.
+ * When @p arena is provided, @p st receives the chunk offsets,
+ * otherwise, only @p st->nbChunks is filled.
+ * @return size of the seek table, including its footer */
+static ZL_Report DFH_parseSeekTable(
+        DFH_SeekTable* st,
+        Arena* arena,
+        size_t nbOutputs,
+        uint64_t chunksStart,
+        const void* src,
+        size_t srcSize)
+{
+    ZL_ASSERT_NN(st);
+    ZL_ASSERT_GT(nbOutputs, 0);
+    const uint8_t* const start = (const uint8_t*)src;
+    const uint8_t* const end   = start + srcSize;
+    const uint8_t* ptr         = start;
+    ZL_TRY_LET_T(uint64_t, nbChunks, ZL_varintDecode(&ptr, end));
+    // Each entry employs at least 1 byte per field
+    ZL_RET_R_IF_GT(
+            corruption, nbChunks, srcSize / (1 + 2 * nbOutputs), "seek table");
+    memset(st, 0, sizeof(*st));
+    st->nbChunks  = (size_t)nbChunks;
+    st->nbOutputs = nbOutputs;
+
+    uint64_t* chunkOffsets   = NULL;
+    uint64_t* contentOffsets = NULL;
+    uint64_t* eltOffsets     = NULL;
+    if (arena != NULL) {
+        size_t const offsetsSize = (st->nbChunks + 1) * sizeof(uint64_t);
+        chunkOffsets   = ALLOC_Arena_malloc(arena, offsetsSize);
+        contentOffsets = ALLOC_Arena_calloc(arena, offsetsSize * nbOutputs);
+        eltOffsets     = ALLOC_Arena_calloc(arena, offsetsSize * nbOutputs);
+        ZL_RET_R_IF(
+                allocation,
+                chunkOffsets == NULL || contentOffsets == NULL
+                        || eltOffsets == NULL);
+        chunkOffsets[0]    = chunksStart;
+        st->chunkOffsets   = chunkOffsets;
+        st->contentOffsets = contentOffsets;
+        st->eltOffsets     = eltOffsets;
+    }
+
+    for (size_t c = 0; c < st->nbChunks; c++) {
+        ZL_TRY_LET_T(uint64_t, chunkSize, ZL_varintDecode(&ptr, end));
+        if (arena != NULL) {
+            ZL_RET_R_IF_GT(
+                    corruption, chunkSize, UINT64_MAX - chunkOffsets[c]);
+            chunkOffsets[c + 1] = chunkOffsets[c] + chunkSize;
+        }
+        for (size_t n = 0; n < nbOutputs; n++) {
+            ZL_TRY_LET_T(uint64_t, contentSize, ZL_varintDecode(&ptr, end));
+            ZL_TRY_LET_T(uint64_t, numElts, ZL_varintDecode(&ptr, end));
+            if (arena == NULL)
+                continue;
+            size_t const prev = c * nbOutputs + n;
+            size_t const next = prev + nbOutputs;
+            ZL_RET_R_IF_GT(
+                    corruption, contentSize, UINT64_MAX - contentOffsets[prev]);
+            ZL_RET_R_IF_GT(corruption, numElts, UINT64_MAX - eltOffsets[prev]);
+            contentOffsets[next] = contentOffsets[prev] + contentSize;
+            eltOffsets[next]     = eltOffsets[prev] + numElts;
+        }
+    }
+
+    size_t const tableSize = (size_t)(ptr - start);
+    ZL_RET_R_IF_LT(
+            srcSize_tooSmall,
+            (size_t)(end - ptr),
+            ZL_SEEK_TABLE_FOOTER_SIZE);
+    ZL_RET_R_IF_NE(corruption, ZL_readLE32(ptr), tableSize);
+    return ZL_returnValue(tableSize + ZL_SEEK_TABLE_FOOTER_SIZE);
+}
+
+ZL_Report
+DFH_getSeekTableSize(const ZL_FrameInfo* fi, const void* src, size_t srcSize)
+{
+    ZL_ASSERT_NN(fi);
+    ZL_ASSERT(fi->properties.hasSeekTable);
+    DFH_SeekTable st;
+    return DFH_parseSeekTable(&st, NULL, fi->nbOutputs, 0, src, srcSize);
+}
+
+ZL_Report DFH_decodeSeekTable(
+        DFH_SeekTable* st,
+        Arena* arena,
+        const ZL_FrameInfo* fi,
+        const void* src,
+        size_t srcSize)
+{
+    ZL_ASSERT_NN(fi);
+    ZL_RET_R_IF_NOT(
+            frameParameter_unsupported,
+            fi->properties.hasSeekTable,
+            "Frame doesn't have a seek table");
+    size_t const hSize = fi->frameHeaderSize;
+    // frame header, end-of-frame marker, nbChunks and footer
+    ZL_RET_R_IF_LT(
+            srcSize_tooSmall, srcSize, hSize + 2 + ZL_SEEK_TABLE_FOOTER_SIZE);
+    size_t const tableSize = ZL_readLE32(
+            (const char*)src + srcSize - ZL_SEEK_TABLE_FOOTER_SIZE);
+    ZL_RET_R_IF_GT(
+            corruption,
+            tableSize,
+            srcSize - (hSize + 1 + ZL_SEEK_TABLE_FOOTER_SIZE));
+    size_t const tableStart = srcSize - ZL_SEEK_TABLE_FOOTER_SIZE - tableSize;
+    size_t const chunksEnd  = tableStart - 1;
+    ZL_RET_R_IF_NE(corruption, ((const uint8_t*)src)[chunksEnd], 0);
+
+    ZL_TRY_LET_R(
+            stSize,
+            DFH_parseSeekTable(
+                    st,
+                    arena,
+                    fi->nbOutputs,
+                    hSize,
+                    (const char*)src + tableStart,
+                    srcSize - tableStart));
+    ZL_RET_R_IF_NE(corruption, tableStart + stSize, srcSize);
+
+    if (arena != NULL) {
+        // Seek table must describe exactly the content of the frame
+        ZL_RET_R_IF_NE(corruption, st->chunkOffsets[st->nbChunks], chunksEnd);
+        if (fi->properties.unknownContentSize && !fi->contentSizeResolved) {
+            // Content size not stored in frame header: nothing to compare
+            return ZL_returnValue(st->nbChunks);
+        }
+        size_t const last = st->nbChunks * st->nbOutputs;
+        for (size_t n = 0; n < st->nbOutputs; n++) {
+            ZL_RET_R_IF_NE(
+                    corruption,
+                    st->contentOffsets[last + n],
+                    fi->decompressedSizes[n]);
+            // numElts of struct and numeric outputs isn't in frame header
+            if (fi->types[n] == ZL_Type_serial
+                || fi->types[n] == ZL_Type_string) {
+                ZL_RET_R_IF_NE(
+                        corruption, st->eltOffsets[last + n], fi->numElts[n]);
+            }
+        }
+    }
+    return ZL_returnValue(st->nbChunks);
+}
+
+ZL_Report ZL_getNumChunks(const void* src, size_t srcSize)
+{
+    ZL_FrameInfo* const fi = ZL_FrameInfo_create(src, srcSize);
+    ZL_RET_R_IF_NULL(header_unknown, fi);
+    DFH_SeekTable st;
+    ZL_Report const r = DFH_decodeSeekTable(&st, NULL, fi, src, srcSize);
+    ZL_FrameInfo_free(fi);
+    return r;
+}
+
 static ZL_Report
 checkedBitpackDecode8(uint8_t* dst, size_t nbElts, ZL_RC* src, int nbBits)
 {
@@ -877,7 +1093,11 @@ static ZL_Report DFH_decodeFrameHeader_V3orMore(
         unsigned formatVersion)
 {
     ZL_DLOG(FRAME, "decodeFrameHeader (srcSize = %zu)", srcSize);
-    ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, FRAME_HEADER_SIZE_MIN);
+    ZL_RET_R_IF_LT(
+            srcSize_tooSmall,
+            srcSize,
+            formatVersion >= ZL_CHUNK_VERSION_MIN ? FRAME_HEADER_SIZE_MIN_V21
+                                                  : FRAME_HEADER_SIZE_MIN);
 
     ZL_ASSERT_GE(formatVersion, 3);
     dfh->formatVersion = formatVersion;
@@ -889,6 +1109,54 @@ static ZL_Report DFH_decodeFrameHeader_V3orMore(
     return DFH_FrameInfo_decodeFrameHeader(dfh->frameinfo, src, srcSize);
 }
 
+/* Decodes the size of each output regenerated by the current chunk,
+ * only present when content size is not stored in the frame header */
+static ZL_Report DFH_decodeChunkOutputSizes(DFH_Struct* dfh, ZL_RC* in)
+{
+    const ZL_FrameInfo* const fi = dfh->frameinfo;
+    size_t const nbOutputs       = fi->nbOutputs;
+    ZL_RET_R_IF_NE(
+            allocation,
+            nbOutputs,
+            VECTOR_RESIZE(dfh->chunkOutputSizes, nbOutputs));
+    ZL_RET_R_IF_NE(
+            allocation, nbOutputs, VECTOR_RESIZE(dfh->chunkNumElts, nbOutputs));
+
+    for (size_t n = 0; n < nbOutputs; n++) {
+        ZL_RESULT_OF(uint64_t) res = ZL_RC_popVarint(in);
+        ZL_RET_R_IF_ERR(res);
+        ZL_RET_R_IF_GE(corruption, ZL_RES_value(res), (uint64_t)SIZE_MAX);
+        VECTOR_AT(dfh->chunkOutputSizes, n) = (size_t)ZL_RES_value(res);
+    }
+    for (size_t n = 0; n < nbOutputs; n++) {
+        size_t numElts = 0;
+        switch (fi->types[n]) {
+            default:
+                ZL_ASSERT_FAIL("invalid type");
+                ZL_FALLTHROUGH;
+            case ZL_Type_struct:
+            case ZL_Type_numeric:
+                // not stored
+                break;
+            case ZL_Type_serial:
+                numElts = VECTOR_AT(dfh->chunkOutputSizes, n);
+                break;
+            case ZL_Type_string: {
+                ZL_RESULT_OF(uint64_t) res = ZL_RC_popVarint(in);
+                ZL_RET_R_IF_ERR(res);
+                ZL_RET_R_IF_GT(
+                        corruption,
+                        ZL_RES_value(res),
+                        VECTOR_AT(dfh->chunkOutputSizes, n));
+                numElts = (size_t)ZL_RES_value(res);
+                break;
+            }
+        }
+        VECTOR_AT(dfh->chunkNumElts, n) = numElts;
+    }
+    return ZL_returnSuccess();
+}
+
 /* src is expected to start at beginning of chunk header */
 static ZL_Report decodeChunkHeader_internal(
         DFH_Struct* dfh,
@@ -965,6 +1233,12 @@ static ZL_Report decodeChunkHeader_internal(
                 ((flags & (1 << 1)) != 0);
     }
 
+    // Frames of unknown content size store sizes at chunk level
+    if (decoder->formatVersion >= ZL_UNKNOWN_SIZE_VERSION_MIN
+        && dfh->frameinfo->properties.unknownContentSize) {
+        ZL_RET_R_IF_ERR(DFH_decodeChunkOutputSizes(dfh, &in));
+    }
+
     {
         // Collect list of decoders
         uint8_t* trt8 = wksp.scratch2;
@@ -1130,11 +1404,14 @@ static ZL_Report getDecompressedSizeV3orMore(
     const uint8_t* ptr = (const uint8_t*)src + hSize;
     const uint8_t* end = (const uint8_t*)src + srcSize;
     ZL_TRY_SET_T(uint64_t, oSize, ZL_varintDecode(&ptr, end));
-    ZL_RET_R_IF_EQ(
-            temporaryLibraryLimitation,
-            oSize,
-            0,
-            "size must be registered in the frame header"); // 0 means "unknown"
+    if (oSize == 0) {
+        // 0 means "unknown" : sizes are stored in each chunk header
+        ZL_FrameInfo* const fi = ZL_FrameInfo_create(src, srcSize);
+        ZL_RET_R_IF_NULL(header_unknown, fi);
+        ZL_Report const r = ZL_FrameInfo_getDecompressedSize(fi, 0);
+        ZL_FrameInfo_free(fi);
+        return r;
+    }
     ZL_DLOG(BLOCK, "1 stream, of decompressed size %llu bytes", oSize - 1);
     ZL_RET_R_IF_GE(
             GENERIC,
@@ -1144,6 +1421,30 @@ static ZL_Report getDecompressedSizeV3orMore(
     return ZL_returnValue((size_t)oSize - 1);
 }
 
+/* @return size of the chunk starting at @p src,
+ * including its header, stored streams and checksums.
+ * @note fills @p dfh with the chunk header content */
+static ZL_Report getChunkSize(
+        const DFH_Interface* decoder,
+        DFH_Struct* dfh,
+        const void* src,
+        size_t srcSize)
+{
+    ZL_TRY_LET_R(
+            chhSize, decoder->decodeChunkHeader(decoder, dfh, src, srcSize));
+    size_t chunkSize = chhSize;
+
+    chunkSize += dfh->totalTHSize;
+
+    for (uint32_t streamNb = 0; streamNb < dfh->nbStoredStreams; streamNb++) {
+        chunkSize += VECTOR_AT(dfh->storedStreamSizes, streamNb);
+    }
+
+    chunkSize += dfh->frameinfo->properties.hasContentChecksum ? 4 : 0;
+    chunkSize += dfh->frameinfo->properties.hasCompressedChecksum ? 4 : 0;
+    return ZL_returnValue(chunkSize);
+}
+
 // @note (@cyan): how useful is this method ?
 // I see it used in one assert() so far,
 // though it requires duplicating the frame scanning logic here
@@ -1177,27 +1478,26 @@ static ZL_Report getCompressedSizeV3orMore(
             if (((const char*)src)[frameSize] == 0) {
                 // frame footer
                 frameSize++;
+                if (FrameInfo_hasSeekTable(dfh.frameinfo)) {
+                    ZL_TRY_LET_R(
+                            stSize,
+                            DFH_getSeekTableSize(
+                                    dfh.frameinfo,
+                                    (const char*)src + frameSize,
+                                    srcSize - frameSize));
+                    frameSize += stSize;
+                }
                 break;
             }
         }
         ZL_TRY_LET_R(
-                chhSize,
-                decoder->decodeChunkHeader(
+                chunkSize,
+                getChunkSize(
                         decoder,
                         &dfh,
                         (const char*)src + frameSize,
                         srcSize - frameSize));
-        frameSize += chhSize;
-
-        frameSize += dfh.totalTHSize;
-
-        for (uint32_t streamNb = 0; streamNb < dfh.nbStoredStreams;
-             streamNb++) {
-            frameSize += VECTOR_AT(dfh.storedStreamSizes, streamNb);
-        }
-
-        frameSize += dfh.frameinfo->properties.hasContentChecksum ? 4 : 0;
-        frameSize += dfh.frameinfo->properties.hasCompressedChecksum ? 4 : 0;
+        frameSize += chunkSize;
 
         if (dfh.formatVersion < ZL_CHUNK_VERSION_MIN)
             break; // single block for v20-
@@ -1272,3 +1572,58 @@ DFH_decodeChunkHeader(DFH_Struct* dfh, const void* src, size_t srcSize)
             DFH_getChunkHeaderDecoder((uint32_t)formatVersion);
     return decoder.decodeChunkHeader(&decoder, dfh, src, srcSize);
 }
+
+ZL_Report DFH_getChunkSize(DFH_Struct* dfh, const void* src, size_t srcSize)
+{
+    ZL_TRY_LET_R(chunkSize, DFH_getChunkSizeFromHeader(dfh, src, srcSize));
+    ZL_RET_R_IF_GT(srcSize_tooSmall, chunkSize, srcSize);
+    return ZL_returnValue(chunkSize);
+}
+
+ZL_Report
+DFH_getChunkSizeFromHeader(DFH_Struct* dfh, const void* src, size_t srcSize)
+{
+    ZL_ASSERT_NN(dfh);
+    DFH_Interface const decoder =
+            DFH_getChunkHeaderDecoder((uint32_t)dfh->formatVersion);
+    return getChunkSize(&decoder, dfh, src, srcSize);
+}
+
+ZL_Report
+DFH_resolveContentSizes(DFH_Struct* dfh, const void* src, size_t srcSize)
+{
+    ZL_ASSERT_NN(dfh);
+    ZL_FrameInfo* const fi = dfh->frameinfo;
+    ZL_ASSERT_NN(fi);
+    if (!fi->properties.unknownContentSize || fi->contentSizeResolved)
+        return ZL_returnSuccess();
+    ZL_DLOG(FRAME, "DFH_resolveContentSizes: scanning chunk headers");
+
+    size_t const nbOutputs = fi->nbOutputs;
+    memset(fi->decompressedSizes, 0, nbOutputs * sizeof(uint64_t));
+    memset(fi->numElts, 0, nbOutputs * sizeof(uint64_t));
+    size_t pos = fi->frameHeaderSize;
+    while (1) {
+        ZL_RET_R_IF_GE(srcSize_tooSmall, pos, srcSize);
+        if (((const uint8_t*)src)[pos] == 0) {
+            // end of frame marker
+            break;
+        }
+        ZL_TRY_LET_R(
+                chunkSize,
+                DFH_getChunkSize(
+                        dfh, (const char*)src + pos, srcSize - pos));
+        for (size_t n = 0; n < nbOutputs; n++) {
+            uint64_t const dSize = VECTOR_AT(dfh->chunkOutputSizes, n);
+            ZL_RET_R_IF_GT(
+                    corruption,
+                    dSize,
+                    (uint64_t)SIZE_MAX - fi->decompressedSizes[n]);
+            fi->decompressedSizes[n] += dSize;
+            fi->numElts[n] += VECTOR_AT(dfh->chunkNumElts, n);
+        }
+        pos += chunkSize;
+    }
+    fi->contentSizeResolved = true;
+    return ZL_returnSuccess();
+}
@@ -3,6 +3,7 @@
 #ifndef ZSTRONG_DECOMPRESS_DECODE_FRAME_HEADER_H
 #define ZSTRONG_DECOMPRESS_DECODE_FRAME_HEADER_H
 
+#include "openzl/common/allocation.h" // Arena
 #include "openzl/common/vector.h"
 #include "openzl/common/wire_format.h" // PublicTransformInfo, ZL_FrameHeaderInfo
 #include "openzl/shared/portability.h"
@@ -16,6 +17,7 @@ ZL_BEGIN_C_DECLS
  */
 // ZL_Report ZL_getDecompressedSize(const void* src, size_t srcSize)
 // ZL_Report ZL_getHeaderSize(const void* src, size_t srcSize)
+// ZL_Report ZL_getNumChunks(const void* src, size_t srcSize)
 
 /* Non-public symbols exposed by this unit */
 
@@ -50,6 +52,10 @@ typedef struct {
     VECTOR(DFH_NodeInfo) nodes; // info about each decoder transform
     size_t totalTHSize;     // Size of all private transform headers combined
     uint32_t formatVersion; // Format version of the frame
+    VECTOR(size_t) chunkOutputSizes; // size of each output in current chunk,
+                                     // only for frames of unknown content size
+    VECTOR(size_t) chunkNumElts;     // nb of elts of each output in current
+                                     // chunk, same condition
 } DFH_Struct;
 
 /// Init the @p dfh
@@ -83,6 +89,35 @@ DFH_decodeFrameHeader(DFH_Struct* dfh, const void* src, size_t srcSize);
 ZL_Report
 DFH_decodeChunkHeader(DFH_Struct* dfh, const void* src, size_t srcSize);
 
+/**
+ * Measure the chunk starting at @src, without decoding its content.
+ * @p dfh must have already been initialized with DFH_decodeFrameHeader().
+ * It is then filled with the chunk header content, like
+ * DFH_decodeChunkHeader().
+ *
+ * @return : size of the whole chunk (header, stored streams and checksums)
+ *           if success, or an error code
+ */
+ZL_Report DFH_getChunkSize(DFH_Struct* dfh, const void* src, size_t srcSize);
+
+/**
+ * Same as DFH_getChunkSize(), but only requires the chunk header to be present
+ * in @p src. The returned size may therefore be larger than @p srcSize.
+ * Used to measure chunks while they are still being received.
+ */
+ZL_Report
+DFH_getChunkSizeFromHeader(DFH_Struct* dfh, const void* src, size_t srcSize);
+
+/**
+ * Frames produced by streaming compression don't store their content size
+ * in the frame header, but in each chunk header instead.
+ * This function scans the whole frame @p src to fill the content size
+ * of each output into `dfh->frameinfo`. It does nothing for other frames.
+ * @p dfh must have already been initialized with DFH_decodeFrameHeader().
+ */
+ZL_Report
+DFH_resolveContentSizes(DFH_Struct* dfh, const void* src, size_t srcSize);
+
 /* @note (@cyan): I kept existing names, `content` and `compressed` checksums,
  * but maybe there are better ones possible.
  * For example, `encoded` & `decoded` .
@@ -93,9 +128,53 @@ int FrameInfo_hasContentChecksum(const ZL_FrameInfo* fi);
 
 int FrameInfo_hasCompressedChecksum(const ZL_FrameInfo* fi);
 
+int FrameInfo_hasSeekTable(const ZL_FrameInfo* fi);
+
+/* true for frames produced by streaming compression,
+ * which store content size in each chunk header instead */
+int FrameInfo_hasUnknownContentSize(const ZL_FrameInfo* fi);
+
 /* note: returns 0 for versions <= 20 */
 size_t FrameInfo_frameHeaderSize(const ZL_FrameInfo* fi);
 
+/// Content of a frame's seek table (see wire_format.h).
+/// Offsets are cumulative, with `nbChunks + 1` entries:
+/// entry `c` is the start of chunk `c`, and entry `nbChunks` is the end of
+/// the last chunk. Per-output offsets are indexed as `c * nbOutputs + n`.
+typedef struct {
+    size_t nbChunks;
+    size_t nbOutputs;
+    const uint64_t* chunkOffsets;   // position of each chunk within the frame
+    const uint64_t* contentOffsets; // decompressed position, in bytes
+    const uint64_t* eltOffsets;     // decompressed position, in elements
+} DFH_SeekTable;
+
+/**
+ * Measure the seek table starting at @p src,
+ * which is the position right after the end-of-frame marker.
+ * @pre @p fi has a seek table
+ *
+ * @return : size of the seek table, including its footer, or an error code
+ */
+ZL_Report
+DFH_getSeekTableSize(const ZL_FrameInfo* fi, const void* src, size_t srcSize);
+
+/**
+ * Locate the seek table from the end of @p src,
+ * which must be exactly one complete frame, whose header is described by @p
+ * fi. When @p arena is provided, @p st is filled with chunk offsets, allocated
+ * into @p arena, and validated against the frame header. Otherwise, only
+ * `st->nbChunks` is filled.
+ *
+ * @return : number of chunks in the frame, or an error code
+ */
+ZL_Report DFH_decodeSeekTable(
+        DFH_SeekTable* st,
+        Arena* arena,
+        const ZL_FrameInfo* fi,
+        const void* src,
+        size_t srcSize);
+
 ZL_END_C_DECLS
 
 #endif // ZSTRONG_DECOMPRESS_DECODE_FRAME_HEADER_H
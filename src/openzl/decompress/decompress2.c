@@ -3,6 +3,7 @@
 // Main decompression function
 
 #include <stdint.h>
+#include <stdlib.h> // qsort
 #include "openzl/common/allocation.h"      // ZL_calloc, ZL_free
 #include "openzl/common/assertion.h"       // ZS_ASSERT_*
 #include "openzl/common/buffer_internal.h" // ZL_RCursor
@@ -12,6 +13,7 @@
 #include "openzl/common/operation_context.h"
 #include "openzl/common/scope_context.h"
 #include "openzl/common/stream.h" // ZL_Data
+#include "openzl/common/trace.h"  // TRACE_*
 #include "openzl/common/vector.h"
 #include "openzl/common/wire_format.h"            // TransformType_e
 #include "openzl/decompress/dctx2.h"              // DCTX_* declarations
@@ -20,6 +22,7 @@
 #include "openzl/decompress/dtransforms.h" // DTransforms_manager, TransformID
 #include "openzl/decompress/gdparams.h"
 #include "openzl/shared/mem.h"    // ZL_readLE32, etc.
+#include "openzl/shared/utils.h"  // ZL_MIN, ZL_MAX
 #include "openzl/shared/xxhash.h" // XXH3_64bits
 #include "openzl/zl_buffer.h"     // ZL_RBuffer
 #include "openzl/zl_data.h"
@@ -71,6 +74,46 @@ typedef struct ZL_DataInfo {
 
 DECLARE_VECTOR_TYPE(ZL_DataInfo)
 
+/* State of a worker decoding Chunks in parallel.
+ * Workers are created on first use, and kept for the lifetime of the DCtx. */
+typedef struct {
+    ZL_DCtx* dctx;          // worker-owned DCtx
+    ZL_Data** outputShells; // chunk-local outputs, one per frame output
+    const void* framePtr;
+    size_t frameSize;
+    size_t chunkStart; // position of the Chunk within the frame
+    size_t chunkSize;
+    uint32_t expectedContentHash;
+    ZL_Report result; // Chunk size, or an error
+} DCTX_ChunkWorker;
+
+/* State of a worker decoding independent stages of a Chunk in parallel.
+ * Its DCtx hosts decoder states and workspace, while streams are shared with
+ * the parent DCtx. Workers are created on first use, and kept for the
+ * lifetime of the DCtx. */
+typedef struct {
+    ZL_DCtx* dctx; // worker-owned DCtx
+    size_t load;   // input bytes assigned within current wave
+    size_t failedStage;
+    ZL_Report result; // success, or error of stage @failedStage
+} DCTX_StageWorker;
+
+/* Decoder stages of the current Chunk, grouped into waves:
+ * stages of a wave only consume streams regenerated by previous waves,
+ * so they can be decoded in any order, or concurrently.
+ * Only built when stages can be decoded in parallel. */
+typedef struct {
+    size_t nbWaves; // 0 means serial decoding
+    size_t* startStreams; // first input stream of each stage
+    DTrPtr* transforms;   // decoder of each stage
+    uint32_t* waves;      // wave of each stage
+    // Current wave
+    size_t nbWaveStages;
+    size_t* waveStages;  // stages of the wave
+    size_t* waveWorkers; // worker assigned to each stage of the wave
+    size_t* groups;      // stages sharing buffers, see DCTX_groupWaveStages()
+} DCTX_StageSchedule;
+
 struct ZL_DCtx_s {
     DTransforms_manager dtm;
     DFH_Struct dfh;
@@ -88,6 +131,14 @@ struct ZL_DCtx_s {
     ZL_OperationContext opCtx;
     GDParams requestedGDParams; // As user-selected at DCtx level
     GDParams appliedGDParams;   // Used at decompression time; DCtx > default
+    ZL_WorkerPool workerPool;   // User-provided, for multi-threaded mode
+    DCTX_ChunkWorker* chunkWorkers;
+    size_t nbChunkWorkers;
+    DCTX_StageWorker* stageWorkers;
+    size_t nbStageWorkers;
+    DCTX_StageSchedule schedule; // of current Chunk
+    bool isStageWorker; // inputs are then released by the parent DCtx
+    DSTREAM_State* dstream; // streaming decompression state, created on demand
 }; // typedef'd to ZL_DCtx within zs2_decompress.h
 
 // --------------------------
@@ -148,6 +199,33 @@ ZL_Report ZL_DCtx_setStreamArena(ZL_DCtx* dctx, ZL_DataArenaType sat)
     return ZL_returnSuccess();
 }
 
+ZL_Report ZL_DCtx_setWorkerPool(ZL_DCtx* dctx, const ZL_WorkerPool* pool)
+{
+    ZL_ASSERT_NN(dctx);
+    if (pool == NULL) {
+        ZL_zeroes(&dctx->workerPool, sizeof(dctx->workerPool));
+        return ZL_returnSuccess();
+    }
+    ZL_RET_R_IF_NULL(parameter_invalid, pool->runTasks);
+    dctx->workerPool = *pool;
+    return ZL_returnSuccess();
+}
+
+ZL_Report ZL_DCtx_setTracer(ZL_DCtx* dctx, ZL_Tracer* tracer)
+{
+    ZL_ASSERT_NN(dctx);
+    // Workers acquire their own ring from the new tracer on next use
+    for (size_t n = 0; n < dctx->nbChunkWorkers; n++) {
+        if (dctx->chunkWorkers[n].dctx != NULL)
+            (void)TRACE_attach(&dctx->chunkWorkers[n].dctx->opCtx, NULL);
+    }
+    for (size_t n = 0; n < dctx->nbStageWorkers; n++) {
+        if (dctx->stageWorkers[n].dctx != NULL)
+            (void)TRACE_attach(&dctx->stageWorkers[n].dctx->opCtx, NULL);
+    }
+    return TRACE_attach(&dctx->opCtx, tracer);
+}
+
 void DCTX_preserveStreams(ZL_DCtx* dctx)
 {
     ZL_ASSERT_NN(dctx);
@@ -168,6 +246,15 @@ void ZL_DCtx_free(ZL_DCtx* dctx)
 {
     if (dctx == NULL)
         return;
+    for (size_t n = 0; n < dctx->nbChunkWorkers; n++) {
+        ZL_DCtx_free(dctx->chunkWorkers[n].dctx);
+    }
+    ZL_free(dctx->chunkWorkers);
+    for (size_t n = 0; n < dctx->nbStageWorkers; n++) {
+        ZL_DCtx_free(dctx->stageWorkers[n].dctx);
+    }
+    ZL_free(dctx->stageWorkers);
+    DSTREAM_free(dctx->dstream);
     VECTOR_DESTROY(dctx->transformInputStreams);
     DCTX_freeStreams(dctx);
     VECTOR_DESTROY(dctx->dataInfos);
@@ -324,6 +411,10 @@ static ZL_Report ZL_AppendToOutputOptimization_register(
         // Does not work with stream preservation, so disable the optimization.
         return ZL_returnValue(0);
     }
+    if (dctx->schedule.nbWaves) {
+        // Inputs would be appended concurrently, in any order.
+        return ZL_returnValue(0);
+    }
     if (!STREAM_hasBuffer(outputData)) {
         // Can only optimize when there is already an output buffer
         // TODO: We could inspect the frame & find the output size
@@ -1220,8 +1311,30 @@ static ZL_Report processStream(
             "Could not find state for transform %u",
             nodeInfo->trpid.trid);
 
+    ZL_TraceRing* const traceRing = TRACE_RING(dctx);
+    uint64_t const traceStart     = TRACE_start(traceRing);
+
     ZL_Report const report = dt->transformFn(&diState, dt, inputs, nbInStreams);
     ZL_RET_R_IF_ERR_COERCE(report);
+    if (traceRing != NULL) {
+        size_t bytesIn = 0;
+        for (size_t n = 0; n < nbInStreams; n++) {
+            bytesIn += ZL_Data_contentSize(inputs[n]);
+        }
+        size_t bytesOut = 0;
+        for (size_t n = 0; n < nodeInfo->nbRegens; n++) {
+            bytesOut += ZL_Data_contentSize(
+                    VECTOR_AT(dctx->dataInfos, regensID[n]).data);
+        }
+        TRACE_record(
+                traceRing,
+                ZL_TraceEventType_codecDecode,
+                dt->miGraphDesc.CTid,
+                trName,
+                traceStart,
+                bytesIn,
+                bytesOut);
+    }
 
     // Check transform's outcome
     for (size_t n = 0; n < nodeInfo->nbRegens; n++) {
@@ -1243,7 +1356,7 @@ static ZL_Report processStream(
             diState.nbRegens);
 
     // Free the input streams
-    if (!dctx->preserveStreams) {
+    if (!dctx->preserveStreams && !dctx->isStageWorker) {
         for (ZL_IDType n = 0; n < nbInStreams; n++) {
             ZL_IDType const snb       = streamID + n;
             ZL_Data** const streamPtr = &VECTOR_AT(dctx->dataInfos, snb).data;
@@ -1255,10 +1368,387 @@ static ZL_Report processStream(
     return ZL_returnValue(nbInStreams);
 }
 
+// -------------------------------------
+// Parallel decoding of a Chunk's stages
+// -------------------------------------
+
+/* @return the nb of workers decoding stages of a Chunk in parallel,
+ * 1 meaning serial mode. */
+static size_t DCTX_getNbStageWorkers(const ZL_DCtx* dctx)
+{
+    ZL_ASSERT_NN(dctx);
+    if (dctx->workerPool.runTasks == NULL)
+        return 1;
+    // StreamDump2 inspects, and re-runs, individual stages
+    if (dctx->preserveStreams)
+        return 1;
+    int const nbWorkers = DCtx_getAppliedGParam(dctx, ZL_DParam_nbWorkers);
+    return (nbWorkers > 1) ? (size_t)nbWorkers : 1;
+}
+
+/* Groups the decoder stages of current Chunk into waves,
+ * based on the stream layout described by the frame header:
+ * a stage consumes the streams regenerated by earlier stages,
+ * and can start once all of them are produced.
+ * Stages remain decoded serially when no wave contains multiple stages,
+ * or when the layout is invalid, in which case serial decoding reports it.
+ * @pre the chunk header is already decoded */
+static ZL_Report DCTX_scheduleStages(ZL_DCtx* dctx)
+{
+    DCTX_StageSchedule* const sched = &dctx->schedule;
+    ZL_zeroes(sched, sizeof(*sched));
+    size_t const nbStages = dctx->dfh.nbDTransforms;
+    if (nbStages < 2 || DCTX_getNbStageWorkers(dctx) <= 1)
+        return ZL_returnSuccess();
+    size_t const nbStreams = dctx->dfh.nbStoredStreams + dctx->dfh.nbRegens;
+    Arena* const arena     = dctx->workspaceArena;
+
+    sched->startStreams = ALLOC_Arena_malloc(arena, nbStages * sizeof(size_t));
+    sched->transforms   = ALLOC_Arena_malloc(arena, nbStages * sizeof(DTrPtr));
+    sched->waves = ALLOC_Arena_malloc(arena, nbStages * sizeof(uint32_t));
+    // First wave in which each stream is available
+    uint32_t* const streamWaves =
+            ALLOC_Arena_calloc(arena, nbStreams * sizeof(uint32_t));
+    ZL_RET_R_IF_NULL(allocation, sched->startStreams);
+    ZL_RET_R_IF_NULL(allocation, sched->transforms);
+    ZL_RET_R_IF_NULL(allocation, sched->waves);
+    ZL_RET_R_IF_NULL(allocation, streamWaves);
+
+    size_t nbWaves = 0;
+    for (size_t stage = 0, startStream = 0; stage < nbStages; stage++) {
+        DFH_NodeInfo const* node = &VECTOR_AT(dctx->dfh.nodes, stage);
+        ZL_TRY_LET_T(
+                DTrPtr,
+                dt,
+                DTM_getTransform(
+                        &dctx->dtm, node->trpid, dctx->dfh.formatVersion));
+        size_t const nbInputs = dt->miGraphDesc.nbSOs + node->nbVOs;
+        if (nbInputs > nbStreams - startStream)
+            return ZL_returnSuccess();
+        size_t const inputEnd = startStream + nbInputs;
+        uint32_t wave         = 0;
+        for (size_t n = startStream; n < inputEnd; n++) {
+            wave = ZL_MAX(wave, streamWaves[n]);
+        }
+        for (size_t n = 0; n < node->nbRegens; n++) {
+            if (node->regenDistances[n] >= nbStreams - inputEnd)
+                return ZL_returnSuccess();
+            streamWaves[inputEnd + node->regenDistances[n]] = wave + 1;
+        }
+        sched->startStreams[stage] = startStream;
+        sched->transforms[stage]   = dt;
+        sched->waves[stage]        = wave;
+        nbWaves                    = ZL_MAX(nbWaves, (size_t)wave + 1);
+        startStream                = inputEnd;
+    }
+
+    // Parallelism is only possible if some wave has multiple stages
+    size_t* const waveSizes =
+            ALLOC_Arena_calloc(arena, nbWaves * sizeof(size_t));
+    ZL_RET_R_IF_NULL(allocation, waveSizes);
+    size_t maxWaveSize = 0;
+    for (size_t stage = 0; stage < nbStages; stage++) {
+        size_t const waveSize = ++waveSizes[sched->waves[stage]];
+        maxWaveSize           = ZL_MAX(maxWaveSize, waveSize);
+    }
+    if (maxWaveSize < 2)
+        return ZL_returnSuccess();
+
+    sched->waveStages  = ALLOC_Arena_malloc(arena, nbStages * sizeof(size_t));
+    sched->waveWorkers = ALLOC_Arena_malloc(arena, nbStages * sizeof(size_t));
+    sched->groups      = ALLOC_Arena_malloc(arena, nbStages * sizeof(size_t));
+    ZL_RET_R_IF_NULL(allocation, sched->waveStages);
+    ZL_RET_R_IF_NULL(allocation, sched->waveWorkers);
+    ZL_RET_R_IF_NULL(allocation, sched->groups);
+    ZL_DLOG(FRAME,
+            "decoding %zu stages in %zu waves (largest: %zu stages)",
+            nbStages,
+            nbWaves,
+            maxWaveSize);
+    sched->nbWaves = nbWaves;
+    return ZL_returnSuccess();
+}
+
+static size_t DCTX_stageNbInputs(const ZL_DCtx* dctx, size_t stage)
+{
+    return dctx->schedule.transforms[stage]->miGraphDesc.nbSOs
+            + VECTOR_AT(dctx->dfh.nodes, stage).nbVOs;
+}
+
+typedef struct {
+    const void* owner;
+    size_t waveIdx;
+} DCTX_BufferOwner;
+
+static int DCTX_BufferOwner_cmp(const void* a, const void* b)
+{
+    uintptr_t const ownerA = (uintptr_t)((const DCTX_BufferOwner*)a)->owner;
+    uintptr_t const ownerB = (uintptr_t)((const DCTX_BufferOwner*)b)->owner;
+    return (ownerA > ownerB) - (ownerA < ownerB);
+}
+
+static size_t DCTX_findGroup(size_t* groups, size_t idx)
+{
+    while (groups[idx] != idx) {
+        groups[idx] = groups[groups[idx]];
+        idx         = groups[idx];
+    }
+    return idx;
+}
+
+/* Stages whose inputs reference a same buffer must run on the same worker,
+ * since they update the same, non thread-safe, reference counter.
+ * Sets `groups[n]` to the first stage of the wave sharing buffers with
+ * stage n of the wave (possibly itself). */
+static ZL_Report DCTX_groupWaveStages(ZL_DCtx* dctx)
+{
+    DCTX_StageSchedule* const sched = &dctx->schedule;
+    size_t nbOwners                 = 0;
+    for (size_t n = 0; n < sched->nbWaveStages; n++) {
+        nbOwners += DCTX_stageNbInputs(dctx, sched->waveStages[n]);
+        sched->groups[n] = n;
+    }
+    DCTX_BufferOwner* const owners = ALLOC_Arena_malloc(
+            dctx->workspaceArena, (nbOwners + 1) * sizeof(DCTX_BufferOwner));
+    ZL_RET_R_IF_NULL(allocation, owners);
+    nbOwners = 0;
+    for (size_t n = 0; n < sched->nbWaveStages; n++) {
+        size_t const stage    = sched->waveStages[n];
+        size_t const start    = sched->startStreams[stage];
+        size_t const nbInputs = DCTX_stageNbInputs(dctx, stage);
+        for (size_t i = start; i < start + nbInputs; i++) {
+            const ZL_Data* const input = VECTOR_AT(dctx->dataInfos, i).data;
+            // Missing inputs are reported by processStream()
+            if (input == NULL || STREAM_bufferOwner(input) == NULL)
+                continue;
+            owners[nbOwners++] = (DCTX_BufferOwner){
+                .owner = STREAM_bufferOwner(input), .waveIdx = n
+            };
+        }
+    }
+    qsort(owners, nbOwners, sizeof(*owners), DCTX_BufferOwner_cmp);
+    for (size_t n = 1; n < nbOwners; n++) {
+        if (owners[n].owner != owners[n - 1].owner)
+            continue;
+        size_t const g1 = DCTX_findGroup(sched->groups, owners[n - 1].waveIdx);
+        size_t const g2 = DCTX_findGroup(sched->groups, owners[n].waveIdx);
+        sched->groups[ZL_MAX(g1, g2)] = ZL_MIN(g1, g2);
+    }
+    for (size_t n = 0; n < sched->nbWaveStages; n++) {
+        sched->groups[n] = DCTX_findGroup(sched->groups, n);
+    }
+    return ZL_returnSuccess();
+}
+
+static size_t DCTX_stageInputSize(const ZL_DCtx* dctx, size_t stage)
+{
+    size_t const start    = dctx->schedule.startStreams[stage];
+    size_t const nbInputs = DCTX_stageNbInputs(dctx, stage);
+    size_t total          = 0;
+    for (size_t i = start; i < start + nbInputs; i++) {
+        const ZL_Data* const input = VECTOR_AT(dctx->dataInfos, i).data;
+        if (input != NULL)
+            total += STREAM_byteSize(input);
+    }
+    return total;
+}
+
+/* Distributes groups of stages of the current wave across @p nbWorkers,
+ * each group to the least loaded worker, measured in input bytes.
+ * @return the nb of workers employed */
+static size_t DCTX_assignWaveStages(ZL_DCtx* dctx, size_t nbWorkers)
+{
+    DCTX_StageSchedule* const sched = &dctx->schedule;
+    size_t* const groupLoads        = sched->waveWorkers; // reused as temp
+    size_t nbGroups                 = 0;
+    for (size_t n = 0; n < sched->nbWaveStages; n++) {
+        groupLoads[n] = 0;
+    }
+    for (size_t n = 0; n < sched->nbWaveStages; n++) {
+        groupLoads[sched->groups[n]] +=
+                DCTX_stageInputSize(dctx, sched->waveStages[n]);
+        nbGroups += (sched->groups[n] == n);
+    }
+    nbWorkers = ZL_MIN(nbWorkers, nbGroups);
+    for (size_t w = 0; w < nbWorkers; w++) {
+        dctx->stageWorkers[w].load = 0;
+    }
+    // groups[n] <= n, so a group is assigned before its other stages
+    for (size_t n = 0; n < sched->nbWaveStages; n++) {
+        if (sched->groups[n] != n) {
+            sched->waveWorkers[n] = sched->waveWorkers[sched->groups[n]];
+            continue;
+        }
+        size_t best = 0;
+        for (size_t w = 1; w < nbWorkers; w++) {
+            if (dctx->stageWorkers[w].load < dctx->stageWorkers[best].load)
+                best = w;
+        }
+        dctx->stageWorkers[best].load += groupLoads[n];
+        sched->waveWorkers[n] = best;
+    }
+    return nbWorkers;
+}
+
+static ZL_Report DCTX_reserveStageWorkers(ZL_DCtx* dctx, size_t nbWorkers)
+{
+    if (nbWorkers <= dctx->nbStageWorkers)
+        return ZL_returnSuccess();
+    DCTX_StageWorker* const workers =
+            ZL_calloc(nbWorkers * sizeof(DCTX_StageWorker));
+    ZL_RET_R_IF_NULL(allocation, workers);
+    if (dctx->nbStageWorkers) {
+        ZL_memcpy(
+                workers,
+                dctx->stageWorkers,
+                dctx->nbStageWorkers * sizeof(DCTX_StageWorker));
+    }
+    ZL_free(dctx->stageWorkers);
+    dctx->stageWorkers   = workers;
+    dctx->nbStageWorkers = nbWorkers;
+    return ZL_returnSuccess();
+}
+
+/* Readies @p worker to decode stages of the current Chunk of @p dctx.
+ * Streams are shared: each one is only accessed by one stage at a time,
+ * and released by @p dctx between waves. */
+static ZL_Report DCTX_attachStageWorker(ZL_DCtx* dctx, DCTX_StageWorker* worker)
+{
+    if (worker->dctx == NULL) {
+        worker->dctx = ZL_DCtx_create();
+        ZL_RET_R_IF_NULL(allocation, worker->dctx);
+        worker->dctx->isStageWorker = true;
+    }
+    ZL_DCtx* const wdctx = worker->dctx;
+    ZL_OC_startOperation(&wdctx->opCtx, ZL_Operation_decompress);
+    TRACE_inherit(&wdctx->opCtx, &dctx->opCtx);
+    ZL_RET_R_IF_ERR(DTM_importCustomTransforms(&wdctx->dtm, &dctx->dtm));
+    GDParams_copy(&wdctx->appliedGDParams, &dctx->appliedGDParams);
+    wdctx->dfh.formatVersion = dctx->dfh.formatVersion;
+    wdctx->thstream          = dctx->thstream;
+    wdctx->outputs           = dctx->outputs;
+    wdctx->nbOutputs         = dctx->nbOutputs;
+    // Shallow copy of the stream table, which is sized for the whole Chunk,
+    // and thus not reallocated during decoding.
+    ZL_memcpy(&wdctx->dataInfos, &dctx->dataInfos, sizeof(dctx->dataInfos));
+    return ZL_returnSuccess();
+}
+
+static void DCTX_detachStageWorker(DCTX_StageWorker* worker)
+{
+    ZL_DCtx* const wdctx = worker->dctx;
+    if (wdctx == NULL)
+        return;
+    // The parent DCtx owns the vector
+    VECTOR_INIT(
+            wdctx->dataInfos, ZL_runtimeStreamLimit(ZL_MAX_FORMAT_VERSION));
+    wdctx->outputs = NULL;
+}
+
+/* Decodes the stages of the current wave assigned to worker @p taskID. */
+static void DCTX_stageWorkerTask(void* taskCtx, size_t taskID)
+{
+    const ZL_DCtx* const dctx             = (const ZL_DCtx*)taskCtx;
+    const DCTX_StageSchedule* const sched = &dctx->schedule;
+    DCTX_StageWorker* const worker        = &dctx->stageWorkers[taskID];
+    worker->result                        = ZL_returnSuccess();
+    for (size_t n = 0; n < sched->nbWaveStages; n++) {
+        if (sched->waveWorkers[n] != taskID)
+            continue;
+        size_t const stage = sched->waveStages[n];
+        ZL_Report const report = processStream(
+                worker->dctx,
+                (ZL_IDType)sched->startStreams[stage],
+                sched->transforms[stage],
+                &VECTOR_AT(dctx->dfh.nodes, stage));
+        if (ZL_isError(report)) {
+            worker->failedStage = stage;
+            worker->result      = report;
+            return;
+        }
+    }
+}
+
+static ZL_Report DCTX_runWaves(ZL_DCtx* dctx, size_t nbWorkers)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    DCTX_StageSchedule* const sched = &dctx->schedule;
+    size_t const nbStages           = dctx->dfh.nbDTransforms;
+    for (size_t wave = 0; wave < sched->nbWaves; wave++) {
+        sched->nbWaveStages = 0;
+        for (size_t stage = 0; stage < nbStages; stage++) {
+            if (sched->waves[stage] == wave)
+                sched->waveStages[sched->nbWaveStages++] = stage;
+        }
+        ZL_ERR_IF_ERR(DCTX_groupWaveStages(dctx));
+        size_t const nbTasks = DCTX_assignWaveStages(dctx, nbWorkers);
+        ZL_DLOG(BLOCK,
+                "decoding wave %zu: %zu stages on %zu workers",
+                wave,
+                sched->nbWaveStages,
+                nbTasks);
+        if (nbTasks == 1) {
+            DCTX_stageWorkerTask(dctx, 0);
+        } else {
+            dctx->workerPool.runTasks(
+                    dctx->workerPool.opaque,
+                    DCTX_stageWorkerTask,
+                    dctx,
+                    nbTasks);
+        }
+        for (size_t w = 0; w < nbTasks; w++) {
+            DCTX_StageWorker* const worker = &dctx->stageWorkers[w];
+            ZL_ERR_IF_ERR(
+                    worker->result,
+                    "Decoding stage %zu failed",
+                    worker->failedStage);
+        }
+
+        // Release the inputs of the wave
+        for (size_t n = 0; n < sched->nbWaveStages; n++) {
+            size_t const stage    = sched->waveStages[n];
+            size_t const start    = sched->startStreams[stage];
+            size_t const nbInputs = DCTX_stageNbInputs(dctx, stage);
+            for (size_t i = start; i < start + nbInputs; i++) {
+                ZL_Data** const streamPtr = &VECTOR_AT(dctx->dataInfos, i).data;
+                STREAM_free(*streamPtr);
+                *streamPtr = NULL;
+            }
+        }
+    }
+    return ZL_returnSuccess();
+}
+
+/* Decodes the stages of current Chunk, wave by wave.
+ * Stages of a wave are distributed across workers, each with its own
+ * decoder states and workspace. */
+static ZL_Report DCTX_runDecodersMT(ZL_DCtx* dctx)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    ZL_ASSERT_GT(dctx->schedule.nbWaves, 0);
+    ZL_ASSERT(!dctx->preserveStreams);
+    size_t const nbWorkers = DCTX_getNbStageWorkers(dctx);
+    ZL_ERR_IF_ERR(DCTX_reserveStageWorkers(dctx, nbWorkers));
+    ZL_Report report = ZL_returnSuccess();
+    for (size_t w = 0; w < nbWorkers && !ZL_isError(report); w++) {
+        report = DCTX_attachStageWorker(dctx, &dctx->stageWorkers[w]);
+    }
+    if (!ZL_isError(report)) {
+        report = DCTX_runWaves(dctx, nbWorkers);
+    }
+    for (size_t w = 0; w < nbWorkers; w++) {
+        DCTX_detachStageWorker(&dctx->stageWorkers[w]);
+    }
+    return report;
+}
+
 static ZL_Report runDecoders(ZL_DCtx* dctx)
 {
     ZL_DLOG(FRAME, "runDecoders (%zu stages)", dctx->dfh.nbDTransforms);
     ZL_ASSERT_NN(dctx);
+    if (dctx->schedule.nbWaves) {
+        return DCTX_runDecodersMT(dctx);
+    }
     for (size_t stage = 0, startingStream = 0; stage < dctx->dfh.nbDTransforms;
          stage++) {
         ZL_DLOG(BLOCK, "decoding stage %zu", stage);
@@ -1417,6 +1907,13 @@ static void cleanChunkBuffers(ZL_DCtx* dctx)
     DCTX_freeStreams(dctx);
     ALLOC_Arena_freeAll(dctx->streamArena);
     ALLOC_Arena_freeAll(dctx->workspaceArena);
+    ZL_zeroes(&dctx->schedule, sizeof(dctx->schedule));
+    // Stage workers host streams of the Chunk
+    for (size_t n = 0; n < dctx->nbStageWorkers; n++) {
+        if (dctx->stageWorkers[n].dctx != NULL) {
+            cleanChunkBuffers(dctx->stageWorkers[n].dctx);
+        }
+    }
 }
 
 static void cleanAllBuffers(ZL_DCtx* dctx)
@@ -1429,27 +1926,26 @@ static void cleanAllBuffers(ZL_DCtx* dctx)
 // Main decompression functions
 // -------------------------------------
 /**
+ * Decodes the chunk starting at position @p alreadyConsumed,
+ * leaving its regenerated content within @p dctx's streams.
+ * The content checksum, if present, is read into @p expectedContentHash,
+ * to be verified by DCTX_commitChunk().
  * @return size of chunk, read from frame
  */
-static ZL_Report ZL_DCtx_decompressChunk(
+static ZL_Report DCTX_decodeChunk(
         ZL_DCtx* dctx,
-        size_t nbOutputs,
         const void* framePtr,
         size_t frameSize,
-        size_t alreadyConsumed)
+        size_t alreadyConsumed,
+        uint32_t* expectedContentHash)
 {
     size_t consumedSize = alreadyConsumed;
     ZL_DLOG(BLOCK,
-            "ZL_DCtx_decompressChunk (frameSize=%zu, consumedSize=%zu)",
+            "DCTX_decodeChunk (frameSize=%zu, consumedSize=%zu)",
             frameSize,
             consumedSize);
     ZL_ASSERT_NN(dctx);
-    ZL_Data** outputs = dctx->outputs;
-
-    // We clean at the beginning instead of the end
-    // in case `DCTX_preserveStreams` is set,
-    // requiring to preserve some results for StreamDump2
-    cleanChunkBuffers(dctx);
+    ZL_ASSERT_NN(expectedContentHash);
 
     ZL_ASSERT_LE(consumedSize, frameSize);
     ZL_TRY_LET_R(
@@ -1459,6 +1955,7 @@ static ZL_Report ZL_DCtx_decompressChunk(
                     (const char*)framePtr + consumedSize,
                     frameSize - consumedSize));
     consumedSize += chunkHeaderSize;
+    ZL_RET_R_IF_ERR(DCTX_scheduleStages(dctx));
 
     VECTOR(uint8_t)
     isRegeneratedStream =
@@ -1472,12 +1969,13 @@ static ZL_Report ZL_DCtx_decompressChunk(
     // If present, verify the compressed checksum before running decoders.
     // Assuming we aren't handling malicious inputs, this ensures that we
     // are running on valid data before we run the decoders.
-    uint32_t expectedContentHash = 0;
+    *expectedContentHash = 0;
 
     if (FrameInfo_hasContentChecksum(dctx->dfh.frameinfo)) {
         ZL_RET_R_IF_LT(srcSize_tooSmall, frameSize, consumedSize + 4);
-        expectedContentHash = ZL_readCE32((const char*)framePtr + consumedSize);
-        ZL_DLOG(SEQ, "stored contentHash: %08X", expectedContentHash);
+        *expectedContentHash =
+                ZL_readCE32((const char*)framePtr + consumedSize);
+        ZL_DLOG(SEQ, "stored contentHash: %08X", *expectedContentHash);
         consumedSize += 4;
     }
 
@@ -1519,13 +2017,21 @@ static ZL_Report ZL_DCtx_decompressChunk(
     // start the decompression process.
     ZL_RET_R_IF_ERR(runDecoders(dctx));
 
-    // write result into user's buffer
-    {
-        ZL_TRY_LET_R(nbOuts, addChunksIntoFinalStreams(dctx));
-        ZL_RET_R_IF_NE(corruption, nbOuts, nbOutputs);
-    }
+    ZL_ASSERT_GE(consumedSize, alreadyConsumed);
+    return ZL_returnValue(consumedSize - alreadyConsumed);
+}
 
-    // verify block content checksum
+/**
+ * Verifies the content checksum of the last decoded chunk, if present,
+ * @p outputs being the content regenerated by this chunk.
+ */
+static ZL_Report DCTX_checkContentChecksum(
+        ZL_DCtx* dctx,
+        const ZL_Data* outputs[],
+        size_t nbOutputs,
+        uint32_t expectedContentHash)
+{
+    ZL_ASSERT_NN(dctx);
     if (FrameInfo_hasContentChecksum(dctx->dfh.frameinfo)
         && DCtx_getAppliedGParam(dctx, ZL_DParam_checkContentChecksum)
                 == ZL_TernaryParam_enable) {
@@ -1542,9 +2048,7 @@ static ZL_Report ZL_DCtx_decompressChunk(
         ZL_TRY_LET_R(
                 actualHashT,
                 STREAM_hashLastCommit_xxh3low32(
-                        (const ZL_Data**)(void*)outputs,
-                        nbOutputs,
-                        dctx->dfh.formatVersion));
+                        outputs, nbOutputs, dctx->dfh.formatVersion));
         uint32_t const actualContentHash = (uint32_t)actualHashT;
         ZL_DLOG(SEQ,
                 "actualContentHash:%08X vs %08X:expectedContentHash",
@@ -1563,11 +2067,291 @@ static ZL_Report ZL_DCtx_decompressChunk(
 #else
         (void)expectedContentHash;
         (void)outputs;
+        (void)nbOutputs;
 #endif
     }
 
-    ZL_ASSERT_GE(consumedSize, alreadyConsumed);
-    return ZL_returnValue(consumedSize - alreadyConsumed);
+    return ZL_returnSuccess();
+}
+
+/**
+ * Writes the content regenerated by the last decoded chunk
+ * into `dctx->outputs`, then verifies its content checksum, if present.
+ */
+static ZL_Report DCTX_commitChunk(
+        ZL_DCtx* dctx,
+        size_t nbOutputs,
+        uint32_t expectedContentHash)
+{
+    ZL_ASSERT_NN(dctx);
+
+    // write result into user's buffer
+    {
+        ZL_TRY_LET_R(nbOuts, addChunksIntoFinalStreams(dctx));
+        ZL_RET_R_IF_NE(corruption, nbOuts, nbOutputs);
+    }
+
+    return DCTX_checkContentChecksum(
+            dctx,
+            (const ZL_Data**)(void*)dctx->outputs,
+            nbOutputs,
+            expectedContentHash);
+}
+
+/**
+ * @return size of chunk, read from frame
+ */
+static ZL_Report ZL_DCtx_decompressChunk(
+        ZL_DCtx* dctx,
+        size_t nbOutputs,
+        const void* framePtr,
+        size_t frameSize,
+        size_t alreadyConsumed)
+{
+    ZL_DLOG(BLOCK,
+            "ZL_DCtx_decompressChunk (frameSize=%zu, consumedSize=%zu)",
+            frameSize,
+            alreadyConsumed);
+    ZL_ASSERT_NN(dctx);
+
+    // We clean at the beginning instead of the end
+    // in case `DCTX_preserveStreams` is set,
+    // requiring to preserve some results for StreamDump2
+    cleanChunkBuffers(dctx);
+
+    uint32_t expectedContentHash = 0;
+    ZL_TRY_LET_R(
+            chunkSize,
+            DCTX_decodeChunk(
+                    dctx,
+                    framePtr,
+                    frameSize,
+                    alreadyConsumed,
+                    &expectedContentHash));
+    ZL_RET_R_IF_ERR(DCTX_commitChunk(dctx, nbOutputs, expectedContentHash));
+    return ZL_returnValue(chunkSize);
+}
+
+// -------------------------------------
+// Multi-threaded decompression
+// -------------------------------------
+
+/* @return the nb of Chunks to decode in parallel, 1 meaning serial mode.
+ * @pre the frame header is already decoded */
+static size_t DCTX_getNbChunkWorkers(const ZL_DCtx* dctx)
+{
+    ZL_ASSERT_NN(dctx);
+    if (dctx->workerPool.runTasks == NULL)
+        return 1;
+    // Older frames contain a single chunk
+    if (dctx->dfh.formatVersion < ZL_CHUNK_VERSION_MIN)
+        return 1;
+    // StreamDump2 inspects the streams of the last chunk
+    if (dctx->preserveStreams)
+        return 1;
+    int const nbWorkers = DCtx_getAppliedGParam(dctx, ZL_DParam_nbWorkers);
+    return (nbWorkers > 1) ? (size_t)nbWorkers : 1;
+}
+
+/* @return whether the Chunk starting at @p pos is the last one of the frame.
+ * Errors are left to be reported when decoding. */
+static bool DCTX_isLastChunk(
+        ZL_DCtx* dctx,
+        const void* framePtr,
+        size_t frameSize,
+        size_t pos)
+{
+    if (pos >= frameSize || ZL_read8((const char*)framePtr + pos) == 0)
+        return false;
+    ZL_Report const chunkSize = DFH_getChunkSize(
+            &dctx->dfh, (const char*)framePtr + pos, frameSize - pos);
+    if (ZL_isError(chunkSize))
+        return false;
+    size_t const end = pos + ZL_validResult(chunkSize);
+    return end < frameSize && ZL_read8((const char*)framePtr + end) == 0;
+}
+
+static ZL_Report DCTX_reserveChunkWorkers(ZL_DCtx* dctx, size_t nbWorkers)
+{
+    if (nbWorkers <= dctx->nbChunkWorkers)
+        return ZL_returnSuccess();
+    DCTX_ChunkWorker* const workers =
+            ZL_calloc(nbWorkers * sizeof(DCTX_ChunkWorker));
+    ZL_RET_R_IF_NULL(allocation, workers);
+    if (dctx->nbChunkWorkers) {
+        ZL_memcpy(
+                workers,
+                dctx->chunkWorkers,
+                dctx->nbChunkWorkers * sizeof(DCTX_ChunkWorker));
+    }
+    ZL_free(dctx->chunkWorkers);
+    dctx->chunkWorkers   = workers;
+    dctx->nbChunkWorkers = nbWorkers;
+    return ZL_returnSuccess();
+}
+
+/* Readies @p worker to decode chunks of the frame @p framePtr.
+ * Custom decoders and applied parameters are synchronized with @p dctx. */
+static ZL_Report DCTX_prepareChunkWorker(
+        ZL_DCtx* dctx,
+        DCTX_ChunkWorker* worker,
+        const void* framePtr,
+        size_t frameSize)
+{
+    if (worker->dctx == NULL) {
+        worker->dctx = ZL_DCtx_create();
+        ZL_RET_R_IF_NULL(allocation, worker->dctx);
+    }
+    ZL_DCtx* const wdctx = worker->dctx;
+    cleanAllBuffers(wdctx);
+    ZL_OC_startOperation(&wdctx->opCtx, ZL_Operation_decompress);
+    TRACE_inherit(&wdctx->opCtx, &dctx->opCtx);
+    ZL_RET_R_IF_ERR(DTM_importCustomTransforms(&wdctx->dtm, &dctx->dtm));
+    GDParams_copy(&wdctx->appliedGDParams, &dctx->appliedGDParams);
+    ZL_RET_R_IF_ERR(
+            decodeFrameHeader(wdctx, framePtr, frameSize, dctx->nbOutputs));
+
+    worker->outputShells = ALLOC_Arena_calloc(
+            wdctx->decompressArena, dctx->nbOutputs * sizeof(ZL_Data*));
+    ZL_RET_R_IF_NULL(allocation, worker->outputShells);
+    wdctx->outputs    = worker->outputShells;
+    worker->framePtr  = framePtr;
+    worker->frameSize = frameSize;
+    return ZL_returnSuccess();
+}
+
+/* Decodes one chunk into chunk-local output streams.
+ * Result is later committed into final outputs, in frame order. */
+static void DCTX_chunkWorkerTask(void* taskCtx, size_t taskID)
+{
+    DCTX_ChunkWorker* const worker = (DCTX_ChunkWorker*)taskCtx + taskID;
+    ZL_DCtx* const wdctx           = worker->dctx;
+    cleanChunkBuffers(wdctx);
+    // Final streams get their own buffers, sized by their decoder
+    for (size_t n = 0; n < wdctx->nbOutputs; n++) {
+        worker->outputShells[n] = STREAM_createInArena(
+                wdctx->streamArena, (ZL_DataID){ (ZL_IDType)n });
+        if (worker->outputShells[n] == NULL) {
+            worker->result = ZL_REPORT_ERROR(allocation);
+            return;
+        }
+    }
+    worker->result = DCTX_decodeChunk(
+            wdctx,
+            worker->framePtr,
+            worker->frameSize,
+            worker->chunkStart,
+            &worker->expectedContentHash);
+}
+
+/* Decodes all chunks of the frame, starting at position @p consumed,
+ * by batches of @p nbWorkers chunks decoded in parallel.
+ * Chunks are then written into `dctx->outputs`, in frame order.
+ * @return position after the end of frame marker */
+static ZL_Report DCTX_decompressChunksMT(
+        ZL_DCtx* dctx,
+        const void* framePtr,
+        size_t frameSize,
+        size_t consumed,
+        size_t nbWorkers)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    ZL_ASSERT_GT(nbWorkers, 1);
+    ZL_ERR_IF_ERR(DCTX_reserveChunkWorkers(dctx, nbWorkers));
+    size_t nbPreparedWorkers = 0;
+    int frameEnd             = 0;
+    size_t chunkNb           = 0;
+
+    while (!frameEnd) {
+        // Locate the next batch of chunks
+        size_t nbJobs = 0;
+        while (nbJobs < nbWorkers) {
+            ZL_ERR_IF_LT(frameSize, consumed + 1, srcSize_tooSmall);
+            if (ZL_read8((const char*)framePtr + consumed) == 0) {
+                ZL_DLOG(SEQ, "End of frame detected at pos %zu", consumed);
+                consumed += 1;
+                frameEnd = 1;
+                break;
+            }
+            DCTX_ChunkWorker* const worker = &dctx->chunkWorkers[nbJobs];
+            if (nbJobs == nbPreparedWorkers) {
+                ZL_ERR_IF_ERR(DCTX_prepareChunkWorker(
+                        dctx, worker, framePtr, frameSize));
+                nbPreparedWorkers++;
+            }
+            ZL_TRY_LET(
+                    size_t,
+                    chunkSize,
+                    DFH_getChunkSize(
+                            &dctx->dfh,
+                            (const char*)framePtr + consumed,
+                            frameSize - consumed));
+            worker->chunkStart = consumed;
+            worker->chunkSize  = chunkSize;
+            consumed += chunkSize;
+            nbJobs++;
+        }
+        if (nbJobs == 0)
+            break;
+
+        ZL_DLOG(BLOCK, "decoding %zu chunks in parallel", nbJobs);
+        dctx->workerPool.runTasks(
+                dctx->workerPool.opaque,
+                DCTX_chunkWorkerTask,
+                dctx->chunkWorkers,
+                nbJobs);
+
+        // Commit chunks into final outputs, in frame order
+        for (size_t n = 0; n < nbJobs; n++, chunkNb++) {
+            DCTX_ChunkWorker* const worker = &dctx->chunkWorkers[n];
+            ZL_DCtx* const wdctx           = worker->dctx;
+            ZL_ERR_IF_ERR(worker->result, "Chunk %zu failed", chunkNb);
+            ZL_ERR_IF_NE(
+                    ZL_validResult(worker->result),
+                    worker->chunkSize,
+                    corruption);
+            wdctx->outputs = dctx->outputs;
+            ZL_Report const commit = DCTX_commitChunk(
+                    wdctx, dctx->nbOutputs, worker->expectedContentHash);
+            wdctx->outputs = worker->outputShells;
+            ZL_ERR_IF_ERR(commit, "Chunk %zu failed", chunkNb);
+            // Release chunk-local outputs early
+            cleanChunkBuffers(wdctx);
+        }
+    }
+    return ZL_returnValue(consumed);
+}
+
+/* Allocates the buffer(s) of @p output, which is just a shell,
+ * to host @p dSize bytes. @p numStrings is only used for String type. */
+static ZL_Report DCTX_reserveOutput(
+        ZL_Data* output,
+        ZL_Type type,
+        size_t dSize,
+        size_t numStrings)
+{
+    switch (type) {
+        default:
+            ZL_ASSERT_FAIL("invalid type");
+            ZL_FALLTHROUGH;
+        case ZL_Type_serial:
+            ZL_DLOG(SEQ,
+                    "pre-allocating output, type Serial, capacity %zu bytes",
+                    dSize);
+            return STREAM_reserve(output, ZL_Type_serial, 1, dSize);
+
+        case ZL_Type_struct:
+        case ZL_Type_numeric:
+            /* only reserve the underlying buffer - typing will be added
+             * later, once eltWidth is discovered */
+            ZL_DLOG(SEQ,
+                    "pre-allocating output, no type set, capacity %zu bytes",
+                    dSize);
+            return STREAM_reserveRawBuffer(output, dSize);
+
+        case ZL_Type_string:
+            return STREAM_reserveStrings(output, numStrings, dSize);
+    }
 }
 
 ZL_Report ZL_DCtx_decompressMultiTBuffer(
@@ -1604,6 +2388,8 @@ ZL_Report ZL_DCtx_decompressMultiTBuffer(
             consumed,
             decodeFrameHeader(dctx, framePtr, frameSize, nbOutputs));
     ZL_DLOG(SEQ, "decoded frame header, of size %zu bytes", consumed);
+    // Frames produced by streaming compression store sizes at chunk level
+    ZL_ERR_IF_ERR(DFH_resolveContentSizes(&dctx->dfh, framePtr, frameSize));
 
     // check buffers in outputs objects
     for (size_t n = 0; n < nbOutputs; n++) {
@@ -1636,74 +2422,75 @@ ZL_Report ZL_DCtx_decompressMultiTBuffer(
                 size_t,
                 dSize,
                 ZL_FrameInfo_getDecompressedSize(dctx->dfh.frameinfo, (int)n));
-
-        switch (type_st) {
-            default:
-                ZL_ASSERT_FAIL("invalid type");
-                ZL_FALLTHROUGH;
-            case ZL_Type_serial: {
-                ZL_DLOG(SEQ,
-                        "pre-allocating output %zu, type Serial, capacity %zu bytes",
-                        n,
-                        dSize);
-                ZL_ERR_IF_ERR(
-                        STREAM_reserve(outputs[n], ZL_Type_serial, 1, dSize));
-            } break;
-
-            case ZL_Type_struct:
-            case ZL_Type_numeric: {
-                /* only reserve the underlying buffer - typing will be added
-                 * later, once eltWidth is discovered */
-                ZL_DLOG(SEQ,
-                        "pre-allocating output %zu, no type set, capacity %zu bytes",
-                        n,
-                        dSize);
-                ZL_ERR_IF_ERR(STREAM_reserveRawBuffer(outputs[n], dSize));
-            } break;
-
-            case ZL_Type_string: {
-                if (dctx->dfh.formatVersion < ZL_CHUNK_VERSION_MIN) {
-                    // allocating output of type string is not possible:
-                    // `numStrings` is not available.
-                    break;
-                }
-                ZL_TRY_LET(
-                        size_t,
-                        numStrings,
-                        ZL_FrameInfo_getNumElts(dctx->dfh.frameinfo, (int)n));
-                ZL_ERR_IF_ERR(
-                        STREAM_reserveStrings(outputs[n], numStrings, dSize));
+        size_t numStrings = 0;
+        if (type_st == ZL_Type_string) {
+            if (dctx->dfh.formatVersion < ZL_CHUNK_VERSION_MIN) {
+                // allocating output of type string is not possible:
+                // `numStrings` is not available.
+                continue;
             }
+            ZL_TRY_SET(
+                    size_t,
+                    numStrings,
+                    ZL_FrameInfo_getNumElts(dctx->dfh.frameinfo, (int)n));
         }
+        ZL_ERR_IF_ERR(DCTX_reserveOutput(
+                outputs[n], (ZL_Type)type_st, dSize, numStrings));
     }
 
     // main decompression loop
-    while (1) {
-        // Check end of frame marker
-        if (dctx->dfh.formatVersion >= ZL_CHUNK_VERSION_MIN) {
-            ZL_ERR_IF_LT(frameSize, consumed + 1, srcSize_tooSmall);
-            uint8_t marker = ZL_read8((const char*)framePtr + consumed);
-            ZL_DLOG(SEQ, "marker %u at pos %zu", marker, consumed);
-            if (marker == 0) {
-                ZL_DLOG(SEQ,
-                        "End of frame detected at pos %zu",
-                        marker,
-                        consumed);
-                consumed += 1;
-                break;
+    size_t nbWorkers = DCTX_getNbChunkWorkers(dctx);
+    if (nbWorkers > 1
+        && DCTX_isLastChunk(dctx, framePtr, frameSize, consumed)) {
+        // A single Chunk is decoded in place, its stages in parallel
+        nbWorkers = 1;
+    }
+    if (nbWorkers > 1) {
+        ZL_TRY_SET(
+                size_t,
+                consumed,
+                DCTX_decompressChunksMT(
+                        dctx, framePtr, frameSize, consumed, nbWorkers));
+    } else {
+        while (1) {
+            // Check end of frame marker
+            if (dctx->dfh.formatVersion >= ZL_CHUNK_VERSION_MIN) {
+                ZL_ERR_IF_LT(frameSize, consumed + 1, srcSize_tooSmall);
+                uint8_t marker = ZL_read8((const char*)framePtr + consumed);
+                ZL_DLOG(SEQ, "marker %u at pos %zu", marker, consumed);
+                if (marker == 0) {
+                    ZL_DLOG(SEQ,
+                            "End of frame detected at pos %zu",
+                            marker,
+                            consumed);
+                    consumed += 1;
+                    break;
+                }
             }
+
+            ZL_TRY_LET(
+                    size_t,
+                    chunkSize,
+                    ZL_DCtx_decompressChunk(
+                            dctx, nbOutputs, framePtr, frameSize, consumed));
+            ZL_DLOG(SEQ, "chunk size: %zu", chunkSize);
+            consumed += chunkSize;
+
+            if (dctx->dfh.formatVersion < ZL_CHUNK_VERSION_MIN)
+                break;
         }
+    }
 
+    // The seek table is only employed for random access
+    if (FrameInfo_hasSeekTable(dctx->dfh.frameinfo)) {
         ZL_TRY_LET(
                 size_t,
-                chunkSize,
-                ZL_DCtx_decompressChunk(
-                        dctx, nbOutputs, framePtr, frameSize, consumed));
-        ZL_DLOG(SEQ, "chunk size: %zu", chunkSize);
-        consumed += chunkSize;
-
-        if (dctx->dfh.formatVersion < ZL_CHUNK_VERSION_MIN)
-            break;
+                stSize,
+                DFH_getSeekTableSize(
+                        dctx->dfh.frameinfo,
+                        (const char*)framePtr + consumed,
+                        frameSize - consumed));
+        consumed += stSize;
     }
 
 #if ZL_ENABLE_ASSERT
@@ -1764,6 +2551,409 @@ ZL_Report ZL_DCtx_decompressMultiTBuffer(
     return ZL_returnValue(nbOutputs);
 }
 
+// -------------------------------------
+// Streaming decompression
+// -------------------------------------
+
+DSTREAM_State* DCTX_getStreamState(const ZL_DCtx* dctx)
+{
+    ZL_ASSERT_NN(dctx);
+    return dctx->dstream;
+}
+
+void DCTX_setStreamState(ZL_DCtx* dctx, DSTREAM_State* dstream)
+{
+    ZL_ASSERT_NN(dctx);
+    ZL_ASSERT_NULL(dctx->dstream);
+    dctx->dstream = dstream;
+}
+
+ZL_Report DCTX_startStreamFrame(
+        ZL_DCtx* dctx,
+        const void* src,
+        size_t srcSize,
+        size_t nbOutputs)
+{
+    ZL_DLOG(FRAME, "DCTX_startStreamFrame (srcSize = %zu)", srcSize);
+    ZL_ASSERT_NN(dctx);
+    ZL_OC_startOperation(&dctx->opCtx, ZL_Operation_decompress);
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+
+    ZL_ERR_IF_ERR(DCtx_setAppliedParameters(dctx));
+    // Clean up state - may be dirty if previous decompression failed
+    cleanAllBuffers(dctx);
+
+    ZL_TRY_LET(size_t, hSize, DFH_decodeFrameHeader(&dctx->dfh, src, srcSize));
+    ZL_ERR_IF_LT(
+            dctx->dfh.formatVersion,
+            ZL_CHUNK_VERSION_MIN,
+            formatVersion_unsupported,
+            "Streaming decompression requires format version >= %u",
+            ZL_CHUNK_VERSION_MIN);
+    ZL_TRY_LET(
+            size_t, nbOuts, ZL_FrameInfo_getNumOutputs(dctx->dfh.frameinfo));
+    ZL_ERR_IF_NE(
+            nbOuts,
+            nbOutputs,
+            userBuffers_invalidNum,
+            "Frame has %zu outputs, but %zu were provided",
+            nbOuts,
+            nbOutputs);
+
+    // Each chunk regenerates its content into its own output shells
+    dctx->outputs = ALLOC_Arena_calloc(
+            dctx->decompressArena, nbOutputs * sizeof(ZL_Data*));
+    ZL_ERR_IF_NULL(dctx->outputs, allocation);
+    dctx->nbOutputs = nbOutputs;
+    return ZL_returnValue(hSize);
+}
+
+ZL_Report DCTX_decodeStreamChunk(
+        ZL_DCtx* dctx,
+        const ZL_Data* chunkOutputs[],
+        const void* src,
+        size_t srcSize)
+{
+    ZL_DLOG(BLOCK, "DCTX_decodeStreamChunk (srcSize = %zu)", srcSize);
+    ZL_ASSERT_NN(dctx);
+    ZL_ASSERT_NN(chunkOutputs);
+    ZL_ASSERT_GE(dctx->nbOutputs, 1);
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    size_t const nbOutputs = dctx->nbOutputs;
+
+    cleanChunkBuffers(dctx);
+    // Final streams get their own buffers, sized by their decoders
+    for (size_t n = 0; n < nbOutputs; n++) {
+        dctx->outputs[n] = STREAM_createInArena(
+                dctx->streamArena, (ZL_DataID){ (ZL_IDType)n });
+        ZL_ERR_IF_NULL(dctx->outputs[n], allocation);
+    }
+
+    uint32_t expectedContentHash = 0;
+    ZL_TRY_LET(
+            size_t,
+            chunkSize,
+            DCTX_decodeChunk(dctx, src, srcSize, 0, &expectedContentHash));
+    ZL_ERR_IF_NE(chunkSize, srcSize, corruption, "Chunk size is incorrect");
+
+    // Outputs are listed in reverse order at the end of dataInfos
+    size_t const nbStreams = VECTOR_SIZE(dctx->dataInfos);
+    ZL_ERR_IF_GT(
+            nbOutputs,
+            nbStreams,
+            outputs_tooNumerous,
+            "Frame header expected more streams than actually produced");
+    for (size_t n = 0; n < nbOutputs; n++) {
+        size_t const lsid = nbStreams - n - 1;
+        chunkOutputs[n]   = VECTOR_AT(dctx->dataInfos, lsid).data;
+        ZL_ERR_IF_NULL(
+                chunkOutputs[n], graph_invalid, "Final stream not produced!");
+    }
+    return DCTX_checkContentChecksum(
+            dctx, chunkOutputs, nbOutputs, expectedContentHash);
+}
+
+ZL_Report DCTX_endStreamFrame(ZL_DCtx* dctx)
+{
+    ZL_ASSERT_NN(dctx);
+    if (!dctx->preserveStreams) {
+        // reclaim tmp memory
+        cleanAllBuffers(dctx);
+    }
+    dctx->outputs = NULL;
+    if (!DCtx_getAppliedGParam(dctx, ZL_DParam_stickyParameters)) {
+        // If dctx parameters are not explicitly sticky, reset them
+        ZL_RET_R_IF_ERR(ZL_DCtx_resetParameters(dctx));
+    }
+    return ZL_returnSuccess();
+}
+
+// -------------------------------------
+// Random access
+// -------------------------------------
+
+/* Decodes the frame header and the seek table of frame @p framePtr into
+ * @p dctx and @p st, which then remain valid until the end of the operation,
+ * concluded by DCTX_endRandomAccess(). */
+static ZL_Report DCTX_startRandomAccess(
+        ZL_DCtx* dctx,
+        DFH_SeekTable* st,
+        const void* framePtr,
+        size_t frameSize,
+        size_t nbOutputs)
+{
+    ZL_ASSERT_NN(dctx);
+    ZL_RET_R_IF_ERR(DCtx_setAppliedParameters(dctx));
+    // Clean up state - may be dirty if previous decompression failed
+    cleanAllBuffers(dctx);
+    ZL_RET_R_IF_ERR(decodeFrameHeader(dctx, framePtr, frameSize, nbOutputs));
+    ZL_RET_R_IF_ERR(DFH_decodeSeekTable(
+            st,
+            dctx->decompressArena,
+            dctx->dfh.frameinfo,
+            framePtr,
+            frameSize));
+    ZL_DLOG(FRAME, "seek table lists %zu chunks", st->nbChunks);
+    return ZL_returnSuccess();
+}
+
+static ZL_Report DCTX_endRandomAccess(ZL_DCtx* dctx)
+{
+    if (!dctx->preserveStreams) {
+        // reclaim tmp memory
+        cleanAllBuffers(dctx);
+    }
+    dctx->outputs = NULL;
+    if (!DCtx_getAppliedGParam(dctx, ZL_DParam_stickyParameters)) {
+        // If dctx parameters are not explicitly sticky, reset them
+        ZL_RET_R_IF_ERR(ZL_DCtx_resetParameters(dctx));
+    }
+    return ZL_returnSuccess();
+}
+
+ZL_Report ZL_DCtx_decompressChunkAt(
+        ZL_DCtx* dctx,
+        ZL_TypedBuffer* tbuffers[],
+        size_t nbOutputs,
+        size_t chunkIndex,
+        const void* framePtr,
+        size_t frameSize)
+{
+    ZL_DLOG(FRAME,
+            "ZL_DCtx_decompressChunkAt: decompress chunk %zu into %zu typed buffers",
+            chunkIndex,
+            nbOutputs);
+    ZL_OC_startOperation(&dctx->opCtx, ZL_Operation_decompress);
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+
+    DFH_SeekTable st;
+    ZL_ERR_IF_ERR(
+            DCTX_startRandomAccess(dctx, &st, framePtr, frameSize, nbOutputs));
+    ZL_ERR_IF_GE(
+            chunkIndex,
+            st.nbChunks,
+            parameter_invalid,
+            "Chunk %zu requested, but frame only has %zu chunks",
+            chunkIndex,
+            st.nbChunks);
+
+    ZL_Data** const outputs = ZL_codemodOutputsAsDatas(tbuffers);
+    ZL_ASSERT_NN(outputs);
+    dctx->outputs = outputs;
+
+    // size outputs for this chunk only
+    size_t const first = chunkIndex * nbOutputs;
+    for (size_t n = 0; n < nbOutputs; n++) {
+        ZL_ASSERT_NN(outputs[n], "output %zu should not be NULL", n);
+        size_t const dSize = (size_t)(st.contentOffsets[first + nbOutputs + n]
+                                      - st.contentOffsets[first + n]);
+        if (STREAM_hasBuffer(outputs[n])) {
+            ZL_ERR_IF_LT(
+                    STREAM_byteCapacity(outputs[n]),
+                    dSize,
+                    dstCapacity_tooSmall,
+                    "Buffer id%zu has insufficient capacity",
+                    n);
+            continue;
+        }
+        ZL_TRY_LET(
+                size_t,
+                type_st,
+                ZL_FrameInfo_getOutputType(dctx->dfh.frameinfo, (int)n));
+        size_t const numElts = (size_t)(st.eltOffsets[first + nbOutputs + n]
+                                        - st.eltOffsets[first + n]);
+        ZL_ERR_IF_ERR(DCTX_reserveOutput(
+                outputs[n], (ZL_Type)type_st, dSize, numElts));
+    }
+
+    size_t const chunkStart = (size_t)st.chunkOffsets[chunkIndex];
+    ZL_TRY_LET(
+            size_t,
+            chunkSize,
+            ZL_DCtx_decompressChunk(
+                    dctx, nbOutputs, framePtr, frameSize, chunkStart));
+    ZL_ERR_IF_NE(
+            chunkSize,
+            st.chunkOffsets[chunkIndex + 1] - chunkStart,
+            corruption,
+            "Chunk size doesn't match the seek table");
+
+    // check decompressed sizes
+    for (size_t n = 0; n < nbOutputs; n++) {
+        ZL_ERR_IF_NE(
+                STREAM_byteSize(outputs[n]),
+                st.contentOffsets[first + nbOutputs + n]
+                        - st.contentOffsets[first + n],
+                corruption,
+                "Regenerated size for output %zu is incorrect",
+                n);
+    }
+
+    ZL_ERR_IF_ERR(DCTX_endRandomAccess(dctx));
+    return ZL_returnValue(nbOutputs);
+}
+
+/* @return index of the chunk containing element @p elt of output @p n
+ * @pre @p elt is smaller than the number of elements of output @p n */
+static size_t
+DCTX_findChunk(const DFH_SeekTable* st, size_t n, uint64_t elt)
+{
+    // Find the first chunk ending after @p elt
+    size_t lo = 0;
+    size_t hi = st->nbChunks - 1;
+    while (lo < hi) {
+        size_t const mid = lo + (hi - lo) / 2;
+        if (st->eltOffsets[(mid + 1) * st->nbOutputs + n] > elt) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+ZL_Report ZL_DCtx_decompressRange(
+        ZL_DCtx* dctx,
+        ZL_TypedBuffer* tbuffer,
+        int outputIndex,
+        size_t eltBegin,
+        size_t eltEnd,
+        const void* framePtr,
+        size_t frameSize)
+{
+    ZL_DLOG(FRAME,
+            "ZL_DCtx_decompressRange: decompress elements [%zu, %zu) of output %i",
+            eltBegin,
+            eltEnd,
+            outputIndex);
+    ZL_OC_startOperation(&dctx->opCtx, ZL_Operation_decompress);
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    ZL_ERR_IF_GT(eltBegin, eltEnd, parameter_invalid);
+
+    ZL_TRY_LET(size_t, nbOutputs, ZL_getNumOutputs(framePtr, frameSize));
+    ZL_ERR_IF(
+            outputIndex < 0 || (size_t)outputIndex >= nbOutputs,
+            outputID_invalid);
+    size_t const outN = (size_t)outputIndex;
+
+    DFH_SeekTable st;
+    ZL_ERR_IF_ERR(
+            DCTX_startRandomAccess(dctx, &st, framePtr, frameSize, nbOutputs));
+    ZL_ERR_IF_GT(
+            eltEnd,
+            st.eltOffsets[st.nbChunks * nbOutputs + outN],
+            parameter_invalid,
+            "Range ends beyond the last element of output %zu",
+            outN);
+
+    ZL_Data* const output = ZL_codemodOutputAsData(tbuffer);
+    ZL_ASSERT_NN(output);
+    size_t const numElts = eltEnd - eltBegin;
+    if (numElts == 0) {
+        ZL_ERR_IF_ERR(DCTX_endRandomAccess(dctx));
+        return ZL_returnValue(0);
+    }
+    size_t const firstChunk = DCTX_findChunk(&st, outN, eltBegin);
+    size_t const lastChunk  = DCTX_findChunk(&st, outN, eltEnd - 1);
+
+    // Content size of all chunks overlapping the range
+    size_t const bytesBound =
+            (size_t)(st.contentOffsets[(lastChunk + 1) * nbOutputs + outN]
+                     - st.contentOffsets[firstChunk * nbOutputs + outN]);
+
+    // Chunks are decoded into chunk-local outputs,
+    // only the requested range is then copied into @p output.
+    dctx->outputs = ALLOC_Arena_calloc(
+            dctx->decompressArena, nbOutputs * sizeof(ZL_Data*));
+    ZL_ERR_IF_NULL(dctx->outputs, allocation);
+
+    size_t written = 0;
+    for (size_t c = firstChunk; c <= lastChunk; c++) {
+        cleanChunkBuffers(dctx);
+        for (size_t n = 0; n < nbOutputs; n++) {
+            dctx->outputs[n] = STREAM_createInArena(
+                    dctx->streamArena, (ZL_DataID){ (ZL_IDType)n });
+            ZL_ERR_IF_NULL(dctx->outputs[n], allocation);
+        }
+        uint32_t expectedContentHash = 0;
+        size_t const chunkStart      = (size_t)st.chunkOffsets[c];
+        ZL_TRY_LET(
+                size_t,
+                chunkSize,
+                DCTX_decodeChunk(
+                        dctx,
+                        framePtr,
+                        frameSize,
+                        chunkStart,
+                        &expectedContentHash));
+        ZL_ERR_IF_NE(
+                chunkSize,
+                st.chunkOffsets[c + 1] - chunkStart,
+                corruption,
+                "Chunk size doesn't match the seek table");
+
+        // Collect the content regenerated by this chunk
+        size_t const nbStreams = VECTOR_SIZE(dctx->dataInfos);
+        ZL_ERR_IF_GT(nbOutputs, nbStreams, outputs_tooNumerous);
+        const ZL_Data** const chunkOutputs = ALLOC_Arena_malloc(
+                dctx->streamArena, nbOutputs * sizeof(ZL_Data*));
+        ZL_ERR_IF_NULL(chunkOutputs, allocation);
+        for (size_t n = 0; n < nbOutputs; n++) {
+            size_t const lsid = nbStreams - n - 1;
+            chunkOutputs[n]   = VECTOR_AT(dctx->dataInfos, lsid).data;
+            ZL_ERR_IF_NULL(
+                    chunkOutputs[n],
+                    graph_invalid,
+                    "Final stream not produced!");
+        }
+        ZL_ERR_IF_ERR(DCTX_checkContentChecksum(
+                dctx, chunkOutputs, nbOutputs, expectedContentHash));
+
+        const ZL_Data* const chunkOutput = chunkOutputs[outN];
+        uint64_t const chunkFirstElt = st.eltOffsets[c * nbOutputs + outN];
+        size_t const chunkNumElts    = ZL_Data_numElts(chunkOutput);
+        ZL_ERR_IF_NE(
+                chunkNumElts,
+                st.eltOffsets[(c + 1) * nbOutputs + outN] - chunkFirstElt,
+                corruption,
+                "Chunk numElts doesn't match the seek table");
+
+        if (c == firstChunk) {
+            // output is typed once the first chunk is decoded
+            ZL_Type const type    = ZL_Data_type(chunkOutput);
+            size_t const eltWidth = ZL_Data_eltWidth(chunkOutput);
+            if (!STREAM_hasBuffer(output)) {
+                if (type == ZL_Type_string) {
+                    ZL_ERR_IF_ERR(
+                            STREAM_reserveStrings(output, numElts, bytesBound));
+                } else {
+                    ZL_ERR_IF_ERR(
+                            STREAM_reserve(output, type, eltWidth, numElts));
+                }
+            } else if (type != ZL_Type_string) {
+                ZL_ERR_IF_ERR(STREAM_initWritableStream(
+                        output, type, eltWidth, numElts));
+            }
+        }
+
+        size_t const sliceStart =
+                (c == firstChunk) ? (size_t)(eltBegin - chunkFirstElt) : 0;
+        size_t const sliceSize =
+                ZL_MIN(numElts - written, chunkNumElts - sliceStart);
+        ZL_Data* const slice = STREAM_createInArena(
+                dctx->streamArena, (ZL_DataID){ (ZL_IDType)outN });
+        ZL_ERR_IF_NULL(slice, allocation);
+        ZL_ERR_IF_ERR(STREAM_refStreamSliceWithoutRefCount(
+                slice, chunkOutput, sliceStart, sliceSize));
+        ZL_ERR_IF_ERR(STREAM_append(output, slice));
+        written += sliceSize;
+    }
+    ZL_ERR_IF_NE(written, numElts, corruption);
+
+    ZL_ERR_IF_ERR(DCTX_endRandomAccess(dctx));
+    return ZL_returnValue(numElts);
+}
+
 ZL_Report ZL_DCtx_decompressTBuffer(
         ZL_DCtx* dctx,
         ZL_TypedBuffer* tbuffer,
@@ -0,0 +1,622 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+/* Streaming decompression : ZL_DCtx_decompressStream()
+ *
+ * A frame is decoded one element at a time : frame header, Chunks, end of
+ * frame marker, and optional seek table. Each element is decoded directly from
+ * input when it's complete, and otherwise staged in an internal buffer until
+ * it is. The content regenerated by a Chunk is then flushed into outputs,
+ * possibly across multiple invocations, before the next Chunk is decoded.
+ * Memory usage is therefore bounded by the size of the largest Chunk.
+ *
+ * Each output of the frame is flushed into its own ZL_StreamOutput :
+ * String outputs employ 2 buffers, one for their content, and one for the
+ * lengths of their strings.
+ */
+
+#include "openzl/decompress/decompress_stream.h"
+#include "openzl/common/allocation.h"
+#include "openzl/common/errors_internal.h"
+#include "openzl/common/limits.h" // ZL_runtimeNodeLimit
+#include "openzl/common/logging.h"
+#include "openzl/common/vector.h"
+#include "openzl/common/wire_format.h"            // ZL_SEEK_TABLE_FOOTER_SIZE
+#include "openzl/decompress/dctx2.h"              // DCTX_decodeStreamChunk
+#include "openzl/decompress/decode_frameheader.h" // DFH_*
+#include "openzl/shared/mem.h"                    // ZL_memcpy
+#include "openzl/shared/utils.h"                  // ZL_MIN
+#include "openzl/shared/varint.h"                 // ZL_VARINT_LENGTH_64
+#include "openzl/zl_data.h"
+#include "openzl/zl_decompress.h"
+#include "openzl/zl_version.h" // ZL_getFormatVersionFromFrame
+
+/* Staging starts with this amount,
+ * and doubles until the element being staged can be measured */
+#define DSTREAM_PROBE_SIZE_MIN 256
+
+typedef enum {
+    DSTREAM_frameHeader = 0, // waiting for a frame header
+    DSTREAM_chunks,          // waiting for a Chunk or the end of frame marker
+    DSTREAM_seekTable,       // waiting for the seek table
+} DSTREAM_Stage;
+
+/* Regenerated content, waiting to be flushed into an output buffer */
+typedef struct {
+    const uint8_t* ptr;
+    size_t size;
+    size_t flushed;
+    // Hosts the remaining content when it references the compressed Chunk
+    uint8_t* buff;
+    size_t capacity;
+} DSTREAM_Pending;
+
+typedef struct {
+    DSTREAM_Pending content;
+    DSTREAM_Pending lengths; // String outputs only
+    uint64_t contentSize;    // regenerated so far in current frame
+} DSTREAM_Output;
+
+struct DSTREAM_State_s {
+    DSTREAM_Stage stage;
+    DFH_Struct dfh; // measures frame elements, before they are decoded
+    size_t nbChunks;
+
+    // Outputs of the current frame
+    DSTREAM_Output* outputs;
+    const ZL_Data** chunkOutputs; // content regenerated by current Chunk
+    size_t nbOutputs;
+    size_t outputsCapacity;
+
+    // Input accumulated, waiting to complete a frame element.
+    // Can host the beginning of following elements.
+    uint8_t* inBuff;
+    size_t inCapacity;
+    size_t inSize;
+    size_t unitSize; // size of the staged element, 0 when not yet known
+    size_t inLoaded; // staged from current input, during current invocation
+};
+
+static DSTREAM_State* DSTREAM_create(void)
+{
+    DSTREAM_State* const ds = ZL_calloc(sizeof(*ds));
+    if (ds == NULL)
+        return NULL;
+    DFH_init(&ds->dfh);
+    return ds;
+}
+
+void DSTREAM_free(DSTREAM_State* ds)
+{
+    if (ds == NULL)
+        return;
+    DFH_destroy(&ds->dfh);
+    ZL_free(ds->inBuff);
+    for (size_t n = 0; n < ds->outputsCapacity; n++) {
+        ZL_free(ds->outputs[n].content.buff);
+        ZL_free(ds->outputs[n].lengths.buff);
+    }
+    ZL_free(ds->outputs);
+    ZL_free(ds->chunkOutputs);
+    ZL_free(ds);
+}
+
+/* Registers @p size bytes at @p ptr to be flushed,
+ * dropping any content still pending */
+static void
+DSTREAM_setPending(DSTREAM_Pending* pending, const void* ptr, size_t size)
+{
+    pending->ptr     = (const uint8_t*)ptr;
+    pending->size    = size;
+    pending->flushed = 0;
+}
+
+/* Note : staged input is preserved, as it may belong to the next frame */
+static void DSTREAM_resetFrame(DSTREAM_State* ds)
+{
+    ds->stage    = DSTREAM_frameHeader;
+    ds->nbChunks = 0;
+    for (size_t n = 0; n < ds->nbOutputs; n++) {
+        DSTREAM_Output* const out = &ds->outputs[n];
+        DSTREAM_setPending(&out->content, NULL, 0);
+        DSTREAM_setPending(&out->lengths, NULL, 0);
+        out->contentSize = 0;
+    }
+    ds->nbOutputs = 0;
+}
+
+static void DSTREAM_abandonFrame(DSTREAM_State* ds)
+{
+    DSTREAM_resetFrame(ds);
+    ds->inSize   = 0;
+    ds->unitSize = 0;
+}
+
+/* Ensures @p *buff can hold at least @p size bytes,
+ * preserving its first @p preserved bytes. */
+static ZL_Report DSTREAM_reserve(
+        uint8_t** buff,
+        size_t* capacity,
+        size_t size,
+        size_t preserved)
+{
+    if (*capacity >= size)
+        return ZL_returnSuccess();
+    ZL_ASSERT_LE(preserved, *capacity);
+    uint8_t* const newBuff = ZL_malloc(size);
+    ZL_RET_R_IF_NULL(allocation, newBuff);
+    if (preserved) {
+        ZL_memcpy(newBuff, *buff, preserved);
+    }
+    ZL_free(*buff);
+    *buff     = newBuff;
+    *capacity = size;
+    return ZL_returnSuccess();
+}
+
+/* Prepares @p nbOutputs outputs for the frame starting,
+ * keeping the buffers of previous frames. */
+static ZL_Report DSTREAM_startOutputs(DSTREAM_State* ds, size_t nbOutputs)
+{
+    ZL_ASSERT_EQ(ds->nbOutputs, 0);
+    if (nbOutputs > ds->outputsCapacity) {
+        const ZL_Data** const chunkOutputs = ZL_realloc(
+                ds->chunkOutputs, nbOutputs * sizeof(*chunkOutputs));
+        ZL_RET_R_IF_NULL(allocation, chunkOutputs);
+        ds->chunkOutputs = chunkOutputs;
+        DSTREAM_Output* const outputs =
+                ZL_realloc(ds->outputs, nbOutputs * sizeof(*outputs));
+        ZL_RET_R_IF_NULL(allocation, outputs);
+        memset(outputs + ds->outputsCapacity,
+               0,
+               (nbOutputs - ds->outputsCapacity) * sizeof(*outputs));
+        ds->outputs         = outputs;
+        ds->outputsCapacity = nbOutputs;
+    }
+    ds->nbOutputs = nbOutputs;
+    return ZL_returnSuccess();
+}
+
+/* @returns the size of the frame element starting at @p src,
+ * or an error if @p src doesn't contain enough of it to tell.
+ * Chunks are measured from their header only, so their size can be
+ * larger than @p srcSize. */
+static ZL_Report
+DSTREAM_measure(DSTREAM_State* ds, const void* src, size_t srcSize)
+{
+    switch (ds->stage) {
+        default:
+            ZL_ASSERT_FAIL("invalid stage");
+            ZL_FALLTHROUGH;
+        case DSTREAM_frameHeader:
+            return DFH_decodeFrameHeader(&ds->dfh, src, srcSize);
+        case DSTREAM_chunks:
+            ZL_RET_R_IF_LT(srcSize_tooSmall, srcSize, 1);
+            if (*(const uint8_t*)src == 0) {
+                return ZL_returnValue(1); // end of frame marker
+            }
+            return DFH_getChunkSizeFromHeader(&ds->dfh, src, srcSize);
+        case DSTREAM_seekTable:
+            return DFH_getSeekTableSize(ds->dfh.frameinfo, src, srcSize);
+    }
+}
+
+/* @returns the maximum amount of input required to measure the current
+ * element. Staged input failing to be measured beyond this size is invalid. */
+static size_t DSTREAM_measureBound(const DSTREAM_State* ds)
+{
+    size_t const maxVarint = ZL_VARINT_LENGTH_64;
+    switch (ds->stage) {
+        default:
+            ZL_ASSERT_FAIL("invalid stage");
+            ZL_FALLTHROUGH;
+        case DSTREAM_frameHeader: {
+            // magic, properties, nb outputs, then type and sizes per output
+            size_t const nbOutputs =
+                    ZL_runtimeInputLimit(ZL_MAX_FORMAT_VERSION);
+            return 16 + nbOutputs * (1 + 2 * maxVarint);
+        }
+        case DSTREAM_chunks: {
+            // Generous : a few varints per node, stream and output
+            unsigned const fv = ds->dfh.formatVersion;
+            return 16 + ZL_runtimeNodeLimit(fv) * 4 * maxVarint
+                    + ZL_runtimeStreamLimit(fv) * 2 * maxVarint
+                    + ZL_runtimeInputLimit(fv) * 2 * maxVarint;
+        }
+        case DSTREAM_seekTable: {
+            // nb of chunks, then sizes per chunk and output
+            ZL_Report const nbOutputs =
+                    ZL_FrameInfo_getNumOutputs(ds->dfh.frameinfo);
+            ZL_ASSERT_SUCCESS(nbOutputs);
+            return maxVarint
+                    + ds->nbChunks * (1 + 2 * ZL_validResult(nbOutputs))
+                    * maxVarint
+                    + ZL_SEEK_TABLE_FOOTER_SIZE;
+        }
+    }
+}
+
+/* Makes the next frame element available contiguously into @p *unit,
+ * either directly from @p input, or once it's completely staged.
+ * @returns the size of the element, or 0 if more input is needed */
+static ZL_Report DSTREAM_loadUnit(
+        DSTREAM_State* ds,
+        ZL_InBuffer* input,
+        const uint8_t** unit)
+{
+    if (ds->inSize == 0) {
+        // Fast path : element completely present in input
+        const uint8_t* const src = (const uint8_t*)input->src + input->pos;
+        size_t const srcAvail    = input->size - input->pos;
+        ZL_Report const r        = DSTREAM_measure(ds, src, srcAvail);
+        if (!ZL_isError(r) && ZL_validResult(r) <= srcAvail) {
+            *unit = src;
+            input->pos += ZL_validResult(r);
+            return r;
+        }
+    }
+
+    for (;;) {
+        if (ds->unitSize == 0 && ds->inSize > 0) {
+            ZL_Report const r = DSTREAM_measure(ds, ds->inBuff, ds->inSize);
+            if (!ZL_isError(r)) {
+                ds->unitSize = ZL_validResult(r);
+            } else if (ds->inSize >= DSTREAM_measureBound(ds)) {
+                return r;
+            } else if (ds->stage == DSTREAM_frameHeader && ds->inSize >= 4) {
+                // Reject foreign data early, without waiting for more input
+                ZL_RET_R_IF_ERR(
+                        ZL_getFormatVersionFromFrame(ds->inBuff, ds->inSize));
+            }
+        }
+        if (ds->unitSize != 0 && ds->inSize >= ds->unitSize) {
+            *unit = ds->inBuff;
+            return ZL_returnValue(ds->unitSize);
+        }
+
+        size_t const srcAvail = input->size - input->pos;
+        if (srcAvail == 0) {
+            return ZL_returnValue(0);
+        }
+        size_t const target = ds->unitSize != 0
+                ? ds->unitSize
+                : ds->inSize + ZL_MAX(ds->inSize, DSTREAM_PROBE_SIZE_MIN);
+        size_t const toLoad = ZL_MIN(target - ds->inSize, srcAvail);
+        ZL_RET_R_IF_ERR(DSTREAM_reserve(
+                &ds->inBuff, &ds->inCapacity, target, ds->inSize));
+        ZL_memcpy(
+                ds->inBuff + ds->inSize,
+                (const uint8_t*)input->src + input->pos,
+                toLoad);
+        ds->inSize += toLoad;
+        ds->inLoaded += toLoad;
+        input->pos += toLoad;
+    }
+}
+
+/* Releases the element loaded by DSTREAM_loadUnit(),
+ * keeping any following input staged. */
+static void DSTREAM_consumeUnit(
+        DSTREAM_State* ds,
+        const uint8_t* unit,
+        size_t unitSize)
+{
+    if (unit != ds->inBuff)
+        return;
+    ZL_ASSERT_EQ(unitSize, ds->unitSize);
+    ZL_ASSERT_GE(ds->inSize, unitSize);
+    ds->inSize -= unitSize;
+    if (ds->inSize) {
+        memmove(ds->inBuff, ds->inBuff + unitSize, ds->inSize);
+    }
+    ds->unitSize = 0;
+}
+
+/* Flushes as much of @p pending as possible into @p dst */
+static void DSTREAM_drainPending(DSTREAM_Pending* pending, ZL_OutBuffer* dst)
+{
+    size_t const remaining = pending->size - pending->flushed;
+    size_t const toCopy    = ZL_MIN(remaining, dst->size - dst->pos);
+    if (toCopy) {
+        ZL_memcpy(
+                (uint8_t*)dst->dst + dst->pos,
+                pending->ptr + pending->flushed,
+                toCopy);
+    }
+    dst->pos += toCopy;
+    pending->flushed += toCopy;
+}
+
+/* Flushes as much regenerated content as possible into @p outputs
+ * @returns 1 if all regenerated content is flushed, 0 otherwise */
+static int DSTREAM_drain(DSTREAM_State* ds, ZL_StreamOutput outputs[])
+{
+    int flushed = 1;
+    for (size_t n = 0; n < ds->nbOutputs; n++) {
+        DSTREAM_Output* const out = &ds->outputs[n];
+        DSTREAM_drainPending(&out->content, &outputs[n].content);
+        DSTREAM_drainPending(&out->lengths, &outputs[n].lengths);
+        flushed &= (out->content.flushed == out->content.size)
+                && (out->lengths.flushed == out->lengths.size);
+    }
+    return flushed;
+}
+
+/* Content may reference the compressed chunk @p unit, which doesn't survive:
+ * copies the part not yet flushed into @p pending's own buffer */
+static ZL_Report DSTREAM_preservePending(
+        DSTREAM_Pending* pending,
+        const uint8_t* unit,
+        size_t unitSize)
+{
+    size_t const remaining = pending->size - pending->flushed;
+    if (remaining == 0)
+        return ZL_returnSuccess();
+    const uint8_t* const src = pending->ptr + pending->flushed;
+    if (src >= unit && src < unit + unitSize) {
+        ZL_RET_R_IF_ERR(DSTREAM_reserve(
+                &pending->buff, &pending->capacity, remaining, 0));
+        ZL_memcpy(pending->buff, src, remaining);
+        pending->ptr     = pending->buff;
+        pending->size    = remaining;
+        pending->flushed = 0;
+    }
+    return ZL_returnSuccess();
+}
+
+/* Decodes Chunk @p unit, and flushes its content into @p outputs.
+ * Content which doesn't fit is kept for next invocations. */
+static ZL_Report DSTREAM_decodeChunk(
+        ZL_DCtx* dctx,
+        DSTREAM_State* ds,
+        const uint8_t* unit,
+        size_t unitSize,
+        ZL_StreamOutput outputs[])
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    ZL_DLOG(BLOCK,
+            "DSTREAM_decodeChunk %zu (size=%zu)",
+            ds->nbChunks,
+            unitSize);
+
+    ZL_ERR_IF_ERR(
+            DCTX_decodeStreamChunk(dctx, ds->chunkOutputs, unit, unitSize));
+    int const unknownContentSize =
+            FrameInfo_hasUnknownContentSize(ds->dfh.frameinfo);
+    for (size_t n = 0; n < ds->nbOutputs; n++) {
+        const ZL_Data* const content = ds->chunkOutputs[n];
+        DSTREAM_Output* const out    = &ds->outputs[n];
+        size_t const contentSize     = ZL_Data_contentSize(content);
+        if (unknownContentSize) {
+            // dfh still describes this chunk, measured by DSTREAM_loadUnit()
+            ZL_ERR_IF_NE(
+                    contentSize,
+                    VECTOR_AT(ds->dfh.chunkOutputSizes, n),
+                    corruption,
+                    "Regenerated size of output %zu in chunk %zu is incorrect",
+                    n,
+                    ds->nbChunks);
+        }
+        out->contentSize += contentSize;
+        DSTREAM_setPending(&out->content, ZL_Data_rPtr(content), contentSize);
+        if (ZL_Data_type(content) == ZL_Type_string) {
+            DSTREAM_setPending(
+                    &out->lengths,
+                    ZL_Data_rStringLens(content),
+                    ZL_Data_numElts(content) * sizeof(uint32_t));
+        } else {
+            DSTREAM_setPending(&out->lengths, NULL, 0);
+        }
+    }
+    ds->nbChunks++;
+    if (DSTREAM_drain(ds, outputs))
+        return ZL_returnSuccess();
+
+    for (size_t n = 0; n < ds->nbOutputs; n++) {
+        DSTREAM_Output* const out = &ds->outputs[n];
+        ZL_ERR_IF_ERR(DSTREAM_preservePending(&out->content, unit, unitSize));
+        ZL_ERR_IF_ERR(DSTREAM_preservePending(&out->lengths, unit, unitSize));
+    }
+    return ZL_returnSuccess();
+}
+
+/* Verifies the frame is complete, then closes it */
+static ZL_Report DSTREAM_endFrame(ZL_DCtx* dctx, DSTREAM_State* ds)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    if (!FrameInfo_hasUnknownContentSize(ds->dfh.frameinfo)) {
+        for (size_t n = 0; n < ds->nbOutputs; n++) {
+            ZL_TRY_LET(
+                    size_t,
+                    dSize,
+                    ZL_FrameInfo_getDecompressedSize(
+                            ds->dfh.frameinfo, (int)n));
+            ZL_ERR_IF_NE(
+                    ds->outputs[n].contentSize,
+                    dSize,
+                    corruption,
+                    "Regenerated size of output %zu is incorrect",
+                    n);
+        }
+    }
+    ZL_DLOG(FRAME,
+            "DSTREAM_endFrame: %zu chunks, %zu outputs",
+            ds->nbChunks,
+            ds->nbOutputs);
+    DSTREAM_resetFrame(ds);
+    ZL_ASSERT_EQ(ds->unitSize, 0);
+    return DCTX_endStreamFrame(dctx);
+}
+
+/* Starts the frame of header @p unit, to be flushed into @p outputs */
+static ZL_Report DSTREAM_startFrame(
+        ZL_DCtx* dctx,
+        DSTREAM_State* ds,
+        const uint8_t* unit,
+        size_t unitSize,
+        const ZL_StreamOutput outputs[],
+        size_t nbOutputs)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    ZL_TRY_LET(
+            size_t,
+            hSize,
+            DCTX_startStreamFrame(dctx, unit, unitSize, nbOutputs));
+    ZL_ERR_IF_NE(hSize, unitSize, corruption);
+    for (size_t n = 0; n < nbOutputs; n++) {
+        ZL_TRY_LET(
+                size_t,
+                type,
+                ZL_FrameInfo_getOutputType(ds->dfh.frameinfo, (int)n));
+        ZL_ERR_IF(
+                type == ZL_Type_string && outputs[n].lengths.dst == NULL,
+                parameter_invalid,
+                "String output %zu requires a buffer for its lengths",
+                n);
+    }
+    ZL_ERR_IF_ERR(DSTREAM_startOutputs(ds, nbOutputs));
+    ds->stage = DSTREAM_chunks;
+    return ZL_returnSuccess();
+}
+
+static ZL_Report DSTREAM_decompressStream_internal(
+        ZL_DCtx* dctx,
+        DSTREAM_State* ds,
+        ZL_InBuffer* input,
+        ZL_StreamOutput outputs[],
+        size_t nbOutputs)
+{
+    ZL_RESULT_DECLARE_SCOPE_REPORT(dctx);
+    if (ds->stage != DSTREAM_frameHeader) {
+        ZL_ERR_IF_NE(
+                nbOutputs,
+                ds->nbOutputs,
+                userBuffers_invalidNum,
+                "Frame has %zu outputs, but %zu were provided",
+                ds->nbOutputs,
+                nbOutputs);
+    }
+    for (;;) {
+        if (!DSTREAM_drain(ds, outputs)) {
+            // an output is full
+            return ZL_returnValue(1);
+        }
+
+        const uint8_t* unit = NULL;
+        ZL_TRY_LET(size_t, unitSize, DSTREAM_loadUnit(ds, input, &unit));
+        if (unitSize == 0) {
+            // Note : remaining size is only known once element is measured
+            return ZL_returnValue(
+                    ds->unitSize ? ds->unitSize - ds->inSize : 1);
+        }
+
+        int frameEnd = 0;
+        switch (ds->stage) {
+            default:
+                ZL_ASSERT_FAIL("invalid stage");
+                ZL_FALLTHROUGH;
+            case DSTREAM_frameHeader:
+                ZL_ERR_IF_ERR(DSTREAM_startFrame(
+                        dctx, ds, unit, unitSize, outputs, nbOutputs));
+                break;
+            case DSTREAM_chunks:
+                if (unitSize == 1 && unit[0] == 0) {
+                    ZL_DLOG(SEQ, "End of frame detected");
+                    if (FrameInfo_hasSeekTable(ds->dfh.frameinfo)) {
+                        ds->stage = DSTREAM_seekTable;
+                    } else {
+                        frameEnd = 1;
+                    }
+                    break;
+                }
+                ZL_ERR_IF_ERR(DSTREAM_decodeChunk(
+                        dctx, ds, unit, unitSize, outputs));
+                break;
+            case DSTREAM_seekTable:
+                // The seek table is only employed for random access
+                frameEnd = 1;
+                break;
+        }
+        DSTREAM_consumeUnit(ds, unit, unitSize);
+
+        if (frameEnd) {
+            ZL_ERR_IF_ERR(DSTREAM_endFrame(dctx, ds));
+            // Input beyond the frame is given back, when it's still present
+            // in @p input. Otherwise, it remains staged for the next frame.
+            if (ds->inSize && ds->inSize <= ds->inLoaded) {
+                ZL_ASSERT_LE(ds->inSize, input->pos);
+                input->pos -= ds->inSize;
+                ds->inSize = 0;
+            }
+            return ZL_returnValue(0);
+        }
+    }
+}
+
+ZL_Report ZL_DCtx_decompressStreamMulti(
+        ZL_DCtx* dctx,
+        ZL_InBuffer* input,
+        ZL_StreamOutput outputs[],
+        size_t nbOutputs)
+{
+    ZL_RET_R_IF_NULL(parameter_invalid, dctx);
+    ZL_RET_R_IF_NULL(parameter_invalid, input);
+    ZL_RET_R_IF_NULL(parameter_invalid, outputs);
+    ZL_RET_R_IF_GT(parameter_invalid, input->pos, input->size);
+    for (size_t n = 0; n < nbOutputs; n++) {
+        ZL_RET_R_IF_GT(
+                parameter_invalid,
+                outputs[n].content.pos,
+                outputs[n].content.size);
+        ZL_RET_R_IF_GT(
+                parameter_invalid,
+                outputs[n].lengths.pos,
+                outputs[n].lengths.size);
+    }
+
+    DSTREAM_State* ds = DCTX_getStreamState(dctx);
+    if (ds == NULL) {
+        ds = DSTREAM_create();
+        ZL_RET_R_IF_NULL(allocation, ds);
+        DCTX_setStreamState(dctx, ds);
+    }
+
+    ds->inLoaded      = 0;
+    ZL_Report const r = DSTREAM_decompressStream_internal(
+            dctx, ds, input, outputs, nbOutputs);
+    if (ZL_isError(r)) {
+        // Abandon the frame
+        int const frameStarted = ds->stage != DSTREAM_frameHeader;
+        DSTREAM_abandonFrame(ds);
+        if (frameStarted) {
+            ZL_RET_R_IF_ERR(DCTX_endStreamFrame(dctx));
+        }
+    }
+    return r;
+}
+
+ZL_Report ZL_DCtx_decompressStream(
+        ZL_DCtx* dctx,
+        ZL_InBuffer* input,
+        ZL_OutBuffer* output)
+{
+    ZL_RET_R_IF_NULL(parameter_invalid, output);
+    // No buffer for lengths : String outputs are rejected
+    ZL_StreamOutput single = { *output, { NULL, 0, 0 } };
+    ZL_Report const r = ZL_DCtx_decompressStreamMulti(dctx, input, &single, 1);
+    output->pos       = single.content.pos;
+    return r;
+}
+
+ZL_Report ZL_DCtx_resetStream(ZL_DCtx* dctx)
+{
+    ZL_RET_R_IF_NULL(parameter_invalid, dctx);
+    DSTREAM_State* const ds = DCTX_getStreamState(dctx);
+    if (ds != NULL) {
+        int const frameStarted = ds->stage != DSTREAM_frameHeader;
+        DSTREAM_abandonFrame(ds);
+        if (frameStarted) {
+            ZL_RET_R_IF_ERR(DCTX_endStreamFrame(dctx));
+        }
+    }
+    return ZL_returnSuccess();
+}
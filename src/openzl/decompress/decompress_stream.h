@@ -0,0 +1,19 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#ifndef ZSTRONG_DECOMPRESS_DECOMPRESS_STREAM_H
+#define ZSTRONG_DECOMPRESS_DECOMPRESS_STREAM_H
+
+#include "openzl/shared/portability.h"
+
+ZL_BEGIN_C_DECLS
+
+/* State of ZL_DCtx_decompressStream(),
+ * allocated on first invocation and owned by its ZL_DCtx. */
+typedef struct DSTREAM_State_s DSTREAM_State;
+
+/* Compatible with NULL */
+void DSTREAM_free(DSTREAM_State* dstream);
+
+ZL_END_C_DECLS
+
+#endif // ZSTRONG_DECOMPRESS_DECOMPRESS_STREAM_H
@@ -191,6 +191,25 @@ static ZL_RESULT_OF(ZL_IDType) DTM_registerDCustomTransform(
     return ZL_RESULT_WRAP_VALUE(ZL_IDType, insert.ptr->val.miGraphDesc.CTid);
 }
 
+ZL_Report DTM_importCustomTransforms(
+        DTransforms_manager* dst,
+        const DTransforms_manager* src)
+{
+    ZL_ASSERT_NN(dst);
+    ZL_ASSERT_NN(src);
+    DTransformMap_Iter iter = DTransformMap_iter(&src->dtmap);
+    for (const DTransformMap_Entry* entry;
+         (entry = DTransformMap_Iter_next(&iter));) {
+        if (DTransformMap_findVal(&dst->dtmap, entry->key) != NULL) {
+            continue;
+        }
+        DTransform dt = entry->val;
+        dt.state      = NULL;
+        ZL_RET_R_IF_ERR(DTM_registerDCustomTransform(dst, &dt));
+    }
+    return ZL_returnSuccess();
+}
+
 static ZL_Report pipeTransformWrapper(
         ZL_Decoder* dictx,
         const DTransform* transform,
@@ -98,6 +98,15 @@ ZL_Report DTM_init(DTransforms_manager* dtm, uint32_t maxNbTransforms);
 
 void DTM_destroy(DTransforms_manager* dtm);
 
+/* DTM_importCustomTransforms():
+ * Registers into @p dst all custom transforms of @p src not yet present.
+ * Imported transforms reference descriptions owned by @p src,
+ * which must therefore outlive @p dst.
+ * Transform states are not shared: each manager creates its own. */
+ZL_Report DTM_importCustomTransforms(
+        DTransforms_manager* dst,
+        const DTransforms_manager* src);
+
 // Accessors
 
 /* Note :
@@ -26,6 +26,10 @@ GDParams_setParameter(GDParams* gdparams, ZL_DParam paramId, int value)
         case ZL_DParam_checkContentChecksum:
             gdparams->checkContentChecksum = (ZL_TernaryParam)value;
             break;
+        case ZL_DParam_nbWorkers:
+            ZL_RET_R_IF_LT(compressionParameter_invalid, value, 0);
+            gdparams->nbWorkers = value;
+            break;
         default:
             ZL_RET_R_ERR(compressionParameter_invalid);
     }
@@ -41,6 +45,7 @@ void GDParams_applyDefaults(GDParams* dst, const GDParams* defaults)
     // Note: stickyParameters aren't overridden by defaults
     SET_DEFAULT(dst, defaults, checkCompressedChecksum);
     SET_DEFAULT(dst, defaults, checkContentChecksum);
+    SET_DEFAULT(dst, defaults, nbWorkers);
 }
 #undef SET_DEFAULT
 
@@ -63,6 +68,9 @@ int GDParams_getParameter(const GDParams* gdparams, ZL_DParam paramId)
         case ZL_DParam_checkContentChecksum:
             return (int)gdparams->checkContentChecksum;
             break;
+        case ZL_DParam_nbWorkers:
+            return gdparams->nbWorkers;
+            break;
         default:
             return 0;
     }
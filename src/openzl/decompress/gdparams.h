@@ -18,6 +18,7 @@ typedef struct {
     int stickyParameters;
     ZL_TernaryParam checkCompressedChecksum;
     ZL_TernaryParam checkContentChecksum;
+    int nbWorkers; // Nb of Chunks decoded in parallel; 0 or 1 means serial
 } GDParams;
 
 // All defaults for Global parameters
@@ -0,0 +1,91 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "openzl/shared/cpu.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <immintrin.h> // _xgetbv
+#endif
+
+/* Set once features have been detected,
+ * so that g_cpuFeatures == 0 means "not detected yet" */
+#define ZL_CPU_FEATURES_DETECTED (1u << 31)
+
+static unsigned g_cpuFeatures;
+static unsigned g_cpuFeaturesMask = ZL_CPU_FEATURES_ALL;
+
+/* Detection is idempotent, so concurrent first invocations are benign,
+ * as long as accesses are atomic */
+static unsigned CPU_load(const unsigned* ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+#else
+    return *(const volatile unsigned*)ptr;
+#endif
+}
+
+static void CPU_store(unsigned* ptr, unsigned value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+#else
+    *(volatile unsigned*)ptr = value;
+#endif
+}
+
+/* @returns the register states enabled by the OS (XCR0) */
+static uint64_t CPU_xgetbv(void)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return _xgetbv(0);
+#elif defined(__x86_64__) || defined(__i386__)
+    uint32_t eax, edx;
+    __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#else
+    return 0;
+#endif
+}
+
+unsigned ZL_cpuFeatures_detect(void)
+{
+    ZL_cpuid_t const cpuid = ZL_cpuid();
+    unsigned features      = 0;
+    if (ZL_cpuid_ssse3(cpuid))
+        features |= ZL_CpuFeature_ssse3;
+    if (ZL_cpuid_sse42(cpuid))
+        features |= ZL_CpuFeature_sse42;
+    if (ZL_cpuid_bmi1(cpuid) && ZL_cpuid_bmi2(cpuid))
+        features |= ZL_CpuFeature_bmi2;
+    if (ZL_cpuid_pclmuldq(cpuid))
+        features |= ZL_CpuFeature_pclmul;
+    if (ZL_cpuid_osxsave(cpuid) && ZL_cpuid_avx(cpuid)) {
+        uint64_t const xcr0 = CPU_xgetbv();
+        // XMM and YMM states
+        if ((xcr0 & 0x6) == 0x6 && ZL_cpuid_avx2(cpuid))
+            features |= ZL_CpuFeature_avx2;
+        // XMM, YMM, opmask and ZMM states
+        if ((xcr0 & 0xE6) == 0xE6 && ZL_cpuid_avx512f(cpuid)
+            && ZL_cpuid_avx512bw(cpuid) && ZL_cpuid_avx512vl(cpuid))
+            features |= ZL_CpuFeature_avx512;
+    }
+#if ZL_ARCH_ARM64 && defined(__ARM_NEON)
+    features |= ZL_CpuFeature_neon;
+#endif
+    return features;
+}
+
+unsigned ZL_cpuFeatures(void)
+{
+    unsigned features = CPU_load(&g_cpuFeatures);
+    if (features == 0) {
+        features = ZL_cpuFeatures_detect() | ZL_CPU_FEATURES_DETECTED;
+        CPU_store(&g_cpuFeatures, features);
+    }
+    return features & CPU_load(&g_cpuFeaturesMask);
+}
+
+void ZL_cpuFeatures_setMask(unsigned mask)
+{
+    CPU_store(&g_cpuFeaturesMask, mask & ZL_CPU_FEATURES_ALL);
+}
@@ -205,6 +205,89 @@ C(avx512vbmi, 1)
 
 #undef X
 
+/* -------------------------------------------------------------------------
+ * Runtime dispatch
+ *
+ * Code paths requiring an instruction set extension are compiled when either
+ * the whole build targets it (ZL_HAS_*), or when ZL_CPU_DISPATCH is enabled,
+ * in which case they are placed within a ZL_TARGET_*_BEGIN / ZL_TARGET_END
+ * region. Either way, they are then selected at runtime with ZL_cpuHas(),
+ * so that portable binaries still employ the best available kernels.
+ *
+ * Headers must be included before a target region,
+ * and functions defined within a region must not be ZL_FORCE_INLINE.
+ * ------------------------------------------------------------------------- */
+
+#ifndef ZL_CPU_DISPATCH
+#    if ZL_ARCH_X86_64 && (defined(__GNUC__) || defined(__clang__))
+#        define ZL_CPU_DISPATCH 1
+#    else
+#        define ZL_CPU_DISPATCH 0
+#    endif
+#endif
+
+/// 1 when code paths requiring the extension are compiled
+#define ZL_CAN_SSSE3 (ZL_HAS_SSSE3 || ZL_CPU_DISPATCH)
+#define ZL_CAN_SSE42 (ZL_HAS_SSE42 || ZL_CPU_DISPATCH)
+#define ZL_CAN_BMI2 (ZL_HAS_BMI2 || ZL_CPU_DISPATCH)
+#define ZL_CAN_AVX2 (ZL_HAS_AVX2 || ZL_CPU_DISPATCH)
+#define ZL_CAN_PCLMUL (ZL_HAS_PCLMUL || ZL_CPU_DISPATCH)
+
+#define ZL_CPU_PRAGMA_(x) _Pragma(#x)
+#if ZL_CPU_DISPATCH && defined(__clang__)
+#    define ZL_TARGET_BEGIN_(t)                                         \
+        ZL_CPU_PRAGMA_(clang attribute push(__attribute__((target(t))), \
+                                            apply_to = function))
+#    define ZL_TARGET_END ZL_CPU_PRAGMA_(clang attribute pop)
+#elif ZL_CPU_DISPATCH
+#    define ZL_TARGET_BEGIN_(t) \
+        ZL_CPU_PRAGMA_(GCC push_options) ZL_CPU_PRAGMA_(GCC target(t))
+#    define ZL_TARGET_END ZL_CPU_PRAGMA_(GCC pop_options)
+#else
+#    define ZL_TARGET_BEGIN_(t)
+#    define ZL_TARGET_END
+#endif
+#define ZL_TARGET_SSSE3_BEGIN ZL_TARGET_BEGIN_("ssse3")
+#define ZL_TARGET_SSE42_BMI2_BEGIN ZL_TARGET_BEGIN_("sse4.2,bmi,bmi2")
+#define ZL_TARGET_AVX2_BEGIN ZL_TARGET_BEGIN_("avx2")
+#define ZL_TARGET_AVX2_BMI2_BEGIN ZL_TARGET_BEGIN_("avx2,bmi,bmi2")
+#define ZL_TARGET_PCLMUL_BEGIN ZL_TARGET_BEGIN_("pclmul")
+
+typedef enum {
+    ZL_CpuFeature_ssse3  = 1 << 0,
+    ZL_CpuFeature_sse42  = 1 << 1,
+    ZL_CpuFeature_bmi2   = 1 << 2,
+    ZL_CpuFeature_avx2   = 1 << 3, ///< Requires OS support of AVX state
+    ZL_CpuFeature_avx512 = 1 << 4, ///< F, BW and VL, and OS support
+    ZL_CpuFeature_pclmul = 1 << 5, ///< Carry-less multiplication
+    ZL_CpuFeature_neon   = 1 << 6, ///< Advanced SIMD, always present on arm64
+} ZL_CpuFeature;
+
+#define ZL_CPU_FEATURES_ALL 0x7Fu
+
+/// @returns the features supported by the CPU and the OS.
+unsigned ZL_cpuFeatures_detect(void);
+
+/**
+ * @returns the features which code paths may employ. They are detected once
+ * per process, then restricted by ZL_cpuFeatures_setMask().
+ */
+unsigned ZL_cpuFeatures(void);
+
+/**
+ * Restricts the features which code paths may employ to @p mask,
+ * typically to test or benchmark the other code paths.
+ * ZL_CPU_FEATURES_ALL restores the default.
+ * @note Must not be invoked while other threads are (de)compressing.
+ */
+void ZL_cpuFeatures_setMask(unsigned mask);
+
+/// @returns whether all @p features may be employed
+ZL_INLINE bool ZL_cpuHas(unsigned features)
+{
+    return (ZL_cpuFeatures() & features) == features;
+}
+
 ZL_END_C_DECLS
 
 #endif /* ZSTRONG_COMMON_CPU_H */
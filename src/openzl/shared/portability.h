@@ -190,6 +190,12 @@ ZL_BEGIN_C_DECLS
 #    define ZL_HAS_SSE42 0
 #endif
 
+#if defined(__PCLMUL__)
+#    define ZL_HAS_PCLMUL 1
+#else
+#    define ZL_HAS_PCLMUL 0
+#endif
+
 #ifndef ZL_FALLTHROUGH
 #    if ZL_HAS_C_ATTRIBUTE(fallthrough)
 #        define ZL_FALLTHROUGH [[fallthrough]]
@@ -105,6 +105,15 @@ TEST_F(CompressParamsTest, strToParam)
     ASSERT_EQ(
             ZL_validResult(GCParams_strToParam("minStreamSize")),
             ZL_CParam_minStreamSize);
+    ASSERT_EQ(
+            ZL_validResult(GCParams_strToParam("nbWorkers")),
+            ZL_CParam_nbWorkers);
+    ASSERT_EQ(
+            ZL_validResult(GCParams_strToParam("seekTable")),
+            ZL_CParam_seekTable);
+    ASSERT_EQ(
+            ZL_validResult(GCParams_strToParam("streamBlockSize")),
+            ZL_CParam_streamBlockSize);
     ASSERT_TRUE(ZL_isError(GCParams_strToParam("invalid")));
     ASSERT_TRUE(ZL_isError(GCParams_strToParam("")));
 }
@@ -132,6 +141,15 @@ TEST_F(CompressParamsTest, paramToStr)
     ASSERT_EQ(
             std::string("minStreamSize"),
             GCParams_paramToStr(ZL_CParam_minStreamSize));
+    ASSERT_EQ(
+            std::string("nbWorkers"),
+            GCParams_paramToStr(ZL_CParam_nbWorkers));
+    ASSERT_EQ(
+            std::string("seekTable"),
+            GCParams_paramToStr(ZL_CParam_seekTable));
+    ASSERT_EQ(
+            std::string("streamBlockSize"),
+            GCParams_paramToStr(ZL_CParam_streamBlockSize));
     ASSERT_EQ(NULL, GCParams_paramToStr((ZL_CParam)0x424242));
 }
 } // namespace
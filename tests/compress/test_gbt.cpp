@@ -761,3 +761,288 @@ TEST_F(GBTValidModelTest, verifyOutOfBoundsMissingChild)
 
     createPredictorAndValidate(invalid_nodes);
 }
+
+namespace {
+/// Compiled predictor, along with the buffer it views
+struct CompiledPredictor {
+    std::vector<uint32_t> buffer;
+    size_t size{};
+    GBTPredictor_Compiled compiled{};
+};
+
+ZL_Report compile(CompiledPredictor& out, const GBTPredictor& predictor)
+{
+    const size_t bound = GBTPredictor_compiledBound(&predictor);
+    out.buffer.resize(bound / sizeof(uint32_t) + 1);
+    const ZL_Report size = GBTPredictor_compile(
+            &predictor, out.buffer.data(), out.buffer.size() * sizeof(uint32_t));
+    if (ZL_isError(size)) {
+        return size;
+    }
+    EXPECT_LE(ZL_validResult(size), bound);
+    out.size = ZL_validResult(size);
+    return GBTPredictor_Compiled_load(
+            &out.compiled, out.buffer.data(), out.size);
+}
+
+/// Appends a random subtree of depth at most @p depth to @p nodes, numbering
+/// children in depth-first order, unlike the breadth-first compiled layout.
+size_t generateRandomSubtree(
+        std::mt19937_64& mt,
+        std::vector<GBTPredictor_Node>& nodes,
+        size_t depth,
+        int nbFeatures)
+{
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    const size_t idx = nodes.size();
+    nodes.push_back({ .featureIdx      = -1,
+                      .value           = value(mt),
+                      .leftChildIdx    = 0,
+                      .rightChildIdx   = 0,
+                      .missingChildIdx = 0 });
+    if (depth == 0 || mt() % 4 == 0) {
+        return idx;
+    }
+    const size_t left  = generateRandomSubtree(mt, nodes, depth - 1, nbFeatures);
+    const size_t right = generateRandomSubtree(mt, nodes, depth - 1, nbFeatures);
+    nodes[idx].featureIdx      = (int)(mt() % (size_t)nbFeatures);
+    nodes[idx].leftChildIdx    = left;
+    nodes[idx].rightChildIdx   = right;
+    nodes[idx].missingChildIdx = mt() % 2 ? left : right;
+    return idx;
+}
+
+/// Random predictor with @p nbForests forests of random trees
+class RandomPredictor {
+   public:
+    RandomPredictor(std::mt19937_64& mt, size_t nbForests, int nbFeatures)
+    {
+        const size_t nbTrees = 1 + mt() % 20;
+        nodes_.resize(nbForests * nbTrees);
+        trees_.resize(nbForests);
+        for (size_t f = 0; f < nbForests; ++f) {
+            for (size_t t = 0; t < nbTrees; ++t) {
+                auto& nodes = nodes_[f * nbTrees + t];
+                generateRandomSubtree(mt, nodes, mt() % 10, nbFeatures);
+                trees_[f].push_back(
+                        { .numNodes = nodes.size(), .nodes = nodes.data() });
+            }
+            forests_.push_back(
+                    { .numTrees = trees_[f].size(), .trees = trees_[f].data() });
+        }
+        predictor_ = { .numForests = forests_.size(),
+                       .forests    = forests_.data() };
+    }
+
+    const GBTPredictor& get() const
+    {
+        return predictor_;
+    }
+
+   private:
+    std::vector<std::vector<GBTPredictor_Node>> nodes_;
+    std::vector<std::vector<GBTPredictor_Tree>> trees_;
+    std::vector<GBTPredictor_Forest> forests_;
+    GBTPredictor predictor_{};
+};
+
+std::vector<float> generateRandomFeatures(
+        std::mt19937_64& mt,
+        size_t nbInputs,
+        size_t nbFeatures)
+{
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::vector<float> features(nbInputs * nbFeatures);
+    for (auto& feature : features) {
+        switch (mt() % 8) {
+            case 0:
+                feature = NAN;
+                break;
+            case 1:
+                feature = (mt() % 2 ? 1 : -1) * INFINITY;
+                break;
+            default:
+                feature = value(mt);
+        }
+    }
+    return features;
+}
+
+void expectCompiledMatches(std::mt19937_64& mt, size_t nbForests)
+{
+    const int kNbFeatures = 12;
+    RandomPredictor predictor(mt, nbForests, kNbFeatures);
+    CompiledPredictor compiled;
+    ZL_REQUIRE_SUCCESS(compile(compiled, predictor.get()));
+    EXPECT_LE(compiled.compiled.numFeatures, (size_t)kNbFeatures);
+
+    const size_t kNbInputs = 37;
+    const auto features = generateRandomFeatures(mt, kNbInputs, kNbFeatures);
+    // Fewer features than the predictor reads: the others are missing
+    for (size_t nbFeatures : { (size_t)kNbFeatures, (size_t)5, (size_t)0 }) {
+        std::vector<size_t> classes(kNbInputs);
+        GBTPredictor_Compiled_predictBatch(
+                &compiled.compiled,
+                features.data(),
+                kNbFeatures,
+                nbFeatures,
+                kNbInputs,
+                classes.data());
+        for (size_t i = 0; i < kNbInputs; ++i) {
+            const float* input = features.data() + i * kNbFeatures;
+            const size_t expected =
+                    GBTPredictor_predict(&predictor.get(), input, nbFeatures);
+            ASSERT_EQ(
+                    GBTPredictor_Compiled_predict(
+                            &compiled.compiled, input, nbFeatures),
+                    expected);
+            ASSERT_EQ(classes[i], expected);
+        }
+    }
+}
+} // namespace
+
+TEST(GBTCompiledTest, matchesPredictor)
+{
+    std::mt19937_64 mt(kRandomSeed);
+    for (size_t i = 0; i < 100; ++i) {
+        expectCompiledMatches(mt, 1);
+        expectCompiledMatches(mt, 3 + i % 5);
+    }
+}
+
+TEST_F(GBTBinaryForestTest, compiledBinaryClassification)
+{
+    const GBTPredictor predictor = { .numForests = binaryForest.size(),
+                                     .forests    = binaryForest.data() };
+    CompiledPredictor compiled;
+    ZL_REQUIRE_SUCCESS(compile(compiled, predictor));
+    EXPECT_EQ(compiled.compiled.numTrees, (size_t)5);
+    EXPECT_EQ(compiled.compiled.numNodes, (size_t)5);
+    EXPECT_EQ(
+            GBTPredictor_Compiled_predict(
+                    &compiled.compiled,
+                    binaryFeatures.data(),
+                    binaryFeatures.size()),
+            (size_t)1);
+}
+
+TEST_F(GBTMultiClassForestTest, compiledMultiClassification)
+{
+    const GBTPredictor predictor = { .numForests = multiClassForests.size(),
+                                     .forests    = multiClassForests.data() };
+    CompiledPredictor compiled;
+    ZL_REQUIRE_SUCCESS(compile(compiled, predictor));
+    EXPECT_EQ(compiled.compiled.numForests, (size_t)3);
+    EXPECT_EQ(compiled.compiled.numNodes, (size_t)21);
+    EXPECT_EQ(compiled.compiled.trees[0].depth, (uint32_t)2);
+    EXPECT_EQ(
+            GBTPredictor_Compiled_predict(
+                    &compiled.compiled,
+                    multiClassFeatures.data(),
+                    multiClassFeatures.size()),
+            (size_t)1);
+}
+
+TEST(GBTCompiledTest, emptyPredictor)
+{
+    const GBTPredictor predictor = { .numForests = 0, .forests = nullptr };
+    CompiledPredictor compiled;
+    ZL_REQUIRE_SUCCESS(compile(compiled, predictor));
+    const float feature = 1.0f;
+    EXPECT_EQ(
+            GBTPredictor_Compiled_predict(&compiled.compiled, &feature, 1),
+            (size_t)0);
+}
+
+TEST(GBTCompiledTest, rejectsUncompilableTrees)
+{
+    std::vector<GBTPredictor_Node> nodes;
+    GBTPredictor_Tree tree = generateTree(7, nodes, 0, 0, /* forceRight */ true);
+    const GBTPredictor_Forest forest = { .numTrees = 1, .trees = &tree };
+    const GBTPredictor predictor  = { .numForests = 1, .forests = &forest };
+    CompiledPredictor compiled;
+    ZL_REQUIRE_SUCCESS(compile(compiled, predictor));
+
+    // Missing values take neither child
+    nodes[1].missingChildIdx = 5;
+    EXPECT_TRUE(ZL_isError(compile(compiled, predictor)));
+    nodes[1].missingChildIdx = nodes[1].leftChildIdx;
+
+    // Nodes reachable from several parents are duplicated, as long as that
+    // doesn't take more nodes than the source tree
+    nodes[2].leftChildIdx = 4;
+    ZL_REQUIRE_SUCCESS(compile(compiled, predictor));
+    nodes[2].leftChildIdx = 5;
+    const std::vector<GBTPredictor_Node> sharedNodes = {
+        { .featureIdx      = 0,
+          .value           = 0.0f,
+          .leftChildIdx    = 1,
+          .rightChildIdx   = 1,
+          .missingChildIdx = 1 },
+        { .featureIdx      = 0,
+          .value           = 1.0f,
+          .leftChildIdx    = 2,
+          .rightChildIdx   = 2,
+          .missingChildIdx = 2 },
+        { .featureIdx      = -1,
+          .value           = 1.0f,
+          .leftChildIdx    = 0,
+          .rightChildIdx   = 0,
+          .missingChildIdx = 0 },
+    };
+    const GBTPredictor_Tree sharedTree = { .numNodes = sharedNodes.size(),
+                                           .nodes    = sharedNodes.data() };
+    const GBTPredictor_Forest sharedForest = { .numTrees = 1,
+                                               .trees    = &sharedTree };
+    const GBTPredictor sharedPredictor     = { .numForests = 1,
+                                               .forests    = &sharedForest };
+    EXPECT_TRUE(ZL_isError(compile(compiled, sharedPredictor)));
+
+    // Invalid tree
+    nodes[2].rightChildIdx = 1;
+    EXPECT_TRUE(ZL_isError(compile(compiled, predictor)));
+    nodes[2].rightChildIdx = 6;
+
+    // Buffer too small
+    std::vector<uint32_t> buffer(8);
+    EXPECT_TRUE(ZL_isError(GBTPredictor_compile(
+            &predictor, buffer.data(), buffer.size() * sizeof(uint32_t))));
+}
+
+TEST(GBTCompiledTest, loadRejectsCorruptedBuffers)
+{
+    std::mt19937_64 mt(kRandomSeed);
+    RandomPredictor predictor(mt, 3, 8);
+    CompiledPredictor compiled;
+    ZL_REQUIRE_SUCCESS(compile(compiled, predictor.get()));
+
+    GBTPredictor_Compiled loaded;
+    const auto load = [&](const std::vector<uint32_t>& buffer, size_t size) {
+        return GBTPredictor_Compiled_load(&loaded, buffer.data(), size);
+    };
+    EXPECT_TRUE(ZL_isError(load(compiled.buffer, compiled.size - 1)));
+    EXPECT_TRUE(ZL_isError(load(compiled.buffer, compiled.size - 16)));
+    EXPECT_TRUE(ZL_isError(load(compiled.buffer, 16)));
+
+    auto corrupted = compiled.buffer;
+    corrupted[0] ^= 1;
+    EXPECT_TRUE(ZL_isError(load(corrupted, compiled.size)));
+
+    // Out of bounds left child of the last node
+    corrupted = compiled.buffer;
+    corrupted[compiled.size / sizeof(uint32_t) - 2] =
+            (uint32_t)compiled.compiled.numNodes;
+    EXPECT_TRUE(ZL_isError(load(corrupted, compiled.size)));
+
+    // Random corruptions are either rejected or evaluated safely
+    const auto features = generateRandomFeatures(mt, 1, 8);
+    for (size_t i = 0; i < 1000; ++i) {
+        corrupted = compiled.buffer;
+        const size_t word = mt() % (compiled.size / sizeof(uint32_t));
+        corrupted[word] ^= (uint32_t)1 << (mt() % 32);
+        if (!ZL_isError(load(corrupted, compiled.size))) {
+            GBTPredictor_Compiled_predict(&loaded, features.data(), 8);
+        }
+    }
+}
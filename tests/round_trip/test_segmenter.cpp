@@ -5,9 +5,15 @@
 // standard C
 #include <stdio.h> // printf
 
+// standard C++
+#include <string>
+#include <utility>
+#include <vector>
+
 // OpenZL
 #include "openzl/codecs/zl_conversion.h"
 #include "openzl/codecs/zl_generic.h"
+#include "openzl/cpp/ThreadPool.hpp"
 #include "openzl/zl_compress.h" // ZL_CCtx_compress
 #include "openzl/zl_compressor.h"
 #include "openzl/zl_data.h"
@@ -505,6 +511,337 @@ TEST(Segmenter, string)
             ZL_Type_string, registerSegmenter, g_segmenterDescPtr->name);
 }
 
+/* ******************************************** */
+/* =======   Multi-threaded Segmenter   ======== */
+/* ******************************************** */
+
+#define MT_CHUNKSIZE 3000
+
+/* Cuts input into fixed-size chunks,
+ * passing runtime parameters living on the stack */
+ZL_Report fixedSizeSegmenterFn(ZL_Segmenter* sctx)
+{
+    size_t remaining;
+    ZL_RET_R_IF_ERR(ZL_Segmenter_getNumElts(sctx, &remaining, 1));
+    while (remaining > 0) {
+        size_t chunkSize =
+                (remaining < MT_CHUNKSIZE) ? remaining : MT_CHUNKSIZE;
+        ZL_IntParam const intParam   = { 1, (int)chunkSize };
+        ZL_LocalParams const lparams = { .intParams = { &intParam, 1 } };
+        ZL_RuntimeGraphParameters const rgp = { .localParams = &lparams };
+        ZL_RET_R_IF_ERR(ZL_Segmenter_processChunk(
+                sctx, &chunkSize, 1, ZL_GRAPH_COMPRESS_GENERIC, &rgp));
+        remaining -= chunkSize;
+    }
+    return ZL_returnSuccess();
+}
+
+static ZL_SegmenterDesc const fixedSizeSegmenter = {
+    .name           = "Fixed Size Segmenter",
+    .segmenterFn    = fixedSizeSegmenterFn,
+    .inputTypeMasks = (const ZL_Type[]){ ZL_Type_serial },
+    .numInputs      = 1,
+};
+
+static std::string compressWithWorkers(
+        const std::string& input,
+        int nbWorkers,
+        openzl::ThreadPool* pool,
+        bool seekTable = false)
+{
+    ZL_Compressor* const compressor = ZL_Compressor_create();
+    ZL_CCtx* const cctx             = ZL_CCtx_create();
+    g_segmenterDescPtr              = &fixedSizeSegmenter;
+    EXPECT_FALSE(ZL_isError(
+            ZL_Compressor_initUsingGraphFn(compressor, registerSegmenter)));
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_refCompressor(cctx, compressor)));
+    EXPECT_FALSE(ZL_isError(
+            ZL_CCtx_setParameter(cctx, ZL_CParam_nbWorkers, nbWorkers)));
+    if (seekTable) {
+        EXPECT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+                cctx, ZL_CParam_seekTable, ZL_TernaryParam_enable)));
+    }
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        EXPECT_FALSE(ZL_isError(ZL_CCtx_setWorkerPool(cctx, &workerPool)));
+    }
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    ZL_Report const r = ZL_CCtx_compress(
+            cctx,
+            &compressed[0],
+            compressed.size(),
+            input.data(),
+            input.size());
+    EXPECT_FALSE(ZL_isError(r)) << "compression failed \n";
+    compressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return compressed;
+}
+
+TEST(Segmenter, multiThreaded)
+{
+    if (g_testVersion < ZL_CHUNK_VERSION_MIN)
+        return;
+    std::string input;
+    for (size_t n = 0; input.size() < 50 * MT_CHUNKSIZE + 123; n++) {
+        input += "line " + std::to_string(n * n % 1009) + ", value "
+                + std::to_string(n) + "\n";
+    }
+    std::string const reference = compressWithWorkers(input, 0, nullptr);
+    ASSERT_GT(reference.size(), 0u);
+
+    openzl::ThreadPool pool(3);
+    for (int nbWorkers : { 2, 4, 7, 64 }) {
+        std::string const compressed =
+                compressWithWorkers(input, nbWorkers, &pool);
+        // Output must be byte-identical to single-threaded mode
+        ASSERT_EQ(compressed, reference) << "nbWorkers = " << nbWorkers;
+    }
+    // Without a pool, nbWorkers is ignored
+    ASSERT_EQ(compressWithWorkers(input, 4, nullptr), reference);
+
+    std::string decompressed(input.size(), '\0');
+    size_t const dSize = decompress(
+            &decompressed[0],
+            decompressed.size(),
+            reference.data(),
+            reference.size());
+    ASSERT_EQ(dSize, input.size());
+    ASSERT_EQ(decompressed, input);
+}
+
+static std::string decompressWithWorkers(
+        const std::string& compressed,
+        size_t dstCapacity,
+        int nbWorkers,
+        openzl::ThreadPool* pool)
+{
+    ZL_DCtx* const dctx = ZL_DCtx_create();
+    EXPECT_FALSE(ZL_isError(
+            ZL_DCtx_setParameter(dctx, ZL_DParam_nbWorkers, nbWorkers)));
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        EXPECT_FALSE(ZL_isError(ZL_DCtx_setWorkerPool(dctx, &workerPool)));
+    }
+    std::string decompressed(dstCapacity, '\0');
+    ZL_Report const r = ZL_DCtx_decompress(
+            dctx,
+            &decompressed[0],
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+    EXPECT_FALSE(ZL_isError(r)) << "decompression failed \n";
+    decompressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_DCtx_free(dctx);
+    return decompressed;
+}
+
+TEST(Segmenter, multiThreadedDecompression)
+{
+    if (g_testVersion < ZL_CHUNK_VERSION_MIN)
+        return;
+    std::string input;
+    for (size_t n = 0; input.size() < 37 * MT_CHUNKSIZE + 45; n++) {
+        input += "id=" + std::to_string(n * 7919 % 10007) + ";\n";
+    }
+    std::string const compressed = compressWithWorkers(input, 0, nullptr);
+    ASSERT_GT(compressed.size(), 0u);
+
+    openzl::ThreadPool pool(3);
+    for (int nbWorkers : { 2, 4, 7, 64 }) {
+        ASSERT_EQ(
+                decompressWithWorkers(
+                        compressed, input.size(), nbWorkers, &pool),
+                input)
+                << "nbWorkers = " << nbWorkers;
+    }
+    // Without a pool, nbWorkers is ignored
+    ASSERT_EQ(
+            decompressWithWorkers(compressed, input.size(), 4, nullptr),
+            input);
+}
+
+/* ******************************************** */
+/* =======   Random access (seek table)   ======= */
+/* ******************************************** */
+
+static std::string decompressChunkAt(
+        ZL_DCtx* dctx,
+        const std::string& compressed,
+        size_t chunkIndex)
+{
+    ZL_TypedBuffer* tbuffer = ZL_TypedBuffer_create();
+    ZL_Report const r       = ZL_DCtx_decompressChunkAt(
+            dctx,
+            &tbuffer,
+            1,
+            chunkIndex,
+            compressed.data(),
+            compressed.size());
+    EXPECT_FALSE(ZL_isError(r)) << "chunk " << chunkIndex << " failed\n";
+    std::string const chunk = ZL_isError(r)
+            ? std::string()
+            : std::string(
+                      (const char*)ZL_TypedBuffer_rPtr(tbuffer),
+                      ZL_TypedBuffer_byteSize(tbuffer));
+    ZL_TypedBuffer_free(tbuffer);
+    return chunk;
+}
+
+static std::string decompressRange(
+        ZL_DCtx* dctx,
+        const std::string& compressed,
+        size_t eltBegin,
+        size_t eltEnd)
+{
+    ZL_TypedBuffer* const tbuffer = ZL_TypedBuffer_create();
+    ZL_Report const r             = ZL_DCtx_decompressRange(
+            dctx,
+            tbuffer,
+            0,
+            eltBegin,
+            eltEnd,
+            compressed.data(),
+            compressed.size());
+    EXPECT_FALSE(ZL_isError(r))
+            << "range [" << eltBegin << ", " << eltEnd << ") failed\n";
+    EXPECT_EQ(ZL_isError(r) ? 0 : ZL_validResult(r), eltEnd - eltBegin);
+    std::string const range = (ZL_isError(r) || eltBegin == eltEnd)
+            ? std::string()
+            : std::string(
+                      (const char*)ZL_TypedBuffer_rPtr(tbuffer),
+                      ZL_TypedBuffer_byteSize(tbuffer));
+    ZL_TypedBuffer_free(tbuffer);
+    return range;
+}
+
+TEST(Segmenter, seekTable)
+{
+    if (g_testVersion < ZL_SEEK_TABLE_VERSION_MIN)
+        return;
+    std::string input;
+    for (size_t n = 0; input.size() < 20 * MT_CHUNKSIZE + 77; n++) {
+        input += "key" + std::to_string(n * 31 % 997) + "|";
+    }
+    std::string const compressed =
+            compressWithWorkers(input, 0, nullptr, true);
+    ASSERT_GT(compressed.size(), 0u);
+    ASSERT_GT(compressed.size(), compressWithWorkers(input, 0, nullptr).size());
+
+    // Multi-threaded compression records the same table
+    openzl::ThreadPool pool(3);
+    ASSERT_EQ(compressWithWorkers(input, 4, &pool, true), compressed);
+
+    // Regular decompression skips the seek table
+    ASSERT_EQ(
+            ZL_validResult(
+                    ZL_getCompressedSize(compressed.data(), compressed.size())),
+            compressed.size());
+    ASSERT_EQ(
+            decompressWithWorkers(compressed, input.size(), 0, nullptr),
+            input);
+    ASSERT_EQ(
+            decompressWithWorkers(compressed, input.size(), 4, &pool), input);
+
+    size_t const nbChunks = (input.size() + MT_CHUNKSIZE - 1) / MT_CHUNKSIZE;
+    ZL_Report const nbChunksR =
+            ZL_getNumChunks(compressed.data(), compressed.size());
+    ASSERT_FALSE(ZL_isError(nbChunksR));
+    ASSERT_EQ(ZL_validResult(nbChunksR), nbChunks);
+
+    ZL_DCtx* const dctx = ZL_DCtx_create();
+    for (size_t c = nbChunks; c-- > 0;) {
+        ASSERT_EQ(
+                decompressChunkAt(dctx, compressed, c),
+                input.substr(c * MT_CHUNKSIZE, MT_CHUNKSIZE))
+                << "chunk " << c;
+    }
+
+    std::vector<std::pair<size_t, size_t>> const ranges = {
+        { 0, 1 },
+        { 5, 5 },
+        { 0, MT_CHUNKSIZE },
+        { MT_CHUNKSIZE - 1, MT_CHUNKSIZE + 1 },
+        { 2 * MT_CHUNKSIZE + 17, 5 * MT_CHUNKSIZE + 3 },
+        { input.size() - 10, input.size() },
+        { 0, input.size() },
+    };
+    for (const auto& range : ranges) {
+        ASSERT_EQ(
+                decompressRange(dctx, compressed, range.first, range.second),
+                input.substr(range.first, range.second - range.first));
+    }
+
+    // Invalid requests
+    ZL_TypedBuffer* const tbuffer = ZL_TypedBuffer_create();
+    ZL_TypedBuffer* tbuffers[]    = { tbuffer };
+    ASSERT_TRUE(ZL_isError(ZL_DCtx_decompressChunkAt(
+            dctx,
+            tbuffers,
+            1,
+            nbChunks,
+            compressed.data(),
+            compressed.size())));
+    ASSERT_TRUE(ZL_isError(ZL_DCtx_decompressRange(
+            dctx,
+            tbuffer,
+            0,
+            0,
+            input.size() + 1,
+            compressed.data(),
+            compressed.size())));
+    ASSERT_TRUE(ZL_isError(ZL_DCtx_decompressRange(
+            dctx, tbuffer, 1, 0, 1, compressed.data(), compressed.size())));
+    ZL_TypedBuffer_free(tbuffer);
+
+    // Frames without a seek table don't support random access
+    std::string const noTable = compressWithWorkers(input, 0, nullptr);
+    ZL_Report const noTableR = ZL_getNumChunks(noTable.data(), noTable.size());
+    ASSERT_TRUE(ZL_isError(noTableR));
+    ASSERT_EQ(ZL_errorCode(noTableR), ZL_ErrorCode_frameParameter_unsupported);
+    ZL_DCtx_free(dctx);
+}
+
+TEST(Segmenter, seekTableRequiresFormatVersion)
+{
+    if (g_testVersion < ZL_SEEK_TABLE_VERSION_MIN)
+        return;
+    std::string const input(3 * MT_CHUNKSIZE + 5, 'a');
+
+    // Frames of older versions can't carry a seek table
+    ZL_CCtx* const cctx = ZL_CCtx_create();
+    ASSERT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_formatVersion, ZL_SEEK_TABLE_VERSION_MIN - 1)));
+    ASSERT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_seekTable, ZL_TernaryParam_enable)));
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    ZL_Report const r = ZL_CCtx_compress(
+            cctx,
+            &compressed[0],
+            compressed.size(),
+            input.data(),
+            input.size());
+    ASSERT_TRUE(ZL_isError(r));
+    ASSERT_EQ(ZL_errorCode(r), ZL_ErrorCode_formatVersion_unsupported);
+    ZL_CCtx_free(cctx);
+
+    // Decoders reject the seek table flag on older versions
+    std::string frame = compressWithWorkers(input, 0, nullptr, true);
+    ASSERT_GT(frame.size(), 4u);
+    // The magic number is little-endian, and ends with the format version
+    int const versionDelta = g_testVersion - (ZL_SEEK_TABLE_VERSION_MIN - 1);
+    frame[0]               = (char)(frame[0] - versionDelta);
+    ASSERT_EQ(
+            ZL_validResult(
+                    ZL_getFormatVersionFromFrame(frame.data(), frame.size())),
+            (size_t)ZL_SEEK_TABLE_VERSION_MIN - 1);
+    ASSERT_TRUE(ZL_isError(ZL_getCompressedSize(frame.data(), frame.size())));
+    std::string decompressed(input.size(), '\0');
+    ASSERT_TRUE(ZL_isError(ZL_decompress(
+            &decompressed[0], decompressed.size(), frame.data(), frame.size())));
+}
+
 /* *********************************************** */
 /* =======   Expected clean failure tests ======== */
 /* *********************************************** */
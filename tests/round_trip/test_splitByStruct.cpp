@@ -5,9 +5,15 @@
 // standard C
 #include <stdio.h> // printf
 
+// standard C++
+#include <string>
+
 // Zstrong
+#include "openzl/codecs/zl_split_by_struct.h"
 #include "openzl/common/debug.h" // ZL_REQUIRE
+#include "openzl/cpp/ThreadPool.hpp"
 #include "openzl/zl_compress.h"
+#include "openzl/zl_compressor.h"
 #include "openzl/zl_decompress.h" // ZL_decompress
 
 namespace {
@@ -215,4 +221,147 @@ TEST(SplitByStruct, test_splitByStruct_0)
             "splitByStruct with a structure of size 0 => failure expected");
 }
 
+/* ------   parallel successors   ------ */
+
+/* Fields are sent to diverse Successors, one of which splits again,
+ * so that Successors create Streams, transform headers,
+ * and store their Inputs directly */
+static ZL_GraphID splitGraph_parallel(ZL_Compressor* cgraph) noexcept
+{
+    ZL_REQUIRE(!ZL_isError(ZL_Compressor_setParameter(
+            cgraph, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION)));
+    const size_t innerSizes[]       = { 1, 1, 2 };
+    const ZL_GraphID innerGraphs[]  = { ZL_GRAPH_ZSTD,
+                                        ZL_GRAPH_STORE,
+                                        ZL_GRAPH_COMPRESS_GENERIC };
+    ZL_GraphID const inner          = ZL_Compressor_registerSplitByStructGraph(
+            cgraph, innerSizes, innerGraphs, 3);
+    const size_t fieldSizes[]       = { 4, 1, 8, 4, 2, 4, 3 };
+    const ZL_GraphID successors[]   = { ZL_GRAPH_COMPRESS_GENERIC,
+                                        ZL_GRAPH_STORE,
+                                        ZL_GRAPH_ZSTD,
+                                        inner,
+                                        ZL_GRAPH_COMPRESS_GENERIC,
+                                        ZL_GRAPH_COMPRESS_GENERIC,
+                                        ZL_GRAPH_STORE };
+    return ZL_Compressor_registerSplitByStructGraph(
+            cgraph, fieldSizes, successors, 7);
+}
+
+static std::string compressWithWorkers(
+        const std::string& input,
+        int nbWorkers,
+        openzl::ThreadPool* pool)
+{
+    ZL_Compressor* const compressor = ZL_Compressor_create();
+    ZL_CCtx* const cctx             = ZL_CCtx_create();
+    EXPECT_FALSE(ZL_isError(ZL_Compressor_initUsingGraphFn(
+            compressor, splitGraph_parallel)));
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_refCompressor(cctx, compressor)));
+    EXPECT_FALSE(ZL_isError(
+            ZL_CCtx_setParameter(cctx, ZL_CParam_nbWorkers, nbWorkers)));
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        EXPECT_FALSE(ZL_isError(ZL_CCtx_setWorkerPool(cctx, &workerPool)));
+    }
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    ZL_Report const r = ZL_CCtx_compress(
+            cctx,
+            &compressed[0],
+            compressed.size(),
+            input.data(),
+            input.size());
+    EXPECT_FALSE(ZL_isError(r)) << "compression failed \n";
+    compressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return compressed;
+}
+
+static std::string decompressWithWorkers(
+        const std::string& compressed,
+        size_t dstCapacity,
+        int nbWorkers,
+        openzl::ThreadPool* pool)
+{
+    ZL_DCtx* const dctx = ZL_DCtx_create();
+    EXPECT_FALSE(ZL_isError(
+            ZL_DCtx_setParameter(dctx, ZL_DParam_nbWorkers, nbWorkers)));
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        EXPECT_FALSE(ZL_isError(ZL_DCtx_setWorkerPool(dctx, &workerPool)));
+    }
+    std::string decompressed(dstCapacity, '\0');
+    ZL_Report const r = ZL_DCtx_decompress(
+            dctx,
+            &decompressed[0],
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+    EXPECT_FALSE(ZL_isError(r)) << "decompression failed \n";
+    decompressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_DCtx_free(dctx);
+    return decompressed;
+}
+
+// structure size : 26
+static std::string genStructs(uint32_t nbStructs)
+{
+    std::string input;
+    for (uint32_t n = 0; n < nbStructs; n++) {
+        uint32_t const fields[] = { n, n % 7, n * n, n / 3, n % 300, ~n, n };
+        const size_t fieldSizes[] = { 4, 1, 8, 4, 2, 4, 3 };
+        for (size_t f = 0; f < 7; f++) {
+            for (size_t b = 0; b < fieldSizes[f]; b++) {
+                input += (char)(b < 4 ? fields[f] >> (8 * b) : 0);
+            }
+        }
+    }
+    return input;
+}
+
+TEST(SplitByStruct, parallelSuccessors)
+{
+    std::string const input     = genStructs(3000);
+    std::string const reference = compressWithWorkers(input, 0, nullptr);
+    ASSERT_GT(reference.size(), 0u);
+
+    openzl::ThreadPool pool(3);
+    for (int nbWorkers : { 2, 3, 4, 16 }) {
+        // Output must be byte-identical to single-threaded mode
+        ASSERT_EQ(compressWithWorkers(input, nbWorkers, &pool), reference)
+                << "nbWorkers = " << nbWorkers;
+    }
+
+    std::string decompressed(input.size(), '\0');
+    size_t const dSize = decompress(
+            &decompressed[0],
+            decompressed.size(),
+            reference.data(),
+            reference.size());
+    ASSERT_EQ(dSize, input.size());
+    ASSERT_EQ(decompressed, input);
+}
+
+TEST(SplitByStruct, parallelDecoders)
+{
+    // A single Chunk, whose field decoders are independent
+    std::string const input      = genStructs(5000);
+    std::string const compressed = compressWithWorkers(input, 0, nullptr);
+    ASSERT_GT(compressed.size(), 0u);
+
+    openzl::ThreadPool pool(3);
+    for (int nbWorkers : { 2, 3, 4, 16 }) {
+        ASSERT_EQ(
+                decompressWithWorkers(
+                        compressed, input.size(), nbWorkers, &pool),
+                input)
+                << "nbWorkers = " << nbWorkers;
+    }
+    // Without a pool, nbWorkers is ignored
+    ASSERT_EQ(
+            decompressWithWorkers(compressed, input.size(), 4, nullptr),
+            input);
+}
+
 } // namespace
@@ -0,0 +1,684 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "openzl/cpp/ThreadPool.hpp"
+#include "openzl/zl_compress.h"   // ZL_CCtx_compressStream
+#include "openzl/zl_compressor.h" // ZL_Compressor_create
+#include "openzl/zl_decompress.h" // ZL_decompress
+#include "openzl/zl_errors.h"
+#include "openzl/zl_segmenter.h" // ZL_Segmenter_processChunk
+#include "openzl/zl_version.h"   // ZL_UNKNOWN_SIZE_VERSION_MIN
+
+namespace {
+
+static std::string genInput(size_t size)
+{
+    std::string input;
+    for (size_t n = 0; input.size() < size; n++) {
+        input += "ts=" + std::to_string(1700000000 + n * 3) + " level="
+                + std::to_string(n * n % 7) + " msg=event "
+                + std::to_string(n % 113) + "\n";
+    }
+    input.resize(size);
+    return input;
+}
+
+static void setStreamParams(ZL_CCtx* cctx, int blockSize, bool seekTable)
+{
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION)));
+    EXPECT_FALSE(ZL_isError(
+            ZL_CCtx_setParameter(cctx, ZL_CParam_streamBlockSize, blockSize)));
+    if (seekTable) {
+        EXPECT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+                cctx, ZL_CParam_seekTable, ZL_TernaryParam_enable)));
+    }
+}
+
+/* Feeds @p input by slices of @p inStep bytes, collecting compressed data
+ * through an output buffer of @p outStep bytes.
+ * All slices but the last one are provided with @p mode. */
+static std::string compressStream(
+        ZL_CCtx* cctx,
+        const std::string& input,
+        size_t inStep,
+        size_t outStep,
+        ZL_FlushMode mode = ZL_FlushMode_continue)
+{
+    std::string compressed;
+    std::string outBuff(outStep, '\0');
+    size_t pos = 0;
+    while (1) {
+        size_t const end        = std::min(input.size(), pos + inStep);
+        bool const last         = (end == input.size());
+        ZL_FlushMode const curr = last ? ZL_FlushMode_end : mode;
+        ZL_InBuffer in          = { input.data(), end, pos };
+        size_t remaining;
+        do {
+            ZL_OutBuffer out  = { &outBuff[0], outBuff.size(), 0 };
+            ZL_Report const r = ZL_CCtx_compressStream(cctx, &in, &out, curr);
+            EXPECT_FALSE(ZL_isError(r)) << "streaming compression failed\n";
+            if (ZL_isError(r))
+                return std::string();
+            compressed.append(outBuff.data(), out.pos);
+            remaining = ZL_validResult(r);
+        } while (in.pos < in.size
+                 || (curr != ZL_FlushMode_continue && remaining != 0));
+        pos = end;
+        if (last)
+            break;
+    }
+    return compressed;
+}
+
+static std::string decompress(const std::string& compressed)
+{
+    ZL_Report const dSize =
+            ZL_getDecompressedSize(compressed.data(), compressed.size());
+    EXPECT_FALSE(ZL_isError(dSize)) << "can't determine decompressed size\n";
+    if (ZL_isError(dSize))
+        return std::string();
+    std::string decompressed(ZL_validResult(dSize), '\0');
+    ZL_Report const r = ZL_decompress(
+            &decompressed[0],
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+    EXPECT_FALSE(ZL_isError(r)) << "decompression failed\n";
+    decompressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    return decompressed;
+}
+
+/* Feeds @p compressed to ZL_DCtx_decompressStream() by slices of
+ * @p inStep bytes, collecting content through an output buffer of
+ * @p outStep bytes, until the end of the first frame. */
+static std::string decompressStream(
+        ZL_DCtx* dctx,
+        const std::string& compressed,
+        size_t inStep,
+        size_t outStep,
+        size_t* consumed = nullptr)
+{
+    std::string decompressed;
+    std::string outBuff(outStep, '\0');
+    ZL_InBuffer in = { compressed.data(), 0, 0 };
+    while (1) {
+        in.size          = std::min(compressed.size(), in.pos + inStep);
+        ZL_OutBuffer out = { &outBuff[0], outBuff.size(), 0 };
+        ZL_Report const r = ZL_DCtx_decompressStream(dctx, &in, &out);
+        EXPECT_FALSE(ZL_isError(r)) << "streaming decompression failed: "
+                                    << ZL_DCtx_getErrorContextString(dctx, r);
+        if (ZL_isError(r))
+            return std::string();
+        decompressed.append(outBuff.data(), out.pos);
+        if (ZL_validResult(r) == 0)
+            break;
+        if (in.pos == compressed.size() && out.pos == 0) {
+            ADD_FAILURE() << "frame is incomplete";
+            return std::string();
+        }
+    }
+    if (consumed != nullptr)
+        *consumed = in.pos;
+    return decompressed;
+}
+
+/* Feeds @p compressed to ZL_DCtx_decompressStreamMulti() by slices of
+ * @p inStep bytes, collecting the content of each output through buffers of
+ * @p outStep bytes, until the end of the first frame.
+ * The lengths of String outputs are collected into @p lengths. */
+static std::vector<std::string> decompressStreamMulti(
+        ZL_DCtx* dctx,
+        const std::string& compressed,
+        size_t nbOutputs,
+        size_t inStep,
+        size_t outStep,
+        std::vector<std::string>* lengths)
+{
+    std::vector<std::string> contents(nbOutputs);
+    lengths->assign(nbOutputs, std::string());
+    std::vector<std::string> outBuffs(2 * nbOutputs, std::string(outStep, 0));
+    std::vector<ZL_StreamOutput> outputs(nbOutputs);
+    ZL_InBuffer in = { compressed.data(), 0, 0 };
+    while (1) {
+        in.size = std::min(compressed.size(), in.pos + inStep);
+        for (size_t n = 0; n < nbOutputs; n++) {
+            outputs[n].content = { &outBuffs[2 * n][0], outStep, 0 };
+            outputs[n].lengths = { &outBuffs[2 * n + 1][0], outStep, 0 };
+        }
+        ZL_Report const r = ZL_DCtx_decompressStreamMulti(
+                dctx, &in, outputs.data(), nbOutputs);
+        EXPECT_FALSE(ZL_isError(r)) << "streaming decompression failed: "
+                                    << ZL_DCtx_getErrorContextString(dctx, r);
+        if (ZL_isError(r))
+            return {};
+        size_t written = 0;
+        for (size_t n = 0; n < nbOutputs; n++) {
+            contents[n].append(outBuffs[2 * n].data(), outputs[n].content.pos);
+            (*lengths)[n].append(
+                    outBuffs[2 * n + 1].data(), outputs[n].lengths.pos);
+            written += outputs[n].content.pos + outputs[n].lengths.pos;
+        }
+        if (ZL_validResult(r) == 0)
+            break;
+        if (in.pos == compressed.size() && written == 0) {
+            ADD_FAILURE() << "frame is incomplete";
+            return {};
+        }
+    }
+    return contents;
+}
+
+/* Cuts all inputs into 4 chunks of similar number of elements */
+static ZL_Report fourChunksSegmenterFn(ZL_Segmenter* sctx)
+{
+    size_t const nbChunks = 4;
+    size_t const nbInputs = ZL_Segmenter_numInputs(sctx);
+    std::vector<size_t> totalElts(nbInputs);
+    std::vector<size_t> numElts(nbInputs);
+    ZL_RET_R_IF_ERR(
+            ZL_Segmenter_getNumElts(sctx, totalElts.data(), nbInputs));
+    for (size_t c = 0; c < nbChunks; c++) {
+        for (size_t n = 0; n < nbInputs; n++) {
+            size_t const begin = totalElts[n] * c / nbChunks;
+            size_t const end   = totalElts[n] * (c + 1) / nbChunks;
+            numElts[n]         = end - begin;
+        }
+        ZL_RET_R_IF_ERR(ZL_Segmenter_processChunk(
+                sctx,
+                numElts.data(),
+                nbInputs,
+                ZL_GRAPH_COMPRESS_GENERIC,
+                NULL));
+    }
+    return ZL_returnSuccess();
+}
+
+static std::string compressSerialAndStrings(
+        const std::string& serial,
+        const std::string& strings,
+        const std::vector<uint32_t>& strLens,
+        bool withSerial)
+{
+    static ZL_Type const inputTypes[] = { ZL_Type_serial, ZL_Type_string };
+    size_t const nbInputs             = withSerial ? 2 : 1;
+
+    ZL_SegmenterDesc segDesc = {};
+    segDesc.name             = "four chunks";
+    segDesc.segmenterFn      = fourChunksSegmenterFn;
+    segDesc.inputTypeMasks   = inputTypes + 2 - nbInputs;
+    segDesc.numInputs        = nbInputs;
+    ZL_Compressor* const compressor = ZL_Compressor_create();
+    ZL_GraphID const segmenter =
+            ZL_Compressor_registerSegmenter(compressor, &segDesc);
+    EXPECT_TRUE(ZL_GraphID_isValid(segmenter));
+    EXPECT_FALSE(ZL_isError(
+            ZL_Compressor_selectStartingGraphID(compressor, segmenter)));
+    ZL_CCtx* const cctx = ZL_CCtx_create();
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_refCompressor(cctx, compressor)));
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION)));
+    // The seek table tells how many chunks were emitted
+    EXPECT_FALSE(ZL_isError(
+            ZL_CCtx_setParameter(cctx, ZL_CParam_seekTable, 1)));
+
+    ZL_TypedRef* const serialRef =
+            ZL_TypedRef_createSerial(serial.data(), serial.size());
+    ZL_TypedRef* const stringRef = ZL_TypedRef_createString(
+            strings.data(), strings.size(), strLens.data(), strLens.size());
+    const ZL_TypedRef* inputs[] = { serialRef, stringRef };
+    std::string compressed(
+            ZL_compressBound(serial.size() + strings.size() + 4 * strLens.size()),
+            '\0');
+    ZL_Report const cSize = ZL_CCtx_compressMultiTypedRef(
+            cctx,
+            &compressed[0],
+            compressed.size(),
+            inputs + 2 - nbInputs,
+            nbInputs);
+    EXPECT_FALSE(ZL_isError(cSize));
+    compressed.resize(ZL_isError(cSize) ? 0 : ZL_validResult(cSize));
+    ZL_TypedRef_free(serialRef);
+    ZL_TypedRef_free(stringRef);
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return compressed;
+}
+
+TEST(Stream, roundTrip)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const input = genInput(300000);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    for (int blockSize : { 1000, 64 << 10, 1 << 20 }) {
+        for (size_t inStep : { (size_t)1, (size_t)777, input.size() }) {
+            if (inStep == 1 && blockSize > 1000)
+                continue; // too slow
+            for (size_t outStep : { (size_t)1, (size_t)100, (size_t)1 << 20 }) {
+                if (outStep == 1 && inStep == 1)
+                    continue; // too slow
+                setStreamParams(cctx, blockSize, false);
+                std::string const compressed =
+                        compressStream(cctx, input, inStep, outStep);
+                ASSERT_GT(compressed.size(), 0u);
+                ZL_Report const cSize = ZL_getCompressedSize(
+                        compressed.data(), compressed.size());
+                ASSERT_FALSE(ZL_isError(cSize));
+                ASSERT_EQ(ZL_validResult(cSize), compressed.size());
+                ASSERT_EQ(decompress(compressed), input)
+                        << "blockSize=" << blockSize << ", inStep=" << inStep
+                        << ", outStep=" << outStep;
+            }
+        }
+    }
+    ZL_CCtx_free(cctx);
+}
+
+TEST(Stream, flush)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const input = genInput(100000);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    setStreamParams(cctx, 1 << 20, true);
+    // Each flush produces at least one chunk
+    std::string const compressed =
+            compressStream(cctx, input, 10000, 4096, ZL_FlushMode_flush);
+    ASSERT_EQ(decompress(compressed), input);
+    ZL_Report const nbChunks =
+            ZL_getNumChunks(compressed.data(), compressed.size());
+    ASSERT_FALSE(ZL_isError(nbChunks));
+    ASSERT_EQ(ZL_validResult(nbChunks), 10u);
+
+    // Flushing without new input doesn't produce anything
+    setStreamParams(cctx, 1 << 20, false);
+    std::string outBuff(1 << 20, '\0');
+    ZL_InBuffer in   = { input.data(), 1000, 0 };
+    ZL_OutBuffer out = { &outBuff[0], outBuff.size(), 0 };
+    ZL_Report r = ZL_CCtx_compressStream(cctx, &in, &out, ZL_FlushMode_flush);
+    ASSERT_FALSE(ZL_isError(r));
+    ASSERT_EQ(ZL_validResult(r), 0u);
+    ASSERT_EQ(in.pos, in.size);
+    size_t const flushedSize = out.pos;
+    r = ZL_CCtx_compressStream(cctx, &in, &out, ZL_FlushMode_flush);
+    ASSERT_FALSE(ZL_isError(r));
+    ASSERT_EQ(out.pos, flushedSize);
+    r = ZL_CCtx_compressStream(cctx, &in, &out, ZL_FlushMode_end);
+    ASSERT_FALSE(ZL_isError(r));
+    ASSERT_EQ(ZL_validResult(r), 0u);
+    outBuff.resize(out.pos);
+    ASSERT_EQ(decompress(outBuff), input.substr(0, 1000));
+    ZL_CCtx_free(cctx);
+}
+
+TEST(Stream, empty)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    ZL_CCtx* const cctx = ZL_CCtx_create();
+    for (size_t outStep : { (size_t)1, (size_t)1000 }) {
+        setStreamParams(cctx, 0, false);
+        std::string const compressed =
+                compressStream(cctx, std::string(), 1, outStep);
+        ASSERT_GT(compressed.size(), 0u);
+        ZL_Report const dSize =
+                ZL_getDecompressedSize(compressed.data(), compressed.size());
+        ASSERT_FALSE(ZL_isError(dSize));
+        ASSERT_EQ(ZL_validResult(dSize), 0u);
+        ASSERT_EQ(decompress(compressed), std::string());
+    }
+    ZL_CCtx_free(cctx);
+}
+
+TEST(Stream, contentSizeRequiresWholeFrame)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const input = genInput(50000);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    setStreamParams(cctx, 4096, false);
+    std::string const compressed =
+            compressStream(cctx, input, input.size(), 1 << 20);
+    ZL_CCtx_free(cctx);
+
+    // Truncated frame : content size can't be determined
+    std::string const truncated = compressed.substr(0, compressed.size() / 2);
+    ASSERT_TRUE(ZL_isError(
+            ZL_getDecompressedSize(truncated.data(), truncated.size())));
+    ZL_FrameInfo* const fi =
+            ZL_FrameInfo_create(truncated.data(), truncated.size());
+    ASSERT_NE(fi, nullptr);
+    ASSERT_TRUE(ZL_isError(ZL_FrameInfo_getDecompressedSize(fi, 0)));
+    ZL_FrameInfo_free(fi);
+
+    std::string decompressed(input.size(), '\0');
+    ASSERT_TRUE(ZL_isError(ZL_decompress(
+            &decompressed[0],
+            decompressed.size(),
+            truncated.data(),
+            truncated.size())));
+}
+
+TEST(Stream, parallelDecompressionAndRandomAccess)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    size_t const blockSize  = 10000;
+    std::string const input = genInput(25 * blockSize + 17);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    setStreamParams(cctx, (int)blockSize, true);
+    std::string const compressed = compressStream(cctx, input, 3333, 1 << 20);
+    ZL_CCtx_free(cctx);
+    ASSERT_EQ(decompress(compressed), input);
+
+    openzl::ThreadPool pool(3);
+    ZL_DCtx* const dctx            = ZL_DCtx_create();
+    ZL_WorkerPool const workerPool = pool.get();
+    ASSERT_FALSE(ZL_isError(
+            ZL_DCtx_setParameter(dctx, ZL_DParam_stickyParameters, 1)));
+    ASSERT_FALSE(ZL_isError(
+            ZL_DCtx_setParameter(dctx, ZL_DParam_nbWorkers, 4)));
+    ASSERT_FALSE(ZL_isError(ZL_DCtx_setWorkerPool(dctx, &workerPool)));
+    std::string decompressed(input.size(), '\0');
+    ZL_Report const r = ZL_DCtx_decompress(
+            dctx,
+            &decompressed[0],
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+    ASSERT_FALSE(ZL_isError(r));
+    ASSERT_EQ(decompressed, input);
+
+    // One chunk per block
+    ZL_Report const nbChunks =
+            ZL_getNumChunks(compressed.data(), compressed.size());
+    ASSERT_FALSE(ZL_isError(nbChunks));
+    ASSERT_EQ(ZL_validResult(nbChunks), 26u);
+    ZL_TypedBuffer* const tbuffer = ZL_TypedBuffer_create();
+    ZL_Report const range         = ZL_DCtx_decompressRange(
+            dctx,
+            tbuffer,
+            0,
+            3 * blockSize - 5,
+            5 * blockSize + 5,
+            compressed.data(),
+            compressed.size());
+    ASSERT_FALSE(ZL_isError(range));
+    ASSERT_EQ(
+            std::string(
+                    (const char*)ZL_TypedBuffer_rPtr(tbuffer),
+                    ZL_TypedBuffer_byteSize(tbuffer)),
+            input.substr(3 * blockSize - 5, 2 * blockSize + 10));
+    ZL_TypedBuffer_free(tbuffer);
+    ZL_DCtx_free(dctx);
+}
+
+TEST(Stream, errorAbandonsFrame)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN
+        || ZL_MIN_FORMAT_VERSION >= ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const input = genInput(5000);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    std::string outBuff(1 << 16, '\0');
+    // Streaming requires support for unknown content sizes
+    ASSERT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_formatVersion, ZL_UNKNOWN_SIZE_VERSION_MIN - 1)));
+    ZL_InBuffer in   = { input.data(), input.size(), 0 };
+    ZL_OutBuffer out = { &outBuff[0], outBuff.size(), 0 };
+    ASSERT_TRUE(ZL_isError(
+            ZL_CCtx_compressStream(cctx, &in, &out, ZL_FlushMode_end)));
+    ASSERT_EQ(out.pos, 0u);
+
+    // The next frame starts afresh
+    setStreamParams(cctx, 1000, false);
+    ASSERT_EQ(decompress(compressStream(cctx, input, 100, 100)), input);
+
+    // A frame can also be abandoned explicitly
+    setStreamParams(cctx, 1000, false);
+    in  = { input.data(), 2500, 0 };
+    out = { &outBuff[0], outBuff.size(), 0 };
+    ASSERT_FALSE(ZL_isError(
+            ZL_CCtx_compressStream(cctx, &in, &out, ZL_FlushMode_continue)));
+    ASSERT_FALSE(ZL_isError(ZL_CCtx_resetStream(cctx)));
+    ASSERT_EQ(decompress(compressStream(cctx, input, 100, 100)), input);
+    ZL_CCtx_free(cctx);
+}
+
+TEST(Stream, unknownSizeRequiresVersion)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN
+        || ZL_MIN_FORMAT_VERSION >= ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const input = genInput(5000);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    setStreamParams(cctx, 1000, false);
+    std::string compressed = compressStream(cctx, input, 100, 100);
+    ZL_CCtx_free(cctx);
+    ASSERT_EQ(decompress(compressed), input);
+
+    // Earlier chunked versions reserve unknown content sizes for a different
+    // chunk header layout: such frames must be rejected, not misread
+    uint32_t const magic = 0xD7B1A5C0 + (ZL_UNKNOWN_SIZE_VERSION_MIN - 1);
+    for (size_t n = 0; n < 4; n++) {
+        compressed[n] = (char)(uint8_t)(magic >> (8 * n));
+    }
+    std::string decompressed(input.size(), '\0');
+    ZL_Report const r = ZL_decompress(
+            &decompressed[0],
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+    ASSERT_TRUE(ZL_isError(r));
+    EXPECT_EQ(ZL_errorCode(r), ZL_ErrorCode_formatVersion_unsupported);
+}
+
+TEST(Stream, decompressStream)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const input = genInput(200000);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    ZL_DCtx* const dctx     = ZL_DCtx_create();
+    for (bool seekTable : { false, true }) {
+        setStreamParams(cctx, 10000, seekTable);
+        std::string const compressed =
+                compressStream(cctx, input, input.size(), 1 << 20);
+        for (size_t inStep : { (size_t)1, (size_t)97, compressed.size() }) {
+            for (size_t outStep : { (size_t)1, (size_t)4000, input.size() }) {
+                if (outStep == 1 && inStep == 1)
+                    continue; // too slow
+                size_t consumed = 0;
+                ASSERT_EQ(
+                        decompressStream(
+                                dctx, compressed, inStep, outStep, &consumed),
+                        input)
+                        << "seekTable=" << seekTable << ", inStep=" << inStep
+                        << ", outStep=" << outStep;
+                ASSERT_EQ(consumed, compressed.size());
+            }
+        }
+    }
+
+    // Frames of known content size, compressed in one pass
+    setStreamParams(cctx, 0, false);
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    ZL_Report const cSize = ZL_CCtx_compress(
+            cctx,
+            &compressed[0],
+            compressed.size(),
+            input.data(),
+            input.size());
+    ASSERT_FALSE(ZL_isError(cSize));
+    compressed.resize(ZL_validResult(cSize));
+    ASSERT_EQ(decompressStream(dctx, compressed, 1000, 1000), input);
+
+    // Concatenated frames are decoded one at a time
+    std::string const first = compressed;
+    setStreamParams(cctx, 3000, true);
+    std::string const second = compressStream(cctx, input, 5000, 1 << 20);
+    std::string const both   = first + second;
+    for (size_t inStep : { (size_t)333, both.size() }) {
+        std::string const tail = both.substr(first.size());
+        size_t consumed        = 0;
+        ASSERT_EQ(decompressStream(dctx, both, inStep, 7777, &consumed), input);
+        if (inStep == both.size()) {
+            ASSERT_EQ(consumed, first.size());
+        }
+        ASSERT_EQ(decompressStream(dctx, tail, inStep, 7777), input);
+    }
+    ZL_DCtx_free(dctx);
+    ZL_CCtx_free(cctx);
+}
+
+TEST(Stream, decompressStreamNumeric)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::vector<uint32_t> numbers(30000);
+    for (size_t n = 0; n < numbers.size(); n++) {
+        numbers[n] = (uint32_t)(n * 7 % 1000);
+    }
+    ZL_Compressor* const compressor = ZL_Compressor_create();
+    ASSERT_FALSE(ZL_isError(ZL_Compressor_selectStartingGraphID(
+            compressor, ZL_GRAPH_COMPRESS_GENERIC)));
+    ZL_CCtx* const cctx = ZL_CCtx_create();
+    ASSERT_FALSE(ZL_isError(ZL_CCtx_refCompressor(cctx, compressor)));
+    ASSERT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION)));
+    ZL_TypedRef* const tref = ZL_TypedRef_createNumeric(
+            numbers.data(), sizeof(numbers[0]), numbers.size());
+    std::string compressed(ZL_compressBound(numbers.size() * 4), '\0');
+    ZL_Report const cSize = ZL_CCtx_compressTypedRef(
+            cctx, &compressed[0], compressed.size(), tref);
+    ASSERT_FALSE(ZL_isError(cSize));
+    compressed.resize(ZL_validResult(cSize));
+    ZL_TypedRef_free(tref);
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+
+    // Content is emitted as raw bytes
+    ZL_DCtx* const dctx = ZL_DCtx_create();
+    std::string const decompressed = decompressStream(dctx, compressed, 50, 99);
+    ASSERT_EQ(decompressed.size(), numbers.size() * sizeof(numbers[0]));
+    ASSERT_EQ(memcmp(decompressed.data(), numbers.data(), decompressed.size()),
+              0);
+    ZL_DCtx_free(dctx);
+}
+
+TEST(Stream, decompressStreamErrors)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const input = genInput(50000);
+    ZL_CCtx* const cctx     = ZL_CCtx_create();
+    setStreamParams(cctx, 4096, false);
+    std::string const compressed =
+            compressStream(cctx, input, input.size(), 1 << 20);
+    ZL_CCtx_free(cctx);
+    ZL_DCtx* const dctx = ZL_DCtx_create();
+    std::string outBuff(input.size(), '\0');
+
+    // Truncated frame : never completes, but emits the chunks received
+    {
+        ZL_InBuffer in    = { compressed.data(), compressed.size() / 2, 0 };
+        ZL_OutBuffer out  = { &outBuff[0], outBuff.size(), 0 };
+        ZL_Report const r = ZL_DCtx_decompressStream(dctx, &in, &out);
+        ASSERT_FALSE(ZL_isError(r));
+        ASSERT_GE(ZL_validResult(r), 1u);
+        ASSERT_EQ(in.pos, in.size);
+        ASSERT_GT(out.pos, 0u);
+        ASSERT_EQ(std::string(outBuff.data(), out.pos),
+                  input.substr(0, out.pos));
+        ASSERT_FALSE(ZL_isError(ZL_DCtx_resetStream(dctx)));
+    }
+
+    // Corruption is detected, and abandons the frame
+    {
+        std::string corrupted = compressed;
+        corrupted[corrupted.size() / 2] ^= 0x5A;
+        ZL_InBuffer in   = { corrupted.data(), corrupted.size(), 0 };
+        ZL_OutBuffer out = { &outBuff[0], outBuff.size(), 0 };
+        ASSERT_TRUE(ZL_isError(ZL_DCtx_decompressStream(dctx, &in, &out)));
+    }
+    std::string garbage(1000, 'z');
+    ZL_InBuffer in   = { garbage.data(), garbage.size(), 0 };
+    ZL_OutBuffer out = { &outBuff[0], outBuff.size(), 0 };
+    ASSERT_TRUE(ZL_isError(ZL_DCtx_decompressStream(dctx, &in, &out)));
+
+    // The next frame starts afresh
+    ASSERT_EQ(decompressStream(dctx, compressed, 100, 100), input);
+    ZL_DCtx_free(dctx);
+}
+
+TEST(Stream, decompressStreamMulti)
+{
+    if (ZL_MAX_FORMAT_VERSION < ZL_UNKNOWN_SIZE_VERSION_MIN)
+        return;
+    std::string const serial = genInput(100000);
+    std::string strings;
+    std::vector<uint32_t> strLens;
+    for (size_t n = 0; n < 5000; n++) {
+        std::string const str = "key" + std::to_string(n * n % 1009);
+        strings += str;
+        strLens.push_back((uint32_t)str.size());
+    }
+    std::string const lensBytes(
+            (const char*)strLens.data(), strLens.size() * sizeof(uint32_t));
+    std::string const compressed =
+            compressSerialAndStrings(serial, strings, strLens, true);
+    ASSERT_GT(compressed.size(), 0u);
+    ZL_Report const nbChunks =
+            ZL_getNumChunks(compressed.data(), compressed.size());
+    ASSERT_FALSE(ZL_isError(nbChunks));
+    ASSERT_EQ(ZL_validResult(nbChunks), 4u);
+
+    // Each output is emitted as its chunks are decoded,
+    // String lengths separately from their content
+    ZL_DCtx* const dctx = ZL_DCtx_create();
+    for (size_t inStep : { (size_t)97, compressed.size() }) {
+        for (size_t outStep : { (size_t)7, (size_t)1000, (size_t)1 << 20 }) {
+            std::vector<std::string> lengths;
+            std::vector<std::string> const contents = decompressStreamMulti(
+                    dctx, compressed, 2, inStep, outStep, &lengths);
+            ASSERT_EQ(contents.size(), 2u);
+            ASSERT_EQ(contents[0], serial)
+                    << "inStep=" << inStep << ", outStep=" << outStep;
+            ASSERT_EQ(lengths[0], std::string());
+            ASSERT_EQ(contents[1], strings);
+            ASSERT_EQ(lengths[1], lensBytes);
+        }
+    }
+
+    // ZL_DCtx_decompressStream() only supports a single non-String output
+    std::string outBuff(1 << 20, '\0');
+    ZL_InBuffer in    = { compressed.data(), compressed.size(), 0 };
+    ZL_OutBuffer out  = { &outBuff[0], outBuff.size(), 0 };
+    ZL_Report const r = ZL_DCtx_decompressStream(dctx, &in, &out);
+    ASSERT_TRUE(ZL_isError(r));
+    EXPECT_EQ(ZL_errorCode(r), ZL_ErrorCode_userBuffers_invalidNum);
+
+    std::string const stringsOnly =
+            compressSerialAndStrings(serial, strings, strLens, false);
+    ASSERT_GT(stringsOnly.size(), 0u);
+    in                 = { stringsOnly.data(), stringsOnly.size(), 0 };
+    out                = { &outBuff[0], outBuff.size(), 0 };
+    ZL_Report const r2 = ZL_DCtx_decompressStream(dctx, &in, &out);
+    ASSERT_TRUE(ZL_isError(r2));
+    EXPECT_EQ(ZL_errorCode(r2), ZL_ErrorCode_parameter_invalid);
+    std::vector<std::string> lengths;
+    ASSERT_EQ(
+            decompressStreamMulti(dctx, stringsOnly, 1, 333, 100, &lengths),
+            std::vector<std::string>{ strings });
+    ASSERT_EQ(lengths[0], lensBytes);
+    ZL_DCtx_free(dctx);
+}
+
+} // namespace
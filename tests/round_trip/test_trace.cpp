@@ -0,0 +1,242 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <gtest/gtest.h>
+
+// standard C
+#include <string.h> // strlen, strstr
+
+// standard C++
+#include <set>
+#include <string>
+
+// Zstrong
+#include "openzl/codecs/zl_split_by_struct.h"
+#include "openzl/common/debug.h" // ZL_REQUIRE
+#include "openzl/cpp/ThreadPool.hpp"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_compressor.h"
+#include "openzl/zl_config.h" // ZL_ALLOW_INTROSPECTION
+#include "openzl/zl_decompress.h"
+#include "openzl/zl_trace.h"
+
+namespace {
+
+static ZL_GraphID splitGraph_traced(ZL_Compressor* cgraph) noexcept
+{
+    ZL_REQUIRE(!ZL_isError(ZL_Compressor_setParameter(
+            cgraph, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION)));
+    const size_t fieldSizes[]     = { 4, 2, 2, 4 };
+    const ZL_GraphID successors[] = { ZL_GRAPH_COMPRESS_GENERIC,
+                                      ZL_GRAPH_ZSTD,
+                                      ZL_GRAPH_COMPRESS_GENERIC,
+                                      ZL_GRAPH_ZSTD };
+    return ZL_Compressor_registerSplitByStructGraph(
+            cgraph, fieldSizes, successors, 4);
+}
+
+// structure size : 12
+static std::string genInput(uint32_t nbStructs)
+{
+    std::string input;
+    for (uint32_t n = 0; n < nbStructs; n++) {
+        uint32_t const fields[] = { n, n % 13, n / 7, n * n };
+        const size_t fieldSizes[] = { 4, 2, 2, 4 };
+        for (size_t f = 0; f < 4; f++) {
+            for (size_t b = 0; b < fieldSizes[f]; b++) {
+                input += (char)(fields[f] >> (8 * b));
+            }
+        }
+    }
+    return input;
+}
+
+static std::string compressTraced(
+        const std::string& input,
+        ZL_Tracer* tracer,
+        int nbWorkers,
+        openzl::ThreadPool* pool)
+{
+    ZL_Compressor* const compressor = ZL_Compressor_create();
+    ZL_CCtx* const cctx             = ZL_CCtx_create();
+    EXPECT_FALSE(ZL_isError(
+            ZL_Compressor_initUsingGraphFn(compressor, splitGraph_traced)));
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_refCompressor(cctx, compressor)));
+    EXPECT_FALSE(ZL_isError(
+            ZL_CCtx_setParameter(cctx, ZL_CParam_nbWorkers, nbWorkers)));
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        EXPECT_FALSE(ZL_isError(ZL_CCtx_setWorkerPool(cctx, &workerPool)));
+    }
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_setTracer(cctx, tracer)));
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    ZL_Report const r = ZL_CCtx_compress(
+            cctx,
+            &compressed[0],
+            compressed.size(),
+            input.data(),
+            input.size());
+    EXPECT_FALSE(ZL_isError(r)) << "compression failed \n";
+    compressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return compressed;
+}
+
+static std::string decompressTraced(
+        const std::string& compressed,
+        size_t dstCapacity,
+        ZL_Tracer* tracer)
+{
+    ZL_DCtx* const dctx = ZL_DCtx_create();
+    EXPECT_FALSE(ZL_isError(ZL_DCtx_setTracer(dctx, tracer)));
+    std::string decompressed(dstCapacity, '\0');
+    ZL_Report const r = ZL_DCtx_decompress(
+            dctx,
+            &decompressed[0],
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+    EXPECT_FALSE(ZL_isError(r)) << "decompression failed \n";
+    decompressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_DCtx_free(dctx);
+    return decompressed;
+}
+
+static void appendToString(void* opaque, const char* data, size_t size)
+{
+    static_cast<std::string*>(opaque)->append(data, size);
+}
+
+static size_t countEvents(const ZL_Tracer* tracer, ZL_TraceEventType type)
+{
+    size_t count = 0;
+    for (size_t n = 0; n < ZL_Tracer_nbEvents(tracer); n++) {
+        count += ZL_Tracer_getEvent(tracer, n)->type == type;
+    }
+    return count;
+}
+
+class TraceTest : public testing::Test {
+   protected:
+    void SetUp() override
+    {
+        if (!ZL_ALLOW_INTROSPECTION) {
+            GTEST_SKIP() << "Tracing requires ZL_ALLOW_INTROSPECTION";
+        }
+    }
+};
+
+TEST_F(TraceTest, recordsEncodeAndDecodeEvents)
+{
+    std::string const input = genInput(2000);
+    ZL_Tracer* const tracer = ZL_Tracer_create(0);
+    ASSERT_NE(tracer, nullptr);
+
+    std::string const compressed = compressTraced(input, tracer, 0, nullptr);
+    ASSERT_GT(compressed.size(), 0u);
+    size_t const nbEncodes = countEvents(tracer, ZL_TraceEventType_codecEncode);
+    EXPECT_GT(nbEncodes, 0u);
+    EXPECT_GT(countEvents(tracer, ZL_TraceEventType_graphEncode), 0u);
+    EXPECT_EQ(countEvents(tracer, ZL_TraceEventType_codecDecode), 0u);
+
+    ASSERT_EQ(decompressTraced(compressed, input.size(), tracer), input);
+    EXPECT_GT(countEvents(tracer, ZL_TraceEventType_codecDecode), 0u);
+    EXPECT_EQ(countEvents(tracer, ZL_TraceEventType_codecEncode), nbEncodes);
+    EXPECT_EQ(ZL_Tracer_nbDroppedEvents(tracer), 0u);
+
+    size_t splitIn = 0;
+    for (size_t n = 0; n < ZL_Tracer_nbEvents(tracer); n++) {
+        const ZL_TraceEvent* const e = ZL_Tracer_getEvent(tracer, n);
+        EXPECT_LE(e->startNs, e->endNs);
+        EXPECT_GT(strlen(e->name), 0u);
+        if (e->type == ZL_TraceEventType_codecEncode
+            && strstr(e->name, "split_by_struct") != nullptr) {
+            splitIn += e->bytesIn;
+        }
+    }
+    // The whole input goes through the split_by_struct codec
+    EXPECT_EQ(splitIn, input.size());
+
+    std::string json;
+    ASSERT_FALSE(ZL_isError(
+            ZL_Tracer_exportChromeTrace(tracer, appendToString, &json)));
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"cat\":\"codecDecode\""), std::string::npos);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+
+    std::string summary;
+    ASSERT_FALSE(ZL_isError(
+            ZL_Tracer_exportSummary(tracer, appendToString, &summary)));
+    EXPECT_NE(summary.find("codecEncode"), std::string::npos);
+    EXPECT_NE(summary.find("codecDecode"), std::string::npos);
+    EXPECT_NE(summary.find("graphEncode"), std::string::npos);
+
+    ZL_Tracer_reset(tracer);
+    EXPECT_EQ(ZL_Tracer_nbEvents(tracer), 0u);
+    ZL_Tracer_free(tracer);
+}
+
+TEST_F(TraceTest, fullRingKeepsNewestEvents)
+{
+    std::string const input = genInput(2000);
+    ZL_Tracer* const tracer = ZL_Tracer_create(2);
+    ASSERT_NE(tracer, nullptr);
+    compressTraced(input, tracer, 0, nullptr);
+    ASSERT_EQ(ZL_Tracer_nbEvents(tracer), 2u);
+    EXPECT_GT(ZL_Tracer_nbDroppedEvents(tracer), 0u);
+    // Events are ordered by completion within a ring
+    EXPECT_LE(
+            ZL_Tracer_getEvent(tracer, 0)->endNs,
+            ZL_Tracer_getEvent(tracer, 1)->endNs);
+    EXPECT_EQ(ZL_Tracer_getEvent(tracer, 2), nullptr);
+    ZL_Tracer_free(tracer);
+}
+
+TEST_F(TraceTest, workersRecordIntoTheirOwnRings)
+{
+    std::string const input     = genInput(5000);
+    std::string const reference = compressTraced(input, nullptr, 0, nullptr);
+    ASSERT_GT(reference.size(), 0u);
+
+    ZL_Tracer* const tracer = ZL_Tracer_create(0);
+    ASSERT_NE(tracer, nullptr);
+    openzl::ThreadPool pool(3);
+    // Tracing doesn't influence compression
+    ASSERT_EQ(compressTraced(input, tracer, 4, &pool), reference);
+
+    std::set<unsigned> ringIDs;
+    for (size_t n = 0; n < ZL_Tracer_nbEvents(tracer); n++) {
+        ringIDs.insert(ZL_Tracer_getEvent(tracer, n)->ringID);
+    }
+    EXPECT_GT(ringIDs.size(), 1u);
+    ZL_Tracer_free(tracer);
+}
+
+} // namespace
+
+TEST_F(TraceTest, ringsAreReusedByLaterContexts)
+{
+    std::string const input = genInput(5000);
+    ZL_Tracer* const tracer = ZL_Tracer_create(0);
+    ASSERT_NE(tracer, nullptr);
+    openzl::ThreadPool pool(3);
+
+    const auto countRings = [tracer] {
+        std::set<unsigned> ringIDs;
+        for (size_t n = 0; n < ZL_Tracer_nbEvents(tracer); n++) {
+            ringIDs.insert(ZL_Tracer_getEvent(tracer, n)->ringID);
+        }
+        return ringIDs.size();
+    };
+    std::string const compressed = compressTraced(input, tracer, 4, &pool);
+    size_t const nbRings         = countRings();
+    size_t const nbEvents        = ZL_Tracer_nbEvents(tracer);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(compressTraced(input, tracer, 4, &pool), compressed);
+    }
+    // Each context released its rings, and later contexts reused them
+    EXPECT_EQ(countRings(), nbRings);
+    EXPECT_EQ(ZL_Tracer_nbEvents(tracer), 11 * nbEvents);
+    ZL_Tracer_free(tracer);
+}
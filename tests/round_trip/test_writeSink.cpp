@@ -0,0 +1,215 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <gtest/gtest.h>
+
+// standard C++
+#include <string>
+#include <vector>
+
+// OpenZL
+#include "openzl/codecs/zl_generic.h"
+#include "openzl/codecs/zl_store.h"
+#include "openzl/cpp/ThreadPool.hpp"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_compressor.h"
+#include "openzl/zl_decompress.h"
+#include "openzl/zl_segmenter.h"
+#include "openzl/zl_version.h"
+
+namespace {
+
+#define SINK_CHUNKSIZE (64 << 10)
+
+static ZL_Report fixedSizeSegmenterFn(ZL_Segmenter* sctx)
+{
+    size_t remaining;
+    ZL_RET_R_IF_ERR(ZL_Segmenter_getNumElts(sctx, &remaining, 1));
+    while (remaining > 0) {
+        size_t chunkSize =
+                (remaining < SINK_CHUNKSIZE) ? remaining : SINK_CHUNKSIZE;
+        ZL_RET_R_IF_ERR(ZL_Segmenter_processChunk(
+                sctx, &chunkSize, 1, ZL_GRAPH_COMPRESS_GENERIC, NULL));
+        remaining -= chunkSize;
+    }
+    return ZL_returnSuccess();
+}
+
+static ZL_SegmenterDesc const fixedSizeSegmenter = {
+    .name           = "Sink Test Segmenter",
+    .segmenterFn    = fixedSizeSegmenterFn,
+    .inputTypeMasks = (const ZL_Type[]){ ZL_Type_serial },
+    .numInputs      = 1,
+};
+
+static ZL_Report segmentedGraph(ZL_Compressor* compressor)
+{
+    ZL_RET_R_IF_ERR(ZL_Compressor_setParameter(
+            compressor, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION));
+    ZL_GraphID const graph =
+            ZL_Compressor_registerSegmenter(compressor, &fixedSizeSegmenter);
+    ZL_RET_R_IF(graph_invalid, !ZL_GraphID_isValid(graph));
+    return ZL_Compressor_selectStartingGraphID(compressor, graph);
+}
+
+// Older versions checksum the entire frame, including its header
+static ZL_Report storeGraph_oldVersion(ZL_Compressor* compressor)
+{
+    ZL_RET_R_IF_ERR(ZL_Compressor_setParameter(
+            compressor, ZL_CParam_formatVersion, ZL_MIN_FORMAT_VERSION));
+    return ZL_Compressor_selectStartingGraphID(compressor, ZL_GRAPH_STORE);
+}
+
+struct Segments {
+    std::string frame;
+    size_t nbSegments = 0;
+    bool fail         = false;
+};
+
+static int writeSegment(void* opaque, const void* src, size_t size)
+{
+    Segments* const segments = static_cast<Segments*>(opaque);
+    if (segments->fail)
+        return 1;
+    segments->frame.append(static_cast<const char*>(src), size);
+    segments->nbSegments++;
+    return 0;
+}
+
+struct Setup {
+    ZL_Report (*graphFn)(ZL_Compressor* compressor);
+    int nbWorkers;
+    bool seekTable;
+};
+
+static ZL_CCtx* createCCtx(
+        ZL_Compressor* compressor,
+        const Setup& setup,
+        openzl::ThreadPool* pool)
+{
+    ZL_CCtx* const cctx = ZL_CCtx_create();
+    EXPECT_FALSE(ZL_isError(setup.graphFn(compressor)));
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_refCompressor(cctx, compressor)));
+    EXPECT_FALSE(ZL_isError(
+            ZL_CCtx_setParameter(cctx, ZL_CParam_nbWorkers, setup.nbWorkers)));
+    EXPECT_FALSE(ZL_isError(ZL_CCtx_setParameter(
+            cctx,
+            ZL_CParam_seekTable,
+            setup.seekTable ? ZL_TernaryParam_enable
+                            : ZL_TernaryParam_disable)));
+    if (pool != nullptr) {
+        ZL_WorkerPool const workerPool = pool->get();
+        EXPECT_FALSE(ZL_isError(ZL_CCtx_setWorkerPool(cctx, &workerPool)));
+    }
+    return cctx;
+}
+
+static std::string compressContiguous(
+        const std::string& input,
+        const Setup& setup,
+        openzl::ThreadPool* pool)
+{
+    ZL_Compressor* const compressor = ZL_Compressor_create();
+    ZL_CCtx* const cctx             = createCCtx(compressor, setup, pool);
+    ZL_TypedRef* const tref =
+            ZL_TypedRef_createSerial(input.data(), input.size());
+    const ZL_TypedRef* inputs[] = { tref };
+    std::string compressed(ZL_compressBound(input.size()), '\0');
+    ZL_Report const r = ZL_CCtx_compressMultiTypedRef(
+            cctx, &compressed[0], compressed.size(), inputs, 1);
+    EXPECT_FALSE(ZL_isError(r)) << "compression failed \n";
+    compressed.resize(ZL_isError(r) ? 0 : ZL_validResult(r));
+    ZL_TypedRef_free(tref);
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return compressed;
+}
+
+static ZL_Report compressToSink(
+        Segments* segments,
+        const std::string& input,
+        const Setup& setup,
+        openzl::ThreadPool* pool)
+{
+    ZL_Compressor* const compressor = ZL_Compressor_create();
+    ZL_CCtx* const cctx             = createCCtx(compressor, setup, pool);
+    ZL_TypedRef* const tref =
+            ZL_TypedRef_createSerial(input.data(), input.size());
+    const ZL_TypedRef* inputs[] = { tref };
+    ZL_WriteSink const sink     = { writeSegment, segments };
+    ZL_Report const r =
+            ZL_CCtx_compressMultiTypedRefToSink(cctx, &sink, inputs, 1);
+    ZL_TypedRef_free(tref);
+    ZL_CCtx_free(cctx);
+    ZL_Compressor_free(compressor);
+    return r;
+}
+
+static std::string genInput(size_t size)
+{
+    std::string input;
+    for (size_t n = 0; input.size() < size; n++) {
+        input += "line " + std::to_string(n * n % 1009) + ", value "
+                + std::to_string(n) + "\n";
+    }
+    return input;
+}
+
+static void testSink(const std::string& input, const Setup& setup)
+{
+    openzl::ThreadPool pool(3);
+    openzl::ThreadPool* const poolPtr = setup.nbWorkers ? &pool : nullptr;
+    std::string const reference = compressContiguous(input, setup, poolPtr);
+    ASSERT_GT(reference.size(), 0u);
+
+    Segments segments;
+    ZL_Report const r = compressToSink(&segments, input, setup, poolPtr);
+    ASSERT_FALSE(ZL_isError(r));
+    ASSERT_EQ(ZL_validResult(r), reference.size());
+    // Output must be byte-identical to the contiguous frame
+    ASSERT_EQ(segments.frame, reference);
+    // Large buffers are written directly
+    EXPECT_GT(segments.nbSegments, 1u);
+
+    std::string decompressed(input.size(), '\0');
+    ZL_Report const d = ZL_decompress(
+            &decompressed[0],
+            decompressed.size(),
+            segments.frame.data(),
+            segments.frame.size());
+    ASSERT_FALSE(ZL_isError(d));
+    ASSERT_EQ(decompressed, input);
+}
+
+TEST(WriteSink, singleChunk)
+{
+    testSink(genInput(100000), { storeGraph_oldVersion, 0, false });
+}
+
+TEST(WriteSink, multipleChunks)
+{
+    std::string const input = genInput(20 * SINK_CHUNKSIZE + 123);
+    testSink(input, { segmentedGraph, 0, false });
+    testSink(input, { segmentedGraph, 0, true });
+}
+
+TEST(WriteSink, parallelChunks)
+{
+    std::string const input = genInput(20 * SINK_CHUNKSIZE + 123);
+    testSink(input, { segmentedGraph, 4, false });
+    testSink(input, { segmentedGraph, 4, true });
+}
+
+TEST(WriteSink, writeFailure)
+{
+    Segments segments;
+    segments.fail = true;
+    ZL_Report const r = compressToSink(
+            &segments,
+            genInput(100000),
+            { segmentedGraph, 0, false },
+            nullptr);
+    ASSERT_TRUE(ZL_isError(r));
+    EXPECT_EQ(segments.nbSegments, 0u);
+}
+
+} // namespace
@@ -0,0 +1,174 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "openzl/codecs/bitpack/common_bitpack_kernel.h"
+#include "openzl/codecs/delta/decode_delta_kernel.h"
+#include "openzl/codecs/transpose/decode_transpose_kernel.h"
+#include "openzl/codecs/transpose/encode_transpose_kernel.h"
+#include "openzl/shared/cpu.h"
+
+using namespace ::testing;
+
+namespace openzl {
+namespace tests {
+
+class CpuTest : public Test {
+   protected:
+    void TearDown() override
+    {
+        ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+    }
+
+    /// Runs @p fn once per dispatch level, and checks that all levels
+    /// produce the same output as the scalar code paths.
+    template <typename Fn>
+    void checkAllLevels(Fn fn)
+    {
+        unsigned const levels[] = {
+            ZL_CpuFeature_ssse3,
+            ZL_CpuFeature_ssse3 | ZL_CpuFeature_sse42 | ZL_CpuFeature_bmi2,
+            ZL_CPU_FEATURES_ALL,
+        };
+        ZL_cpuFeatures_setMask(0);
+        auto const expected = fn();
+        for (unsigned const level : levels) {
+            ZL_cpuFeatures_setMask(level);
+            EXPECT_EQ(fn(), expected) << "feature mask " << level;
+        }
+        ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+    }
+
+    std::vector<uint8_t> genBytes(size_t size, uint32_t seed) const
+    {
+        std::mt19937 gen(seed);
+        std::vector<uint8_t> data(size);
+        for (auto& b : data) {
+            b = (uint8_t)gen();
+        }
+        return data;
+    }
+};
+
+TEST_F(CpuTest, DetectionIsConsistent)
+{
+    unsigned const detected = ZL_cpuFeatures_detect();
+    EXPECT_EQ(detected & ~ZL_CPU_FEATURES_ALL, 0u);
+    EXPECT_EQ(ZL_cpuFeatures(), detected);
+    EXPECT_EQ(ZL_cpuFeatures_detect(), detected);
+    // Features enabled for the whole build must be supported
+    if (ZL_HAS_AVX2) {
+        EXPECT_TRUE(ZL_cpuHas(ZL_CpuFeature_avx2));
+    }
+    if (ZL_HAS_BMI2) {
+        EXPECT_TRUE(ZL_cpuHas(ZL_CpuFeature_bmi2));
+    }
+    if (ZL_HAS_PCLMUL) {
+        EXPECT_TRUE(ZL_cpuHas(ZL_CpuFeature_pclmul));
+    }
+}
+
+TEST_F(CpuTest, MaskRestrictsFeatures)
+{
+    unsigned const detected = ZL_cpuFeatures_detect();
+    ZL_cpuFeatures_setMask(0);
+    EXPECT_EQ(ZL_cpuFeatures(), 0u);
+    EXPECT_TRUE(ZL_cpuHas(0));
+    EXPECT_FALSE(ZL_cpuHas(ZL_CpuFeature_ssse3));
+
+    ZL_cpuFeatures_setMask(ZL_CpuFeature_sse42 | ZL_CpuFeature_avx2);
+    EXPECT_EQ(
+            ZL_cpuFeatures(),
+            detected & (ZL_CpuFeature_sse42 | ZL_CpuFeature_avx2));
+    EXPECT_FALSE(ZL_cpuHas(ZL_CpuFeature_sse42 | ZL_CpuFeature_bmi2));
+
+    ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+    EXPECT_EQ(ZL_cpuFeatures(), detected);
+}
+
+TEST_F(CpuTest, BitpackMatchesScalar)
+{
+    size_t const nbElts           = 1000;
+    std::vector<uint8_t> const in = genBytes(nbElts * 8, 1);
+    for (int nbBits = 1; nbBits <= 64; ++nbBits) {
+        std::vector<uint64_t> src(nbElts);
+        memcpy(src.data(), in.data(), in.size());
+        for (auto& v : src) {
+            v &= (~(uint64_t)0) >> (64 - nbBits);
+        }
+        size_t const eltWidth = nbBits <= 8 ? 1
+                : nbBits <= 16              ? 2
+                : nbBits <= 32              ? 4
+                                            : 8;
+        std::vector<uint8_t> narrow(nbElts * eltWidth);
+        for (size_t i = 0; i < nbElts; ++i) {
+            memcpy(&narrow[i * eltWidth], &src[i], eltWidth);
+        }
+        std::vector<uint8_t> packed(ZS_bitpackEncodeBound(nbElts, nbBits));
+        checkAllLevels([&] {
+            std::vector<uint8_t> out(packed.size());
+            ZS_bitpackEncode(
+                    out.data(),
+                    out.size(),
+                    narrow.data(),
+                    nbElts,
+                    eltWidth,
+                    nbBits);
+            packed = out;
+            return out;
+        });
+        checkAllLevels([&] {
+            std::vector<uint8_t> out(narrow.size());
+            ZS_bitpackDecode(
+                    out.data(),
+                    nbElts,
+                    eltWidth,
+                    packed.data(),
+                    packed.size(),
+                    nbBits);
+            return out;
+        });
+    }
+}
+
+TEST_F(CpuTest, TransposeMatchesScalar)
+{
+    for (size_t const eltWidth : { 2, 4, 8 }) {
+        size_t const nbElts           = 1027;
+        std::vector<uint8_t> const in = genBytes(nbElts * eltWidth, 2);
+        checkAllLevels([&] {
+            std::vector<uint8_t> out(in.size());
+            ZS_transposeEncode(out.data(), in.data(), nbElts, eltWidth);
+            return out;
+        });
+        checkAllLevels([&] {
+            std::vector<uint8_t> out(in.size());
+            ZS_transposeDecode(out.data(), in.data(), nbElts, eltWidth);
+            return out;
+        });
+    }
+}
+
+TEST_F(CpuTest, DeltaDecodeMatchesScalar)
+{
+    for (size_t const eltWidth : { 1, 2, 4, 8 }) {
+        size_t const nbElts               = 1027;
+        std::vector<uint8_t> const deltas = genBytes(nbElts * eltWidth, 3);
+        checkAllLevels([&] {
+            std::vector<uint8_t> out(nbElts * eltWidth);
+            ZS_deltaDecode(
+                    out.data(),
+                    deltas.data(),
+                    deltas.data() + eltWidth,
+                    nbElts,
+                    eltWidth);
+            return out;
+        });
+    }
+}
+
+} // namespace tests
+} // namespace openzl
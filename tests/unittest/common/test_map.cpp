@@ -1,6 +1,8 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
+#include <cstring>
 #include <random>
+#include <set>
 #include <unordered_map>
 
 #include "openzl/common/map.h"
@@ -73,13 +75,28 @@ TEST(MapTest, Reserve)
     }
 }
 
+TEST(MapTest, ReserveZeroDoesNotAllocate)
+{
+    for (int guaranteeNoAllocations = 0; guaranteeNoAllocations <= 1;
+         ++guaranteeNoAllocations) {
+        TestMap map = TestMap_create(kDefaultMaxCapacity);
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(TestMap_reserve(&map, 0, !!guaranteeNoAllocations));
+            ASSERT_EQ(map.table_.table, nullptr);
+            ASSERT_EQ(map.table_.spare, nullptr);
+            ASSERT_EQ(TestMap_capacity(&map), 0u);
+        }
+        TestMap_destroy(&map);
+    }
+}
+
 TEST(MapTest, ReserveGuaranteeToAllocations)
 {
     size_t constexpr kCapacity = 10;
     TestMap map                = TestMap_create(kDefaultMaxCapacity);
     ASSERT_TRUE(TestMap_reserve(&map, kCapacity, true));
     void const* tablePtr = map.table_.table;
-    void const* chainPtr = map.table_.chain;
+    void const* sparePtr = map.table_.spare;
 
     std::mt19937 gen(0xdeadbeef);
     std::uniform_int_distribution<int> dist;
@@ -108,7 +125,7 @@ TEST(MapTest, ReserveGuaranteeToAllocations)
     }
 
     ASSERT_EQ(tablePtr, map.table_.table);
-    ASSERT_EQ(chainPtr, map.table_.chain);
+    ASSERT_EQ(sparePtr, map.table_.spare);
 
     TestMap_destroy(&map);
 }
@@ -468,6 +485,30 @@ TEST(MapTest, CustomMap)
     TestCustomMap_destroy(&map);
 }
 
+TEST(MapTest, HashIntMixesHighBits)
+{
+    // Keys which only differ in their high bits must still get different
+    // control bytes and different groups
+    auto const checkSpread = [](auto const& genKey) {
+        std::set<uint8_t> h2s;
+        std::set<size_t> groups;
+        for (uint64_t i = 0; i < 1024; ++i) {
+            size_t const hash = ZL_Table_hashInt(genKey(i));
+            h2s.insert(SwissTable_h2(hash));
+            groups.insert(SwissTable_h1(hash) & 1023);
+        }
+        EXPECT_EQ(h2s.size(), 128u);
+        EXPECT_GT(groups.size(), 512u);
+    };
+    checkSpread([](uint64_t i) { return i << 40; });
+    checkSpread([](uint64_t i) {
+        double const d = (double)i;
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        return bits;
+    });
+}
+
 TEST(MapTest, CreateInArena)
 {
     Arena* arena = ALLOC_HeapArena_create();
@@ -482,3 +523,88 @@ TEST(MapTest, CreateInArena)
 
     ALLOC_Arena_freeArena(arena);
 }
+
+ZL_DECLARE_MAP_TYPE_WITH_IMPL(ChainedMap, uint64_t, int, GenericTable);
+ZL_DECLARE_MAP_TYPE_WITH_IMPL(SwissMap, uint64_t, int, SwissTable);
+
+namespace {
+#define DECLARE_MAP_OPS(Map)                                               \
+    struct Map##Ops {                                                      \
+        using Type = Map;                                                  \
+        static Map create(uint32_t maxCapacity)                            \
+        {                                                                  \
+            return Map##_create(maxCapacity);                              \
+        }                                                                  \
+        static void destroy(Map* map)                                      \
+        {                                                                  \
+            Map##_destroy(map);                                            \
+        }                                                                  \
+        static size_t size(Map const* map)                                 \
+        {                                                                  \
+            return Map##_size(map);                                        \
+        }                                                                  \
+        static bool reserve(Map* map, uint32_t capacity)                   \
+        {                                                                  \
+            return Map##_reserve(map, capacity, true);                     \
+        }                                                                  \
+        static Map##_Entry const* find(Map const* map, uint64_t key)       \
+        {                                                                  \
+            return Map##_findVal(map, key);                                \
+        }                                                                  \
+        static bool erase(Map* map, uint64_t key)                          \
+        {                                                                  \
+            return Map##_eraseVal(map, key);                               \
+        }                                                                  \
+        static Map##_Insert insert(Map* map, uint64_t key, int val)        \
+        {                                                                  \
+            return Map##_insertVal(map, { key, val });                     \
+        }                                                                  \
+    }
+
+DECLARE_MAP_OPS(ChainedMap);
+DECLARE_MAP_OPS(SwissMap);
+
+template <typename Ops>
+void testRandomOps(uint64_t keyRange, bool guaranteeNoAllocations)
+{
+    typename Ops::Type map = Ops::create(kDefaultMaxCapacity);
+    std::unordered_map<uint64_t, int> expected;
+    std::mt19937 gen(0xdeadbeef);
+    if (guaranteeNoAllocations) {
+        ASSERT_TRUE(Ops::reserve(&map, (uint32_t)keyRange));
+    }
+    for (int i = 0; i < 20000; ++i) {
+        // Keys with identical low bits stress the control bytes
+        uint64_t const key = (gen() % keyRange) << 7;
+        if (gen() % 3 == 0) {
+            ASSERT_EQ(Ops::erase(&map, key), expected.erase(key) == 1);
+        } else {
+            auto const insert         = Ops::insert(&map, key, i);
+            auto const [it, inserted] = expected.emplace(key, i);
+            ASSERT_FALSE(insert.badAlloc);
+            ASSERT_EQ(insert.inserted, inserted);
+            ASSERT_EQ(insert.ptr->val, it->second);
+        }
+        ASSERT_EQ(Ops::size(&map), expected.size());
+    }
+    for (uint64_t k = 0; k < keyRange; ++k) {
+        auto const* entry = Ops::find(&map, k << 7);
+        auto const it     = expected.find(k << 7);
+        ASSERT_EQ(entry != nullptr, it != expected.end());
+        if (entry != nullptr) {
+            ASSERT_EQ(entry->val, it->second);
+        }
+    }
+    Ops::destroy(&map);
+}
+} // namespace
+
+TEST(MapTest, RandomOpsOnBothImplementations)
+{
+    for (uint64_t const keyRange : { 10, 100, 5000 }) {
+        for (bool const guarantee : { false, true }) {
+            testRandomOps<ChainedMapOps>(keyRange, guarantee);
+            testRandomOps<SwissMapOps>(keyRange, guarantee);
+        }
+    }
+}
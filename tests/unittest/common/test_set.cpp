@@ -411,18 +411,18 @@ TEST(SetTest, SmallCapacityLimit)
     TestSet set = TestSet_create(10);
     ASSERT_TRUE(TestSet_reserve(&set, 10, /* guaranteeNoAllocations */ true));
     const size_t capacity      = TestSet_capacity(&set);
-    const size_t chainCapacity = set.table_.chainCapacity;
+    void const* const tablePtr = set.table_.table;
 
     for (size_t offset = 0; offset < 100; ++offset) {
         for (size_t i = 0; i < 10; ++i) {
             ASSERT_EQ(TestSet_insertVal(&set, i + offset).inserted, true);
         }
         ASSERT_EQ(TestSet_capacity(&set), capacity);
-        ASSERT_EQ(set.table_.chainCapacity, chainCapacity);
+        ASSERT_EQ(set.table_.table, tablePtr);
         TestSet_clear(&set);
     }
     ASSERT_EQ(TestSet_capacity(&set), capacity);
-    ASSERT_EQ(set.table_.chainCapacity, chainCapacity);
+    ASSERT_EQ(set.table_.table, tablePtr);
 
     TestSet_destroy(&set);
 }
@@ -432,12 +432,12 @@ TEST(SetTest, TinyCapacityLimit)
     TestSet set = TestSet_create(1);
     ASSERT_TRUE(TestSet_reserve(&set, 1, /* guaranteeNoAllocations */ true));
     const size_t capacity      = TestSet_capacity(&set);
-    const size_t chainCapacity = set.table_.chainCapacity;
+    void const* const tablePtr = set.table_.table;
 
     ASSERT_EQ(TestSet_insertVal(&set, 0).inserted, true);
 
     ASSERT_EQ(TestSet_capacity(&set), capacity);
-    ASSERT_EQ(set.table_.chainCapacity, chainCapacity);
+    ASSERT_EQ(set.table_.table, tablePtr);
 
     TestSet_destroy(&set);
 }
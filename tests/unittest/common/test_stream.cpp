@@ -111,6 +111,57 @@ TEST(Stream, copyString)
     STREAM_free(dst);
 }
 
+TEST(Stream, refStringSlice)
+{
+    ZL_Data* const src = STREAM_create(kZeroID);
+    ZL_REQUIRE_SUCCESS(STREAM_reserve(src, ZL_Type_string, 1, 14));
+    uint32_t* const srcLens = ZL_Data_reserveStringLens(src, 4);
+    ASSERT_NE(srcLens, nullptr);
+    memcpy(ZL_Data_wPtr(src), "abcdefghijklmn", 14);
+    srcLens[0] = 3;
+    srcLens[1] = 5;
+    srcLens[2] = 2;
+    srcLens[3] = 4;
+    ZL_REQUIRE_SUCCESS(ZL_Data_commit(src, 4));
+
+    ZL_Data* const slice = STREAM_create(kOneID);
+    ZL_REQUIRE_SUCCESS(STREAM_refStreamSliceWithoutRefCount(slice, src, 1, 2));
+
+    // Both the content and the lengths start at the first selected string
+    ASSERT_EQ(ZL_Data_numElts(slice), 2u);
+    ASSERT_EQ(ZL_Data_contentSize(slice), 7u);
+    ASSERT_EQ(memcmp(ZL_Data_rPtr(slice), "defghij", 7), 0);
+    const uint32_t* const lens = ZL_Data_rStringLens(slice);
+    ASSERT_EQ(lens[0], 5u);
+    ASSERT_EQ(lens[1], 2u);
+
+    STREAM_free(slice);
+    STREAM_free(src);
+}
+
+TEST(Stream, appendStrings)
+{
+    ZL_Data* const s = STREAM_create(kZeroID);
+    ZL_REQUIRE_SUCCESS(STREAM_reserve(s, ZL_Type_string, 1, 20));
+    uint32_t* const lens = ZL_Data_reserveStringLens(s, 4);
+    ASSERT_NE(lens, nullptr);
+    lens[0] = 5;
+    lens[1] = 10;
+    ZL_REQUIRE_SUCCESS(ZL_Data_commit(s, 2));
+
+    // Strings committed later are appended after the previous ones
+    lens[2] = 3;
+    ZL_REQUIRE_SUCCESS(ZL_Data_commit(s, 1));
+    ASSERT_EQ(ZL_Data_numElts(s), 3u);
+    ASSERT_EQ(ZL_Data_contentSize(s), 18u);
+
+    // Only the remaining capacity is available
+    lens[3] = 3;
+    ASSERT_TRUE(ZL_isError(ZL_Data_commit(s, 1)));
+
+    STREAM_free(s);
+}
+
 TEST(Stream, refStream)
 {
     ZL_Data* const ref = STREAM_create(kZeroID);
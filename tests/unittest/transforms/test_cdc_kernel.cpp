@@ -0,0 +1,261 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "openzl/codecs/dedup/decode_cdc_kernel.h"
+#include "openzl/codecs/dedup/encode_cdc_kernel.h"
+#include "openzl/shared/cpu.h"
+
+namespace zstrong {
+namespace tests {
+namespace {
+
+class CdcKernelTest : public testing::Test {
+   protected:
+    void TearDown() override
+    {
+        ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+    }
+
+    std::vector<uint8_t> random(size_t size)
+    {
+        std::uniform_int_distribution<int> dist(0, 255);
+        std::vector<uint8_t> data(size);
+        for (auto& x : data) {
+            x = (uint8_t)dist(gen_);
+        }
+        return data;
+    }
+
+    std::vector<uint64_t> candidates(
+            std::vector<uint8_t> const& data,
+            ZS_CdcParams const& params)
+    {
+        std::vector<uint64_t> cand(ZS_cdcCandidatesWords(data.size()));
+        ZS_cdcFindCandidates(
+                cand.data(), data.data(), data.size(), params.maskBits);
+        return cand;
+    }
+
+    /// @returns the end of each chunk
+    std::vector<size_t> chunk(
+            std::vector<uint8_t> const& data,
+            ZS_CdcParams const& params)
+    {
+        auto const cand = candidates(data, params);
+        std::vector<size_t> ends;
+        for (size_t start = 0; start < data.size();) {
+            start = ZS_cdcNextBoundary(
+                    cand.data(), start, data.size(), &params);
+            ends.push_back(start);
+        }
+        return ends;
+    }
+
+    struct Dedup {
+        std::vector<uint8_t> unique;
+        std::vector<uint32_t> uniqueSizes;
+        std::vector<uint32_t> refs;
+    };
+
+    Dedup dedup(
+            std::vector<uint8_t> const& data,
+            ZS_CdcParams const& params,
+            size_t maxIndexedChunks = 1 << 20)
+    {
+        auto const cand          = candidates(data, params);
+        size_t const maxNbChunks = ZS_cdcMaxNbChunks(data.size(), &params);
+        Dedup result;
+        result.unique.resize(data.size());
+        result.uniqueSizes.resize(maxNbChunks);
+        result.refs.resize(maxNbChunks);
+        ZS_CdcDedupOutput out = {
+            .unique      = result.unique.data(),
+            .uniqueSizes = result.uniqueSizes.data(),
+            .refs        = result.refs.data(),
+        };
+        ZL_Report const ret = ZS_cdcDedup(
+                &out,
+                data.data(),
+                data.size(),
+                cand.data(),
+                &params,
+                maxIndexedChunks);
+        EXPECT_FALSE(ZL_isError(ret));
+        result.unique.resize(out.uniqueSize);
+        result.uniqueSizes.resize(out.nbUnique);
+        result.refs.resize(out.nbChunks);
+        return result;
+    }
+
+    ZL_Report decode(std::vector<uint8_t>& out, Dedup const& d)
+    {
+        std::vector<size_t> offsets(d.uniqueSizes.size());
+        ZL_Report const ret = ZS_cdcDecodedSize(
+                offsets.data(),
+                d.uniqueSizes.data(),
+                d.uniqueSizes.size(),
+                d.unique.size(),
+                d.refs.data(),
+                d.refs.size());
+        if (ZL_isError(ret)) {
+            return ret;
+        }
+        out.resize(ZL_validResult(ret));
+        ZS_cdcDecode(
+                out.data(),
+                d.unique.data(),
+                offsets.data(),
+                d.uniqueSizes.data(),
+                d.refs.data(),
+                d.refs.size());
+        return ret;
+    }
+
+    /// @returns the size of the unique chunks
+    size_t testRoundTrip(
+            std::vector<uint8_t> const& data,
+            ZS_CdcParams const& params,
+            size_t maxIndexedChunks = 1 << 20)
+    {
+        auto const d = dedup(data, params, maxIndexedChunks);
+        std::vector<uint8_t> out;
+        EXPECT_FALSE(ZL_isError(decode(out, d)));
+        EXPECT_EQ(out, data);
+        return d.unique.size();
+    }
+
+    std::mt19937 gen_{ 0xdeadbeef };
+};
+
+TEST_F(CdcKernelTest, CandidatesMatchScalar)
+{
+    auto const params = ZS_cdcParams(256);
+    for (size_t size :
+         { 0, 1, 63, 64, 65, 1000, 8191, 8192, 100000, 1000003 }) {
+        auto const data = random(size);
+        ZL_cpuFeatures_setMask(0);
+        auto const scalar = candidates(data, params);
+        ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+        EXPECT_EQ(candidates(data, params), scalar);
+    }
+}
+
+TEST_F(CdcKernelTest, ChunkSizes)
+{
+    for (size_t avg : { 256, 1000, 4096, 65536 }) {
+        auto const params = ZS_cdcParams(avg);
+        auto const data   = random(1 << 20);
+        auto const ends   = chunk(data, params);
+        ASSERT_FALSE(ends.empty());
+        EXPECT_EQ(ends.back(), data.size());
+        size_t start = 0;
+        for (size_t i = 0; i + 1 < ends.size(); ++i) {
+            EXPECT_GE(ends[i] - start, params.minChunkSize);
+            EXPECT_LE(ends[i] - start, params.maxChunkSize);
+            start = ends[i];
+        }
+        // The average is close to the target
+        size_t const target =
+                params.minChunkSize + ((size_t)1 << params.maskBits);
+        EXPECT_GT(ends.size(), data.size() / target / 2);
+        EXPECT_LT(ends.size(), data.size() / target * 2);
+    }
+}
+
+TEST_F(CdcKernelTest, ShiftInvariant)
+{
+    auto const params = ZS_cdcParams(1024);
+    auto const data   = random(1 << 18);
+    auto shifted      = random(100);
+    shifted.insert(shifted.end(), data.begin(), data.end());
+    auto const ends        = chunk(data, params);
+    auto const shiftedEnds = chunk(shifted, params);
+    // Chunking resynchronizes after a few chunks
+    size_t matched = 0;
+    for (size_t end : ends) {
+        matched += std::count(
+                shiftedEnds.begin(), shiftedEnds.end(), end + 100);
+    }
+    EXPECT_GE(matched + 4, ends.size());
+}
+
+TEST_F(CdcKernelTest, DedupShiftedRepeats)
+{
+    auto const params = ZS_cdcParams(1024);
+    auto const a      = random(100000);
+    auto const b      = random(50000);
+    std::vector<uint8_t> data = a;
+    data.insert(data.end(), b.begin(), b.end());
+    auto const junk = random(37);
+    data.insert(data.end(), junk.begin(), junk.end());
+    data.insert(data.end(), a.begin(), a.end());
+    data.insert(data.end(), b.begin() + 1000, b.end());
+    size_t const uniqueSize = testRoundTrip(data, params);
+    // Only the chunks around the edits are stored twice
+    EXPECT_LT(uniqueSize, a.size() + b.size() + 8 * params.maxChunkSize);
+}
+
+TEST_F(CdcKernelTest, RoundTrips)
+{
+    for (size_t size : { 0, 1, 100, 255, 256, 257, 5000, 100000 }) {
+        for (size_t avg : { 256, 4096 }) {
+            auto const params = ZS_cdcParams(avg);
+            testRoundTrip(random(size), params);
+            testRoundTrip(std::vector<uint8_t>(size, 'a'), params);
+            auto const quarter = random(size / 4);
+            std::vector<uint8_t> data;
+            for (size_t i = 0; i < 4; ++i) {
+                data.insert(data.end(), quarter.begin(), quarter.end());
+            }
+            testRoundTrip(data, params);
+        }
+    }
+}
+
+TEST_F(CdcKernelTest, MaxIndexedChunks)
+{
+    auto const params = ZS_cdcParams(256);
+    auto data         = random(50000);
+    auto const copy   = data;
+    data.insert(data.end(), copy.begin(), copy.end());
+    size_t const full = testRoundTrip(data, params);
+    EXPECT_LT(full, data.size() * 2 / 3);
+    // With a small index, only the first chunks are deduplicated
+    size_t const capped = testRoundTrip(data, params, 8);
+    EXPECT_GT(capped, data.size() * 9 / 10);
+    EXPECT_LT(capped, data.size());
+}
+
+TEST_F(CdcKernelTest, DecodeRejectsCorruption)
+{
+    Dedup d;
+    d.unique      = { 'a', 'b', 'c', 'd', 'e' };
+    d.uniqueSizes = { 3, 2 };
+    d.refs        = { 0, 1, 0, 0 };
+    std::vector<uint8_t> out;
+    ASSERT_FALSE(ZL_isError(decode(out, d)));
+    EXPECT_EQ(std::string(out.begin(), out.end()), "abcdeabcabc");
+
+    auto bad = d;
+    bad.refs = { 1, 0 };
+    EXPECT_TRUE(ZL_isError(decode(out, bad)));
+    bad.refs = { 0, 1, 2 };
+    EXPECT_TRUE(ZL_isError(decode(out, bad)));
+    bad.refs = { 0, 0 };
+    EXPECT_TRUE(ZL_isError(decode(out, bad)));
+    bad             = d;
+    bad.uniqueSizes = { 3, 3 };
+    EXPECT_TRUE(ZL_isError(decode(out, bad)));
+    bad.uniqueSizes = { 3, 1 };
+    EXPECT_TRUE(ZL_isError(decode(out, bad)));
+}
+
+} // namespace
+} // namespace tests
+} // namespace zstrong
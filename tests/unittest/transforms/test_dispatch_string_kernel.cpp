@@ -109,6 +109,8 @@ class DispatchStringKernelTest : public ::testing::Test {
         free(dstBuffers);
     }
 
+    void testRoundtrip(uint16_t maxSplits);
+
     void** dstBuffers;
     char** dstBuffersChar;
     uint32_t** dstStrLens;
@@ -172,9 +174,8 @@ TEST_F(DispatchStringKernelTest, RoundtripOne)
     earlyTearDown(1);
 }
 
-TEST_F(DispatchStringKernelTest, RoundtripMany)
+void DispatchStringKernelTest::testRoundtrip(uint16_t maxSplits)
 {
-    const size_t maxSplits = 16;
     std::vector<uint16_t> indices(nbStrs);
     for (auto i = 0u; i < nbStrs; ++i) {
         indices[i] = (uint16_t)i % maxSplits;
@@ -228,7 +229,20 @@ TEST_F(DispatchStringKernelTest, RoundtripMany)
         EXPECT_EQ(roundtripDstStrLens[i], srcStrLens[i]);
     }
 
-    earlyTearDown(16);
+    earlyTearDown(maxSplits);
+}
+
+TEST_F(DispatchStringKernelTest, RoundtripMany)
+{
+    testRoundtrip(16);
+}
+
+TEST_F(DispatchStringKernelTest, RoundtripWide)
+{
+    // lengths and contents are dispatched in separate passes
+    testRoundtrip(ZL_DISPATCH_STRING_ONE_PASS_MAX + 8);
+    // some outputs remain empty
+    testRoundtrip(ZL_DISPATCH_STRING_ONE_PASS_MAX * 3);
 }
 
 } // anonymous namespace
@@ -0,0 +1,287 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "openzl/codecs/common/window.h"
+#include "openzl/codecs/lz/common_field_lz.h"
+#include "openzl/codecs/lz/encode_field_lz_ldm.h"
+#include "openzl/codecs/lz/encode_match_finder.h"
+
+namespace zstrong {
+namespace tests {
+namespace {
+
+/// Frees everything allocated through it when destroyed
+class Arena {
+   public:
+    ~Arena()
+    {
+        for (void* ptr : allocs_) {
+            free(ptr);
+        }
+    }
+
+    ZL_FieldLz_Allocator allocator()
+    {
+        return { &Arena::alloc, this };
+    }
+
+   private:
+    static void* alloc(void* opaque, size_t size)
+    {
+        auto* arena     = static_cast<Arena*>(opaque);
+        void* const ptr = malloc(size == 0 ? 1 : size);
+        arena->allocs_.push_back(ptr);
+        return ptr;
+    }
+
+    std::vector<void*> allocs_;
+};
+
+class FieldLzKernelTest : public testing::Test {
+   protected:
+    std::vector<uint8_t> random(size_t size)
+    {
+        std::uniform_int_distribution<int> dist(0, 255);
+        std::vector<uint8_t> data(size);
+        for (auto& x : data) {
+            x = (uint8_t)dist(gen_);
+        }
+        return data;
+    }
+
+    /// Fields drawn from a small alphabet, with some repeated runs
+    std::vector<uint8_t> tokens(size_t nbElts, size_t eltWidth)
+    {
+        auto const alphabet = random(64 * eltWidth);
+        std::uniform_int_distribution<size_t> token(0, 63);
+        std::uniform_int_distribution<size_t> run(0, 3);
+        std::vector<uint8_t> data;
+        while (data.size() < nbElts * eltWidth) {
+            size_t const t = token(gen_);
+            for (size_t r = run(gen_) + 1; r > 0; --r) {
+                data.insert(
+                        data.end(),
+                        alphabet.begin() + (ptrdiff_t)(t * eltWidth),
+                        alphabet.begin() + (ptrdiff_t)((t + 1) * eltWidth));
+            }
+        }
+        data.resize(nbElts * eltWidth);
+        return data;
+    }
+
+    /// @returns the number of literal fields
+    size_t testRoundTrip(
+            std::vector<uint8_t> const& data,
+            size_t eltWidth,
+            int level)
+    {
+        size_t const nbElts  = data.size() / eltWidth;
+        size_t const maxSeqs = ZL_FieldLz_maxNbSequences(nbElts, eltWidth);
+        std::vector<uint8_t> literals(data.size());
+        std::vector<uint16_t> tokens(maxSeqs);
+        std::vector<uint32_t> offsets(maxSeqs);
+        std::vector<uint32_t> extraLiteralLengths(maxSeqs);
+        std::vector<uint32_t> extraMatchLengths(maxSeqs);
+        ZL_FieldLz_OutSequences out = {
+            .literalElts         = literals.data(),
+            .literalEltsCapacity = nbElts,
+            .tokens              = tokens.data(),
+            .offsets             = offsets.data(),
+            .extraLiteralLengths = extraLiteralLengths.data(),
+            .extraMatchLengths   = extraMatchLengths.data(),
+            .sequencesCapacity   = maxSeqs,
+        };
+        Arena arena;
+        ZL_Report const ret = ZS2_FieldLz_compress(
+                &out,
+                data.data(),
+                nbElts,
+                eltWidth,
+                level,
+                arena.allocator());
+        EXPECT_FALSE(ZL_isError(ret)) << "level " << level;
+
+        ZL_FieldLz_InSequences const in = {
+            .literalElts           = out.literalElts,
+            .nbLiteralElts         = out.nbLiteralElts,
+            .tokens                = out.tokens,
+            .nbTokens              = out.nbTokens,
+            .offsets               = out.offsets,
+            .nbOffsets             = out.nbOffsets,
+            .extraLiteralLengths   = out.extraLiteralLengths,
+            .nbExtraLiteralLengths = out.nbExtraLiteralLengths,
+            .extraMatchLengths     = out.extraMatchLengths,
+            .nbExtraMatchLengths   = out.nbExtraMatchLengths,
+        };
+        std::vector<uint8_t> decoded(data.size());
+        ZL_Report const size =
+                ZS2_FieldLz_decompress(decoded.data(), nbElts, eltWidth, &in);
+        EXPECT_FALSE(ZL_isError(size)) << "level " << level;
+        EXPECT_EQ(ZL_validResult(size), nbElts);
+        EXPECT_EQ(decoded, data) << "level " << level;
+        return out.nbLiteralElts;
+    }
+
+    /// Parses @p data with the lazy match finder and a 64 KiB window.
+    /// @returns the number of literal bytes
+    size_t lazyLiterals(std::vector<uint8_t> const& data, bool ldm)
+    {
+        Arena arena;
+        ZS_MatchFinderParameters params;
+        memset(&params, 0, sizeof(params));
+        params.strategy       = ZS_MatchFinderStrategy_lazy;
+        params.lzHashLog      = 16;
+        params.lzChainLog     = 16;
+        params.lzSearchLog    = 4;
+        params.lzTargetLength = 32;
+        params.windowLog      = 16;
+        params.ldmEnabled     = ldm;
+        params.ldmHashLog     = 12;
+        params.ldmMinLength   = 64;
+        params.fieldSize      = 1;
+        params.alloc          = arena.allocator();
+
+        ZS_seqStore seqStore;
+        ZS_window window;
+        EXPECT_EQ(
+                ZS_seqStore_initBound(
+                        &seqStore, data.size(), 4, arena.allocator()),
+                0);
+        ZS_window_init(&window, 1u << params.windowLog, 8);
+        ZS_matchFinderCtx* const ctx =
+                ZS_lazyTokenLzMatchFinder.ctx_create(&window, &params);
+        EXPECT_NE(ctx, nullptr);
+        ZS_window_update(&window, data.data(), data.size());
+        ZS_lazyTokenLzMatchFinder.parse(
+                ctx, &seqStore, data.data(), data.size());
+
+        // Replay the sequences with the decoder's repcode rules
+        std::vector<uint8_t> decoded;
+        uint32_t rep[3]         = { 1, 2, 4 };
+        uint8_t const* literals = seqStore.lits.start;
+        for (auto seq = seqStore.seqs.start; seq < seqStore.seqs.ptr; ++seq) {
+            decoded.insert(
+                    decoded.end(), literals, literals + seq->literalLength);
+            literals += seq->literalLength;
+            uint32_t offset;
+            if (seq->matchType == ZS_mt_lz) {
+                offset = seq->matchCode;
+                rep[2] = rep[1];
+                rep[1] = rep[0];
+            } else {
+                offset = rep[seq->matchCode];
+                for (uint32_t r = seq->matchCode; r > 0; --r) {
+                    rep[r] = rep[r - 1];
+                }
+            }
+            rep[0] = offset;
+            EXPECT_LE(offset, decoded.size());
+            for (uint32_t i = 0; i < seq->matchLength; ++i) {
+                decoded.push_back(decoded[decoded.size() - offset]);
+            }
+        }
+        decoded.insert(
+                decoded.end(), literals, (uint8_t const*)seqStore.lits.ptr);
+        EXPECT_EQ(decoded, data);
+        return (size_t)(seqStore.lits.ptr - seqStore.lits.start);
+    }
+
+    std::mt19937 gen_{ 0xdeadbeef };
+};
+
+TEST_F(FieldLzKernelTest, RoundTripHighLevels)
+{
+    for (size_t eltWidth : { 1, 2, 4, 8 }) {
+        for (size_t nbElts : { 0, 1, 3, 100, 5000, 100000 }) {
+            auto const tok  = tokens(nbElts, eltWidth);
+            auto const rand = random(nbElts * eltWidth);
+            std::vector<uint8_t> const same(nbElts * eltWidth, 'a');
+            for (int level = 6; level <= 9; ++level) {
+                testRoundTrip(tok, eltWidth, level);
+                testRoundTrip(rand, eltWidth, level);
+                testRoundTrip(same, eltWidth, level);
+            }
+        }
+    }
+}
+
+TEST_F(FieldLzKernelTest, OptimalParsingCoversMoreFields)
+{
+    for (size_t eltWidth : { 1, 2, 4, 8 }) {
+        auto const data    = tokens(100000, eltWidth);
+        size_t const lazy  = testRoundTrip(data, eltWidth, 6);
+        size_t const lazy2 = testRoundTrip(data, eltWidth, 7);
+        EXPECT_LT(testRoundTrip(data, eltWidth, 8), std::min(lazy, lazy2));
+        EXPECT_LT(testRoundTrip(data, eltWidth, 9), std::min(lazy, lazy2));
+    }
+}
+
+TEST_F(FieldLzKernelTest, LongDistanceMatchesBeyondTheWindow)
+{
+    auto const a     = random(20000);
+    auto const noise = random(100000);
+    std::vector<uint8_t> data = a;
+    data.insert(data.end(), noise.begin(), noise.end());
+    data.insert(data.end(), a.begin(), a.end());
+
+    size_t const withoutLdm = lazyLiterals(data, false);
+    size_t const withLdm    = lazyLiterals(data, true);
+    EXPECT_GT(withoutLdm, data.size() * 9 / 10);
+    EXPECT_LT(withLdm, a.size() + noise.size() + 1000);
+}
+
+TEST_F(FieldLzKernelTest, FindLongMatches)
+{
+    for (uint32_t fieldSize : { 1, 2, 4, 8 }) {
+        auto const a     = random(50000);
+        // Field aligned matches need an offset multiple of the field size
+        auto const noise = random(30008);
+        std::vector<uint8_t> data = a;
+        data.insert(data.end(), noise.begin(), noise.end());
+        data.insert(data.end(), a.begin(), a.end());
+
+        Arena arena;
+        ZS_LdmMatches ldm;
+        ASSERT_EQ(
+                ZS_FieldLz_findLongMatches(
+                        &ldm,
+                        data.data(),
+                        data.size(),
+                        fieldSize,
+                        12,
+                        64,
+                        arena.allocator()),
+                0);
+        size_t covered = 0;
+        size_t end     = 0;
+        for (size_t i = 0; i < ldm.nbMatches; ++i) {
+            auto const& m = ldm.matches[i];
+            EXPECT_GE(m.start, end);
+            EXPECT_EQ(m.start % fieldSize, 0u);
+            EXPECT_EQ(m.length % fieldSize, 0u);
+            EXPECT_EQ(m.offset % fieldSize, 0u);
+            EXPECT_GE(m.length, 64u);
+            ASSERT_LE(m.offset, m.start);
+            EXPECT_EQ(
+                    memcmp(data.data() + m.start,
+                           data.data() + m.start - m.offset,
+                           m.length),
+                    0);
+            covered += m.length;
+            end = m.start + m.length;
+        }
+        // Most of the repeat is found
+        EXPECT_GT(covered, a.size() * 9 / 10) << "fieldSize " << fieldSize;
+    }
+}
+
+} // namespace
+} // namespace tests
+} // namespace zstrong
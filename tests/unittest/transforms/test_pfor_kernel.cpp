@@ -0,0 +1,228 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "openzl/codecs/pfor/decode_pfor_kernel.h"
+#include "openzl/codecs/pfor/encode_pfor_kernel.h"
+#include "openzl/shared/cpu.h"
+
+namespace zstrong {
+namespace tests {
+namespace {
+
+class PforKernelTest : public testing::Test {
+   protected:
+    void TearDown() override
+    {
+        ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+    }
+
+    template <typename T>
+    std::vector<uint8_t> encode(std::vector<T> const& data)
+    {
+        std::vector<uint8_t> encoded(
+                ZS_pforEncodeBound(data.size(), sizeof(T)));
+        size_t const cSize = ZS_pforEncode(
+                encoded.data(),
+                encoded.size(),
+                data.data(),
+                data.size(),
+                sizeof(T));
+        EXPECT_LE(cSize, encoded.size());
+        encoded.resize(cSize);
+        return encoded;
+    }
+
+    template <typename T>
+    ZL_Report decode(std::vector<T>& out, std::vector<uint8_t> const& encoded)
+    {
+        return ZS_pforDecode(
+                out.data(),
+                out.size(),
+                sizeof(T),
+                encoded.data(),
+                encoded.size());
+    }
+
+    /// @returns the compressed size
+    template <typename T>
+    size_t testRoundTrip(std::vector<T> const& data)
+    {
+        auto const encoded = encode(data);
+        // Check both the scalar and the vectorized unpackers
+        for (auto const mask : { 0u, (unsigned)ZL_CPU_FEATURES_ALL }) {
+            ZL_cpuFeatures_setMask(mask);
+            std::vector<T> out(data.size());
+            ZL_Report const ret = decode(out, encoded);
+            EXPECT_FALSE(ZL_isError(ret));
+            if (ZL_isError(ret)) {
+                return encoded.size();
+            }
+            EXPECT_EQ(ZL_validResult(ret), encoded.size());
+            EXPECT_EQ(out, data);
+        }
+        return encoded.size();
+    }
+
+    template <typename T>
+    std::vector<T> sorted(size_t nbElts, uint64_t maxStep)
+    {
+        std::uniform_int_distribution<uint64_t> step(0, maxStep);
+        std::vector<T> data(nbElts);
+        T val = (T)gen_();
+        for (auto& x : data) {
+            val = (T)(val + step(gen_));
+            x   = val;
+        }
+        return data;
+    }
+
+    template <typename T>
+    std::vector<T> random(size_t nbElts, uint64_t maxValue)
+    {
+        std::uniform_int_distribution<uint64_t> dist(0, maxValue);
+        std::vector<T> data(nbElts);
+        for (auto& x : data) {
+            x = (T)dist(gen_);
+        }
+        return data;
+    }
+
+    template <typename T>
+    void testRoundTrips()
+    {
+        uint64_t const maxValue = (uint64_t)(T)-1;
+        for (size_t nbElts : { 0, 1, 2, 127, 128, 129, 1000, 10000 }) {
+            testRoundTrip(random<T>(nbElts, maxValue));
+            testRoundTrip(random<T>(nbElts, maxValue >> 3));
+            testRoundTrip(random<T>(nbElts, 0));
+            testRoundTrip(sorted<T>(nbElts, 3));
+            testRoundTrip(sorted<T>(nbElts, maxValue >> 2));
+            // Decreasing
+            auto data = sorted<T>(nbElts, 100);
+            std::reverse(data.begin(), data.end());
+            testRoundTrip(data);
+            // Signed values around 0
+            data = random<T>(nbElts, 200);
+            for (auto& x : data) {
+                x = (T)(x - 100);
+            }
+            testRoundTrip(data);
+            // Outliers
+            data = random<T>(nbElts, 15);
+            for (size_t i = 0; i < nbElts; i += 17) {
+                data[i] = (T)gen_();
+            }
+            testRoundTrip(data);
+        }
+    }
+
+    template <typename T>
+    void testCorruption()
+    {
+        auto data = random<T>(1000, 255);
+        for (size_t i = 0; i < data.size(); i += 13) {
+            data[i] = (T)gen_();
+        }
+        auto const encoded = encode(data);
+        std::vector<T> out(data.size());
+        ASSERT_FALSE(ZL_isError(decode(out, encoded)));
+        // Truncated sources must be rejected
+        auto truncated = encoded;
+        truncated.pop_back();
+        EXPECT_TRUE(ZL_isError(decode(out, truncated)));
+        // Bit flips must not crash
+        std::uniform_int_distribution<size_t> pos(0, encoded.size() - 1);
+        for (size_t i = 0; i < 1000; ++i) {
+            auto corrupted = encoded;
+            corrupted[pos(gen_)] ^= (uint8_t)(1u << (i % 8));
+            ZL_Report const ret = decode(out, corrupted);
+            (void)ret;
+        }
+    }
+
+    std::mt19937_64 gen_{ 0xdeadbeef };
+};
+
+TEST_F(PforKernelTest, RoundTrip8)
+{
+    testRoundTrips<uint8_t>();
+}
+
+TEST_F(PforKernelTest, RoundTrip16)
+{
+    testRoundTrips<uint16_t>();
+}
+
+TEST_F(PforKernelTest, RoundTrip32)
+{
+    testRoundTrips<uint32_t>();
+}
+
+TEST_F(PforKernelTest, RoundTrip64)
+{
+    testRoundTrips<uint64_t>();
+}
+
+TEST_F(PforKernelTest, CompressesWell)
+{
+    // Timestamps with a small jitter use a few bits per value
+    auto const data = sorted<uint64_t>(100000, 7);
+    EXPECT_LT(testRoundTrip(data), data.size() * sizeof(data[0]) / 10);
+    // Rare outliers are patched, and don't widen their block
+    auto const baseline = testRoundTrip(random<uint32_t>(100000, 15));
+    auto withOutliers   = random<uint32_t>(100000, 15);
+    for (size_t i = 0; i < withOutliers.size(); i += 64) {
+        withOutliers[i] = (uint32_t)gen_();
+    }
+    EXPECT_LT(testRoundTrip(withOutliers), baseline * 2);
+    // Constant blocks only cost their header
+    std::vector<uint32_t> const constant(128 * 100, 12345);
+    EXPECT_EQ(testRoundTrip(constant), 100 * (2 + sizeof(uint32_t)));
+}
+
+TEST_F(PforKernelTest, SkipBlocks)
+{
+    auto const data    = sorted<uint32_t>(1000, 1000);
+    auto const encoded = encode(data);
+    // Skip to each block by reading block headers only, then decode it alone
+    uint8_t const* ip   = encoded.data();
+    uint8_t const* iend = encoded.data() + encoded.size();
+    for (size_t n = 0; n < data.size(); n += ZS_PFOR_BLOCK_SIZE) {
+        size_t const blockSize =
+                std::min<size_t>(ZS_PFOR_BLOCK_SIZE, data.size() - n);
+        std::vector<uint32_t> out(blockSize);
+        ZL_Report const ret = ZS_pforDecodeBlock(
+                out.data(),
+                blockSize,
+                sizeof(uint32_t),
+                ip,
+                (size_t)(iend - ip));
+        ASSERT_FALSE(ZL_isError(ret));
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), data.begin() + n));
+        ZL_Report const cSize = ZS_pforBlockCSize(
+                ip, (size_t)(iend - ip), blockSize, sizeof(uint32_t));
+        ASSERT_FALSE(ZL_isError(cSize));
+        EXPECT_EQ(ZL_validResult(cSize), ZL_validResult(ret));
+        ip += ZL_validResult(cSize);
+    }
+    EXPECT_EQ(ip, iend);
+}
+
+TEST_F(PforKernelTest, Corruption32)
+{
+    testCorruption<uint32_t>();
+}
+
+TEST_F(PforKernelTest, Corruption64)
+{
+    testCorruption<uint64_t>();
+}
+
+} // namespace
+} // namespace tests
+} // namespace zstrong
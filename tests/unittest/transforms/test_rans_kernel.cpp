@@ -0,0 +1,219 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "openzl/codecs/entropy/decode_rans_kernel.h"
+#include "openzl/codecs/entropy/encode_rans_kernel.h"
+#include "openzl/shared/cpu.h"
+
+namespace zstrong {
+namespace tests {
+namespace {
+
+class RansKernelTest : public testing::Test {
+   protected:
+    void TearDown() override
+    {
+        ZL_cpuFeatures_setMask(ZL_CPU_FEATURES_ALL);
+    }
+
+    template <typename T>
+    std::vector<T> generate(size_t nbElts, size_t cardinality, bool skewed)
+    {
+        std::uniform_int_distribution<size_t> dist(0, cardinality - 1);
+        std::vector<T> data(nbElts);
+        for (auto& x : data) {
+            size_t v = dist(gen_);
+            if (skewed) {
+                v = v * v / cardinality;
+            }
+            x = (T)v;
+        }
+        return data;
+    }
+
+    /// @returns the encoded data, or an empty buffer for constant data
+    template <typename T>
+    std::vector<uint8_t> encode(
+            std::vector<T> const& data,
+            std::vector<uint16_t>& norm,
+            unsigned& tableLog)
+    {
+        size_t const nbSymbols = (size_t)1 << (8 * sizeof(T));
+        std::vector<unsigned> count(nbSymbols, 0);
+        size_t cardinality = 0;
+        for (auto x : data) {
+            cardinality += count[x]++ == 0;
+        }
+        if (cardinality < 2) {
+            return {};
+        }
+        tableLog = ZS_ransOptimalTableLog(
+                data.size(), cardinality, ZS_ransMaxTableLog(sizeof(T)));
+        norm.resize(nbSymbols);
+        ZL_Report ret = ZS_ransNormalizeCount(
+                norm.data(), count.data(), nbSymbols, data.size(), tableLog);
+        EXPECT_FALSE(ZL_isError(ret));
+        for (size_t s = 0; s < nbSymbols; ++s) {
+            EXPECT_EQ(count[s] == 0, norm[s] == 0);
+        }
+
+        std::vector<ZS_RansCElt> ctable(nbSymbols);
+        ZS_ransBuildCTable(ctable.data(), norm.data(), nbSymbols, tableLog);
+        std::vector<uint8_t> encoded(ZS_ransEncodeBound(data.size()));
+        ret = ZS_ransEncode(
+                encoded.data(),
+                encoded.size(),
+                data.data(),
+                data.size(),
+                sizeof(T),
+                ctable.data(),
+                tableLog);
+        EXPECT_FALSE(ZL_isError(ret));
+        encoded.resize(ZL_validResult(ret));
+        return encoded;
+    }
+
+    template <typename T>
+    ZL_Report decode(
+            std::vector<T>& out,
+            std::vector<uint8_t> const& encoded,
+            std::vector<uint16_t> const& norm)
+    {
+        ZL_Report const tableLog =
+                ZS_ransValidNorm(norm.data(), norm.size(), sizeof(T));
+        if (ZL_isError(tableLog)) {
+            return tableLog;
+        }
+        std::vector<uint8_t> dtable(ZS_ransDTableSize(
+                (unsigned)ZL_validResult(tableLog), sizeof(T)));
+        ZS_ransBuildDTable(
+                dtable.data(),
+                norm.data(),
+                norm.size(),
+                (unsigned)ZL_validResult(tableLog),
+                sizeof(T));
+        return ZS_ransDecode(
+                out.data(),
+                out.size(),
+                sizeof(T),
+                encoded.data(),
+                encoded.size(),
+                dtable.data(),
+                (unsigned)ZL_validResult(tableLog));
+    }
+
+    template <typename T>
+    void testRoundTrip(std::vector<T> const& data)
+    {
+        std::vector<uint16_t> norm;
+        unsigned tableLog = 0;
+        auto const encoded = encode(data, norm, tableLog);
+        if (encoded.empty()) {
+            return;
+        }
+        // Check both the scalar and the vectorized decoders
+        for (auto const mask : { 0u, (unsigned)ZL_CPU_FEATURES_ALL }) {
+            ZL_cpuFeatures_setMask(mask);
+            std::vector<T> out(data.size());
+            ZL_Report const ret = decode(out, encoded, norm);
+            ASSERT_FALSE(ZL_isError(ret));
+            EXPECT_EQ(ZL_validResult(ret), encoded.size());
+            EXPECT_EQ(out, data);
+        }
+    }
+
+    template <typename T>
+    void testRoundTrips(size_t maxCardinality)
+    {
+        for (size_t nbElts : { 2, 31, 32, 33, 100, 1000, 4097, 100000 }) {
+            for (size_t card = 2; card <= maxCardinality; card = card * 5 + 1) {
+                testRoundTrip(generate<T>(nbElts, card, false));
+                testRoundTrip(generate<T>(nbElts, card, true));
+            }
+        }
+    }
+
+    template <typename T>
+    void testCorruption()
+    {
+        auto const data = generate<T>(5000, 50, true);
+        std::vector<uint16_t> norm;
+        unsigned tableLog = 0;
+        auto const encoded = encode(data, norm, tableLog);
+        ASSERT_FALSE(encoded.empty());
+        std::uniform_int_distribution<size_t> pos(0, encoded.size() - 1);
+        for (auto const mask : { 0u, (unsigned)ZL_CPU_FEATURES_ALL }) {
+            ZL_cpuFeatures_setMask(mask);
+            std::vector<T> out(data.size());
+            // Truncated & extended sources must be rejected
+            auto truncated = encoded;
+            truncated.pop_back();
+            EXPECT_TRUE(ZL_isError(decode(out, truncated, norm)));
+            auto extended = encoded;
+            extended.push_back(0);
+            extended.push_back(0);
+            EXPECT_TRUE(ZL_isError(decode(out, extended, norm)));
+            // Bit flips must not crash
+            for (size_t i = 0; i < 100; ++i) {
+                auto corrupted = encoded;
+                corrupted[pos(gen_)] ^= (uint8_t)(1u << (i % 8));
+                ZL_Report const ret = decode(out, corrupted, norm);
+                (void)ret;
+            }
+        }
+    }
+
+    std::mt19937 gen_{ 0xdeadbeef };
+};
+
+TEST_F(RansKernelTest, RoundTrip8)
+{
+    testRoundTrips<uint8_t>(256);
+}
+
+TEST_F(RansKernelTest, RoundTrip16)
+{
+    testRoundTrips<uint16_t>(1 << 15);
+}
+
+TEST_F(RansKernelTest, Corruption8)
+{
+    testCorruption<uint8_t>();
+}
+
+TEST_F(RansKernelTest, Corruption16)
+{
+    testCorruption<uint16_t>();
+}
+
+TEST_F(RansKernelTest, InvalidNorm)
+{
+    std::vector<uint16_t> norm = { 16, 16 };
+    EXPECT_FALSE(ZL_isError(ZS_ransValidNorm(norm.data(), norm.size(), 1)));
+    // Sum is not a power of 2
+    norm = { 16, 15 };
+    EXPECT_TRUE(ZL_isError(ZS_ransValidNorm(norm.data(), norm.size(), 1)));
+    // Single symbol
+    norm = { 32, 0 };
+    EXPECT_TRUE(ZL_isError(ZS_ransValidNorm(norm.data(), norm.size(), 1)));
+    // Table log too small
+    norm = { 8, 8 };
+    EXPECT_TRUE(ZL_isError(ZS_ransValidNorm(norm.data(), norm.size(), 1)));
+    // Table log too large for 8-bit symbols, but not for 16-bit ones
+    norm = { 1 << 12, 1 << 12 };
+    EXPECT_TRUE(ZL_isError(ZS_ransValidNorm(norm.data(), norm.size(), 1)));
+    EXPECT_FALSE(ZL_isError(ZS_ransValidNorm(norm.data(), norm.size(), 2)));
+    // Too many symbols
+    norm.assign(257, 0);
+    norm[0] = norm[256] = 16;
+    EXPECT_TRUE(ZL_isError(ZS_ransValidNorm(norm.data(), norm.size(), 1)));
+}
+
+} // namespace
+} // namespace tests
+} // namespace zstrong
@@ -0,0 +1,131 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Kernel headers employ the C99 `restrict` qualifier
+#define restrict __restrict
+#include "openzl/codecs/splitByStruct/decode_splitByStruct_kernel.h"
+#include "openzl/codecs/splitByStruct/encode_splitByStruct_kernel.h"
+#undef restrict
+
+namespace zstrong::tests {
+
+namespace {
+void testLayout(const std::vector<size_t>& fieldSizes, size_t nbElts)
+{
+    size_t const nbFields = fieldSizes.size();
+    size_t const structSize =
+            std::accumulate(fieldSizes.begin(), fieldSizes.end(), (size_t)0);
+    std::mt19937 gen(uint32_t(nbFields * 1000 + nbElts));
+    // One extra byte, so that the buffer is never NULL
+    std::vector<uint8_t> input(structSize * nbElts + 1);
+    for (auto& b : input) {
+        b = (uint8_t)gen();
+    }
+
+    // Naive reference
+    std::vector<std::vector<uint8_t>> expected(nbFields);
+    size_t pos = 0;
+    for (size_t e = 0; e < nbElts; e++) {
+        for (size_t f = 0; f < nbFields; f++) {
+            expected[f].insert(
+                    expected[f].end(),
+                    input.begin() + (ptrdiff_t)pos,
+                    input.begin() + (ptrdiff_t)(pos + fieldSizes[f]));
+            pos += fieldSizes[f];
+        }
+    }
+
+    // Exactly sized buffers, so that overflows are detected by ASan
+    std::vector<std::vector<uint8_t>> fields(nbFields);
+    std::vector<void*> dstBuffers(nbFields);
+    for (size_t f = 0; f < nbFields; f++) {
+        fields[f].resize(fieldSizes[f] * nbElts);
+        fields[f].reserve(1);
+        dstBuffers[f] = fields[f].data();
+    }
+    ZS_dispatchArrayFixedSizeStruct(
+            dstBuffers.data(),
+            nbFields,
+            input.data(),
+            structSize * nbElts,
+            fieldSizes.data());
+    for (size_t f = 0; f < nbFields; f++) {
+        ASSERT_EQ(fields[f], expected[f]) << "field " << f;
+        // The single member shortcut is a plain copy, which doesn't advance
+        // its destination pointer
+        if (nbFields > 1) {
+            ASSERT_EQ(
+                    dstBuffers[f],
+                    (void*)(fields[f].data() + fieldSizes[f] * nbElts));
+        }
+    }
+
+    std::vector<const void*> srcs(nbFields);
+    for (size_t f = 0; f < nbFields; f++) {
+        srcs[f] = fields[f].data();
+    }
+    // One extra byte, so that the buffer is never NULL
+    std::vector<uint8_t> regenerated(structSize * nbElts + 1);
+    size_t const dstSize = ZS_dispatchArrayFixedSizeStruct_decode(
+            regenerated.data(),
+            structSize * nbElts,
+            srcs.data(),
+            fieldSizes.data(),
+            nbFields,
+            nbElts);
+    ASSERT_EQ(dstSize, structSize * nbElts);
+    regenerated.pop_back();
+    input.pop_back();
+    ASSERT_EQ(regenerated, input);
+}
+
+void testLayout(const std::vector<size_t>& fieldSizes)
+{
+    for (size_t const nbElts : { 0, 1, 2, 7, 9, 100, 3001 }) {
+        testLayout(fieldSizes, nbElts);
+    }
+}
+
+std::vector<size_t> repeat(std::vector<size_t> pattern, size_t nbFields)
+{
+    std::vector<size_t> fieldSizes;
+    for (size_t f = 0; f < nbFields; f++) {
+        fieldSizes.push_back(pattern[f % pattern.size()]);
+    }
+    return fieldSizes;
+}
+} // namespace
+
+TEST(SplitByStructKernelTest, UniformFieldSizes)
+{
+    for (size_t const fs : { 1, 2, 3, 4, 8, 12 }) {
+        for (size_t const nbFields : { 1, 2, 5, 16 }) {
+            testLayout(repeat({ fs }, nbFields));
+        }
+    }
+}
+
+TEST(SplitByStructKernelTest, MixedFieldSizes)
+{
+    testLayout({ 4, 2, 2, 4 });
+    testLayout({ 1, 8, 3, 1 });
+    testLayout({ 8, 16, 1, 33 });
+    testLayout({ 2, 9 });
+}
+
+TEST(SplitByStructKernelTest, ManyFields)
+{
+    testLayout(repeat({ 4 }, 17));
+    testLayout(repeat({ 1, 2, 4, 8 }, 40));
+    testLayout(repeat({ 1 }, 100));
+    testLayout(repeat({ 8, 3, 1, 20 }, 37));
+    testLayout(repeat({ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 9 }, 48));
+    // Structures larger than a block
+    testLayout(repeat({ 700, 2 }, 30), 20);
+}
+
+} // namespace zstrong::tests
@@ -1,7 +1,9 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <random>
+#include <unordered_map>
 
 #include "openzl/codecs/tokenize/decode_tokenize2to1_kernel.h"
 #include "openzl/codecs/tokenize/decode_tokenize4to2_kernel.h"
@@ -9,6 +11,8 @@
 #include "openzl/codecs/tokenize/encode_tokenize2to1_kernel.h"
 #include "openzl/codecs/tokenize/encode_tokenize4to2_kernel.h"
 #include "openzl/codecs/tokenize/encode_tokenizeVarto4_kernel.h"
+#include "openzl/codecs/tokenize/encode_tokenize_kernel.h"
+#include "openzl/codecs/tokenize/encode_tokenize_kernel_sort.h"
 
 namespace zstrong::tests {
 
@@ -202,4 +206,174 @@ TEST(TokenizeKernelTest, RoundTripVarTo4)
             maxLength /* because content is all the same char */);
 }
 
+namespace {
+template <typename T>
+struct Tokenized {
+    std::vector<T> alphabet;
+    std::vector<uint32_t> indices;
+
+    bool operator==(const Tokenized& other) const
+    {
+        return alphabet == other.alphabet && indices == other.indices;
+    }
+};
+
+/// Reference tokenization, matching the hash-based encoder
+template <typename T>
+Tokenized<T> tokenizeReference(const std::vector<T>& input, bool sort)
+{
+    Tokenized<T> out;
+    std::unordered_map<T, uint32_t> tokToIdx;
+    for (T const token : input) {
+        auto const [it, inserted] =
+                tokToIdx.emplace(token, (uint32_t)out.alphabet.size());
+        if (inserted) {
+            out.alphabet.push_back(token);
+        }
+        out.indices.push_back(it->second);
+    }
+    if (sort) {
+        std::sort(out.alphabet.begin(), out.alphabet.end());
+        for (size_t i = 0; i < out.alphabet.size(); ++i) {
+            tokToIdx[out.alphabet[i]] = (uint32_t)i;
+        }
+        for (size_t i = 0; i < input.size(); ++i) {
+            out.indices[i] = tokToIdx[input[i]];
+        }
+    }
+    return out;
+}
+
+std::vector<uint32_t> widenIndices(
+        const std::vector<uint8_t>& indices,
+        size_t nbElts,
+        size_t idxWidth)
+{
+    std::vector<uint32_t> out(nbElts);
+    for (size_t i = 0; i < nbElts; ++i) {
+        memcpy(&out[i], &indices[i * idxWidth], idxWidth);
+    }
+    return out;
+}
+
+size_t minIdxWidth(size_t alphabetSize)
+{
+    return alphabetSize <= 256 ? 1 : alphabetSize <= 65536 ? 2 : 4;
+}
+
+template <typename T>
+Tokenized<T> tokenizeDirect(const std::vector<T>& input, bool sort)
+{
+    auto const [minIt, maxIt] = std::minmax_element(input.begin(), input.end());
+    uint64_t const minValue   = input.empty() ? 0 : *minIt;
+    uint64_t const maxValue   = input.empty() ? 0 : *maxIt;
+    size_t const rangeSize    = (size_t)(maxValue - minValue) + 1;
+    std::vector<uint32_t> table(rangeSize);
+    size_t const alphabetSize = ZS_tokenizeDirect_buildTable(
+            table.data(),
+            rangeSize,
+            input.data(),
+            input.size(),
+            sizeof(T),
+            minValue,
+            sort);
+    size_t const idxWidth = minIdxWidth(alphabetSize);
+    Tokenized<T> out;
+    out.alphabet.resize(alphabetSize);
+    std::vector<uint8_t> indices(input.size() * idxWidth + 1);
+    ZS_tokenizeDirect_writeAlphabet(
+            out.alphabet.data(), table.data(), rangeSize, sizeof(T), minValue);
+    ZS_tokenizeDirect_writeIndices(
+            indices.data(),
+            idxWidth,
+            table.data(),
+            input.data(),
+            input.size(),
+            sizeof(T),
+            minValue);
+    out.indices = widenIndices(indices, input.size(), idxWidth);
+    return out;
+}
+
+template <typename T>
+Tokenized<T> tokenizeRadix(const std::vector<T>& input)
+{
+    auto const [minIt, maxIt] = std::minmax_element(input.begin(), input.end());
+    uint64_t const minValue   = input.empty() ? 0 : *minIt;
+    uint64_t const maxValue   = input.empty() ? 0 : *maxIt;
+    std::vector<uint64_t> workspace(
+            ZS_tokenizeRadix_wkspSize(input.size()) / sizeof(uint64_t) + 1);
+    size_t alphabetSize;
+    uint64_t const* const entries = ZS_tokenizeRadix_sort(
+            &alphabetSize,
+            input.data(),
+            input.size(),
+            sizeof(T),
+            minValue,
+            maxValue,
+            workspace.data());
+    size_t const idxWidth = minIdxWidth(alphabetSize);
+    Tokenized<T> out;
+    out.alphabet.resize(alphabetSize);
+    std::vector<uint8_t> indices(input.size() * idxWidth + 1);
+    ZS_tokenizeRadix_write(
+            out.alphabet.data(),
+            indices.data(),
+            idxWidth,
+            entries,
+            input.size(),
+            sizeof(T),
+            minValue);
+    out.indices = widenIndices(indices, input.size(), idxWidth);
+    return out;
+}
+
+template <typename T>
+std::vector<T> genTokens(size_t nbElts, uint64_t base, uint64_t range)
+{
+    std::mt19937_64 gen(0xdeadbeef);
+    std::vector<T> input(nbElts);
+    for (auto& v : input) {
+        v = (T)(base + gen() % range);
+    }
+    return input;
+}
+
+template <typename T>
+void testFastPaths()
+{
+    for (uint64_t const range : { 1, 7, 300, 70000, 1 << 20 }) {
+        for (size_t const nbElts : { 0, 1, 1000, 100000 }) {
+            auto const input = genTokens<T>(nbElts, (T)-1 - range, range);
+            for (bool const sort : { false, true }) {
+                EXPECT_EQ(
+                        tokenizeDirect(input, sort),
+                        tokenizeReference(input, sort));
+            }
+            EXPECT_EQ(tokenizeRadix(input), tokenizeReference(input, true));
+        }
+    }
+}
+} // namespace
+
+TEST(TokenizeKernelTest, FastPathsMatchReference4)
+{
+    testFastPaths<uint32_t>();
+}
+
+TEST(TokenizeKernelTest, FastPathsMatchReference8)
+{
+    testFastPaths<uint64_t>();
+}
+
+TEST(TokenizeKernelTest, RadixSortFullRange)
+{
+    // Values span the full 32-bit range after subtracting the minimum
+    std::vector<uint64_t> input =
+            genTokens<uint64_t>(5000, 1ull << 40, 1ull << 32);
+    input.push_back(1ull << 40);
+    input.push_back((1ull << 40) + UINT32_MAX);
+    EXPECT_EQ(tokenizeRadix(input), tokenizeReference(input, true));
+}
+
 } // namespace zstrong::tests
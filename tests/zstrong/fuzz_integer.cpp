@@ -65,6 +65,13 @@ FUZZ_F(IntegerTest, FuzzZigzagRoundTrip)
     testNodeOnInput(ZL_NODE_ZIGZAG, eltWidth, input);
 }
 
+FUZZ_F(IntegerTest, FuzzPforRoundTrip)
+{
+    size_t const eltWidth = f.choices("elt_width", { 1, 2, 4, 8 });
+    std::string input = gen_str(f, "input_data", InputLengthInBytes(eltWidth));
+    testNodeOnInput(ZL_NODE_PFOR, eltWidth, input);
+}
+
 FUZZ_F(IntegerTest, FuzzBitpackRoundTrip)
 {
     size_t const eltWidth = f.choices("elt_width", { 1, 2, 4, 8 });
@@ -94,6 +94,24 @@ FUZZ_F(SerializedTest, FuzzFSERoundTrip)
     }
 }
 
+FUZZ_F(SerializedTest, FuzzRansRoundTrip)
+{
+    bool const useNode = f.coin("use_node");
+    std::string input  = gen_str(f, "input_data", InputLengthInBytes(1));
+    reset();
+    if (useNode) {
+        setLargeCompressBound(8);
+        finalizeGraph(
+                declareGraph(ZL_NodeID{ ZL_PrivateStandardNodeID_rans }), 1);
+        testRoundTripCompressionMayFail(input);
+    } else {
+        // Lets the entropy graph select rANS
+        setLevels(0, 1);
+        finalizeGraph(ZL_GRAPH_ENTROPY, 1);
+        testRoundTrip(input);
+    }
+}
+
 FUZZ_F(SerializedTest, FuzzZstdRoundTrip)
 {
     std::string input = gen_str(f, "input_data", InputLengthInBytes(1));
@@ -81,6 +81,17 @@ TEST_F(FixedTest, HuffmanNode2)
     testRoundTrip(generatedData(50000, 1000));
 }
 
+TEST_F(FixedTest, RansNode2)
+{
+    reset();
+    finalizeGraph(declareGraph({ ZL_PrivateStandardNodeID_rans_struct }), 2);
+    setAlphabetMask("\xff\x03");
+    testRoundTrip(generatedData(50000, 2));
+    testRoundTrip(generatedData(50000, 10));
+    testRoundTrip(generatedData(50000, 100));
+    testRoundTrip(generatedData(50000, 1000));
+}
+
 TEST_F(FixedTest, HuffmanGraph2)
 {
     reset();
@@ -91,6 +102,17 @@ TEST_F(FixedTest, HuffmanGraph2)
     test();
 }
 
+TEST_F(FixedTest, EntropyGraph2FastDecompression)
+{
+    reset();
+    setLevels(0, 1);
+    auto graph = ZL_Compressor_registerStaticGraph_fromNode1o(
+            cgraph_, ZL_NODE_INTERPRET_AS_LE16, ZL_GRAPH_ENTROPY);
+    testGraph(graph, 2);
+    setAlphabetMask("\xff\x0f");
+    test();
+}
+
 TEST_F(FixedTest, Zstd)
 {
     setFormatVersion(10); // Last version that supported ZSTD_FIXED
@@ -201,12 +223,15 @@ TEST_F(FixedTest, FieldLzGraph8)
 
 TEST_F(FixedTest, FieldLzGraphWithCompressionLevelOverride)
 {
-    for (int level = 1; level <= 5; ++level) {
-        reset();
-        setLevels(1, 1);
-        testGraph(
-                ZL_Compressor_registerFieldLZGraph_withLevel(cgraph_, level),
-                1);
+    for (int level = 1; level <= 9; ++level) {
+        for (size_t eltWidth : { 1, 2, 4, 8 }) {
+            reset();
+            setLevels(1, 1);
+            testGraph(
+                    ZL_Compressor_registerFieldLZGraph_withLevel(
+                            cgraph_, level),
+                    eltWidth);
+        }
     }
 }
 
@@ -103,6 +103,26 @@ TEST_F(IntegerTest, Zigzag64)
     testNode(ZL_NODE_ZIGZAG, 8);
 }
 
+TEST_F(IntegerTest, Pfor8)
+{
+    testNode(ZL_NODE_PFOR, 1);
+}
+
+TEST_F(IntegerTest, Pfor16)
+{
+    testNode(ZL_NODE_PFOR, 2);
+}
+
+TEST_F(IntegerTest, Pfor32)
+{
+    testNode(ZL_NODE_PFOR, 4);
+}
+
+TEST_F(IntegerTest, Pfor64)
+{
+    testNode(ZL_NODE_PFOR, 8);
+}
+
 TEST_F(IntegerTest, Bitpack8)
 {
     testNode(ZL_NODE_BITPACK_INT, 1);
@@ -73,11 +73,42 @@ TEST_F(SerializedTest, HuffmanGraph)
     testGraph(ZL_GRAPH_HUFFMAN);
 }
 
+TEST_F(SerializedTest, RansNode)
+{
+    reset();
+    finalizeGraph(declareGraph({ ZL_PrivateStandardNodeID_rans }), 1);
+    testRoundTrip(generatedData(1000, 2));
+    testRoundTrip(generatedData(1000, 10));
+    testRoundTrip(generatedData(1000, 100));
+    testRoundTrip(generatedData(100000, 256));
+}
+
 TEST_F(SerializedTest, Zstd)
 {
     testNode(ZL_NODE_ZSTD);
 }
 
+TEST_F(SerializedTest, DedupChunks)
+{
+    testNode(ZL_NODE_DEDUP_CHUNKS);
+}
+
+TEST_F(SerializedTest, DedupChunksShiftedRepeats)
+{
+    std::string data = generatedData(100000, 256);
+    data += "shift" + data.substr(0, 60000) + data.substr(30000);
+    for (int avgChunkSize : { 256, 1000, 4096 }) {
+        ZL_IntParam param = { .paramId    = ZL_DEDUP_CHUNKS_AVG_SIZE_PID,
+                              .paramValue = avgChunkSize };
+        ZL_LocalParams const params = { .intParams = { &param, 1 } };
+        testParameterizedNodeOnInput(ZL_NODE_DEDUP_CHUNKS, params, data);
+        // Outputs are stored, so only deduplication shrinks the data
+        auto const [csize, compressed] = compress(data);
+        ASSERT_FALSE(ZL_isError(csize));
+        EXPECT_LT(ZL_validResult(csize), data.size() * 2 / 3);
+    }
+}
+
 TEST_F(SerializedTest, Bitpack)
 {
     testNode(ZL_NODE_BITPACK_SERIAL);
@@ -146,6 +177,17 @@ TEST_F(SerializedTest, EntropySelector)
     testGraph(ZL_GRAPH_ENTROPY);
 }
 
+TEST_F(SerializedTest, EntropySelectorFastDecompression)
+{
+    for (int decompressionLevel : { 1, 2 }) {
+        reset();
+        setLevels(0, decompressionLevel);
+        finalizeGraph(ZL_GRAPH_ENTROPY, 1);
+        test();
+        testRoundTrip(generatedData(100000, 10));
+    }
+}
+
 TEST_F(SerializedTest, BitpackSelector)
 {
     testGraph(ZL_GRAPH_BITPACK);
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
 
 #include "openzl/cpp/poly/Optional.hpp"
 #include "openzl/cpp/poly/StringView.hpp"
@@ -28,6 +31,40 @@ class Input {
      * Retrieve the contents of this input.
      */
     virtual poly::string_view contents() = 0;
+
+    /**
+     * @returns whether size() can be known without reading the whole input.
+     * Inputs which can't, like pipes, are best consumed with read().
+     */
+    virtual bool hasKnownSize()
+    {
+        return true;
+    }
+
+    /**
+     * Copies up to @p capacity of the next bytes of this input into @p dst.
+     * Successive calls return consecutive parts of the input, starting at its
+     * beginning. Unlike contents(), inputs may serve this sequentially,
+     * without holding the whole input in memory.
+     *
+     * @returns the number of bytes copied, which is smaller than @p capacity
+     *          only at the end of the input.
+     */
+    virtual size_t read(char* dst, size_t capacity)
+    {
+        const auto src = contents();
+        if (readPos_ >= src.size()) {
+            return 0;
+        }
+        const size_t toCopy = std::min(capacity, src.size() - readPos_);
+        memcpy(dst, src.data() + readPos_, toCopy);
+        readPos_ += toCopy;
+        return toCopy;
+    }
+
+   protected:
+    /// Position of the next read()
+    size_t readPos_ = 0;
 };
 
 } // namespace openzl::tools::io
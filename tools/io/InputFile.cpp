@@ -25,8 +25,14 @@ poly::string_view InputFile::name() const
 poly::optional<size_t> InputFile::size()
 {
     if (!contents_) {
-        // TODO: eventually we will be stat-ing the file first and can use that
-        // instead of triggering reading the contents.
+        // Regular files can be measured without reading them
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(filename_, ec)) {
+            const auto fileSize = std::filesystem::file_size(filename_, ec);
+            if (!ec) {
+                return (size_t)fileSize;
+            }
+        }
         read();
     }
 
@@ -42,6 +48,45 @@ poly::string_view InputFile::contents()
     return contents_.value();
 }
 
+bool InputFile::hasKnownSize()
+{
+    std::error_code ec;
+    return contents_ || std::filesystem::is_regular_file(filename_, ec);
+}
+
+size_t InputFile::read(char* dst, size_t capacity)
+{
+    if (contents_) {
+        return Input::read(dst, capacity);
+    }
+
+    if (!stream_.is_open()) {
+        Logger::log_c(
+                VERBOSE1, "Streaming from input file '%s'", filename_.c_str());
+        stream_.open(filename_, std::ios::binary);
+        if (!stream_.is_open()) {
+            throw IOException(
+                    "Failed to open input file '" + filename_
+                    + "': " + std::system_category().message(errno));
+        }
+    }
+    if (stream_.eof()) {
+        return 0;
+    }
+
+    stream_.read(dst, (std::streamsize)capacity);
+    // A short read at the end of the input sets both eofbit and failbit:
+    // failbit alone means an error
+    if (stream_.bad() || (stream_.fail() && !stream_.eof())) {
+        throw IOException(
+                "Failed to read input file '" + filename_
+                + "': " + std::system_category().message(errno));
+    }
+    const size_t readSize = (size_t)stream_.gcount();
+    readPos_ += readSize;
+    return readSize;
+}
+
 void InputFile::read()
 {
     Logger::log_c(VERBOSE1, "Reading from input file '%s'", filename_.c_str());
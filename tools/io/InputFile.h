@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <fstream>
 #include <string>
 
 #include "tools/io/Input.h"
@@ -21,11 +22,24 @@ class InputFile : public Input {
 
     poly::string_view contents() override;
 
+    /**
+     * Only regular files can be measured without being read.
+     */
+    bool hasKnownSize() override;
+
+    /**
+     * Reads sequentially from the file, without seeking, so that pipes and
+     * other unbounded inputs are supported. Reads are served from memory once
+     * the contents are loaded.
+     */
+    size_t read(char* dst, size_t capacity) override;
+
    private:
     void read();
 
     std::string filename_;
     poly::optional<std::string> contents_;
+    std::ifstream stream_;
 };
 
 } // namespace openzl::tools::io
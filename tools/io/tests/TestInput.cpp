@@ -0,0 +1,110 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <sys/stat.h> // mkfifo
+#include <unistd.h>   // getpid
+
+#include "tools/io/InputBuffer.h"
+#include "tools/io/InputFile.h"
+
+using namespace testing;
+
+namespace openzl::tools::io::tests {
+
+namespace {
+
+/// Reads @p input by blocks of @p blockSize bytes.
+std::string readByBlocks(Input& input, size_t blockSize)
+{
+    std::string result;
+    std::string block(blockSize, '\0');
+    size_t readSize;
+    do {
+        readSize = input.read(block.data(), block.size());
+        result.append(block.data(), readSize);
+    } while (readSize == blockSize);
+    return result;
+}
+
+std::string makeContents(size_t size)
+{
+    std::string contents;
+    for (size_t i = 0; contents.size() < size; ++i) {
+        contents += std::to_string(i) + ",";
+    }
+    contents.resize(size);
+    return contents;
+}
+} // anonymous namespace
+
+TEST(TestInput, BufferReadByBlocks)
+{
+    const auto contents = makeContents(1000);
+    for (size_t blockSize : { 1, 7, 100, 1000, 4096 }) {
+        InputBuffer input(contents);
+        ASSERT_EQ(readByBlocks(input, blockSize), contents);
+        char c;
+        ASSERT_EQ(input.read(&c, 1), 0u);
+    }
+}
+
+TEST(TestInput, FileReadByBlocks)
+{
+    const auto path = std::filesystem::temp_directory_path()
+            / ("openzl_test_input_" + std::to_string(::getpid()));
+    const auto contents = makeContents(10000);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(contents.data(), (std::streamsize)contents.size());
+    }
+
+    for (size_t blockSize : { 1, 333, 5000, 10000, 20000 }) {
+        // Streamed without loading the whole file
+        InputFile input(path.string());
+        ASSERT_TRUE(input.hasKnownSize());
+        ASSERT_EQ(input.size().value(), contents.size());
+        ASSERT_EQ(readByBlocks(input, blockSize), contents);
+        char c;
+        ASSERT_EQ(input.read(&c, 1), 0u);
+    }
+    {
+        // Once loaded, reads continue from memory
+        InputFile input(path.string());
+        std::string block(333, '\0');
+        ASSERT_EQ(input.read(block.data(), block.size()), block.size());
+        ASSERT_EQ(std::string(input.contents()), contents);
+        ASSERT_EQ(block + readByBlocks(input, 333), contents);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(TestInput, PipeReadByBlocks)
+{
+    const auto path = std::filesystem::temp_directory_path()
+            / ("openzl_test_pipe_" + std::to_string(::getpid()));
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+    const auto contents = makeContents(300000);
+    // Written by small pieces, so that reads get partial data from the pipe
+    std::thread writer([&] {
+        std::ofstream out(path, std::ios::binary);
+        for (size_t pos = 0; pos < contents.size(); pos += 1000) {
+            out.write(contents.data() + pos, 1000);
+            out.flush();
+        }
+    });
+
+    {
+        // Pipes can't be seeked nor measured: they are read sequentially
+        InputFile input(path.string());
+        EXPECT_FALSE(input.hasKnownSize());
+        EXPECT_EQ(readByBlocks(input, 65536), contents);
+    }
+    writer.join();
+    std::filesystem::remove(path);
+}
+
+} // namespace openzl::tools::io::tests